@@ -145,6 +145,16 @@ cdef class CoreWorker:
             &contained_id, const CAddress &caller_address,
             int64_t *task_output_inlined_bytes,
             shared_ptr[CRayObject] *return_ptr)
+    cdef store_task_output_batch(
+            self, serialized_objects, output_indices,
+            const c_vector[CObjectID] &return_ids,
+            const c_vector[size_t] &data_sizes,
+            c_vector[shared_ptr[CBuffer]] &metadatas,
+            const c_vector[c_vector[CObjectID]] &contained_ids,
+            const CObjectID &generator_id,
+            const CAddress &caller_address,
+            c_vector[c_pair[CObjectID, shared_ptr[CRayObject]]] *returns,
+            int64_t *task_output_inlined_bytes)
     cdef store_task_outputs(
             self,
             worker, outputs,
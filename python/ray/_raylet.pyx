@@ -4500,6 +4500,88 @@ cdef class CoreWorker:
                                    return_id, return_ptr, generator_id))
             return success
 
+    cdef store_task_output_batch(
+            self, serialized_objects, output_indices,
+            const c_vector[CObjectID] &return_ids,
+            const c_vector[size_t] &data_sizes,
+            c_vector[shared_ptr[CBuffer]] &metadatas,
+            const c_vector[c_vector[CObjectID]] &contained_ids,
+            const CObjectID &generator_id,
+            const CAddress &caller_address,
+            c_vector[c_pair[CObjectID, shared_ptr[CRayObject]]] *returns,
+            int64_t *task_output_inlined_bytes):
+        """Store task return values in plasma with one request to create them
+        and another to seal them.
+
+        Returns the number of return values stored.
+        """
+        cdef:
+            c_vector[shared_ptr[CRayObject]] return_objects
+            shared_ptr[CRayObject] *return_ptr
+            CRayStatus status
+            c_bool success
+            size_t j
+
+        if return_ids.size() > 1:
+            with nogil:
+                status = (CCoreWorkerProcess.GetCoreWorker()
+                          .AllocateReturnObjects(
+                              return_ids, data_sizes, metadatas, contained_ids,
+                              caller_address, task_output_inlined_bytes,
+                              &return_objects))
+            if status.ok():
+                for j in range(return_ids.size()):
+                    if (return_objects[j].get() != NULL and
+                            return_objects[j].get().HasData()):
+                        (<SerializedObject>serialized_objects[j]).write_to(
+                            Buffer.make(return_objects[j].get().GetData()))
+                with nogil:
+                    check_status(
+                        CCoreWorkerProcess.GetCoreWorker().SealReturnObjects(
+                            return_ids, return_objects, generator_id,
+                            caller_address))
+                for j in range(return_ids.size()):
+                    return_ptr = &returns[0][output_indices[j]].second
+                    return_ptr[0] = return_objects[j]
+                    if return_ptr.get() == NULL:
+                        # The object already existed. Pin it, or create another
+                        # copy if the existing copy got evicted.
+                        with nogil:
+                            success = (CCoreWorkerProcess.GetCoreWorker()
+                                       .PinExistingReturnObject(
+                                           return_ids[j], return_ptr,
+                                           generator_id))
+                        if not success:
+                            self.store_task_output(
+                                serialized_objects[j], return_ids[j],
+                                generator_id,
+                                data_sizes[j], metadatas[j],
+                                contained_ids[j], caller_address,
+                                task_output_inlined_bytes, return_ptr)
+                return return_ids.size()
+            elif not status.IsObjectExists():
+                check_status(status)
+            # Otherwise, some of the objects already existed in plasma and none
+            # was created. Store them one at a time.
+
+        for j in range(return_ids.size()):
+            return_ptr = &returns[0][output_indices[j]].second
+            if not self.store_task_output(
+                    serialized_objects[j], return_ids[j],
+                    generator_id,
+                    data_sizes[j], metadatas[j], contained_ids[j],
+                    caller_address, task_output_inlined_bytes, return_ptr):
+                # If the object already exists, but we fail to pin the copy, it
+                # means the existing copy might've gotten evicted. Try to
+                # create another copy.
+                self.store_task_output(
+                        serialized_objects[j], return_ids[j],
+                        generator_id,
+                        data_sizes[j], metadatas[j],
+                        contained_ids[j], caller_address,
+                        task_output_inlined_bytes, return_ptr)
+        return return_ids.size()
+
     cdef store_task_outputs(self,
                             worker, outputs,
                             const CAddress &caller_address,
@@ -4514,6 +4596,10 @@ cdef class CoreWorker:
             int64_t task_output_inlined_bytes
             int64_t num_returns = -1
             shared_ptr[CRayObject] *return_ptr
+            c_vector[CObjectID] return_ids
+            c_vector[size_t] data_sizes
+            c_vector[shared_ptr[CBuffer]] metadatas
+            c_vector[c_vector[CObjectID]] contained_ids
 
         num_outputs_stored = 0
         if not ref_generator_id.IsNil():
@@ -4538,67 +4624,100 @@ cdef class CoreWorker:
         if num_returns == 0:
             return num_outputs_stored
 
+        # The return values of a task that returned them all at once are stored
+        # together. The values yielded by a generator are stored as they come,
+        # so that they don't pile up in the worker and are kept if the generator
+        # raises.
+        batched = (ref_generator_id.IsNil() and not self.is_local_mode and
+                   isinstance(outputs, (list, tuple)))
+        # The outputs to store together, with their index in returns.
+        output_indices = []
+        serialized_objects = []
+
         task_output_inlined_bytes = 0
         i = -1
-        for i, output in enumerate(outputs):
-            if num_returns >= 0 and i >= num_returns:
-                raise ValueError(
-                    "Task returned more than num_returns={} objects.".format(
-                        num_returns))
-            # TODO(sang): Remove it when the streaming generator is
-            # enabled by default.
-            while i >= returns[0].size():
-                return_id = (CCoreWorkerProcess.GetCoreWorker()
-                             .AllocateDynamicReturnId(
-                                caller_address, CTaskID.Nil(), NULL_PUT_INDEX))
-                returns[0].push_back(
-                        c_pair[CObjectID, shared_ptr[CRayObject]](
-                            return_id, shared_ptr[CRayObject]()))
-            assert i < returns[0].size()
-            return_id = returns[0][i].first
-            if returns[0][i].second == nullptr:
-                returns[0][i].second = shared_ptr[CRayObject]()
-            return_ptr = &returns[0][i].second
-
-            # Skip return values that we already created.  This can occur if
-            # there were multiple return values, and we initially errored while
-            # trying to create one of them.
-            if (return_ptr.get() != NULL and return_ptr.get().GetData().get()
-                    != NULL):
-                continue
+        try:
+            for i, output in enumerate(outputs):
+                if num_returns >= 0 and i >= num_returns:
+                    raise ValueError(
+                        "Task returned more than num_returns={} objects.".format(
+                            num_returns))
+                # TODO(sang): Remove it when the streaming generator is
+                # enabled by default.
+                while i >= returns[0].size():
+                    return_id = (CCoreWorkerProcess.GetCoreWorker()
+                                 .AllocateDynamicReturnId(
+                                    caller_address, CTaskID.Nil(), NULL_PUT_INDEX))
+                    returns[0].push_back(
+                            c_pair[CObjectID, shared_ptr[CRayObject]](
+                                return_id, shared_ptr[CRayObject]()))
+                assert i < returns[0].size()
+                return_id = returns[0][i].first
+                if returns[0][i].second == nullptr:
+                    returns[0][i].second = shared_ptr[CRayObject]()
+                return_ptr = &returns[0][i].second
+
+                # Skip return values that we already created.  This can occur if
+                # there were multiple return values, and we initially errored
+                # while trying to create one of them.
+                if (return_ptr.get() != NULL and return_ptr.get().GetData().get()
+                        != NULL):
+                    continue
 
-            context = worker.get_serialization_context()
-
-            serialized_object = context.serialize(output)
-            data_size = serialized_object.total_bytes
-            metadata_str = serialized_object.metadata
-            if ray._private.worker.global_worker.debugger_get_breakpoint:
-                breakpoint = (
-                    ray._private.worker.global_worker.debugger_get_breakpoint)
-                metadata_str += (
-                    b"," + ray_constants.OBJECT_METADATA_DEBUG_PREFIX +
-                    breakpoint.encode())
-                # Reset debugging context of this worker.
-                ray._private.worker.global_worker.debugger_get_breakpoint = b""
-            metadata = string_to_buffer(metadata_str)
-            contained_id = ObjectRefsToVector(
-                serialized_object.contained_object_refs)
+                context = worker.get_serialization_context()
+
+                serialized_object = context.serialize(output)
+                data_size = serialized_object.total_bytes
+                metadata_str = serialized_object.metadata
+                if ray._private.worker.global_worker.debugger_get_breakpoint:
+                    breakpoint = (
+                        ray._private.worker.global_worker.debugger_get_breakpoint)
+                    metadata_str += (
+                        b"," + ray_constants.OBJECT_METADATA_DEBUG_PREFIX +
+                        breakpoint.encode())
+                    # Reset debugging context of this worker.
+                    ray._private.worker.global_worker.debugger_get_breakpoint = b""
+                metadata = string_to_buffer(metadata_str)
+                contained_id = ObjectRefsToVector(
+                    serialized_object.contained_object_refs)
+
+                if batched:
+                    output_indices.append(i)
+                    serialized_objects.append(serialized_object)
+                    return_ids.push_back(return_id)
+                    data_sizes.push_back(data_size)
+                    metadatas.push_back(metadata)
+                    contained_ids.push_back(contained_id)
+                    continue
 
-            if not self.store_task_output(
-                    serialized_object, return_id,
-                    ref_generator_id,
-                    data_size, metadata, contained_id, caller_address,
-                    &task_output_inlined_bytes, return_ptr):
-                # If the object already exists, but we fail to pin the copy, it
-                # means the existing copy might've gotten evicted. Try to
-                # create another copy.
-                self.store_task_output(
+                if not self.store_task_output(
                         serialized_object, return_id,
                         ref_generator_id,
-                        data_size, metadata,
-                        contained_id, caller_address, &task_output_inlined_bytes,
-                        return_ptr)
-            num_outputs_stored += 1
+                        data_size, metadata, contained_id, caller_address,
+                        &task_output_inlined_bytes, return_ptr):
+                    # If the object already exists, but we fail to pin the copy,
+                    # it means the existing copy might've gotten evicted. Try to
+                    # create another copy.
+                    self.store_task_output(
+                            serialized_object, return_id,
+                            ref_generator_id,
+                            data_size, metadata,
+                            contained_id, caller_address,
+                            &task_output_inlined_bytes, return_ptr)
+                num_outputs_stored += 1
+        except BaseException:
+            # Keep the return values serialized before the error, as when they
+            # are stored one at a time. Only the rest get the error.
+            self.store_task_output_batch(
+                serialized_objects, output_indices, return_ids, data_sizes,
+                metadatas, contained_ids, ref_generator_id, caller_address,
+                returns, &task_output_inlined_bytes)
+            raise
+
+        num_outputs_stored += self.store_task_output_batch(
+            serialized_objects, output_indices, return_ids, data_sizes,
+            metadatas, contained_ids, ref_generator_id, caller_address,
+            returns, &task_output_inlined_bytes)
 
         i += 1
         if i < num_returns:
@@ -115,6 +115,7 @@ cdef extern from "ray/common/status.h" namespace "ray" nogil:
         c_bool IsUnknownError()
         c_bool IsNotImplemented()
         c_bool IsObjectStoreFull()
+        c_bool IsObjectExists()
         c_bool IsOutOfDisk()
         c_bool IsRedisError()
         c_bool IsTimedOut()
@@ -162,6 +162,19 @@ cdef extern from "ray/core_worker/core_worker.h" nogil:
             const CObjectID& generator_id,
             const CAddress &caller_address
         )
+        CRayStatus AllocateReturnObjects(
+            const c_vector[CObjectID] &object_ids,
+            const c_vector[size_t] &data_sizes,
+            const c_vector[shared_ptr[CBuffer]] &metadata,
+            const c_vector[c_vector[CObjectID]] &contained_object_ids,
+            const CAddress &caller_address,
+            int64_t *task_output_inlined_bytes,
+            c_vector[shared_ptr[CRayObject]] *return_objects)
+        CRayStatus SealReturnObjects(
+            const c_vector[CObjectID] &return_ids,
+            const c_vector[shared_ptr[CRayObject]] &return_objects,
+            const CObjectID& generator_id,
+            const CAddress &caller_address)
         c_bool PinExistingReturnObject(
             const CObjectID& return_id,
             shared_ptr[CRayObject] *return_object,
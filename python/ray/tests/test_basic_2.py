@@ -10,6 +10,7 @@ import threading
 import time
 from unittest.mock import MagicMock, patch
 
+import numpy as np
 import pytest
 
 from ray._private.ray_constants import KV_NAMESPACE_FUNCTION_TABLE
@@ -638,6 +639,26 @@ def test_wait(ray_start_regular_shared):
         ray.wait([1])
 
 
+def test_multiple_returns_in_plasma(ray_start_regular_shared):
+    # The return values that don't fit inline are created and sealed in the
+    # object store together.
+    @ray.remote(num_returns=4)
+    def f():
+        return (
+            np.full(200 * 1024, 1, dtype=np.uint8),
+            1,
+            np.full(300 * 1024, 2, dtype=np.uint8),
+            np.full(400 * 1024, 3, dtype=np.uint8),
+        )
+
+    for _ in range(3):
+        a, b, c, d = ray.get(list(f.remote()))
+        assert a.size == 200 * 1024 and (a == 1).all()
+        assert b == 1
+        assert c.size == 300 * 1024 and (c == 2).all()
+        assert d.size == 400 * 1024 and (d == 3).all()
+
+
 def test_duplicate_args(ray_start_regular_shared):
     @ray.remote
     def f(arg1, arg2, arg1_duplicate, kwarg1=None, kwarg2=None, kwarg1_duplicate=None):
@@ -3,6 +3,7 @@ import numpy as np
 import sys
 import time
 import gc
+import threading
 from unittest.mock import Mock
 
 import ray
@@ -194,6 +195,41 @@ def test_generator_errors(
         ray.get(ref2)
 
 
+@pytest.mark.parametrize("num_returns_type", ["dynamic", None])
+def test_generator_fails_after_plasma_values(ray_start_regular, num_returns_type):
+    # The values yielded before the error are stored as they are yielded, so
+    # their refs keep them and only the refs after them get the error.
+    @ray.remote(max_retries=0)
+    def generator(num_values):
+        for i in range(num_values):
+            yield np.ones(1_000_000, dtype=np.int8) * i
+        raise Exception("error")
+
+    dynamic_ref = generator.options(num_returns=num_returns_type).remote(3)
+    refs = list(ray.get(dynamic_ref))
+    assert len(refs) == 4
+    for i, ref in enumerate(refs[:3]):
+        assert ray.get(ref)[0] == i
+    with pytest.raises(ray.exceptions.RayTaskError):
+        ray.get(refs[3])
+
+    # The return values of a task that fails to serialize one of them are kept
+    # up to that one too.
+    @ray.remote(num_returns=3, max_retries=0)
+    def returns_unserializable():
+        return (
+            np.ones(1_000_000, dtype=np.int8),
+            np.ones(1_000_000, dtype=np.int8) * 2,
+            threading.Lock(),
+        )
+
+    ref1, ref2, ref3 = returns_unserializable.remote()
+    assert ray.get(ref1)[0] == 1
+    assert ray.get(ref2)[0] == 2
+    with pytest.raises(ray.exceptions.RayTaskError):
+        ray.get(ref3)
+
+
 @pytest.mark.parametrize("store_in_plasma", [False, True])
 @pytest.mark.parametrize("num_returns_type", ["dynamic", None])
 def test_dynamic_generator_retry_exception(
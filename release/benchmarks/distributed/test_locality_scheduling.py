@@ -0,0 +1,134 @@
+import ray
+import argparse
+import random
+from time import time, sleep
+import numpy as np
+from ray._private.internal_api import get_memory_info_reply, get_state_from_address
+from ray._private.test_utils import safe_write_to_results_json
+from ray.cluster_utils import Cluster
+
+
+@ray.remote
+def produce(size_mb):
+    return np.zeros(size_mb * 1024 * 1024, dtype=np.uint8)
+
+
+@ray.remote(num_cpus=1)
+def consume(duration_s, *args):
+    sleep(duration_s)
+
+
+def created_bytes():
+    # Includes the copies pulled from other nodes, so the difference before and
+    # after the consumers ran is the number of bytes transferred between nodes.
+    state = get_state_from_address(ray.get_runtime_context().gcs_address)
+    return get_memory_info_reply(state).store_stats.cumulative_created_bytes
+
+
+def run(args):
+    num_nodes = len(ray.nodes())
+    # Each object lives on one node, and each consumer reads two objects from
+    # different nodes. Once the node holding the first one is busy, the lease is
+    # spilled back and a locality-aware raylet prefers the node holding the other.
+    objects = [
+        produce.options(resources={f"node{i % num_nodes}": 0.001}).remote(
+            args.object_size_mb
+        )
+        for i in range(args.num_objects)
+    ]
+    ray.wait(objects, num_returns=len(objects), fetch_local=False)
+    rng = random.Random(args.seed)
+    pairs = []
+    for _ in range(args.total_num_task):
+        first = rng.randrange(args.num_objects)
+        second = rng.randrange(args.num_objects - 1)
+        if second % num_nodes == first % num_nodes:
+            second = (second + 1) % args.num_objects
+        pairs.append((objects[first], objects[second]))
+
+    bytes_before = created_bytes()
+    start = time()
+    ray.get([consume.remote(args.task_duration_s, a, b) for a, b in pairs])
+    makespan = time() - start
+    return created_bytes() - bytes_before, makespan
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(prog="Test Locality Scheduling")
+    parser.add_argument(
+        "--total-num-task", type=int, help="Total number of tasks.", default=400
+    )
+    parser.add_argument(
+        "--num-objects", type=int, help="Number of objects to read.", default=32
+    )
+    parser.add_argument(
+        "--object-size-mb", type=int, help="Size of each object.", default=32
+    )
+    parser.add_argument(
+        "--task-duration-s",
+        type=float,
+        help="How long does each task execute.",
+        default=0.5,
+    )
+    parser.add_argument("--seed", type=int, help="Random seed.", default=0)
+    parser.add_argument(
+        "--num-nodes", type=int, help="Number of raylets of the cluster.", default=4
+    )
+    parser.add_argument(
+        "--num-cpus-per-node", type=int, help="CPUs of each raylet.", default=2
+    )
+    parser.add_argument(
+        "--object-store-memory-mb",
+        type=int,
+        help="Object store memory of each raylet.",
+        default=2048,
+    )
+    parser.add_argument(
+        "--scheduler-locality-weights",
+        type=str,
+        help="Comma separated weights of argument locality in the raylet scheduler "
+        "to compare, each on its own cluster. 0 disables it.",
+        default="0,0.25,0.5,1",
+    )
+    args = parser.parse_args()
+
+    results = []
+    for weight in [float(w) for w in args.scheduler_locality_weights.split(",")]:
+        cluster = Cluster()
+        for i in range(args.num_nodes):
+            node_args = {
+                "num_cpus": args.num_cpus_per_node,
+                "resources": {f"node{i}": 1},
+                "object_store_memory": args.object_store_memory_mb * 1024**2,
+            }
+            if i == 0:
+                node_args["_system_config"] = {"scheduler_locality_weight": weight}
+            cluster.add_node(**node_args)
+        cluster.wait_for_nodes()
+        ray.init(address=cluster.address)
+
+        bytes_transferred, makespan = run(args)
+        results.append(
+            {
+                "scheduler_locality_weight": weight,
+                "bytes_transferred": bytes_transferred,
+                "makespan_s": makespan,
+            }
+        )
+        print(results[-1])
+
+        ray.shutdown()
+        cluster.shutdown()
+
+    result = {
+        "total_num_task": args.total_num_task,
+        "num_objects": args.num_objects,
+        "object_size_mb": args.object_size_mb,
+        "num_nodes": args.num_nodes,
+        "results": results,
+        "_runtime": sum(r["makespan_s"] for r in results),
+    }
+
+    safe_write_to_results_json(result)
+
+    print(result)
@@ -0,0 +1,109 @@
+import ray
+import argparse
+import random
+from time import time, sleep
+from ray._private.test_utils import safe_write_to_results_json
+from ray.cluster_utils import Cluster
+
+
+@ray.remote(num_cpus=1)
+def skewed_task(t):
+    sleep(t)
+    return time()
+
+
+def task_durations(num_tasks, skew, seed):
+    # Most tasks are short, a few are much longer, so the nodes that happen to
+    # queue the long ones become stragglers unless the idle ones take work over.
+    rng = random.Random(seed)
+    return [min(0.001 * rng.paretovariate(skew), 1.0) for _ in range(num_tasks)]
+
+
+def percentile(values, p):
+    values = sorted(values)
+    return values[min(int(len(values) * p), len(values) - 1)]
+
+
+def run(num_tasks, skew, seed):
+    start = time()
+    refs = [skewed_task.remote(t) for t in task_durations(num_tasks, skew, seed)]
+    submission_cost = time() - start
+    completion_times = [end - start for end in ray.get(refs)]
+    return submission_cost, completion_times, time() - start
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(prog="Test Work Stealing")
+    parser.add_argument(
+        "--total-num-task", type=int, help="Total number of tasks.", default=100000
+    )
+    parser.add_argument(
+        "--skew",
+        type=float,
+        help="Pareto shape of the task durations, smaller is more skewed.",
+        default=1.2,
+    )
+    parser.add_argument("--seed", type=int, help="Random seed.", default=0)
+    parser.add_argument(
+        "--num-nodes",
+        type=int,
+        help="Start a local cluster of this many raylets instead of connecting "
+        "to an existing one.",
+        required=False,
+    )
+    parser.add_argument(
+        "--num-cpus-per-node",
+        type=int,
+        help="CPUs of each raylet of the local cluster.",
+        default=4,
+    )
+    parser.add_argument(
+        "--work-stealing-period-ms",
+        type=int,
+        help="Work stealing period of the local cluster, 0 disables it.",
+        default=100,
+    )
+    args = parser.parse_args()
+
+    cluster = None
+    if args.num_nodes is not None:
+        cluster = Cluster()
+        for i in range(args.num_nodes):
+            node_args = {"num_cpus": args.num_cpus_per_node}
+            if i == 0:
+                node_args["_system_config"] = {
+                    "work_stealing_period_ms": args.work_stealing_period_ms
+                }
+            cluster.add_node(**node_args)
+        cluster.wait_for_nodes()
+        ray.init(address=cluster.address)
+    else:
+        ray.init(address="auto")
+
+    num_nodes = len(ray.nodes())
+    submission_cost, completion_times, makespan = run(
+        args.total_num_task, args.skew, args.seed
+    )
+
+    result = {
+        "total_num_task": args.total_num_task,
+        "skew": args.skew,
+        "num_nodes": num_nodes,
+        "work_stealing_period_ms": args.work_stealing_period_ms
+        if cluster is not None
+        else None,
+        "submission_cost": submission_cost,
+        "p50_completion_s": percentile(completion_times, 0.5),
+        "p99_completion_s": percentile(completion_times, 0.99),
+        "max_completion_s": max(completion_times),
+        "makespan_s": makespan,
+        "_runtime": makespan,
+    }
+
+    safe_write_to_results_json(result)
+
+    print(result)
+
+    ray.shutdown()
+    if cluster is not None:
+        cluster.shutdown()
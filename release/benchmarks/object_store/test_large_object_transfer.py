@@ -0,0 +1,78 @@
+"""Transfer a single large object between two raylets running on the same machine.
+
+The throughput is bounded by the copies on the push/receive path of the object
+manager rather than by the network, so this is used to measure changes to it.
+
+    python object_store/test_large_object_transfer.py --object-size-gb 10
+"""
+import argparse
+import json
+import os
+from time import perf_counter
+
+import numpy as np
+
+import ray
+from ray.cluster_utils import Cluster
+
+
+def test_large_object_transfer(object_size):
+    @ray.remote(num_cpus=1, resources={"sender": 1})
+    def produce():
+        return np.ones(object_size, dtype=np.uint8)
+
+    @ray.remote(num_cpus=1, resources={"receiver": 1})
+    def consume(arr):
+        return len(arr)
+
+    ref = produce.remote()
+    ray.wait([ref], fetch_local=False)
+
+    start = perf_counter()
+    assert ray.get(consume.remote(ref)) == object_size
+    return perf_counter() - start
+
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--object-size-gb", type=float, default=10)
+args = parser.parse_args()
+object_size = int(args.object_size_gb * 2**30)
+# Leave room for the object and its metadata in each store.
+object_store_memory = object_size + 2**30
+
+cluster = Cluster()
+cluster.add_node(
+    num_cpus=1, resources={"sender": 1}, object_store_memory=object_store_memory
+)
+cluster.add_node(
+    num_cpus=1, resources={"receiver": 1}, object_store_memory=object_store_memory
+)
+ray.init(address=cluster.address)
+
+duration = test_large_object_transfer(object_size)
+throughput = object_size / duration / 2**30
+print(f"Transfer time: {duration} ({object_size} B, {throughput:.2f} GiB/s)")
+
+if "TEST_OUTPUT_JSON" in os.environ:
+    out_file = open(os.environ["TEST_OUTPUT_JSON"], "w")
+    results = {
+        "transfer_time": duration,
+        "object_size": object_size,
+        "success": "1",
+    }
+    results["perf_metrics"] = [
+        {
+            "perf_metric_name": f"time_to_transfer_{object_size}_bytes_between_raylets",
+            "perf_metric_value": duration,
+            "perf_metric_type": "LATENCY",
+        },
+        {
+            "perf_metric_name": "large_object_transfer_gib_per_second",
+            "perf_metric_value": throughput,
+            "perf_metric_type": "THROUGHPUT",
+        },
+    ]
+    json.dump(results, out_file)
+
+ray.shutdown()
+cluster.shutdown()
@@ -113,6 +113,11 @@ class MockRayletClientInterface : public RayletClientInterface {
                int64_t draining_deadline_timestamp_ms,
                const rpc::ClientCallback<rpc::DrainRayletReply> &callback),
               (override));
+  MOCK_METHOD(void,
+              StealTasks,
+              (const rpc::StealTasksRequest &request,
+               const rpc::ClientCallback<rpc::StealTasksReply> &callback),
+              (override));
 };
 
 }  // namespace ray
@@ -482,7 +482,7 @@ void ClientConnection::ProcessMessageHeader(const boost::system::error_code &err
 
   // If there was no error, make sure the ray cookie matches.
   if (!CheckRayCookie()) {
-    ServerConnection::Close();
+    Close();
     return;
   }
 
@@ -65,7 +65,7 @@ class ServerConnection : public std::enable_shared_from_this<ServerConnection> {
   /// \param length The size in bytes of the message.
   /// \param message A pointer to the message buffer.
   /// \return Status.
-  ray::Status WriteMessage(int64_t type, int64_t length, const uint8_t *message);
+  virtual ray::Status WriteMessage(int64_t type, int64_t length, const uint8_t *message);
 
   /// Write a message to the client asynchronously.
   ///
@@ -83,7 +83,7 @@ class ServerConnection : public std::enable_shared_from_this<ServerConnection> {
   /// \param type The message type (e.g., a flatbuffer enum).
   /// \param message A pointer to the message buffer.
   /// \return Status.
-  Status ReadMessage(int64_t type, std::vector<uint8_t> *message);
+  virtual Status ReadMessage(int64_t type, std::vector<uint8_t> *message);
 
   /// Write a buffer to this connection.
   ///
@@ -114,7 +114,7 @@ class ServerConnection : public std::enable_shared_from_this<ServerConnection> {
                        const std::function<void(const ray::Status &)> &handler);
 
   /// Shuts down socket for this connection.
-  void Close() {
+  virtual void Close() {
     boost::system::error_code ec;
     socket_.close(ec);
   }
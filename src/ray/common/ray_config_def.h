@@ -163,6 +163,31 @@ RAY_CONFIG(int64_t, max_lineage_bytes, 1024 * 1024 * 1024)
 /// See also: https://github.com/ray-project/ray/issues/14182
 RAY_CONFIG(bool, preallocate_plasma_memory, false)
 
+/// Objects up to this size are allocated from slabs of blocks of the same size
+/// class in plasma memory, instead of directly from dlmalloc. This avoids
+/// fragmenting plasma memory when many small objects are created and deleted,
+/// at the cost of rounding up object sizes by up to 25%. 0 disables it.
+RAY_CONFIG(int64_t, plasma_slab_allocator_max_object_size, 0)
+
+/// The policy to choose the plasma objects to evict when the object store is full,
+/// available options are
+/// lru: evict the least recently used objects.
+/// gdsf: evict the objects used the least often per byte, aging out the objects not
+/// used for a while (Greedy-Dual-Size-Frequency).
+RAY_CONFIG(std::string, plasma_eviction_policy, "lru")
+
+/// Whether plasma clients exchange messages with the store through a pair of
+/// single-producer single-consumer rings in shared memory, instead of the unix
+/// domain socket. The socket is still used to pass file descriptors and to
+/// detect disconnections. Only supported on Linux. Off by default until it is shown
+/// to lower the latency of plasma Get on multi-core nodes, see DISABLED_GetLatencyPerf
+/// in plasma_client_test.
+RAY_CONFIG(bool, plasma_shared_memory_transport, false)
+
+/// The size in bytes of each of the request and response rings of the plasma
+/// shared memory transport. Larger messages are streamed through the ring.
+RAY_CONFIG(uint64_t, plasma_shared_memory_transport_ring_size, 1024 * 1024)
+
 // If true, we place a soft cap on the numer of scheduling classes, see
 // `worker_cap_initial_backoff_delay_ms`.
 RAY_CONFIG(bool, worker_cap_enabled, true)
@@ -185,6 +210,18 @@ RAY_CONFIG(int64_t, worker_cap_max_backoff_delay_ms, 1000 * 10)
 /// even balancing of load. Low values (min 0.0) encourage more load spreading.
 RAY_CONFIG(float, scheduler_spread_threshold, 0.5)
 
+/// Used by the default hybrid policy only. The weight, between 0.0 and 1.0, of the
+/// fraction of a task's argument bytes already on a node in the node's score, the
+/// rest being its critical resource utilization. Only the locations of the objects
+/// in the local object store and of the objects being pulled are known to the raylet.
+/// 0.0 schedules by utilization only. It defaults to 0.0 because with that partial
+/// view the benefit depends on the workload (compare the weights with
+/// release/benchmarks/distributed/test_locality_scheduling.py), while a weight above
+/// 0.0 scores every node for each task with arguments instead of using the node score
+/// index, which costs 3 to 4 times the decision throughput
+/// (HybridSchedulingPolicyTest.DISABLED_ArgumentLocalityPerf).
+RAY_CONFIG(float, scheduler_locality_weight, 0.0)
+
 /// Used by the default hybrid policy only. The scheduler will randomly pick
 /// one node from the top k in the cluster to improve load balancing. The
 /// scheduler guarantees k is at least equal to this fraction * the number of
@@ -196,6 +233,27 @@ RAY_CONFIG(float, scheduler_top_k_fraction, 0.2);
 /// scheduler guarantees k is at least equal to scheduler_top_k_absolute.
 RAY_CONFIG(int32_t, scheduler_top_k_absolute, 1);
 
+/// Whether the raylet places the queued tasks of a scheduling class that share a
+/// preferred node with one scheduler call, instead of one call per task.
+RAY_CONFIG(bool, scheduler_batch_same_shape_tasks, true)
+
+/// How often an idle raylet asks a saturated one to hand over queued tasks. The
+/// saturated raylet spills back up to half of the tasks waiting for its resources to
+/// the idle one. 0 disables work stealing.
+RAY_CONFIG(uint64_t, work_stealing_period_ms, 0)
+
+/// The maximum number of tasks a raylet asks for at once when stealing work.
+RAY_CONFIG(int64_t, work_stealing_max_tasks, 100)
+
+/// How long a raylet holds the resources of the tasks it stole for the owners of the
+/// tasks to ask it for leases. After that, the resources are free for other tasks.
+RAY_CONFIG(int64_t, work_stealing_reservation_timeout_ms, 10000)
+
+/// A queued task is only handed over to another raylet if the total size of its
+/// arguments stored in plasma is at most this many bytes, since the arguments are
+/// pulled again by the other raylet.
+RAY_CONFIG(uint64_t, work_stealing_max_args_bytes, 1024 * 1024)
+
 /// Whether to only report the usage of pinned copies of objects in the
 /// object_store_memory resource. This means nodes holding secondary copies only
 /// will become eligible for removal in the autoscaler.
@@ -205,6 +263,11 @@ RAY_CONFIG(bool, scheduler_report_pinned_bytes_only, true)
 // Objects larger than this size will be spilled/promoted to plasma.
 RAY_CONFIG(int64_t, max_direct_call_object_size, 100 * 1024)
 
+/// The number of shards of the in-memory object store of a worker. The objects of
+/// each shard, and the requests waiting for them, are protected by their own lock,
+/// so that threads accessing different objects rarely contend.
+RAY_CONFIG(uint64_t, memory_store_num_shards, 16)
+
 // The max gRPC message size (the gRPC internal default is 4MB). We use a higher
 // limit in Ray to avoid crashing with many small inlined task arguments.
 // Keep in sync with GCS_STORAGE_MAX_SIZE in packaging.py.
@@ -357,12 +420,36 @@ RAY_CONFIG(uint64_t,
            object_manager_max_bytes_in_flight,
            ((uint64_t)2) * 1024 * 1024 * 1024)
 
+/// The maximum number of spilled files the object manager keeps open to serve pushes
+/// of spilled objects. Reads of an open file are served with a positional read
+/// instead of opening and seeking the file for every chunk. Set it to 0 to open the
+/// file on every read.
+RAY_CONFIG(uint64_t, object_manager_max_cached_spilled_files, 256)
+
+/// Whether the object manager adapts the number of chunks in flight to each
+/// destination to the round trip time of its chunks, and shares
+/// object_manager_max_bytes_in_flight fairly across destinations. Otherwise chunks
+/// are sent round-robin across pushes up to the global limit only.
+RAY_CONFIG(bool, object_manager_push_adaptive_scheduling, false)
+
+/// The max number of nodes the object manager pushes an object to at a time. The
+/// pulls of further nodes are forwarded to the nodes the object is being pushed to,
+/// which relay the chunks as they receive them, so that an object pulled by many
+/// nodes at once is broadcast over a tree. Set it to 0 to always push from the node
+/// that is pulled from.
+RAY_CONFIG(int64_t, object_manager_broadcast_max_fanout, 0)
+
 /// Maximum number of ids in one batch to send to GCS to delete keys.
 RAY_CONFIG(uint32_t, maximum_gcs_deletion_batch_size, 1000)
 
 /// Maximum number of items in one batch to scan/get/delete from GCS storage.
 RAY_CONFIG(uint32_t, maximum_gcs_storage_operation_batch_size, 1000)
 
+/// The single-key writes to the Redis GCS storage made within this many microseconds
+/// are sent to Redis as one command, up to maximum_gcs_storage_operation_batch_size
+/// writes per command. 0 sends every write on its own.
+RAY_CONFIG(uint64_t, gcs_redis_write_batch_window_us, 0)
+
 /// When getting objects from object store, max number of ids to print in the warning
 /// message.
 RAY_CONFIG(uint32_t, object_store_get_max_ids_to_print_in_warning, 20)
@@ -390,6 +477,10 @@ RAY_CONFIG(uint32_t, gcs_create_actor_retry_interval_ms, 200)
 RAY_CONFIG(uint64_t, gcs_create_placement_group_retry_min_interval_ms, 100)
 RAY_CONFIG(uint64_t, gcs_create_placement_group_retry_max_interval_ms, 1000)
 RAY_CONFIG(double, gcs_create_placement_group_retry_multiplier, 1.5)
+/// Maximum number of attempts to fit a bundle on a node when searching a placement for
+/// a PACK or STRICT_SPREAD placement group that the greedy placement failed to place.
+/// 0 disables the search.
+RAY_CONFIG(int64_t, placement_group_solver_max_steps, 100000)
 /// Maximum number of destroyed actors in GCS server memory cache.
 RAY_CONFIG(uint32_t, maximum_gcs_destroyed_actor_cached_count, 100000)
 /// Maximum number of dead nodes in GCS server memory cache.
@@ -398,8 +489,17 @@ RAY_CONFIG(uint32_t, maximum_gcs_dead_node_cached_count, 1000)
 RAY_CONFIG(int, gcs_resource_report_poll_period_ms, 100)
 // The number of concurrent polls to polls to GCS.
 RAY_CONFIG(uint64_t, gcs_max_concurrent_resource_pulls, 100)
-// The storage backend to use for the GCS. It can be either 'redis' or 'memory'.
+/// Whether the GCS internal KV manager and service run on their own thread, so that
+/// large KV requests don't delay the other GCS managers.
+RAY_CONFIG(bool, gcs_internal_kv_dedicated_thread, false)
+// The storage backend to use for the GCS. It can be 'redis', 'memory' or 'file'.
 RAY_CONFIG(std::string, gcs_storage, "memory")
+/// The directory of the GCS storage when gcs_storage is 'file'. It can be on a local or
+/// a shared disk, and a restarted GCS recovers its tables from it.
+RAY_CONFIG(std::string, gcs_file_storage_path, "")
+/// When the write-ahead log of the 'file' GCS storage grows over this size (or the size
+/// of the latest snapshot, if larger), the tables are compacted into a new snapshot.
+RAY_CONFIG(uint64_t, gcs_file_storage_compaction_bytes, 256 * 1024 * 1024)
 
 /// Duration to sleep after failing to put an object in plasma because it is full.
 RAY_CONFIG(uint32_t, object_store_full_delay_ms, 10)
@@ -469,6 +569,17 @@ RAY_CONFIG(int64_t, ray_syncer_message_refresh_interval_ms, 3000)
 /// requests can run in flight for syncing.
 RAY_CONFIG(int64_t, ray_syncer_polling_buffer, 5)
 
+/// Ray syncer sends a resource view message as a delta against the version a
+/// connection last sent when that's smaller. This is the number of deltas sent for a
+/// node before its full resource view is sent again. 0 disables deltas.
+RAY_CONFIG(int64_t, ray_syncer_delta_full_message_interval, 20)
+
+/// The node label that groups raylets for ray syncer, e.g. a rack or zone label.
+/// Raylets with the same label value sync with one raylet of the group instead of
+/// the GCS, which then relays each update to one connection per group. Empty
+/// means every raylet syncs with the GCS directly.
+RAY_CONFIG(std::string, ray_syncer_aggregation_label, "")
+
 /// The interval at which the gcs client will check if the address of gcs service has
 /// changed. When the address changed, we will resubscribe again.
 RAY_CONFIG(uint64_t, gcs_service_address_check_interval_milliseconds, 1000)
@@ -492,6 +603,15 @@ RAY_CONFIG(int64_t, task_events_report_interval_ms, 1000)
 /// Setting the value to -1 allows for unlimited task events stored in GCS.
 RAY_CONFIG(int64_t, task_events_max_num_task_in_gcs, 100000)
 
+/// The number of terminated tasks kept in GCS after they are evicted by
+/// `task_events_max_num_task_in_gcs`. They're kept in a compressed columnar form that
+/// takes a fraction of the memory, so this can be much higher than
+/// `task_events_max_num_task_in_gcs`. Setting the value to 0 drops the evicted tasks.
+/// Any other value works: the oldest 1/16 of the archived tasks (at least one task) is
+/// dropped at a time, but below 4096 the tasks are compressed in smaller blocks, which
+/// saves less memory.
+RAY_CONFIG(int64_t, task_events_max_num_archived_task_in_gcs, 0)
+
 /// The number of task attempts being dropped per job tracked at GCS. When GCS is forced
 /// to stop tracking some task attempts that are lost, this will incur potential partial
 /// data loss for a single task attempt (e.g. some task events were dropped, but some were
@@ -588,6 +708,19 @@ RAY_CONFIG(bool, enable_worker_prestart, false)
 /// TODO(clarng): reconcile with enable_worker_prestart
 RAY_CONFIG(bool, prestart_worker_first_driver, true)
 
+/// The interval at which the worker pool keeps warm workers for the recent lease
+/// requests of each kind of worker, i.e. per language, job and runtime env hash (which
+/// covers the resource shape when worker_resource_limits_enabled is set). Value of 0
+/// means the demand-based prestarting is disabled.
+RAY_CONFIG(uint64_t, worker_demand_prestart_interval_ms, 0)
+
+/// The half-life of the lease request rates that size the warm workers, in ms.
+RAY_CONFIG(uint64_t, worker_demand_half_life_ms, 10000)
+
+/// The maximum number of workers prestarted for the demand that are starting or idle
+/// at once. This bounds the memory held by speculative workers.
+RAY_CONFIG(int64_t, worker_demand_max_warm_workers, 8)
+
 /// The interval of periodic idle worker killing. Value of 0 means worker capping is
 /// disabled.
 RAY_CONFIG(uint64_t, kill_idle_workers_interval_ms, 200)
@@ -173,13 +173,17 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
   /// \param message_processor The callback for the message received.
   /// \param cleanup_cb When the connection terminates, it'll be called to cleanup
   ///     the environment.
+  /// \param delta_encoder The encoder used to send messages as deltas. nullptr means
+  ///     only full messages are sent. Deltas received are decoded either way.
   RaySyncerBidiReactorBase(
       instrumented_io_context &io_context,
       const std::string &remote_node_id,
-      std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor)
+      std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor,
+      std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder = nullptr)
       : RaySyncerBidiReactor(remote_node_id),
         io_context_(io_context),
-        message_processor_(std::move(message_processor)) {}
+        message_processor_(std::move(message_processor)),
+        delta_encoder_(std::move(delta_encoder)) {}
 
   bool PushToSendingQueue(std::shared_ptr<const RaySyncMessage> message) override {
     if (*IsDisconnected()) {
@@ -223,6 +227,10 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
   ///
   /// \param messages The message received.
   void ReceiveUpdate(std::shared_ptr<const RaySyncMessage> message) {
+    message = DecodeReceived(std::move(message));
+    if (message == nullptr) {
+      return;
+    }
     auto &node_versions = GetNodeComponentVersions(message->node_id());
     RAY_LOG(DEBUG) << "Receive update: "
                    << " message_type=" << message->message_type()
@@ -241,6 +249,61 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
     }
   }
 
+  /// Replace a message by its delta against the version of it last sent on this
+  /// stream, when the delta is smaller. Every `FullMessageInterval()` deltas, the full
+  /// message is sent again.
+  std::shared_ptr<const RaySyncMessage> EncodeForSending(
+      std::shared_ptr<const RaySyncMessage> message) {
+    if (delta_encoder_ == nullptr || delta_encoder_->FullMessageInterval() <= 0 ||
+        message->message_type() != MessageType::RESOURCE_VIEW) {
+      return message;
+    }
+    auto &sent_messages = GetNodeComponents(last_sent_, message->node_id());
+    auto &last_sent = sent_messages[message->message_type()];
+    std::shared_ptr<const RaySyncMessage> delta;
+    if (last_sent.message != nullptr &&
+        last_sent.num_deltas < delta_encoder_->FullMessageInterval()) {
+      delta = delta_encoder_->Encode(*last_sent.message, *message);
+    }
+    last_sent.message = message;
+    if (delta == nullptr) {
+      last_sent.num_deltas = 0;
+      return message;
+    }
+    last_sent.num_deltas++;
+    return delta;
+  }
+
+  /// Turn a delta received on this stream back into the full message.
+  ///
+  /// \return The full message, or nullptr if the delta doesn't apply to the version
+  /// last received. The message is dropped then, and the next full message sent by
+  /// the remote node brings the view up to date again.
+  std::shared_ptr<const RaySyncMessage> DecodeReceived(
+      std::shared_ptr<const RaySyncMessage> message) {
+    if (message->message_type() != MessageType::RESOURCE_VIEW) {
+      return message;
+    }
+    auto &received_messages = GetNodeComponents(last_received_, message->node_id());
+    auto &last_received = received_messages[message->message_type()];
+    if (message->is_delta()) {
+      auto full_message = last_received == nullptr
+                              ? nullptr
+                              : ApplySyncMessageDelta(*last_received, *message);
+      if (full_message == nullptr) {
+        RAY_LOG_EVERY_MS(WARNING, 1000)
+            << "Drop delta message received from "
+            << NodeID::FromBinary(message->node_id()) << " because its base version "
+            << message->base_version() << " doesn't match the local version "
+            << (last_received == nullptr ? -1 : last_received->version());
+        return nullptr;
+      }
+      message = std::move(full_message);
+    }
+    last_received = message;
+    return message;
+  }
+
   void SendNext() {
     sending_ = false;
     StartSend();
@@ -255,7 +318,7 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
       auto iter = sending_buffer_.begin();
       auto msg = std::move(iter->second);
       sending_buffer_.erase(iter);
-      Send(std::move(msg), sending_buffer_.empty());
+      Send(EncodeForSending(std::move(msg)), sending_buffer_.empty());
       sending_ = true;
     }
   }
@@ -329,6 +392,8 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
 
   // For testing
   FRIEND_TEST(RaySyncerTest, RaySyncerBidiReactorBase);
+  FRIEND_TEST(RaySyncerTest, RaySyncerBidiReactorBaseDelta);
+  FRIEND_TEST(RaySyncerTest, DISABLED_RaySyncerBidiReactorBaseDeltaPerf);
   friend struct SyncerServerTest;
 
   std::array<int64_t, kComponentArraySize> &GetNodeComponentVersions(
@@ -342,9 +407,23 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
     return iter->second;
   }
 
+  template <typename V>
+  static std::array<V, kComponentArraySize> &GetNodeComponents(
+      absl::flat_hash_map<std::string, std::array<V, kComponentArraySize>> &map,
+      const std::string &node_id) {
+    auto iter = map.find(node_id);
+    if (iter == map.end()) {
+      iter = map.emplace(node_id, std::array<V, kComponentArraySize>()).first;
+    }
+    return iter->second;
+  }
+
   /// Handler of a message update.
   const std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor_;
 
+  /// The delta encoder shared by the connections of the syncer.
+  const std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder_;
+
  private:
   /// Buffering all the updates. Sending will be done in an async way.
   absl::flat_hash_map<std::pair<std::string, MessageType>,
@@ -357,6 +436,24 @@ class RaySyncerBidiReactorBase : public RaySyncerBidiReactor, public T {
   absl::flat_hash_map<std::string, std::array<int64_t, kComponentArraySize>>
       node_versions_;
 
+  struct SentMessage {
+    /// The full message last sent, which the next delta is encoded against.
+    std::shared_ptr<const RaySyncMessage> message;
+    /// The number of deltas sent since the full message was last sent.
+    int64_t num_deltas = 0;
+  };
+
+  /// The messages last sent on this stream, by node id and message type.
+  absl::flat_hash_map<std::string, std::array<SentMessage, kComponentArraySize>>
+      last_sent_;
+
+  /// The full messages last received on this stream, by node id and message type.
+  /// Deltas received are applied to them.
+  absl::flat_hash_map<
+      std::string,
+      std::array<std::shared_ptr<const RaySyncMessage>, kComponentArraySize>>
+      last_received_;
+
   bool sending_ = false;
 };
 
@@ -369,7 +466,8 @@ class RayServerBidiReactor : public RaySyncerBidiReactorBase<ServerBidiReactor>
       instrumented_io_context &io_context,
       const std::string &local_node_id,
       std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor,
-      std::function<void(const std::string &, bool)> cleanup_cb);
+      std::function<void(const std::string &, bool)> cleanup_cb,
+      std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder = nullptr);
 
   ~RayServerBidiReactor() override = default;
 
@@ -396,7 +494,8 @@ class RayClientBidiReactor : public RaySyncerBidiReactorBase<ClientBidiReactor>
       instrumented_io_context &io_context,
       std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor,
       std::function<void(const std::string &, bool)> cleanup_cb,
-      std::unique_ptr<ray::rpc::syncer::RaySyncer::Stub> stub);
+      std::unique_ptr<ray::rpc::syncer::RaySyncer::Stub> stub,
+      std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder = nullptr);
 
   ~RayClientBidiReactor() override = default;
 
@@ -95,11 +95,13 @@ RayServerBidiReactor::RayServerBidiReactor(
     instrumented_io_context &io_context,
     const std::string &local_node_id,
     std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor,
-    std::function<void(const std::string &, bool)> cleanup_cb)
+    std::function<void(const std::string &, bool)> cleanup_cb,
+    std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder)
     : RaySyncerBidiReactorBase<ServerBidiReactor>(
           io_context,
           GetNodeIDFromServerContext(server_context),
-          std::move(message_processor)),
+          std::move(message_processor),
+          std::move(delta_encoder)),
       cleanup_cb_(std::move(cleanup_cb)),
       server_context_(server_context) {
   // Send the local node id to the remote
@@ -133,9 +135,13 @@ RayClientBidiReactor::RayClientBidiReactor(
     instrumented_io_context &io_context,
     std::function<void(std::shared_ptr<const RaySyncMessage>)> message_processor,
     std::function<void(const std::string &, bool)> cleanup_cb,
-    std::unique_ptr<ray::rpc::syncer::RaySyncer::Stub> stub)
+    std::unique_ptr<ray::rpc::syncer::RaySyncer::Stub> stub,
+    std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder)
     : RaySyncerBidiReactorBase<ClientBidiReactor>(
-          io_context, remote_node_id, std::move(message_processor)),
+          io_context,
+          remote_node_id,
+          std::move(message_processor),
+          std::move(delta_encoder)),
       cleanup_cb_(std::move(cleanup_cb)),
       stub_(std::move(stub)) {
   client_context_.AddMetadata("node_id", NodeID::FromBinary(local_node_id).Hex());
@@ -171,6 +177,8 @@ RaySyncer::RaySyncer(instrumented_io_context &io_context,
     : io_context_(io_context),
       local_node_id_(local_node_id),
       node_state_(std::make_unique<NodeState>()),
+      delta_encoder_(std::make_shared<SyncMessageDeltaEncoder>(
+          RayConfig::instance().ray_syncer_delta_full_message_interval())),
       timer_(io_context) {
   stopped_ = std::make_shared<bool>(false);
 }
@@ -213,6 +221,7 @@ void RaySyncer::Connect(const std::string &node_id,
                         std::shared_ptr<grpc::Channel> channel) {
   boost::asio::dispatch(
       io_context_.get_executor(), std::packaged_task<void()>([=]() {
+        channels_[node_id] = channel;
         auto stub = ray::rpc::syncer::RaySyncer::NewStub(channel);
         auto reactor = new RayClientBidiReactor(
             /* remote_node_id */ node_id,
@@ -226,6 +235,11 @@ void RaySyncer::Connect(const std::string &node_id,
                 execute_after(
                     io_context_,
                     [this, node_id, channel]() {
+                      // Don't reconnect if the node was disconnected in the meantime.
+                      auto iter = channels_.find(node_id);
+                      if (iter == channels_.end() || iter->second != channel) {
+                        return;
+                      }
                       RAY_LOG(INFO) << "Connection is broken. Reconnect to node: "
                                     << NodeID::FromBinary(node_id);
                       Connect(node_id, channel);
@@ -233,9 +247,11 @@ void RaySyncer::Connect(const std::string &node_id,
                     /* delay_microseconds = */ std::chrono::milliseconds(2000));
               } else {
                 node_state_->RemoveNode(node_id);
+                delta_encoder_->RemoveNode(node_id);
               }
             },
-            /* stub */ std::move(stub));
+            /* stub */ std::move(stub),
+            /* delta_encoder */ delta_encoder_);
         Connect(reactor);
         reactor->StartCall();
       }))
@@ -267,6 +283,7 @@ void RaySyncer::Connect(RaySyncerBidiReactor *reactor) {
 
 void RaySyncer::Disconnect(const std::string &node_id) {
   auto task = std::packaged_task<void()>([&]() {
+    channels_.erase(node_id);
     auto iter = sync_reactors_.find(node_id);
     if (iter == sync_reactors_.end()) {
       return;
@@ -354,7 +371,9 @@ ServerBidiReactor *RaySyncerService::StartSync(grpc::CallbackServerContext *cont
         RAY_CHECK(!reconnect);
         syncer_.sync_reactors_.erase(node_id);
         syncer_.node_state_->RemoveNode(node_id);
-      });
+        syncer_.delta_encoder_->RemoveNode(node_id);
+      },
+      syncer_.delta_encoder_);
   RAY_LOG(DEBUG) << "Get connection from "
                  << NodeID::FromBinary(reactor->GetRemoteNodeID()) << " to "
                  << NodeID::FromBinary(syncer_.GetLocalNodeID());
@@ -22,6 +22,7 @@
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/asio/periodical_runner.h"
 #include "ray/common/id.h"
+#include "ray/common/ray_syncer/sync_message_delta.h"
 #include "src/ray/protobuf/ray_syncer.grpc.pb.h"
 
 namespace ray {
@@ -177,9 +178,17 @@ class RaySyncer {
   /// Manage connections. Here the key is the NodeID in binary form.
   absl::flat_hash_map<std::string, RaySyncerBidiReactor *> sync_reactors_;
 
+  /// The channels of the nodes this node connected to, keyed by the NodeID in binary
+  /// form. A broken connection is only retried while its node is in here.
+  absl::flat_hash_map<std::string, std::shared_ptr<grpc::Channel>> channels_;
+
   /// The local node state
   std::unique_ptr<NodeState> node_state_;
 
+  /// Encodes the messages sent by all the connections as deltas. It's shared with
+  /// the connections, which may outlive the syncer.
+  std::shared_ptr<SyncMessageDeltaEncoder> delta_encoder_;
+
   /// Timer is used to do broadcasting.
   ray::PeriodicalRunner timer_;
 
@@ -192,6 +201,7 @@ class RaySyncer {
   FRIEND_TEST(SyncerTest, Test1ToN);
   FRIEND_TEST(SyncerTest, TestMToN);
   FRIEND_TEST(SyncerTest, Reconnect);
+  FRIEND_TEST(SyncerTest, DISABLED_AggregationScalingPerf);
 };
 
 /// RaySyncerService is a service to take care of resource synchronization
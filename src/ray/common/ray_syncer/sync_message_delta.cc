@@ -0,0 +1,170 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/common/ray_syncer/sync_message_delta.h"
+
+namespace ray {
+namespace syncer {
+
+using ray::rpc::syncer::ResourceViewDeltaSyncMessage;
+using ray::rpc::syncer::ResourceViewSyncMessage;
+
+namespace {
+
+using ResourceMap = google::protobuf::Map<std::string, double>;
+
+/// Record the entries of `resources` that differ from `base` in `updated`, and the
+/// entries only in `base` in `removed`.
+void DiffResources(const ResourceMap &base,
+                   const ResourceMap &resources,
+                   ResourceMap *updated,
+                   google::protobuf::RepeatedPtrField<std::string> *removed) {
+  for (const auto &[name, value] : resources) {
+    auto iter = base.find(name);
+    if (iter == base.end() || iter->second != value) {
+      (*updated)[name] = value;
+    }
+  }
+  for (const auto &[name, _] : base) {
+    if (!resources.contains(name)) {
+      removed->Add()->assign(name);
+    }
+  }
+}
+
+void PatchResources(const ResourceMap &updated,
+                    const google::protobuf::RepeatedPtrField<std::string> &removed,
+                    ResourceMap *resources) {
+  for (const auto &name : removed) {
+    resources->erase(name);
+  }
+  for (const auto &[name, value] : updated) {
+    (*resources)[name] = value;
+  }
+}
+
+}  // namespace
+
+std::shared_ptr<const RaySyncMessage> EncodeSyncMessageDelta(
+    const RaySyncMessage &base, const RaySyncMessage &message) {
+  if (message.message_type() != MessageType::RESOURCE_VIEW ||
+      base.message_type() != message.message_type() ||
+      base.node_id() != message.node_id() || base.is_delta() || message.is_delta()) {
+    return nullptr;
+  }
+  ResourceViewSyncMessage base_view;
+  ResourceViewSyncMessage view;
+  if (!base_view.ParseFromString(base.sync_message()) ||
+      !view.ParseFromString(message.sync_message())) {
+    return nullptr;
+  }
+
+  // Carry every field of the new view, except that the resource maps only keep the
+  // entries that changed since the base view.
+  ResourceMap resources_available;
+  ResourceMap resources_total;
+  resources_available.swap(*view.mutable_resources_available());
+  resources_total.swap(*view.mutable_resources_total());
+  ResourceViewDeltaSyncMessage delta;
+  auto *updated = delta.mutable_updated();
+  updated->Swap(&view);
+  DiffResources(base_view.resources_available(),
+                resources_available,
+                updated->mutable_resources_available(),
+                delta.mutable_resources_available_removed());
+  DiffResources(base_view.resources_total(),
+                resources_total,
+                updated->mutable_resources_total(),
+                delta.mutable_resources_total_removed());
+
+  std::string delta_bytes;
+  delta.SerializeToString(&delta_bytes);
+  if (delta_bytes.size() >= message.sync_message().size()) {
+    return nullptr;
+  }
+  auto delta_message = std::make_shared<RaySyncMessage>();
+  delta_message->set_version(message.version());
+  delta_message->set_message_type(message.message_type());
+  delta_message->set_node_id(message.node_id());
+  delta_message->set_sync_message(std::move(delta_bytes));
+  delta_message->set_is_delta(true);
+  delta_message->set_base_version(base.version());
+  return delta_message;
+}
+
+std::shared_ptr<const RaySyncMessage> ApplySyncMessageDelta(const RaySyncMessage &base,
+                                                            const RaySyncMessage &delta) {
+  if (!delta.is_delta() || base.is_delta() ||
+      delta.message_type() != MessageType::RESOURCE_VIEW ||
+      base.message_type() != delta.message_type() ||
+      base.node_id() != delta.node_id() || base.version() != delta.base_version()) {
+    return nullptr;
+  }
+  ResourceViewSyncMessage base_view;
+  ResourceViewDeltaSyncMessage view_delta;
+  if (!base_view.ParseFromString(base.sync_message()) ||
+      !view_delta.ParseFromString(delta.sync_message())) {
+    return nullptr;
+  }
+
+  // Every field comes from the delta, except that the resource maps are the ones of
+  // the base view with the changed entries patched in.
+  ResourceViewSyncMessage view;
+  view.Swap(view_delta.mutable_updated());
+  ResourceMap updated_available;
+  ResourceMap updated_total;
+  updated_available.swap(*view.mutable_resources_available());
+  updated_total.swap(*view.mutable_resources_total());
+  view.mutable_resources_available()->swap(*base_view.mutable_resources_available());
+  view.mutable_resources_total()->swap(*base_view.mutable_resources_total());
+  PatchResources(updated_available,
+                 view_delta.resources_available_removed(),
+                 view.mutable_resources_available());
+  PatchResources(updated_total,
+                 view_delta.resources_total_removed(),
+                 view.mutable_resources_total());
+
+  auto message = std::make_shared<RaySyncMessage>();
+  message->set_version(delta.version());
+  message->set_message_type(delta.message_type());
+  message->set_node_id(delta.node_id());
+  view.SerializeToString(message->mutable_sync_message());
+  return message;
+}
+
+std::shared_ptr<const RaySyncMessage> SyncMessageDeltaEncoder::Encode(
+    const RaySyncMessage &base, const RaySyncMessage &message) {
+  auto node_iter = cache_.find(message.node_id());
+  if (node_iter == cache_.end()) {
+    node_iter = cache_.emplace(message.node_id(), decltype(cache_)::mapped_type()).first;
+  }
+  auto &cached = node_iter->second[message.message_type()];
+  if (cached.version != message.version()) {
+    cached.version = message.version();
+    cached.deltas.clear();
+  }
+  auto iter = cached.deltas.find(base.version());
+  if (iter == cached.deltas.end()) {
+    iter = cached.deltas.emplace(base.version(), EncodeSyncMessageDelta(base, message))
+               .first;
+  }
+  return iter->second;
+}
+
+void SyncMessageDeltaEncoder::RemoveNode(const std::string &node_id) {
+  cache_.erase(node_id);
+}
+
+}  // namespace syncer
+}  // namespace ray
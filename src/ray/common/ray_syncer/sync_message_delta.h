@@ -0,0 +1,93 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "src/ray/protobuf/ray_syncer.pb.h"
+
+namespace ray {
+namespace syncer {
+
+using ray::rpc::syncer::MessageType;
+using ray::rpc::syncer::RaySyncMessage;
+
+/// Encode a RESOURCE_VIEW message as a delta against an earlier version of it.
+///
+/// \param base The message the receiver already has.
+/// \param message The message to be sent.
+///
+/// \return The delta message, or nullptr if the message can't be encoded as a delta
+/// or the delta isn't smaller than the message itself.
+std::shared_ptr<const RaySyncMessage> EncodeSyncMessageDelta(
+    const RaySyncMessage &base, const RaySyncMessage &message);
+
+/// Rebuild the full message from a delta made by EncodeSyncMessageDelta.
+///
+/// \param base The message the delta was encoded against.
+/// \param delta The delta message.
+///
+/// \return The full message, or nullptr if `delta` doesn't apply to `base`.
+std::shared_ptr<const RaySyncMessage> ApplySyncMessageDelta(const RaySyncMessage &base,
+                                                            const RaySyncMessage &delta);
+
+/// Delta encoder shared by all the connections of a syncer.
+///
+/// A node's new message is usually sent to many connections that all hold the same
+/// earlier version of it, so the encoder keeps the deltas of the latest version of each
+/// node's messages and only diffs each (base, message) pair once. All methods must be
+/// called from the syncer's io context.
+class SyncMessageDeltaEncoder {
+ public:
+  /// \param full_message_interval The number of deltas a connection sends for a
+  /// component before it sends the full message again. The full message lets the
+  /// receiver recover from a delta it failed to apply.
+  explicit SyncMessageDeltaEncoder(int64_t full_message_interval)
+      : full_message_interval_(full_message_interval) {}
+
+  /// Encode `message` as a delta against `base`.
+  ///
+  /// \return The delta message, or nullptr if the full message should be sent.
+  std::shared_ptr<const RaySyncMessage> Encode(const RaySyncMessage &base,
+                                               const RaySyncMessage &message);
+
+  /// Drop the cached deltas of a node.
+  void RemoveNode(const std::string &node_id);
+
+  int64_t FullMessageInterval() const { return full_message_interval_; }
+
+ private:
+  struct CachedDeltas {
+    /// The version of the message the deltas encode.
+    int64_t version = -1;
+    /// The deltas of that version keyed by their base version. nullptr means the
+    /// full message should be sent.
+    absl::flat_hash_map<int64_t, std::shared_ptr<const RaySyncMessage>> deltas;
+  };
+
+  const int64_t full_message_interval_;
+
+  /// The cached deltas by node id and message type.
+  absl::flat_hash_map<
+      std::string,
+      std::array<CachedDeltas, ray::rpc::syncer::MessageType_ARRAYSIZE>>
+      cache_;
+};
+
+}  // namespace syncer
+}  // namespace ray
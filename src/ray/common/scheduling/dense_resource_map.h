@@ -0,0 +1,258 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+#include "absl/container/inlined_vector.h"
+#include "ray/common/scheduling/fixed_point.h"
+#include "ray/common/scheduling/scheduling_ids.h"
+
+namespace ray {
+
+/// Map from resource IDs to quantities, laid out for whole-set arithmetic.
+///
+/// The predefined resources (CPU, memory, GPU and object store memory) are stored in a
+/// fixed-width array indexed by their ID, so comparing or subtracting two maps is a
+/// short loop over contiguous 64-bit values that the compiler can vectorize. The few
+/// custom resources of a set are kept in a small vector sorted by ID, so two maps are
+/// combined by merging rather than by hashing every ID.
+///
+/// A predefined resource whose value is 0 is absent from the map. Neither ResourceSet
+/// nor NodeResourceSet stores a predefined resource at 0, so this loses nothing.
+class DenseResourceMap {
+ public:
+  static constexpr size_t kNumPredefined = PredefinedResourcesEnum_MAX;
+  using value_type = std::pair<scheduling::ResourceID, FixedPoint>;
+  using PredefinedArray = std::array<FixedPoint, kNumPredefined>;
+  using CustomVector = absl::InlinedVector<value_type, 4>;
+
+  /// Iterates the resources of a map: the predefined ones in ID order, then the custom
+  /// ones in ID order.
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = DenseResourceMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const_iterator(const DenseResourceMap *map, size_t pos)
+        : map_(map), pos_(pos), current_(scheduling::ResourceID(-1), FixedPoint(0)) {
+      Settle();
+    }
+
+    reference operator*() const { return current_; }
+    pointer operator->() const { return &current_; }
+
+    const_iterator &operator++() {
+      pos_++;
+      Settle();
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &other) const { return pos_ == other.pos_; }
+    bool operator!=(const const_iterator &other) const { return pos_ != other.pos_; }
+
+   private:
+    /// Skip the absent predefined resources and load the entry at `pos_`.
+    void Settle() {
+      while (pos_ < kNumPredefined && map_->predefined_[pos_] == 0) {
+        pos_++;
+      }
+      if (pos_ < kNumPredefined) {
+        current_ = {scheduling::ResourceID(pos_), map_->predefined_[pos_]};
+      } else if (pos_ < kNumPredefined + map_->custom_.size()) {
+        current_ = map_->custom_[pos_ - kNumPredefined];
+      }
+    }
+
+    const DenseResourceMap *map_;
+    size_t pos_;
+    value_type current_;
+  };
+
+  /// Iterates the IDs of the resources of a map, in the same order as const_iterator.
+  class key_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = scheduling::ResourceID;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    explicit key_iterator(const_iterator it) : it_(it) {}
+
+    reference operator*() const { return it_->first; }
+    pointer operator->() const { return &it_->first; }
+
+    key_iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+
+    key_iterator operator++(int) {
+      key_iterator old = *this;
+      ++it_;
+      return old;
+    }
+
+    bool operator==(const key_iterator &other) const { return it_ == other.it_; }
+    bool operator!=(const key_iterator &other) const { return it_ != other.it_; }
+
+   private:
+    const_iterator it_;
+  };
+
+  /// A range over the IDs of the resources of a map. It is invalidated by any change
+  /// to the map.
+  class KeyRange {
+   public:
+    explicit KeyRange(const DenseResourceMap *map) : map_(map) {}
+    key_iterator begin() const { return key_iterator(map_->begin()); }
+    key_iterator end() const { return key_iterator(map_->end()); }
+
+   private:
+    const DenseResourceMap *map_;
+  };
+
+  DenseResourceMap() { predefined_.fill(FixedPoint(0)); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const {
+    return const_iterator(this, kNumPredefined + custom_.size());
+  }
+  KeyRange Keys() const { return KeyRange(this); }
+
+  /// Return the value of a resource, or nullptr if it is absent.
+  const FixedPoint *Find(scheduling::ResourceID resource_id) const {
+    if (resource_id.IsPredefinedResource()) {
+      const auto &value = predefined_[resource_id.ToInt()];
+      return value == 0 ? nullptr : &value;
+    }
+    auto it = LowerBound(resource_id);
+    if (it == custom_.end() || it->first != resource_id) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  bool Contains(scheduling::ResourceID resource_id) const {
+    return Find(resource_id) != nullptr;
+  }
+
+  /// Insert a resource or overwrite its value. Setting a predefined resource to 0
+  /// removes it.
+  void Set(scheduling::ResourceID resource_id, FixedPoint value) {
+    if (resource_id.IsPredefinedResource()) {
+      predefined_[resource_id.ToInt()] = value;
+      return;
+    }
+    auto it = LowerBound(resource_id);
+    if (it != custom_.end() && it->first == resource_id) {
+      it->second = value;
+    } else {
+      custom_.insert(it, {resource_id, value});
+    }
+  }
+
+  void Erase(scheduling::ResourceID resource_id) {
+    if (resource_id.IsPredefinedResource()) {
+      predefined_[resource_id.ToInt()] = FixedPoint(0);
+      return;
+    }
+    auto it = LowerBound(resource_id);
+    if (it != custom_.end() && it->first == resource_id) {
+      custom_.erase(it);
+    }
+  }
+
+  /// Remove the custom resources for which `pred(id, value)` is true.
+  template <typename Pred>
+  void EraseCustomIf(Pred pred) {
+    custom_.erase(std::remove_if(custom_.begin(),
+                                 custom_.end(),
+                                 [&pred](const value_type &entry) {
+                                   return pred(entry.first, entry.second);
+                                 }),
+                  custom_.end());
+  }
+
+  size_t Size() const {
+    size_t size = custom_.size();
+    for (const auto &value : predefined_) {
+      size += value != 0;
+    }
+    return size;
+  }
+
+  bool IsEmpty() const {
+    if (!custom_.empty()) {
+      return false;
+    }
+    for (const auto &value : predefined_) {
+      if (value != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Clear() {
+    predefined_.fill(FixedPoint(0));
+    custom_.clear();
+  }
+
+  bool operator==(const DenseResourceMap &other) const {
+    return predefined_ == other.predefined_ && custom_ == other.custom_;
+  }
+
+  bool operator!=(const DenseResourceMap &other) const { return !(*this == other); }
+
+  /// The values of the predefined resources, indexed by resource ID. Absent resources
+  /// are 0.
+  const PredefinedArray &Predefined() const { return predefined_; }
+  PredefinedArray &MutablePredefined() { return predefined_; }
+
+  /// The custom resources, sorted by ID.
+  const CustomVector &Custom() const { return custom_; }
+
+ private:
+  static bool IdLess(const value_type &entry, scheduling::ResourceID resource_id) {
+    return entry.first < resource_id;
+  }
+
+  CustomVector::iterator LowerBound(scheduling::ResourceID resource_id) {
+    return std::lower_bound(custom_.begin(), custom_.end(), resource_id, IdLess);
+  }
+
+  CustomVector::const_iterator LowerBound(scheduling::ResourceID resource_id) const {
+    return std::lower_bound(custom_.begin(), custom_.end(), resource_id, IdLess);
+  }
+
+  PredefinedArray predefined_;
+  CustomVector custom_;
+};
+
+}  // namespace ray
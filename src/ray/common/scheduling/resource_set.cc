@@ -64,75 +64,85 @@ ResourceSet ResourceSet::operator-(const ResourceSet &other) const {
 }
 
 ResourceSet &ResourceSet::operator+=(const ResourceSet &other) {
-  for (auto &entry : other.resources_) {
-    auto it = resources_.find(entry.first);
-    if (it != resources_.end()) {
-      it->second += entry.second;
-      if (it->second == 0) {
-        resources_.erase(it);
-      }
-    } else {
-      resources_.emplace(entry.first, entry.second);
-    }
+  auto &predefined = resources_.MutablePredefined();
+  const auto &other_predefined = other.resources_.Predefined();
+  for (size_t i = 0; i < DenseResourceMap::kNumPredefined; i++) {
+    predefined[i] += other_predefined[i];
+  }
+  for (const auto &[id, quantity] : other.resources_.Custom()) {
+    Set(id, Get(id) + quantity);
   }
   return *this;
 }
 
 ResourceSet &ResourceSet::operator-=(const ResourceSet &other) {
-  for (auto &entry : other.resources_) {
-    auto it = resources_.find(entry.first);
-    if (it != resources_.end()) {
-      it->second -= entry.second;
-      if (it->second == 0) {
-        resources_.erase(it);
-      }
-    } else {
-      resources_.emplace(entry.first, -entry.second);
-    }
+  auto &predefined = resources_.MutablePredefined();
+  const auto &other_predefined = other.resources_.Predefined();
+  for (size_t i = 0; i < DenseResourceMap::kNumPredefined; i++) {
+    predefined[i] -= other_predefined[i];
+  }
+  for (const auto &[id, quantity] : other.resources_.Custom()) {
+    Set(id, Get(id) - quantity);
   }
   return *this;
 }
 
 bool ResourceSet::operator<=(const ResourceSet &other) const {
-  // Check all resources that exist in this.
-  for (auto &entry : resources_) {
-    auto &this_value = entry.second;
-    auto other_value = FixedPoint(0);
-    auto it = other.resources_.find(entry.first);
-    if (it != other.resources_.end()) {
-      other_value = it->second;
-    }
-    if (this_value > other_value) {
-      return false;
-    }
+  // Absent resources count as 0 on both sides, so the predefined resources are
+  // compared slot by slot without branching.
+  const auto &predefined = resources_.Predefined();
+  const auto &other_predefined = other.resources_.Predefined();
+  bool result = true;
+  for (size_t i = 0; i < DenseResourceMap::kNumPredefined; i++) {
+    result &= predefined[i] <= other_predefined[i];
+  }
+  if (!result) {
+    return false;
   }
-  // Check all resources that exist in other, but not in this.
-  for (auto &entry : other.resources_) {
-    if (!resources_.contains(entry.first)) {
-      if (entry.second < 0) {
+  // Merge the custom resources, which are sorted by ID on both sides.
+  const auto &custom = resources_.Custom();
+  const auto &other_custom = other.resources_.Custom();
+  auto it = custom.begin();
+  auto other_it = other_custom.begin();
+  while (it != custom.end() || other_it != other_custom.end()) {
+    if (other_it == other_custom.end() ||
+        (it != custom.end() && it->first < other_it->first)) {
+      if (it->second > 0) {
         return false;
       }
+      it++;
+    } else if (it == custom.end() || other_it->first < it->first) {
+      if (other_it->second < 0) {
+        return false;
+      }
+      other_it++;
+    } else {
+      if (it->second > other_it->second) {
+        return false;
+      }
+      it++;
+      other_it++;
     }
   }
   return true;
 }
 
-bool ResourceSet::IsEmpty() const { return resources_.empty(); }
+bool ResourceSet::IsEmpty() const { return resources_.IsEmpty(); }
 
 FixedPoint ResourceSet::Get(ResourceID resource_id) const {
-  auto it = resources_.find(resource_id);
-  if (it == resources_.end()) {
+  const FixedPoint *quantity = resources_.Find(resource_id);
+  if (quantity == nullptr) {
     return FixedPoint(0);
   } else {
-    return it->second;
+    return *quantity;
   }
 }
 
 ResourceSet &ResourceSet::Set(ResourceID resource_id, FixedPoint value) {
   if (value == 0) {
-    resources_.erase(resource_id);
+    resources_.Erase(resource_id);
   } else {
-    resources_[resource_id] = value;
+    resources_.Set(resource_id, value);
   }
   return *this;
 }
@@ -191,34 +201,52 @@ NodeResourceSet::NodeResourceSet(
 
 NodeResourceSet &NodeResourceSet::Set(ResourceID resource_id, FixedPoint value) {
   if (value == ResourceDefaultValue(resource_id)) {
-    resources_.erase(resource_id);
+    resources_.Erase(resource_id);
   } else {
-    resources_[resource_id] = value;
+    resources_.Set(resource_id, value);
   }
   return *this;
 }
 
 FixedPoint NodeResourceSet::Get(ResourceID resource_id) const {
-  auto it = resources_.find(resource_id);
-  if (it == resources_.end()) {
+  const FixedPoint *quantity = resources_.Find(resource_id);
+  if (quantity == nullptr) {
     return ResourceDefaultValue(resource_id);
   } else {
-    return it->second;
+    return *quantity;
   }
 }
 
 bool NodeResourceSet::Has(ResourceID resource_id) const { return Get(resource_id) != 0; }
 
 NodeResourceSet &NodeResourceSet::operator-=(const ResourceSet &other) {
-  for (auto &entry : other.Resources()) {
-    Set(entry.first, Get(entry.first) - entry.second);
+  // Predefined resources default to 0, so an absent slot on either side is already
+  // the right operand.
+  auto &predefined = resources_.MutablePredefined();
+  const auto &other_predefined = other.Resources().Predefined();
+  for (size_t i = 0; i < DenseResourceMap::kNumPredefined; i++) {
+    predefined[i] -= other_predefined[i];
+  }
+  for (const auto &[id, quantity] : other.Resources().Custom()) {
+    Set(id, Get(id) - quantity);
   }
   return *this;
 }
 
 bool NodeResourceSet::operator>=(const ResourceSet &other) const {
-  for (auto &entry : other.Resources()) {
-    if (Get(entry.first) < entry.second) {
+  // Only the resources in `other` are compared: a node may hold a negative quantity of
+  // a resource that isn't requested.
+  const auto &predefined = resources_.Predefined();
+  const auto &other_predefined = other.Resources().Predefined();
+  bool result = true;
+  for (size_t i = 0; i < DenseResourceMap::kNumPredefined; i++) {
+    result &= (other_predefined[i] == 0) | (predefined[i] >= other_predefined[i]);
+  }
+  if (!result) {
+    return false;
+  }
+  for (const auto &[id, quantity] : other.Resources().Custom()) {
+    if (Get(id) < quantity) {
       return false;
     }
   }
@@ -246,13 +274,13 @@ absl::flat_hash_map<std::string, double> NodeResourceSet::GetResourceMap() const
 };
 
 void NodeResourceSet::RemoveNegative() {
-  for (auto it = resources_.begin(); it != resources_.end();) {
-    if (it->second < 0) {
-      resources_.erase(it++);
-    } else {
-      it++;
+  for (auto &quantity : resources_.MutablePredefined()) {
+    if (quantity < 0) {
+      quantity = FixedPoint(0);
     }
   }
+  resources_.EraseCustomIf(
+      [](ResourceID id, const FixedPoint &quantity) { return quantity < 0; });
 }
 
 std::set<ResourceID> NodeResourceSet::ExplicitResourceIds() const {
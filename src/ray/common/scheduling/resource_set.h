@@ -14,11 +14,12 @@
 
 #pragma once
 
-#include <boost/range/adaptor/map.hpp>
+#include <set>
 #include <string>
 #include <unordered_map>
 
 #include "absl/container/flat_hash_map.h"
+#include "ray/common/scheduling/dense_resource_map.h"
 #include "ray/common/scheduling/fixed_point.h"
 #include "ray/common/scheduling/scheduling_ids.h"
 
@@ -30,8 +31,7 @@ using scheduling::ResourceID;
 /// If any resource value is changed to 0, the resource will be removed.
 class ResourceSet {
  public:
-  using ResourceIdIterator =
-      boost::select_first_range<absl::flat_hash_map<ResourceID, FixedPoint>>;
+  using ResourceIdIterator = DenseResourceMap::KeyRange;
 
   static std::shared_ptr<ResourceSet> Nil() {
     static auto nil = std::make_shared<ResourceSet>();
@@ -95,24 +95,22 @@ class ResourceSet {
   ResourceSet &Set(ResourceID resource_id, FixedPoint value);
 
   /// Check whether a particular resource exist.
-  bool Has(ResourceID resource_id) const { return resources_.contains(resource_id); }
+  bool Has(ResourceID resource_id) const { return resources_.Contains(resource_id); }
 
   /// Return the number of resources in this set.
-  size_t Size() const { return resources_.size(); }
+  size_t Size() const { return resources_.Size(); }
 
   /// Clear the whole set.
-  void Clear() { resources_.clear(); }
+  void Clear() { resources_.Clear(); }
 
   /// Return true if the resource set is empty. False otherwise.
   bool IsEmpty() const;
 
-  /// Return a boost::range object that can be used as an iterator of the resource IDs.
-  ResourceIdIterator ResourceIds() const { return boost::adaptors::keys(resources_); }
+  /// Return a range object that can be used as an iterator of the resource IDs.
+  ResourceIdIterator ResourceIds() const { return resources_.Keys(); }
 
   /// Returns the underlying resource map.
-  const absl::flat_hash_map<ResourceID, FixedPoint> &Resources() const {
-    return resources_;
-  }
+  const DenseResourceMap &Resources() const { return resources_; }
 
   // TODO(atumanov): implement const_iterator class for the ResourceSet container.
   // TODO(williamma12): Make sure that everywhere we use doubles we don't
@@ -131,7 +129,7 @@ class ResourceSet {
 
  private:
   /// Map from the resource IDs to the resource values.
-  absl::flat_hash_map<ResourceID, FixedPoint> resources_;
+  DenseResourceMap resources_;
 };
 
 /// Represents a set of node resources and their values.
@@ -140,9 +138,6 @@ class ResourceSet {
 /// Negative values are valid in this set.
 class NodeResourceSet {
  public:
-  using ResourceIdIterator =
-      boost::select_first_range<absl::flat_hash_map<ResourceID, FixedPoint>>;
-
   NodeResourceSet(){};
 
   /// Constructs NodeResourceSet from the specified resource map.
@@ -194,7 +189,7 @@ class NodeResourceSet {
   /// Map from the resource IDs to the resource values.
   /// If the resource value is the default value for the resource
   /// it will be removed from the map.
-  absl::flat_hash_map<ResourceID, FixedPoint> resources_;
+  DenseResourceMap resources_;
 };
 
 }  // namespace ray
@@ -16,6 +16,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include <chrono>
+#include <deque>
 #include <sstream>
 #include <grpc/grpc.h>
 #include <grpcpp/create_channel.h>
@@ -56,6 +57,29 @@ RaySyncMessage MakeMessage(MessageType cid, int64_t version, const NodeID &id) {
   return msg;
 }
 
+RaySyncMessage MakeResourceViewMessage(
+    int64_t version,
+    const NodeID &id,
+    const absl::flat_hash_map<std::string, double> &resources_available) {
+  ResourceViewSyncMessage resource_view;
+  for (const auto &[name, value] : resources_available) {
+    (*resource_view.mutable_resources_available())[name] = value;
+  }
+  for (const auto &[name, value] :
+       absl::flat_hash_map<std::string, double>({{"CPU", 64},
+                                                 {"GPU", 8},
+                                                 {"memory", 256e9},
+                                                 {"object_store_memory", 64e9},
+                                                 {"node:" + id.Hex(), 1},
+                                                 {"accelerator_type:A100", 1}})) {
+    (*resource_view.mutable_resources_total())[name] = value;
+  }
+  resource_view.set_idle_duration_ms(version);
+  auto msg = MakeMessage(MessageType::RESOURCE_VIEW, version, id);
+  resource_view.SerializeToString(msg.mutable_sync_message());
+  return msg;
+}
+
 class RaySyncerTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -198,6 +222,144 @@ TEST_F(RaySyncerTest, RaySyncerBidiReactorBase) {
       3, sync_reactor.node_versions_[from_node_id.Binary()][MessageType::RESOURCE_VIEW]);
 }
 
+TEST_F(RaySyncerTest, SyncMessageDelta) {
+  auto node_id = NodeID::FromRandom();
+  auto base = MakeResourceViewMessage(1, node_id, {{"CPU", 64}, {"GPU", 8}, {"a", 1}});
+  auto msg = MakeResourceViewMessage(2, node_id, {{"CPU", 60}, {"GPU", 8}});
+  // The fields other than the resource maps are carried over in full.
+  ResourceViewSyncMessage view;
+  ASSERT_TRUE(view.ParseFromString(msg.sync_message()));
+  view.set_is_draining(true);
+  view.set_draining_deadline_timestamp_ms(100);
+  view.add_node_activity("busy");
+  msg.set_sync_message(view.SerializeAsString());
+
+  auto delta = EncodeSyncMessageDelta(base, msg);
+  ASSERT_NE(nullptr, delta);
+  ASSERT_TRUE(delta->is_delta());
+  ASSERT_EQ(1, delta->base_version());
+  ASSERT_EQ(2, delta->version());
+  ASSERT_LT(delta->sync_message().size(), msg.sync_message().size());
+
+  auto full = ApplySyncMessageDelta(base, *delta);
+  ASSERT_NE(nullptr, full);
+  ResourceViewSyncMessage expected;
+  ResourceViewSyncMessage actual;
+  ASSERT_TRUE(expected.ParseFromString(msg.sync_message()));
+  ASSERT_TRUE(actual.ParseFromString(full->sync_message()));
+  ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(expected, actual));
+  ASSERT_EQ(msg.version(), full->version());
+  ASSERT_FALSE(full->is_delta());
+
+  // A delta only applies to its base version.
+  base.set_version(0);
+  ASSERT_EQ(nullptr, ApplySyncMessageDelta(base, *delta));
+
+  // Other components are always sent in full.
+  auto commands = MakeMessage(MessageType::COMMANDS, 2, node_id);
+  ASSERT_EQ(nullptr,
+            EncodeSyncMessageDelta(MakeMessage(MessageType::COMMANDS, 1, node_id),
+                                   commands));
+}
+
+TEST_F(RaySyncerTest, RaySyncerBidiReactorBaseDelta) {
+  auto encoder = std::make_shared<SyncMessageDeltaEncoder>(/*full_message_interval=*/2);
+  std::vector<std::shared_ptr<const RaySyncMessage>> received;
+  MockRaySyncerBidiReactorBase<MockReactor> sender(
+      io_context_,
+      NodeID::FromRandom().Binary(),
+      [](std::shared_ptr<const RaySyncMessage>) {},
+      encoder);
+  MockRaySyncerBidiReactorBase<MockReactor> receiver(
+      io_context_,
+      NodeID::FromRandom().Binary(),
+      [&received](std::shared_ptr<const RaySyncMessage> msg) {
+        received.push_back(msg);
+      });
+
+  auto from_node_id = NodeID::FromRandom();
+  std::vector<bool> sent_as_delta;
+  for (int64_t version = 1; version <= 4; ++version) {
+    auto msg = std::make_shared<RaySyncMessage>(MakeResourceViewMessage(
+        version, from_node_id, {{"CPU", 64 - version}, {"GPU", 8}}));
+    ASSERT_TRUE(sender.PushToSendingQueue(msg));
+    auto sent = sender.sending_message_;
+    sent_as_delta.push_back(sent->is_delta());
+    receiver.ReceiveUpdate(sent);
+    sender.SendNext();
+
+    ASSERT_EQ(version, received.size());
+    ASSERT_FALSE(received.back()->is_delta());
+    ResourceViewSyncMessage expected;
+    ResourceViewSyncMessage actual;
+    ASSERT_TRUE(expected.ParseFromString(msg->sync_message()));
+    ASSERT_TRUE(actual.ParseFromString(received.back()->sync_message()));
+    ASSERT_TRUE(google::protobuf::util::MessageDifferencer::Equals(expected, actual));
+  }
+  // The full message is sent again after two deltas.
+  ASSERT_EQ(std::vector<bool>({false, true, true, false}), sent_as_delta);
+
+  // A delta whose base the receiver doesn't have is dropped.
+  auto base = MakeResourceViewMessage(10, from_node_id, {{"CPU", 1}});
+  auto msg = MakeResourceViewMessage(11, from_node_id, {{"CPU", 2}});
+  receiver.ReceiveUpdate(EncodeSyncMessageDelta(base, msg));
+  ASSERT_EQ(4, received.size());
+}
+
+TEST_F(RaySyncerTest, DISABLED_RaySyncerBidiReactorBaseDeltaPerf) {
+  // Simulate the GCS broadcasting the resource views of N nodes to the N nodes. In
+  // each round a tenth of the nodes report a change of their available resources.
+  const int num_nodes = 1000;
+  const int num_rounds = 20;
+  std::vector<NodeID> node_ids;
+  for (int i = 0; i < num_nodes; ++i) {
+    node_ids.push_back(NodeID::FromRandom());
+  }
+
+  for (int64_t interval : {0, 20}) {
+    auto encoder = std::make_shared<SyncMessageDeltaEncoder>(interval);
+    std::vector<std::unique_ptr<MockRaySyncerBidiReactorBase<MockReactor>>> reactors;
+    for (const auto &node_id : node_ids) {
+      reactors.push_back(std::make_unique<MockRaySyncerBidiReactorBase<MockReactor>>(
+          io_context_,
+          node_id.Binary(),
+          [](std::shared_ptr<const RaySyncMessage>) {},
+          encoder));
+    }
+
+    size_t bytes_sent = 0;
+    auto start = steady_clock::now();
+    for (int round = 0; round <= num_rounds; ++round) {
+      // All nodes report in the first round, which isn't measured.
+      if (round == 1) {
+        bytes_sent = 0;
+        start = steady_clock::now();
+      }
+      for (int i = 0; i < num_nodes; ++i) {
+        if (round != 0 && (i + round) % 10 != 0) {
+          continue;
+        }
+        auto msg = std::make_shared<RaySyncMessage>(MakeResourceViewMessage(
+            round, node_ids[i], {{"CPU", 64 - round % 64}, {"memory", 256e9 - round}}));
+        for (auto &reactor : reactors) {
+          reactor->PushToSendingQueue(msg);
+        }
+      }
+      for (auto &reactor : reactors) {
+        while (reactor->sending_) {
+          // Serialize the message like gRPC does when writing it to the stream.
+          bytes_sent += reactor->sending_message_->SerializeAsString().size();
+          reactor->SendNext();
+        }
+      }
+    }
+    auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start).count();
+    RAY_LOG(INFO) << "full_message_interval=" << interval << ": sent " << bytes_sent
+                  << " bytes in " << num_rounds << " rounds to " << num_nodes
+                  << " nodes, took " << elapsed << "ms";
+  }
+}
+
 struct SyncerServerTest {
   SyncerServerTest(std::string port) : work_guard(io_context.get_executor()) {
     this->server_port = port;
@@ -785,6 +947,213 @@ TEST_F(SyncerTest, TestMToN) {
   ASSERT_TRUE(TestCorrectness(get_cluster_view, servers, g));
 }
 
+/// Runs syncers from one thread as if each had a machine of its own. Each syncer runs
+/// on its own io context and has its own clock, which advances by the time spent
+/// polling its context and by waiting for the messages it receives. Network delay is
+/// ignored.
+struct SimulatedCluster {
+  explicit SimulatedCluster(size_t num_syncers) : clocks(num_syncers), cpu(num_syncers) {
+    for (size_t i = 0; i < num_syncers; ++i) {
+      io_contexts.push_back(std::make_unique<instrumented_io_context>());
+    }
+  }
+
+  /// The clock of the syncer being polled.
+  int64_t Now() const {
+    return clocks[polling] + (steady_clock::now() - poll_start).count();
+  }
+
+  /// Make the syncer being polled wait until `time` on its clock.
+  void WaitUntil(int64_t time) {
+    auto now = Now();
+    if (time > now) {
+      clocks[polling] += time - now;
+    }
+  }
+
+  /// Start all the clocks at the latest one.
+  void SyncClocks() {
+    auto latest = *std::max_element(clocks.begin(), clocks.end());
+    std::fill(clocks.begin(), clocks.end(), latest);
+  }
+
+  /// Poll the io contexts in turn until none of them has work left.
+  void Run() {
+    bool busy = true;
+    while (busy) {
+      busy = false;
+      for (polling = 0; polling < io_contexts.size(); ++polling) {
+        io_contexts[polling]->restart();
+        poll_start = steady_clock::now();
+        busy |= io_contexts[polling]->poll() > 0;
+        auto elapsed = (steady_clock::now() - poll_start).count();
+        clocks[polling] += elapsed;
+        cpu[polling] += elapsed;
+      }
+    }
+    polling = 0;
+  }
+
+  std::vector<std::unique_ptr<instrumented_io_context>> io_contexts;
+  /// The clock of each syncer in nanoseconds.
+  std::vector<int64_t> clocks;
+  /// The time spent polling each io context in nanoseconds.
+  std::vector<int64_t> cpu;
+  size_t polling = 0;
+  steady_clock::time_point poll_start;
+};
+
+/// One end of an in-process stream between two syncers of a SimulatedCluster. Messages
+/// are serialized like gRPC does and delivered on the io context of the other end.
+struct LocalStream {
+  void StartRead(RaySyncMessage *message) {
+    reading = message;
+    cluster->io_contexts[index]->post([this]() { Deliver(); }, "");
+  }
+
+  void StartWrite(const RaySyncMessage *message,
+                  grpc::WriteOptions opts = grpc::WriteOptions()) {
+    auto sent_at = cluster->Now();
+    cluster->io_contexts[peer->index]->post(
+        [peer = peer, bytes = message->SerializeAsString(), sent_at]() {
+          peer->cluster->WaitUntil(sent_at);
+          peer->inbox.emplace_back();
+          peer->inbox.back().ParseFromString(bytes);
+          peer->Deliver();
+        },
+        "");
+    cluster->io_contexts[index]->post([this]() { OnWriteDone(true); }, "");
+  }
+
+  void Deliver() {
+    if (reading == nullptr || inbox.empty()) {
+      return;
+    }
+    *reading = std::move(inbox.front());
+    inbox.pop_front();
+    reading = nullptr;
+    OnReadDone(true);
+  }
+
+  virtual void OnWriteDone(bool ok) {}
+  virtual void OnReadDone(bool ok) {}
+
+  SimulatedCluster *cluster = nullptr;
+  /// The index of the syncer of this end.
+  size_t index = 0;
+  LocalStream *peer = nullptr;
+  RaySyncMessage *reading = nullptr;
+  std::deque<RaySyncMessage> inbox;
+};
+
+using LocalReactor = MockRaySyncerBidiReactorBase<LocalStream>;
+
+TEST_F(SyncerTest, DISABLED_AggregationScalingPerf) {
+  // Simulate N raylets syncing with the GCS either directly or through an aggregator
+  // per group of 50 nodes. In each round a tenth of the nodes report a change of their
+  // available resources. Report the time the GCS spends per round and the time it
+  // takes for the round's updates to reach every node.
+  const int num_rounds = 10;
+  const size_t group_size = 50;
+  for (size_t num_nodes : {1000, 5000}) {
+    for (bool aggregate : {false, true}) {
+      // The GCS is syncer 0.
+      SimulatedCluster cluster(num_nodes + 1);
+      std::vector<NodeID> node_ids;
+      std::vector<std::unique_ptr<RaySyncer>> syncers;
+      for (size_t i = 0; i <= num_nodes; ++i) {
+        node_ids.push_back(NodeID::FromRandom());
+        syncers.push_back(
+            std::make_unique<RaySyncer>(*cluster.io_contexts[i], node_ids[i].Binary()));
+      }
+
+      int64_t latest_arrival = 0;
+      std::vector<std::unique_ptr<LocalReactor>> reactors;
+      auto make_reactor = [&](size_t from, size_t to) {
+        auto &syncer = *syncers[from];
+        auto reactor = std::make_unique<LocalReactor>(
+            *cluster.io_contexts[from],
+            node_ids[to].Binary(),
+            [&cluster, &latest_arrival, &syncer](auto message) {
+              latest_arrival = std::max(latest_arrival, cluster.Now());
+              syncer.BroadcastRaySyncMessage(message);
+            },
+            syncer.delta_encoder_);
+        EXPECT_CALL(*reactor, DoDisconnect()).Times(testing::AnyNumber());
+        reactor->cluster = &cluster;
+        reactor->index = from;
+        reactors.push_back(std::move(reactor));
+        return reactors.back().get();
+      };
+      auto connect = [&](size_t child, size_t parent) {
+        auto up = make_reactor(child, parent);
+        auto down = make_reactor(parent, child);
+        up->peer = down;
+        down->peer = up;
+        for (auto [index, reactor] :
+             {std::make_pair(child, up), std::make_pair(parent, down)}) {
+          cluster.io_contexts[index]->post(
+              [&syncer = *syncers[index], reactor = reactor]() {
+                syncer.Connect(reactor);
+                reactor->StartPull();
+              },
+              "");
+        }
+      };
+      size_t num_gcs_streams = 0;
+      for (size_t i = 1; i <= num_nodes; ++i) {
+        size_t aggregator = (i - 1) / group_size * group_size + 1;
+        if (!aggregate || i == aggregator) {
+          connect(i, 0);
+          ++num_gcs_streams;
+        } else {
+          connect(i, aggregator);
+        }
+      }
+      cluster.Run();
+
+      int64_t gcs_cpu = 0;
+      int64_t latency = 0;
+      int64_t max_latency = 0;
+      for (int round = 0; round <= num_rounds; ++round) {
+        // All nodes report in the first round, which isn't measured.
+        if (round == 1) {
+          gcs_cpu = cluster.cpu[0];
+          latency = 0;
+          max_latency = 0;
+        }
+        cluster.SyncClocks();
+        auto round_start = cluster.clocks[0];
+        latest_arrival = round_start;
+        for (size_t i = 1; i <= num_nodes; ++i) {
+          if (round != 0 && (i + round) % 10 != 0) {
+            continue;
+          }
+          syncers[i]->BroadcastRaySyncMessage(
+              std::make_shared<RaySyncMessage>(MakeResourceViewMessage(
+                  round,
+                  node_ids[i],
+                  {{"CPU", 64 - round % 64}, {"memory", 256e9 - round}})));
+        }
+        cluster.Run();
+        latency += latest_arrival - round_start;
+        max_latency = std::max(max_latency, latest_arrival - round_start);
+      }
+      RAY_LOG(INFO) << num_nodes << " nodes, "
+                    << (aggregate ? "groups of " + std::to_string(group_size)
+                                  : std::string("flat"))
+                    << ": " << num_gcs_streams << " GCS streams, GCS busy "
+                    << (cluster.cpu[0] - gcs_cpu) / num_rounds / 1000
+                    << "us per round, propagation latency avg "
+                    << latency / num_rounds / 1000 << "us max " << max_latency / 1000
+                    << "us";
+
+      syncers.clear();
+      cluster.Run();
+    }
+  }
+}
+
 struct MockRaySyncerService : public ray::rpc::syncer::RaySyncer::CallbackService {
   MockRaySyncerService(
       instrumented_io_context &_io_context,
@@ -12,10 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "gtest/gtest.h"
 #include "ray/common/scheduling/cluster_resource_data.h"
+#include "ray/common/scheduling/dense_resource_map.h"
 
 namespace ray {
 
@@ -145,6 +148,152 @@ TEST_F(ResourceRequestTest, TestOperators) {
   ASSERT_EQ(r4.ToResourceMap(), expected);
 }
 
+TEST_F(ResourceRequestTest, TestDenseResourceMap) {
+  auto cpu_id = ResourceID::CPU();
+  auto gpu_id = ResourceID::GPU();
+  auto custom_id1 = ResourceID("custom1");
+  auto custom_id2 = ResourceID("custom2");
+
+  DenseResourceMap map;
+  ASSERT_TRUE(map.IsEmpty());
+  map.Set(custom_id2, 3);
+  map.Set(gpu_id, 2);
+  map.Set(custom_id1, 1);
+  map.Set(cpu_id, 4);
+  ASSERT_EQ(map.Size(), 4);
+  ASSERT_EQ(*map.Find(cpu_id), 4);
+  ASSERT_EQ(*map.Find(custom_id2), 3);
+  ASSERT_EQ(map.Find(ResourceID::Memory()), nullptr);
+
+  // Predefined resources come first, then custom resources sorted by ID.
+  std::vector<ResourceID> expected_ids({cpu_id, gpu_id});
+  std::vector<ResourceID> custom_ids({custom_id1, custom_id2});
+  std::sort(custom_ids.begin(), custom_ids.end());
+  expected_ids.insert(expected_ids.end(), custom_ids.begin(), custom_ids.end());
+  auto keys = map.Keys();
+  ASSERT_EQ(std::vector<ResourceID>(keys.begin(), keys.end()), expected_ids);
+
+  // A predefined resource set to 0 is absent.
+  map.Set(gpu_id, 0);
+  ASSERT_FALSE(map.Contains(gpu_id));
+  map.Erase(custom_id1);
+  ASSERT_FALSE(map.Contains(custom_id1));
+  ASSERT_EQ(map.Size(), 2);
+
+  DenseResourceMap other;
+  other.Set(custom_id2, 3);
+  other.Set(cpu_id, 4);
+  ASSERT_EQ(map, other);
+  map.Clear();
+  ASSERT_TRUE(map.IsEmpty());
+}
+
+/// A cluster for the perf tests below. Each node has the predefined resources and a
+/// few custom ones.
+std::vector<NodeResources> MakePerfNodes(int num_nodes) {
+  std::vector<NodeResources> nodes;
+  for (int i = 0; i < num_nodes; i++) {
+    absl::flat_hash_map<std::string, double> total(
+        {{"CPU", 16}, {"memory", 64}, {"object_store_memory", 32}});
+    if (i % 4 == 0) {
+      total["GPU"] = 4;
+    }
+    total["zone" + std::to_string(i % 8)] = 1;
+    total["node:" + std::to_string(i)] = 1;
+    nodes.push_back(ResourceMapToNodeResources(total, total));
+  }
+  return nodes;
+}
+
+/// A mixed task queue for the perf tests below.
+std::vector<ResourceRequest> MakePerfRequests(int num_requests) {
+  std::vector<ResourceRequest> requests;
+  for (int i = 0; i < num_requests; i++) {
+    absl::flat_hash_map<std::string, double> request({{"CPU", 1 + i % 16}});
+    if (i % 3 == 0) {
+      request["GPU"] = 1;
+    }
+    if (i % 5 == 0) {
+      request["zone" + std::to_string(i % 8)] = 0.5;
+    }
+    requests.push_back(ResourceMapToResourceRequest(request, false));
+  }
+  return requests;
+}
+
+TEST_F(ResourceRequestTest, DISABLED_IsAvailablePerf) {
+  // Feasibility scan of a mixed task queue over a cluster, the inner loop of
+  // scheduling.
+  const int num_nodes = 1000;
+  const int num_requests = 100;
+  std::vector<NodeResources> nodes = MakePerfNodes(num_nodes);
+  std::vector<ResourceRequest> requests = MakePerfRequests(num_requests);
+
+  auto start = std::chrono::steady_clock::now();
+  int64_t num_available = 0;
+  for (int round = 0; round < 100; round++) {
+    for (const auto &request : requests) {
+      for (const auto &node : nodes) {
+        num_available += node.IsAvailable(request);
+      }
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  RAY_LOG(INFO) << "Checked " << 100 * num_requests * num_nodes << " (request, node) "
+                << "pairs in " << elapsed.count() << "us, " << num_available
+                << " available.";
+}
+
+TEST_F(ResourceRequestTest, DISABLED_ResourceSetArithmeticPerf) {
+  // The resource set operations of placing tasks on a local copy of the cluster view:
+  // copy the view of a node, take a request from it and compare requests.
+  const int num_nodes = 1000;
+  const int num_requests = 100;
+  std::vector<NodeResources> nodes = MakePerfNodes(num_nodes);
+  std::vector<ResourceRequest> requests = MakePerfRequests(num_requests);
+
+  auto start = std::chrono::steady_clock::now();
+  int64_t num_copies = 0;
+  for (int round = 0; round < 1000; round++) {
+    for (const auto &node : nodes) {
+      NodeResources copy = node;
+      num_copies += copy.available.Has(ResourceID::CPU());
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  RAY_LOG(INFO) << "Copied " << num_copies << " nodes in " << elapsed.count() << "us.";
+
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < 10; round++) {
+    for (const auto &request : requests) {
+      for (auto &node : nodes) {
+        node.available -= request.GetResourceSet();
+      }
+    }
+  }
+  elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  RAY_LOG(INFO) << "Took " << 10 * num_requests * num_nodes << " requests from nodes in "
+                << elapsed.count() << "us.";
+
+  start = std::chrono::steady_clock::now();
+  int64_t num_fits = 0;
+  for (int round = 0; round < 1000; round++) {
+    for (const auto &request : requests) {
+      for (const auto &other : requests) {
+        num_fits += request.GetResourceSet() <= other.GetResourceSet();
+      }
+    }
+  }
+  elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  RAY_LOG(INFO) << "Compared " << 1000 * num_requests * num_requests
+                << " pairs of requests in " << elapsed.count() << "us, " << num_fits
+                << " fit.";
+}
+
 class TaskResourceInstancesTest : public ::testing::Test {};
 
 TEST_F(TaskResourceInstancesTest, TestBasic) {
@@ -395,8 +395,8 @@ CoreWorker::CoreWorker(const CoreWorkerOptions &options, const WorkerID &worker_
       memory_store_,
       reference_counter_,
       /*put_in_local_plasma_callback=*/
-      [this](const RayObject &object, const ObjectID &object_id) {
-        RAY_CHECK_OK(PutInLocalPlasmaStore(object, object_id, /*pin_object=*/true));
+      [this](const RayObject &object, const std::vector<ObjectID> &object_ids) {
+        RAY_CHECK_OK(PutInLocalPlasmaStore(object, object_ids, /*pin_object=*/true));
       },
       /* retry_task_callback= */
       [this](TaskSpecification &spec,
@@ -1216,32 +1216,41 @@ Status CoreWorker::Put(const RayObject &object,
 }
 
 Status CoreWorker::PutInLocalPlasmaStore(const RayObject &object,
-                                         const ObjectID &object_id,
+                                         const std::vector<ObjectID> &object_ids,
                                          bool pin_object) {
-  bool object_exists;
-  RAY_RETURN_NOT_OK(plasma_store_provider_->Put(
-      object, object_id, /* owner_address = */ rpc_address_, &object_exists));
-  if (!object_exists) {
+  std::vector<ObjectID> created_object_ids;
+  RAY_RETURN_NOT_OK(plasma_store_provider_->PutBatch(
+      object, object_ids, /* owner_address = */ rpc_address_, &created_object_ids));
+  if (!created_object_ids.empty()) {
     if (pin_object) {
-      // Tell the raylet to pin the object **after** it is created.
-      RAY_LOG(DEBUG) << "Pinning put object " << object_id;
+      // Tell the raylet to pin the objects **after** they are created.
+      RAY_LOG(DEBUG) << "Pinning " << created_object_ids.size()
+                     << " put objects, first " << created_object_ids[0];
       local_raylet_client_->PinObjectIDs(
           rpc_address_,
-          {object_id},
+          created_object_ids,
           /*generator_id=*/ObjectID::Nil(),
-          [this, object_id](const Status &status, const rpc::PinObjectIDsReply &reply) {
-            // Only release the object once the raylet has responded to avoid the race
-            // condition that the object could be evicted before the raylet pins it.
-            if (!plasma_store_provider_->Release(object_id).ok()) {
-              RAY_LOG(ERROR) << "Failed to release ObjectID (" << object_id
-                             << "), might cause a leak in plasma.";
+          [this, created_object_ids](const Status &status,
+                                     const rpc::PinObjectIDsReply &reply) {
+            // Only release the objects once the raylet has responded to avoid the race
+            // condition that the objects could be evicted before the raylet pins them.
+            for (const auto &object_id : created_object_ids) {
+              if (!plasma_store_provider_->Release(object_id).ok()) {
+                RAY_LOG(ERROR) << "Failed to release ObjectID (" << object_id
+                               << "), might cause a leak in plasma.";
+              }
             }
           });
     } else {
-      RAY_RETURN_NOT_OK(plasma_store_provider_->Release(object_id));
+      for (const auto &object_id : created_object_ids) {
+        RAY_RETURN_NOT_OK(plasma_store_provider_->Release(object_id));
+      }
     }
   }
-  RAY_CHECK(memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
+  for (const auto &object_id : object_ids) {
+    RAY_CHECK(
+        memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
+  }
   return Status::OK();
 }
 
@@ -1255,7 +1264,7 @@ Status CoreWorker::Put(const RayObject &object,
     RAY_CHECK(memory_store_->Put(object, object_id));
     return Status::OK();
   }
-  return PutInLocalPlasmaStore(object, object_id, pin_object);
+  return PutInLocalPlasmaStore(object, {object_id}, pin_object);
 }
 
 Status CoreWorker::CreateOwnedAndIncrementLocalRef(
@@ -2788,6 +2797,96 @@ Status CoreWorker::AllocateReturnObject(const ObjectID &object_id,
   return Status::OK();
 }
 
+Status CoreWorker::AllocateReturnObjects(
+    const std::vector<ObjectID> &object_ids,
+    const std::vector<size_t> &data_sizes,
+    const std::vector<std::shared_ptr<Buffer>> &metadata,
+    const std::vector<std::vector<ObjectID>> &contained_object_ids,
+    const rpc::Address &caller_address,
+    int64_t *task_output_inlined_bytes,
+    std::vector<std::shared_ptr<RayObject>> *return_objects) {
+  RAY_CHECK(data_sizes.size() == object_ids.size() &&
+            metadata.size() == object_ids.size() &&
+            contained_object_ids.size() == object_ids.size());
+  RAY_CHECK(!options_.is_local_mode);
+  rpc::Address owner_address(caller_address);
+
+  // Decide which objects are inlined, in order, like AllocateReturnObject would.
+  int64_t inlined_bytes = *task_output_inlined_bytes;
+  std::vector<size_t> plasma_indices;
+  for (size_t i = 0; i < object_ids.size(); i++) {
+    const int64_t data_size = static_cast<int64_t>(data_sizes[i]);
+    if (data_size == 0) {
+      continue;
+    }
+    if (data_size < max_direct_call_object_size_ &&
+        inlined_bytes + data_size <=
+            RayConfig::instance().task_rpc_inlined_bytes_limit()) {
+      inlined_bytes += data_size;
+    } else {
+      plasma_indices.push_back(i);
+    }
+  }
+
+  std::vector<std::shared_ptr<Buffer>> plasma_buffers;
+  if (plasma_indices.size() > 1) {
+    std::vector<std::shared_ptr<Buffer>> plasma_metadata;
+    std::vector<size_t> plasma_data_sizes;
+    std::vector<ObjectID> plasma_object_ids;
+    for (size_t i : plasma_indices) {
+      plasma_metadata.push_back(metadata[i]);
+      plasma_data_sizes.push_back(data_sizes[i]);
+      plasma_object_ids.push_back(object_ids[i]);
+    }
+    RAY_LOG(DEBUG) << "Creating " << plasma_object_ids.size()
+                   << " return objects, first " << plasma_object_ids[0];
+    RAY_RETURN_NOT_OK(plasma_store_provider_->CreateBatch(plasma_metadata,
+                                                          plasma_data_sizes,
+                                                          plasma_object_ids,
+                                                          owner_address,
+                                                          &plasma_buffers));
+  } else if (plasma_indices.size() == 1) {
+    size_t i = plasma_indices[0];
+    RAY_LOG(DEBUG) << "Creating return object " << object_ids[i];
+    plasma_buffers.emplace_back();
+    RAY_RETURN_NOT_OK(CreateExisting(metadata[i],
+                                     data_sizes[i],
+                                     object_ids[i],
+                                     owner_address,
+                                     &plasma_buffers[0],
+                                     /*created_by_worker=*/true));
+  }
+  *task_output_inlined_bytes = inlined_bytes;
+
+  return_objects->assign(object_ids.size(), nullptr);
+  size_t next_plasma_index = 0;
+  for (size_t i = 0; i < object_ids.size(); i++) {
+    std::shared_ptr<Buffer> data_buffer;
+    if (data_sizes[i] > 0) {
+      // Mark this object as containing other object IDs. The ref counter will
+      // keep the inner IDs in scope until the outer one is out of scope.
+      if (!contained_object_ids[i].empty()) {
+        reference_counter_->AddNestedObjectIds(
+            object_ids[i], contained_object_ids[i], owner_address);
+      }
+      if (next_plasma_index < plasma_indices.size() &&
+          plasma_indices[next_plasma_index] == i) {
+        data_buffer = plasma_buffers[next_plasma_index++];
+        if (data_buffer == nullptr) {
+          // Leave the return object as a nullptr if the object already exists.
+          continue;
+        }
+      } else {
+        data_buffer = std::make_shared<LocalMemoryBuffer>(data_sizes[i]);
+      }
+    }
+    auto contained_refs = GetObjectRefs(contained_object_ids[i]);
+    (*return_objects)[i] =
+        std::make_shared<RayObject>(data_buffer, metadata[i], std::move(contained_refs));
+  }
+  return Status::OK();
+}
+
 Status CoreWorker::ExecuteTask(
     const TaskSpecification &task_spec,
     const std::shared_ptr<ResourceMappingType> &resource_ids,
@@ -3026,6 +3125,64 @@ Status CoreWorker::SealReturnObject(const ObjectID &return_id,
   return status;
 }
 
+Status CoreWorker::SealReturnObjects(
+    const std::vector<ObjectID> &return_ids,
+    const std::vector<std::shared_ptr<RayObject>> &return_objects,
+    const ObjectID &generator_id,
+    const rpc::Address &caller_address) {
+  RAY_CHECK(return_ids.size() == return_objects.size());
+  RAY_CHECK(!options_.is_local_mode);
+  std::vector<ObjectID> plasma_object_ids;
+  size_t last_plasma_index = 0;
+  for (size_t i = 0; i < return_ids.size(); i++) {
+    const auto &return_object = return_objects[i];
+    if (return_object != nullptr && return_object->GetData() != nullptr &&
+        return_object->GetData()->IsPlasmaBuffer()) {
+      plasma_object_ids.push_back(return_ids[i]);
+      last_plasma_index = i;
+    }
+  }
+  if (plasma_object_ids.empty()) {
+    return Status::OK();
+  }
+  if (plasma_object_ids.size() == 1) {
+    return SealReturnObject(return_ids[last_plasma_index],
+                            return_objects[last_plasma_index],
+                            generator_id,
+                            caller_address);
+  }
+
+  RAY_LOG(DEBUG) << "Sealing " << plasma_object_ids.size() << " return objects, first "
+                 << plasma_object_ids[0];
+  Status status = plasma_store_provider_->SealBatch(plasma_object_ids);
+  if (!status.ok()) {
+    RAY_LOG(FATAL) << "Failed to seal " << plasma_object_ids.size()
+                   << " objects, first " << plasma_object_ids[0]
+                   << ", in store: " << status.message();
+  }
+  // Tell the raylet to pin the objects **after** they are sealed.
+  local_raylet_client_->PinObjectIDs(
+      caller_address,
+      plasma_object_ids,
+      generator_id,
+      [this, plasma_object_ids](const Status &status,
+                                const rpc::PinObjectIDsReply &reply) {
+        // Only release the objects once the raylet has responded to avoid the race
+        // condition that the objects could be evicted before the raylet pins them.
+        for (const auto &object_id : plasma_object_ids) {
+          if (!plasma_store_provider_->Release(object_id).ok()) {
+            RAY_LOG(ERROR) << "Failed to release ObjectID (" << object_id
+                           << "), might cause a leak in plasma.";
+          }
+        }
+      });
+  for (const auto &object_id : plasma_object_ids) {
+    RAY_CHECK(
+        memory_store_->Put(RayObject(rpc::ErrorType::OBJECT_IN_PLASMA), object_id));
+  }
+  return Status::OK();
+}
+
 void CoreWorker::AsyncDelObjectRefStream(const ObjectID &generator_id) {
   RAY_LOG(DEBUG) << "AsyncDelObjectRefStream " << generator_id;
   if (task_manager_->TryDelObjectRefStream(generator_id)) {
@@ -1106,6 +1106,44 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
                           const ObjectID &generator_id,
                           const rpc::Address &caller_address);
 
+  /// Allocate the return objects of an executing task at once. The objects that aren't
+  /// inlined are created with a single request to the plasma store, so the caller
+  /// should write into all of the data buffers, then call SealReturnObjects() to seal
+  /// them together.
+  ///
+  /// The arguments are those of AllocateReturnObject(), one per object. The plasma
+  /// store creates either all of the objects or none, so allocating them together
+  /// doesn't risk the deadlock of holding some buffers while waiting for space.
+  ///
+  /// \param[out] return_objects RayObjects containing buffers to write results into,
+  /// in the order of the IDs. An object is left as a nullptr if it already exists.
+  /// \return ObjectExists if some of the objects to create in plasma already existed,
+  /// in which case nothing was allocated and the caller should allocate the objects
+  /// one at a time with AllocateReturnObject().
+  Status AllocateReturnObjects(
+      const std::vector<ObjectID> &object_ids,
+      const std::vector<size_t> &data_sizes,
+      const std::vector<std::shared_ptr<Buffer>> &metadata,
+      const std::vector<std::vector<ObjectID>> &contained_object_ids,
+      const rpc::Address &caller_address,
+      int64_t *task_output_inlined_bytes,
+      std::vector<std::shared_ptr<RayObject>> *return_objects);
+
+  /// Seal the return objects allocated with AllocateReturnObjects(), with a single
+  /// request to the plasma store and a single request to the raylet to pin them. The
+  /// caller should already have written into the data buffers.
+  ///
+  /// \param[in] return_ids Object IDs of the return values.
+  /// \param[in] return_objects RayObjects containing the buffers written into. The
+  /// nullptr ones are skipped.
+  /// \param[in] generator_id See SealReturnObject().
+  /// \param[in] caller_address The address of the caller of the method.
+  /// \return Status.
+  Status SealReturnObjects(const std::vector<ObjectID> &return_ids,
+                           const std::vector<std::shared_ptr<RayObject>> &return_objects,
+                           const ObjectID &generator_id,
+                           const rpc::Address &caller_address);
+
   /// Pin the local copy of the return object, if one exists.
   ///
   /// \param[in] return_id ObjectID of the return value.
@@ -1513,9 +1551,10 @@ class CoreWorker : public rpc::CoreWorkerServiceHandler {
       bool *is_retryable_error,
       std::string *application_error);
 
-  /// Put an object in the local plasma store.
+  /// Put copies of an object in the local plasma store, under each of the IDs. Several
+  /// objects are created and sealed with a single request to the store.
   Status PutInLocalPlasmaStore(const RayObject &object,
-                               const ObjectID &object_id,
+                               const std::vector<ObjectID> &object_ids,
                                bool pin_object);
 
   /// Execute a local mode task (runs normal ExecuteTask)
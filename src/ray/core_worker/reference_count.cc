@@ -27,7 +27,16 @@
                  << " stored_in: " << it->second.borrow().stored_in_objects.size() \
                  << " lineage_ref_count: " << it->second.lineage_ref_count;
 
-namespace {}  // namespace
+namespace {
+
+/// The bytes allocated on the heap by an absl hash table, whose slots each
+/// hold a value and a control byte.
+template <typename Table>
+size_t HashTableHeapBytes(const Table &table) {
+  return table.capacity() * (sizeof(typename Table::value_type) + 1);
+}
+
+}  // namespace
 
 namespace ray {
 namespace core {
@@ -145,7 +154,7 @@ void ReferenceCounter::AddObjectRefStats(
 
     auto ref_proto = stats->add_object_refs();
     ref_proto->set_object_id(ref.first.Binary());
-    ref_proto->set_call_site(ref.second.call_site);
+    ref_proto->set_call_site(ref.second.CallSite());
     ref_proto->set_object_size(ref.second.object_size);
     ref_proto->set_local_ref_count(ref.second.local_ref_count);
     ref_proto->set_submitted_task_ref_count(ref.second.submitted_task_ref_count);
@@ -156,7 +165,7 @@ void ReferenceCounter::AddObjectRefStats(
       if (ref.second.object_size <= 0) {
         ref_proto->set_object_size(it->second.first);
       }
-      if (ref.second.call_site.empty()) {
+      if (ref.second.CallSite().empty()) {
         ref_proto->set_call_site(it->second.second);
       }
     }
@@ -231,7 +240,7 @@ void ReferenceCounter::AddDynamicReturn(const ObjectID &object_id,
   RAY_UNUSED(AddOwnedObjectInternal(object_id,
                                     {},
                                     owner_address,
-                                    outer_it->second.call_site,
+                                    outer_it->second.CallSite(),
                                     /*object_size=*/-1,
                                     outer_it->second.is_reconstructable,
                                     /*add_local_ref=*/false,
@@ -266,7 +275,7 @@ void ReferenceCounter::OwnDynamicStreamingTaskReturnRef(const ObjectID &object_i
   RAY_UNUSED(AddOwnedObjectInternal(object_id,
                                     {},
                                     owner_address,
-                                    outer_it->second.call_site,
+                                    outer_it->second.CallSite(),
                                     /*object_size=*/-1,
                                     outer_it->second.is_reconstructable,
                                     /*add_local_ref=*/true,
@@ -555,7 +564,7 @@ int64_t ReferenceCounter::ReleaseLineageReferences(ReferenceTable::iterator ref)
     RAY_LOG(DEBUG) << "Releasing lineage internal for argument " << argument_id;
     arg_it->second.lineage_ref_count--;
     if (arg_it->second.ShouldDelete(lineage_pinning_enabled_)) {
-      RAY_CHECK(arg_it->second.on_ref_removed == nullptr);
+      RAY_CHECK(arg_it->second.callbacks().on_ref_removed == nullptr);
       lineage_bytes_evicted += ReleaseLineageReferences(arg_it);
       ReleasePlasmaObject(arg_it);
       EraseReference(arg_it);
@@ -681,10 +690,10 @@ void ReferenceCounter::DeleteReferenceInternal(ReferenceTable::iterator it,
                                                std::vector<ObjectID> *deleted) {
   const ObjectID id = it->first;
   RAY_LOG(DEBUG) << "Attempting to delete object " << id;
-  if (it->second.RefCount() == 0 && it->second.on_ref_removed) {
+  if (it->second.RefCount() == 0 && it->second.callbacks().on_ref_removed) {
     RAY_LOG(DEBUG) << "Calling on_ref_removed for object " << id;
-    it->second.on_ref_removed(id);
-    it->second.on_ref_removed = nullptr;
+    it->second.callbacks().on_ref_removed(id);
+    it->second.mutable_callbacks()->on_ref_removed = nullptr;
   }
 
   PRINT_REF_COUNT(it);
@@ -772,20 +781,19 @@ int64_t ReferenceCounter::EvictLineage(int64_t min_bytes_to_evict) {
 }
 
 void ReferenceCounter::ReleasePlasmaObject(ReferenceTable::iterator it) {
-  if (it->second.on_delete) {
+  if (it->second.callbacks().on_delete) {
     RAY_LOG(DEBUG) << "Calling on_delete for object " << it->first;
-    it->second.on_delete(it->first);
-    it->second.on_delete = nullptr;
+    it->second.callbacks().on_delete(it->first);
+    it->second.mutable_callbacks()->on_delete = nullptr;
   }
   it->second.pinned_at_raylet_id.reset();
-  if (it->second.spilled && !it->second.spilled_node_id.IsNil()) {
+  if (it->second.spilled && !it->second.spill().spilled_node_id.IsNil()) {
     // The spilled copy of the object should get deleted during the on_delete
     // callback, so reset the spill location metadata here.
     // NOTE(swang): Spilled copies in cloud storage are not GCed, so we do not
     // reset the spilled metadata.
     it->second.spilled = false;
-    it->second.spilled_url = "";
-    it->second.spilled_node_id = NodeID::Nil();
+    it->second.spill_info.reset();
   }
 }
 
@@ -812,7 +820,7 @@ bool ReferenceCounter::SetDeleteCallback(
   // will resend the registration request after GCS restarts.
   // 2.After GCS restarts, GCS will send `WaitForActorOutOfScope` request to owned actors
   // again.
-  it->second.on_delete = callback;
+  it->second.mutable_callbacks()->on_delete = callback;
   return true;
 }
 
@@ -821,7 +829,7 @@ void ReferenceCounter::ResetObjectsOnRemovedNode(const NodeID &raylet_id) {
   for (auto it = object_id_refs_.begin(); it != object_id_refs_.end(); it++) {
     const auto &object_id = it->first;
     if (it->second.pinned_at_raylet_id.value_or(NodeID::Nil()) == raylet_id ||
-        it->second.spilled_node_id == raylet_id) {
+        it->second.spill().spilled_node_id == raylet_id) {
       ReleasePlasmaObject(it);
       if (!it->second.OutOfScope(lineage_pinning_enabled_)) {
         objects_to_recover_.push_back(object_id);
@@ -906,6 +914,19 @@ size_t ReferenceCounter::NumActorsOwnedByUs() const {
   return num_actors_owned_by_us_;
 }
 
+ReferenceCounter::MemoryUsage ReferenceCounter::GetMemoryUsage() const {
+  absl::MutexLock lock(&mutex_);
+  MemoryUsage usage;
+  usage.num_references = object_id_refs_.size();
+  usage.table_bytes = HashTableHeapBytes(object_id_refs_);
+  for (const auto &entry : object_id_refs_) {
+    usage.side_state_bytes += entry.second.SideStateBytes();
+  }
+  usage.num_interned_owner_addresses = InternedValue<rpc::Address>::NumInterned();
+  usage.num_interned_call_sites = InternedValue<std::string>::NumInterned();
+  return usage;
+}
+
 std::unordered_set<ObjectID> ReferenceCounter::GetAllInScopeObjectIDs() const {
   absl::MutexLock lock(&mutex_);
   std::unordered_set<ObjectID> in_scope_object_ids;
@@ -1296,7 +1317,7 @@ void ReferenceCounter::SetRefRemovedCallback(
   } else {
     // We are still borrowing the object ID. Respond to the owner once we have
     // stopped borrowing it.
-    if (it->second.on_ref_removed != nullptr) {
+    if (it->second.callbacks().on_ref_removed != nullptr) {
       // TODO(swang): If the owner of an object dies and and is re-executed, it
       // is possible that we will receive a duplicate request to set
       // on_ref_removed. If messages are delayed and we overwrite the
@@ -1306,7 +1327,7 @@ void ReferenceCounter::SetRefRemovedCallback(
       RAY_LOG(WARNING) << "on_ref_removed already set for " << object_id
                        << ". The owner task must have died and been re-executed.";
     }
-    it->second.on_ref_removed = ref_removed_callback;
+    it->second.mutable_callbacks()->on_ref_removed = ref_removed_callback;
   }
 }
 
@@ -1410,10 +1431,10 @@ bool ReferenceCounter::HandleObjectSpilled(const ObjectID &object_id,
       spilled_node_id.IsNil() || check_node_alive_(spilled_node_id);
   if (spilled_location_alive) {
     if (spilled_url != "") {
-      it->second.spilled_url = spilled_url;
+      it->second.mutable_spill()->spilled_url = spilled_url;
     }
     if (!spilled_node_id.IsNil()) {
-      it->second.spilled_node_id = spilled_node_id;
+      it->second.mutable_spill()->spilled_node_id = spilled_node_id;
     }
     PushToLocationSubscribers(it);
   } else {
@@ -1442,7 +1463,7 @@ absl::optional<LocalityData> ReferenceCounter::GetLocalityData(
   const auto object_size = it->second.object_size;
   if (object_size < 0) {
     // We don't know the object size so we can't returned valid locality data.
-    RAY_LOG(DEBUG) << "Reference [" << it->second.call_site << "] for object "
+    RAY_LOG(DEBUG) << "Reference [" << it->second.CallSite() << "] for object "
                    << object_id
                    << " has an unknown object size, locality data not available";
     return absl::nullopt;
@@ -1540,8 +1561,8 @@ void ReferenceCounter::PushToLocationSubscribers(ReferenceTable::iterator it) {
   const auto &object_id = it->first;
   const auto &locations = it->second.locations;
   auto object_size = it->second.object_size;
-  const auto &spilled_url = it->second.spilled_url;
-  const auto &spilled_node_id = it->second.spilled_node_id;
+  const auto &spilled_url = it->second.spill().spilled_url;
+  const auto &spilled_node_id = it->second.spill().spilled_node_id;
   const auto &optional_primary_node_id = it->second.pinned_at_raylet_id;
   const auto &primary_node_id = optional_primary_node_id.value_or(NodeID::Nil());
   RAY_LOG(DEBUG) << "Published message for " << object_id << ", " << locations.size()
@@ -1580,8 +1601,8 @@ void ReferenceCounter::FillObjectInformationInternal(
     object_info->add_node_ids(node_id.Binary());
   }
   object_info->set_object_size(it->second.object_size);
-  object_info->set_spilled_url(it->second.spilled_url);
-  object_info->set_spilled_node_id(it->second.spilled_node_id.Binary());
+  object_info->set_spilled_url(it->second.spill().spilled_url);
+  object_info->set_spilled_node_id(it->second.spill().spilled_node_id.Binary());
   auto primary_node_id = it->second.pinned_at_raylet_id.value_or(NodeID::Nil());
   object_info->set_primary_node_id(primary_node_id.Binary());
   object_info->set_pending_creation(it->second.pending_creation);
@@ -1636,6 +1657,27 @@ ReferenceCounter::Reference ReferenceCounter::Reference::FromProto(
   return ref;
 }
 
+size_t ReferenceCounter::Reference::SideStateBytes() const {
+  size_t bytes = HashTableHeapBytes(locations);
+  if (nested_reference_count != nullptr) {
+    bytes += sizeof(NestedReferenceCount) +
+             HashTableHeapBytes(nested_reference_count->contained_in_owned) +
+             HashTableHeapBytes(nested_reference_count->contained_in_borrowed_ids) +
+             HashTableHeapBytes(nested_reference_count->contains);
+  }
+  if (borrow_info != nullptr) {
+    bytes += sizeof(BorrowInfo) + HashTableHeapBytes(borrow_info->stored_in_objects) +
+             HashTableHeapBytes(borrow_info->borrowers);
+  }
+  if (reference_callbacks != nullptr) {
+    bytes += sizeof(ReferenceCallbacks);
+  }
+  if (spill_info != nullptr) {
+    bytes += sizeof(SpillInfo) + spill_info->spilled_url.capacity();
+  }
+  return bytes;
+}
+
 void ReferenceCounter::Reference::ToProto(rpc::ObjectReferenceCount *ref,
                                           bool deduct_local_ref) const {
   if (owner_address) {
@@ -25,6 +25,7 @@
 #include "ray/rpc/grpc_server.h"
 #include "ray/rpc/worker/core_worker_client.h"
 #include "ray/rpc/worker/core_worker_client_pool.h"
+#include "ray/util/interned_value.h"
 #include "ray/util/logging.h"
 #include "src/ray/protobuf/common.pb.h"
 
@@ -367,6 +368,32 @@ class ReferenceCounter : public ReferenceCounterInterface,
   /// Returns the total number of actors owned by this worker.
   size_t NumActorsOwnedByUs() const ABSL_LOCKS_EXCLUDED(mutex_);
 
+  /// The memory used by the reference counting state, for debugging.
+  struct MemoryUsage {
+    /// The number of references in scope.
+    size_t num_references = 0;
+    /// The bytes of the reference table, including its free slots.
+    size_t table_bytes = 0;
+    /// The bytes allocated separately for the state that only some references
+    /// have, such as borrowers, nested references, callbacks and spill info.
+    size_t side_state_bytes = 0;
+    /// The number of distinct owner addresses and call sites that the references
+    /// of this process hold, each stored once.
+    size_t num_interned_owner_addresses = 0;
+    size_t num_interned_call_sites = 0;
+
+    /// The average number of bytes used per reference.
+    double BytesPerReference() const {
+      return num_references == 0
+                 ? 0
+                 : static_cast<double>(table_bytes + side_state_bytes) / num_references;
+    }
+  };
+
+  /// Returns the memory used by the references. This scans all of them, so it
+  /// is meant for debugging.
+  MemoryUsage GetMemoryUsage() const ABSL_LOCKS_EXCLUDED(mutex_);
+
   /// Returns a set of all ObjectIDs currently in scope (i.e., nonzero reference count).
   std::unordered_set<ObjectID> GetAllInScopeObjectIDs() const ABSL_LOCKS_EXCLUDED(mutex_);
 
@@ -616,25 +643,62 @@ class ReferenceCounter : public ReferenceCounterInterface,
     absl::flat_hash_set<rpc::Address> borrowers;
   };
 
+  /// Contains the callbacks of a reference, which are only set for some of them.
+  struct ReferenceCallbacks {
+    /// Callback that will be called when this ObjectID no longer has
+    /// references.
+    std::function<void(const ObjectID &)> on_delete;
+    /// Callback that is called when this process is no longer a borrower
+    /// (RefCount() == 0).
+    std::function<void(const ObjectID &)> on_ref_removed;
+  };
+
+  /// Contains information related to spilled objects only.
+  struct SpillInfo {
+    /// For objects that have been spilled to external storage, the URL from which
+    /// they can be retrieved.
+    std::string spilled_url = "";
+    /// The ID of the node that spilled the object.
+    /// This will be Nil if the object has not been spilled or if it is spilled
+    /// distributed external storage.
+    NodeID spilled_node_id = NodeID::Nil();
+  };
+
+  /// The reference counting state of an object. There is one per object ID in
+  /// scope, so that it is laid out to be small: the values that many references
+  /// share (owner addresses, call sites and node IDs) are interned, the flags are
+  /// packed into bits, and the state that only some references have is allocated
+  /// separately when first set.
   struct Reference {
     /// Constructor for a reference whose origin is unknown.
-    Reference() {}
-    Reference(std::string call_site, const int64_t object_size)
-        : call_site(call_site), object_size(object_size) {}
+    Reference()
+        : owned_by_us(false),
+          is_reconstructable(false),
+          lineage_evicted(false),
+          spilled(false),
+          foreign_owner_already_monitoring(false),
+          has_nested_refs_to_report(false),
+          pending_creation(false),
+          did_spill(false) {}
+    Reference(const std::string &call_site, const int64_t object_size) : Reference() {
+      this->call_site = call_site;
+      this->object_size = object_size;
+    }
     /// Constructor for a reference that we created.
     Reference(const rpc::Address &owner_address,
-              std::string call_site,
+              const std::string &call_site,
               const int64_t object_size,
               bool is_reconstructable,
               const absl::optional<NodeID> &pinned_at_raylet_id)
-        : call_site(call_site),
-          object_size(object_size),
-          owner_address(owner_address),
-          pinned_at_raylet_id(pinned_at_raylet_id),
-          owned_by_us(true),
-          is_reconstructable(is_reconstructable),
-          foreign_owner_already_monitoring(false),
-          pending_creation(!pinned_at_raylet_id.has_value()) {}
+        : Reference(call_site, object_size) {
+      this->owner_address = owner_address;
+      if (pinned_at_raylet_id.has_value()) {
+        this->pinned_at_raylet_id = *pinned_at_raylet_id;
+      }
+      owned_by_us = true;
+      this->is_reconstructable = is_reconstructable;
+      pending_creation = !pinned_at_raylet_id.has_value();
+    }
 
     /// Constructor from a protobuf. This is assumed to be a message from
     /// another process, so the object defaults to not being owned by us.
@@ -726,34 +790,106 @@ class ReferenceCounter : public ReferenceCounterInterface,
       return nested_reference_count.get();
     }
 
+    /// Access ReferenceCallbacks without modifications.
+    /// Returns the default value of the struct if it is not set.
+    const ReferenceCallbacks &callbacks() const {
+      if (reference_callbacks == nullptr) {
+        static auto *default_callbacks = new ReferenceCallbacks();
+        return *default_callbacks;
+      }
+      return *reference_callbacks;
+    }
+
+    /// Returns the callbacks for updates.
+    /// Creates the underlying field if it is not set.
+    ReferenceCallbacks *mutable_callbacks() {
+      if (reference_callbacks == nullptr) {
+        reference_callbacks = std::make_unique<ReferenceCallbacks>();
+      }
+      return reference_callbacks.get();
+    }
+
+    /// Access SpillInfo without modifications.
+    /// Returns the default value of the struct if it is not set.
+    const SpillInfo &spill() const {
+      if (spill_info == nullptr) {
+        static auto *default_info = new SpillInfo();
+        return *default_info;
+      }
+      return *spill_info;
+    }
+
+    /// Returns the spill info for updates.
+    /// Creates the underlying field if it is not set.
+    SpillInfo *mutable_spill() {
+      if (spill_info == nullptr) {
+        spill_info = std::make_unique<SpillInfo>();
+      }
+      return spill_info.get();
+    }
+
     /// Description of the call site where the reference was created.
-    std::string call_site = "<unknown>";
-    /// Object size if known, otherwise -1;
-    int64_t object_size = -1;
-    /// If this object is owned by us and stored in plasma, this contains all
-    /// object locations.
-    absl::flat_hash_set<NodeID> locations;
+    const std::string &CallSite() const {
+      static const auto *unknown_call_site = new std::string("<unknown>");
+      return call_site.has_value() ? *call_site : *unknown_call_site;
+    }
+
+    /// The number of bytes allocated for this reference outside of the
+    /// reference table, excluding the interned values.
+    size_t SideStateBytes() const;
+
+    /// Description of the call site where the reference was created, if known.
+    /// Use CallSite() to read it.
+    InternedValue<std::string> call_site;
     /// The object's owner's address, if we know it. If this process is the
     /// owner, then this is added during creation of the Reference. If this is
     /// process is a borrower, the borrower must add the owner's address before
     /// using the ObjectID.
-    absl::optional<rpc::Address> owner_address;
+    InternedValue<rpc::Address> owner_address;
     /// If this object is owned by us and stored in plasma, and reference
     /// counting is enabled, then some raylet must be pinning the object value.
     /// This is the address of that raylet.
-    absl::optional<NodeID> pinned_at_raylet_id;
+    InternedValue<NodeID> pinned_at_raylet_id;
     /// Whether we own the object. If we own the object, then we are
     /// responsible for tracking the state of the task that creates the object
     /// (see task_manager.h).
-    bool owned_by_us = false;
+    bool owned_by_us : 1;
 
     // Whether this object can be reconstructed via lineage. If false, then the
     // object's value will be pinned as long as it is referenced by any other
     // object's lineage. This should be set to false if the object was created
     // by ray.put(), a task that cannot be retried, or its lineage was evicted.
-    bool is_reconstructable = false;
+    bool is_reconstructable : 1;
     /// Whether the lineage of this object was evicted due to memory pressure.
-    bool lineage_evicted = false;
+    bool lineage_evicted : 1;
+    /// Whether this object has been spilled to external storage.
+    bool spilled : 1;
+
+    /// Whether the object was created with a foreign owner (i.e., _owner set).
+    /// In this case, the owner is already monitoring this reference with a
+    /// WaitForRefRemoved() call, and it is an error to return borrower
+    /// metadata to the parent of the current task.
+    /// See https://github.com/ray-project/ray/pull/19910 for more context.
+    bool foreign_owner_already_monitoring : 1;
+
+    /// ObjectRefs nested in this object that are or were in use. These objects
+    /// are not owned by us, and we need to report that we are borrowing them
+    /// to their owner. Nesting is transitive, so this flag is set as long as
+    /// any child object is in scope.
+    bool has_nested_refs_to_report : 1;
+
+    /// Whether the task that creates this object is scheduled/executing.
+    bool pending_creation : 1;
+
+    /// Whether or not this object was spilled.
+    bool did_spill : 1;
+
+    /// Object size if known, otherwise -1;
+    int64_t object_size = -1;
+    /// If this object is owned by us and stored in plasma, this contains all
+    /// object locations.
+    absl::flat_hash_set<NodeID> locations;
+
     /// The number of tasks that depend on this object that may be retried in
     /// the future (pending execution or finished but retryable). If the object
     /// is inlined (not stored in plasma), then its lineage ref count is 0
@@ -772,41 +908,11 @@ class ReferenceCounter : public ReferenceCounterInterface,
     /// Metadata related to borrowing.
     std::unique_ptr<BorrowInfo> borrow_info;
 
-    /// Callback that will be called when this ObjectID no longer has
-    /// references.
-    std::function<void(const ObjectID &)> on_delete;
-    /// Callback that is called when this process is no longer a borrower
-    /// (RefCount() == 0).
-    std::function<void(const ObjectID &)> on_ref_removed;
+    /// Callbacks to call when the reference is deleted or removed.
+    std::unique_ptr<ReferenceCallbacks> reference_callbacks;
 
-    /// For objects that have been spilled to external storage, the URL from which
-    /// they can be retrieved.
-    std::string spilled_url = "";
-    /// The ID of the node that spilled the object.
-    /// This will be Nil if the object has not been spilled or if it is spilled
-    /// distributed external storage.
-    NodeID spilled_node_id = NodeID::Nil();
-    /// Whether this object has been spilled to external storage.
-    bool spilled = false;
-
-    /// Whether the object was created with a foreign owner (i.e., _owner set).
-    /// In this case, the owner is already monitoring this reference with a
-    /// WaitForRefRemoved() call, and it is an error to return borrower
-    /// metadata to the parent of the current task.
-    /// See https://github.com/ray-project/ray/pull/19910 for more context.
-    bool foreign_owner_already_monitoring = false;
-
-    /// ObjectRefs nested in this object that are or were in use. These objects
-    /// are not owned by us, and we need to report that we are borrowing them
-    /// to their owner. Nesting is transitive, so this flag is set as long as
-    /// any child object is in scope.
-    bool has_nested_refs_to_report = false;
-
-    /// Whether the task that creates this object is scheduled/executing.
-    bool pending_creation = false;
-
-    /// Whether or not this object was spilled.
-    bool did_spill = false;
+    /// Metadata related to spilling.
+    std::unique_ptr<SpillInfo> spill_info;
   };
 
   using ReferenceTable = absl::flat_hash_map<ObjectID, Reference>;
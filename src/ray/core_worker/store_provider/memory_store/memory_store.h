@@ -142,10 +142,7 @@ class CoreWorkerMemoryStore {
   /// Returns the number of objects in this store.
   ///
   /// \return Count of objects in the store.
-  int Size() {
-    absl::MutexLock lock(&mu_);
-    return objects_.size();
-  }
+  int Size();
 
   /// Returns stats data of memory usage.
   ///
@@ -168,6 +165,7 @@ class CoreWorkerMemoryStore {
 
  private:
   FRIEND_TEST(TestMemoryStore, TestMemoryStoreStats);
+  FRIEND_TEST(TestMemoryStore, TestConcurrentPutAndGet);
 
   /// See the public version of `Get` for meaning of the other arguments.
   /// \param[in] abort_if_any_object_is_exception Whether we should abort if any object
@@ -183,15 +181,51 @@ class CoreWorkerMemoryStore {
   /// Called when an object is deleted from the store.
   void OnDelete(std::shared_ptr<RayObject> obj);
 
+  /// A subset of the objects of the store, keyed by the hash of their IDs,
+  /// together with the requests waiting for them.
+  struct Shard {
+    /// Protects the data structures below.
+    mutable absl::Mutex mu;
+
+    /// Map from object ID to `RayObject`.
+    /// NOTE: This map should be modified by EmplaceObjectAndUpdateStats and
+    /// EraseObjectAndUpdateStats.
+    absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> objects
+        ABSL_GUARDED_BY(mu);
+
+    /// Map from object ID to its get requests.
+    absl::flat_hash_map<ObjectID, std::vector<std::shared_ptr<GetRequest>>>
+        object_get_requests ABSL_GUARDED_BY(mu);
+
+    /// Map from object ID to its async get requests.
+    absl::flat_hash_map<ObjectID,
+                        std::vector<std::function<void(std::shared_ptr<RayObject>)>>>
+        object_async_get_requests ABSL_GUARDED_BY(mu);
+
+    /// Number of objects in the plasma store for this shard.
+    int32_t num_in_plasma ABSL_GUARDED_BY(mu) = 0;
+    /// Number of objects that don't exist in the plasma store.
+    int32_t num_local_objects ABSL_GUARDED_BY(mu) = 0;
+    /// Number of bytes used by this shard on heap, including both placeholder
+    /// values for objects in plasma and inlined small returned objects from task.
+    int64_t num_local_objects_bytes ABSL_GUARDED_BY(mu) = 0;
+  };
+
+  /// Get the shard of an object.
+  Shard &GetShard(const ObjectID &object_id) const {
+    return *shards_[object_id.Hash() % shards_.size()];
+  }
+
   /// Emplace the given object entry to the in-memory-store and update stats properly.
-  void EmplaceObjectAndUpdateStats(const ObjectID &object_id,
+  void EmplaceObjectAndUpdateStats(Shard &shard,
+                                   const ObjectID &object_id,
                                    std::shared_ptr<RayObject> &object_entry)
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mu);
 
   /// Erase the object of the object id from the in memory store and update stats
   /// properly.
-  void EraseObjectAndUpdateStats(const ObjectID &object_id)
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void EraseObjectAndUpdateStats(Shard &shard, const ObjectID &object_id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mu);
 
   /// If enabled, holds a reference to local worker ref counter. TODO(ekl) make this
   /// mandatory once Java is supported.
@@ -200,22 +234,13 @@ class CoreWorkerMemoryStore {
   // If set, this will be used to notify worker blocked / unblocked on get calls.
   std::shared_ptr<raylet::RayletClient> raylet_client_ = nullptr;
 
-  /// Protects the data structures below.
-  mutable absl::Mutex mu_;
-
-  /// Map from object ID to `RayObject`.
-  /// NOTE: This map should be modified by EmplaceObjectAndUpdateStats and
-  /// EraseObjectAndUpdateStats.
-  absl::flat_hash_map<ObjectID, std::shared_ptr<RayObject>> objects_ ABSL_GUARDED_BY(mu_);
+  /// The shards of the store. A multi-object `Get` locks the shards of its
+  /// objects one at a time, never several at once.
+  std::vector<std::unique_ptr<Shard>> shards_;
 
-  /// Map from object ID to its get requests.
-  absl::flat_hash_map<ObjectID, std::vector<std::shared_ptr<GetRequest>>>
-      object_get_requests_ ABSL_GUARDED_BY(mu_);
-
-  /// Map from object ID to its async get requests.
-  absl::flat_hash_map<ObjectID,
-                      std::vector<std::function<void(std::shared_ptr<RayObject>)>>>
-      object_async_get_requests_ ABSL_GUARDED_BY(mu_);
+  /// The shard that the next NotifyUnhandledErrors scan starts from. Only used
+  /// by NotifyUnhandledErrors, which is called from a single thread.
+  size_t next_unhandled_error_shard_ = 0;
 
   /// Function passed in to be called to check for signals (e.g., Ctrl-C).
   std::function<Status()> check_signals_;
@@ -223,18 +248,6 @@ class CoreWorkerMemoryStore {
   /// Function called to report unhandled exceptions.
   std::function<void(const RayObject &)> unhandled_exception_handler_;
 
-  ///
-  /// Below information is stats.
-  ///
-  /// Number of objects in the plasma store for this memory store.
-  int32_t num_in_plasma_ ABSL_GUARDED_BY(mu_) = 0;
-  /// Number of objects that don't exist in the plasma store.
-  int32_t num_local_objects_ ABSL_GUARDED_BY(mu_) = 0;
-  /// Number of bytes used by this memory store on heap, including both
-  /// placeholder values for objects in plasma and inlined small returned
-  /// objects from task.
-  int64_t num_local_objects_bytes_ ABSL_GUARDED_BY(mu_) = 0;
-
   /// This lambda is used to allow language frontend to allocate the objects
   /// in the memory store.
   std::function<std::shared_ptr<RayObject>(const RayObject &object,
@@ -108,6 +108,53 @@ Status CoreWorkerPlasmaStoreProvider::Put(const RayObject &object,
   return Status::OK();
 }
 
+Status CoreWorkerPlasmaStoreProvider::PutBatch(
+    const RayObject &object,
+    const std::vector<ObjectID> &object_ids,
+    const rpc::Address &owner_address,
+    std::vector<ObjectID> *created_object_ids) {
+  RAY_CHECK(!object.IsInPlasmaError());
+  created_object_ids->clear();
+  if (object_ids.size() > 1) {
+    const auto &metadata = object.GetMetadata();
+    const int64_t data_size = object.HasData() ? object.GetData()->Size() : 0;
+    std::vector<plasma::ObjectCreateSpec> specs;
+    specs.reserve(object_ids.size());
+    for (const auto &object_id : object_ids) {
+      specs.push_back({object_id,
+                       data_size,
+                       metadata ? metadata->Data() : nullptr,
+                       metadata ? static_cast<int64_t>(metadata->Size()) : 0});
+    }
+    std::vector<std::shared_ptr<Buffer>> data;
+    Status status = store_client_.CreateBatchAndSpillIfNeeded(
+        specs, owner_address, &data, plasma::flatbuf::ObjectSource::CreatedByWorker);
+    if (status.ok()) {
+      if (object.HasData()) {
+        for (const auto &buffer : data) {
+          memcpy(buffer->Data(), object.GetData()->Data(), data_size);
+        }
+      }
+      RAY_RETURN_NOT_OK(store_client_.SealBatch(object_ids));
+      *created_object_ids = object_ids;
+      return Status::OK();
+    }
+    // The store creates either all of the objects of a batch or none of them. If some
+    // of them already exist, create the others one by one.
+    if (!status.IsObjectExists()) {
+      return status;
+    }
+  }
+  for (const auto &object_id : object_ids) {
+    bool object_exists;
+    RAY_RETURN_NOT_OK(Put(object, object_id, owner_address, &object_exists));
+    if (!object_exists) {
+      created_object_ids->push_back(object_id);
+    }
+  }
+  return Status::OK();
+}
+
 Status CoreWorkerPlasmaStoreProvider::Create(const std::shared_ptr<Buffer> &metadata,
                                              const size_t data_size,
                                              const ObjectID &object_id,
@@ -155,6 +202,50 @@ Status CoreWorkerPlasmaStoreProvider::Create(const std::shared_ptr<Buffer> &meta
   return status;
 }
 
+Status CoreWorkerPlasmaStoreProvider::CreateBatch(
+    const std::vector<std::shared_ptr<Buffer>> &metadata,
+    const std::vector<size_t> &data_sizes,
+    const std::vector<ObjectID> &object_ids,
+    const rpc::Address &owner_address,
+    std::vector<std::shared_ptr<Buffer>> *data) {
+  RAY_CHECK(metadata.size() == object_ids.size() &&
+            data_sizes.size() == object_ids.size());
+  std::vector<plasma::ObjectCreateSpec> specs;
+  specs.reserve(object_ids.size());
+  size_t total_size = 0;
+  for (size_t i = 0; i < object_ids.size(); i++) {
+    specs.push_back({object_ids[i],
+                     static_cast<int64_t>(data_sizes[i]),
+                     metadata[i] ? metadata[i]->Data() : nullptr,
+                     metadata[i] ? static_cast<int64_t>(metadata[i]->Size()) : 0});
+    total_size += data_sizes[i];
+  }
+  Status status = store_client_.CreateBatchAndSpillIfNeeded(
+      specs, owner_address, data, plasma::flatbuf::ObjectSource::CreatedByWorker);
+  if (status.IsObjectStoreFull()) {
+    RAY_LOG(ERROR) << "Failed to put " << object_ids.size()
+                   << " objects in object store because it "
+                   << "is full. Total size is " << total_size << " bytes.\n"
+                   << "Plasma store status:\n"
+                   << MemoryUsageString() << "\n---\n"
+                   << "--- Tip: Use the `ray memory` command to list active objects "
+                      "in the cluster."
+                   << "\n---\n";
+
+    // Replace the status with a more helpful error message.
+    std::ostringstream message;
+    message << "Failed to put " << object_ids.size() << " objects, first "
+            << object_ids[0] << ", in object store because it is full. Total size is "
+            << total_size << " bytes.";
+    status = Status::ObjectStoreFull(message.str());
+  }
+  return status;
+}
+
+Status CoreWorkerPlasmaStoreProvider::SealBatch(const std::vector<ObjectID> &object_ids) {
+  return store_client_.SealBatch(object_ids);
+}
+
 Status CoreWorkerPlasmaStoreProvider::Seal(const ObjectID &object_id) {
   return store_client_.Seal(object_id);
 }
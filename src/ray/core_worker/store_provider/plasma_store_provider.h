@@ -113,6 +113,22 @@ class CoreWorkerPlasmaStoreProvider {
              const rpc::Address &owner_address,
              bool *object_exists);
 
+  /// Create and seal copies of an object under several IDs, with a single create
+  /// and a single seal request to the store.
+  ///
+  /// NOTE: The caller must subsequently call Release() for each of the created
+  /// objects, like after Put().
+  ///
+  /// \param[in] object The object to create.
+  /// \param[in] object_ids The IDs of the objects.
+  /// \param[in] owner_address The address of the objects' owner.
+  /// \param[out] created_object_ids The IDs of the objects that were created, i.e.
+  /// that didn't exist yet.
+  Status PutBatch(const RayObject &object,
+                  const std::vector<ObjectID> &object_ids,
+                  const rpc::Address &owner_address,
+                  std::vector<ObjectID> *created_object_ids);
+
   /// Create an object in plasma and return a mutable buffer to it. The buffer should be
   /// subsequently written to and then sealed using Seal().
   ///
@@ -129,6 +145,35 @@ class CoreWorkerPlasmaStoreProvider {
                 bool created_by_worker,
                 bool is_mutable = false);
 
+  /// Create several objects in plasma with a single request to the store, and return
+  /// mutable buffers to them. The buffers should be written to and then sealed using
+  /// SealBatch().
+  ///
+  /// The store creates either all of the objects or none of them, so that a worker
+  /// never holds some of the buffers while it waits for space for the others.
+  ///
+  /// \param[in] metadata The metadata of each object.
+  /// \param[in] data_sizes The data size of each object.
+  /// \param[in] object_ids The IDs of the objects.
+  /// \param[in] owner_address The address of the objects' owner.
+  /// \param[out] data The mutable object buffers in plasma, in the order of the IDs.
+  /// \return ObjectExists if any of the objects already exists, in which case none of
+  /// them was created.
+  Status CreateBatch(const std::vector<std::shared_ptr<Buffer>> &metadata,
+                     const std::vector<size_t> &data_sizes,
+                     const std::vector<ObjectID> &object_ids,
+                     const rpc::Address &owner_address,
+                     std::vector<std::shared_ptr<Buffer>> *data);
+
+  /// Seal object buffers created with CreateBatch() with a single request to the
+  /// store.
+  ///
+  /// NOTE: The caller must subsequently call Release() for each of the objects, like
+  /// after Seal().
+  ///
+  /// \param[in] object_ids The IDs of the objects.
+  Status SealBatch(const std::vector<ObjectID> &object_ids);
+
   /// Seal an object buffer created with Create().
   ///
   /// NOTE: The caller must subsequently call Release() to release the first reference to
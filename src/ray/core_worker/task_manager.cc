@@ -475,7 +475,7 @@ bool TaskManager::HandleTaskReturn(const ObjectID &object_id,
 
     RayObject object(data_buffer, metadata_buffer, nested_refs);
     if (store_in_plasma) {
-      put_in_local_plasma_callback_(object, object_id);
+      put_in_local_plasma_callback_(object, {object_id});
     } else {
       direct_return = in_memory_store_->Put(object, object_id);
     }
@@ -1301,11 +1301,13 @@ void TaskManager::MarkTaskReturnObjectsFailed(
   RayObject error(error_type, ray_error_info);
   RAY_LOG(DEBUG) << "Treat task as failed. task_id: " << task_id
                  << ", error_type: " << ErrorType_Name(error_type);
+  // The error objects stored in plasma are created with a single request to the store.
+  std::vector<ObjectID> plasma_object_ids;
   int64_t num_returns = spec.NumReturns();
   for (int i = 0; i < num_returns; i++) {
     const auto object_id = ObjectID::FromIndex(task_id, /*index=*/i + 1);
     if (store_in_plasma_ids.count(object_id)) {
-      put_in_local_plasma_callback_(error, object_id);
+      plasma_object_ids.push_back(object_id);
     } else {
       in_memory_store_->Put(error, object_id);
     }
@@ -1313,7 +1315,7 @@ void TaskManager::MarkTaskReturnObjectsFailed(
   if (spec.ReturnsDynamic()) {
     for (const auto &dynamic_return_id : spec.DynamicReturnIds()) {
       if (store_in_plasma_ids.count(dynamic_return_id)) {
-        put_in_local_plasma_callback_(error, dynamic_return_id);
+        plasma_object_ids.push_back(dynamic_return_id);
       } else {
         in_memory_store_->Put(error, dynamic_return_id);
       }
@@ -1338,12 +1340,15 @@ void TaskManager::MarkTaskReturnObjectsFailed(
     for (size_t i = 0; i < num_streaming_generator_returns; i++) {
       const auto generator_return_id = spec.StreamingGeneratorReturnId(i);
       if (store_in_plasma_ids.count(generator_return_id)) {
-        put_in_local_plasma_callback_(error, generator_return_id);
+        plasma_object_ids.push_back(generator_return_id);
       } else {
         in_memory_store_->Put(error, generator_return_id);
       }
     }
   }
+  if (!plasma_object_ids.empty()) {
+    put_in_local_plasma_callback_(error, plasma_object_ids);
+  }
 }
 
 absl::optional<TaskSpecification> TaskManager::GetTaskSpec(const TaskID &task_id) const {
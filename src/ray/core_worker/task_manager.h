@@ -77,8 +77,9 @@ class TaskResubmissionInterface {
 };
 
 using TaskStatusCounter = CounterMap<std::tuple<std::string, rpc::TaskStatus, bool>>;
+/// Store copies of an object in plasma under each of the IDs.
 using PutInLocalPlasmaCallback =
-    std::function<void(const RayObject &object, const ObjectID &object_id)>;
+    std::function<void(const RayObject &object, const std::vector<ObjectID> &object_ids)>;
 using RetryTaskCallback = std::function<void(
     TaskSpecification &spec, bool object_recovery, bool update_seqno, uint32_t delay_ms)>;
 using ReconstructObjectCallback = std::function<void(const ObjectID &object_id)>;
@@ -14,6 +14,9 @@
 
 #include "ray/core_worker/store_provider/memory_store/memory_store.h"
 
+#include <chrono>
+#include <thread>
+
 #include "absl/synchronization/mutex.h"
 #include "gtest/gtest.h"
 #include "ray/common/test_util.h"
@@ -84,9 +87,9 @@ TEST(TestMemoryStore, TestMemoryStoreStats) {
   // Iterate through the memory store and compare the values that are obtained by
   // GetMemoryStoreStatisticalData.
   auto fill_expected_memory_stats = [&](MemoryStoreStats &expected_item) {
-    {
-      absl::MutexLock lock(&provider->mu_);
-      for (const auto &it : provider->objects_) {
+    for (const auto &shard : provider->shards_) {
+      absl::MutexLock lock(&shard->mu);
+      for (const auto &it : shard->objects) {
         if (it.second->IsInPlasmaError()) {
           expected_item.num_in_plasma += 1;
         } else {
@@ -137,6 +140,110 @@ TEST(TestMemoryStore, TestMemoryStoreStats) {
   ASSERT_EQ(item.num_local_objects_bytes, expected_item3.num_local_objects_bytes);
 }
 
+TEST(TestMemoryStore, TestConcurrentPutAndGet) {
+  WorkerContext context(WorkerType::WORKER, WorkerID::FromRandom(), JobID::FromInt(0));
+  auto provider = std::make_shared<CoreWorkerMemoryStore>();
+  const int kNumThreads = 8;
+  const int kNumObjectsPerThread = 100;
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < kNumThreads * kNumObjectsPerThread; i++) {
+    object_ids.push_back(ObjectID::FromRandom());
+    // The hash is computed lazily, so compute it before the IDs are shared.
+    object_ids.back().Hash();
+  }
+
+  // Objects of all shards are put while a single get waits for all of them, and
+  // another waits for half of them.
+  std::vector<std::shared_ptr<RayObject>> results;
+  std::vector<std::shared_ptr<RayObject>> wait_results;
+  std::thread getter([&]() {
+    RAY_CHECK_OK(provider->Get(object_ids,
+                               object_ids.size(),
+                               /*timeout_ms=*/-1,
+                               context,
+                               /*remove_after_get=*/false,
+                               &results));
+  });
+  std::thread waiter([&]() {
+    absl::flat_hash_set<ObjectID> ready;
+    RAY_CHECK_OK(provider->Wait(absl::flat_hash_set<ObjectID>(object_ids.begin(),
+                                                              object_ids.end()),
+                                object_ids.size() / 2,
+                                /*timeout_ms=*/-1,
+                                context,
+                                &ready));
+    ASSERT_GE(ready.size(), object_ids.size() / 2);
+  });
+  std::vector<std::thread> putters;
+  for (int i = 0; i < kNumThreads; i++) {
+    putters.emplace_back([&, i]() {
+      for (int j = 0; j < kNumObjectsPerThread; j++) {
+        const auto &object_id = object_ids[i * kNumObjectsPerThread + j];
+        auto data = MakeLocalMemoryBufferFromString(object_id.Binary());
+        RayObject object(data, nullptr, std::vector<rpc::ObjectReference>());
+        ASSERT_TRUE(provider->Put(object, object_id));
+      }
+    });
+  }
+  for (auto &putter : putters) {
+    putter.join();
+  }
+  getter.join();
+  waiter.join();
+
+  ASSERT_EQ(results.size(), object_ids.size());
+  for (size_t i = 0; i < object_ids.size(); i++) {
+    ASSERT_NE(results[i], nullptr);
+    const auto &data = results[i]->GetData();
+    ASSERT_EQ(std::string(reinterpret_cast<const char *>(data->Data()), data->Size()),
+              object_ids[i].Binary());
+  }
+  ASSERT_EQ(provider->Size(), kNumThreads * kNumObjectsPerThread);
+  for (const auto &shard : provider->shards_) {
+    absl::MutexLock lock(&shard->mu);
+    ASSERT_TRUE(shard->object_get_requests.empty());
+  }
+}
+
+// Measures the throughput of puts, gets and deletes of small objects from many
+// threads at once. We disable it by default.
+TEST(TestMemoryStore, DISABLED_MultiThreadedPutGetPerf) {
+  WorkerContext context(WorkerType::WORKER, WorkerID::FromRandom(), JobID::FromInt(0));
+  const int kNumOpsPerThread = 100 * 1000;
+  auto data = MakeLocalMemoryBufferFromString("hello");
+  RayObject object(data, nullptr, std::vector<rpc::ObjectReference>());
+  for (int num_threads : {1, 2, 4, 8, 16, 32, 64}) {
+    auto provider = std::make_shared<CoreWorkerMemoryStore>();
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_threads; i++) {
+      threads.emplace_back([&]() {
+        for (int j = 0; j < kNumOpsPerThread; j++) {
+          auto object_id = ObjectID::FromRandom();
+          std::vector<std::shared_ptr<RayObject>> results;
+          RAY_CHECK(provider->Put(object, object_id));
+          RAY_CHECK_OK(provider->Get({object_id},
+                                     1,
+                                     /*timeout_ms=*/-1,
+                                     context,
+                                     /*remove_after_get=*/false,
+                                     &results));
+          provider->Delete(std::vector<ObjectID>{object_id});
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    RAY_LOG(INFO) << num_threads << " threads: "
+                  << num_threads * kNumOpsPerThread / duration_s
+                  << " put/get/delete per second";
+  }
+}
+
 /// A mock manager that manages all test buffers. This mocks
 /// that memory pressure is able to be awared.
 class MockBufferManager {
@@ -663,6 +663,76 @@ TEST_F(ReferenceCountTest, TestHandleObjectSpilled) {
   rc->RemoveLocalReference(obj1, nullptr);
 }
 
+// Tests that the owner addresses and call sites of references are shared, and
+// that the state that only some references have is accounted for.
+TEST_F(ReferenceCountTest, TestMemoryUsage) {
+  rpc::Address address;
+  address.set_ip_address("1234");
+  auto initial_usage = rc->GetMemoryUsage();
+  ASSERT_EQ(initial_usage.num_references, 0);
+
+  std::vector<ObjectID> ids;
+  for (int i = 0; i < 100; i++) {
+    ids.push_back(ObjectID::FromRandom());
+    rc->AddOwnedObject(ids.back(), {}, address, "file.py:42", 100, false, true);
+  }
+  auto usage = rc->GetMemoryUsage();
+  ASSERT_EQ(usage.num_references, 100);
+  ASSERT_EQ(usage.num_interned_owner_addresses,
+            initial_usage.num_interned_owner_addresses + 1);
+  ASSERT_EQ(usage.num_interned_call_sites, initial_usage.num_interned_call_sites + 1);
+  ASSERT_GT(usage.table_bytes, 0);
+  ASSERT_GT(usage.BytesPerReference(), 0);
+
+  rc->HandleObjectSpilled(ids[0], "url1", NodeID::FromRandom());
+  ASSERT_TRUE(rc->SetDeleteCallback(ids[1], [](const ObjectID &) {}));
+  ASSERT_GT(rc->GetMemoryUsage().side_state_bytes, usage.side_state_bytes);
+
+  for (const auto &id : ids) {
+    rc->RemoveLocalReference(id, nullptr);
+  }
+  usage = rc->GetMemoryUsage();
+  ASSERT_EQ(usage.num_references, 0);
+  ASSERT_EQ(usage.num_interned_owner_addresses,
+            initial_usage.num_interned_owner_addresses);
+  ASSERT_EQ(usage.num_interned_call_sites, initial_usage.num_interned_call_sites);
+}
+
+// Measures the memory used per reference and the time to create and release
+// 10M references. We disable it by default.
+TEST_F(ReferenceCountTest, DISABLED_CreateAndReleaseReferencesPerf) {
+  const int kNumReferences = 10 * 1000 * 1000;
+  rpc::Address address;
+  address.set_ip_address("1234");
+  // Don't log the publications of the released references.
+  ::testing::NiceMock<pubsub::MockPublisher> publisher;
+  ::testing::NiceMock<pubsub::MockSubscriber> subscriber;
+  ReferenceCounter counter(
+      address, &publisher, &subscriber, [](const NodeID &node_id) { return true; });
+  std::vector<ObjectID> ids;
+  ids.reserve(kNumReferences);
+  for (int i = 0; i < kNumReferences; i++) {
+    ids.push_back(ObjectID::FromRandom());
+  }
+
+  auto start = absl::Now();
+  for (const auto &id : ids) {
+    counter.AddOwnedObject(id, {}, address, "file.py:42", 100, false, true);
+  }
+  auto created = absl::Now();
+  auto usage = counter.GetMemoryUsage();
+  for (const auto &id : ids) {
+    counter.RemoveLocalReference(id, nullptr);
+  }
+  auto released = absl::Now();
+  RAY_LOG(INFO) << "Created " << kNumReferences << " references in "
+                << absl::ToDoubleSeconds(created - start) << " s, released them in "
+                << absl::ToDoubleSeconds(released - created) << " s, "
+                << usage.BytesPerReference() << " bytes per reference ("
+                << usage.table_bytes << " bytes of table, " << usage.side_state_bytes
+                << " bytes of side state)";
+}
+
 // Tests fetching of locality data from reference table.
 TEST_F(ReferenceCountTest, TestGetLocalityData) {
   ObjectID obj1 = ObjectID::FromRandom();
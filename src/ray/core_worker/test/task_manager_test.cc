@@ -126,8 +126,9 @@ class TaskManagerTest : public ::testing::Test {
         manager_(
             store_,
             reference_counter_,
-            [this](const RayObject &object, const ObjectID &object_id) {
-              stored_in_plasma.insert(object_id);
+            [this](const RayObject &object, const std::vector<ObjectID> &object_ids) {
+              stored_in_plasma.insert(object_ids.begin(), object_ids.end());
+              num_plasma_puts_++;
             },
             [this](TaskSpecification &spec,
                    bool object_recovery,
@@ -187,6 +188,7 @@ class TaskManagerTest : public ::testing::Test {
   uint32_t last_delay_ms_ = 0;
   bool last_object_recovery_ = false;
   std::unordered_set<ObjectID> stored_in_plasma;
+  int num_plasma_puts_ = 0;
 };
 
 class TaskManagerLineageTest : public TaskManagerTest {
@@ -1067,6 +1069,43 @@ TEST_F(TaskManagerLineageTest, TestResubmittedTaskFails) {
   ASSERT_FALSE(stored_in_plasma.count(return_id2));
 }
 
+// Test that the errors of a failed task whose return values were stored in plasma are
+// stored in plasma with a single put.
+TEST_F(TaskManagerLineageTest, TestResubmittedTaskFailsBatchesPlasmaPuts) {
+  rpc::Address caller_address;
+  auto spec = CreateTaskHelper(3, {});
+  manager_.AddPendingTask(caller_address, spec, "", /*num_retries=*/1);
+  manager_.MarkDependenciesResolved(spec.TaskId());
+
+  // The task completes. All return objects are stored in plasma.
+  {
+    manager_.MarkTaskWaitingForExecution(
+        spec.TaskId(), NodeID::FromRandom(), WorkerID::FromRandom());
+    rpc::PushTaskReply reply;
+    auto data = GenerateRandomBuffer();
+    for (int i = 0; i < 3; i++) {
+      auto return_object = reply.add_return_objects();
+      return_object->set_object_id(spec.ReturnId(i).Binary());
+      return_object->set_data(data->Data(), data->Size());
+      return_object->set_in_plasma(true);
+    }
+    manager_.CompletePendingTask(spec.TaskId(), reply, rpc::Address(), false);
+  }
+  std::vector<ObjectID> resubmitted_task_deps;
+  ASSERT_TRUE(manager_.ResubmitTask(spec.TaskId(), &resubmitted_task_deps));
+
+  // The re-executed task fails.
+  for (int i = 0; i < 3; i++) {
+    reference_counter_->AddLocalReference(spec.ReturnId(i), "");
+  }
+  manager_.MarkDependenciesResolved(spec.TaskId());
+  manager_.MarkTaskWaitingForExecution(
+      spec.TaskId(), NodeID::FromRandom(), WorkerID::FromRandom());
+  manager_.FailOrRetryPendingTask(spec.TaskId(), rpc::ErrorType::WORKER_DIED);
+  ASSERT_EQ(stored_in_plasma.size(), 3);
+  ASSERT_EQ(num_plasma_puts_, 1);
+}
+
 // Test submission and resubmission for a task with dynamic returns.
 TEST_F(TaskManagerLineageTest, TestDynamicReturnsTask) {
   auto spec = CreateTaskHelper(1, {}, /*dynamic_returns=*/true);
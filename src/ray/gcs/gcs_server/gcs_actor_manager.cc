@@ -15,13 +15,92 @@
 #include "ray/gcs/gcs_server/gcs_actor_manager.h"
 
 #include <boost/regex.hpp>
+#include <queue>
 #include <utility>
 
+#include "absl/strings/match.h"
 #include "ray/common/ray_config.h"
 #include "ray/gcs/pb_util.h"
 #include "ray/stats/metric_defs.h"
 
 namespace {
+/// Whether an actor matches the filters of a GetAllActorInfo request.
+bool MatchesActorFilters(const ray::rpc::GetAllActorInfoRequest::Filters &filters,
+                         const ray::rpc::ActorTableData &data) {
+  if (filters.has_actor_id() && filters.actor_id() != data.actor_id()) {
+    return false;
+  }
+  if (filters.has_job_id() && filters.job_id() != data.job_id()) {
+    return false;
+  }
+  if (filters.has_state() && filters.state() != data.state()) {
+    return false;
+  }
+  if (filters.has_node_id() && filters.node_id() != data.address().raylet_id()) {
+    return false;
+  }
+  if (filters.has_name_prefix() &&
+      !absl::StartsWith(data.name(), filters.name_prefix())) {
+    return false;
+  }
+  return true;
+}
+
+/// The page of a paginated GetAllActorInfo request: the `limit` actors with the
+/// smallest ids after the page token. Only the page is kept while the actors are
+/// scanned, so its memory doesn't grow with the number of actors.
+class ActorInfoPage {
+ public:
+  ActorInfoPage(std::string page_token, int64_t limit)
+      : page_token_(std::move(page_token)), limit_(limit) {}
+
+  /// Add an actor matching the filters to the page, if it belongs there.
+  void Add(const ray::rpc::ActorTableData *data) {
+    if (data->actor_id() <= page_token_) {
+      return;
+    }
+    ++num_after_token_;
+    page_.push(data);
+    if (limit_ != -1 && static_cast<int64_t>(page_.size()) > limit_) {
+      page_.pop();
+    }
+  }
+
+  /// Take the actors of the page in the order of their ids.
+  ///
+  /// \param[out] next_page_token The token of the next page, or empty if this is the
+  /// last page.
+  std::vector<const ray::rpc::ActorTableData *> Take(std::string *next_page_token) {
+    std::vector<const ray::rpc::ActorTableData *> actors(page_.size());
+    for (auto it = actors.rbegin(); it != actors.rend(); ++it) {
+      *it = page_.top();
+      page_.pop();
+    }
+    next_page_token->clear();
+    if (!actors.empty() && num_after_token_ > actors.size()) {
+      *next_page_token = actors.back()->actor_id();
+    }
+    return actors;
+  }
+
+ private:
+  struct IdLess {
+    bool operator()(const ray::rpc::ActorTableData *left,
+                    const ray::rpc::ActorTableData *right) const {
+      return left->actor_id() < right->actor_id();
+    }
+  };
+
+  const std::string page_token_;
+  const int64_t limit_;
+  size_t num_after_token_ = 0;
+  /// The actors of the page so far, with the largest id on top.
+  std::priority_queue<const ray::rpc::ActorTableData *,
+                      std::vector<const ray::rpc::ActorTableData *>,
+                      IdLess>
+      page_;
+};
+
 /// The error message constructed from below methods is user-facing, so please avoid
 /// including too much implementation detail or internal information.
 void AddActorInfo(const ray::gcs::GcsActor *actor,
@@ -348,57 +427,86 @@ void GcsActorManager::HandleGetAllActorInfo(rpc::GetAllActorInfoRequest request,
   RAY_LOG(DEBUG) << "Getting all actor info.";
   ++counts_[CountType::GET_ALL_ACTOR_INFO_REQUEST];
 
-  const auto filter_fn = [](const rpc::GetAllActorInfoRequest::Filters &filters,
-                            const rpc::ActorTableData &data) {
-    if (filters.has_actor_id() &&
-        ActorID::FromBinary(filters.actor_id()) != ActorID::FromBinary(data.actor_id())) {
-      return false;
-    }
-    if (filters.has_job_id() &&
-        JobID::FromBinary(filters.job_id()) != JobID::FromBinary(data.job_id())) {
-      return false;
-    }
-    if (filters.has_state() && filters.state() != data.state()) {
-      return false;
-    }
-    return true;
-  };
-
   if (request.show_dead_jobs() == false) {
     auto total_actors = registered_actors_.size() + destroyed_actors_.size();
     reply->set_total(total_actors);
 
     auto count = 0;
-    auto num_filtered = 0;
-    for (const auto &iter : registered_actors_) {
-      if (limit != -1 && count >= limit) {
-        break;
+    int64_t num_filtered = 0;
+    const bool lookup_actor_id = request.filters().has_actor_id();
+    if (lookup_actor_id) {
+      // Look the actor up instead of scanning all the actors.
+      const auto actor_id = ActorID::FromBinary(request.filters().actor_id());
+      std::shared_ptr<GcsActor> actor;
+      if (auto it = registered_actors_.find(actor_id); it != registered_actors_.end()) {
+        actor = it->second;
+      } else if (auto it = destroyed_actors_.find(actor_id);
+                 it != destroyed_actors_.end()) {
+        actor = it->second;
       }
-
-      // With filters, skip the actor if it doesn't match the filter.
-      if (request.has_filters() &&
-          !filter_fn(request.filters(), iter.second->GetActorTableData())) {
-        ++num_filtered;
-        continue;
+      const bool after_page_token =
+          !request.has_page_token() || request.page_token().empty() ||
+          request.filters().actor_id() > request.page_token();
+      if (actor != nullptr && after_page_token && limit != 0 &&
+          MatchesActorFilters(request.filters(), actor->GetActorTableData())) {
+        *reply->add_actor_table_data() = actor->GetActorTableData();
       }
-
-      count += 1;
-      *reply->add_actor_table_data() = iter.second->GetActorTableData();
-    }
-
-    for (const auto &iter : destroyed_actors_) {
-      if (limit != -1 && count >= limit) {
-        break;
+      num_filtered = total_actors - reply->actor_table_data_size();
+    } else {
+      if (request.has_page_token() && !request.page_token().empty() &&
+          request.page_token().size() != ActorID::Size()) {
+        GCS_RPC_SEND_REPLY(send_reply_callback,
+                           reply,
+                           Status::InvalidArgument("Invalid page token."));
+        return;
       }
-      // With filters, skip the actor if it doesn't match the filter.
-      if (request.has_filters() &&
-          !filter_fn(request.filters(), iter.second->GetActorTableData())) {
-        ++num_filtered;
-        continue;
+      // Scan the smallest index that the filters allow. The actors outside of it don't
+      // match the filters.
+      static const ActorIndex kEmptyIndex;
+      const ActorIndex *index = &actor_index_;
+      if (request.filters().has_job_id()) {
+        auto it = actor_index_by_job_.find(JobID::FromBinary(request.filters().job_id()));
+        index = it != actor_index_by_job_.end() ? &it->second : &kEmptyIndex;
+      } else if (request.filters().has_state()) {
+        auto it = actor_index_by_state_.find(request.filters().state());
+        index = it != actor_index_by_state_.end() ? &it->second : &kEmptyIndex;
+      }
+      num_filtered = total_actors - index->size();
+      // A page lists the actors in the order of their ids. Without a page token, the
+      // registered actors are listed before the destroyed ones, so that the limit
+      // doesn't leave live actors out behind dead ones.
+      const bool paged = request.has_page_token();
+      bool full = false;
+      for (int pass = 0; pass < (paged ? 1 : 2) && !full; ++pass) {
+        auto it = index->begin();
+        if (paged && !request.page_token().empty()) {
+          it = index->upper_bound(ActorID::FromBinary(request.page_token()));
+        }
+        for (; it != index->end(); ++it) {
+          if (!paged && registered_actors_.contains(it->first) != (pass == 0)) {
+            // Listed by the other pass.
+            continue;
+          }
+          const auto &data = it->second.actor->GetActorTableData();
+          // With filters, skip the actor if it doesn't match the filter.
+          if (request.has_filters() && !MatchesActorFilters(request.filters(), data)) {
+            ++num_filtered;
+            continue;
+          }
+          if (limit != -1 && count >= limit) {
+            // There is a next page, which starts after the last actor of this one.
+            if (paged && count > 0) {
+              reply->set_next_page_token(
+                  reply->actor_table_data(reply->actor_table_data_size() - 1)
+                      .actor_id());
+            }
+            full = true;
+            break;
+          }
+          count += 1;
+          *reply->add_actor_table_data() = data;
+        }
       }
-
-      count += 1;
-      *reply->add_actor_table_data() = iter.second->GetActorTableData();
     }
     reply->set_num_filtered(num_filtered);
     RAY_LOG(DEBUG) << "Finished getting all actor info.";
@@ -410,7 +518,7 @@ void GcsActorManager::HandleGetAllActorInfo(rpc::GetAllActorInfoRequest request,
   // We don't maintain an in-memory cache of all actors which belong to dead
   // jobs, so fetch it from redis.
   Status status = gcs_table_storage_->ActorTable().GetAll(
-      [reply, send_reply_callback, limit, request, filter_fn](
+      [reply, send_reply_callback, limit, request](
           absl::flat_hash_map<ActorID, rpc::ActorTableData> &&result) {
         auto total_actors = result.size();
 
@@ -419,23 +527,38 @@ void GcsActorManager::HandleGetAllActorInfo(rpc::GetAllActorInfoRequest request,
         RAY_CHECK(arena != nullptr);
         auto ptr = google::protobuf::Arena::Create<
             absl::flat_hash_map<ActorID, rpc::ActorTableData>>(arena, std::move(result));
+        std::optional<ActorInfoPage> page;
+        if (request.has_page_token()) {
+          page.emplace(request.page_token(), limit);
+        }
         auto count = 0;
         auto num_filtered = 0;
         for (const auto &pair : *ptr) {
-          if (limit != -1 && count >= limit) {
+          if (!page.has_value() && limit != -1 && count >= limit) {
             break;
           }
           // With filters, skip the actor if it doesn't match the filter.
-          if (request.has_filters() && !filter_fn(request.filters(), pair.second)) {
+          if (request.has_filters() &&
+              !MatchesActorFilters(request.filters(), pair.second)) {
             ++num_filtered;
             continue;
           }
+          if (page.has_value()) {
+            page->Add(&pair.second);
+            continue;
+          }
           count += 1;
 
           // TODO yic: Fix const cast
           reply->mutable_actor_table_data()->UnsafeArenaAddAllocated(
               const_cast<rpc::ActorTableData *>(&pair.second));
         }
+        if (page.has_value()) {
+          for (const auto *data : page->Take(reply->mutable_next_page_token())) {
+            reply->mutable_actor_table_data()->UnsafeArenaAddAllocated(
+                const_cast<rpc::ActorTableData *>(data));
+          }
+        }
         reply->set_num_filtered(num_filtered);
         GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
         RAY_LOG(DEBUG) << "Finished getting all actor info.";
@@ -581,6 +704,7 @@ Status GcsActorManager::RegisterActor(const ray::rpc::RegisterActorRequest &requ
 
   actor_to_register_callbacks_[actor_id].emplace_back(std::move(success_callback));
   registered_actors_.emplace(actor->GetActorID(), actor);
+  ReindexActor(actor_id);
   function_manager_.AddJobReference(actor_id.JobId());
 
   const auto &owner_address = actor->GetOwnerAddress();
@@ -698,6 +822,7 @@ Status GcsActorManager::CreateActor(const ray::rpc::CreateActorRequest &request,
   auto actor = std::make_shared<GcsActor>(
       request.task_spec(), actor_namespace, actor_state_counter_);
   actor->UpdateState(rpc::ActorTableData::PENDING_CREATION);
+  ReindexActor(actor->GetActorID());
   const auto &actor_table_data = actor->GetActorTableData();
   actor->GetMutableTaskSpec()->set_dependency_resolution_timestamp_ms(
       current_sys_time_ms());
@@ -709,6 +834,7 @@ Status GcsActorManager::CreateActor(const ray::rpc::CreateActorRequest &request,
   // Update the registered actor as its creation task specification may have changed due
   // to resolved dependencies.
   registered_actors_[actor_id] = actor;
+  ReindexActor(actor_id);
 
   // Schedule the actor.
   gcs_actor_scheduler_->Schedule(actor);
@@ -829,6 +955,7 @@ void GcsActorManager::DestroyActor(const ActorID &actor_id,
   const auto actor = std::move(it->second);
 
   registered_actors_.erase(it);
+  ReindexActor(actor->GetActorID());
   RAY_LOG(DEBUG) << "Try to kill actor " << actor->GetActorID() << ", with status "
                  << actor->GetState() << ", name " << actor->GetName();
   // Clean up the client to the actor's owner, if necessary.
@@ -885,6 +1012,7 @@ void GcsActorManager::DestroyActor(const ActorID &actor_id,
   // entirely if the callers check directly whether the owner is still alive.
   auto mutable_actor_table_data = actor->GetMutableActorTableData();
   actor->UpdateState(rpc::ActorTableData::DEAD);
+  ReindexActor(actor->GetActorID());
   auto time = current_sys_time_ms();
   mutable_actor_table_data->set_end_time(time);
   mutable_actor_table_data->set_timestamp(time);
@@ -1175,6 +1303,7 @@ void GcsActorManager::ReconstructActor(const ActorID &actor_id,
     // between memory cache and storage.
     mutable_actor_table_data->set_num_restarts(num_restarts + 1);
     actor->UpdateState(rpc::ActorTableData::RESTARTING);
+    ReindexActor(actor->GetActorID());
     // Make sure to reset the address before flushing to GCS. Otherwise,
     // GCS will mistakenly consider this lease request succeeds when restarting.
     actor->UpdateAddress(rpc::Address());
@@ -1191,6 +1320,7 @@ void GcsActorManager::ReconstructActor(const ActorID &actor_id,
   } else {
     RemoveActorNameFromRegistry(actor);
     actor->UpdateState(rpc::ActorTableData::DEAD);
+    ReindexActor(actor->GetActorID());
     mutable_actor_table_data->mutable_death_cause()->CopyFrom(death_cause);
     auto time = current_sys_time_ms();
     mutable_actor_table_data->set_end_time(time);
@@ -1297,6 +1427,7 @@ void GcsActorManager::OnActorCreationSuccess(const std::shared_ptr<GcsActor> &ac
     mutable_actor_table_data->set_start_time(time);
   }
   actor->UpdateState(rpc::ActorTableData::ALIVE);
+  ReindexActor(actor->GetActorID());
 
   // We should register the entry to the in-memory index before flushing them to
   // GCS because otherwise, there could be timing problems due to asynchronous Put.
@@ -1354,6 +1485,7 @@ void GcsActorManager::Initialize(const GcsInitData &gcs_init_data) {
       auto actor = std::make_shared<GcsActor>(
           actor_table_data, iter->second, actor_state_counter_);
       registered_actors_.emplace(actor_id, actor);
+      ReindexActor(actor_id);
       function_manager_.AddJobReference(actor->GetActorID().JobId());
       if (!actor->GetName().empty()) {
         auto &actors_in_namespace = named_actors_[actor->GetRayNamespace()];
@@ -1386,6 +1518,7 @@ void GcsActorManager::Initialize(const GcsInitData &gcs_init_data) {
       dead_actors.push_back(actor_id);
       auto actor = std::make_shared<GcsActor>(actor_table_data, actor_state_counter_);
       destroyed_actors_.emplace(actor_id, actor);
+      ReindexActor(actor_id);
       sorted_destroyed_actor_list_.emplace_back(actor_id,
                                                 (int64_t)actor_table_data.timestamp());
     }
@@ -1538,15 +1671,45 @@ void GcsActorManager::AddDestroyedActorToCache(const std::shared_ptr<GcsActor> &
     const auto &actor_id = sorted_destroyed_actor_list_.front().first;
     RAY_CHECK_OK(gcs_table_storage_->ActorTable().Delete(actor_id, nullptr));
     destroyed_actors_.erase(actor_id);
+    ReindexActor(actor_id);
     sorted_destroyed_actor_list_.pop_front();
   }
 
   if (destroyed_actors_.emplace(actor->GetActorID(), actor).second) {
+    ReindexActor(actor->GetActorID());
     sorted_destroyed_actor_list_.emplace_back(
         actor->GetActorID(), (int64_t)actor->GetActorTableData().timestamp());
   }
 }
 
+void GcsActorManager::ReindexActor(const ActorID &actor_id) {
+  auto erase_from = [&actor_id](auto *indexes, const auto &key) {
+    auto it = indexes->find(key);
+    it->second.erase(actor_id);
+    if (it->second.empty()) {
+      indexes->erase(it);
+    }
+  };
+  if (auto it = actor_index_.find(actor_id); it != actor_index_.end()) {
+    erase_from(&actor_index_by_job_, it->second.job_id);
+    erase_from(&actor_index_by_state_, it->second.state);
+    actor_index_.erase(it);
+  }
+  const GcsActor *actor = nullptr;
+  if (auto it = registered_actors_.find(actor_id); it != registered_actors_.end()) {
+    actor = it->second.get();
+  } else if (auto it = destroyed_actors_.find(actor_id); it != destroyed_actors_.end()) {
+    actor = it->second.get();
+  }
+  if (actor == nullptr) {
+    return;
+  }
+  const IndexedActor indexed{actor, actor_id.JobId(), actor->GetState()};
+  actor_index_.emplace(actor_id, indexed);
+  actor_index_by_job_[indexed.job_id].emplace(actor_id, indexed);
+  actor_index_by_state_[indexed.state].emplace(actor_id, indexed);
+}
+
 void GcsActorManager::CancelActorInScheduling(const std::shared_ptr<GcsActor> &actor,
                                               const TaskID &task_id) {
   RAY_LOG(DEBUG) << "Cancel actor in scheduling: actor_id " << actor->GetActorID()
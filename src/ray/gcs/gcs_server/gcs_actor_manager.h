@@ -15,8 +15,10 @@
 #pragma once
 #include <gtest/gtest_prod.h>
 
+#include <cstring>
 #include <utility>
 
+#include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
 #include "ray/common/id.h"
 #include "ray/common/runtime_env_manager.h"
@@ -548,6 +550,12 @@ class GcsActorManager : public rpc::ActorInfoHandler {
   /// \param actor The actor to be killed.
   void AddDestroyedActorToCache(const std::shared_ptr<GcsActor> &actor);
 
+  /// Update the entries of an actor in the actor indexes after it's added to or removed
+  /// from `registered_actors_` or `destroyed_actors_`, or its state changes.
+  ///
+  /// \param actor_id The actor to index.
+  void ReindexActor(const ActorID &actor_id);
+
   std::shared_ptr<rpc::ActorTableData> GenActorDataOnlyWithStates(
       const rpc::ActorTableData &actor) {
     auto actor_delta = std::make_shared<rpc::ActorTableData>();
@@ -626,6 +634,29 @@ class GcsActorManager : public rpc::ActorInfoHandler {
   /// The actors are sorted according to the timestamp, and the oldest is at the head of
   /// the list.
   std::list<std::pair<ActorID, int64_t>> sorted_destroyed_actor_list_;
+
+  /// Orders actor ids like their binaries, which are the page tokens of
+  /// GetAllActorInfo.
+  struct ActorIDBinaryLess {
+    bool operator()(const ActorID &left, const ActorID &right) const {
+      return std::memcmp(left.Data(), right.Data(), ActorID::Size()) < 0;
+    }
+  };
+  /// An actor of the actor indexes, with the job and the state it's indexed by.
+  struct IndexedActor {
+    const GcsActor *actor;
+    JobID job_id;
+    rpc::ActorTableData::ActorState state;
+  };
+  using ActorIndex = absl::btree_map<ActorID, IndexedActor, ActorIDBinaryLess>;
+  /// The actors of `registered_actors_` and `destroyed_actors_` in the order of their
+  /// ids, so that a page of GetAllActorInfo starts at its token instead of scanning all
+  /// the actors.
+  ActorIndex actor_index_;
+  /// The actors of `actor_index_` by job.
+  absl::flat_hash_map<JobID, ActorIndex> actor_index_by_job_;
+  /// The actors of `actor_index_` by state.
+  absl::flat_hash_map<rpc::ActorTableData::ActorState, ActorIndex> actor_index_by_state_;
   /// Maps actor names to their actor ID for lookups by name, first keyed by their
   /// namespace.
   absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, ActorID>>
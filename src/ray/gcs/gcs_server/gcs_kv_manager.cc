@@ -141,6 +141,88 @@ void GcsInternalKVManager::HandleInternalKVKeys(
   }
 }
 
+void IoContextInternalKV::Get(const std::string &ns,
+                              const std::string &key,
+                              std::function<void(std::optional<std::string>)> callback) {
+  kv_io_context_.post(
+      [this, ns, key, callback = PostToCaller(std::move(callback), "InternalKV.Get")]() {
+        delegate_.Get(ns, key, callback);
+      },
+      "InternalKV.Get");
+}
+
+void IoContextInternalKV::MultiGet(
+    const std::string &ns,
+    const std::vector<std::string> &keys,
+    std::function<void(std::unordered_map<std::string, std::string>)> callback) {
+  kv_io_context_.post(
+      [this,
+       ns,
+       keys,
+       callback = PostToCaller(std::move(callback), "InternalKV.MultiGet")]() {
+        delegate_.MultiGet(ns, keys, callback);
+      },
+      "InternalKV.MultiGet");
+}
+
+void IoContextInternalKV::Put(const std::string &ns,
+                              const std::string &key,
+                              const std::string &value,
+                              bool overwrite,
+                              std::function<void(bool)> callback) {
+  kv_io_context_.post(
+      [this,
+       ns,
+       key,
+       value,
+       overwrite,
+       callback = PostToCaller(std::move(callback), "InternalKV.Put")]() {
+        delegate_.Put(ns, key, value, overwrite, callback);
+      },
+      "InternalKV.Put");
+}
+
+void IoContextInternalKV::Del(const std::string &ns,
+                              const std::string &key,
+                              bool del_by_prefix,
+                              std::function<void(int64_t)> callback) {
+  kv_io_context_.post(
+      [this,
+       ns,
+       key,
+       del_by_prefix,
+       callback = PostToCaller(std::move(callback), "InternalKV.Del")]() {
+        delegate_.Del(ns, key, del_by_prefix, callback);
+      },
+      "InternalKV.Del");
+}
+
+void IoContextInternalKV::Exists(const std::string &ns,
+                                 const std::string &key,
+                                 std::function<void(bool)> callback) {
+  kv_io_context_.post(
+      [this,
+       ns,
+       key,
+       callback = PostToCaller(std::move(callback), "InternalKV.Exists")]() {
+        delegate_.Exists(ns, key, callback);
+      },
+      "InternalKV.Exists");
+}
+
+void IoContextInternalKV::Keys(const std::string &ns,
+                               const std::string &prefix,
+                               std::function<void(std::vector<std::string>)> callback) {
+  kv_io_context_.post(
+      [this,
+       ns,
+       prefix,
+       callback = PostToCaller(std::move(callback), "InternalKV.Keys")]() {
+        delegate_.Keys(ns, prefix, callback);
+      },
+      "InternalKV.Keys");
+}
+
 Status GcsInternalKVManager::ValidateKey(const std::string &key) const {
   constexpr std::string_view kNamespacePrefix = "@namespace_";
   if (absl::StartsWith(key, kNamespacePrefix)) {
@@ -14,9 +14,11 @@
 
 #pragma once
 #include <memory>
+#include <tuple>
 
 #include "absl/container/btree_map.h"
 #include "absl/synchronization/mutex.h"
+#include "ray/common/asio/instrumented_io_context.h"
 #include "ray/gcs/redis_client.h"
 #include "ray/gcs/store_client/redis_store_client.h"
 #include "ray/rpc/gcs_server/gcs_rpc_server.h"
@@ -97,6 +99,73 @@ class InternalKVInterface {
   virtual ~InternalKVInterface(){};
 };
 
+/// \class IoContextInternalKV
+/// An InternalKVInterface that runs the calls of another one on the io_context of
+/// that KV, and posts their callbacks to the io_context of the caller. It lets the
+/// managers of one thread use a KV that runs on another thread, without either thread
+/// running the other's code.
+class IoContextInternalKV : public InternalKVInterface {
+ public:
+  /// \param delegate The KV to run the calls on.
+  /// \param kv_io_context The io_context `delegate` runs on.
+  /// \param caller_io_context The io_context to run the callbacks on.
+  IoContextInternalKV(InternalKVInterface &delegate,
+                      instrumented_io_context &kv_io_context,
+                      instrumented_io_context &caller_io_context)
+      : delegate_(delegate),
+        kv_io_context_(kv_io_context),
+        caller_io_context_(caller_io_context) {}
+
+  void Get(const std::string &ns,
+           const std::string &key,
+           std::function<void(std::optional<std::string>)> callback) override;
+
+  void MultiGet(const std::string &ns,
+                const std::vector<std::string> &keys,
+                std::function<void(std::unordered_map<std::string, std::string>)>
+                    callback) override;
+
+  void Put(const std::string &ns,
+           const std::string &key,
+           const std::string &value,
+           bool overwrite,
+           std::function<void(bool)> callback) override;
+
+  void Del(const std::string &ns,
+           const std::string &key,
+           bool del_by_prefix,
+           std::function<void(int64_t)> callback) override;
+
+  void Exists(const std::string &ns,
+              const std::string &key,
+              std::function<void(bool)> callback) override;
+
+  void Keys(const std::string &ns,
+            const std::string &prefix,
+            std::function<void(std::vector<std::string>)> callback) override;
+
+ private:
+  /// Wrap a callback of `delegate_` to run it on `caller_io_context_`.
+  template <typename... Args>
+  std::function<void(Args...)> PostToCaller(std::function<void(Args...)> callback,
+                                            const std::string &name) {
+    if (callback == nullptr) {
+      return nullptr;
+    }
+    return [this, callback = std::move(callback), name](Args... args) {
+      caller_io_context_.post(
+          [callback, args = std::make_tuple(std::move(args)...)]() mutable {
+            std::apply(callback, std::move(args));
+          },
+          name);
+    };
+  }
+
+  InternalKVInterface &delegate_;
+  instrumented_io_context &kv_io_context_;
+  instrumented_io_context &caller_io_context_;
+};
+
 /// This implementation class of `InternalKVHandler`.
 class GcsInternalKVManager : public rpc::InternalKVHandler {
  public:
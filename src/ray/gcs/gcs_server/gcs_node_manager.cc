@@ -14,8 +14,10 @@
 
 #include "ray/gcs/gcs_server/gcs_node_manager.h"
 
+#include <algorithm>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "ray/common/ray_config.h"
 #include "ray/gcs/pb_util.h"
@@ -181,15 +183,88 @@ void GcsNodeManager::DrainNode(const NodeID &node_id) {
 void GcsNodeManager::HandleGetAllNodeInfo(rpc::GetAllNodeInfoRequest request,
                                           rpc::GetAllNodeInfoReply *reply,
                                           rpc::SendReplyCallback send_reply_callback) {
-  // Here the unsafe allocate is safe here, because entry.second's life cycle is longer
-  // then reply.
-  // The request will be sent when call send_reply_callback and after that, reply will
-  // not be used any more. But entry is still valid.
-  for (const auto &entry : alive_nodes_) {
-    *reply->add_node_info_list() = *entry.second;
-  }
-  for (const auto &entry : dead_nodes_) {
-    *reply->add_node_info_list() = *entry.second;
+  const auto limit = request.has_limit() ? request.limit() : -1;
+  const auto &filters = request.filters();
+  const int64_t total = alive_nodes_.size() + dead_nodes_.size();
+  reply->set_total(total);
+
+  if (filters.has_node_id()) {
+    // Look the node up instead of scanning all the nodes.
+    const auto node_id = NodeID::FromBinary(filters.node_id());
+    std::shared_ptr<rpc::GcsNodeInfo> node;
+    if (auto it = alive_nodes_.find(node_id); it != alive_nodes_.end()) {
+      node = it->second;
+    } else if (auto it = dead_nodes_.find(node_id); it != dead_nodes_.end()) {
+      node = it->second;
+    }
+    const bool after_page_token = !request.has_page_token() ||
+                                  request.page_token().empty() ||
+                                  filters.node_id() > request.page_token();
+    if (node != nullptr && after_page_token && limit != 0 &&
+        (!filters.has_state() || filters.state() == node->state())) {
+      *reply->add_node_info_list() = *node;
+    }
+    reply->set_num_filtered(total - reply->node_info_list_size());
+  } else if (request.has_page_token()) {
+    const auto &page_token = request.page_token();
+    if (!page_token.empty() && page_token.size() != NodeID::Size()) {
+      GCS_RPC_SEND_REPLY(
+          send_reply_callback, reply, Status::InvalidArgument("Invalid page token."));
+      return;
+    }
+    // A page lists the nodes in the order of their ids, starting after the token.
+    int64_t num_filtered = 0;
+    std::vector<const rpc::GcsNodeInfo *> after_token;
+    auto collect_nodes = [&](const auto &nodes, rpc::GcsNodeInfo::GcsNodeState state) {
+      if (filters.has_state() && filters.state() != state) {
+        num_filtered += nodes.size();
+        return;
+      }
+      for (const auto &entry : nodes) {
+        if (entry.second->node_id() > page_token) {
+          after_token.push_back(entry.second.get());
+        }
+      }
+    };
+    collect_nodes(alive_nodes_, rpc::GcsNodeInfo::ALIVE);
+    collect_nodes(dead_nodes_, rpc::GcsNodeInfo::DEAD);
+    const size_t page_size =
+        limit == -1 ? after_token.size()
+                    : std::min(after_token.size(), static_cast<size_t>(limit));
+    std::partial_sort(after_token.begin(),
+                      after_token.begin() + page_size,
+                      after_token.end(),
+                      [](const rpc::GcsNodeInfo *lhs, const rpc::GcsNodeInfo *rhs) {
+                        return lhs->node_id() < rhs->node_id();
+                      });
+    for (size_t i = 0; i < page_size; ++i) {
+      *reply->add_node_info_list() = *after_token[i];
+    }
+    // There is a next page, which starts after the last node of this one.
+    if (page_size > 0 && page_size < after_token.size()) {
+      reply->set_next_page_token(after_token[page_size - 1]->node_id());
+    }
+    reply->set_num_filtered(num_filtered);
+  } else {
+    // With a state filter, only the nodes of that state are scanned.
+    int64_t num_filtered = 0;
+    int64_t count = 0;
+    auto add_nodes = [&](const auto &nodes, rpc::GcsNodeInfo::GcsNodeState state) {
+      if (filters.has_state() && filters.state() != state) {
+        num_filtered += nodes.size();
+        return;
+      }
+      for (const auto &entry : nodes) {
+        if (limit != -1 && count >= limit) {
+          break;
+        }
+        count += 1;
+        *reply->add_node_info_list() = *entry.second;
+      }
+    };
+    add_nodes(alive_nodes_, rpc::GcsNodeInfo::ALIVE);
+    add_nodes(dead_nodes_, rpc::GcsNodeInfo::DEAD);
+    reply->set_num_filtered(num_filtered);
   }
   GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
   ++counts_[CountType::GET_ALL_NODE_INFO_REQUEST];
@@ -30,8 +30,10 @@
 #include "ray/gcs/gcs_server/gcs_worker_manager.h"
 #include "ray/gcs/gcs_server/runtime_env_handler.h"
 #include "ray/gcs/gcs_server/store_client_kv.h"
+#include "ray/gcs/store_client/file_store_client.h"
 #include "ray/gcs/store_client/observable_store_client.h"
 #include "ray/pubsub/publisher.h"
+#include "ray/util/filesystem.h"
 #include "ray/util/util.h"
 
 namespace ray {
@@ -43,6 +45,8 @@ inline std::ostream &operator<<(std::ostream &str, GcsServer::StorageType val) {
     return str << "StorageType::IN_MEMORY";
   case GcsServer::StorageType::REDIS_PERSIST:
     return str << "StorageType::REDIS_PERSIST";
+  case GcsServer::StorageType::FILE_PERSIST:
+    return str << "StorageType::FILE_PERSIST";
   case GcsServer::StorageType::UNKNOWN:
     return str << "StorageType::UNKNOWN";
   default:
@@ -79,6 +83,11 @@ GcsServer::GcsServer(const ray::gcs::GcsServerConfig &config,
   case StorageType::REDIS_PERSIST:
     gcs_table_storage_ = std::make_shared<gcs::RedisGcsTableStorage>(GetOrConnectRedis());
     break;
+  case StorageType::FILE_PERSIST:
+    gcs_table_storage_ = std::make_shared<gcs::FileGcsTableStorage>(
+        main_service_,
+        JoinPaths(RayConfig::instance().gcs_file_storage_path(), "tables"));
+    break;
   default:
     RAY_LOG(FATAL) << "Unexpected storage type: " << storage_type_;
   }
@@ -152,7 +161,7 @@ void GcsServer::Start() {
 void GcsServer::GetOrGenerateClusterId(
     std::function<void(ClusterID cluster_id)> &&continuation) {
   static std::string const kTokenNamespace = "cluster";
-  kv_manager_->GetInstance().Get(
+  GetKVInstance().Get(
       kTokenNamespace,
       kClusterIdKey,
       [this, continuation = std::move(continuation)](
@@ -161,7 +170,7 @@ void GcsServer::GetOrGenerateClusterId(
           ClusterID cluster_id = ClusterID::FromRandom();
           RAY_LOG(INFO) << "No existing server cluster ID found. Generating new ID: "
                         << cluster_id.Hex();
-          kv_manager_->GetInstance().Put(
+          GetKVInstance().Put(
               kTokenNamespace,
               kClusterIdKey,
               cluster_id.Binary(),
@@ -274,6 +283,11 @@ void GcsServer::Stop() {
     ray_syncer_thread_->join();
     ray_syncer_.reset();
 
+    if (kv_io_thread_ != nullptr) {
+      kv_io_context_.stop();
+      kv_io_thread_->join();
+    }
+
     gcs_task_manager_->Stop();
 
     pubsub_handler_->Stop();
@@ -426,7 +440,7 @@ void GcsServer::InitGcsJobManager(const GcsInitData &gcs_init_data) {
                                                      gcs_publisher_,
                                                      *runtime_env_manager_,
                                                      *function_manager_,
-                                                     kv_manager_->GetInstance(),
+                                                     GetKVInstance(),
                                                      client_factory);
   gcs_job_manager_->Initialize(gcs_init_data);
 
@@ -531,6 +545,11 @@ GcsServer::StorageType GcsServer::GetStorageType() const {
     RAY_CHECK(!config_.redis_address.empty());
     return StorageType::REDIS_PERSIST;
   }
+  if (RayConfig::instance().gcs_storage() == kFileStorage) {
+    RAY_CHECK(!RayConfig::instance().gcs_file_storage_path().empty())
+        << "gcs_file_storage_path must be set to use the file GCS storage.";
+    return StorageType::FILE_PERSIST;
+  }
   RAY_LOG(FATAL) << "Unsupported GCS storage type: "
                  << RayConfig::instance().gcs_storage();
   return StorageType::UNKNOWN;
@@ -552,7 +571,7 @@ void GcsServer::InitRaySyncer(const GcsInitData &gcs_init_data) {
 }
 
 void GcsServer::InitFunctionManager() {
-  function_manager_ = std::make_unique<GcsFunctionManager>(kv_manager_->GetInstance());
+  function_manager_ = std::make_unique<GcsFunctionManager>(GetKVInstance());
 }
 
 void GcsServer::InitUsageStatsClient() {
@@ -561,28 +580,71 @@ void GcsServer::InitUsageStatsClient() {
 }
 
 void GcsServer::InitKVManager() {
+  const bool dedicated_thread = RayConfig::instance().gcs_internal_kv_dedicated_thread();
+  // The io_context the KV store client runs its callbacks on.
+  instrumented_io_context &kv_io_context =
+      dedicated_thread ? kv_io_context_ : main_service_;
   // TODO (yic): Use a factory with configs
   std::unique_ptr<InternalKVInterface> instance;
   switch (storage_type_) {
-  case (StorageType::REDIS_PERSIST):
+  case (StorageType::REDIS_PERSIST): {
+    std::shared_ptr<RedisClient> redis_client = GetOrConnectRedis();
+    if (dedicated_thread) {
+      // The shared client runs its callbacks on `main_service_`. The failure detector
+      // of the shared client also covers this one, as they talk to the same Redis.
+      kv_redis_client_ = std::make_shared<RedisClient>(GetRedisClientOptions());
+      auto status = kv_redis_client_->Connect(kv_io_context_);
+      RAY_CHECK(status.ok()) << "Failed to init redis KV client as " << status;
+      redis_client = kv_redis_client_;
+    }
     instance = std::make_unique<StoreClientInternalKV>(
-        std::make_unique<RedisStoreClient>(GetOrConnectRedis()));
+        std::make_unique<RedisStoreClient>(std::move(redis_client)));
     break;
+  }
   case (StorageType::IN_MEMORY):
     instance =
         std::make_unique<StoreClientInternalKV>(std::make_unique<ObservableStoreClient>(
-            std::make_unique<InMemoryStoreClient>(main_service_)));
+            std::make_unique<InMemoryStoreClient>(kv_io_context)));
+    break;
+  case (StorageType::FILE_PERSIST):
+    // The KV has its own directory, as the table storage owns the other one.
+    instance =
+        std::make_unique<StoreClientInternalKV>(std::make_unique<ObservableStoreClient>(
+            std::make_unique<FileStoreClient>(
+                kv_io_context,
+                JoinPaths(RayConfig::instance().gcs_file_storage_path(), "kv"))));
     break;
   default:
     RAY_LOG(FATAL) << "Unexpected storage type! " << storage_type_;
   }
 
   kv_manager_ = std::make_unique<GcsInternalKVManager>(std::move(instance));
+
+  if (dedicated_thread) {
+    // Large KV scans and values don't block the other managers. They only talk to
+    // the KV through `main_service_kv_instance_`, which passes the calls and their
+    // callbacks between the two threads.
+    main_service_kv_instance_ = std::make_unique<IoContextInternalKV>(
+        kv_manager_->GetInstance(), kv_io_context_, main_service_);
+    kv_io_thread_ = std::make_unique<std::thread>([this]() {
+      SetThreadName("gcs_kv");
+      boost::asio::io_service::work work(kv_io_context_);
+      kv_io_context_.run();
+    });
+  }
+}
+
+InternalKVInterface &GcsServer::GetKVInstance() {
+  if (main_service_kv_instance_ != nullptr) {
+    return *main_service_kv_instance_;
+  }
+  return kv_manager_->GetInstance();
 }
 
 void GcsServer::InitKVService() {
   RAY_CHECK(kv_manager_);
-  kv_service_ = std::make_unique<rpc::InternalKVGrpcService>(main_service_, *kv_manager_);
+  kv_service_ = std::make_unique<rpc::InternalKVGrpcService>(
+      kv_io_thread_ != nullptr ? kv_io_context_ : main_service_, *kv_manager_);
   // Register service.
   rpc_server_.RegisterService(*kv_service_, false /* token_auth */);
 }
@@ -613,7 +675,7 @@ void GcsServer::InitRuntimeEnvManager() {
             // these.
             callback(true);
           } else {
-            this->kv_manager_->GetInstance().Del(
+            this->GetKVInstance().Del(
                 "" /* namespace */,
                 plugin_uri /* key */,
                 false /* del_by_prefix*/,
@@ -647,7 +709,7 @@ void GcsServer::InitGcsAutoscalerStateManager(const GcsInitData &gcs_init_data)
   auto v2_enabled = std::to_string(RayConfig::instance().enable_autoscaler_v2());
   RAY_LOG(INFO) << "Autoscaler V2 enabled: " << v2_enabled;
 
-  kv_manager_->GetInstance().Put(
+  GetKVInstance().Put(
       kGcsAutoscalerStateNamespace,
       kGcsAutoscalerV2EnabledKey,
       v2_enabled,
@@ -658,7 +720,7 @@ void GcsServer::InitGcsAutoscalerStateManager(const GcsInitData &gcs_init_data)
           // GCS re-started), so we just try to get the value to check if it's correct.
           // TODO(rickyx): We could probably load some system configs from internal kv
           // when we initialize GCS from restart to avoid this.
-          kv_manager_->GetInstance().Get(
+          GetKVInstance().Get(
               kGcsAutoscalerStateNamespace,
               kGcsAutoscalerV2EnabledKey,
               [v2_enabled](std::optional<std::string> value) {
@@ -104,10 +104,12 @@ class GcsServer {
     UNKNOWN = 0,
     IN_MEMORY = 1,
     REDIS_PERSIST = 2,
+    FILE_PERSIST = 3,
   };
 
   static constexpr char kInMemoryStorage[] = "memory";
   static constexpr char kRedisStorage[] = "redis";
+  static constexpr char kFileStorage[] = "file";
 
   void UpdateGcsResourceManagerInTest(
       const NodeID &node_id,
@@ -164,6 +166,10 @@ class GcsServer {
   /// Initialize KV manager.
   void InitKVManager();
 
+  /// Get the KV for the managers running on `main_service_`. Its callbacks run on
+  /// `main_service_` even if the KV manager has its own thread.
+  InternalKVInterface &GetKVInstance();
+
   /// Initialize KV service.
   void InitKVService();
 
@@ -268,9 +274,18 @@ class GcsServer {
   std::unique_ptr<rpc::WorkerInfoGrpcService> worker_info_service_;
   /// Placement Group info handler and service.
   std::unique_ptr<rpc::PlacementGroupInfoGrpcService> placement_group_info_service_;
+  /// The event loop and thread of the KV manager and service, if
+  /// `gcs_internal_kv_dedicated_thread` is set.
+  instrumented_io_context kv_io_context_;
+  std::unique_ptr<std::thread> kv_io_thread_;
+  /// The Redis connection of the KV manager when it has its own thread, so that its
+  /// replies are handled on `kv_io_context_`.
+  std::shared_ptr<RedisClient> kv_redis_client_;
   /// Global KV storage handler and service.
   std::unique_ptr<GcsInternalKVManager> kv_manager_;
   std::unique_ptr<rpc::InternalKVGrpcService> kv_service_;
+  /// The KV for the managers on `main_service_` when the KV manager has its own thread.
+  std::unique_ptr<InternalKVInterface> main_service_kv_instance_;
   /// Runtime env handler and service.
   std::unique_ptr<RuntimeEnvHandler> runtime_env_handler_;
   std::unique_ptr<rpc::RuntimeEnvGrpcService> runtime_env_service_;
@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "ray/common/asio/instrumented_io_context.h"
+#include "ray/gcs/store_client/file_store_client.h"
 #include "ray/gcs/store_client/in_memory_store_client.h"
 #include "ray/gcs/store_client/observable_store_client.h"
 #include "ray/gcs/store_client/redis_store_client.h"
@@ -340,5 +341,16 @@ class InMemoryGcsTableStorage : public GcsTableStorage {
             std::make_unique<InMemoryStoreClient>(main_io_service))) {}
 };
 
+/// \class FileGcsTableStorage
+/// FileGcsTableStorage is an implementation of `GcsTableStorage`
+/// that uses a write-ahead log and snapshots in a directory as storage.
+class FileGcsTableStorage : public GcsTableStorage {
+ public:
+  FileGcsTableStorage(instrumented_io_context &main_io_service,
+                      const std::string &storage_path)
+      : GcsTableStorage(std::make_shared<ObservableStoreClient>(
+            std::make_unique<FileStoreClient>(main_io_service, storage_path))) {}
+};
+
 }  // namespace gcs
 }  // namespace ray
@@ -0,0 +1,489 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/gcs_server/gcs_task_events_archive.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/gzip_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+namespace gcs {
+
+namespace {
+
+std::string Compress(std::string_view data) {
+  std::string compressed;
+  google::protobuf::io::StringOutputStream output(&compressed);
+  google::protobuf::io::GzipOutputStream::Options options;
+  options.format = google::protobuf::io::GzipOutputStream::ZLIB;
+  google::protobuf::io::GzipOutputStream gzip_output(&output, options);
+  {
+    google::protobuf::io::CodedOutputStream coded_output(&gzip_output);
+    coded_output.WriteRaw(data.data(), data.size());
+  }
+  RAY_CHECK(gzip_output.Close());
+  return compressed;
+}
+
+std::string Decompress(const std::string &compressed, size_t size) {
+  std::string data;
+  google::protobuf::io::ArrayInputStream input(compressed.data(), compressed.size());
+  google::protobuf::io::GzipInputStream gzip_input(
+      &input, google::protobuf::io::GzipInputStream::ZLIB);
+  google::protobuf::io::CodedInputStream coded_input(&gzip_input);
+  RAY_CHECK(coded_input.ReadString(&data, size));
+  return data;
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T> &vector) {
+  return vector.capacity() * sizeof(T);
+}
+
+/// The id of a string of a query that isn't interned in a chunk. No row has it.
+constexpr uint32_t kNotInterned = std::numeric_limits<uint32_t>::max();
+
+}  // namespace
+
+TaskEventsArchive::TaskEventsArchive(size_t chunk_size) : chunk_size_(chunk_size) {
+  RAY_CHECK(chunk_size_ > 0);
+}
+
+uint32_t TaskEventsArchive::Chunk::Intern(const std::string &str) {
+  auto it = string_ids.find(str);
+  if (it != string_ids.end()) {
+    return it->second;
+  }
+  if (strings.empty()) {
+    // The id 0 means the field isn't set.
+    strings.emplace_back();
+  }
+  // The deque doesn't move its elements, so the views stay valid.
+  const uint32_t id = strings.size();
+  const auto &interned = strings.emplace_back(str);
+  string_ids.emplace(interned, id);
+  return id;
+}
+
+std::optional<uint32_t> TaskEventsArchive::Chunk::FindString(std::string_view str) const {
+  auto it = string_ids.find(str);
+  if (it == string_ids.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void TaskEventsArchive::Add(rpc::TaskEvents &&task_events) {
+  if (chunks_.empty() || chunks_.back().NumRows() == chunk_size_) {
+    if (!chunks_.empty()) {
+      Seal(chunks_.back());
+    }
+    auto &chunk = chunks_.emplace_back();
+    chunk.first_row = next_row_;
+  }
+  auto &chunk = chunks_.back();
+  const uint64_t row = next_row_++;
+
+  // Move the fields kept in columns out of the task events.
+  const bool has_task_info = task_events.has_task_info();
+  const bool has_state_updates = task_events.has_state_updates();
+  const auto task_id = TaskID::FromBinary(task_events.task_id());
+  chunk.task_ids.append(task_events.task_id());
+  chunk.attempt_numbers.push_back(task_events.attempt_number());
+  chunk.job_ids.push_back(chunk.Intern(task_events.job_id()));
+  auto *task_info = task_events.mutable_task_info();
+  chunk.names.push_back(task_info->name().empty() ? 0 : chunk.Intern(task_info->name()));
+  chunk.func_or_class_names.push_back(
+      task_info->func_or_class_name().empty()
+          ? 0
+          : chunk.Intern(task_info->func_or_class_name()));
+  chunk.actor_ids.push_back(
+      task_info->has_actor_id() ? chunk.Intern(task_info->actor_id()) : 0);
+  auto *state_updates = task_events.mutable_state_updates();
+  chunk.node_ids.push_back(
+      state_updates->has_node_id() ? chunk.Intern(state_updates->node_id()) : 0);
+  chunk.worker_ids.push_back(
+      state_updates->has_worker_id() ? chunk.Intern(state_updates->worker_id()) : 0);
+  chunk.num_profile_events.push_back(NumProfileEvents(task_events));
+  chunk.has_task_info.push_back(has_task_info);
+  chunk.has_state_updates.push_back(has_state_updates);
+  chunk.is_driver.push_back(has_task_info &&
+                            task_info->type() == rpc::TaskType::DRIVER_TASK);
+  chunk.taken.push_back(false);
+
+  auto [it, inserted] = last_task_rows_.emplace(task_id.Hash(), row);
+  uint64_t prev_task_row_distance = 0;
+  if (!inserted) {
+    prev_task_row_distance = row - it->second;
+    if (prev_task_row_distance > std::numeric_limits<uint32_t>::max()) {
+      // The previous rows are too far, so they're not linked any more.
+      prev_task_row_distance = 0;
+    }
+    it->second = row;
+  }
+  chunk.prev_task_rows.push_back(prev_task_row_distance);
+
+  task_events.clear_task_id();
+  task_events.clear_attempt_number();
+  task_events.clear_job_id();
+  task_info->clear_name();
+  task_info->clear_func_or_class_name();
+  task_info->clear_actor_id();
+  state_updates->clear_node_id();
+  state_updates->clear_worker_id();
+  if (!has_task_info) {
+    task_events.clear_task_info();
+  }
+  if (!has_state_updates) {
+    task_events.clear_state_updates();
+  }
+  task_events.AppendToString(&chunk.data);
+  chunk.data_ends.push_back(chunk.data.size());
+  ++num_task_events_;
+}
+
+void TaskEventsArchive::Seal(Chunk &chunk) {
+  for (size_t begin = 0; begin < chunk.NumRows(); begin += kRowsPerBlock) {
+    const size_t end = std::min(begin + kRowsPerBlock, chunk.NumRows());
+    const size_t data_begin = begin == 0 ? 0 : chunk.data_ends[begin - 1];
+    const size_t data_end = chunk.data_ends[end - 1];
+    chunk.blocks.push_back(Compress(
+        std::string_view(chunk.data.data() + data_begin, data_end - data_begin)));
+  }
+  std::string().swap(chunk.data);
+}
+
+bool TaskEventsArchive::HasRow(uint64_t row) const {
+  return !chunks_.empty() && row >= chunks_.front().first_row && row < next_row_;
+}
+
+bool TaskEventsArchive::RowHasTask(const Chunk &chunk,
+                                   size_t index,
+                                   const TaskID &task_id) const {
+  return std::string_view(chunk.task_ids).substr(index * TaskID::Size(),
+                                                 TaskID::Size()) ==
+         std::string_view(reinterpret_cast<const char *>(task_id.Data()),
+                          TaskID::Size());
+}
+
+std::optional<rpc::TaskEvents> TaskEventsArchive::Take(const TaskAttempt &task_attempt) {
+  const auto &[task_id, attempt_number] = task_attempt;
+  auto it = last_task_rows_.find(task_id.Hash());
+  if (it == last_task_rows_.end()) {
+    return std::nullopt;
+  }
+  uint64_t row = it->second;
+  while (HasRow(row)) {
+    auto &chunk = GetChunk(row);
+    const size_t index = row - chunk.first_row;
+    if (!chunk.taken[index] && chunk.attempt_numbers[index] == attempt_number &&
+        RowHasTask(chunk, index, task_id)) {
+      std::vector<rpc::TaskEvents> result;
+      DecodeRows({row}, &result);
+      chunk.taken[index] = true;
+      --num_task_events_;
+      return std::move(result.front());
+    }
+    if (chunk.prev_task_rows[index] == 0) {
+      break;
+    }
+    row -= chunk.prev_task_rows[index];
+  }
+  return std::nullopt;
+}
+
+void TaskEventsArchive::EvictOldestChunk(const EvictedCallback &on_evicted) {
+  RAY_CHECK(!chunks_.empty());
+  const auto &chunk = chunks_.front();
+  for (size_t index = 0; index < chunk.NumRows(); ++index) {
+    const auto task_id = TaskID::FromBinary(
+        chunk.task_ids.substr(index * TaskID::Size(), TaskID::Size()));
+    // The rows of the task are all evicted if its last row is.
+    auto it = last_task_rows_.find(task_id.Hash());
+    if (it != last_task_rows_.end() && it->second == chunk.first_row + index) {
+      last_task_rows_.erase(it);
+    }
+    if (chunk.taken[index]) {
+      continue;
+    }
+    --num_task_events_;
+    on_evicted(JobID::FromBinary(chunk.strings[chunk.job_ids[index]]),
+               std::make_pair<>(task_id, chunk.attempt_numbers[index]),
+               chunk.num_profile_events[index]);
+  }
+  chunks_.pop_front();
+}
+
+std::vector<uint64_t> TaskEventsArchive::GetTaskRows(
+    const absl::flat_hash_set<TaskID> &task_ids) const {
+  std::vector<uint64_t> rows;
+  for (const auto &task_id : task_ids) {
+    auto it = last_task_rows_.find(task_id.Hash());
+    if (it == last_task_rows_.end()) {
+      continue;
+    }
+    uint64_t row = it->second;
+    while (HasRow(row)) {
+      const auto &chunk = GetChunk(row);
+      const size_t index = row - chunk.first_row;
+      if (!chunk.taken[index] && RowHasTask(chunk, index, task_id)) {
+        rows.push_back(row);
+      }
+      if (chunk.prev_task_rows[index] == 0) {
+        break;
+      }
+      row -= chunk.prev_task_rows[index];
+    }
+  }
+  // Decode the rows of a block together.
+  std::sort(rows.begin(), rows.end(), std::greater<uint64_t>());
+  return rows;
+}
+
+int TaskEventsArchive::CompareRowTaskAttempt(const Chunk &chunk,
+                                             size_t index,
+                                             const TaskAttempt &task_attempt) {
+  const int cmp = std::memcmp(chunk.task_ids.data() + index * TaskID::Size(),
+                              task_attempt.first.Data(),
+                              TaskID::Size());
+  if (cmp != 0) {
+    return cmp;
+  }
+  const auto attempt_number = static_cast<uint32_t>(chunk.attempt_numbers[index]);
+  const auto other_attempt_number = static_cast<uint32_t>(task_attempt.second);
+  return attempt_number < other_attempt_number
+             ? -1
+             : (attempt_number == other_attempt_number ? 0 : 1);
+}
+
+TaskEventsArchive::QueryStats TaskEventsArchive::GetTaskEvents(
+    const Query &query, std::vector<rpc::TaskEvents> *result) const {
+  QueryStats stats;
+  std::vector<uint64_t> rows;
+  auto truncate_row = [&stats](const Chunk &chunk, size_t index) {
+    ++stats.num_truncated;
+    stats.num_profile_events_truncated += chunk.num_profile_events[index];
+    stats.num_status_events_truncated += chunk.has_state_updates[index] ? 1 : 0;
+  };
+  // In page order, the rows selected are kept in a max-heap of their task attempts, so
+  // that a row before the last one selected replaces it once the limit is reached.
+  auto row_less = [this](uint64_t left, uint64_t right) {
+    const auto &left_chunk = GetChunk(left);
+    const size_t left_index = left - left_chunk.first_row;
+    const auto &right_chunk = GetChunk(right);
+    const size_t right_index = right - right_chunk.first_row;
+    const int cmp =
+        std::memcmp(left_chunk.task_ids.data() + left_index * TaskID::Size(),
+                    right_chunk.task_ids.data() + right_index * TaskID::Size(),
+                    TaskID::Size());
+    return cmp < 0 ||
+           (cmp == 0 && static_cast<uint32_t>(left_chunk.attempt_numbers[left_index]) <
+                            static_cast<uint32_t>(right_chunk.attempt_numbers[right_index]));
+  };
+  // The ids of the strings of the query in the chunk of the last row scanned.
+  const Chunk *ids_chunk = nullptr;
+  uint32_t job_id = kNotInterned;
+  uint32_t name = kNotInterned;
+  uint32_t actor_id = kNotInterned;
+  // Evaluate the query on the columns of a row that wasn't taken, and select it if it
+  // matches and is under the limit.
+  auto scan_row = [&](const Chunk &chunk, size_t index) {
+    if (ids_chunk != &chunk) {
+      ids_chunk = &chunk;
+      if (query.job_id.has_value()) {
+        job_id = chunk.FindString(query.job_id->Binary()).value_or(kNotInterned);
+      }
+      if (query.name.has_value()) {
+        name = query.name->empty()
+                   ? 0
+                   : chunk.FindString(*query.name).value_or(kNotInterned);
+      }
+      if (query.actor_id.has_value()) {
+        actor_id = chunk.FindString(query.actor_id->Binary()).value_or(kNotInterned);
+      }
+    }
+    if (query.job_id.has_value() && chunk.job_ids[index] != job_id) {
+      return;
+    }
+    if ((query.require_task_info && !chunk.has_task_info[index]) ||
+        (query.exclude_driver && chunk.is_driver[index]) ||
+        (query.name.has_value() && chunk.names[index] != name) ||
+        (query.actor_id.has_value() && chunk.actor_ids[index] != 0 &&
+         chunk.actor_ids[index] != actor_id)) {
+      ++stats.num_filtered;
+      return;
+    }
+    const uint64_t row = chunk.first_row + index;
+    if (query.page_order) {
+      if (query.page_token.has_value() &&
+          CompareRowTaskAttempt(chunk, index, *query.page_token) <= 0) {
+        ++stats.num_before_page_token;
+        return;
+      }
+      if (query.limit >= 0 && static_cast<int64_t>(rows.size()) >= query.limit) {
+        if (rows.empty() || !row_less(row, rows.front())) {
+          truncate_row(chunk, index);
+          return;
+        }
+        std::pop_heap(rows.begin(), rows.end(), row_less);
+        const auto &last_chunk = GetChunk(rows.back());
+        truncate_row(last_chunk, rows.back() - last_chunk.first_row);
+        rows.back() = row;
+      } else {
+        rows.push_back(row);
+      }
+      std::push_heap(rows.begin(), rows.end(), row_less);
+      return;
+    }
+    if (query.limit < 0 || static_cast<int64_t>(rows.size()) < query.limit) {
+      rows.push_back(row);
+      return;
+    }
+    truncate_row(chunk, index);
+  };
+
+  if (query.task_ids != nullptr) {
+    for (const auto row : GetTaskRows(*query.task_ids)) {
+      const auto &chunk = GetChunk(row);
+      scan_row(chunk, row - chunk.first_row);
+    }
+  } else {
+    for (auto chunk = chunks_.rbegin(); chunk != chunks_.rend(); ++chunk) {
+      if (query.job_id.has_value() && !chunk->FindString(query.job_id->Binary())) {
+        // No task attempt of the job in the chunk.
+        continue;
+      }
+      for (size_t index = chunk->NumRows(); index-- > 0;) {
+        if (!chunk->taken[index]) {
+          scan_row(*chunk, index);
+        }
+      }
+    }
+  }
+  if (!query.page_order) {
+    DecodeRows(rows, result);
+    return stats;
+  }
+  // Decode the rows of a block together, then put the task events in page order.
+  std::sort(rows.begin(), rows.end(), std::greater<uint64_t>());
+  const size_t result_begin = result->size();
+  DecodeRows(rows, result);
+  const TaskAttemptPageOrder less;
+  std::sort(result->begin() + result_begin,
+            result->end(),
+            [&less](const rpc::TaskEvents &left, const rpc::TaskEvents &right) {
+              return less(GetTaskAttempt(left), GetTaskAttempt(right));
+            });
+  return stats;
+}
+
+void TaskEventsArchive::DecodeRows(const std::vector<uint64_t> &rows,
+                                   std::vector<rpc::TaskEvents> *result) const {
+  // The offset of the data of a row in the uncompressed data of its chunk.
+  auto data_begin_of = [](const Chunk &chunk, size_t index) -> size_t {
+    return index == 0 ? 0 : chunk.data_ends[index - 1];
+  };
+  // The uncompressed data of the last block decompressed.
+  const Chunk *block_chunk = nullptr;
+  size_t block_first_index = 0;
+  std::string block_data;
+  for (const auto row : rows) {
+    RAY_CHECK(HasRow(row));
+    const auto &chunk = GetChunk(row);
+    const size_t index = row - chunk.first_row;
+    std::string_view data = chunk.data;
+    size_t data_begin = data_begin_of(chunk, index);
+    size_t data_end = chunk.data_ends[index];
+    if (!chunk.blocks.empty()) {
+      const size_t first_index = index / kRowsPerBlock * kRowsPerBlock;
+      const size_t block_begin = data_begin_of(chunk, first_index);
+      if (block_chunk != &chunk || block_first_index != first_index) {
+        const size_t end_index = std::min(first_index + kRowsPerBlock, chunk.NumRows());
+        block_data = Decompress(chunk.blocks[first_index / kRowsPerBlock],
+                                chunk.data_ends[end_index - 1] - block_begin);
+        block_chunk = &chunk;
+        block_first_index = first_index;
+      }
+      data = block_data;
+      data_begin -= block_begin;
+      data_end -= block_begin;
+    }
+    auto &task_events = result->emplace_back();
+    RAY_CHECK(
+        task_events.ParseFromArray(data.data() + data_begin, data_end - data_begin));
+    DecodeColumns(chunk, index, &task_events);
+  }
+}
+
+void TaskEventsArchive::DecodeColumns(const Chunk &chunk,
+                                      size_t index,
+                                      rpc::TaskEvents *task_events) const {
+  task_events->set_task_id(chunk.task_ids.substr(index * TaskID::Size(), TaskID::Size()));
+  task_events->set_attempt_number(chunk.attempt_numbers[index]);
+  task_events->set_job_id(chunk.strings[chunk.job_ids[index]]);
+  if (chunk.names[index] != 0) {
+    task_events->mutable_task_info()->set_name(chunk.strings[chunk.names[index]]);
+  }
+  if (chunk.func_or_class_names[index] != 0) {
+    task_events->mutable_task_info()->set_func_or_class_name(
+        chunk.strings[chunk.func_or_class_names[index]]);
+  }
+  if (chunk.actor_ids[index] != 0) {
+    task_events->mutable_task_info()->set_actor_id(chunk.strings[chunk.actor_ids[index]]);
+  }
+  if (chunk.node_ids[index] != 0) {
+    task_events->mutable_state_updates()->set_node_id(
+        chunk.strings[chunk.node_ids[index]]);
+  }
+  if (chunk.worker_ids[index] != 0) {
+    task_events->mutable_state_updates()->set_worker_id(
+        chunk.strings[chunk.worker_ids[index]]);
+  }
+}
+
+size_t TaskEventsArchive::MemoryUsageBytes() const {
+  size_t bytes = 0;
+  for (const auto &chunk : chunks_) {
+    bytes += sizeof(Chunk) + chunk.task_ids.capacity() +
+             VectorBytes(chunk.attempt_numbers) + VectorBytes(chunk.job_ids) +
+             VectorBytes(chunk.names) + VectorBytes(chunk.func_or_class_names) +
+             VectorBytes(chunk.actor_ids) + VectorBytes(chunk.node_ids) +
+             VectorBytes(chunk.worker_ids) + VectorBytes(chunk.num_profile_events) +
+             VectorBytes(chunk.prev_task_rows) + VectorBytes(chunk.data_ends) +
+             (chunk.has_task_info.capacity() + chunk.has_state_updates.capacity() +
+              chunk.is_driver.capacity() + chunk.taken.capacity()) /
+                 8 +
+             chunk.data.capacity();
+    for (const auto &block : chunk.blocks) {
+      bytes += sizeof(std::string) + block.capacity();
+    }
+    for (const auto &str : chunk.strings) {
+      bytes += sizeof(std::string) + str.capacity();
+    }
+    bytes += chunk.string_ids.capacity() *
+             (sizeof(std::string_view) + sizeof(uint32_t) + 1);
+  }
+  bytes += last_task_rows_.capacity() * (sizeof(size_t) + sizeof(uint64_t) + 1);
+  return bytes;
+}
+
+}  // namespace gcs
+}  // namespace ray
@@ -0,0 +1,234 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "ray/common/id.h"
+#include "ray/gcs/pb_util.h"
+#include "src/ray/protobuf/gcs.pb.h"
+
+namespace ray {
+namespace gcs {
+
+/// \class TaskEventsArchive
+/// A compact in-memory store of the task events of terminated task attempts.
+///
+/// The task attempts are appended to chunks in the order they are added. A chunk keeps
+/// the fields used to look up task events in columns: the task ids, the attempt
+/// numbers, and the job ids, task names, actor ids and node and worker ids, interned in
+/// the chunk. The rest of each task attempt is serialized into the data of the chunk,
+/// which is compressed in blocks of `kRowsPerBlock` task attempts once the chunk is
+/// full. A query is evaluated on the columns, and only the blocks of the task attempts
+/// it returns are decompressed and decoded.
+///
+/// Task attempts are evicted a whole chunk at a time, from the oldest one, along with
+/// the strings interned in the chunk.
+///
+/// This class is not thread-safe.
+class TaskEventsArchive {
+ public:
+  /// The number of task attempts compressed together.
+  static constexpr size_t kRowsPerBlock = 256;
+
+  /// The callback of an evicted task attempt, with its job and number of profile
+  /// events.
+  using EvictedCallback = std::function<void(const JobID &, const TaskAttempt &, size_t)>;
+
+  /// A query of task events. The task events returned match all its set fields.
+  struct Query {
+    /// The job of the task events.
+    std::optional<JobID> job_id;
+    /// The tasks of the task events, if not null.
+    const absl::flat_hash_set<TaskID> *task_ids = nullptr;
+    /// The name of the task.
+    std::optional<std::string> name;
+    /// The actor of the task. Task events without an actor id match it.
+    std::optional<ActorID> actor_id;
+    /// Whether the task events of driver tasks are excluded.
+    bool exclude_driver = false;
+    /// Whether the task events without task info are excluded.
+    bool require_task_info = false;
+    /// The max number of task events returned, -1 for no limit.
+    int64_t limit = -1;
+    /// Whether the task events are returned in the order of their task attempts (see
+    /// `TaskAttemptPageOrder`). The limit then keeps the first task attempts in that
+    /// order instead of the most recent ones.
+    bool page_order = false;
+    /// With `page_order`, only the task attempts after this one are returned.
+    std::optional<TaskAttempt> page_token;
+  };
+
+  /// The task events of the job and tasks of a query that it doesn't return.
+  struct QueryStats {
+    /// The number of task events that don't match the other fields of the query.
+    int64_t num_filtered = 0;
+    /// The number of matching task events over the limit.
+    int64_t num_truncated = 0;
+    /// The number of profile events of the truncated task events.
+    int64_t num_profile_events_truncated = 0;
+    /// The number of truncated task events with state updates.
+    int64_t num_status_events_truncated = 0;
+    /// The number of matching task events up to the page token.
+    int64_t num_before_page_token = 0;
+  };
+
+  /// \param chunk_size The number of task attempts in a chunk.
+  explicit TaskEventsArchive(size_t chunk_size);
+
+  /// Add the task events of a task attempt.
+  ///
+  /// \param task_events The task events. The task attempt must not be in the archive.
+  void Add(rpc::TaskEvents &&task_events);
+
+  /// Remove a task attempt from the archive.
+  ///
+  /// \param task_attempt The task attempt.
+  /// \return The task events of the task attempt, or nullopt if it's not in the archive.
+  std::optional<rpc::TaskEvents> Take(const TaskAttempt &task_attempt);
+
+  /// Evict the task attempts of the oldest chunk.
+  ///
+  /// \param on_evicted Called with each evicted task attempt.
+  void EvictOldestChunk(const EvictedCallback &on_evicted);
+
+  /// Get the task events matching a query, from the most recently added, or in page
+  /// order if the query asks for it. Only the task events under the limit are decoded.
+  ///
+  /// \param query The query.
+  /// \param[out] result The task events are appended to it.
+  /// \return The stats of the task events not returned.
+  QueryStats GetTaskEvents(const Query &query,
+                           std::vector<rpc::TaskEvents> *result) const;
+
+  /// Return the number of task attempts in the archive.
+  size_t NumTaskEvents() const { return num_task_events_; }
+
+  /// Return the approximate memory used by the archive in bytes.
+  size_t MemoryUsageBytes() const;
+
+ private:
+  /// The task attempts of a chunk, one entry per row in every column.
+  struct Chunk {
+    /// The row id of the first task attempt.
+    uint64_t first_row = 0;
+    /// The binary task ids, of `TaskID::Size()` bytes each.
+    std::string task_ids;
+    std::vector<int32_t> attempt_numbers;
+    /// The strings interned in the chunk, 0 if the field isn't set.
+    std::vector<uint32_t> job_ids;
+    std::vector<uint32_t> names;
+    std::vector<uint32_t> func_or_class_names;
+    std::vector<uint32_t> actor_ids;
+    std::vector<uint32_t> node_ids;
+    std::vector<uint32_t> worker_ids;
+    std::vector<uint32_t> num_profile_events;
+    /// Whether the task events have task info and state updates, and are of a driver
+    /// task.
+    std::vector<bool> has_task_info;
+    std::vector<bool> has_state_updates;
+    std::vector<bool> is_driver;
+    /// The distance to the previous row of the same task, 0 if there's none.
+    std::vector<uint32_t> prev_task_rows;
+    /// The end of the data of each row, in the uncompressed data of the chunk.
+    std::vector<uint32_t> data_ends;
+    /// Whether the row was taken out of the archive.
+    std::vector<bool> taken;
+    /// The strings interned in the chunk, indexed by their ids. The id 0 is unused.
+    std::deque<std::string> strings;
+    absl::flat_hash_map<std::string_view, uint32_t> string_ids;
+    /// The uncompressed data of the chunk being filled.
+    std::string data;
+    /// The compressed data of a full chunk, per block of `kRowsPerBlock` rows.
+    std::vector<std::string> blocks;
+
+    size_t NumRows() const { return attempt_numbers.size(); }
+
+    /// Intern a string in the chunk.
+    ///
+    /// \return The id of the string, never 0.
+    uint32_t Intern(const std::string &str);
+
+    /// Return the id of a string interned in the chunk, or nullopt if it's not.
+    std::optional<uint32_t> FindString(std::string_view str) const;
+  };
+
+  /// Whether a row wasn't evicted yet.
+  bool HasRow(uint64_t row) const;
+
+  /// Return the chunk of a row that wasn't evicted.
+  Chunk &GetChunk(uint64_t row) {
+    return chunks_[(row - chunks_.front().first_row) / chunk_size_];
+  }
+  const Chunk &GetChunk(uint64_t row) const {
+    return chunks_[(row - chunks_.front().first_row) / chunk_size_];
+  }
+
+  /// Compress the data of a full chunk.
+  void Seal(Chunk &chunk);
+
+  /// Compare the task attempt of a row with a task attempt, in page order.
+  ///
+  /// \return A negative number if the row comes first, 0 if it's the task attempt, and a
+  /// positive number otherwise.
+  static int CompareRowTaskAttempt(const Chunk &chunk,
+                                   size_t index,
+                                   const TaskAttempt &task_attempt);
+
+  /// Whether a row is of a task attempt of the task.
+  bool RowHasTask(const Chunk &chunk, size_t index, const TaskID &task_id) const;
+
+  /// Return the rows of the task attempts of tasks, from the most recent.
+  std::vector<uint64_t> GetTaskRows(const absl::flat_hash_set<TaskID> &task_ids) const;
+
+  /// Decode rows into task events.
+  ///
+  /// \param rows The row ids, from the most recent.
+  /// \param[out] result The task events are appended to it.
+  void DecodeRows(const std::vector<uint64_t> &rows,
+                  std::vector<rpc::TaskEvents> *result) const;
+
+  /// Fill the fields kept in columns into the task events of a row.
+  void DecodeColumns(const Chunk &chunk,
+                     size_t index,
+                     rpc::TaskEvents *task_events) const;
+
+  /// The number of rows in a chunk.
+  const size_t chunk_size_;
+
+  /// The chunks, from the oldest. Every chunk but the last one is full.
+  std::deque<Chunk> chunks_;
+
+  /// The id of the next row added.
+  uint64_t next_row_ = 0;
+
+  /// The number of task attempts, excluding the taken ones.
+  size_t num_task_events_ = 0;
+
+  /// The last row of each task, by the hash of the task id. The rows of the other
+  /// attempts of a task are linked by `prev_task_rows`. Tasks with the same hash share
+  /// the links, so a lookup checks the task id of each row.
+  absl::flat_hash_map<size_t, uint64_t> last_task_rows_;
+};
+
+}  // namespace gcs
+}  // namespace ray
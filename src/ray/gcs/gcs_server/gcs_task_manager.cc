@@ -44,12 +44,12 @@ std::vector<rpc::TaskEvents> GcsTaskManager::GcsTaskManagerStorage::GetTaskEvent
 
 std::vector<rpc::TaskEvents> GcsTaskManager::GcsTaskManagerStorage::GetTaskEvents(
     JobID job_id) const {
+  std::vector<rpc::TaskEvents> result;
   auto task_locators_itr = job_index_.find(job_id);
-  if (task_locators_itr == job_index_.end()) {
-    // Not found any tasks related to this job.
-    return {};
+  if (task_locators_itr != job_index_.end()) {
+    result = GetTaskEvents(task_locators_itr->second);
   }
-  return GetTaskEvents(task_locators_itr->second);
+  return result;
 }
 
 std::vector<rpc::TaskEvents> GcsTaskManager::GcsTaskManagerStorage::GetTaskEvents(
@@ -66,6 +66,93 @@ std::vector<rpc::TaskEvents> GcsTaskManager::GcsTaskManagerStorage::GetTaskEvent
   return GetTaskEvents(select_task_locators);
 }
 
+TaskEventsArchive::QueryStats
+GcsTaskManager::GcsTaskManagerStorage::GetArchivedTaskEvents(
+    const TaskEventsArchive::Query &query, std::vector<rpc::TaskEvents> *result) const {
+  if (archive_ == nullptr) {
+    return {};
+  }
+  return archive_->GetTaskEvents(query, result);
+}
+
+std::vector<rpc::TaskEvents> GcsTaskManager::GcsTaskManagerStorage::GetTaskEventsPage(
+    const absl::flat_hash_set<TaskID> *task_ids,
+    const std::optional<JobID> &job_id,
+    const std::optional<TaskAttempt> &page_token,
+    int64_t limit,
+    const std::function<bool(const rpc::TaskEvents &)> &filter_fn,
+    PageStats *stats) const {
+  const TaskAttemptPageOrder less;
+  std::vector<rpc::TaskEvents> result;
+  if (task_ids == nullptr && !job_id.has_value()) {
+    // Scan the task attempts in order from the token, up to the end of the page.
+    stats->num_total = page_index_.size();
+    auto it = page_token.has_value() ? page_index_.upper_bound(*page_token)
+                                     : page_index_.begin();
+    for (; it != page_index_.end(); ++it) {
+      const auto &task_events = it->second->GetTaskEventsMutable();
+      if (!filter_fn(task_events)) {
+        ++stats->num_filtered;
+        continue;
+      }
+      if (limit >= 0 && static_cast<int64_t>(result.size()) >= limit) {
+        stats->has_more = true;
+        break;
+      }
+      result.push_back(task_events);
+    }
+    return result;
+  }
+
+  // The task attempts of the tasks or the job aren't ordered, so the page is selected
+  // among them before its task events are copied.
+  std::vector<std::pair<TaskAttempt, const rpc::TaskEvents *>> page;
+  auto add_candidates =
+      [&](const absl::flat_hash_set<std::shared_ptr<TaskEventLocator>> &locators) {
+        stats->num_total += locators.size();
+        for (const auto &loc : locators) {
+          const auto &task_events = loc->GetTaskEventsMutable();
+          const auto task_attempt = GetTaskAttempt(task_events);
+          if (page_token.has_value() && !less(*page_token, task_attempt)) {
+            continue;
+          }
+          if (!filter_fn(task_events)) {
+            ++stats->num_filtered;
+            continue;
+          }
+          page.emplace_back(task_attempt, &task_events);
+        }
+      };
+  if (task_ids != nullptr) {
+    for (const auto &task_id : *task_ids) {
+      auto it = task_index_.find(task_id);
+      if (it != task_index_.end()) {
+        add_candidates(it->second);
+      }
+    }
+  } else {
+    auto it = job_index_.find(*job_id);
+    if (it != job_index_.end()) {
+      add_candidates(it->second);
+    }
+  }
+  auto page_less = [&less](const auto &left, const auto &right) {
+    return less(left.first, right.first);
+  };
+  auto page_end = page.end();
+  if (limit >= 0 && static_cast<size_t>(limit) < page.size()) {
+    page_end = page.begin() + limit;
+    std::nth_element(page.begin(), page_end, page.end(), page_less);
+    stats->has_more = true;
+  }
+  std::sort(page.begin(), page_end, page_less);
+  result.reserve(page_end - page.begin());
+  for (auto it = page.begin(); it != page_end; ++it) {
+    result.push_back(*it->second);
+  }
+  return result;
+}
+
 std::vector<rpc::TaskEvents> GcsTaskManager::GcsTaskManagerStorage::GetTaskEvents(
     const absl::flat_hash_set<std::shared_ptr<TaskEventLocator>> &task_locators) const {
   std::vector<rpc::TaskEvents> result;
@@ -180,7 +267,8 @@ void GcsTaskManager::GcsTaskManagerStorage::UpdateExistingTaskAttempt(
 }
 
 std::shared_ptr<GcsTaskManager::GcsTaskManagerStorage::TaskEventLocator>
-GcsTaskManager::GcsTaskManagerStorage::AddNewTaskEvent(rpc::TaskEvents &&task_events) {
+GcsTaskManager::GcsTaskManagerStorage::AddNewTaskEvent(rpc::TaskEvents &&task_events,
+                                                       bool count_task_type) {
   // Create a new locator.
   auto target_list_index = gc_policy_->GetTaskListPriority(task_events);
   task_events_list_.at(target_list_index).push_front(std::move(task_events));
@@ -196,7 +284,8 @@ GcsTaskManager::GcsTaskManagerStorage::AddNewTaskEvent(rpc::TaskEvents &&task_ev
   // Stats tracking
   stats_counter_.Increment(kNumTaskEventsStored);
   // Bump the task counters by type.
-  if (added_task_events.has_task_info() && added_task_events.attempt_number() == 0) {
+  if (count_task_type && added_task_events.has_task_info() &&
+      added_task_events.attempt_number() == 0) {
     stats_counter_.Increment(
         kTaskTypeToCounterType.at(added_task_events.task_info().type()));
   }
@@ -213,6 +302,7 @@ void GcsTaskManager::GcsTaskManagerStorage::UpdateIndex(
   const auto worker_id = GetWorkerID(task_events);
 
   primary_index_.insert({task_attempt, loc});
+  page_index_.insert({task_attempt, loc});
   RAY_CHECK(!job_id.IsNil());
   RAY_CHECK(!task_id.IsNil());
 
@@ -259,6 +349,7 @@ void GcsTaskManager::GcsTaskManagerStorage::RemoveFromIndex(
 
   // Remove from primary index.
   primary_index_.erase(task_attempt);
+  page_index_.erase(task_attempt);
 }
 
 std::shared_ptr<GcsTaskManager::GcsTaskManagerStorage::TaskEventLocator>
@@ -275,6 +366,18 @@ GcsTaskManager::GcsTaskManagerStorage::UpdateOrInitTaskEventLocator(
     return loc_itr->second;
   }
 
+  if (archive_ != nullptr) {
+    if (auto archived_task_events = archive_->Take(task_attempt)) {
+      // New events of an archived task attempt, e.g. profile events reported after the
+      // task finished. Move it back to merge them.
+      stats_counter_.Decrement(kNumTaskEventsArchived);
+      auto loc = AddNewTaskEvent(std::move(*archived_task_events),
+                                 /*count_task_type=*/false);
+      UpdateExistingTaskAttempt(loc, events_by_task);
+      return loc;
+    }
+  }
+
   // A new task attempt
   auto loc = AddNewTaskEvent(std::move(events_by_task));
 
@@ -302,6 +405,34 @@ void GcsTaskManager::GcsTaskManagerStorage::RemoveTaskAttempt(
   task_events_list_[loc->GetCurrentListIndex()].erase(loc->GetCurrentListIterator());
 }
 
+void GcsTaskManager::GcsTaskManagerStorage::ArchiveTaskAttempt(
+    std::shared_ptr<TaskEventLocator> loc) {
+  RemoveFromIndex(loc);
+  auto &task_events_list = task_events_list_[loc->GetCurrentListIndex()];
+  archive_->Add(std::move(*loc->GetCurrentListIterator()));
+  task_events_list.erase(loc->GetCurrentListIterator());
+  stats_counter_.Decrement(kNumTaskEventsStored);
+  stats_counter_.Increment(kNumTaskEventsArchived);
+
+  if (archive_->NumTaskEvents() <= max_num_archived_task_events_) {
+    return;
+  }
+  RAY_LOG_EVERY_MS(WARNING, 10000)
+      << "Max number of archived tasks events (" << max_num_archived_task_events_
+      << ") allowed is reached. Old task events will be dropped. Set "
+         "`RAY_task_events_max_num_archived_task_in_gcs` to a higher value to "
+         "store more.";
+  archive_->EvictOldestChunk([this](const JobID &job_id,
+                                    const TaskAttempt &task_attempt,
+                                    size_t num_profile_events) {
+    job_task_summary_[job_id].RecordProfileEventsDropped(num_profile_events);
+    job_task_summary_[job_id].RecordTaskAttemptDropped(task_attempt);
+    stats_counter_.Decrement(kNumTaskEventsArchived);
+    stats_counter_.Increment(kTotalNumTaskAttemptsDropped);
+    stats_counter_.Increment(kTotalNumProfileTaskEventsDropped, num_profile_events);
+  });
+}
+
 void GcsTaskManager::GcsTaskManagerStorage::EvictTaskEvent() {
   // Choose one task event to evict
   size_t list_index = 0;
@@ -318,6 +449,10 @@ void GcsTaskManager::GcsTaskManagerStorage::EvictTaskEvent() {
   const auto &loc_iter = primary_index_.find(GetTaskAttempt(to_evict));
   RAY_CHECK(loc_iter != primary_index_.end());
 
+  if (archive_ != nullptr && IsTaskTerminated(to_evict)) {
+    ArchiveTaskAttempt(loc_iter->second);
+    return;
+  }
   RemoveTaskAttempt(loc_iter->second);
 }
 
@@ -366,18 +501,27 @@ void GcsTaskManager::HandleGetTaskEvents(rpc::GetTaskEventsRequest request,
                                          rpc::SendReplyCallback send_reply_callback) {
   RAY_LOG(DEBUG) << "Getting task status:" << request.ShortDebugString();
 
-  // Select candidate events by indexing if possible.
-  std::vector<rpc::TaskEvents> task_events;
+  // Select candidate events by indexing if possible. The archived task events are
+  // selected by the same query, along with the filters below.
   const auto &filters = request.filters();
+  absl::flat_hash_set<TaskID> task_ids;
+  TaskEventsArchive::Query archive_query;
+  archive_query.require_task_info = true;
+  archive_query.exclude_driver = filters.exclude_driver();
+  if (filters.has_actor_id()) {
+    archive_query.actor_id = ActorID::FromBinary(filters.actor_id());
+  }
+  if (filters.has_name()) {
+    archive_query.name = filters.name();
+  }
   if (filters.task_ids_size() > 0) {
-    absl::flat_hash_set<TaskID> task_ids;
     for (const auto &task_id_str : filters.task_ids()) {
       task_ids.insert(TaskID::FromBinary(task_id_str));
     }
-    task_events = task_event_storage_->GetTaskEvents(task_ids);
+    archive_query.task_ids = &task_ids;
   } else if (filters.has_job_id()) {
     const auto job_id = JobID::FromBinary(filters.job_id());
-    task_events = task_event_storage_->GetTaskEvents(job_id);
+    archive_query.job_id = job_id;
     // Populate per-job data loss.
     if (task_event_storage_->HasJob(job_id)) {
       const auto &job_summary = task_event_storage_->GetJobTaskSummary(job_id);
@@ -385,7 +529,6 @@ void GcsTaskManager::HandleGetTaskEvents(rpc::GetTaskEventsRequest request,
       reply->set_num_status_task_events_dropped(job_summary.NumTaskAttemptsDropped());
     }
   } else {
-    task_events = task_event_storage_->GetTaskEvents();
     // Populate all jobs data loss
     reply->set_num_profile_task_events_dropped(
         task_event_storage_->NumProfileEventsDropped());
@@ -426,21 +569,116 @@ void GcsTaskManager::HandleGetTaskEvents(rpc::GetTaskEventsRequest request,
     return true;
   };
 
+  if (request.has_page_token()) {
+    // A page holds the first `limit` task attempts after the token. The task events
+    // after the page aren't truncated, the next pages return them.
+    std::optional<TaskAttempt> page_token;
+    if (!request.page_token().empty()) {
+      page_token = ParseTaskAttemptPageToken(request.page_token());
+      if (!page_token.has_value()) {
+        GCS_RPC_SEND_REPLY(send_reply_callback,
+                           reply,
+                           Status::InvalidArgument("Invalid page token."));
+        return;
+      }
+    }
+    if (limit == 0) {
+      // An empty page would hand back the same token forever.
+      GCS_RPC_SEND_REPLY(
+          send_reply_callback,
+          reply,
+          Status::InvalidArgument("The limit of a paged request must be positive."));
+      return;
+    }
+    GcsTaskManagerStorage::PageStats page_stats;
+    auto page = task_event_storage_->GetTaskEventsPage(archive_query.task_ids,
+                                                       archive_query.job_id,
+                                                       page_token,
+                                                       limit,
+                                                       filter_fn,
+                                                       &page_stats);
+    // The archive selects its own page on its columns, and the two pages are merged.
+    archive_query.page_order = true;
+    archive_query.page_token = page_token;
+    archive_query.limit = limit;
+    std::vector<rpc::TaskEvents> archived_task_events;
+    const auto archive_stats =
+        task_event_storage_->GetArchivedTaskEvents(archive_query, &archived_task_events);
+    const auto page_size = page.size();
+    for (auto &task_event : archived_task_events) {
+      page.push_back(std::move(task_event));
+    }
+    const TaskAttemptPageOrder less;
+    std::inplace_merge(
+        page.begin(),
+        page.begin() + page_size,
+        page.end(),
+        [&less](const rpc::TaskEvents &left, const rpc::TaskEvents &right) {
+          return less(GetTaskAttempt(left), GetTaskAttempt(right));
+        });
+    bool has_more = page_stats.has_more || archive_stats.num_truncated > 0;
+    if (limit > 0 && static_cast<size_t>(limit) < page.size()) {
+      page.resize(limit);
+      has_more = true;
+    }
+    if (has_more) {
+      reply->set_next_page_token(TaskAttemptPageToken(GetTaskAttempt(page.back())));
+    }
+    for (auto &task_event : page) {
+      reply->add_events_by_task()->Swap(&task_event);
+    }
+    reply->set_num_total_stored(page_stats.num_total + archived_task_events.size() +
+                                archive_stats.num_filtered + archive_stats.num_truncated +
+                                archive_stats.num_before_page_token);
+    reply->set_num_filtered_on_gcs(page_stats.num_filtered + archive_stats.num_filtered);
+    GCS_RPC_SEND_REPLY(send_reply_callback, reply, Status::OK());
+    return;
+  }
+
+  std::vector<rpc::TaskEvents> task_events;
+  if (archive_query.task_ids != nullptr) {
+    task_events = task_event_storage_->GetTaskEvents(task_ids);
+  } else if (archive_query.job_id.has_value()) {
+    task_events = task_event_storage_->GetTaskEvents(*archive_query.job_id);
+  } else {
+    task_events = task_event_storage_->GetTaskEvents();
+  }
+
   int64_t num_filtered = 0;
+  std::vector<rpc::TaskEvents *> matched;
   for (auto itr = task_events.rbegin(); itr != task_events.rend(); ++itr) {
-    auto &task_event = *itr;
-    if (!filter_fn(task_event)) {
+    if (!filter_fn(*itr)) {
       num_filtered++;
       continue;
     }
-
+    matched.push_back(&*itr);
+  }
+
+  // The archived task events come after the ones in memory. The archive evaluates the
+  // query on its columns and only decodes the task events under the remaining limit.
+  archive_query.limit =
+      limit < 0 ? -1
+                : std::max<int64_t>(limit - static_cast<int64_t>(matched.size()), 0);
+  std::vector<rpc::TaskEvents> archived_task_events;
+  const auto archive_stats =
+      task_event_storage_->GetArchivedTaskEvents(archive_query, &archived_task_events);
+  num_filtered += archive_stats.num_filtered;
+  num_limit_truncated += archive_stats.num_truncated;
+  num_profile_event_limit += archive_stats.num_profile_events_truncated;
+  num_status_event_limit += archive_stats.num_status_events_truncated;
+  for (auto &task_event : archived_task_events) {
+    matched.push_back(&task_event);
+  }
+
+  for (auto *task_event : matched) {
     if (limit < 0 || count++ < limit) {
       auto events = reply->add_events_by_task();
-      events->Swap(&task_event);
+      events->Swap(task_event);
     } else {
-      num_profile_event_limit +=
-          task_event.has_profile_events() ? task_event.profile_events().events_size() : 0;
-      num_status_event_limit += task_event.has_state_updates() ? 1 : 0;
+      num_profile_event_limit += task_event->has_profile_events()
+                                     ? task_event->profile_events().events_size()
+                                     : 0;
+      num_status_event_limit += task_event->has_state_updates() ? 1 : 0;
       num_limit_truncated++;
     }
   }
@@ -451,7 +689,8 @@ void GcsTaskManager::HandleGetTaskEvents(rpc::GetTaskEventsRequest request,
   reply->set_num_status_task_events_dropped(reply->num_status_task_events_dropped() +
                                             num_status_event_limit);
 
-  reply->set_num_total_stored(task_events.size());
+  reply->set_num_total_stored(task_events.size() + archived_task_events.size() +
+                              archive_stats.num_filtered + archive_stats.num_truncated);
   reply->set_num_truncated(num_limit_truncated);
   reply->set_num_filtered_on_gcs(num_filtered);
 
@@ -474,6 +713,14 @@ void GcsTaskManager::GcsTaskManagerStorage::RecordDataLossFromWorker(
     const auto &loc_iter = primary_index_.find(std::make_pair<>(task_id, attempt_number));
     if (loc_iter != primary_index_.end()) {
       RemoveTaskAttempt(loc_iter->second);
+    } else if (archive_ != nullptr) {
+      if (auto archived_task_events =
+              archive_->Take(std::make_pair<>(task_id, attempt_number))) {
+        auto num_profile_events = NumProfileEvents(*archived_task_events);
+        job_task_summary_[job_id].RecordProfileEventsDropped(num_profile_events);
+        stats_counter_.Decrement(kNumTaskEventsArchived);
+        stats_counter_.Increment(kTotalNumProfileTaskEventsDropped, num_profile_events);
+      }
     }
   }
 
@@ -509,6 +756,7 @@ std::string GcsTaskManager::DebugString() {
      << counters[kTotalNumTaskAttemptsDropped] << "\n-Total num profile events dropped: "
      << counters[kTotalNumProfileTaskEventsDropped]
      << "\n-Current num of task events stored: " << counters[kNumTaskEventsStored]
+     << "\n-Current num of task events archived: " << counters[kNumTaskEventsArchived]
      << "\n-Total num of actor creation tasks: " << counters[kTotalNumActorCreationTask]
      << "\n-Total num of actor tasks: " << counters[kTotalNumActorTask]
      << "\n-Total num of normal tasks: " << counters[kTotalNumNormalTask]
@@ -14,11 +14,15 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
 #include "ray/gcs/gcs_client/usage_stats_client.h"
+#include "ray/gcs/gcs_server/gcs_task_events_archive.h"
 #include "ray/gcs/pb_util.h"
 #include "ray/rpc/gcs_server/gcs_rpc_server.h"
 #include "ray/util/counter_map.h"
@@ -32,6 +36,7 @@ enum GcsTaskManagerCounter {
   kTotalNumTaskAttemptsDropped,
   kTotalNumProfileTaskEventsDropped,
   kNumTaskEventsStored,
+  kNumTaskEventsArchived,
   kTotalNumActorCreationTask,
   kTotalNumActorTask,
   kTotalNumNormalTask,
@@ -90,7 +95,8 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
         task_event_storage_(std::make_unique<GcsTaskManagerStorage>(
             RayConfig::instance().task_events_max_num_task_in_gcs(),
             stats_counter_,
-            std::make_unique<FinishedTaskActorTaskGcPolicy>())),
+            std::make_unique<FinishedTaskActorTaskGcPolicy>(),
+            RayConfig::instance().task_events_max_num_archived_task_in_gcs())),
         io_service_thread_(std::make_unique<std::thread>([this] {
           SetThreadName("task_events");
           // Keep io_service_ alive.
@@ -174,6 +180,11 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
   /// `TaskEventGcPolicyInterface` will be evicted first. When new events from the
   /// already evicted task attempts are reported to GCS, those events will also be
   /// dropped.
+  ///
+  /// With `RAY_task_events_max_num_archived_task_in_gcs` set, the evicted task attempts
+  /// that are terminated are moved to a `TaskEventsArchive` instead, which keeps them in
+  /// a fraction of the memory. Only the task attempts evicted from the archive are
+  /// dropped then. New events of an archived task attempt move it back to merge them.
   class GcsTaskManagerStorage {
     class TaskEventLocator;
     class JobTaskSummary;
@@ -183,13 +194,24 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
     ///
     /// \param max_num_task_events Max number of task events stored before replacing older
     /// ones.
+    /// \param max_num_archived_task_events Max number of evicted task events archived
+    /// before dropping older ones. 0 disables the archive.
     GcsTaskManagerStorage(size_t max_num_task_events,
                           CounterMapThreadSafe<GcsTaskManagerCounter> &stats_counter,
-                          std::unique_ptr<TaskEventsGcPolicyInterface> gc_policy)
+                          std::unique_ptr<TaskEventsGcPolicyInterface> gc_policy,
+                          size_t max_num_archived_task_events = 0)
         : max_num_task_events_(max_num_task_events),
+          max_num_archived_task_events_(max_num_archived_task_events),
           stats_counter_(stats_counter),
           gc_policy_(std::move(gc_policy)),
-          task_events_list_(gc_policy_->MaxPriority(), std::list<rpc::TaskEvents>()) {}
+          task_events_list_(gc_policy_->MaxPriority(), std::list<rpc::TaskEvents>()) {
+      if (max_num_archived_task_events_ > 0) {
+        // Evict at most 1/16 of the archive at a time. Chunks of a small archive are
+        // smaller than a block rather than evicting most of the archive at once.
+        archive_ = std::make_unique<TaskEventsArchive>(std::clamp(
+            max_num_archived_task_events_ / 16, size_t{1}, kMaxArchiveChunkSize));
+      }
+    }
 
     /// Add a new task event or replace an existing task event in the storage.
     ///
@@ -221,6 +243,46 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
     std::vector<rpc::TaskEvents> GetTaskEvents(
         const absl::flat_hash_set<TaskID> &task_ids) const;
 
+    /// The stats of a page of task events.
+    struct PageStats {
+      /// The number of task events of the tasks or the job, or of all task events.
+      int64_t num_total = 0;
+      /// The number of task events scanned that don't match the filter.
+      int64_t num_filtered = 0;
+      /// Whether there are matching task events after the page.
+      bool has_more = false;
+    };
+
+    /// Get a page of task events, in the order of their task attempts (see
+    /// `TaskAttemptPageOrder`). Only the task events of the page are copied.
+    ///
+    /// \param task_ids If not null, only the task events of these tasks are returned.
+    /// \param job_id If set, only the task events of the job are returned.
+    /// \param page_token If set, only the task attempts after it are returned.
+    /// \param limit The max number of task events returned, -1 for no limit.
+    /// \param filter_fn Whether a task event matches the other filters of the page.
+    /// \param[out] stats The stats of the page.
+    /// \return The task events of the page, in order.
+    std::vector<rpc::TaskEvents> GetTaskEventsPage(
+        const absl::flat_hash_set<TaskID> *task_ids,
+        const std::optional<JobID> &job_id,
+        const std::optional<TaskAttempt> &page_token,
+        int64_t limit,
+        const std::function<bool(const rpc::TaskEvents &)> &filter_fn,
+        PageStats *stats) const;
+
+    /// Get the archived task events matching a query.
+    ///
+    /// The task events above only include the task events not archived.
+    ///
+    /// \param query The query.
+    /// \param[out] result The task events are appended to it, from the most recently
+    /// archived.
+    /// \return The stats of the archived task events not returned.
+    TaskEventsArchive::QueryStats GetArchivedTaskEvents(
+        const TaskEventsArchive::Query &query,
+        std::vector<rpc::TaskEvents> *result) const;
+
     /// Get task events of task locators.
     ///
     /// \param task_attempts Task attempts (task ids + attempt number).
@@ -421,8 +483,10 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
     /// returns a locator to the task event.
     ///
     /// \param events_by_task Task events.
+    /// \param count_task_type Whether to count the task in the task type counters.
     /// \return The task event locator.
-    std::shared_ptr<TaskEventLocator> AddNewTaskEvent(rpc::TaskEvents &&events_by_task);
+    std::shared_ptr<TaskEventLocator> AddNewTaskEvent(rpc::TaskEvents &&events_by_task,
+                                                      bool count_task_type = true);
 
     /// Add the locator to indices.
     ///
@@ -445,15 +509,25 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
     /// Remove information of a task attempt from the storage.
     void RemoveTaskAttempt(std::shared_ptr<TaskEventLocator> loc);
 
+    /// Move a terminated task attempt to the archive, and drop the oldest archived task
+    /// attempts if the archive is full.
+    void ArchiveTaskAttempt(std::shared_ptr<TaskEventLocator> loc);
+
     /// Test only functions.
     std::shared_ptr<TaskEventLocator> GetTaskEventLocator(
         const TaskAttempt &task_attempt) const {
       return primary_index_.at(task_attempt);
     }
 
+    /// The max number of task attempts in a chunk of the archive.
+    static constexpr size_t kMaxArchiveChunkSize = 16 * 1024;
+
     /// Max number of task events allowed in the storage.
     const size_t max_num_task_events_ = 0;
 
+    /// Max number of task events allowed in the archive.
+    const size_t max_num_archived_task_events_ = 0;
+
     /// Reference to the counter map owned by the GcsTaskManager.
     CounterMapThreadSafe<GcsTaskManagerCounter> &stats_counter_;
 
@@ -467,6 +541,9 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
         job_index_;
     absl::flat_hash_map<WorkerID, absl::flat_hash_set<std::shared_ptr<TaskEventLocator>>>
         worker_index_;
+    // The task attempts in the order they are paged in.
+    absl::btree_map<TaskAttempt, std::shared_ptr<TaskEventLocator>, TaskAttemptPageOrder>
+        page_index_;
 
     // A summary for per job stats.
     absl::flat_hash_map<JobID, JobTaskSummary> job_task_summary_;
@@ -477,6 +554,9 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
     /// Task events lists.
     std::vector<std::list<rpc::TaskEvents>> task_events_list_;
 
+    /// The evicted task events of terminated task attempts, if enabled.
+    std::unique_ptr<TaskEventsArchive> archive_;
+
     friend class GcsTaskManager;
     FRIEND_TEST(GcsTaskManagerTest, TestHandleAddTaskEventBasic);
     FRIEND_TEST(GcsTaskManagerTest, TestMergeTaskEventsSameTaskAttempt);
@@ -513,6 +593,9 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
   /// Test only
   size_t GetNumTaskEventsStored() { return stats_counter_.Get(kNumTaskEventsStored); }
 
+  /// Test only
+  size_t GetNumTaskEventsArchived() { return stats_counter_.Get(kNumTaskEventsArchived); }
+
   // Mutex guarding the usage stats client
   absl::Mutex mutex_;
 
@@ -544,6 +627,9 @@ class GcsTaskManager : public rpc::TaskInfoHandler {
   FRIEND_TEST(GcsTaskManagerTest, TestMultipleJobsDataLoss);
   FRIEND_TEST(GcsTaskManagerDroppedTaskAttemptsLimit, TestDroppedTaskAttemptsLimit);
   FRIEND_TEST(GcsTaskManagerProfileEventsLimitTest, TestProfileEventsNoLeak);
+  FRIEND_TEST(GcsTaskManagerArchiveTest, TestArchiveTerminatedTasks);
+  FRIEND_TEST(GcsTaskManagerArchiveTest, TestArchiveNotTerminatedTasks);
+  FRIEND_TEST(GcsTaskManagerArchiveTest, TestArchiveLimit);
 };
 
 }  // namespace gcs
@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include <memory>
+#include <set>
 
 // clang-format off
 #include "gtest/gtest.h"
+#include "absl/strings/match.h"
 #include "ray/common/asio/instrumented_io_context.h"
 #include "ray/common/test_util.h"
 #include "ray/gcs/gcs_server/test/gcs_server_test_util.h"
@@ -1288,6 +1290,131 @@ TEST_F(GcsActorManagerTest, TestGetAllActorInfoFilters) {
     ASSERT_EQ(reply.num_filtered(), num_other_actors + 1);
     ASSERT_EQ(reply.actor_table_data().size(), 0);
   }
+
+  // Filter with node id
+  {
+    rpc::GetAllActorInfoRequest request;
+    request.mutable_filters()->set_node_id(actor->GetAddress().raylet_id());
+
+    auto &reply =
+        *google::protobuf::Arena::CreateMessage<rpc::GetAllActorInfoReply>(&arena);
+    gcs_actor_manager_->HandleGetAllActorInfo(request, &reply, callback);
+    ASSERT_EQ(reply.actor_table_data().size(), 1);
+    ASSERT_EQ(reply.actor_table_data(0).actor_id(), actor->GetActorID().Binary());
+    ASSERT_EQ(reply.num_filtered(), num_other_actors);
+  }
+}
+
+TEST_F(GcsActorManagerTest, TestGetAllActorInfoNamePrefix) {
+  google::protobuf::Arena arena;
+  auto job_id = JobID::FromInt(1);
+  for (const auto &name : {"train_0", "train_1", "serve_0"}) {
+    auto request1 = Mocker::GenRegisterActorRequest(job_id,
+                                                    /*max_restarts=*/0,
+                                                    /*detached=*/true,
+                                                    /*name=*/name);
+    Status status = gcs_actor_manager_->RegisterActor(
+        request1, [](std::shared_ptr<gcs::GcsActor> actor) {});
+    ASSERT_TRUE(status.ok());
+  }
+
+  rpc::GetAllActorInfoRequest request;
+  request.mutable_filters()->set_name_prefix("train_");
+  auto &reply =
+      *google::protobuf::Arena::CreateMessage<rpc::GetAllActorInfoReply>(&arena);
+  auto callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  gcs_actor_manager_->HandleGetAllActorInfo(request, &reply, callback);
+  ASSERT_EQ(reply.actor_table_data().size(), 2);
+  ASSERT_EQ(reply.num_filtered(), 1);
+  for (const auto &data : reply.actor_table_data()) {
+    ASSERT_TRUE(absl::StartsWith(data.name(), "train_"));
+  }
+}
+
+TEST_F(GcsActorManagerTest, TestGetAllActorInfoPagination) {
+  google::protobuf::Arena arena;
+  auto job_id = JobID::FromInt(1);
+  auto job_id_other = JobID::FromInt(2);
+  auto num_actors = 5;
+  std::set<std::string> actor_ids;
+  for (int i = 0; i < num_actors; i++) {
+    auto request1 = Mocker::GenRegisterActorRequest(job_id,
+                                                    /*max_restarts=*/0,
+                                                    /*detached=*/false);
+    Status status = gcs_actor_manager_->RegisterActor(
+        request1, [](std::shared_ptr<gcs::GcsActor> actor) {});
+    ASSERT_TRUE(status.ok());
+    actor_ids.insert(request1.task_spec().actor_creation_task_spec().actor_id());
+
+    // Actors filtered out of every page.
+    auto request2 = Mocker::GenRegisterActorRequest(job_id_other,
+                                                    /*max_restarts=*/0,
+                                                    /*detached=*/false);
+    status = gcs_actor_manager_->RegisterActor(
+        request2, [](std::shared_ptr<gcs::GcsActor> actor) {});
+    ASSERT_TRUE(status.ok());
+  }
+
+  auto callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  std::vector<std::string> paged_actor_ids;
+  std::string page_token;
+  int num_pages = 0;
+  do {
+    rpc::GetAllActorInfoRequest request;
+    request.set_limit(2);
+    request.set_page_token(page_token);
+    request.mutable_filters()->set_job_id(job_id.Binary());
+    auto &reply =
+        *google::protobuf::Arena::CreateMessage<rpc::GetAllActorInfoReply>(&arena);
+    gcs_actor_manager_->HandleGetAllActorInfo(request, &reply, callback);
+    ASSERT_LE(reply.actor_table_data().size(), 2);
+    ASSERT_EQ(reply.total(), 2 * num_actors);
+    for (const auto &data : reply.actor_table_data()) {
+      paged_actor_ids.push_back(data.actor_id());
+    }
+    page_token = reply.next_page_token();
+    ++num_pages;
+  } while (!page_token.empty());
+
+  // Every actor is returned once, in the order of the ids.
+  ASSERT_EQ(num_pages, 3);
+  ASSERT_EQ(paged_actor_ids,
+            std::vector<std::string>(actor_ids.begin(), actor_ids.end()));
+}
+
+TEST_F(GcsActorManagerTest, TestGetAllActorInfoStateIndex) {
+  google::protobuf::Arena arena;
+  auto job_id = JobID::FromInt(1);
+  auto actor = CreateActorAndWaitTilAlive(job_id);
+  RegisterActor(job_id);
+
+  auto callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  auto get_actor_ids = [&](rpc::ActorTableData::ActorState state) {
+    rpc::GetAllActorInfoRequest request;
+    request.mutable_filters()->set_state(state);
+    auto &reply =
+        *google::protobuf::Arena::CreateMessage<rpc::GetAllActorInfoReply>(&arena);
+    gcs_actor_manager_->HandleGetAllActorInfo(request, &reply, callback);
+    EXPECT_EQ(reply.num_filtered() + reply.actor_table_data_size(), 2);
+    std::vector<std::string> actor_ids;
+    for (const auto &data : reply.actor_table_data()) {
+      actor_ids.push_back(data.actor_id());
+    }
+    return actor_ids;
+  };
+  ASSERT_EQ(get_actor_ids(rpc::ActorTableData::ALIVE),
+            std::vector<std::string>{actor->GetActorID().Binary()});
+  ASSERT_TRUE(get_actor_ids(rpc::ActorTableData::DEAD).empty());
+
+  // The destroyed actor moves to the dead actors.
+  gcs_actor_manager_->OnWorkerDead(actor->GetNodeID(), actor->GetWorkerID());
+  ASSERT_EQ(actor->GetState(), rpc::ActorTableData::DEAD);
+  ASSERT_TRUE(get_actor_ids(rpc::ActorTableData::ALIVE).empty());
+  ASSERT_EQ(get_actor_ids(rpc::ActorTableData::DEAD),
+            std::vector<std::string>{actor->GetActorID().Binary()});
 }
 
 TEST_F(GcsActorManagerTest, TestGetAllActorInfoLimit) {
@@ -1322,6 +1449,68 @@ TEST_F(GcsActorManagerTest, TestGetAllActorInfoLimit) {
   }
 }
 
+TEST_F(GcsActorManagerTest, TestGetAllActorInfoLimitListsLiveActorsFirst) {
+  google::protobuf::Arena arena;
+  auto job_id = JobID::FromInt(1);
+  const int num_dead_actors = 20;
+  for (int i = 0; i < num_dead_actors; i++) {
+    auto actor = CreateActorAndWaitTilAlive(job_id);
+    gcs_actor_manager_->OnWorkerDead(actor->GetNodeID(), actor->GetWorkerID());
+    ASSERT_EQ(actor->GetState(), rpc::ActorTableData::DEAD);
+  }
+  auto live_actor = CreateActorAndWaitTilAlive(job_id);
+
+  // Without a page token, the live actors come before the dead ones whatever their
+  // ids.
+  auto callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  rpc::GetAllActorInfoRequest request;
+  request.set_limit(1);
+  auto &reply =
+      *google::protobuf::Arena::CreateMessage<rpc::GetAllActorInfoReply>(&arena);
+  gcs_actor_manager_->HandleGetAllActorInfo(request, &reply, callback);
+  ASSERT_EQ(reply.actor_table_data_size(), 1);
+  ASSERT_EQ(reply.actor_table_data(0).actor_id(), live_actor->GetActorID().Binary());
+  ASSERT_EQ(reply.total(), num_dead_actors + 1);
+  ASSERT_TRUE(reply.next_page_token().empty());
+}
+
+TEST_F(GcsActorManagerTest, DISABLED_GetAllActorInfoPagingBenchmark) {
+  auto job_id = JobID::FromInt(1);
+  const int num_actors = 500000;
+  for (int i = 0; i < num_actors; i++) {
+    auto request = Mocker::GenRegisterActorRequest(job_id,
+                                                   /*max_restarts=*/0,
+                                                   /*detached=*/false);
+    Status status = gcs_actor_manager_->RegisterActor(
+        request, [](std::shared_ptr<gcs::GcsActor> actor) {});
+    ASSERT_TRUE(status.ok());
+  }
+
+  auto callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  rpc::GetAllActorInfoRequest request;
+  request.set_limit(1000);
+  request.set_page_token("");
+  int num_pages = 0;
+  int num_listed = 0;
+  auto start = absl::Now();
+  do {
+    google::protobuf::Arena arena;
+    auto &reply =
+        *google::protobuf::Arena::CreateMessage<rpc::GetAllActorInfoReply>(&arena);
+    gcs_actor_manager_->HandleGetAllActorInfo(request, &reply, callback);
+    num_listed += reply.actor_table_data_size();
+    num_pages++;
+    request.set_page_token(reply.next_page_token());
+  } while (!request.page_token().empty());
+  auto duration = absl::Now() - start;
+  ASSERT_EQ(num_listed, num_actors);
+  RAY_LOG(INFO) << "Listed " << num_actors << " actors in " << num_pages
+                << " pages: " << absl::ToDoubleMilliseconds(duration) << " ms, "
+                << absl::ToDoubleMilliseconds(duration) / num_pages << " ms per page.";
+}
+
 namespace gcs {
 TEST_F(GcsActorManagerTest, TestKillActorWhenActorIsCreating) {
   auto job_id = JobID::FromInt(1);
@@ -41,19 +41,37 @@ class GcsKVManagerTest : public ::testing::TestWithParam<std::string> {
     } else if (GetParam() == "memory") {
       kv_instance = std::make_unique<ray::gcs::StoreClientInternalKV>(
           std::make_unique<ray::gcs::InMemoryStoreClient>(io_service));
+    } else if (GetParam() == "memory_on_kv_thread") {
+      // The KV runs on its own thread, and its callbacks are posted to io_service.
+      thread_kv_io_service = std::make_unique<std::thread>([this] {
+        boost::asio::io_service::work work(kv_io_service);
+        kv_io_service.run();
+      });
+      kv_delegate = std::make_unique<ray::gcs::StoreClientInternalKV>(
+          std::make_unique<ray::gcs::InMemoryStoreClient>(kv_io_service));
+      kv_instance = std::make_unique<ray::gcs::IoContextInternalKV>(
+          *kv_delegate, kv_io_service, io_service);
     }
   }
 
   void TearDown() override {
     io_service.stop();
     thread_io_service->join();
+    if (thread_kv_io_service) {
+      kv_io_service.stop();
+      thread_kv_io_service->join();
+    }
     redis_client.reset();
     kv_instance.reset();
+    kv_delegate.reset();
   }
 
   std::unique_ptr<ray::gcs::RedisClient> redis_client;
   std::unique_ptr<std::thread> thread_io_service;
   instrumented_io_context io_service;
+  std::unique_ptr<std::thread> thread_kv_io_service;
+  instrumented_io_context kv_io_service;
+  std::unique_ptr<ray::gcs::InternalKVInterface> kv_delegate;
   std::unique_ptr<ray::gcs::InternalKVInterface> kv_instance;
 };
 
@@ -118,7 +136,7 @@ TEST_P(GcsKVManagerTest, TestInternalKV) {
 
 INSTANTIATE_TEST_SUITE_P(GcsKVManagerTestFixture,
                          GcsKVManagerTest,
-                         ::testing::Values("redis", "memory"));
+                         ::testing::Values("redis", "memory", "memory_on_kv_thread"));
 
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 // clang-format off
 #include "gtest/gtest.h"
@@ -94,6 +97,115 @@ TEST_F(GcsNodeManagerTest, TestListener) {
   }
 }
 
+TEST_F(GcsNodeManagerTest, TestGetAllNodeInfoFiltersAndLimit) {
+  instrumented_io_context io_service;
+  gcs_table_storage_ = std::make_shared<gcs::InMemoryGcsTableStorage>(io_service);
+  gcs::GcsNodeManager node_manager(
+      gcs_publisher_, gcs_table_storage_, client_pool_, ClusterID::Nil());
+  int num_alive_nodes = 3;
+  int num_dead_nodes = 2;
+  std::vector<std::shared_ptr<rpc::GcsNodeInfo>> nodes;
+  for (int i = 0; i < num_alive_nodes + num_dead_nodes; ++i) {
+    nodes.push_back(Mocker::GenNodeInfo());
+    node_manager.AddNode(nodes.back());
+  }
+  for (int i = 0; i < num_dead_nodes; ++i) {
+    node_manager.OnNodeFailure(NodeID::FromBinary(nodes[i]->node_id()), nullptr);
+  }
+
+  auto callback =
+      [](Status status, std::function<void()> success, std::function<void()> failure) {};
+  auto get_all_node_info = [&node_manager,
+                            &callback](rpc::GetAllNodeInfoRequest request) {
+    rpc::GetAllNodeInfoReply reply;
+    node_manager.HandleGetAllNodeInfo(request, &reply, callback);
+    EXPECT_EQ(reply.total(), 5);
+    return reply;
+  };
+
+  // Without filters or limit.
+  {
+    auto reply = get_all_node_info(rpc::GetAllNodeInfoRequest());
+    ASSERT_EQ(reply.node_info_list_size(), 5);
+    ASSERT_EQ(reply.num_filtered(), 0);
+  }
+
+  // Filter with node id.
+  {
+    rpc::GetAllNodeInfoRequest request;
+    request.mutable_filters()->set_node_id(nodes[0]->node_id());
+    auto reply = get_all_node_info(request);
+    ASSERT_EQ(reply.node_info_list_size(), 1);
+    ASSERT_EQ(reply.node_info_list(0).node_id(), nodes[0]->node_id());
+    ASSERT_EQ(reply.node_info_list(0).state(), rpc::GcsNodeInfo::DEAD);
+    ASSERT_EQ(reply.num_filtered(), 4);
+
+    request.mutable_filters()->set_state(rpc::GcsNodeInfo::ALIVE);
+    reply = get_all_node_info(request);
+    ASSERT_EQ(reply.node_info_list_size(), 0);
+    ASSERT_EQ(reply.num_filtered(), 5);
+  }
+
+  // Filter with state.
+  {
+    rpc::GetAllNodeInfoRequest request;
+    request.mutable_filters()->set_state(rpc::GcsNodeInfo::ALIVE);
+    auto reply = get_all_node_info(request);
+    ASSERT_EQ(reply.node_info_list_size(), num_alive_nodes);
+    ASSERT_EQ(reply.num_filtered(), num_dead_nodes);
+    for (const auto &node : reply.node_info_list()) {
+      ASSERT_EQ(node.state(), rpc::GcsNodeInfo::ALIVE);
+    }
+
+    request.mutable_filters()->set_state(rpc::GcsNodeInfo::DEAD);
+    reply = get_all_node_info(request);
+    ASSERT_EQ(reply.node_info_list_size(), num_dead_nodes);
+    ASSERT_EQ(reply.num_filtered(), num_alive_nodes);
+  }
+
+  // Limit.
+  {
+    rpc::GetAllNodeInfoRequest request;
+    request.set_limit(4);
+    auto reply = get_all_node_info(request);
+    ASSERT_EQ(reply.node_info_list_size(), 4);
+
+    request.mutable_filters()->set_state(rpc::GcsNodeInfo::DEAD);
+    request.set_limit(1);
+    reply = get_all_node_info(request);
+    ASSERT_EQ(reply.node_info_list_size(), 1);
+    ASSERT_EQ(reply.node_info_list(0).state(), rpc::GcsNodeInfo::DEAD);
+  }
+
+  // Paging.
+  {
+    std::vector<std::string> node_ids;
+    for (const auto &node : nodes) {
+      node_ids.push_back(node->node_id());
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+
+    rpc::GetAllNodeInfoRequest request;
+    request.set_limit(2);
+    request.set_page_token("");
+    std::vector<std::string> listed;
+    for (int page = 0; page < 3; ++page) {
+      auto reply = get_all_node_info(request);
+      for (const auto &node : reply.node_info_list()) {
+        listed.push_back(node.node_id());
+      }
+      ASSERT_EQ(reply.next_page_token().empty(), page == 2);
+      request.set_page_token(reply.next_page_token());
+    }
+    ASSERT_EQ(listed, node_ids);
+
+    request.set_page_token("invalid");
+    auto reply = get_all_node_info(request);
+    ASSERT_EQ(reply.status().code(), (int)StatusCode::InvalidArgument);
+    ASSERT_EQ(reply.node_info_list_size(), 0);
+  }
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
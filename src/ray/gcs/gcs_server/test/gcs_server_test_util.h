@@ -294,6 +294,9 @@ struct GcsServerMocker {
       callback(Status::OK(), reply);
     };
 
+    void StealTasks(const rpc::StealTasksRequest &request,
+                    const rpc::ClientCallback<rpc::StealTasksReply> &callback) override {}
+
     void NotifyGCSRestart(
         const rpc::ClientCallback<rpc::NotifyGCSRestartReply> &callback) override{};
 
@@ -16,6 +16,7 @@
 
 #include <google/protobuf/util/message_differencer.h>
 
+#include "absl/time/clock.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ray/gcs/pb_util.h"
@@ -127,7 +128,8 @@ class GcsTaskManagerTest : public ::testing::Test {
                                             int64_t limit = -1,
                                             bool exclude_driver = true,
                                             const std::string &name = "",
-                                            const ActorID &actor_id = ActorID::Nil()) {
+                                            const ActorID &actor_id = ActorID::Nil(),
+                                            const std::string *page_token = nullptr) {
     rpc::GetTaskEventsRequest request;
     rpc::GetTaskEventsReply reply;
     std::promise<bool> promise;
@@ -156,6 +158,10 @@ class GcsTaskManagerTest : public ::testing::Test {
 
     request.mutable_filters()->set_exclude_driver(exclude_driver);
 
+    if (page_token != nullptr) {
+      request.set_page_token(*page_token);
+    }
+
     task_manager->GetIoContext().dispatch(
         [this, &promise, &request, &reply]() {
           task_manager->HandleGetTaskEvents(
@@ -310,6 +316,19 @@ class GcsTaskManagerDroppedTaskAttemptsLimit : public GcsTaskManagerTest {
   }
 };
 
+class GcsTaskManagerArchiveTest : public GcsTaskManagerTest {
+ public:
+  GcsTaskManagerArchiveTest() : GcsTaskManagerTest() {
+    RayConfig::instance().initialize(
+        R"(
+{
+  "task_events_max_num_task_in_gcs": 10,
+  "task_events_max_num_archived_task_in_gcs": 300
+}
+  )");
+  }
+};
+
 TEST_F(GcsTaskManagerTest, TestHandleAddTaskEventBasic) {
   size_t num_task_events = 100;
   int32_t num_status_events_dropped = 10;
@@ -459,6 +478,111 @@ TEST_F(GcsTaskManagerTest, TestGetTaskEventsWithLimit) {
   }
 }
 
+TEST_F(GcsTaskManagerTest, TestGetTaskEventsPaged) {
+  // Add task events, with 2 attempts of each task.
+  int32_t num_task_events = 50;
+  auto task_ids = GenTaskIDs(num_task_events);
+  for (int32_t attempt_number = 0; attempt_number < 2; ++attempt_number) {
+    auto events = GenTaskEvents(task_ids,
+                                attempt_number,
+                                0,
+                                absl::nullopt,
+                                GenStateUpdate(),
+                                GenTaskInfo(JobID::FromInt(1)));
+    SyncAddTaskEventData(Mocker::GenTaskEventsData(events));
+  }
+
+  std::string page_token;
+  std::vector<TaskAttempt> paged;
+  int num_pages = 0;
+  do {
+    auto reply = SyncGetTaskEvents(/* task_ids */ {},
+                                   /* job_id */ absl::nullopt,
+                                   /* limit */ 30,
+                                   /* exclude_driver */ true,
+                                   /* name */ "",
+                                   /* actor_id */ ActorID::Nil(),
+                                   &page_token);
+    // The task events after the page are returned by the next pages.
+    EXPECT_EQ(reply.num_truncated(), 0);
+    EXPECT_EQ(reply.num_total_stored(), 2 * num_task_events);
+    for (const auto &task_event : reply.events_by_task()) {
+      paged.push_back(GetTaskAttempt(task_event));
+    }
+    page_token = reply.next_page_token();
+    num_pages++;
+  } while (!page_token.empty());
+
+  // Every task attempt is returned once, in the order of task attempts.
+  EXPECT_EQ(num_pages, 4);
+  ASSERT_EQ(paged.size(), static_cast<size_t>(2 * num_task_events));
+  for (size_t i = 1; i < paged.size(); ++i) {
+    const auto &prev_task_id = paged[i - 1].first.Binary();
+    const auto &task_id = paged[i].first.Binary();
+    EXPECT_TRUE(prev_task_id < task_id ||
+                (prev_task_id == task_id && paged[i - 1].second < paged[i].second));
+  }
+
+  // The pages of a job are selected among the task events of the job.
+  {
+    std::string job_page_token;
+    std::vector<TaskAttempt> job_paged;
+    do {
+      auto reply = SyncGetTaskEvents(/* task_ids */ {},
+                                     /* job_id */ JobID::FromInt(1),
+                                     /* limit */ 40,
+                                     /* exclude_driver */ true,
+                                     /* name */ "",
+                                     /* actor_id */ ActorID::Nil(),
+                                     &job_page_token);
+      for (const auto &task_event : reply.events_by_task()) {
+        job_paged.push_back(GetTaskAttempt(task_event));
+      }
+      job_page_token = reply.next_page_token();
+    } while (!job_page_token.empty());
+    EXPECT_EQ(job_paged, paged);
+  }
+
+  {
+    std::string invalid_token = "invalid";
+    rpc::GetTaskEventsRequest request;
+    rpc::GetTaskEventsReply reply;
+    request.set_page_token(invalid_token);
+    std::promise<Status> promise;
+    task_manager->GetIoContext().dispatch(
+        [this, &promise, &request, &reply]() {
+          task_manager->HandleGetTaskEvents(
+              request,
+              &reply,
+              [&promise](Status status, std::function<void()>, std::function<void()>) {
+                promise.set_value(status);
+              });
+        },
+        "SyncGetTaskEvents");
+    EXPECT_TRUE(promise.get_future().get().IsInvalidArgument());
+  }
+
+  {
+    // An empty page can't move past its token.
+    rpc::GetTaskEventsRequest request;
+    rpc::GetTaskEventsReply reply;
+    request.set_page_token("");
+    request.set_limit(0);
+    std::promise<Status> promise;
+    task_manager->GetIoContext().dispatch(
+        [this, &promise, &request, &reply]() {
+          task_manager->HandleGetTaskEvents(
+              request,
+              &reply,
+              [&promise](Status status, std::function<void()>, std::function<void()>) {
+                promise.set_value(status);
+              });
+        },
+        "SyncGetTaskEvents");
+    EXPECT_TRUE(promise.get_future().get().IsInvalidArgument());
+  }
+}
+
 TEST_F(GcsTaskManagerTest, TestGetTaskEventsByTaskIDs) {
   int32_t num_events_task_1 = 10;
   int32_t num_events_task_2 = 20;
@@ -787,6 +911,7 @@ TEST_F(GcsTaskManagerMemoryLimitedTest, TestIndexNoLeak) {
     EXPECT_EQ(task_manager->task_event_storage_->task_index_.size(), num_limit);
     EXPECT_EQ(task_manager->task_event_storage_->job_index_.size(), 1);
     EXPECT_EQ(task_manager->task_event_storage_->primary_index_.size(), num_limit);
+    EXPECT_EQ(task_manager->task_event_storage_->page_index_.size(), num_limit);
     EXPECT_EQ(task_manager->task_event_storage_->worker_index_.size(), 0);
   }
 }
@@ -1136,5 +1261,377 @@ TEST_F(GcsTaskManagerMemoryLimitedTest, TestLimitGcPriorityBased) {
   }
 }
 
+TEST_F(GcsTaskManagerTest, TestTaskEventsArchive) {
+  // Chunks of more than one block.
+  TaskEventsArchive archive(/*chunk_size=*/TaskEventsArchive::kRowsPerBlock + 44);
+  auto task_ids = GenTaskIDs(1000);
+  std::vector<rpc::TaskEvents> expected_events;
+  for (size_t i = 0; i < task_ids.size(); ++i) {
+    auto events = GenTaskEvents({task_ids[i]},
+                                /* attempt_number */ 0,
+                                /* job_id */ i % 3,
+                                GenProfileEvents("event", i, i + 1),
+                                GenStateUpdate({{rpc::TaskStatus::FINISHED, 1}},
+                                               WorkerID::FromRandom()),
+                                GenTaskInfo(JobID::FromInt(i % 3),
+                                            TaskID::Nil(),
+                                            rpc::TaskType::NORMAL_TASK,
+                                            ActorID::Nil(),
+                                            "task_" + std::to_string(i % 10)));
+    if (i % 5 == 0) {
+      // A task without task info.
+      events[0].clear_task_info();
+    }
+    if (i % 7 == 0) {
+      // A retried task.
+      auto retry_events = GenTaskEvents({task_ids[i]}, /* attempt_number */ 1);
+      events.push_back(retry_events[0]);
+    }
+    for (auto &task_events : events) {
+      expected_events.push_back(task_events);
+      archive.Add(std::move(task_events));
+    }
+  }
+  EXPECT_EQ(archive.NumTaskEvents(), expected_events.size());
+
+  // All task events, from the most recently added.
+  {
+    std::vector<rpc::TaskEvents> actual_events;
+    archive.GetTaskEvents({}, &actual_events);
+    ASSERT_EQ(actual_events.size(), expected_events.size());
+    for (size_t i = 0; i < actual_events.size(); ++i) {
+      EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(
+          actual_events[i], expected_events[expected_events.size() - 1 - i]));
+    }
+  }
+
+  // Task events of a job.
+  {
+    TaskEventsArchive::Query query;
+    query.job_id = JobID::FromInt(1);
+    std::vector<rpc::TaskEvents> actual_events;
+    archive.GetTaskEvents(query, &actual_events);
+    size_t num_job_events = std::count_if(
+        expected_events.begin(), expected_events.end(), [](const auto &task_events) {
+          return task_events.job_id() == JobID::FromInt(1).Binary();
+        });
+    EXPECT_EQ(actual_events.size(), num_job_events);
+    for (const auto &task_events : actual_events) {
+      EXPECT_EQ(task_events.job_id(), JobID::FromInt(1).Binary());
+    }
+    actual_events.clear();
+    query.job_id = JobID::FromInt(4);
+    archive.GetTaskEvents(query, &actual_events);
+    EXPECT_TRUE(actual_events.empty());
+  }
+
+  // Task events of tasks, with all their attempts.
+  {
+    absl::flat_hash_set<TaskID> query_task_ids{task_ids[1], task_ids[7], task_ids[999]};
+    TaskEventsArchive::Query query;
+    query.task_ids = &query_task_ids;
+    std::vector<rpc::TaskEvents> actual_events;
+    archive.GetTaskEvents(query, &actual_events);
+    EXPECT_EQ(actual_events.size(), 4);
+  }
+
+  // Task events matching filters, from the most recently added up to the limit.
+  {
+    TaskEventsArchive::Query query;
+    query.name = "task_3";
+    query.require_task_info = true;
+    std::vector<rpc::TaskEvents> actual_events;
+    auto stats = archive.GetTaskEvents(query, &actual_events);
+    EXPECT_EQ(actual_events.size(), 100);
+    for (const auto &task_events : actual_events) {
+      EXPECT_EQ(task_events.task_info().name(), "task_3");
+    }
+    EXPECT_EQ(stats.num_filtered, static_cast<int64_t>(expected_events.size()) - 100);
+    EXPECT_EQ(stats.num_truncated, 0);
+
+    query.limit = 10;
+    actual_events.clear();
+    stats = archive.GetTaskEvents(query, &actual_events);
+    ASSERT_EQ(actual_events.size(), 10);
+    EXPECT_EQ(actual_events[0].task_id(), task_ids[993].Binary());
+    EXPECT_EQ(stats.num_truncated, 90);
+    EXPECT_EQ(stats.num_profile_events_truncated, 90);
+    EXPECT_EQ(stats.num_status_events_truncated, 90);
+
+    // Only the task events without an actor id match another actor.
+    TaskEventsArchive::Query actor_query;
+    actor_query.actor_id = ActorID::Of(JobID::FromInt(1), TaskID::Nil(), 1);
+    actual_events.clear();
+    stats = archive.GetTaskEvents(actor_query, &actual_events);
+    EXPECT_EQ(actual_events.size(), expected_events.size() - 800);
+    for (const auto &task_events : actual_events) {
+      EXPECT_FALSE(task_events.task_info().has_actor_id());
+    }
+    EXPECT_EQ(stats.num_filtered, 800);
+  }
+
+  // Pages of task events, in the order of their task attempts.
+  {
+    std::vector<TaskAttempt> expected_attempts;
+    for (const auto &task_events : expected_events) {
+      expected_attempts.push_back(GetTaskAttempt(task_events));
+    }
+    std::sort(
+        expected_attempts.begin(), expected_attempts.end(), TaskAttemptPageOrder());
+
+    TaskEventsArchive::Query query;
+    query.page_order = true;
+    query.limit = 100;
+    std::vector<TaskAttempt> actual_attempts;
+    do {
+      std::vector<rpc::TaskEvents> actual_events;
+      auto stats = archive.GetTaskEvents(query, &actual_events);
+      EXPECT_EQ(stats.num_before_page_token,
+                static_cast<int64_t>(actual_attempts.size()));
+      EXPECT_EQ(stats.num_truncated,
+                static_cast<int64_t>(expected_attempts.size() - actual_attempts.size() -
+                                     actual_events.size()));
+      for (const auto &task_events : actual_events) {
+        actual_attempts.push_back(GetTaskAttempt(task_events));
+      }
+      ASSERT_FALSE(actual_events.empty());
+      query.page_token = actual_attempts.back();
+    } while (actual_attempts.size() < expected_attempts.size());
+    EXPECT_EQ(actual_attempts, expected_attempts);
+  }
+
+  // Take a task attempt out.
+  {
+    auto task_events = archive.Take({task_ids[7], 1});
+    ASSERT_TRUE(task_events.has_value());
+    EXPECT_EQ(task_events->task_id(), task_ids[7].Binary());
+    EXPECT_EQ(task_events->attempt_number(), 1);
+    EXPECT_FALSE(archive.Take({task_ids[7], 1}).has_value());
+    EXPECT_FALSE(archive.Take({task_ids[1], 1}).has_value());
+    EXPECT_EQ(archive.NumTaskEvents(), expected_events.size() - 1);
+
+    absl::flat_hash_set<TaskID> query_task_ids{task_ids[7]};
+    TaskEventsArchive::Query query;
+    query.task_ids = &query_task_ids;
+    std::vector<rpc::TaskEvents> actual_events;
+    archive.GetTaskEvents(query, &actual_events);
+    ASSERT_EQ(actual_events.size(), 1);
+    EXPECT_EQ(actual_events[0].attempt_number(), 0);
+  }
+
+  // Evict the oldest chunk.
+  {
+    size_t num_evicted = 0;
+    archive.EvictOldestChunk([&num_evicted](const JobID &job_id,
+                                            const TaskAttempt &task_attempt,
+                                            size_t num_profile_events) {
+      EXPECT_EQ(num_profile_events, task_attempt.second == 0 ? 1 : 0);
+      ++num_evicted;
+    });
+    // The chunk had the task attempt taken out.
+    EXPECT_EQ(num_evicted, TaskEventsArchive::kRowsPerBlock + 44 - 1);
+    EXPECT_EQ(archive.NumTaskEvents(), expected_events.size() - 1 - num_evicted);
+    EXPECT_FALSE(archive.Take({task_ids[0], 0}).has_value());
+
+    std::vector<rpc::TaskEvents> actual_events;
+    archive.GetTaskEvents({}, &actual_events);
+    EXPECT_EQ(actual_events.size(), archive.NumTaskEvents());
+  }
+}
+
+TEST_F(GcsTaskManagerTest, TestTaskEventsArchiveEvictsStrings) {
+  // The strings interned in a chunk are released with it, so the memory stays bounded
+  // while task attempts with new names are archived and evicted.
+  TaskEventsArchive archive(/*chunk_size=*/TaskEventsArchive::kRowsPerBlock);
+  size_t num_added = 0;
+  auto add_chunk = [&]() {
+    for (size_t i = 0; i < TaskEventsArchive::kRowsPerBlock; ++i) {
+      auto events = GenTaskEvents(GenTaskIDs(1),
+                                  /* attempt_number */ 0,
+                                  /* job_id */ 1,
+                                  /* profile_events */ absl::nullopt,
+                                  /* state_update */ absl::nullopt,
+                                  GenTaskInfo(JobID::FromInt(1),
+                                              TaskID::Nil(),
+                                              rpc::TaskType::NORMAL_TASK,
+                                              ActorID::Nil(),
+                                              std::string(200, 'a') +
+                                                  std::to_string(num_added++)));
+      archive.Add(std::move(events[0]));
+    }
+  };
+  for (int i = 0; i < 4; ++i) {
+    add_chunk();
+  }
+  const size_t memory_usage = archive.MemoryUsageBytes();
+  for (int i = 0; i < 20; ++i) {
+    archive.EvictOldestChunk([](const JobID &, const TaskAttempt &, size_t) {});
+    add_chunk();
+  }
+  EXPECT_EQ(archive.NumTaskEvents(), 4 * TaskEventsArchive::kRowsPerBlock);
+  EXPECT_LT(archive.MemoryUsageBytes(), 2 * memory_usage);
+}
+
+TEST_F(GcsTaskManagerArchiveTest, TestArchiveTerminatedTasks) {
+  size_t num_limit = 10;  // synced with test config
+  size_t num_tasks = 100;
+
+  // Finished tasks over the limit are archived.
+  auto task_ids = GenTaskIDs(num_tasks);
+  auto expected_events = GenTaskEvents(task_ids,
+                                       /* attempt_number */ 0,
+                                       /* job_id */ 1,
+                                       /* profile_events */ absl::nullopt,
+                                       GenStateUpdate({{rpc::TaskStatus::FINISHED, 1}}));
+  SyncAddTaskEventData(Mocker::GenTaskEventsData(expected_events));
+  EXPECT_EQ(task_manager->GetNumTaskEventsStored(), num_limit);
+  EXPECT_EQ(task_manager->GetNumTaskEventsArchived(), num_tasks - num_limit);
+  EXPECT_EQ(task_manager->GetTotalNumTaskAttemptsDropped(), 0);
+
+  {
+    auto reply = SyncGetTaskEvents({});
+    auto expected_data = Mocker::GenTaskEventsData(expected_events);
+    ExpectTaskEventsEq(expected_data.mutable_events_by_task(),
+                       reply.mutable_events_by_task());
+    EXPECT_EQ(reply.num_status_task_events_dropped(), 0);
+
+    reply = SyncGetTaskEvents({}, JobID::FromInt(1));
+    EXPECT_EQ(reply.events_by_task_size(), num_tasks);
+
+    reply = SyncGetTaskEvents({task_ids[0], task_ids[num_tasks - 1]});
+    EXPECT_EQ(reply.events_by_task_size(), 2);
+  }
+
+  // New events of an archived task attempt are merged into it.
+  {
+    auto events = GenTaskEvents({task_ids[0]},
+                                /* attempt_number */ 0,
+                                /* job_id */ 1,
+                                GenProfileEvents("event", 1, 1));
+    SyncAddTaskEventData(Mocker::GenTaskEventsData(events));
+    EXPECT_EQ(task_manager->GetNumTaskEventsStored(), num_limit);
+    EXPECT_EQ(task_manager->GetNumTaskEventsArchived(), num_tasks - num_limit);
+
+    auto reply = SyncGetTaskEvents({task_ids[0]});
+    ASSERT_EQ(reply.events_by_task_size(), 1);
+    EXPECT_TRUE(reply.events_by_task(0).state_updates().has_finished_ts());
+    EXPECT_EQ(reply.events_by_task(0).profile_events().events_size(), 1);
+  }
+
+  // Data loss of an archived task attempt drops it.
+  {
+    rpc::TaskEventData data;
+    auto dropped_attempt = data.add_dropped_task_attempts();
+    dropped_attempt->set_task_id(task_ids[1].Binary());
+    dropped_attempt->set_attempt_number(0);
+    data.set_job_id(JobID::FromInt(1).Binary());
+    SyncAddTaskEventData(data);
+    EXPECT_EQ(task_manager->GetNumTaskEventsArchived(), num_tasks - num_limit - 1);
+    EXPECT_EQ(SyncGetTaskEvents({task_ids[1]}).events_by_task_size(), 0);
+  }
+}
+
+TEST_F(GcsTaskManagerArchiveTest, TestArchiveNotTerminatedTasks) {
+  size_t num_limit = 10;  // synced with test config
+
+  // Running tasks over the limit are dropped.
+  SyncAddTaskEvent(GenTaskIDs(num_limit * 2), {{rpc::TaskStatus::RUNNING, 1}});
+  EXPECT_EQ(task_manager->GetNumTaskEventsStored(), num_limit);
+  EXPECT_EQ(task_manager->GetNumTaskEventsArchived(), 0);
+  EXPECT_EQ(task_manager->GetTotalNumTaskAttemptsDropped(), num_limit);
+}
+
+TEST_F(GcsTaskManagerArchiveTest, TestArchiveLimit) {
+  size_t num_limit = 10;            // synced with test config
+  size_t num_archived_limit = 300;  // synced with test config
+  size_t num_tasks = 1000;
+
+  SyncAddTaskEvent(GenTaskIDs(num_tasks), {{rpc::TaskStatus::FINISHED, 1}});
+  auto num_archived = task_manager->GetNumTaskEventsArchived();
+  // Only the oldest 1/16 of the archive is evicted at a time.
+  EXPECT_GT(num_archived, num_archived_limit - num_archived_limit / 16);
+  EXPECT_LE(num_archived, num_archived_limit);
+  EXPECT_EQ(task_manager->GetNumTaskEventsStored(), num_limit);
+  EXPECT_EQ(task_manager->GetTotalNumTaskAttemptsDropped(),
+            num_tasks - num_limit - num_archived);
+
+  auto reply = SyncGetTaskEvents({});
+  EXPECT_EQ(reply.events_by_task_size(), num_limit + num_archived);
+  EXPECT_EQ(reply.num_status_task_events_dropped(), num_tasks - num_limit - num_archived);
+}
+
+TEST_F(GcsTaskManagerTest, DISABLED_TaskEventsArchiveBenchmark) {
+  // Terminated task attempts of 10 jobs, with the fields of a typical task.
+  const size_t num_task_events = 10 * 1000 * 1000;
+  const size_t num_jobs = 10;
+  std::vector<NodeID> node_ids;
+  for (size_t i = 0; i < 100; ++i) {
+    node_ids.push_back(NodeID::FromRandom());
+  }
+  auto worker_ids = GenWorkerIDs(1000);
+
+  TaskEventsArchive archive(/*chunk_size=*/16 * 1024);
+  std::vector<TaskID> sampled_task_ids;
+  size_t protobuf_bytes = 0;
+  for (size_t i = 0; i < num_task_events; ++i) {
+    auto task_id = GenTaskIDForJob(i % num_jobs);
+    if (i % 1000 == 0) {
+      sampled_task_ids.push_back(task_id);
+    }
+    const int64_t ts = i;
+    auto state_update = GenStateUpdate({{rpc::TaskStatus::PENDING_ARGS_AVAIL, ts},
+                                        {rpc::TaskStatus::RUNNING, ts + 1000},
+                                        {rpc::TaskStatus::FINISHED, ts + 500000}},
+                                       worker_ids[i % worker_ids.size()]);
+    state_update.set_node_id(node_ids[i % node_ids.size()].Binary());
+    auto task_info = GenTaskInfo(JobID::FromInt(i % num_jobs),
+                                 RandomTaskId(),
+                                 rpc::TaskType::NORMAL_TASK,
+                                 ActorID::Nil(),
+                                 "task_" + std::to_string(i % 50));
+    task_info.set_func_or_class_name("module.task_" + std::to_string(i % 50));
+    (*task_info.mutable_required_resources())["CPU"] = 1;
+    auto events = GenTaskEvents({task_id},
+                                /* attempt_number */ 0,
+                                i % num_jobs,
+                                /* profile_events */ absl::nullopt,
+                                state_update,
+                                task_info);
+    protobuf_bytes += events[0].SpaceUsedLong();
+    archive.Add(std::move(events[0]));
+  }
+  RAY_LOG(INFO) << "Bytes per task event: "
+                << archive.MemoryUsageBytes() / num_task_events << " archived, "
+                << protobuf_bytes / num_task_events << " as rpc::TaskEvents.";
+
+  std::vector<rpc::TaskEvents> result;
+  absl::flat_hash_set<TaskID> query_task_ids{sampled_task_ids[0]};
+  TaskEventsArchive::Query query;
+  query.task_ids = &query_task_ids;
+  auto start = absl::Now();
+  archive.GetTaskEvents(query, &result);
+  RAY_LOG(INFO) << "Query of 1 task: " << absl::ToDoubleMicroseconds(absl::Now() - start)
+                << " us.";
+  ASSERT_EQ(result.size(), 1);
+
+  result.clear();
+  query_task_ids = absl::flat_hash_set<TaskID>(sampled_task_ids.begin(),
+                                               sampled_task_ids.begin() + 100);
+  start = absl::Now();
+  archive.GetTaskEvents(query, &result);
+  RAY_LOG(INFO) << "Query of 100 tasks: "
+                << absl::ToDoubleMilliseconds(absl::Now() - start) << " ms.";
+  ASSERT_EQ(result.size(), 100);
+
+  result.clear();
+  TaskEventsArchive::Query job_query;
+  job_query.job_id = JobID::FromInt(1);
+  start = absl::Now();
+  archive.GetTaskEvents(job_query, &result);
+  RAY_LOG(INFO) << "Query of 1 job: " << absl::ToDoubleMilliseconds(absl::Now() - start)
+                << " ms.";
+  ASSERT_EQ(result.size(), num_task_events / num_jobs);
+}
+
 }  // namespace gcs
 }  // namespace ray
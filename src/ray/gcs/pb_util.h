@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <string_view>
 
 #include "ray/common/constants.h"
 #include "ray/common/id.h"
@@ -319,6 +322,41 @@ inline TaskAttempt GetTaskAttempt(const rpc::TaskEvents &task_event) {
                           task_event.attempt_number());
 }
 
+/// The order task attempts are paged in: by binary task id, then by attempt number.
+struct TaskAttemptPageOrder {
+  bool operator()(const TaskAttempt &left, const TaskAttempt &right) const {
+    const int cmp = std::memcmp(left.first.Data(), right.first.Data(), TaskID::Size());
+    return cmp < 0 || (cmp == 0 && static_cast<uint32_t>(left.second) <
+                                       static_cast<uint32_t>(right.second));
+  }
+};
+
+/// Return the page token of a task attempt: the binary task id followed by the
+/// big-endian attempt number, so that the tokens compare like the task attempts.
+inline std::string TaskAttemptPageToken(const TaskAttempt &task_attempt) {
+  std::string token = task_attempt.first.Binary();
+  const auto attempt_number = static_cast<uint32_t>(task_attempt.second);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    token.push_back(static_cast<char>((attempt_number >> shift) & 0xff));
+  }
+  return token;
+}
+
+/// Parse the page token of a task attempt.
+///
+/// \return The task attempt, or nullopt if the token is invalid.
+inline std::optional<TaskAttempt> ParseTaskAttemptPageToken(std::string_view token) {
+  if (token.size() != TaskID::Size() + sizeof(uint32_t)) {
+    return std::nullopt;
+  }
+  uint32_t attempt_number = 0;
+  for (size_t i = TaskID::Size(); i < token.size(); ++i) {
+    attempt_number = (attempt_number << 8) | static_cast<uint8_t>(token[i]);
+  }
+  return std::make_pair(TaskID::FromBinary(std::string(token.substr(0, TaskID::Size()))),
+                        static_cast<int32_t>(attempt_number));
+}
+
 inline bool IsActorTask(const rpc::TaskEvents &task_event) {
   if (!task_event.has_task_info()) {
     return false;
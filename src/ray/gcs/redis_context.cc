@@ -26,6 +26,7 @@ extern "C" {
 }
 
 // TODO(pcm): Integrate into the C++ tree.
+#include "absl/strings/match.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "ray/common/ray_config.h"
@@ -42,7 +43,7 @@ CallbackReply::CallbackReply(redisReply *redis_reply) : reply_type_(redis_reply-
     break;
   }
   case REDIS_REPLY_ERROR: {
-    RAY_LOG(FATAL) << "Got an error in redis reply: " << redis_reply->str;
+    error_reply_ = std::string(redis_reply->str, redis_reply->len);
     break;
   }
   case REDIS_REPLY_INTEGER: {
@@ -126,6 +127,9 @@ int64_t CallbackReply::ReadAsInteger() const {
 }
 
 Status CallbackReply::ReadAsStatus() const {
+  if (reply_type_ == REDIS_REPLY_ERROR) {
+    return Status::RedisError(error_reply_);
+  }
   RAY_CHECK(reply_type_ == REDIS_REPLY_STATUS) << "Unexpected type: " << reply_type_;
   return status_reply_;
 }
@@ -154,13 +158,15 @@ const std::vector<std::optional<std::string>> &CallbackReply::ReadAsStringArray(
 RedisRequestContext::RedisRequestContext(instrumented_io_context &io_service,
                                          RedisCallback callback,
                                          RedisAsyncContext *context,
-                                         std::vector<std::string> args)
+                                         std::vector<std::string> args,
+                                         bool pass_error_replies)
     : exp_back_off_(RayConfig::instance().redis_retry_base_ms(),
                     RayConfig::instance().redis_retry_multiplier(),
                     RayConfig::instance().redis_retry_max_ms()),
       io_service_(io_service),
       redis_context_(context),
       pending_retries_(RayConfig::instance().num_redis_request_retries() + 1),
+      pass_error_replies_(pass_error_replies),
       callback_(std::move(callback)),
       start_time_(absl::Now()),
       redis_cmds_(std::move(args)) {
@@ -176,7 +182,15 @@ void RedisRequestContext::RedisResponseFn(struct redisAsyncContext *async_contex
   auto *request_cxt = static_cast<RedisRequestContext *>(privdata);
   auto redis_reply = reinterpret_cast<redisReply *>(raw_reply);
   // Error happened.
-  if (redis_reply == nullptr || redis_reply->type == REDIS_REPLY_ERROR) {
+  // A NOSCRIPT error can't be fixed by running the same EVALSHA again.
+  const bool pass_error_reply =
+      redis_reply != nullptr && redis_reply->type == REDIS_REPLY_ERROR &&
+      request_cxt->pass_error_replies_ &&
+      (request_cxt->pending_retries_ == 0 ||
+       absl::StartsWith(std::string_view(redis_reply->str, redis_reply->len),
+                        "NOSCRIPT"));
+  if (redis_reply == nullptr ||
+      (redis_reply->type == REDIS_REPLY_ERROR && !pass_error_reply)) {
     auto error_msg = redis_reply ? redis_reply->str : async_context->errstr;
     RAY_LOG(ERROR) << "Redis request [" << absl::StrJoin(request_cxt->redis_cmds_, " ")
                    << "]"
@@ -562,12 +576,14 @@ std::unique_ptr<CallbackReply> RedisContext::RunArgvSync(
 }
 
 void RedisContext::RunArgvAsync(std::vector<std::string> args,
-                                RedisCallback redis_callback) {
+                                RedisCallback redis_callback,
+                                bool pass_error_replies) {
   RAY_CHECK(redis_async_context_);
   auto request_context = new RedisRequestContext(io_service_,
                                                  std::move(redis_callback),
                                                  redis_async_context_.get(),
-                                                 std::move(args));
+                                                 std::move(args),
+                                                 pass_error_replies);
   request_context->Run();
 }
 
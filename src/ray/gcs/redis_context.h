@@ -56,7 +56,7 @@ class CallbackReply {
   /// Read this reply data as an integer.
   int64_t ReadAsInteger() const;
 
-  /// Read this reply data as a status.
+  /// Read this reply data as a status. An error reply is read as a `RedisError`.
   Status ReadAsStatus() const;
 
   /// Read this reply data as a string.
@@ -113,7 +113,8 @@ struct RedisRequestContext {
   RedisRequestContext(instrumented_io_context &io_service,
                       RedisCallback callback,
                       RedisAsyncContext *context,
-                      std::vector<std::string> args);
+                      std::vector<std::string> args,
+                      bool pass_error_replies);
 
   static void RedisResponseFn(struct redisAsyncContext *async_context,
                               void *raw_reply,
@@ -126,6 +127,9 @@ struct RedisRequestContext {
   instrumented_io_context &io_service_;
   RedisAsyncContext *redis_context_;
   size_t pending_retries_;
+  /// Whether error replies are passed to the callback instead of crashing once the
+  /// retries are used up.
+  bool pass_error_replies_;
   RedisCallback callback_;
   absl::Time start_time_;
 
@@ -158,8 +162,12 @@ class RedisContext {
   ///
   /// \param args The vector of command args to pass to Redis.
   /// \param redis_callback The Redis callback function.
+  /// \param pass_error_replies Whether an error reply is passed to the callback
+  /// instead of crashing once the retries are used up. A NOSCRIPT error, which a retry
+  /// can't fix, is passed right away.
   void RunArgvAsync(std::vector<std::string> args,
-                    RedisCallback redis_callback = nullptr);
+                    RedisCallback redis_callback = nullptr,
+                    bool pass_error_replies = false);
 
   redisContext *sync_context() {
     RAY_CHECK(context_);
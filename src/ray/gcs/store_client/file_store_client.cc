@@ -0,0 +1,552 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/gcs/store_client/file_store_client.h"
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "absl/crc/crc32c.h"
+#include "absl/time/clock.h"
+#include "ray/common/ray_config.h"
+#include "ray/util/filesystem.h"
+
+namespace ray {
+
+namespace gcs {
+
+namespace {
+
+constexpr char kSnapshotFile[] = "snapshot";
+constexpr char kSnapshotTmpFile[] = "snapshot.tmp";
+constexpr char kLogFile[] = "log";
+/// The log replaced by a snapshot still being written.
+constexpr char kOldLogFile[] = "log.old";
+
+/// The snapshot is written in chunks of this size.
+constexpr size_t kSnapshotChunkBytes = 4 * 1024 * 1024;
+
+/// The kinds of records in the logs and the snapshot. A record holds the result of a
+/// write rather than the write itself, so replaying a record twice is harmless.
+enum class RecordType : uint8_t {
+  /// Set a key of a table to a value.
+  PUT = 1,
+  /// Delete a key of a table.
+  REMOVE = 2,
+  /// Set the job counter.
+  JOB_COUNTER = 3,
+};
+
+void PutFixed32(std::string *dst, uint32_t value) {
+  char buf[4];
+  for (int i = 0; i < 4; i++) {
+    buf[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  dst->append(buf, 4);
+}
+
+uint32_t DecodeFixed32(const char *ptr) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= static_cast<uint32_t>(static_cast<uint8_t>(ptr[i])) << (8 * i);
+  }
+  return value;
+}
+
+/// Encode a record as its payload size, the CRC32C of its payload and its payload.
+/// The payload is the record type followed by the sizes and contents of the table name,
+/// the key and the data.
+void EncodeRecord(std::string *dst,
+                  RecordType type,
+                  absl::string_view table_name,
+                  absl::string_view key,
+                  absl::string_view data) {
+  const size_t header_offset = dst->size();
+  dst->append(8, '\0');
+  const size_t payload_offset = dst->size();
+  dst->push_back(static_cast<char>(type));
+  for (const auto &field : {table_name, key, data}) {
+    PutFixed32(dst, field.size());
+    dst->append(field.data(), field.size());
+  }
+  const absl::string_view payload(dst->data() + payload_offset,
+                                  dst->size() - payload_offset);
+  std::string header;
+  PutFixed32(&header, payload.size());
+  PutFixed32(&header, static_cast<uint32_t>(absl::ComputeCrc32c(payload)));
+  dst->replace(header_offset, header.size(), header);
+}
+
+int OpenFile(const std::string &path, bool truncate) {
+#ifdef _WIN32
+  int fd = _open(path.c_str(),
+                 _O_WRONLY | _O_CREAT | _O_BINARY | (truncate ? _O_TRUNC : _O_APPEND),
+                 _S_IREAD | _S_IWRITE);
+#else
+  int fd = open(path.c_str(),
+                O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND),
+                0644);
+#endif
+  RAY_CHECK(fd >= 0) << "Failed to open " << path << ": " << strerror(errno);
+  return fd;
+}
+
+void WriteFile(int fd, absl::string_view data) {
+  while (!data.empty()) {
+#ifdef _WIN32
+    auto written = _write(fd, data.data(), data.size());
+#else
+    auto written = write(fd, data.data(), data.size());
+#endif
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    RAY_CHECK(written > 0) << "Failed to write the GCS storage: " << strerror(errno);
+    data.remove_prefix(written);
+  }
+}
+
+void SyncFile(int fd) {
+#ifdef _WIN32
+  int result = _commit(fd);
+#elif defined(__linux__)
+  int result = fdatasync(fd);
+#else
+  int result = fsync(fd);
+#endif
+  RAY_CHECK(result == 0) << "Failed to sync the GCS storage: " << strerror(errno);
+}
+
+void CloseFile(int fd) {
+#ifdef _WIN32
+  _close(fd);
+#else
+  close(fd);
+#endif
+}
+
+/// Make the files renamed or created in a directory durable.
+void SyncDirectory(const std::string &path) {
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  RAY_CHECK(fd >= 0) << "Failed to open " << path << ": " << strerror(errno);
+  fsync(fd);
+  close(fd);
+#endif
+}
+
+}  // namespace
+
+FileStoreClient::FileStoreClient(instrumented_io_context &main_io_service,
+                                 const std::string &storage_path)
+    : main_io_service_(main_io_service), storage_path_(storage_path) {
+  Recover();
+  sync_thread_ = std::thread([this] { SyncLoop(); });
+}
+
+FileStoreClient::~FileStoreClient() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopped_ = true;
+  }
+  sync_thread_.join();
+  if (snapshot_thread_.joinable()) {
+    snapshot_thread_.join();
+  }
+  CloseFile(log_fd_);
+}
+
+void FileStoreClient::Recover() {
+  std::filesystem::create_directories(storage_path_);
+  const auto snapshot_path = JoinPaths(storage_path_, kSnapshotFile);
+  const auto old_log_path = JoinPaths(storage_path_, kOldLogFile);
+  const auto log_path = JoinPaths(storage_path_, kLogFile);
+  std::filesystem::remove(JoinPaths(storage_path_, kSnapshotTmpFile));
+
+  absl::MutexLock lock(&mutex_);
+  auto start = absl::Now();
+  if (std::filesystem::exists(snapshot_path)) {
+    snapshot_bytes_ = std::filesystem::file_size(snapshot_path);
+    RAY_CHECK(ReplayFile(snapshot_path) == snapshot_bytes_)
+        << "The GCS storage snapshot " << snapshot_path << " is corrupted.";
+  }
+  const bool compaction_unfinished = std::filesystem::exists(old_log_path);
+  if (compaction_unfinished) {
+    // The old log was synced before the compaction started, so it's complete.
+    ReplayFile(old_log_path);
+  }
+  if (std::filesystem::exists(log_path)) {
+    log_bytes_ = ReplayFile(log_path);
+    if (log_bytes_ < std::filesystem::file_size(log_path)) {
+      // The GCS died in the middle of a write, whose callback never ran.
+      RAY_LOG(WARNING) << "Discarding a partial write at the end of " << log_path;
+      std::filesystem::resize_file(log_path, log_bytes_);
+    }
+  }
+  size_t num_records = 0;
+  for (const auto &[table_name, table] : tables_) {
+    num_records += table.size();
+  }
+  RAY_LOG(INFO) << "Recovered " << num_records << " records of " << tables_.size()
+                << " tables from the GCS storage in " << storage_path_ << " in "
+                << absl::ToDoubleMilliseconds(absl::Now() - start) << " ms.";
+
+  if (compaction_unfinished) {
+    // Finish the compaction before a new one needs the old log file.
+    WriteSnapshot(tables_, reserved_job_id_);
+  }
+  log_fd_ = OpenFile(log_path, /*truncate=*/false);
+}
+
+uint64_t FileStoreClient::ReplayFile(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  RAY_CHECK(file) << "Failed to open " << path;
+  std::string content(std::filesystem::file_size(path), '\0');
+  file.read(content.data(), content.size());
+  content.resize(file.gcount());
+  // The table of the previous record, as consecutive records usually share the table.
+  Table *table = nullptr;
+  absl::string_view table_name;
+  uint64_t offset = 0;
+  while (offset + 8 <= content.size()) {
+    const uint32_t payload_size = DecodeFixed32(content.data() + offset);
+    const uint32_t crc = DecodeFixed32(content.data() + offset + 4);
+    if (payload_size > content.size() - offset - 8) {
+      break;
+    }
+    absl::string_view payload(content.data() + offset + 8, payload_size);
+    if (payload.empty() ||
+        static_cast<uint32_t>(absl::ComputeCrc32c(payload)) != crc) {
+      break;
+    }
+    const auto type = static_cast<RecordType>(payload[0]);
+    payload.remove_prefix(1);
+    absl::string_view fields[3];
+    bool valid = true;
+    for (auto &field : fields) {
+      if (payload.size() < 4 || DecodeFixed32(payload.data()) > payload.size() - 4) {
+        valid = false;
+        break;
+      }
+      field = payload.substr(4, DecodeFixed32(payload.data()));
+      payload.remove_prefix(4 + field.size());
+    }
+    if (!valid) {
+      break;
+    }
+    const auto &[record_table_name, key, data] = fields;
+    if (type == RecordType::JOB_COUNTER) {
+      reserved_job_id_ = std::stoi(std::string(data));
+      job_id_ = reserved_job_id_;
+    } else {
+      if (table == nullptr || record_table_name != table_name) {
+        table = &tables_[record_table_name];
+        table_name = record_table_name;
+      }
+      if (type == RecordType::PUT) {
+        (*table)[key] = std::string(data);
+      } else {
+        RAY_CHECK(type == RecordType::REMOVE)
+            << "Unknown record type " << static_cast<int>(type) << " in " << path;
+        table->erase(key);
+      }
+    }
+    offset += 8 + payload_size;
+  }
+  return offset;
+}
+
+void FileStoreClient::PostAfterSync(std::function<void()> callback, std::string name) {
+  pending_callbacks_.emplace_back(std::move(callback), std::move(name));
+}
+
+void FileStoreClient::SyncLoop() {
+  const auto log_path = JoinPaths(storage_path_, kLogFile);
+  const auto old_log_path = JoinPaths(storage_path_, kOldLogFile);
+  while (true) {
+    std::string records;
+    std::vector<std::pair<std::function<void()>, std::string>> callbacks;
+    std::unique_ptr<Tables> snapshot;
+    int job_id = 0;
+    uint64_t batch = 0;
+    {
+      absl::MutexLock lock(&mutex_);
+      auto has_writes_or_stopped = [this]() {
+        mutex_.AssertReaderHeld();
+        return !pending_records_.empty() || !pending_callbacks_.empty() || stopped_;
+      };
+      mutex_.Await(absl::Condition(&has_writes_or_stopped));
+      if (pending_records_.empty() && pending_callbacks_.empty()) {
+        break;
+      }
+      // Take all the writes that arrived during the previous sync as one batch.
+      records.swap(pending_records_);
+      callbacks.swap(pending_callbacks_);
+      batch = ++num_batches_;
+      if (!compacting_ &&
+          log_bytes_ + records.size() >
+              std::max<uint64_t>(
+                  RayConfig::instance().gcs_file_storage_compaction_bytes(),
+                  snapshot_bytes_)) {
+        // The tables include this batch, so they replace the snapshot and this log.
+        snapshot = std::make_unique<Tables>(tables_);
+        job_id = reserved_job_id_;
+      }
+    }
+
+    if (!records.empty()) {
+      WriteFile(log_fd_, records);
+      SyncFile(log_fd_);
+      log_bytes_ += records.size();
+    }
+    {
+      absl::MutexLock lock(&mutex_);
+      num_synced_batches_ = batch;
+    }
+    for (auto &[callback, name] : callbacks) {
+      main_io_service_.post(std::move(callback), std::move(name));
+    }
+
+    if (snapshot != nullptr) {
+      // Start a new log while the snapshot is written in the background. Until the
+      // snapshot replaces the old log, recovery replays both logs.
+      CloseFile(log_fd_);
+      std::filesystem::rename(log_path, old_log_path);
+      log_fd_ = OpenFile(log_path, /*truncate=*/true);
+      SyncDirectory(storage_path_);
+      log_bytes_ = 0;
+      if (snapshot_thread_.joinable()) {
+        snapshot_thread_.join();
+      }
+      compacting_ = true;
+      snapshot_thread_ = std::thread([this, snapshot = std::move(snapshot), job_id]() {
+        WriteSnapshot(*snapshot, job_id);
+        compacting_ = false;
+      });
+    }
+  }
+}
+
+void FileStoreClient::WriteSnapshot(const Tables &tables, int job_id) {
+  auto start = absl::Now();
+  const auto tmp_path = JoinPaths(storage_path_, kSnapshotTmpFile);
+  int fd = OpenFile(tmp_path, /*truncate=*/true);
+  std::string buffer;
+  uint64_t snapshot_bytes = 0;
+  for (const auto &[table_name, table] : tables) {
+    for (const auto &[key, data] : table) {
+      EncodeRecord(&buffer, RecordType::PUT, table_name, key, data);
+      if (buffer.size() >= kSnapshotChunkBytes) {
+        WriteFile(fd, buffer);
+        snapshot_bytes += buffer.size();
+        buffer.clear();
+      }
+    }
+  }
+  EncodeRecord(&buffer, RecordType::JOB_COUNTER, "", "", std::to_string(job_id));
+  WriteFile(fd, buffer);
+  snapshot_bytes += buffer.size();
+  SyncFile(fd);
+  CloseFile(fd);
+  std::filesystem::rename(tmp_path, JoinPaths(storage_path_, kSnapshotFile));
+  SyncDirectory(storage_path_);
+  std::filesystem::remove(JoinPaths(storage_path_, kOldLogFile));
+  snapshot_bytes_ = snapshot_bytes;
+  RAY_LOG(INFO) << "Compacted the GCS storage into a snapshot of " << snapshot_bytes
+                << " bytes in " << absl::ToDoubleMilliseconds(absl::Now() - start)
+                << " ms.";
+}
+
+Status FileStoreClient::AsyncPut(const std::string &table_name,
+                                 const std::string &key,
+                                 const std::string &data,
+                                 bool overwrite,
+                                 std::function<void(bool)> callback) {
+  absl::MutexLock lock(&mutex_);
+  auto &table = tables_[table_name];
+  auto [it, inserted] = table.try_emplace(key, data);
+  if (!inserted && overwrite) {
+    it->second = data;
+  }
+  if (inserted || overwrite) {
+    EncodeRecord(&pending_records_, RecordType::PUT, table_name, key, data);
+  }
+  if (callback != nullptr) {
+    PostAfterSync([callback, inserted = inserted]() { callback(inserted); },
+                  "GcsFileStore.Put");
+  }
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncGet(const std::string &table_name,
+                                 const std::string &key,
+                                 const OptionalItemCallback<std::string> &callback) {
+  RAY_CHECK(callback != nullptr);
+  absl::MutexLock lock(&mutex_);
+  boost::optional<std::string> data;
+  auto table_it = tables_.find(table_name);
+  if (table_it != tables_.end()) {
+    auto it = table_it->second.find(key);
+    if (it != table_it->second.end()) {
+      data = it->second;
+    }
+  }
+  main_io_service_.post(
+      [callback, data = std::move(data)]() { callback(Status::OK(), data); },
+      "GcsFileStore.Get");
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncGetAll(
+    const std::string &table_name,
+    const MapCallback<std::string, std::string> &callback) {
+  RAY_CHECK(callback);
+  absl::MutexLock lock(&mutex_);
+  auto result = absl::flat_hash_map<std::string, std::string>();
+  auto table_it = tables_.find(table_name);
+  if (table_it != tables_.end()) {
+    result = table_it->second;
+  }
+  main_io_service_.post(
+      [result = std::move(result), callback]() mutable { callback(std::move(result)); },
+      "GcsFileStore.GetAll");
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncMultiGet(
+    const std::string &table_name,
+    const std::vector<std::string> &keys,
+    const MapCallback<std::string, std::string> &callback) {
+  RAY_CHECK(callback);
+  absl::MutexLock lock(&mutex_);
+  auto result = absl::flat_hash_map<std::string, std::string>();
+  auto table_it = tables_.find(table_name);
+  if (table_it != tables_.end()) {
+    for (auto &key : keys) {
+      auto it = table_it->second.find(key);
+      if (it != table_it->second.end()) {
+        result[key] = it->second;
+      }
+    }
+  }
+  main_io_service_.post(
+      [result = std::move(result), callback]() mutable { callback(std::move(result)); },
+      "GcsFileStore.MultiGet");
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncDelete(const std::string &table_name,
+                                    const std::string &key,
+                                    std::function<void(bool)> callback) {
+  absl::MutexLock lock(&mutex_);
+  auto table_it = tables_.find(table_name);
+  const bool deleted = table_it != tables_.end() && table_it->second.erase(key) > 0;
+  if (deleted) {
+    EncodeRecord(&pending_records_, RecordType::REMOVE, table_name, key, "");
+  }
+  if (callback != nullptr) {
+    PostAfterSync([callback, deleted]() { callback(deleted); }, "GcsFileStore.Delete");
+  }
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncBatchDelete(const std::string &table_name,
+                                         const std::vector<std::string> &keys,
+                                         std::function<void(int64_t)> callback) {
+  absl::MutexLock lock(&mutex_);
+  int64_t num = 0;
+  auto table_it = tables_.find(table_name);
+  if (table_it != tables_.end()) {
+    for (auto &key : keys) {
+      if (table_it->second.erase(key) > 0) {
+        EncodeRecord(&pending_records_, RecordType::REMOVE, table_name, key, "");
+        num++;
+      }
+    }
+  }
+  if (callback != nullptr) {
+    PostAfterSync([callback, num]() { callback(num); }, "GcsFileStore.BatchDelete");
+  }
+  return Status::OK();
+}
+
+int FileStoreClient::GetNextJobID() {
+  absl::MutexLock lock(&mutex_);
+  const int job_id = ++job_id_;
+  if (job_id <= reserved_job_id_) {
+    return job_id;
+  }
+  reserved_job_id_ = job_id + kJobIdBlockSize - 1;
+  EncodeRecord(&pending_records_,
+               RecordType::JOB_COUNTER,
+               "",
+               "",
+               std::to_string(reserved_job_id_));
+  // Job ids must not be reused after a restart, so wait for the batch of this record
+  // to be synced.
+  const uint64_t batch = num_batches_ + 1;
+  auto synced = [this, batch]() {
+    mutex_.AssertReaderHeld();
+    return num_synced_batches_ >= batch;
+  };
+  mutex_.Await(absl::Condition(&synced));
+  return job_id;
+}
+
+Status FileStoreClient::AsyncGetKeys(
+    const std::string &table_name,
+    const std::string &prefix,
+    std::function<void(std::vector<std::string>)> callback) {
+  RAY_CHECK(callback);
+  absl::MutexLock lock(&mutex_);
+  std::vector<std::string> result;
+  auto table_it = tables_.find(table_name);
+  if (table_it != tables_.end()) {
+    for (auto &pair : table_it->second) {
+      if (pair.first.find(prefix) == 0) {
+        result.push_back(pair.first);
+      }
+    }
+  }
+  main_io_service_.post(
+      [result = std::move(result), callback]() mutable { callback(std::move(result)); },
+      "GcsFileStore.Keys");
+  return Status::OK();
+}
+
+Status FileStoreClient::AsyncExists(const std::string &table_name,
+                                    const std::string &key,
+                                    std::function<void(bool)> callback) {
+  RAY_CHECK(callback);
+  absl::MutexLock lock(&mutex_);
+  auto table_it = tables_.find(table_name);
+  bool result = table_it != tables_.end() && table_it->second.contains(key);
+  main_io_service_.post([result, callback]() mutable { callback(result); },
+                        "GcsFileStore.Exists");
+  return Status::OK();
+}
+
+}  // namespace gcs
+
+}  // namespace ray
@@ -0,0 +1,167 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/common/asio/instrumented_io_context.h"
+#include "ray/gcs/store_client/store_client.h"
+
+namespace ray {
+
+namespace gcs {
+
+/// \class FileStoreClient
+/// Please refer to StoreClient for API semantics.
+///
+/// The tables are kept in memory and persisted in a local or shared directory, so that
+/// a restarted GCS recovers them without Redis. Every write is appended to a
+/// write-ahead log, and its callback runs once the log is synced to disk. The writes
+/// that arrive while the log is being synced are synced together (group commit). When
+/// the log grows over `gcs_file_storage_compaction_bytes`, the tables are compacted
+/// into a snapshot in the background and a new log is started. The constructor
+/// recovers the tables from the snapshot and the logs.
+///
+/// Reads are served from memory, so they may observe writes whose callbacks haven't
+/// run yet.
+///
+/// This class is thread safe.
+class FileStoreClient : public StoreClient {
+ public:
+  /// The number of job ids reserved by a synced record at a time. The ids of a block
+  /// not handed out before a restart are skipped.
+  static constexpr int kJobIdBlockSize = 100;
+
+  /// \param main_io_service The event loop to run the callbacks on.
+  /// \param storage_path The directory of the snapshot and the logs. It's created if it
+  /// doesn't exist.
+  FileStoreClient(instrumented_io_context &main_io_service,
+                  const std::string &storage_path);
+
+  /// Sync the pending writes and wait for the ongoing compaction.
+  ~FileStoreClient() override;
+
+  Status AsyncPut(const std::string &table_name,
+                  const std::string &key,
+                  const std::string &data,
+                  bool overwrite,
+                  std::function<void(bool)> callback) override;
+
+  Status AsyncGet(const std::string &table_name,
+                  const std::string &key,
+                  const OptionalItemCallback<std::string> &callback) override;
+
+  Status AsyncGetAll(const std::string &table_name,
+                     const MapCallback<std::string, std::string> &callback) override;
+
+  Status AsyncMultiGet(const std::string &table_name,
+                       const std::vector<std::string> &keys,
+                       const MapCallback<std::string, std::string> &callback) override;
+
+  Status AsyncDelete(const std::string &table_name,
+                     const std::string &key,
+                     std::function<void(bool)> callback) override;
+
+  Status AsyncBatchDelete(const std::string &table_name,
+                          const std::vector<std::string> &keys,
+                          std::function<void(int64_t)> callback) override;
+
+  /// Job ids are reserved in blocks of kJobIdBlockSize. Reserving a block blocks the
+  /// calling thread until the record is synced to the log, so that ids are never reused
+  /// after a restart. The other ids of the block are returned without blocking.
+  int GetNextJobID() override;
+
+  Status AsyncGetKeys(const std::string &table_name,
+                      const std::string &prefix,
+                      std::function<void(std::vector<std::string>)> callback) override;
+
+  Status AsyncExists(const std::string &table_name,
+                     const std::string &key,
+                     std::function<void(bool)> callback) override;
+
+ private:
+  using Table = absl::flat_hash_map<std::string, std::string>;
+  using Tables = absl::flat_hash_map<std::string, Table>;
+
+  /// Load the snapshot, then replay the old log of an unfinished compaction and the
+  /// current log.
+  void Recover();
+
+  /// Apply the records of a file to the tables.
+  ///
+  /// \param path The file to replay.
+  /// \return The size of the valid records at the start of the file. Any bytes after
+  /// them are a torn or corrupted write.
+  uint64_t ReplayFile(const std::string &path) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Post a callback to the main event loop once the pending records are synced.
+  void PostAfterSync(std::function<void()> callback, std::string name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Sync the pending records to the log in batches until the client is destroyed.
+  void SyncLoop();
+
+  /// Write a snapshot of the tables, then remove the old log it replaces.
+  void WriteSnapshot(const Tables &tables, int job_id);
+
+  /// Async API Callback needs to post to main_io_service_ to ensure the orderly execution
+  /// of the callback.
+  instrumented_io_context &main_io_service_;
+  /// The directory of the snapshot and the logs.
+  const std::string storage_path_;
+
+  /// Mutex to protect the tables and the pending writes.
+  absl::Mutex mutex_;
+  Tables tables_ ABSL_GUARDED_BY(mutex_);
+  /// The last job id handed out.
+  int job_id_ ABSL_GUARDED_BY(mutex_) = 0;
+  /// The last job id reserved by the records, which is the one persisted.
+  int reserved_job_id_ ABSL_GUARDED_BY(mutex_) = 0;
+  /// The encoded records not synced to the log yet.
+  std::string pending_records_ ABSL_GUARDED_BY(mutex_);
+  /// The callbacks to post once the pending records are synced, with their names.
+  std::vector<std::pair<std::function<void()>, std::string>> pending_callbacks_
+      ABSL_GUARDED_BY(mutex_);
+  /// The number of batches of records taken by the sync thread.
+  uint64_t num_batches_ ABSL_GUARDED_BY(mutex_) = 0;
+  /// The number of batches of records synced to the log.
+  uint64_t num_synced_batches_ ABSL_GUARDED_BY(mutex_) = 0;
+  /// Whether the client is being destroyed.
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+
+  /// The following fields are only used by the sync thread once it's started.
+  /// The file descriptor of the current log.
+  int log_fd_ = -1;
+  /// The size of the current log.
+  uint64_t log_bytes_ = 0;
+  /// The thread writing the latest snapshot, if any.
+  std::thread snapshot_thread_;
+  /// Whether `snapshot_thread_` is still writing the snapshot.
+  std::atomic<bool> compacting_{false};
+  /// The size of the latest snapshot.
+  std::atomic<uint64_t> snapshot_bytes_{0};
+
+  std::thread sync_thread_;
+};
+
+}  // namespace gcs
+
+}  // namespace ray
@@ -18,8 +18,12 @@
 #include <regex>
 
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "ray/common/asio/asio_util.h"
 #include "ray/gcs/redis_context.h"
+#include "ray/stats/metric_defs.h"
 #include "ray/util/logging.h"
 
 namespace ray {
@@ -31,6 +35,24 @@ namespace {
 const std::string_view kTableSeparator = ":";
 const std::string_view kClusterSeparator = "@";
 
+// Runs a batch of HSET, HSETNX and HDEL commands on the hash KEYS[1] in order. ARGV holds
+// the command, the field and the value (empty for HDEL) of each write. The integer
+// replies are returned as strings, as a Lua array of numbers isn't a string array. A
+// failed write fails the script, and the writes are then sent one at a time.
+constexpr std::string_view kWriteBatchScript = R"(
+local replies = {}
+for i = 1, #ARGV, 3 do
+  local reply
+  if ARGV[i] == 'HDEL' then
+    reply = redis.call('HDEL', KEYS[1], ARGV[i + 1])
+  else
+    reply = redis.call(ARGV[i], KEYS[1], ARGV[i + 1], ARGV[i + 2])
+  end
+  replies[#replies + 1] = tostring(reply)
+end
+return replies
+)";
+
 // "[, ], -, ?, *, ^, \" are special chars in Redis pattern matching.
 // escape them with / according to the doc:
 // https://redis.io/commands/keys/
@@ -143,6 +165,25 @@ RedisStoreClient::RedisStoreClient(std::shared_ptr<RedisClient> redis_client)
       << kClusterSeparator << ".";
 }
 
+RedisStoreClient::~RedisStoreClient() {
+  std::vector<BufferedWrite> batch;
+  {
+    absl::MutexLock lock(&mu_);
+    if (write_batch_.empty()) {
+      return;
+    }
+    absl::Time batch_start;
+    batch = TakeWriteBatch(&batch_start);
+  }
+  // The requests sent through the sending queues have callbacks that use this client.
+  // The writes are sent after the requests already in flight on the same connection,
+  // so they are still run in order.
+  auto context = redis_client_->GetPrimaryContext();
+  for (auto &write : batch) {
+    SendUnbatchedWrite(context, external_storage_namespace_, std::move(write));
+  }
+}
+
 Status RedisStoreClient::AsyncPut(const std::string &table_name,
                                   const std::string &key,
                                   const std::string &data,
@@ -179,6 +220,8 @@ Status RedisStoreClient::AsyncGetAll(
     const std::string &table_name,
     const MapCallback<std::string, std::string> &callback) {
   RAY_CHECK(callback);
+  // The scan doesn't go through the sending queues, so send the writes before it.
+  FlushWriteBatch();
   std::string match_pattern =
       GenKeyRedisMatchPattern(external_storage_namespace_, table_name);
   auto scanner = std::make_shared<RedisScanner>(
@@ -279,8 +322,10 @@ std::vector<std::function<void()>> RedisStoreClient::TakeRequestsFromSendingQueu
 
 void RedisStoreClient::SendRedisCmd(std::vector<std::string> keys,
                                     std::vector<std::string> args,
-                                    RedisCallback redis_callback) {
+                                    RedisCallback redis_callback,
+                                    std::string_view script) {
   RAY_CHECK(!keys.empty());
+  FlushWriteBatch(&keys);
   // The number of keys that's ready for this request.
   // For a query reading or writing multiple keys, we need a counter
   // to check whether all existing requests for this keys have been
@@ -290,8 +335,8 @@ void RedisStoreClient::SendRedisCmd(std::vector<std::string> keys,
                                       num_ready_keys = num_ready_keys,
                                       keys,
                                       args = std::move(args),
-                                      redis_callback =
-                                          std::move(redis_callback)]() mutable {
+                                      redis_callback = std::move(redis_callback),
+                                      script]() mutable {
     {
       absl::MutexLock lock(&mu_);
       *num_ready_keys += 1;
@@ -302,23 +347,7 @@ void RedisStoreClient::SendRedisCmd(std::vector<std::string> keys,
       }
     }
     // Send the actual request
-    auto cxt = redis_client_->GetPrimaryContext();
-    cxt->RunArgvAsync(std::move(args),
-                      [this,
-                       keys = std::move(keys),
-                       redis_callback = std::move(redis_callback)](auto reply) {
-                        std::vector<std::function<void()>> requests;
-                        {
-                          absl::MutexLock lock(&mu_);
-                          requests = TakeRequestsFromSendingQueue(keys);
-                        }
-                        for (auto &request : requests) {
-                          request();
-                        }
-                        if (redis_callback) {
-                          redis_callback(reply);
-                        }
-                      });
+    RunRedisCmd(std::move(keys), std::move(args), std::move(redis_callback), script);
   };
 
   {
@@ -338,10 +367,69 @@ void RedisStoreClient::SendRedisCmd(std::vector<std::string> keys,
   }
 }
 
+void RedisStoreClient::RunRedisCmd(std::vector<std::string> keys,
+                                   std::vector<std::string> args,
+                                   RedisCallback redis_callback,
+                                   std::string_view script) {
+  // Keep the EVALSHA arguments to run them again with EVAL.
+  std::vector<std::string> eval_args;
+  if (!script.empty() && args[0] == "EVALSHA") {
+    eval_args = args;
+  }
+  auto cxt = redis_client_->GetPrimaryContext();
+  cxt->RunArgvAsync(
+      std::move(args),
+      [this,
+       keys = std::move(keys),
+       eval_args = std::move(eval_args),
+       redis_callback = std::move(redis_callback),
+       script](auto reply) mutable {
+        if (!eval_args.empty() && reply->IsError() &&
+            absl::StartsWith(reply->ReadAsStatus().message(), "NOSCRIPT")) {
+          // The script cache of Redis was flushed, e.g. by a restart. EVAL loads the
+          // script again. The keys are still held, so the order of the writes is kept.
+          eval_args[0] = "EVAL";
+          eval_args[1] = std::string(script);
+          RunRedisCmd(std::move(keys),
+                      std::move(eval_args),
+                      std::move(redis_callback),
+                      script);
+          return;
+        }
+        // The callback of a script runs before the next requests of its keys are sent,
+        // so that the writes it sends again when the script fails go first.
+        if (!script.empty() && redis_callback) {
+          redis_callback(reply);
+        }
+        std::vector<std::function<void()>> requests;
+        {
+          absl::MutexLock lock(&mu_);
+          requests = TakeRequestsFromSendingQueue(keys);
+        }
+        for (auto &request : requests) {
+          request();
+        }
+        if (script.empty() && redis_callback) {
+          redis_callback(reply);
+        }
+      },
+      /*pass_error_replies=*/!script.empty());
+}
+
 Status RedisStoreClient::DoPut(const std::string &key,
                                const std::string &data,
                                bool overwrite,
                                std::function<void(bool)> callback) {
+  if (IsWriteBatchingEnabled()) {
+    std::function<void(int64_t)> write_callback = nullptr;
+    if (callback) {
+      write_callback = [callback = std::move(callback)](int64_t added_num) {
+        callback(added_num != 0);
+      };
+    }
+    BufferWrite({overwrite ? "HSET" : "HSETNX", key, data, std::move(write_callback)});
+    return Status::OK();
+  }
   std::vector<std::string> args = {
       overwrite ? "HSET" : "HSETNX", external_storage_namespace_, key, data};
   RedisCallback write_callback = nullptr;
@@ -358,6 +446,10 @@ Status RedisStoreClient::DoPut(const std::string &key,
 
 Status RedisStoreClient::DeleteByKeys(const std::vector<std::string> &keys,
                                       std::function<void(int64_t)> callback) {
+  if (keys.size() == 1 && IsWriteBatchingEnabled()) {
+    BufferWrite({"HDEL", keys.front(), "", std::move(callback)});
+    return Status::OK();
+  }
   auto del_cmds = GenCommandsBatched("HDEL", external_storage_namespace_, keys);
   auto total_count = del_cmds.size();
   auto finished_count = std::make_shared<size_t>(0);
@@ -381,6 +473,190 @@ Status RedisStoreClient::DeleteByKeys(const std::vector<std::string> &keys,
   return Status::OK();
 }
 
+void RedisStoreClient::BufferWrite(BufferedWrite write) {
+  std::vector<BufferedWrite> batch;
+  absl::Time batch_start;
+  {
+    absl::MutexLock lock(&mu_);
+    if (write_batch_.empty()) {
+      write_batch_start_ = absl::Now();
+      write_batch_timer_ = execute_after(
+          redis_client_->GetPrimaryContext()->io_service(),
+          [this, batch_id = write_batch_id_]() {
+            {
+              absl::MutexLock lock(&mu_);
+              // The batch was already sent because it was full.
+              if (batch_id != write_batch_id_) {
+                return;
+              }
+            }
+            FlushWriteBatch();
+          },
+          std::chrono::microseconds(
+              RayConfig::instance().gcs_redis_write_batch_window_us()));
+    }
+    write_batch_keys_.insert(write.redis_key);
+    write_batch_.push_back(std::move(write));
+    if (write_batch_.size() <
+        RayConfig::instance().maximum_gcs_storage_operation_batch_size()) {
+      return;
+    }
+    batch = TakeWriteBatch(&batch_start);
+  }
+  SendWriteBatch(std::move(batch), batch_start);
+}
+
+std::vector<RedisStoreClient::BufferedWrite> RedisStoreClient::TakeWriteBatch(
+    absl::Time *batch_start) {
+  if (write_batch_timer_ != nullptr) {
+    write_batch_timer_->cancel();
+    write_batch_timer_ = nullptr;
+  }
+  ++write_batch_id_;
+  write_batch_keys_.clear();
+  *batch_start = write_batch_start_;
+  std::vector<BufferedWrite> batch;
+  batch.swap(write_batch_);
+  return batch;
+}
+
+void RedisStoreClient::FlushWriteBatch(const std::vector<std::string> *keys) {
+  std::vector<BufferedWrite> batch;
+  absl::Time batch_start;
+  {
+    absl::MutexLock lock(&mu_);
+    if (write_batch_.empty()) {
+      return;
+    }
+    if (keys != nullptr) {
+      bool has_buffered_write = false;
+      for (const auto &key : *keys) {
+        if (write_batch_keys_.contains(key)) {
+          has_buffered_write = true;
+          break;
+        }
+      }
+      if (!has_buffered_write) {
+        return;
+      }
+    }
+    batch = TakeWriteBatch(&batch_start);
+  }
+  SendWriteBatch(std::move(batch), batch_start);
+}
+
+void RedisStoreClient::SendWriteBatch(std::vector<BufferedWrite> batch,
+                                      absl::Time batch_start) {
+  STATS_gcs_storage_write_batch_size.Record(batch.size());
+  std::vector<std::string> keys;
+  std::vector<std::string> args;
+  std::string_view script;
+  if (batch.size() == 1) {
+    auto &write = batch.front();
+    keys.push_back(write.redis_key);
+    args = {write.command, external_storage_namespace_, write.redis_key};
+    if (write.command != "HDEL") {
+      args.push_back(std::move(write.data));
+    }
+  } else {
+    // A key written several times in the batch waits for its in-flight requests once.
+    absl::flat_hash_set<std::string> unique_keys;
+    script = kWriteBatchScript;
+    bool send_script_load = false;
+    {
+      absl::MutexLock lock(&mu_);
+      if (write_batch_script_sha_.empty()) {
+        args = {"EVAL", std::string(script), "1", external_storage_namespace_};
+        send_script_load = !write_batch_script_load_sent_;
+        write_batch_script_load_sent_ = true;
+      } else {
+        args = {"EVALSHA", write_batch_script_sha_, "1", external_storage_namespace_};
+      }
+    }
+    if (send_script_load) {
+      redis_client_->GetPrimaryContext()->RunArgvAsync(
+          {"SCRIPT", "LOAD", std::string(script)},
+          [this](const std::shared_ptr<CallbackReply> &reply) {
+            if (reply->IsError()) {
+              // The batches keep sending the script with EVAL.
+              RAY_LOG(WARNING) << "Failed to load the write batch script into Redis: "
+                               << reply->ReadAsStatus();
+              return;
+            }
+            absl::MutexLock lock(&mu_);
+            write_batch_script_sha_ = reply->ReadAsString();
+          },
+          /*pass_error_replies=*/true);
+    }
+    args.reserve(args.size() + 3 * batch.size());
+    for (auto &write : batch) {
+      if (unique_keys.insert(write.redis_key).second) {
+        keys.push_back(write.redis_key);
+      }
+      args.push_back(write.command);
+      args.push_back(write.redis_key);
+      args.push_back(std::move(write.data));
+    }
+  }
+  auto batch_callback = [this, batch = std::move(batch), batch_start](
+                            const std::shared_ptr<CallbackReply> &reply) mutable {
+    STATS_gcs_storage_write_batch_flush_latency_ms.Record(
+        absl::ToDoubleMilliseconds(absl::Now() - batch_start));
+    if (batch.size() == 1) {
+      if (batch.front().callback) {
+        batch.front().callback(reply->ReadAsInteger());
+      }
+      return;
+    }
+    if (reply->IsError()) {
+      // Either Redis can't run the script, or one of its writes failed. The writes
+      // are sent again one at a time, and a write that keeps failing is handled like
+      // any other failed request.
+      if (!write_batch_script_failed_.exchange(true)) {
+        RAY_LOG(WARNING) << "Failed to run the write batch script in Redis, writes "
+                            "won't be batched anymore: "
+                         << reply->ReadAsStatus();
+      }
+      auto context = redis_client_->GetPrimaryContext();
+      for (auto &write : batch) {
+        SendUnbatchedWrite(context, external_storage_namespace_, std::move(write));
+      }
+      return;
+    }
+    const auto &replies = reply->ReadAsStringArray();
+    RAY_CHECK(replies.size() == batch.size())
+        << "Got " << replies.size() << " replies for " << batch.size() << " writes.";
+    for (size_t i = 0; i < batch.size(); ++i) {
+      int64_t num = 0;
+      if (!replies[i].has_value() || !absl::SimpleAtoi(*replies[i], &num)) {
+        RAY_LOG(FATAL) << "Unexpected reply to " << batch[i].command << " on "
+                       << batch[i].redis_key << " in Redis: " << replies[i].value_or("");
+      }
+      if (batch[i].callback) {
+        batch[i].callback(num);
+      }
+    }
+  };
+  SendRedisCmd(std::move(keys), std::move(args), std::move(batch_callback), script);
+}
+
+void RedisStoreClient::SendUnbatchedWrite(const std::shared_ptr<RedisContext> &context,
+                                          const std::string &external_storage_namespace,
+                                          BufferedWrite write) {
+  std::vector<std::string> args = {
+      write.command, external_storage_namespace, write.redis_key};
+  if (write.command != "HDEL") {
+    args.push_back(std::move(write.data));
+  }
+  context->RunArgvAsync(std::move(args),
+                        [callback = std::move(write.callback)](
+                            const std::shared_ptr<CallbackReply> &reply) {
+                          if (callback) {
+                            callback(reply->ReadAsInteger());
+                          }
+                        });
+}
+
 RedisStoreClient::RedisScanner::RedisScanner(
     std::shared_ptr<RedisClient> redis_client,
     const std::string &external_storage_namespace,
@@ -469,6 +745,7 @@ Status RedisStoreClient::AsyncGetKeys(
     const std::string &table_name,
     const std::string &prefix,
     std::function<void(std::vector<std::string>)> callback) {
+  FlushWriteBatch();
   std::string match_pattern =
       GenKeyRedisMatchPattern(external_storage_namespace_, table_name, prefix);
   auto scanner = std::make_shared<RedisScanner>(
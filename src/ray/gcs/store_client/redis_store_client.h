@@ -16,10 +16,14 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <atomic>
+#include <boost/asio/deadline_timer.hpp>
 #include <queue>
+#include <string_view>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "ray/common/ray_config.h"
 #include "ray/gcs/redis_client.h"
 #include "ray/gcs/redis_context.h"
@@ -34,6 +38,10 @@ class RedisStoreClient : public StoreClient {
  public:
   explicit RedisStoreClient(std::shared_ptr<RedisClient> redis_client);
 
+  /// Send the buffered writes, if any, one by one. Their replies may arrive after this
+  /// client is destroyed, so they only call the callbacks of the writes.
+  ~RedisStoreClient() override;
+
   Status AsyncPut(const std::string &table_name,
                   const std::string &key,
                   const std::string &data,
@@ -147,22 +155,106 @@ class RedisStoreClient : public StoreClient {
   // \param keys The keys in the request.
   // \param args The redis commands
   // \param redis_callback The callback to call when the reply is received.
+  // \param script If not empty, `args` is an EVALSHA or an EVAL of this Lua script. An
+  // EVALSHA is run again with EVAL if Redis doesn't have the script cached. Error
+  // replies are passed to `redis_callback` instead of crashing once the retries are
+  // used up, and `redis_callback` runs before the next requests of the keys are sent.
   void SendRedisCmd(std::vector<std::string> keys,
                     std::vector<std::string> args,
-                    RedisCallback redis_callback);
+                    RedisCallback redis_callback,
+                    std::string_view script = {});
+
+  // Run a command of SendRedisCmd, then send the next requests of its keys.
+  void RunRedisCmd(std::vector<std::string> keys,
+                   std::vector<std::string> args,
+                   RedisCallback redis_callback,
+                   std::string_view script);
 
   void MGetValues(const std::string &table_name,
                   const std::vector<std::string> &keys,
                   const MapCallback<std::string, std::string> &callback);
 
+  /// A single-key write buffered to be sent to Redis with the other writes of its batch.
+  struct BufferedWrite {
+    /// HSET, HSETNX or HDEL.
+    std::string command;
+    std::string redis_key;
+    /// The value to set. Unused by HDEL.
+    std::string data;
+    /// Called with the integer reply of the command, or 0 if the write failed.
+    std::function<void(int64_t)> callback;
+  };
+
+  /// Whether writes are buffered to be sent in batches. Batching is turned off for good
+  /// if Redis fails to run the write batch script.
+  bool IsWriteBatchingEnabled() const {
+    return RayConfig::instance().gcs_redis_write_batch_window_us() > 0 &&
+           !write_batch_script_failed_;
+  }
+
+  /// Buffer a write until the batch window `gcs_redis_write_batch_window_us` ends or
+  /// the batch is full.
+  void BufferWrite(BufferedWrite write);
+
+  /// Take the buffered writes to send them.
+  ///
+  /// \param[out] batch_start When the first write of the batch was buffered.
+  /// \return The buffered writes.
+  std::vector<BufferedWrite> TakeWriteBatch(absl::Time *batch_start)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  /// Send the buffered writes. If `keys` is given, they're only sent if one of them
+  /// writes to one of the keys, so that a request made after a buffered write of the
+  /// same key isn't sent before it.
+  void FlushWriteBatch(const std::vector<std::string> *keys = nullptr);
+
+  /// Send a batch of writes as one Redis command. A batch of several writes is run by a
+  /// Lua script, which returns the reply of each write. The script is sent with EVAL
+  /// until SCRIPT LOAD, started by the first batch, returns its SHA1 digest, and is run
+  /// with EVALSHA after that. If Redis fails to run the script, or a write of the script
+  /// fails, the writes are sent one by one.
+  void SendWriteBatch(std::vector<BufferedWrite> batch, absl::Time batch_start);
+
+  /// Send a buffered write as its own command, bypassing the sending queues of its key.
+  /// The reply only calls the callback of the write, so it can arrive after the client
+  /// is destroyed. Like the other requests, a failed write is retried, and the process
+  /// exits if it keeps failing.
+  ///
+  /// \param context The Redis context to send the write to.
+  /// \param external_storage_namespace The hash the write is made in.
+  /// \param write The write to send.
+  static void SendUnbatchedWrite(const std::shared_ptr<RedisContext> &context,
+                                 const std::string &external_storage_namespace,
+                                 BufferedWrite write);
+
   std::string external_storage_namespace_;
   std::shared_ptr<RedisClient> redis_client_;
   absl::Mutex mu_;
+  /// The SHA1 digest of the write batch script loaded into Redis, empty until
+  /// SCRIPT LOAD replies.
+  std::string write_batch_script_sha_ ABSL_GUARDED_BY(mu_);
+  /// Whether SCRIPT LOAD was sent for the write batch script.
+  bool write_batch_script_load_sent_ ABSL_GUARDED_BY(mu_) = false;
+  /// Set when Redis fails to run the write batch script, e.g. because scripting is
+  /// disabled. Writes are no longer batched after that.
+  std::atomic<bool> write_batch_script_failed_ = false;
 
   // The pending redis requests queue for each key.
   // The queue will be poped when the request is processed.
   absl::flat_hash_map<std::string, std::queue<std::function<void()>>>
       pending_redis_request_by_key_ ABSL_GUARDED_BY(mu_);
+
+  /// The buffered writes, in the order they were made.
+  std::vector<BufferedWrite> write_batch_ ABSL_GUARDED_BY(mu_);
+  /// The keys written by `write_batch_`.
+  absl::flat_hash_set<std::string> write_batch_keys_ ABSL_GUARDED_BY(mu_);
+  /// When the first write of `write_batch_` was buffered.
+  absl::Time write_batch_start_ ABSL_GUARDED_BY(mu_);
+  /// Incremented when a batch is sent, so that the timer of a batch sent early because
+  /// it's full is a no-op.
+  uint64_t write_batch_id_ ABSL_GUARDED_BY(mu_) = 0;
+  /// The timer to send `write_batch_` at the end of its window.
+  std::shared_ptr<boost::asio::deadline_timer> write_batch_timer_ ABSL_GUARDED_BY(mu_);
   FRIEND_TEST(RedisStoreClientTest, Random);
 };
 
@@ -243,6 +243,213 @@ TEST_F(RedisStoreClientTest, Complicated) {
       5000));
 }
 
+class RedisStoreClientWriteBatchTest : public RedisStoreClientTest {
+ public:
+  RedisStoreClientWriteBatchTest() {
+    ::RayConfig::instance().gcs_redis_write_batch_window_us() = 1000;
+  }
+
+  ~RedisStoreClientWriteBatchTest() override {
+    ::RayConfig::instance().gcs_redis_write_batch_window_us() = 0;
+  }
+};
+
+TEST_F(RedisStoreClientWriteBatchTest, AsyncPutAndAsyncGetTest) {
+  TestAsyncPutAndAsyncGet();
+}
+
+TEST_F(RedisStoreClientWriteBatchTest, AsyncGetAllAndBatchDeleteTest) {
+  TestAsyncGetAllAndBatchDelete();
+}
+
+TEST_F(RedisStoreClientWriteBatchTest, OrderedWithReadsOfSameKey) {
+  // The writes of a key share a batch, and a read of the key sends the batch before it.
+  auto cnt = std::make_shared<std::atomic<size_t>>(0);
+  for (size_t i = 0; i < 100; ++i) {
+    for (size_t j = 0; j < 20; ++j) {
+      auto key = absl::StrCat("A", std::to_string(j));
+      *cnt += 3;
+      ASSERT_TRUE(store_client_
+                      ->AsyncPut("T",
+                                 key,
+                                 std::to_string(i),
+                                 true,
+                                 [i, cnt](auto r) {
+                                   --*cnt;
+                                   ASSERT_EQ(r, i == 0);
+                                 })
+                      .ok());
+      ASSERT_TRUE(store_client_
+                      ->AsyncPut("T",
+                                 key,
+                                 "not written",
+                                 false,
+                                 [cnt](auto r) {
+                                   --*cnt;
+                                   ASSERT_FALSE(r);
+                                 })
+                      .ok());
+      ASSERT_TRUE(store_client_
+                      ->AsyncGet("T",
+                                 key,
+                                 [i, cnt](auto s, auto r) {
+                                   --*cnt;
+                                   ASSERT_TRUE(r.has_value());
+                                   ASSERT_EQ(*r, std::to_string(i));
+                                 })
+                      .ok());
+    }
+  }
+  for (size_t j = 0; j < 20; ++j) {
+    auto key = absl::StrCat("A", std::to_string(j));
+    *cnt += 3;
+    ASSERT_TRUE(store_client_
+                    ->AsyncDelete("T",
+                                  key,
+                                  [cnt](auto r) {
+                                    --*cnt;
+                                    ASSERT_TRUE(r);
+                                  })
+                    .ok());
+    ASSERT_TRUE(store_client_
+                    ->AsyncDelete("T",
+                                  key,
+                                  [cnt](auto r) {
+                                    --*cnt;
+                                    ASSERT_FALSE(r);
+                                  })
+                    .ok());
+    ASSERT_TRUE(store_client_
+                    ->AsyncExists("T",
+                                  key,
+                                  [cnt](auto r) {
+                                    --*cnt;
+                                    ASSERT_FALSE(r);
+                                  })
+                    .ok());
+  }
+  ASSERT_TRUE(WaitForCondition([cnt]() { return *cnt == 0; }, 5000));
+}
+
+TEST_F(RedisStoreClientWriteBatchTest, RunsScriptAfterScriptCacheFlush) {
+  // The first batches load the write batch script, which is run with EVAL again after
+  // Redis forgets it.
+  TestAsyncPutAndAsyncGet();
+  TestSetupUtil::ExecuteRedisCmd(TEST_REDIS_SERVER_PORTS.front(), {"SCRIPT", "FLUSH"});
+  TestAsyncPutAndAsyncGet();
+}
+
+TEST_F(RedisStoreClientWriteBatchTest, WritesOneByOneWithoutScripting) {
+  // Send the writes as one batch.
+  ::RayConfig::instance().gcs_redis_write_batch_window_us() = 1000 * 1000;
+  TestSetupUtil::ExecuteRedisCmd(TEST_REDIS_SERVER_PORTS.front(),
+                                 {"ACL", "SETUSER", "default", "-@scripting"});
+  auto cnt = std::make_shared<std::atomic<size_t>>(0);
+  for (size_t j = 0; j < 10; ++j) {
+    ++*cnt;
+    ASSERT_TRUE(store_client_
+                    ->AsyncPut("T",
+                               absl::StrCat("A", std::to_string(j)),
+                               "written",
+                               true,
+                               [cnt](auto r) {
+                                 --*cnt;
+                                 ASSERT_TRUE(r);
+                               })
+                    .ok());
+  }
+  ASSERT_TRUE(WaitForCondition([cnt]() { return *cnt == 0; }, 10000));
+  TestSetupUtil::ExecuteRedisCmd(TEST_REDIS_SERVER_PORTS.front(),
+                                 {"ACL", "SETUSER", "default", "+@all"});
+  ++*cnt;
+  ASSERT_TRUE(store_client_
+                  ->AsyncGet("T",
+                             "A9",
+                             [cnt](auto status, auto value) {
+                               --*cnt;
+                               ASSERT_EQ(*value, "written");
+                             })
+                  .ok());
+  ASSERT_TRUE(WaitForCondition([cnt]() { return *cnt == 0; }, 5000));
+}
+
+TEST_F(RedisStoreClientWriteBatchTest, SendsBufferedWritesOnDestruction) {
+  ::RayConfig::instance().gcs_redis_write_batch_window_us() = 1000 * 1000;
+  auto cnt = std::make_shared<std::atomic<size_t>>(0);
+  for (size_t j = 0; j < 10; ++j) {
+    ++*cnt;
+    ASSERT_TRUE(store_client_
+                    ->AsyncPut("T",
+                               absl::StrCat("A", std::to_string(j)),
+                               "written",
+                               true,
+                               [cnt](auto r) {
+                                 --*cnt;
+                                 ASSERT_TRUE(r);
+                               })
+                    .ok());
+  }
+  // The replies arrive after the store client is gone.
+  store_client_.reset();
+  ASSERT_TRUE(WaitForCondition([cnt]() { return *cnt == 0; }, 5000));
+  store_client_ = std::make_shared<RedisStoreClient>(redis_client_);
+  TestAsyncPutAndAsyncGet();
+}
+
+TEST_F(RedisStoreClientWriteBatchTest, FailedWritesAreRetried) {
+  // Retry the failed requests until the hash is fixed below.
+  const auto num_redis_request_retries =
+      ::RayConfig::instance().num_redis_request_retries();
+  const auto redis_retry_base_ms = ::RayConfig::instance().redis_retry_base_ms();
+  const auto redis_retry_max_ms = ::RayConfig::instance().redis_retry_max_ms();
+  ::RayConfig::instance().num_redis_request_retries() = 1000;
+  ::RayConfig::instance().redis_retry_base_ms() = 10;
+  ::RayConfig::instance().redis_retry_max_ms() = 100;
+  // Send the writes as one batch.
+  ::RayConfig::instance().gcs_redis_write_batch_window_us() = 1000 * 1000;
+  // Every write of the batch fails while the hash of the namespace is a string.
+  TestSetupUtil::ExecuteRedisCmd(
+      TEST_REDIS_SERVER_PORTS.front(),
+      {"SET", ::RayConfig::instance().external_storage_namespace(), "not a hash"});
+  auto cnt = std::make_shared<std::atomic<size_t>>(0);
+  for (size_t j = 0; j < 10; ++j) {
+    ++*cnt;
+    ASSERT_TRUE(store_client_
+                    ->AsyncPut("T",
+                               absl::StrCat("A", std::to_string(j)),
+                               "written",
+                               true,
+                               [cnt](auto r) {
+                                 --*cnt;
+                                 ASSERT_TRUE(r);
+                               })
+                    .ok());
+  }
+  // The failed writes aren't reported as writes that changed nothing, like unbatched
+  // writes they are retried.
+  std::this_thread::sleep_for(2s);
+  ASSERT_EQ(*cnt, 10);
+  TestSetupUtil::ExecuteRedisCmd(
+      TEST_REDIS_SERVER_PORTS.front(),
+      {"DEL", ::RayConfig::instance().external_storage_namespace()});
+  ASSERT_TRUE(WaitForCondition([cnt]() { return *cnt == 0; }, 5000));
+  for (size_t j = 0; j < 10; ++j) {
+    ++*cnt;
+    ASSERT_TRUE(store_client_
+                    ->AsyncGet("T",
+                               absl::StrCat("A", std::to_string(j)),
+                               [cnt](auto status, auto value) {
+                                 --*cnt;
+                                 ASSERT_EQ(*value, "written");
+                               })
+                    .ok());
+  }
+  ASSERT_TRUE(WaitForCondition([cnt]() { return *cnt == 0; }, 5000));
+  ::RayConfig::instance().num_redis_request_retries() = num_redis_request_retries;
+  ::RayConfig::instance().redis_retry_base_ms() = redis_retry_base_ms;
+  ::RayConfig::instance().redis_retry_max_ms() = redis_retry_max_ms;
+}
+
 TEST_F(RedisStoreClientTest, Random) {
   std::map<std::string, std::string> dict;
   auto counter = std::make_shared<std::atomic<size_t>>(0);
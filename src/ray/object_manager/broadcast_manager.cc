@@ -0,0 +1,81 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/broadcast_manager.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+BroadcastManager::BroadcastManager(
+    int64_t max_fanout, std::function<bool(const NodeID &, const ObjectID &)> is_pushing)
+    : max_fanout_(max_fanout), is_pushing_(std::move(is_pushing)) {
+  RAY_CHECK(max_fanout_ > 0) << max_fanout_;
+}
+
+NodeID BroadcastManager::ForwardPullTo(const ObjectID &object_id,
+                                       const NodeID &node_id) {
+  auto &pushes = pushes_[object_id];
+  RemoveCompletedPushes(object_id, pushes);
+  auto &node_ids = pushes.node_ids;
+  if (std::find(node_ids.begin(), node_ids.end(), node_id) != node_ids.end()) {
+    // A retried pull. Push again, as we would without broadcast.
+    return NodeID::Nil();
+  }
+  if (static_cast<int64_t>(node_ids.size()) < max_fanout_) {
+    node_ids.push_back(node_id);
+    return NodeID::Nil();
+  }
+  const auto &forward_to = node_ids[pushes.next_forward_index++ % node_ids.size()];
+  num_pulls_forwarded_++;
+  RAY_LOG(DEBUG) << "Forwarding pull of " << object_id << " from " << node_id << " to "
+                 << forward_to;
+  return forward_to;
+}
+
+void BroadcastManager::RemoveCompletedPushes(const ObjectID &object_id,
+                                             ObjectPushes &pushes) {
+  auto &node_ids = pushes.node_ids;
+  node_ids.erase(std::remove_if(node_ids.begin(),
+                                node_ids.end(),
+                                [this, &object_id](const NodeID &node_id) {
+                                  return !is_pushing_(node_id, object_id);
+                                }),
+                 node_ids.end());
+}
+
+void BroadcastManager::RemoveCompletedPushes() {
+  for (auto it = pushes_.begin(); it != pushes_.end();) {
+    RemoveCompletedPushes(it->first, it->second);
+    if (it->second.node_ids.empty()) {
+      pushes_.erase(it++);
+    } else {
+      it++;
+    }
+  }
+}
+
+std::string BroadcastManager::DebugString() const {
+  std::stringstream result;
+  result << "BroadcastManager:";
+  result << "\n- num objects being pushed: " << NumObjects();
+  result << "\n- max fanout: " << max_fanout_;
+  result << "\n- num pulls forwarded: " << num_pulls_forwarded_;
+  return result.str();
+}
+
+}  // namespace ray
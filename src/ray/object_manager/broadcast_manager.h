@@ -0,0 +1,87 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "ray/common/id.h"
+
+namespace ray {
+
+/// Spreads the pushes of an object pulled by many nodes at once over a tree.
+///
+/// Without it, every node that pulls an object sends its pull request to one of
+/// the object's locations, which is usually the node that created it, since the
+/// other nodes only become locations once they have received the whole object.
+/// That node then pushes the object to every puller, sharing its bandwidth.
+///
+/// With it, a node pushes an object to at most `max_fanout` nodes at a time. It
+/// forwards the pulls of further nodes to the nodes it is already pushing the
+/// object to, which relay the chunks they have received while still receiving the
+/// rest, and forward further pulls the same way. The pushes of the object form a
+/// tree of degree `max_fanout`, and the object reaches all nodes in about the time
+/// it takes to push it to one node, plus one chunk per level of the tree.
+class BroadcastManager {
+ public:
+  /// Create a broadcast manager.
+  ///
+  /// \param max_fanout The max number of nodes to push an object to at a time.
+  /// \param is_pushing Returns whether the object is still being pushed to a node.
+  BroadcastManager(
+      int64_t max_fanout,
+      std::function<bool(const NodeID &, const ObjectID &)> is_pushing);
+
+  /// Decide where to serve a pull of an object from.
+  ///
+  /// \param object_id The object to push.
+  /// \param node_id The node that pulls the object.
+  /// \return The node to forward the pull to, or nil if this node should push the
+  /// object itself, in which case it's recorded as being pushed to the node.
+  NodeID ForwardPullTo(const ObjectID &object_id, const NodeID &node_id);
+
+  /// Forget the pushes that have completed.
+  void RemoveCompletedPushes();
+
+  /// Return the number of objects being pushed to at least one node.
+  size_t NumObjects() const { return pushes_.size(); }
+
+  std::string DebugString() const;
+
+ private:
+  /// The nodes an object is being pushed to.
+  struct ObjectPushes {
+    std::vector<NodeID> node_ids;
+    /// The index of the next node to forward a pull to, for round-robin.
+    size_t next_forward_index = 0;
+  };
+
+  /// Remove the nodes the object isn't pushed to anymore.
+  void RemoveCompletedPushes(const ObjectID &object_id, ObjectPushes &pushes);
+
+  const int64_t max_fanout_;
+
+  const std::function<bool(const NodeID &, const ObjectID &)> is_pushing_;
+
+  /// The nodes each object is being pushed to by this node.
+  absl::flat_hash_map<ObjectID, ObjectPushes> pushes_;
+
+  /// The number of pulls forwarded to other nodes.
+  int64_t num_pulls_forwarded_ = 0;
+};
+
+}  // namespace ray
@@ -121,6 +121,19 @@ void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
                                   uint64_t metadata_size,
                                   const uint64_t chunk_index,
                                   const std::string &data) {
+  const absl::string_view data_pieces[] = {data};
+  WriteChunk(object_id, data_size, metadata_size, chunk_index, data_pieces);
+}
+
+void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
+                                  uint64_t data_size,
+                                  uint64_t metadata_size,
+                                  const uint64_t chunk_index,
+                                  absl::Span<const absl::string_view> data_pieces) {
+  uint64_t chunk_data_size = 0;
+  for (const auto &piece : data_pieces) {
+    chunk_data_size += piece.size();
+  }
   std::optional<ObjectBufferPool::ChunkInfo> chunk_info;
   {
     absl::MutexLock lock(&pool_mutex_);
@@ -139,8 +152,8 @@ void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
     RAY_CHECK(it->second.chunk_info.size() > chunk_index);
 
     chunk_info = it->second.chunk_info.at(chunk_index);
-    RAY_CHECK(data.size() == chunk_info->buffer_length)
-        << "size mismatch!  data size: " << data.size()
+    RAY_CHECK(chunk_data_size == chunk_info->buffer_length)
+        << "size mismatch!  data size: " << chunk_data_size
         << " chunk size: " << chunk_info->buffer_length;
 
     // Update the state from REFERENCED To SEALED before releasing the lock to ensure
@@ -154,7 +167,11 @@ void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
   RAY_CHECK(chunk_info.has_value()) << "chunk_info is not set";
   // The num_inflight_copies is used to ensure that another thread cannot call Release
   // on the object_id, which makes the unguarded copy call safe.
-  std::memcpy(chunk_info->data, data.data(), chunk_info->buffer_length);
+  uint8_t *output = chunk_info->data;
+  for (const auto &piece : data_pieces) {
+    std::memcpy(output, piece.data(), piece.size());
+    output += piece.size();
+  }
 
   {
     // Ensure the process of object_id Seal and Release is mutex guarded.
@@ -164,11 +181,16 @@ void ObjectBufferPool::WriteChunk(const ObjectID &object_id,
     RAY_CHECK(it != create_buffer_state_.end());
     // Decrement the number of inflight copies to ensure Abort can release the buffer.
     it->second.num_inflight_copies--;
+    it->second.chunk_written[chunk_index] = true;
     it->second.num_seals_remaining--;
     if (it->second.num_seals_remaining == 0) {
       RAY_CHECK_OK(store_client_->Seal(object_id));
-      RAY_CHECK_OK(store_client_->Release(object_id));
-      create_buffer_state_.erase(it);
+      it->second.sealed = true;
+      // The buffer stays referenced until the reads copying out of it finish.
+      if (it->second.num_inflight_reads == 0) {
+        RAY_CHECK_OK(store_client_->Release(object_id));
+        create_buffer_state_.erase(it);
+      }
       RAY_LOG(DEBUG) << "Have received all chunks for object " << object_id
                      << ", last chunk index: " << chunk_index;
     }
@@ -184,7 +206,8 @@ void ObjectBufferPool::AbortCreateInternal(const ObjectID &object_id) {
   auto no_copy_inflight = [this, object_id]() {
     pool_mutex_.AssertReaderHeld();
     auto it = create_buffer_state_.find(object_id);
-    return it == create_buffer_state_.end() || it->second.num_inflight_copies == 0;
+    return it == create_buffer_state_.end() || (it->second.num_inflight_copies == 0 &&
+                                                it->second.num_inflight_reads == 0);
   };
 
   pool_mutex_.Await(absl::Condition(&no_copy_inflight));
@@ -314,6 +337,7 @@ ray::Status ObjectBufferPool::EnsureBufferExists(const ObjectID &object_id,
       std::forward_as_tuple(object_id),
       std::forward_as_tuple(metadata_size,
                             data_size,
+                            owner_address,
                             BuildChunks(object_id, mutable_data, data_size, data)));
   RAY_CHECK(inserted.first->second.chunk_info.size() == num_chunks);
   RAY_LOG(DEBUG) << "Created object " << object_id
@@ -323,6 +347,77 @@ ray::Status ObjectBufferPool::EnsureBufferExists(const ObjectID &object_id,
   return ray::Status::OK();
 }
 
+bool ObjectBufferPool::GetReceivingObject(const ObjectID &object_id,
+                                          uint64_t *data_size,
+                                          uint64_t *metadata_size,
+                                          rpc::Address *owner_address) const {
+  absl::MutexLock lock(&pool_mutex_);
+  auto it = create_buffer_state_.find(object_id);
+  if (it == create_buffer_state_.end()) {
+    return false;
+  }
+  *data_size = it->second.data_size;
+  *metadata_size = it->second.metadata_size;
+  *owner_address = it->second.owner_address;
+  return true;
+}
+
+bool ObjectBufferPool::IsChunkReceived(const ObjectID &object_id,
+                                       uint64_t chunk_index) const {
+  absl::MutexLock lock(&pool_mutex_);
+  auto it = create_buffer_state_.find(object_id);
+  return it != create_buffer_state_.end() &&
+         chunk_index < it->second.chunk_written.size() &&
+         it->second.chunk_written[chunk_index];
+}
+
+bool ObjectBufferPool::ReadReceivedData(const ObjectID &object_id,
+                                        uint64_t offset,
+                                        uint64_t size,
+                                        char *output) {
+  // The ranges of the chunks to copy. The buffer is pinned by num_inflight_reads while
+  // they are copied outside the lock: once the last chunk is written, the buffer is
+  // sealed, and released by the last inflight read.
+  std::vector<std::pair<const uint8_t *, uint64_t>> ranges;
+  {
+    absl::MutexLock lock(&pool_mutex_);
+    auto it = create_buffer_state_.find(object_id);
+    if (it == create_buffer_state_.end() || offset + size > it->second.data_size) {
+      return false;
+    }
+    auto &state = it->second;
+    while (size > 0) {
+      uint64_t chunk_index = offset / default_chunk_size_;
+      if (!state.chunk_written[chunk_index]) {
+        return false;
+      }
+      const auto &chunk = state.chunk_info[chunk_index];
+      uint64_t chunk_offset = offset - chunk_index * default_chunk_size_;
+      uint64_t copy_size = std::min(size, chunk.buffer_length - chunk_offset);
+      ranges.emplace_back(chunk.data + chunk_offset, copy_size);
+      offset += copy_size;
+      size -= copy_size;
+    }
+    state.num_inflight_reads++;
+  }
+
+  for (const auto &[data, copy_size] : ranges) {
+    std::memcpy(output, data, copy_size);
+    output += copy_size;
+  }
+
+  absl::MutexLock lock(&pool_mutex_);
+  auto it = create_buffer_state_.find(object_id);
+  // Neither Abort nor the last WriteChunk erase the state during inflight reads.
+  RAY_CHECK(it != create_buffer_state_.end());
+  it->second.num_inflight_reads--;
+  if (it->second.sealed && it->second.num_inflight_reads == 0) {
+    RAY_CHECK_OK(store_client_->Release(object_id));
+    create_buffer_state_.erase(it);
+  }
+  return true;
+}
+
 void ObjectBufferPool::FreeObjects(const std::vector<ObjectID> &object_ids) {
   absl::MutexLock lock(&pool_mutex_);
   RAY_CHECK_OK(store_client_->Delete(object_ids));
@@ -23,7 +23,9 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "ray/common/id.h"
 #include "ray/common/status.h"
 #include "ray/object_manager/memory_object_reader.h"
@@ -131,6 +133,51 @@ class ObjectBufferPool {
                   uint64_t chunk_index,
                   const std::string &data) ABSL_LOCKS_EXCLUDED(pool_mutex_);
 
+  /// Same as above, but the data to write is given as a sequence of pieces that are
+  /// copied one after the other into the chunk. This allows writing a chunk straight
+  /// from the buffers it was received in, see `PushRequestReader`.
+  ///
+  /// \param object_id The ObjectID.
+  /// \param chunk_index The index of the chunk.
+  /// \param data_pieces The data to write into the chunk, in order.
+  void WriteChunk(const ObjectID &object_id,
+                  uint64_t data_size,
+                  uint64_t metadata_size,
+                  uint64_t chunk_index,
+                  absl::Span<const absl::string_view> data_pieces)
+      ABSL_LOCKS_EXCLUDED(pool_mutex_);
+
+  /// Get the sizes and the owner of an object that is being received, i.e. of
+  /// which some chunks may have been written but that isn't sealed yet.
+  ///
+  /// \param object_id The ObjectID.
+  /// \return Whether the object is being received. The other outputs are only set
+  /// if it is.
+  bool GetReceivingObject(const ObjectID &object_id,
+                          uint64_t *data_size,
+                          uint64_t *metadata_size,
+                          rpc::Address *owner_address) const
+      ABSL_LOCKS_EXCLUDED(pool_mutex_);
+
+  /// Whether a chunk of an object that is being received has been written.
+  bool IsChunkReceived(const ObjectID &object_id, uint64_t chunk_index) const
+      ABSL_LOCKS_EXCLUDED(pool_mutex_);
+
+  /// Copy a range of an object that is being received, so that the object can be
+  /// forwarded to other nodes before it's fully received. The range is in the
+  /// object data followed by the metadata, the way chunks are laid out.
+  ///
+  /// \param object_id The ObjectID.
+  /// \param offset The offset of the range.
+  /// \param size The size of the range.
+  /// \param output The buffer to copy the range to.
+  /// \return False if the object isn't being received anymore, or if some chunks of
+  /// the range haven't been written yet.
+  bool ReadReceivedData(const ObjectID &object_id,
+                        uint64_t offset,
+                        uint64_t size,
+                        char *output) ABSL_LOCKS_EXCLUDED(pool_mutex_);
+
   /// Free a list of objects from object store.
   ///
   /// \param object_ids the The list of ObjectIDs to be deleted.
@@ -177,26 +224,40 @@ class ObjectBufferPool {
   struct CreateBufferState {
     CreateBufferState(uint64_t metadata_size,
                       uint64_t data_size,
+                      rpc::Address owner_address,
                       std::vector<ChunkInfo> chunk_info)
         : metadata_size(metadata_size),
           data_size(data_size),
+          owner_address(std::move(owner_address)),
           chunk_info(chunk_info),
           chunk_state(chunk_info.size(), CreateChunkState::AVAILABLE),
+          chunk_written(chunk_info.size(), false),
           num_seals_remaining(chunk_info.size()) {}
     /// Total size of the object metadata.
     uint64_t metadata_size;
     /// Total size of the object data.
     uint64_t data_size;
+    /// The address of the object's owner.
+    rpc::Address owner_address;
     /// A vector maintaining information about the chunks which comprise
     /// an object.
     std::vector<ChunkInfo> chunk_info;
     /// The state of each chunk, which is used to enforce strict state
     /// transitions of each chunk.
     std::vector<CreateChunkState> chunk_state;
+    /// Whether the copy of each chunk into the buffer has completed. A chunk is
+    /// SEALED as soon as its copy starts.
+    std::vector<bool> chunk_written;
     /// The number of chunks left to seal before the buffer is sealed.
     uint64_t num_seals_remaining;
     /// The number of inflight copy operations.
     uint64_t num_inflight_copies = 0;
+    /// The number of inflight ReadReceivedData copies out of the buffer. The buffer
+    /// isn't released or aborted while there are any.
+    uint64_t num_inflight_reads = 0;
+    /// Whether every chunk was written and the object was sealed. The buffer is released
+    /// once the inflight reads finish.
+    bool sealed = false;
   };
 
   /// Returned when GetChunk or CreateChunk fails.
@@ -107,13 +107,57 @@ ObjectManager::ObjectManager(
           main_service, ClusterID::Nil(), config_.rpc_service_threads_number),
       restore_spilled_object_(restore_spilled_object),
       get_spilled_object_url_(get_spilled_object_url),
+      spilled_object_file_cache_(
+          config_.max_cached_spilled_files > 0
+              ? std::make_shared<SpilledObjectFileCache>(config_.max_cached_spilled_files)
+              : nullptr),
       pull_retry_timer_(*main_service_,
                         boost::posix_time::milliseconds(config.timer_freq_ms)) {
   RAY_CHECK(config_.rpc_service_threads_number > 0);
 
-  push_manager_.reset(new PushManager(/* max_chunks_in_flight= */ std::max(
-      static_cast<int64_t>(1L),
-      static_cast<int64_t>(config_.max_bytes_in_flight / config_.object_chunk_size))));
+  push_manager_.reset(new PushManager(
+      /* max_chunks_in_flight= */ std::max(
+          static_cast<int64_t>(1L),
+          static_cast<int64_t>(config_.max_bytes_in_flight / config_.object_chunk_size)),
+      config_.push_adaptive_scheduling));
+  if (config_.broadcast_max_fanout > 0) {
+    relay_manager_ = std::make_unique<RelayManager>(
+        config_.broadcast_max_fanout,
+        config_.object_chunk_size,
+        config_.push_timeout_ms,
+        buffer_pool_,
+        *push_manager_,
+        [this](const ObjectID &object_id) {
+          return local_objects_.count(object_id) != 0;
+        },
+        [this](const ObjectID &object_id,
+               const NodeID &node_id,
+               const NodeID &requester_id) {
+          SendPullRequest(object_id, node_id, requester_id);
+        },
+        [this](const UniqueID &push_id,
+               const ObjectID &object_id,
+               const NodeID &node_id,
+               uint64_t chunk_index,
+               std::shared_ptr<ChunkObjectReader> chunk_reader) {
+          auto rpc_client = GetRpcClient(node_id);
+          if (!rpc_client) {
+            // Push is best effort, so just complete the chunk.
+            RAY_LOG(INFO)
+                << "Failed to establish connection for Push with remote object manager.";
+            push_manager_->OnChunkComplete(
+                node_id, object_id, Status::IOError("No connection to the node"));
+            return;
+          }
+          SendObjectChunkAsync(push_id,
+                               object_id,
+                               node_id,
+                               chunk_index,
+                               std::move(rpc_client),
+                               std::move(chunk_reader),
+                               /*from_disk=*/false);
+        });
+  }
 
   pull_retry_timer_.async_wait([this](const boost::system::error_code &e) { Tick(e); });
 
@@ -165,6 +209,12 @@ bool ObjectManager::IsPlasmaObjectSpillable(const ObjectID &object_id) {
   return plasma::plasma_store_runner->IsPlasmaObjectSpillable(object_id);
 }
 
+void ObjectManager::EvictSpilledObjectFile(const std::string &file_path) {
+  if (spilled_object_file_cache_ != nullptr) {
+    spilled_object_file_cache_->Evict(file_path);
+  }
+}
+
 void ObjectManager::RunRpcService(int index) {
   SetThreadName("rpc.obj.mgr." + std::to_string(index));
   rpc_service_.run();
@@ -214,6 +264,11 @@ void ObjectManager::HandleObjectAdded(const ObjectInfo &object_info) {
     }
     unfulfilled_push_requests_.erase(iter);
   }
+
+  if (relay_manager_ != nullptr) {
+    // Relay the chunks that were waiting for the object to be sealed.
+    HandleObjectChunkReceived(object_id);
+  }
 }
 
 void ObjectManager::HandleObjectDeleted(const ObjectID &object_id) {
@@ -271,15 +326,34 @@ void ObjectManager::CancelPull(uint64_t request_id) {
   }
 }
 
+bool ObjectManager::GetObjectLocations(const ObjectID &object_id,
+                                       std::vector<NodeID> *node_ids,
+                                       int64_t *object_size) const {
+  auto it = local_objects_.find(object_id);
+  if (it != local_objects_.end()) {
+    const auto &object_info = it->second.object_info;
+    *node_ids = {self_node_id_};
+    *object_size = object_info.data_size + object_info.metadata_size;
+    return true;
+  }
+  return pull_manager_->GetObjectLocations(object_id, node_ids, object_size);
+}
+
 void ObjectManager::SendPullRequest(const ObjectID &object_id, const NodeID &client_id) {
+  SendPullRequest(object_id, client_id, self_node_id_);
+}
+
+void ObjectManager::SendPullRequest(const ObjectID &object_id,
+                                    const NodeID &client_id,
+                                    const NodeID &requester_id) {
   auto rpc_client = GetRpcClient(client_id);
   if (rpc_client) {
     // Try pulling from the client.
     rpc_service_.post(
-        [this, object_id, client_id, rpc_client]() {
+        [this, object_id, client_id, requester_id, rpc_client]() {
           rpc::PullRequest pull_request;
           pull_request.set_object_id(object_id.Binary());
-          pull_request.set_node_id(self_node_id_.Binary());
+          pull_request.set_node_id(requester_id.Binary());
 
           rpc_client->Pull(
               pull_request,
@@ -340,6 +414,9 @@ void ObjectManager::Push(const ObjectID &object_id, const NodeID &node_id) {
   RAY_LOG(DEBUG) << "Push on " << self_node_id_ << " to " << node_id << " of object "
                  << object_id;
   if (local_objects_.count(object_id) != 0) {
+    if (relay_manager_ != nullptr && relay_manager_->ForwardPull(object_id, node_id)) {
+      return;
+    }
     return PushLocalObject(object_id, node_id);
   }
 
@@ -349,6 +426,12 @@ void ObjectManager::Push(const ObjectID &object_id, const NodeID &node_id) {
     return PushFromFilesystem(object_id, node_id, object_url);
   }
 
+  // Relay the object as it's received if this node is receiving it.
+  if (relay_manager_ != nullptr &&
+      relay_manager_->RelayReceivingObject(object_id, node_id)) {
+    return;
+  }
+
   // Avoid setting duplicated timer for the same object and node pair.
   auto &nodes = unfulfilled_push_requests_[object_id];
 
@@ -431,8 +514,8 @@ void ObjectManager::PushFromFilesystem(const ObjectID &object_id,
   // main thread.
   rpc_service_.post(
       [this, object_id, node_id, spilled_url, chunk_size = config_.object_chunk_size]() {
-        auto optional_spilled_object =
-            SpilledObjectReader::CreateSpilledObjectReader(spilled_url);
+        auto optional_spilled_object = SpilledObjectReader::CreateSpilledObjectReader(
+            spilled_url, spilled_object_file_cache_);
         if (!optional_spilled_object.has_value()) {
           RAY_LOG_EVERY_N_OR_DEBUG(INFO, 100)
               << "Ignoring stale read request for already deleted object: " << object_id;
@@ -479,30 +562,64 @@ void ObjectManager::PushObjectInternal(const ObjectID &object_id,
   auto push_id = UniqueID::FromRandom();
   push_manager_->StartPush(
       node_id, object_id, chunk_reader->GetNumChunks(), [=](int64_t chunk_id) {
-        rpc_service_.post(
-            [=]() {
-              // Post to the multithreaded RPC event loop so that data is copied
-              // off of the main thread.
-              SendObjectChunk(
-                  push_id,
-                  object_id,
-                  node_id,
-                  chunk_id,
-                  rpc_client,
-                  [=](const Status &status) {
-                    // Post back to the main event loop because the
-                    // PushManager is not thread-safe.
-                    main_service_->post(
-                        [this, node_id, object_id]() {
-                          push_manager_->OnChunkComplete(node_id, object_id);
-                        },
-                        "ObjectManager.Push");
+        SendObjectChunkAsync(
+            push_id, object_id, node_id, chunk_id, rpc_client, chunk_reader, from_disk);
+      });
+}
+
+void ObjectManager::HandleObjectChunkReceived(const ObjectID &object_id) {
+  // Start relaying the object to the nodes that pulled it before this node started
+  // receiving it.
+  auto push_requests = unfulfilled_push_requests_.find(object_id);
+  if (push_requests != unfulfilled_push_requests_.end() &&
+      local_objects_.count(object_id) == 0) {
+    std::vector<NodeID> node_ids;
+    for (auto &pair : push_requests->second) {
+      node_ids.push_back(pair.first);
+      if (pair.second != nullptr) {
+        pair.second->cancel();
+      }
+    }
+    unfulfilled_push_requests_.erase(push_requests);
+    for (const auto &node_id : node_ids) {
+      Push(object_id, node_id);
+    }
+  }
+
+  relay_manager_->HandleObjectChunkReceived(object_id);
+}
+
+void ObjectManager::SendObjectChunkAsync(
+    const UniqueID &push_id,
+    const ObjectID &object_id,
+    const NodeID &node_id,
+    uint64_t chunk_index,
+    std::shared_ptr<rpc::ObjectManagerClient> rpc_client,
+    std::shared_ptr<ChunkObjectReader> chunk_reader,
+    bool from_disk) {
+  rpc_service_.post(
+      [=]() {
+        // Post to the multithreaded RPC event loop so that data is copied
+        // off of the main thread.
+        SendObjectChunk(
+            push_id,
+            object_id,
+            node_id,
+            chunk_index,
+            rpc_client,
+            [=](const Status &status) {
+              // Post back to the main event loop because the
+              // PushManager is not thread-safe.
+              main_service_->post(
+                  [this, node_id, object_id, status]() {
+                    push_manager_->OnChunkComplete(node_id, object_id, status);
                   },
-                  chunk_reader,
-                  from_disk);
+                  "ObjectManager.Push");
             },
-            "ObjectManager.Push");
-      });
+            chunk_reader,
+            from_disk);
+      },
+      "ObjectManager.Push");
 }
 
 void ObjectManager::SendObjectChunk(const UniqueID &push_id,
@@ -559,21 +676,37 @@ void ObjectManager::SendObjectChunk(const UniqueID &push_id,
 }
 
 /// Implementation of ObjectManagerServiceHandler
-void ObjectManager::HandlePush(rpc::PushRequest request,
-                               rpc::PushReply *reply,
+void ObjectManager::HandlePush(grpc::ByteBuffer request,
+                               grpc::ByteBuffer *reply,
                                rpc::SendReplyCallback send_reply_callback) {
-  ObjectID object_id = ObjectID::FromBinary(request.object_id());
-  NodeID node_id = NodeID::FromBinary(request.node_id());
+  grpc::Slice serialized_reply(rpc::PushReply().SerializeAsString());
+  *reply = grpc::ByteBuffer(&serialized_reply, 1);
+
+  // Parse the request without copying the chunk data out of the received buffer.
+  auto push_request = PushRequestReader::Parse(request);
+  if (push_request == nullptr) {
+    RAY_LOG(WARNING) << "Failed to parse a push request, dropping the chunk.";
+    send_reply_callback(Status::Invalid("Malformed push request"), nullptr, nullptr);
+    return;
+  }
+  const rpc::PushRequest &header = push_request->Header();
+  ObjectID object_id = ObjectID::FromBinary(header.object_id());
+  NodeID node_id = NodeID::FromBinary(header.node_id());
 
   // Serialize.
-  uint64_t chunk_index = request.chunk_index();
-  uint64_t metadata_size = request.metadata_size();
-  uint64_t data_size = request.data_size();
-  const rpc::Address &owner_address = request.owner_address();
-  const std::string &data = request.data();
-
-  bool success = ReceiveObjectChunk(
-      node_id, object_id, owner_address, data_size, metadata_size, chunk_index, data);
+  uint64_t chunk_index = header.chunk_index();
+  uint64_t metadata_size = header.metadata_size();
+  uint64_t data_size = header.data_size();
+  const rpc::Address &owner_address = header.owner_address();
+
+  bool success = ReceiveObjectChunk(node_id,
+                                    object_id,
+                                    owner_address,
+                                    data_size,
+                                    metadata_size,
+                                    chunk_index,
+                                    push_request->Data(),
+                                    push_request->DataSize());
   num_chunks_received_total_++;
   if (!success) {
     num_chunks_received_total_failed_++;
@@ -592,11 +725,12 @@ bool ObjectManager::ReceiveObjectChunk(const NodeID &node_id,
                                        uint64_t data_size,
                                        uint64_t metadata_size,
                                        uint64_t chunk_index,
-                                       const std::string &data) {
-  num_bytes_received_total_ += data.size();
+                                       absl::Span<const absl::string_view> data,
+                                       uint64_t chunk_data_size) {
+  num_bytes_received_total_ += chunk_data_size;
   RAY_LOG(DEBUG) << "ReceiveObjectChunk on " << self_node_id_ << " from " << node_id
                  << " of object " << object_id << " chunk index: " << chunk_index
-                 << ", chunk data size: " << data.size()
+                 << ", chunk data size: " << chunk_data_size
                  << ", object size: " << data_size;
 
   if (!pull_manager_->IsObjectActive(object_id)) {
@@ -621,6 +755,10 @@ bool ObjectManager::ReceiveObjectChunk(const NodeID &node_id,
   if (chunk_status.ok()) {
     // Avoid handling this chunk if it's already being handled by another process.
     buffer_pool_.WriteChunk(object_id, data_size, metadata_size, chunk_index, data);
+    if (relay_manager_ != nullptr) {
+      main_service_->post([this, object_id]() { HandleObjectChunkReceived(object_id); },
+                          "ObjectManager.ObjectChunkReceived");
+    }
     return true;
   } else {
     num_chunks_received_failed_due_to_plasma_++;
@@ -731,6 +869,12 @@ std::string ObjectManager::DebugString() const {
          << num_chunks_received_cancelled_;
   result << "\n- num chunks received failed / plasma error: "
          << num_chunks_received_failed_due_to_plasma_;
+  if (spilled_object_file_cache_ != nullptr) {
+    result << "\n" << spilled_object_file_cache_->DebugString();
+  }
+  if (relay_manager_ != nullptr) {
+    result << "\n" << relay_manager_->DebugString();
+  }
   result << "\nEvent stats:" << rpc_service_.stats().StatsString();
   result << "\n" << push_manager_->DebugString();
   result << "\n" << object_directory_->DebugString();
@@ -761,6 +905,16 @@ void ObjectManager::RecordMetrics() {
   ray::stats::STATS_object_manager_bytes.Record(num_bytes_pushed_from_disk_,
                                                 "PushedFromLocalDisk");
   ray::stats::STATS_object_manager_bytes.Record(num_bytes_received_total_, "Received");
+  if (spilled_object_file_cache_ != nullptr) {
+    ray::stats::STATS_object_manager_spilled_file_cache.Record(
+        spilled_object_file_cache_->NumHits(), "Hits");
+    ray::stats::STATS_object_manager_spilled_file_cache.Record(
+        spilled_object_file_cache_->NumMisses(), "Misses");
+    ray::stats::STATS_object_manager_spilled_file_cache.Record(
+        spilled_object_file_cache_->NumBytesRead(), "BytesRead");
+    ray::stats::STATS_object_manager_spilled_file_cache.Record(
+        spilled_object_file_cache_->NumOpenFiles(), "OpenFiles");
+  }
 
   ray::stats::STATS_object_manager_received_chunks.Record(num_chunks_received_total_,
                                                           "Total");
@@ -804,6 +958,10 @@ void ObjectManager::Tick(const boost::system::error_code &e) {
 
   pull_manager_->Tick();
 
+  if (relay_manager_ != nullptr) {
+    relay_manager_->Tick();
+  }
+
   auto interval = boost::posix_time::milliseconds(config_.timer_freq_ms);
   pull_retry_timer_.expires_from_now(interval);
   pull_retry_timer_.async_wait([this](const boost::system::error_code &e) { Tick(e); });
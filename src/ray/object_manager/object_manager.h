@@ -40,7 +40,10 @@
 #include "ray/object_manager/ownership_based_object_directory.h"
 #include "ray/object_manager/plasma/store_runner.h"
 #include "ray/object_manager/pull_manager.h"
+#include "ray/object_manager/push_request_reader.h"
 #include "ray/object_manager/push_manager.h"
+#include "ray/object_manager/relay_manager.h"
+#include "ray/object_manager/spilled_object_file_cache.h"
 #include "ray/rpc/object_manager/object_manager_client.h"
 #include "ray/rpc/object_manager/object_manager_server.h"
 #include "src/ray/protobuf/common.pb.h"
@@ -82,6 +85,16 @@ struct ObjectManagerConfig {
   std::string fallback_directory;
   /// Enable huge pages.
   bool huge_pages;
+  /// The maximum number of spilled files to keep open for pushing spilled
+  /// objects. 0 means spilled files are opened on every chunk read.
+  uint64_t max_cached_spilled_files = 0;
+  /// Whether pushes get an adaptive window per destination and are fairly queued
+  /// across destinations, instead of only sharing max_bytes_in_flight.
+  bool push_adaptive_scheduling = false;
+  /// The max number of nodes to push an object to at a time. Pulls from further
+  /// nodes are forwarded to these nodes, which relay the chunks they receive. 0
+  /// disables it, and pulls are always served by the node they are sent to.
+  int64_t broadcast_max_fanout = 0;
 };
 
 struct LocalObjectInfo {
@@ -124,11 +137,11 @@ class ObjectManager : public ObjectManagerInterface,
   /// Push request will contain the object which is specified by pull request
   /// the object will be transfered by a sequence of chunks.
   ///
-  /// \param request Push request including the object chunk data
-  /// \param reply Reply to the sender
+  /// \param request Serialized push request including the object chunk data
+  /// \param reply Serialized reply to the sender
   /// \param send_reply_callback Callback of the request
-  void HandlePush(rpc::PushRequest request,
-                  rpc::PushReply *reply,
+  void HandlePush(grpc::ByteBuffer request,
+                  grpc::ByteBuffer *reply,
                   rpc::SendReplyCallback send_reply_callback) override;
 
   /// Handle pull request from remote object manager
@@ -229,6 +242,12 @@ class ObjectManager : public ObjectManagerInterface,
   ///                   or send it to all the object stores.
   void FreeObjects(const std::vector<ObjectID> &object_ids, bool local_only);
 
+  /// Close the cached handle of a spilled file that is being deleted, so its disk
+  /// space is released once the file is deleted.
+  ///
+  /// \param file_path The path of the spilled file.
+  void EvictSpilledObjectFile(const std::string &file_path);
+
   /// Returns debug string for class.
   ///
   /// \return string.
@@ -255,6 +274,18 @@ class ObjectManager : public ObjectManagerInterface,
 
   bool PullManagerHasPullsQueued() const { return pull_manager_->HasPullsQueued(); }
 
+  /// Get the nodes known to hold a copy of an object and the size of the object. This
+  /// is only known for the objects in the local object store and the objects being
+  /// pulled.
+  ///
+  /// \param object_id The object ID.
+  /// \param[out] node_ids The nodes known to hold a copy of the object.
+  /// \param[out] object_size The size of the object.
+  /// \return Whether the locations of the object are known.
+  bool GetObjectLocations(const ObjectID &object_id,
+                          std::vector<NodeID> *node_ids,
+                          int64_t *object_size) const;
+
  private:
   friend class TestObjectManager;
 
@@ -294,6 +325,20 @@ class ObjectManager : public ObjectManagerInterface,
                           std::shared_ptr<ChunkObjectReader> chunk_reader,
                           bool from_disk);
 
+  /// Handle a chunk of an object received from a remote node, or the object being
+  /// sealed, to relay the object to the nodes that pulled it from this node.
+  void HandleObjectChunkReceived(const ObjectID &object_id);
+
+  /// Send a chunk of the object to a remote object manager from the rpc threads,
+  /// and notify the push manager from the main thread once it has been sent.
+  void SendObjectChunkAsync(const UniqueID &push_id,
+                            const ObjectID &object_id,
+                            const NodeID &node_id,
+                            uint64_t chunk_index,
+                            std::shared_ptr<rpc::ObjectManagerClient> rpc_client,
+                            std::shared_ptr<ChunkObjectReader> chunk_reader,
+                            bool from_disk);
+
   /// Send one chunk of the object to remote object manager
   ///
   /// Object will be transfered as a sequence of chunks, small object(defined in config)
@@ -369,7 +414,8 @@ class ObjectManager : public ObjectManagerInterface,
   /// \param data_size Data size
   /// \param metadata_size Metadata size
   /// \param chunk_index Chunk index
-  /// \param data Chunk data
+  /// \param data Chunk data, as views into the received request
+  /// \param chunk_data_size Total size of the chunk data
   /// \return Whether the chunk was successfully written into the local object
   /// store. This can fail if the chunk was already received in the past, or if
   /// the object is no longer being actively pulled.
@@ -379,7 +425,8 @@ class ObjectManager : public ObjectManagerInterface,
                           uint64_t data_size,
                           uint64_t metadata_size,
                           uint64_t chunk_index,
-                          const std::string &data);
+                          absl::Span<const absl::string_view> data,
+                          uint64_t chunk_data_size);
 
   /// Send pull request
   ///
@@ -387,6 +434,15 @@ class ObjectManager : public ObjectManagerInterface,
   /// \param client_id Remote server client id
   void SendPullRequest(const ObjectID &object_id, const NodeID &client_id);
 
+  /// Send pull request on behalf of another node, which the object is pushed to.
+  ///
+  /// \param object_id Object id
+  /// \param client_id Remote server client id
+  /// \param requester_id The node the object should be pushed to
+  void SendPullRequest(const ObjectID &object_id,
+                       const NodeID &client_id,
+                       const NodeID &requester_id);
+
   /// Get the rpc client according to the node ID
   ///
   /// \param node_id Remote node id, will send rpc request to it
@@ -457,12 +513,20 @@ class ObjectManager : public ObjectManagerInterface,
   /// This returns the empty string if the object was not spilled locally.
   std::function<std::string(const ObjectID &)> get_spilled_object_url_;
 
+  /// Open file handles of spilled files, shared by all spilled object readers.
+  /// This is nullptr if max_cached_spilled_files is 0.
+  std::shared_ptr<SpilledObjectFileCache> spilled_object_file_cache_;
+
   /// Pull manager retry timer .
   boost::asio::deadline_timer pull_retry_timer_;
 
   /// Object push manager.
   std::unique_ptr<PushManager> push_manager_;
 
+  /// Forwards pulls and relays the objects being received to broadcast objects
+  /// over a tree. This is nullptr if broadcast_max_fanout is 0.
+  std::unique_ptr<RelayManager> relay_manager_;
+
   /// Object pull manager.
   std::unique_ptr<PullManager> pull_manager_;
 
@@ -19,6 +19,7 @@
 #include "absl/types/optional.h"
 #include "ray/object_manager/plasma/common.h"
 #include "ray/object_manager/plasma/compat.h"
+#include "ray/object_manager/plasma/slab_allocator.h"
 
 namespace plasma {
 
@@ -59,6 +60,13 @@ class IAllocator {
 
   /// Get the number of bytes fallback allocated so far.
   virtual int64_t FallbackAllocated() const = 0;
+
+  /// Get the memory held by the slab allocator small objects are allocated from.
+  ///
+  /// \return the stats, or empty if objects aren't allocated from slabs.
+  virtual absl::optional<SlabAllocatorStats> GetSlabAllocatorStats() const {
+    return absl::nullopt;
+  }
 };
 
 }  // namespace plasma
@@ -121,6 +121,11 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
                                 fb::ObjectSource source,
                                 int device_num = 0);
 
+  Status CreateBatchAndSpillIfNeeded(const std::vector<ObjectCreateSpec> &objects,
+                                     const ray::rpc::Address &owner_address,
+                                     std::vector<std::shared_ptr<Buffer>> *data,
+                                     fb::ObjectSource source);
+
   Status RetryCreate(const ObjectID &object_id,
                      uint64_t request_id,
                      bool is_experimental_mutable_object,
@@ -159,6 +164,8 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
 
   Status Seal(const ObjectID &object_id);
 
+  Status SealBatch(const std::vector<ObjectID> &object_ids);
+
   Status Delete(const std::vector<ObjectID> &object_ids);
 
   Status Evict(int64_t num_bytes, int64_t &num_bytes_evicted);
@@ -172,6 +179,10 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
   int64_t store_capacity() { return store_capacity_; }
 
  private:
+  /// Switch the connection to the shared memory transport of the store, if the
+  /// store supports it.
+  Status ConnectSharedMemoryTransport();
+
   /// Helper method to read and process the reply of a create request.
   Status HandleCreateReply(const ObjectID &object_id,
                            bool is_experimental_mutable_object,
@@ -179,6 +190,11 @@ class PlasmaClient::Impl : public std::enable_shared_from_this<PlasmaClient::Imp
                            uint64_t *retry_with_request_id,
                            std::shared_ptr<Buffer> *data);
 
+  /// Helper method to read and process the reply of a batched create request.
+  Status HandleCreateBatchReply(const std::vector<ObjectCreateSpec> &objects,
+                                uint64_t *retry_with_request_id,
+                                std::vector<std::shared_ptr<Buffer>> *data);
+
   /// Check if store_fd has already been received from the store. If yes,
   /// return it. Otherwise, receive it from the store (see analogous logic
   /// in store.cc).
@@ -438,6 +454,110 @@ Status PlasmaClient::Impl::CreateAndSpillIfNeeded(const ObjectID &object_id,
   return status;
 }
 
+Status PlasmaClient::Impl::HandleCreateBatchReply(
+    const std::vector<ObjectCreateSpec> &objects,
+    uint64_t *retry_with_request_id,
+    std::vector<std::shared_ptr<Buffer>> *data) {
+  std::vector<uint8_t> buffer;
+  RAY_RETURN_NOT_OK(
+      PlasmaReceive(store_conn_, MessageType::PlasmaCreateBatchReply, &buffer));
+  std::vector<ObjectID> object_ids;
+  std::vector<PlasmaObject> plasma_objects;
+  std::vector<MEMFD_TYPE> store_fds;
+  std::vector<int64_t> mmap_sizes;
+  RAY_RETURN_NOT_OK(ReadCreateBatchReply(buffer.data(),
+                                         buffer.size(),
+                                         retry_with_request_id,
+                                         &object_ids,
+                                         &plasma_objects,
+                                         &store_fds,
+                                         &mmap_sizes));
+  if (*retry_with_request_id > 0) {
+    // The client should retry the request.
+    return Status::OK();
+  }
+  RAY_CHECK(object_ids.size() == objects.size());
+  RAY_CHECK(plasma_objects.size() == objects.size());
+
+  // The store sends the file descriptors that the objects are allocated in
+  // right after the reply, each one once.
+  for (size_t i = 0; i < store_fds.size(); i++) {
+    RAY_LOG(DEBUG) << "GetStoreFdAndMmap " << store_fds[i].first << ", "
+                   << store_fds[i].second << ", size " << mmap_sizes[i];
+    GetStoreFdAndMmap(store_fds[i], mmap_sizes[i]);
+  }
+
+  data->clear();
+  data->reserve(objects.size());
+  for (size_t i = 0; i < objects.size(); i++) {
+    const auto &object_id = objects[i].object_id;
+    RAY_CHECK(object_ids[i] == object_id);
+    auto object = std::make_unique<PlasmaObject>(plasma_objects[i]);
+    RAY_CHECK(object->device_num == 0) << "GPU is not enabled.";
+    // The metadata should come right after the data.
+    RAY_CHECK(object->metadata_offset == object->data_offset + object->data_size);
+    auto object_data = std::make_shared<PlasmaMutableBuffer>(
+        shared_from_this(),
+        LookupMmappedFile(object->store_fd) + object->data_offset,
+        object->data_size);
+    if (objects[i].metadata != NULL) {
+      // Copy the metadata to the buffer.
+      memcpy(object_data->Data() + object->data_size,
+             objects[i].metadata,
+             object->metadata_size);
+    }
+    data->push_back(std::move(object_data));
+    // Like HandleCreateReply, pin the object until it is sealed.
+    InsertObjectInUse(object_id, std::move(object), /*is_sealed=*/false);
+    IncrementObjectCount(object_id);
+  }
+  return Status::OK();
+}
+
+Status PlasmaClient::Impl::CreateBatchAndSpillIfNeeded(
+    const std::vector<ObjectCreateSpec> &objects,
+    const ray::rpc::Address &owner_address,
+    std::vector<std::shared_ptr<Buffer>> *data,
+    fb::ObjectSource source) {
+  std::unique_lock<std::recursive_mutex> guard(client_mutex_);
+  if (objects.empty()) {
+    data->clear();
+    return Status::OK();
+  }
+  std::vector<ObjectID> object_ids;
+  std::vector<int64_t> data_sizes;
+  std::vector<int64_t> metadata_sizes;
+  object_ids.reserve(objects.size());
+  data_sizes.reserve(objects.size());
+  metadata_sizes.reserve(objects.size());
+  for (const auto &object : objects) {
+    object_ids.push_back(object.object_id);
+    data_sizes.push_back(object.data_size);
+    metadata_sizes.push_back(object.metadata_size);
+  }
+  uint64_t retry_with_request_id = 0;
+
+  RAY_LOG(DEBUG) << "called plasma_create_batch on conn " << store_conn_ << " with "
+                 << objects.size() << " objects";
+  RAY_RETURN_NOT_OK(SendCreateBatchRequest(
+      store_conn_, object_ids, owner_address, data_sizes, metadata_sizes, source));
+  Status status = HandleCreateBatchReply(objects, &retry_with_request_id, data);
+
+  while (retry_with_request_id > 0) {
+    guard.unlock();
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(RayConfig::instance().object_store_full_delay_ms()));
+    guard.lock();
+    RAY_LOG(DEBUG) << "Retrying request for " << objects.size()
+                   << " objects with request ID " << retry_with_request_id;
+    RAY_RETURN_NOT_OK(
+        SendCreateBatchRetryRequest(store_conn_, object_ids, retry_with_request_id));
+    status = HandleCreateBatchReply(objects, &retry_with_request_id, data);
+  }
+
+  return status;
+}
+
 Status PlasmaClient::Impl::RetryCreate(const ObjectID &object_id,
                                        uint64_t request_id,
                                        bool is_experimental_mutable_object,
@@ -787,6 +907,42 @@ Status PlasmaClient::Impl::Seal(const ObjectID &object_id) {
   return Status::OK();
 }
 
+Status PlasmaClient::Impl::SealBatch(const std::vector<ObjectID> &object_ids) {
+  std::lock_guard<std::recursive_mutex> guard(client_mutex_);
+  RAY_LOG(DEBUG) << "Seal " << object_ids.size() << " objects";
+  if (object_ids.empty()) {
+    return Status::OK();
+  }
+
+  // Check all of the objects before marking any of them as sealed.
+  for (const auto &object_id : object_ids) {
+    auto object_entry = objects_in_use_.find(object_id);
+    if (object_entry == objects_in_use_.end()) {
+      return Status::ObjectNotFound(
+          "SealBatch() called on an object without a reference to it");
+    }
+    if (object_entry->second->is_sealed) {
+      return Status::ObjectAlreadySealed(
+          "SealBatch() called on an already sealed object");
+    }
+  }
+  for (const auto &object_id : object_ids) {
+    objects_in_use_[object_id]->is_sealed = true;
+  }
+  RAY_RETURN_NOT_OK(SendSealBatchRequest(store_conn_, object_ids));
+  std::vector<uint8_t> buffer;
+  RAY_RETURN_NOT_OK(
+      PlasmaReceive(store_conn_, MessageType::PlasmaSealBatchReply, &buffer));
+  std::vector<ObjectID> sealed_ids;
+  RAY_RETURN_NOT_OK(ReadSealBatchReply(buffer.data(), buffer.size(), &sealed_ids));
+  RAY_CHECK(sealed_ids == object_ids);
+  // Release the references taken when the objects were created, like Seal.
+  for (const auto &object_id : object_ids) {
+    RAY_RETURN_NOT_OK(Release(object_id));
+  }
+  return Status::OK();
+}
+
 Status PlasmaClient::Impl::Abort(const ObjectID &object_id) {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
   auto object_entry = objects_in_use_.find(object_id);
@@ -866,10 +1022,41 @@ Status PlasmaClient::Impl::Connect(const std::string &store_socket_name,
   std::vector<uint8_t> buffer;
   RAY_RETURN_NOT_OK(PlasmaReceive(store_conn_, MessageType::PlasmaConnectReply, &buffer));
   RAY_RETURN_NOT_OK(ReadConnectReply(buffer.data(), buffer.size(), &store_capacity_));
+  if (RayConfig::instance().plasma_shared_memory_transport()) {
+    RAY_RETURN_NOT_OK(ConnectSharedMemoryTransport());
+  }
 
   return Status::OK();
 }
 
+Status PlasmaClient::Impl::ConnectSharedMemoryTransport() {
+  RAY_RETURN_NOT_OK(SendConnectRingRequest(store_conn_));
+  std::vector<uint8_t> buffer;
+  RAY_RETURN_NOT_OK(
+      PlasmaReceive(store_conn_, MessageType::PlasmaConnectRingReply, &buffer));
+  uint64_t ring_capacity;
+  RAY_RETURN_NOT_OK(ReadConnectRingReply(buffer.data(), buffer.size(), &ring_capacity));
+  if (ring_capacity == 0) {
+    RAY_LOG(INFO) << "The plasma store doesn't support the shared memory transport, "
+                  << "falling back to the socket.";
+    return Status::OK();
+  }
+#ifdef _WIN32
+  return Status::NotImplemented("The shared memory transport requires Linux.");
+#else
+  MEMFD_TYPE_NON_UNIQUE shm_fd;
+  MEMFD_TYPE_NON_UNIQUE event_fd;
+  RAY_RETURN_NOT_OK(store_conn_->RecvFd(&shm_fd));
+  RAY_RETURN_NOT_OK(store_conn_->RecvFd(&event_fd));
+  auto transport = SharedMemoryTransport::Attach(shm_fd, event_fd, ring_capacity);
+  if (transport == nullptr) {
+    return Status::IOError("Failed to attach to the shared memory transport.");
+  }
+  store_conn_->UseSharedMemoryTransport(std::move(transport));
+  return Status::OK();
+#endif
+}
+
 Status PlasmaClient::Impl::Disconnect() {
   std::lock_guard<std::recursive_mutex> guard(client_mutex_);
 
@@ -934,6 +1121,14 @@ Status PlasmaClient::CreateAndSpillIfNeeded(const ObjectID &object_id,
                                        device_num);
 }
 
+Status PlasmaClient::CreateBatchAndSpillIfNeeded(
+    const std::vector<ObjectCreateSpec> &objects,
+    const ray::rpc::Address &owner_address,
+    std::vector<std::shared_ptr<Buffer>> *data,
+    fb::ObjectSource source) {
+  return impl_->CreateBatchAndSpillIfNeeded(objects, owner_address, data, source);
+}
+
 Status PlasmaClient::TryCreateImmediately(const ObjectID &object_id,
                                           const ray::rpc::Address &owner_address,
                                           int64_t data_size,
@@ -989,6 +1184,10 @@ Status PlasmaClient::Abort(const ObjectID &object_id) { return impl_->Abort(obje
 
 Status PlasmaClient::Seal(const ObjectID &object_id) { return impl_->Seal(object_id); }
 
+Status PlasmaClient::SealBatch(const std::vector<ObjectID> &object_ids) {
+  return impl_->SealBatch(object_ids);
+}
+
 Status PlasmaClient::Delete(const ObjectID &object_id) {
   return impl_->Delete(std::vector<ObjectID>{object_id});
 }
@@ -49,6 +49,18 @@ struct MutableObject {
   const int64_t allocated_size;
 };
 
+/// The arguments to create one object of a batch.
+struct ObjectCreateSpec {
+  /// The ID to use for the newly created object.
+  ObjectID object_id;
+  /// The size in bytes of the object's data.
+  int64_t data_size;
+  /// The object's metadata. If there is no metadata, this should be NULL.
+  const uint8_t *metadata;
+  /// The size in bytes of the metadata.
+  int64_t metadata_size;
+};
+
 /// Object buffer data structure.
 struct ObjectBuffer {
   /// The data buffer.
@@ -220,6 +232,27 @@ class PlasmaClient : public PlasmaClientInterface {
                                 plasma::flatbuf::ObjectSource source,
                                 int device_num = 0);
 
+  /// Create several objects in the Plasma Store with a single request. The
+  /// store creates either all of the objects or none of them, and sends the
+  /// allocations and file descriptors of all of them in a single reply.
+  ///
+  /// Like CreateAndSpillIfNeeded, this call blocks until enough objects have
+  /// been spilled to make space for the whole batch.
+  ///
+  /// \param objects The IDs, sizes and metadata of the objects to create.
+  /// \param owner_address The address of the objects' owner.
+  /// \param[out] data The buffers of the newly created objects, in the same
+  /// order as the objects.
+  /// \param source The source of the objects.
+  /// \return The return status.
+  ///
+  /// Each returned object must be released once it is done with. The objects
+  /// must also be either sealed, e.g. with SealBatch, or aborted.
+  Status CreateBatchAndSpillIfNeeded(const std::vector<ObjectCreateSpec> &objects,
+                                     const ray::rpc::Address &owner_address,
+                                     std::vector<std::shared_ptr<Buffer>> *data,
+                                     plasma::flatbuf::ObjectSource source);
+
   /// Create an object in the Plasma Store. Any metadata for this object must be
   /// be passed in when the object is created.
   ///
@@ -322,6 +355,12 @@ class PlasmaClient : public PlasmaClientInterface {
   /// \return The return status.
   Status Seal(const ObjectID &object_id);
 
+  /// Seal several objects with a single request. See Seal.
+  ///
+  /// \param object_ids The IDs of the objects to seal.
+  /// \return The return status.
+  Status SealBatch(const std::vector<ObjectID> &object_ids);
+
   /// Delete an object from the object store. This currently assumes that the
   /// object is present, has been sealed and not used by another client. Otherwise,
   /// it is a no operation.
@@ -100,6 +100,7 @@ struct Allocation {
   friend struct ObjectLifecycleManagerTest;
   FRIEND_TEST(ObjectStoreTest, PassThroughTest);
   FRIEND_TEST(EvictionPolicyTest, Test);
+  FRIEND_TEST(EvictionPolicyTest, TestGdsf);
   friend struct GetRequestQueueTest;
 };
 
@@ -162,6 +163,7 @@ class LocalObject {
   FRIEND_TEST(ObjectLifecycleManagerTest, RemoveReferenceOneRefNotSealed);
   friend struct ObjectStatsCollectorTest;
   FRIEND_TEST(EvictionPolicyTest, Test);
+  FRIEND_TEST(EvictionPolicyTest, TestGdsf);
   friend struct GetRequestQueueTest;
 
   /// Allocation Info;
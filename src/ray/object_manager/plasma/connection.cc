@@ -1,8 +1,14 @@
 #include "ray/object_manager/plasma/connection.h"
 
+#include <sstream>
+
 #ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+
 #include "ray/object_manager/plasma/fling.h"
 #endif
+#include "ray/common/ray_config.h"
 #include "ray/object_manager/plasma/plasma_generated.h"
 #include "ray/object_manager/plasma/protocol.h"
 #include "ray/util/logging.h"
@@ -48,6 +54,37 @@ static const std::vector<std::string> object_store_message_enum =
     GenerateEnumNames(flatbuf::EnumNamesMessageType(),
                       static_cast<int>(MessageType::MIN),
                       static_cast<int>(MessageType::MAX));
+
+/// Whether the other end of a socket is still connected. Used while waiting for
+/// the peer of a shared memory transport.
+bool IsPeerConnected(int socket_fd) {
+#ifdef __linux__
+  if (socket_fd < 0) {
+    return false;
+  }
+  struct pollfd poll_fd = {socket_fd, POLLRDHUP, 0};
+  if (poll(&poll_fd, 1, 0) <= 0) {
+    return true;
+  }
+  return (poll_fd.revents & (POLLRDHUP | POLLHUP | POLLERR | POLLNVAL)) == 0;
+#else
+  return socket_fd >= 0;
+#endif
+}
+
+/// Write a message in the same format as ServerConnection::WriteMessage.
+Status WriteRingMessage(SharedMemoryRing &ring,
+                        int socket_fd,
+                        int64_t type,
+                        int64_t length,
+                        const uint8_t *message) {
+  int64_t cookie = RayConfig::instance().ray_cookie();
+  return ring.Write({{reinterpret_cast<const uint8_t *>(&cookie), sizeof(cookie)},
+                     {reinterpret_cast<const uint8_t *>(&type), sizeof(type)},
+                     {reinterpret_cast<const uint8_t *>(&length), sizeof(length)},
+                     {message, static_cast<size_t>(length)}},
+                    [socket_fd]() { return IsPeerConnected(socket_fd); });
+}
 }  // namespace
 
 Client::Client(ray::MessageHandler &message_handler, ray::local_stream_socket &&socket)
@@ -63,20 +100,20 @@ std::shared_ptr<Client> Client::Create(PlasmaStoreMessageHandler message_handler
       [message_handler](std::shared_ptr<ray::ClientConnection> client,
                         int64_t message_type,
                         const std::vector<uint8_t> &message) {
-        Status s = message_handler(
-            std::static_pointer_cast<Client>(client->shared_ClientConnection_from_this()),
-            (MessageType)message_type,
-            message);
+        auto plasma_client =
+            std::static_pointer_cast<Client>(client->shared_ClientConnection_from_this());
+        Status s = message_handler(plasma_client, (MessageType)message_type, message);
         if (!s.ok()) {
           if (!s.IsDisconnected()) {
             RAY_LOG(ERROR) << "Fail to process client message. " << s.ToString();
           }
-          client->Close();
+          plasma_client->Close();
         } else {
           client->ProcessMessages();
         }
       };
   std::shared_ptr<Client> self(new Client(ray_message_handler, std::move(socket)));
+  self->plasma_message_handler_ = std::move(message_handler);
   // Let our manager process our new connection.
   self->ProcessMessages();
   return self;
@@ -142,6 +179,113 @@ Status Client::SendFd(MEMFD_TYPE fd) {
   return Status::OK();
 }
 
+Status Client::UseSharedMemoryTransport(
+    std::unique_ptr<SharedMemoryTransport> transport) {
+#ifdef _WIN32
+  return Status::NotImplemented("The shared memory transport requires Linux.");
+#else
+  for (int fd : {transport->ShmFd(), transport->EventFd()}) {
+    if (send_fd(GetNativeHandle(), fd) <= 0) {
+      return Status::IOError("Failed to send the shared memory transport.");
+    }
+  }
+  int event_fd = dup(transport->EventFd());
+  if (event_fd < 0) {
+    return Status::IOError("Failed to duplicate the eventfd of the transport.");
+  }
+  transport_ = std::move(transport);
+  ring_event_ = std::make_unique<boost::asio::posix::stream_descriptor>(
+      socket_.get_executor(), event_fd);
+  WaitForRingMessages();
+  return Status::OK();
+#endif
+}
+
+void Client::WaitForRingMessages() {
+#ifndef _WIN32
+  auto self = std::static_pointer_cast<Client>(shared_ClientConnection_from_this());
+  ring_event_->async_wait(boost::asio::posix::stream_descriptor::wait_read,
+                          [self](const boost::system::error_code &error) {
+                            if (!error) {
+                              self->ProcessRingMessages();
+                            }
+                          });
+#endif
+}
+
+void Client::ProcessRingMessages() {
+#ifndef _WIN32
+  // Reset the eventfd. The producer only writes to it again once we wait.
+  uint64_t events;
+  ssize_t read_bytes = read(ring_event_->native_handle(), &events, sizeof(events));
+  RAY_UNUSED(read_bytes);
+  auto &requests = transport_->Requests();
+  auto *header = reinterpret_cast<uint8_t *>(ring_message_header_);
+  const size_t header_size = sizeof(ring_message_header_);
+  while (ring_event_->is_open()) {
+    if (ring_message_header_bytes_ < header_size) {
+      ring_message_header_bytes_ +=
+          requests.TryRead(header + ring_message_header_bytes_,
+                           header_size - ring_message_header_bytes_);
+      if (ring_message_header_bytes_ < header_size) {
+        if (requests.PrepareToWait()) {
+          break;
+        }
+        continue;
+      }
+      if (ring_message_header_[0] != RayConfig::instance().ray_cookie()) {
+        RAY_LOG(ERROR) << "Ray cookie mismatch for a message from the shared memory "
+                       << "transport of client " << GetNativeHandle();
+        Close();
+        return;
+      }
+      ring_message_.resize(ring_message_header_[2]);
+      ring_message_bytes_ = 0;
+    }
+    ring_message_bytes_ += requests.TryRead(ring_message_.data() + ring_message_bytes_,
+                                            ring_message_.size() - ring_message_bytes_);
+    if (ring_message_bytes_ < ring_message_.size()) {
+      if (requests.PrepareToWait()) {
+        break;
+      }
+      continue;
+    }
+    ring_message_header_bytes_ = 0;
+    auto self = std::static_pointer_cast<Client>(shared_ClientConnection_from_this());
+    Status s = plasma_message_handler_(
+        self, static_cast<MessageType>(ring_message_header_[1]), ring_message_);
+    if (!s.ok()) {
+      if (!s.IsDisconnected()) {
+        RAY_LOG(ERROR) << "Fail to process client message. " << s.ToString();
+      }
+      Close();
+      return;
+    }
+  }
+  if (ring_event_->is_open()) {
+    WaitForRingMessages();
+  }
+#endif
+}
+
+Status Client::WriteMessage(int64_t type, int64_t length, const uint8_t *message) {
+  if (transport_ == nullptr) {
+    return ServerConnection::WriteMessage(type, length, message);
+  }
+  return WriteRingMessage(
+      transport_->Replies(), GetNativeHandle(), type, length, message);
+}
+
+void Client::Close() {
+#ifndef _WIN32
+  if (ring_event_ != nullptr) {
+    boost::system::error_code ec;
+    ring_event_->close(ec);
+  }
+#endif
+  ServerConnection::Close();
+}
+
 StoreConn::StoreConn(ray::local_stream_socket &&socket)
     : ray::ServerConnection(std::move(socket)) {}
 
@@ -165,4 +309,43 @@ Status StoreConn::RecvFd(MEMFD_TYPE_NON_UNIQUE *fd) {
   return Status::OK();
 }
 
+void StoreConn::UseSharedMemoryTransport(
+    std::unique_ptr<SharedMemoryTransport> transport) {
+  transport_ = std::move(transport);
+}
+
+Status StoreConn::WriteMessage(int64_t type, int64_t length, const uint8_t *message) {
+  if (transport_ == nullptr) {
+    return ServerConnection::WriteMessage(type, length, message);
+  }
+  return WriteRingMessage(
+      transport_->Requests(), GetNativeHandle(), type, length, message);
+}
+
+Status StoreConn::ReadMessage(int64_t type, std::vector<uint8_t> *message) {
+  if (transport_ == nullptr) {
+    return ServerConnection::ReadMessage(type, message);
+  }
+  int socket_fd = GetNativeHandle();
+  auto is_store_connected = [socket_fd]() { return IsPeerConnected(socket_fd); };
+  auto &replies = transport_->Replies();
+  int64_t header[3];
+  RAY_RETURN_NOT_OK(replies.Read(
+      reinterpret_cast<uint8_t *>(header), sizeof(header), is_store_connected));
+  if (header[0] != RayConfig::instance().ray_cookie()) {
+    std::ostringstream ss;
+    ss << "Ray cookie mismatch for received message. "
+       << "Received cookie: " << header[0];
+    return Status::IOError(ss.str());
+  }
+  if (type != header[1]) {
+    std::ostringstream ss;
+    ss << "Connection corrupted. Expected message type: " << type
+       << ", received message type: " << header[1];
+    return Status::IOError(ss.str());
+  }
+  message->resize(header[2]);
+  return replies.Read(message->data(), message->size(), is_store_connected);
+}
+
 }  // namespace plasma
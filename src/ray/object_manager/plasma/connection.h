@@ -1,10 +1,15 @@
 #pragma once
 
+#ifndef _WIN32
+#include <boost/asio/posix/stream_descriptor.hpp>
+#endif
+
 #include "absl/container/flat_hash_set.h"
 #include "ray/common/client_connection.h"
 #include "ray/common/id.h"
 #include "ray/common/status.h"
 #include "ray/object_manager/plasma/compat.h"
+#include "ray/object_manager/plasma/shared_memory_ring.h"
 
 namespace plasma {
 
@@ -36,6 +41,25 @@ class Client : public ray::ClientConnection, public ClientInterface {
 
   ray::Status SendFd(MEMFD_TYPE fd) override;
 
+  /// Exchange the following messages with the client through the rings of a
+  /// shared memory transport instead of the socket. The file descriptors of the
+  /// transport are sent to the client. The socket is still used to send the file
+  /// descriptors of objects, and to detect that the client disconnected.
+  ///
+  /// \param transport The transport.
+  /// \return Status.
+  ray::Status UseSharedMemoryTransport(std::unique_ptr<SharedMemoryTransport> transport);
+
+  /// Write a message to the client, through the shared memory transport if
+  /// the client uses it.
+  ray::Status WriteMessage(int64_t type,
+                           int64_t length,
+                           const uint8_t *message) override;
+
+  /// Close the socket and stop reading messages from the shared memory
+  /// transport.
+  void Close() override;
+
   const std::unordered_set<ray::ObjectID> &GetObjectIDs() override { return object_ids; }
 
   // Holds the object ID. If the object ID has a fallback-allocated fd, adds the ref count
@@ -108,6 +132,30 @@ class Client : public ray::ClientConnection, public ClientInterface {
 
  private:
   Client(ray::MessageHandler &message_handler, ray::local_stream_socket &&socket);
+
+  /// Wait for the client to write to the ring of requests.
+  void WaitForRingMessages();
+
+  /// Handle the messages written to the ring of requests, until it is empty.
+  void ProcessRingMessages();
+
+  /// Handles the messages of the client, from the socket or the ring of requests.
+  PlasmaStoreMessageHandler plasma_message_handler_;
+
+  /// The shared memory transport, if the client uses it.
+  std::unique_ptr<SharedMemoryTransport> transport_;
+#ifndef _WIN32
+  /// The eventfd of the transport, to wait for requests in the event loop.
+  std::unique_ptr<boost::asio::posix::stream_descriptor> ring_event_;
+#endif
+  /// The header of the message being read from the ring of requests: its cookie,
+  /// type and length, and how many bytes of the header and of the message were
+  /// read so far. Messages can be larger than the ring.
+  int64_t ring_message_header_[3];
+  size_t ring_message_header_bytes_ = 0;
+  std::vector<uint8_t> ring_message_;
+  size_t ring_message_bytes_ = 0;
+
   /// File descriptors that are used by this client.
   /// TODO(ekl) we should also clean up old fds that are removed.
   absl::flat_hash_set<MEMFD_TYPE> used_fds_;
@@ -134,6 +182,24 @@ class StoreConn : public ray::ServerConnection {
   ///
   /// \return A file descriptor.
   ray::Status RecvFd(MEMFD_TYPE_NON_UNIQUE *fd);
+
+  /// Exchange the following messages with the store through the rings of a
+  /// shared memory transport instead of the socket.
+  ///
+  /// \param transport The transport.
+  void UseSharedMemoryTransport(std::unique_ptr<SharedMemoryTransport> transport);
+
+  /// Write a message to the store, through the shared memory transport if any.
+  ray::Status WriteMessage(int64_t type,
+                           int64_t length,
+                           const uint8_t *message) override;
+
+  /// Read a message from the store, through the shared memory transport if any.
+  ray::Status ReadMessage(int64_t type, std::vector<uint8_t> *message) override;
+
+ private:
+  /// The shared memory transport, if the store supports it.
+  std::unique_ptr<SharedMemoryTransport> transport_;
 };
 
 std::ostream &operator<<(std::ostream &os, const std::shared_ptr<StoreConn> &store_conn);
@@ -30,15 +30,49 @@ uint64_t CreateRequestQueue::AddRequest(const ObjectID &object_id,
                                         size_t object_size) {
   auto req_id = next_req_id_++;
   fulfilled_requests_[req_id] = nullptr;
-  queue_.emplace_back(
-      new CreateRequest(object_id, req_id, client, create_callback, object_size));
+  queue_.emplace_back(new CreateRequest(
+      object_id,
+      req_id,
+      client,
+      [create_callback](bool fallback_allocator, std::vector<PlasmaObject> *results) {
+        results->resize(1);
+        return create_callback(fallback_allocator, &results->front());
+      },
+      object_size));
   num_bytes_pending_ += object_size;
   return req_id;
 }
 
+uint64_t CreateRequestQueue::AddBatchRequest(
+    const std::vector<ObjectID> &object_ids,
+    const std::shared_ptr<ClientInterface> &client,
+    const CreateObjectsCallback &create_callback,
+    size_t total_size) {
+  RAY_CHECK(!object_ids.empty());
+  auto req_id = next_req_id_++;
+  fulfilled_requests_[req_id] = nullptr;
+  queue_.emplace_back(
+      new CreateRequest(object_ids.front(), req_id, client, create_callback, total_size));
+  num_bytes_pending_ += total_size;
+  return req_id;
+}
+
 bool CreateRequestQueue::GetRequestResult(uint64_t req_id,
                                           PlasmaObject *result,
                                           PlasmaError *error) {
+  std::vector<PlasmaObject> results;
+  if (!GetBatchRequestResult(req_id, &results, error)) {
+    return false;
+  }
+  if (!results.empty()) {
+    *result = results.front();
+  }
+  return true;
+}
+
+bool CreateRequestQueue::GetBatchRequestResult(uint64_t req_id,
+                                               std::vector<PlasmaObject> *results,
+                                               PlasmaError *error) {
   auto it = fulfilled_requests_.find(req_id);
   if (it == fulfilled_requests_.end()) {
     RAY_LOG(ERROR)
@@ -53,7 +87,7 @@ bool CreateRequestQueue::GetRequestResult(uint64_t req_id,
     return false;
   }
 
-  *result = it->second->result;
+  *results = std::move(it->second->results);
   *error = it->second->error;
   fulfilled_requests_.erase(it);
   return true;
@@ -73,7 +107,7 @@ std::pair<PlasmaObject, PlasmaError> CreateRequestQueue::TryRequestImmediately(
 
 Status CreateRequestQueue::ProcessRequest(bool fallback_allocator,
                                           std::unique_ptr<CreateRequest> &request) {
-  request->error = request->create_callback(fallback_allocator, &request->result);
+  request->error = request->create_callback(fallback_allocator, &request->results);
   if (request->error == PlasmaError::OutOfMemory) {
     return Status::ObjectStoreFull("");
   } else {
@@ -34,6 +34,10 @@ class CreateRequestQueue {
   using CreateObjectCallback =
       std::function<PlasmaError(bool fallback_allocator, PlasmaObject *result)>;
 
+  /// Creates a batch of objects. Either all of them are created or none.
+  using CreateObjectsCallback = std::function<PlasmaError(
+      bool fallback_allocator, std::vector<PlasmaObject> *results)>;
+
   CreateRequestQueue(ray::FileSystemMonitor &fs_monitor,
                      int64_t oom_grace_period_s,
                      ray::SpillObjectsCallback spill_objects_callback,
@@ -64,6 +68,21 @@ class CreateRequestQueue {
                       const CreateObjectCallback &create_callback,
                       const size_t object_size);
 
+  /// Add a request to create a batch of objects to the queue. The batch is
+  /// queued and retried as a single request of the total size of the objects,
+  /// so that either all of the objects are created or none.
+  ///
+  /// \param object_ids The IDs of the objects to create.
+  /// \param client The client that sent the request. This is used as a key to
+  /// drop this request if the client disconnects.
+  /// \param create_callback A callback to attempt to create the objects.
+  /// \param total_size The total size of the objects in bytes.
+  /// \return A request ID that can be used to get the result.
+  uint64_t AddBatchRequest(const std::vector<ObjectID> &object_ids,
+                           const std::shared_ptr<ClientInterface> &client,
+                           const CreateObjectsCallback &create_callback,
+                           size_t total_size);
+
   /// Get the result of a request.
   ///
   /// This method should only be called with a request ID returned by a
@@ -82,6 +101,19 @@ class CreateRequestQueue {
   /// request is still pending.
   bool GetRequestResult(uint64_t req_id, PlasmaObject *result, PlasmaError *error);
 
+  /// Get the result of a request to create a batch of objects. See
+  /// GetRequestResult.
+  ///
+  /// \param[in] req_id The request ID that was returned to the caller by a
+  /// previous call to add a request.
+  /// \param[out] results The resulting objects, in the order of the request,
+  /// if the request was finished and successful.
+  /// \param[out] error The error code returned by the creation handler.
+  /// \return Whether the results and error are ready.
+  bool GetBatchRequestResult(uint64_t req_id,
+                             std::vector<PlasmaObject> *results,
+                             PlasmaError *error);
+
   /// Try to fulfill a request immediately, for clients that cannot retry.
   ///
   /// \param object_id The ID of the object to create.
@@ -122,7 +154,7 @@ class CreateRequestQueue {
     CreateRequest(const ObjectID &object_id,
                   uint64_t request_id,
                   const std::shared_ptr<ClientInterface> &client,
-                  CreateObjectCallback create_callback,
+                  CreateObjectsCallback create_callback,
                   size_t object_size)
         : object_id(object_id),
           request_id(request_id),
@@ -130,7 +162,7 @@ class CreateRequestQueue {
           create_callback(create_callback),
           object_size(object_size) {}
 
-    // The ObjectID to create.
+    // The ObjectID to create, or the first one of a batch.
     const ObjectID object_id;
 
     // A request ID that can be returned to the caller to get the result once
@@ -141,15 +173,15 @@ class CreateRequestQueue {
     // by a client that is now disconnected.
     const std::shared_ptr<ClientInterface> client;
 
-    // A callback to attempt to create the object.
-    const CreateObjectCallback create_callback;
+    // A callback to attempt to create the objects.
+    const CreateObjectsCallback create_callback;
 
     const size_t object_size;
 
     // The results of the creation call. These should be sent back to the
     // client once ready.
     PlasmaError error = PlasmaError::OK;
-    PlasmaObject result = {};
+    std::vector<PlasmaObject> results;
   };
 
   /// Process a single request. Sets the request's error result to the error
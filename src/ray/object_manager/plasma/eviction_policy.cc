@@ -24,6 +24,34 @@
 
 namespace plasma {
 
+namespace {
+// The cost of fetching an object again, on top of transferring its bytes, expressed
+// in bytes. About the size of the largest objects that are inlined instead of being
+// put in plasma, since their cost is dominated by the overhead.
+const double kFetchOverheadBytes = 100 * 1024;
+
+// Choose objects to evict to create an object of the given size. Returns the number
+// of bytes of space that is still needed, if any.
+int64_t ChooseObjectsToEvictForSize(IEvictionPolicy &policy,
+                                    const IAllocator &allocator,
+                                    int64_t size,
+                                    std::vector<ObjectID> &objects_to_evict) {
+  // Check if there is enough space to create the object.
+  int64_t required_space = allocator.Allocated() + size - allocator.GetFootprintLimit();
+  // Try to free up at least as much space as we need right now but ideally
+  // up to 20% of the total capacity.
+  int64_t space_to_free = std::max(required_space, allocator.GetFootprintLimit() / 5);
+  // Choose some objects to evict, and update the return pointers.
+  int64_t num_bytes_evicted =
+      policy.ChooseObjectsToEvict(space_to_free, objects_to_evict);
+  RAY_LOG(DEBUG) << "There is not enough space to create this object, so evicting "
+                 << objects_to_evict.size() << " objects to free up " << num_bytes_evicted
+                 << " bytes. The number of bytes in use (before "
+                 << "this eviction) is " << allocator.Allocated() << ".";
+  return required_space - num_bytes_evicted;
+}
+}  // namespace
+
 void LRUCache::Add(const ObjectID &key, int64_t size) {
   auto it = item_map_.find(key);
   RAY_CHECK(it == item_map_.end());
@@ -117,18 +145,7 @@ void EvictionPolicy::ObjectCreated(const ObjectID &object_id) {
 
 int64_t EvictionPolicy::RequireSpace(int64_t size,
                                      std::vector<ObjectID> &objects_to_evict) {
-  // Check if there is enough space to create the object.
-  int64_t required_space = allocator_.Allocated() + size - allocator_.GetFootprintLimit();
-  // Try to free up at least as much space as we need right now but ideally
-  // up to 20% of the total capacity.
-  int64_t space_to_free = std::max(required_space, allocator_.GetFootprintLimit() / 5);
-  // Choose some objects to evict, and update the return pointers.
-  int64_t num_bytes_evicted = ChooseObjectsToEvict(space_to_free, objects_to_evict);
-  RAY_LOG(DEBUG) << "There is not enough space to create this object, so evicting "
-                 << objects_to_evict.size() << " objects to free up " << num_bytes_evicted
-                 << " bytes. The number of bytes in use (before "
-                 << "this eviction) is " << allocator_.Allocated() << ".";
-  return required_space - num_bytes_evicted;
+  return ChooseObjectsToEvictForSize(*this, allocator_, size, objects_to_evict);
 }
 
 void EvictionPolicy::BeginObjectAccess(const ObjectID &object_id) {
@@ -158,4 +175,124 @@ bool EvictionPolicy::IsObjectExists(const ObjectID &object_id) const {
 }
 
 std::string EvictionPolicy::DebugString() const { return cache_.DebugString(); }
+
+GdsfEvictionPolicy::GdsfEvictionPolicy(const IObjectStore &object_store,
+                                       const IAllocator &allocator)
+    : clock_(0),
+      next_sequence_number_(0),
+      pinned_memory_bytes_(0),
+      evictable_bytes_(0),
+      num_evictions_total_(0),
+      bytes_evicted_total_(0),
+      object_store_(object_store),
+      allocator_(allocator) {}
+
+void GdsfEvictionPolicy::AddToEvictionQueue(const ObjectID &object_id,
+                                            ObjectEntry &entry) {
+  RAY_CHECK(!entry.evictable);
+  // The cost of fetching the object again per byte of memory it takes.
+  double cost_per_byte =
+      (entry.size + kFetchOverheadBytes) / std::max<int64_t>(entry.size, 1);
+  auto key =
+      std::make_pair(clock_ + entry.frequency * cost_per_byte, next_sequence_number_++);
+  entry.position = eviction_queue_.emplace(key, object_id).first;
+  entry.evictable = true;
+  evictable_bytes_ += entry.size;
+}
+
+void GdsfEvictionPolicy::RemoveFromEvictionQueue(ObjectEntry &entry) {
+  if (!entry.evictable) {
+    return;
+  }
+  eviction_queue_.erase(entry.position);
+  entry.evictable = false;
+  evictable_bytes_ -= entry.size;
+}
+
+void GdsfEvictionPolicy::ObjectCreated(const ObjectID &object_id) {
+  auto size = object_store_.GetObject(object_id)->GetObjectSize();
+  auto inserted = objects_.emplace(object_id, ObjectEntry{size});
+  RAY_CHECK(inserted.second);
+  AddToEvictionQueue(object_id, inserted.first->second);
+}
+
+int64_t GdsfEvictionPolicy::RequireSpace(int64_t size,
+                                         std::vector<ObjectID> &objects_to_evict) {
+  return ChooseObjectsToEvictForSize(*this, allocator_, size, objects_to_evict);
+}
+
+void GdsfEvictionPolicy::BeginObjectAccess(const ObjectID &object_id) {
+  auto it = objects_.find(object_id);
+  RAY_CHECK(it != objects_.end());
+  auto &entry = it->second;
+  RemoveFromEvictionQueue(entry);
+  entry.frequency++;
+  pinned_memory_bytes_ += entry.size;
+}
+
+void GdsfEvictionPolicy::EndObjectAccess(const ObjectID &object_id) {
+  auto it = objects_.find(object_id);
+  RAY_CHECK(it != objects_.end());
+  AddToEvictionQueue(object_id, it->second);
+  pinned_memory_bytes_ -= it->second.size;
+}
+
+int64_t GdsfEvictionPolicy::ChooseObjectsToEvict(
+    int64_t num_bytes_required, std::vector<ObjectID> &objects_to_evict) {
+  int64_t bytes_evicted = 0;
+  while (bytes_evicted < num_bytes_required && !eviction_queue_.empty()) {
+    auto it = eviction_queue_.begin();
+    auto &entry = objects_.at(it->second);
+    // Age the objects that stay in the queue.
+    clock_ = it->first.first;
+    objects_to_evict.push_back(it->second);
+    bytes_evicted += entry.size;
+    RemoveFromEvictionQueue(entry);
+    num_evictions_total_++;
+  }
+  bytes_evicted_total_ += bytes_evicted;
+  return bytes_evicted;
+}
+
+void GdsfEvictionPolicy::RemoveObject(const ObjectID &object_id) {
+  auto it = objects_.find(object_id);
+  if (it == objects_.end()) {
+    return;
+  }
+  RemoveFromEvictionQueue(it->second);
+  objects_.erase(it);
+}
+
+bool GdsfEvictionPolicy::IsObjectEvictable(const ObjectID &object_id) const {
+  auto it = objects_.find(object_id);
+  return it != objects_.end() && it->second.evictable;
+}
+
+std::string GdsfEvictionPolicy::DebugString() const {
+  std::stringstream result;
+  result << "\n(gdsf) capacity: " << allocator_.GetFootprintLimit();
+  result << "\n(gdsf) num objects: " << objects_.size();
+  result << "\n(gdsf) num evictable objects: " << eviction_queue_.size();
+  result << "\n(gdsf) evictable bytes: " << evictable_bytes_;
+  result << "\n(gdsf) pinned bytes: " << pinned_memory_bytes_;
+  result << "\n(gdsf) clock: " << clock_;
+  result << "\n(gdsf) num evictions: " << num_evictions_total_;
+  result << "\n(gdsf) bytes evicted: " << bytes_evicted_total_;
+  return result.str();
+}
+
+std::unique_ptr<IEvictionPolicy> CreateEvictionPolicy(const std::string &policy,
+                                                      const IObjectStore &object_store,
+                                                      const IAllocator &allocator) {
+  if (policy == kGdsfEvictionPolicy) {
+    RAY_LOG(INFO) << "Using the GDSF plasma eviction policy.";
+    return std::make_unique<GdsfEvictionPolicy>(object_store, allocator);
+  }
+  if (policy != kLruEvictionPolicy) {
+    RAY_LOG(ERROR) << policy
+                   << " is an invalid plasma eviction policy. Defaulting to LRU policy.";
+  }
+  return std::make_unique<EvictionPolicy>(object_store, allocator);
+}
+
 }  // namespace plasma
@@ -25,6 +25,8 @@
 
 #include <functional>
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -37,6 +39,11 @@
 
 namespace plasma {
 
+/// The names of the eviction policies, see plasma_eviction_policy in
+/// ray_config_def.h.
+constexpr char kLruEvictionPolicy[] = "lru";
+constexpr char kGdsfEvictionPolicy[] = "gdsf";
+
 /// The eviction policy interface.
 class IEvictionPolicy {
  public:
@@ -196,4 +203,99 @@ class EvictionPolicy : public IEvictionPolicy {
   FRIEND_TEST(EvictionPolicyTest, Test);
 };
 
+/// A size and frequency aware eviction policy: Greedy-Dual-Size-Frequency (GDSF).
+///
+/// Each object that is not in use has the priority
+///
+///   clock + frequency * (size + fetch overhead) / size
+///
+/// where the frequency is the number of times the object was used, and the cost of
+/// fetching the object again is its size plus a fixed overhead. The objects with the
+/// lowest priority are evicted first, and the clock is raised to the priority of
+/// each evicted object, so objects that haven't been used for a while age out even
+/// if they were used often before.
+///
+/// Unlike the LRU policy, objects used by many tasks are not evicted to make room
+/// for large objects that are used only once. Among the objects used equally often,
+/// the largest are evicted first.
+class GdsfEvictionPolicy : public IEvictionPolicy {
+ public:
+  GdsfEvictionPolicy(const IObjectStore &object_store, const IAllocator &allocator);
+
+  void ObjectCreated(const ObjectID &object_id) override;
+
+  int64_t RequireSpace(int64_t size, std::vector<ObjectID> &objects_to_evict) override;
+
+  void BeginObjectAccess(const ObjectID &object_id) override;
+
+  void EndObjectAccess(const ObjectID &object_id) override;
+
+  int64_t ChooseObjectsToEvict(int64_t num_bytes_required,
+                               std::vector<ObjectID> &objects_to_evict) override;
+
+  void RemoveObject(const ObjectID &object_id) override;
+
+  std::string DebugString() const override;
+
+ private:
+  /// The objects that can be evicted by priority, and by the order in which they
+  /// stopped being used for the same priority.
+  using EvictionQueue = std::map<std::pair<double, uint64_t>, ObjectID>;
+
+  struct ObjectEntry {
+    int64_t size;
+    /// The number of times the object was used.
+    int64_t frequency = 0;
+    /// Whether the object is in the eviction queue.
+    bool evictable = false;
+    EvictionQueue::iterator position;
+  };
+
+  /// Add the object to the eviction queue, with a priority for its current
+  /// frequency.
+  void AddToEvictionQueue(const ObjectID &object_id, ObjectEntry &entry);
+
+  void RemoveFromEvictionQueue(ObjectEntry &entry);
+
+  /// Returns whether the object can be evicted.
+  bool IsObjectEvictable(const ObjectID &object_id) const;
+
+  /// All the objects, including the ones in use.
+  absl::flat_hash_map<ObjectID, ObjectEntry> objects_;
+
+  EvictionQueue eviction_queue_;
+
+  /// The priority of the last evicted object.
+  double clock_;
+
+  /// Breaks ties between objects of the same priority.
+  uint64_t next_sequence_number_;
+
+  /// The number of bytes pinned by applications.
+  int64_t pinned_memory_bytes_;
+
+  /// The number of bytes in the eviction queue.
+  int64_t evictable_bytes_;
+
+  /// The number of objects evicted.
+  int64_t num_evictions_total_;
+
+  /// The number of bytes evicted.
+  int64_t bytes_evicted_total_;
+
+  const IObjectStore &object_store_;
+
+  const IAllocator &allocator_;
+
+  FRIEND_TEST(EvictionPolicyTest, TestGdsf);
+};
+
+/// Create the eviction policy with the given name.
+///
+/// \param policy The name of the policy, kLruEvictionPolicy or kGdsfEvictionPolicy.
+/// Defaults to the LRU policy if the name is unknown.
+std::unique_ptr<IEvictionPolicy> CreateEvictionPolicy(const std::string &policy,
+                                                      const IObjectStore &object_store,
+                                                      const IAllocator &allocator);
+
 }  // namespace plasma
@@ -26,10 +26,13 @@ using namespace flatbuf;
 ObjectLifecycleManager::ObjectLifecycleManager(
     IAllocator &allocator, ray::DeleteObjectCallback delete_object_callback)
     : object_store_(std::make_unique<ObjectStore>(allocator)),
-      eviction_policy_(std::make_unique<EvictionPolicy>(*object_store_, allocator)),
+      eviction_policy_(
+          CreateEvictionPolicy(RayConfig::instance().plasma_eviction_policy(),
+                               *object_store_,
+                               allocator)),
       delete_object_callback_(delete_object_callback),
       earger_deletion_objects_(),
-      stats_collector_(std::make_unique<ObjectStatsCollector>()) {}
+      stats_collector_(std::make_unique<ObjectStatsCollector>(&allocator)) {}
 
 std::pair<const LocalObject *, flatbuf::PlasmaError> ObjectLifecycleManager::CreateObject(
     const ray::ObjectInfo &object_info,
@@ -158,6 +158,7 @@ class ObjectLifecycleManager : public IObjectLifecycleManager {
   FRIEND_TEST(ObjectLifecycleManagerTest, RemoveReferenceOneRefEagerlyDeletion);
   friend struct GetRequestQueueTest;
   FRIEND_TEST(GetRequestQueueTest, TestAddRequest);
+  FRIEND_TEST(EvictionPolicyTest, DISABLED_TraceReplayPerf);
 
   const LocalObject *CreateObjectInternal(const ray::ObjectInfo &object_info,
                                           plasma::flatbuf::ObjectSource source,
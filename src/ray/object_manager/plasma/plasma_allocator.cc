@@ -61,7 +61,8 @@ const int64_t kDlMallocReserved = 256 * sizeof(size_t);
 PlasmaAllocator::PlasmaAllocator(const std::string &plasma_directory,
                                  const std::string &fallback_directory,
                                  bool hugepage_enabled,
-                                 int64_t footprint_limit)
+                                 int64_t footprint_limit,
+                                 int64_t slab_max_object_size)
     : kFootprintLimit(footprint_limit),
       kAlignment(kAllocationAlignment),
       allocated_(0),
@@ -79,10 +80,29 @@ PlasmaAllocator::PlasmaAllocator(const std::string &plasma_directory,
   // This will unmap the file, but the next one created will be as large
   // as this one (this is an implementation detail of dlmalloc).
   Free(std::move(allocation.value()));
+
+  if (slab_max_object_size > 0) {
+    // Slabs are allocated like objects, so they're in the pre-mmaped file as long as
+    // it has space, and are never fallback allocated.
+    slab_allocator_ = std::make_unique<SlabAllocator>(
+        slab_max_object_size,
+        kAlignment,
+        [this](size_t bytes) { return dlmemalign(kAlignment, bytes); },
+        [](void *slab) { dlfree(slab); });
+  }
 }
 
 absl::optional<Allocation> PlasmaAllocator::Allocate(size_t bytes) {
   RAY_LOG(DEBUG) << "allocating " << bytes;
+  if (slab_allocator_ != nullptr && bytes <= slab_allocator_->MaxBlockSize()) {
+    void *block = slab_allocator_->Allocate(bytes);
+    if (block) {
+      // Slabs are counted as a whole in Allocated().
+      RAY_LOG(DEBUG) << "allocated " << bytes << " at " << block << " from a slab";
+      return BuildAllocation(block, bytes, /* is_fallback_allocated */ false);
+    }
+    // If there's no room for a new slab, the object may still fit.
+  }
   void *mem = dlmemalign(kAlignment, bytes);
   RAY_LOG(DEBUG) << "allocated " << bytes << " at " << mem;
   if (!mem) {
@@ -119,8 +139,12 @@ absl::optional<Allocation> PlasmaAllocator::FallbackAllocate(size_t bytes) {
 void PlasmaAllocator::Free(Allocation allocation) {
   RAY_CHECK(allocation.address != nullptr) << "Cannot free the nullptr";
   RAY_LOG(DEBUG) << "deallocating " << allocation.size << " at " << allocation.address;
-  dlfree(allocation.address);
+  if (slab_allocator_ != nullptr && !allocation.fallback_allocated &&
+      slab_allocator_->Free(allocation.address, allocation.size)) {
+    return;
+  }
   allocated_ -= allocation.size;
+  dlfree(allocation.address);
   if (internal::IsOutsideInitialAllocation(allocation.address)) {
     fallback_allocated_ -= allocation.size;
   }
@@ -128,10 +152,22 @@ void PlasmaAllocator::Free(Allocation allocation) {
 
 int64_t PlasmaAllocator::GetFootprintLimit() const { return kFootprintLimit; }
 
-int64_t PlasmaAllocator::Allocated() const { return allocated_; }
+int64_t PlasmaAllocator::Allocated() const {
+  if (slab_allocator_ == nullptr) {
+    return allocated_;
+  }
+  return allocated_ + slab_allocator_->GetStats().slab_bytes;
+}
 
 int64_t PlasmaAllocator::FallbackAllocated() const { return fallback_allocated_; }
 
+absl::optional<SlabAllocatorStats> PlasmaAllocator::GetSlabAllocatorStats() const {
+  if (slab_allocator_ == nullptr) {
+    return absl::nullopt;
+  }
+  return slab_allocator_->GetStats();
+}
+
 absl::optional<Allocation> PlasmaAllocator::BuildAllocation(void *addr,
                                                             size_t size,
                                                             bool is_fallback_allocated) {
@@ -20,10 +20,12 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 #include "absl/types/optional.h"
 #include "ray/object_manager/plasma/allocator.h"
 #include "ray/object_manager/plasma/common.h"
+#include "ray/object_manager/plasma/slab_allocator.h"
 
 namespace plasma {
 
@@ -38,12 +40,17 @@ namespace plasma {
 //
 // The FallbackAllocate always allocates memory from a disk
 // based mmapped file.
+//
+// If slab_max_object_size is positive, the Allocate call allocates
+// objects up to that size from slabs in the pre-mmaped file instead,
+// see SlabAllocator.
 class PlasmaAllocator : public IAllocator {
  public:
   PlasmaAllocator(const std::string &plasma_directory,
                   const std::string &fallback_directory,
                   bool hugepage_enabled,
-                  int64_t footprint_limit);
+                  int64_t footprint_limit,
+                  int64_t slab_max_object_size);
 
   /// On linux, it allocates memory from a pre-mmapped file from /dev/shm.
   /// On other system, it allocates memory from a pre-mmapped file on disk.
@@ -77,12 +84,16 @@ class PlasmaAllocator : public IAllocator {
   /// Get the memory footprint limit for this allocator.
   int64_t GetFootprintLimit() const override;
 
-  /// Get the number of bytes allocated so far.
+  /// Get the number of bytes allocated so far. The slabs count as a whole,
+  /// including their free blocks, since they are reserved in the pre-mmaped file.
   int64_t Allocated() const override;
 
   /// Get the number of bytes fallback allocated so far.
   int64_t FallbackAllocated() const override;
 
+  /// Get the memory held by the slab allocator, if enabled.
+  absl::optional<SlabAllocatorStats> GetSlabAllocatorStats() const override;
+
  private:
   absl::optional<Allocation> BuildAllocation(void *addr,
                                              size_t size,
@@ -91,10 +102,13 @@ class PlasmaAllocator : public IAllocator {
  private:
   const int64_t kFootprintLimit;
   const size_t kAlignment;
+  // The bytes of the objects that aren't allocated from slabs.
   int64_t allocated_;
   // TODO(scv119): once we refactor object_manager this no longer
   // need to be atomic.
   std::atomic<int64_t> fallback_allocated_;
+  // Allocates small objects from the pre-mmaped file, if enabled.
+  std::unique_ptr<SlabAllocator> slab_allocator_;
 };
 
 }  // namespace plasma
@@ -387,6 +387,257 @@ Status ReadSealReply(uint8_t *data, size_t size, ObjectID *object_id) {
   return PlasmaErrorStatus(message->error());
 }
 
+// Batched create and seal messages.
+
+namespace {
+
+PlasmaObjectSpec ToPlasmaObjectSpec(const PlasmaObject &object) {
+  return PlasmaObjectSpec(FD2INT(object.store_fd.first),
+                          object.store_fd.second,
+                          object.header_offset,
+                          object.data_offset,
+                          object.data_size,
+                          object.metadata_offset,
+                          object.metadata_size,
+                          object.allocated_size,
+                          object.fallback_allocated,
+                          object.device_num,
+                          object.is_experimental_mutable_object);
+}
+
+PlasmaObject FromPlasmaObjectSpec(const PlasmaObjectSpec &spec) {
+  PlasmaObject object = {};
+  object.store_fd.first = INT2FD(spec.segment_index());
+  object.store_fd.second = spec.unique_fd_id();
+  object.header_offset = spec.header_offset();
+  object.data_offset = spec.data_offset();
+  object.data_size = spec.data_size();
+  object.metadata_offset = spec.metadata_offset();
+  object.metadata_size = spec.metadata_size();
+  object.allocated_size = spec.allocated_size();
+  object.fallback_allocated = spec.fallback_allocated();
+  object.device_num = spec.device_num();
+  object.is_experimental_mutable_object = spec.is_experimental_mutable_object();
+  return object;
+}
+
+/// Whether a string can be converted with ID::FromBinary without crashing.
+template <typename ID>
+bool IsNilOrIdSize(const flatbuffers::String *binary) {
+  return binary->size() == 0 || binary->size() == ID::Size();
+}
+
+}  // namespace
+
+Status SendCreateBatchRetryRequest(const std::shared_ptr<StoreConn> &store_conn,
+                                   const std::vector<ObjectID> &object_ids,
+                                   uint64_t request_id) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaCreateBatchRetryRequest(
+      fbb, ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()), request_id);
+  return PlasmaSend(
+      store_conn, MessageType::PlasmaCreateBatchRetryRequest, &fbb, message);
+}
+
+Status ReadCreateBatchRetryRequest(uint8_t *data,
+                                   size_t size,
+                                   std::vector<ObjectID> *object_ids,
+                                   uint64_t *request_id) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaCreateBatchRetryRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  ConvertToVector(message->object_ids(), object_ids, [](const flatbuffers::String &id) {
+    return ObjectID::FromBinary(id.str());
+  });
+  *request_id = message->request_id();
+  return Status::OK();
+}
+
+Status SendCreateBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                              const std::vector<ObjectID> &object_ids,
+                              const ray::rpc::Address &owner_address,
+                              const std::vector<int64_t> &data_sizes,
+                              const std::vector<int64_t> &metadata_sizes,
+                              flatbuf::ObjectSource source) {
+  RAY_CHECK(object_ids.size() == data_sizes.size());
+  RAY_CHECK(object_ids.size() == metadata_sizes.size());
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<uint64_t> data_sizes_unsigned(data_sizes.begin(), data_sizes.end());
+  std::vector<uint64_t> metadata_sizes_unsigned(metadata_sizes.begin(),
+                                                metadata_sizes.end());
+  auto message = fb::CreatePlasmaCreateBatchRequest(
+      fbb,
+      ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()),
+      fbb.CreateString(owner_address.raylet_id()),
+      fbb.CreateString(owner_address.ip_address()),
+      owner_address.port(),
+      fbb.CreateString(owner_address.worker_id()),
+      fbb.CreateVector(MakeNonNull(data_sizes_unsigned.data()),
+                       data_sizes_unsigned.size()),
+      fbb.CreateVector(MakeNonNull(metadata_sizes_unsigned.data()),
+                       metadata_sizes_unsigned.size()),
+      source);
+  return PlasmaSend(store_conn, MessageType::PlasmaCreateBatchRequest, &fbb, message);
+}
+
+Status ReadCreateBatchRequest(uint8_t *data,
+                              size_t size,
+                              std::vector<ray::ObjectInfo> *object_infos,
+                              flatbuf::ObjectSource *source) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaCreateBatchRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  if (message->object_ids() == nullptr || message->data_sizes() == nullptr ||
+      message->metadata_sizes() == nullptr ||
+      message->object_ids()->size() != message->data_sizes()->size() ||
+      message->object_ids()->size() != message->metadata_sizes()->size() ||
+      message->owner_raylet_id() == nullptr || message->owner_ip_address() == nullptr ||
+      message->owner_worker_id() == nullptr ||
+      !IsNilOrIdSize<NodeID>(message->owner_raylet_id()) ||
+      !IsNilOrIdSize<WorkerID>(message->owner_worker_id())) {
+    return Status::Invalid("Malformed create batch request.");
+  }
+  for (const auto *object_id : *message->object_ids()) {
+    if (object_id == nullptr || object_id->size() != ObjectID::Size()) {
+      return Status::Invalid("Malformed object ID in create batch request.");
+    }
+  }
+  const auto owner_raylet_id = NodeID::FromBinary(message->owner_raylet_id()->str());
+  const auto owner_worker_id = WorkerID::FromBinary(message->owner_worker_id()->str());
+  object_infos->clear();
+  object_infos->reserve(message->object_ids()->size());
+  for (uoffset_t i = 0; i < message->object_ids()->size(); i++) {
+    ray::ObjectInfo object_info;
+    object_info.object_id = ObjectID::FromBinary(message->object_ids()->Get(i)->str());
+    object_info.is_mutable = false;
+    object_info.data_size = message->data_sizes()->Get(i);
+    object_info.metadata_size = message->metadata_sizes()->Get(i);
+    object_info.owner_raylet_id = owner_raylet_id;
+    object_info.owner_ip_address = message->owner_ip_address()->str();
+    object_info.owner_port = message->owner_port();
+    object_info.owner_worker_id = owner_worker_id;
+    object_infos->push_back(std::move(object_info));
+  }
+  *source = message->source();
+  return Status::OK();
+}
+
+Status SendUnfinishedCreateBatchReply(const std::shared_ptr<Client> &client,
+                                      const std::vector<ObjectID> &object_ids,
+                                      uint64_t retry_with_request_id) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto object_ids_offset = ToFlatbuffer(&fbb, object_ids.data(), object_ids.size());
+  fb::PlasmaCreateBatchReplyBuilder crb(fbb);
+  crb.add_object_ids(object_ids_offset);
+  crb.add_retry_with_request_id(retry_with_request_id);
+  auto message = crb.Finish();
+  return PlasmaSend(client, MessageType::PlasmaCreateBatchReply, &fbb, message);
+}
+
+Status SendCreateBatchReply(const std::shared_ptr<Client> &client,
+                            const std::vector<ObjectID> &object_ids,
+                            const std::vector<PlasmaObject> &objects,
+                            const std::vector<MEMFD_TYPE> &store_fds,
+                            const std::vector<int64_t> &mmap_sizes,
+                            PlasmaError error) {
+  RAY_CHECK(objects.empty() || object_ids.size() == objects.size());
+  RAY_CHECK(store_fds.size() == mmap_sizes.size());
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<PlasmaObjectSpec> specs;
+  specs.reserve(objects.size());
+  for (const auto &object : objects) {
+    specs.push_back(ToPlasmaObjectSpec(object));
+  }
+  std::vector<int> store_fds_as_int;
+  std::vector<int64_t> unique_fd_ids;
+  for (MEMFD_TYPE store_fd : store_fds) {
+    store_fds_as_int.push_back(FD2INT(store_fd.first));
+    unique_fd_ids.push_back(store_fd.second);
+  }
+  auto message = fb::CreatePlasmaCreateBatchReply(
+      fbb,
+      /*retry_with_request_id=*/0,
+      ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()),
+      fbb.CreateVectorOfStructs(MakeNonNull(specs.data()), specs.size()),
+      error,
+      fbb.CreateVector(MakeNonNull(store_fds_as_int.data()), store_fds_as_int.size()),
+      fbb.CreateVector(MakeNonNull(unique_fd_ids.data()), unique_fd_ids.size()),
+      fbb.CreateVector(MakeNonNull(mmap_sizes.data()), mmap_sizes.size()));
+  return PlasmaSend(client, MessageType::PlasmaCreateBatchReply, &fbb, message);
+}
+
+Status ReadCreateBatchReply(uint8_t *data,
+                            size_t size,
+                            uint64_t *retry_with_request_id,
+                            std::vector<ObjectID> *object_ids,
+                            std::vector<PlasmaObject> *objects,
+                            std::vector<MEMFD_TYPE> *store_fds,
+                            std::vector<int64_t> *mmap_sizes) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaCreateBatchReply>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  *retry_with_request_id = message->retry_with_request_id();
+  if (*retry_with_request_id > 0) {
+    // The client should retry the request.
+    return Status::OK();
+  }
+
+  ConvertToVector(message->object_ids(), object_ids, [](const flatbuffers::String &id) {
+    return ObjectID::FromBinary(id.str());
+  });
+  ConvertToVector(message->plasma_objects(), objects, FromPlasmaObjectSpec);
+  RAY_CHECK(message->store_fds()->size() == message->mmap_sizes()->size());
+  store_fds->clear();
+  mmap_sizes->clear();
+  for (uoffset_t i = 0; i < message->store_fds()->size(); i++) {
+    store_fds->push_back(
+        {INT2FD(message->store_fds()->Get(i)), message->unique_fd_ids()->Get(i)});
+    mmap_sizes->push_back(message->mmap_sizes()->Get(i));
+  }
+  return PlasmaErrorStatus(message->error());
+}
+
+Status SendSealBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                            const std::vector<ObjectID> &object_ids) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaSealBatchRequest(
+      fbb, ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()));
+  return PlasmaSend(store_conn, MessageType::PlasmaSealBatchRequest, &fbb, message);
+}
+
+Status ReadSealBatchRequest(uint8_t *data,
+                            size_t size,
+                            std::vector<ObjectID> *object_ids) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaSealBatchRequest>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  ConvertToVector(message->object_ids(), object_ids, [](const flatbuffers::String &id) {
+    return ObjectID::FromBinary(id.str());
+  });
+  return Status::OK();
+}
+
+Status SendSealBatchReply(const std::shared_ptr<Client> &client,
+                          const std::vector<ObjectID> &object_ids,
+                          PlasmaError error) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaSealBatchReply(
+      fbb, ToFlatbuffer(&fbb, object_ids.data(), object_ids.size()), error);
+  return PlasmaSend(client, MessageType::PlasmaSealBatchReply, &fbb, message);
+}
+
+Status ReadSealBatchReply(uint8_t *data,
+                          size_t size,
+                          std::vector<ObjectID> *object_ids) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaSealBatchReply>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  ConvertToVector(message->object_ids(), object_ids, [](const flatbuffers::String &id) {
+    return ObjectID::FromBinary(id.str());
+  });
+  return PlasmaErrorStatus(message->error());
+}
+
 // Release messages.
 
 Status SendReleaseRequest(const std::shared_ptr<StoreConn> &store_conn,
@@ -554,6 +805,29 @@ Status ReadConnectReply(uint8_t *data, size_t size, int64_t *memory_capacity) {
   return Status::OK();
 }
 
+// ConnectRing messages.
+
+Status SendConnectRingRequest(const std::shared_ptr<StoreConn> &store_conn) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaConnectRingRequest(fbb);
+  return PlasmaSend(store_conn, MessageType::PlasmaConnectRingRequest, &fbb, message);
+}
+
+Status SendConnectRingReply(const std::shared_ptr<Client> &client,
+                            uint64_t ring_capacity) {
+  flatbuffers::FlatBufferBuilder fbb;
+  auto message = fb::CreatePlasmaConnectRingReply(fbb, ring_capacity);
+  return PlasmaSend(client, MessageType::PlasmaConnectRingReply, &fbb, message);
+}
+
+Status ReadConnectRingReply(uint8_t *data, size_t size, uint64_t *ring_capacity) {
+  RAY_DCHECK(data);
+  auto message = flatbuffers::GetRoot<fb::PlasmaConnectRingReply>(data);
+  RAY_DCHECK(VerifyFlatbuffer(message, data, size));
+  *ring_capacity = message->ring_capacity();
+  return Status::OK();
+}
+
 // Evict messages.
 
 Status SendEvictRequest(const std::shared_ptr<StoreConn> &store_conn, int64_t num_bytes) {
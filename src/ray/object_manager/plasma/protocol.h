@@ -135,6 +135,63 @@ Status SendSealReply(const std::shared_ptr<Client> &client,
 
 Status ReadSealReply(uint8_t *data, size_t size, ObjectID *object_id);
 
+/* Plasma batched Create and Seal message functions. */
+
+Status SendCreateBatchRetryRequest(const std::shared_ptr<StoreConn> &store_conn,
+                                   const std::vector<ObjectID> &object_ids,
+                                   uint64_t request_id);
+
+Status ReadCreateBatchRetryRequest(uint8_t *data,
+                                   size_t size,
+                                   std::vector<ObjectID> *object_ids,
+                                   uint64_t *request_id);
+
+Status SendCreateBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                              const std::vector<ObjectID> &object_ids,
+                              const ray::rpc::Address &owner_address,
+                              const std::vector<int64_t> &data_sizes,
+                              const std::vector<int64_t> &metadata_sizes,
+                              flatbuf::ObjectSource source);
+
+Status ReadCreateBatchRequest(uint8_t *data,
+                              size_t size,
+                              std::vector<ray::ObjectInfo> *object_infos,
+                              flatbuf::ObjectSource *source);
+
+Status SendUnfinishedCreateBatchReply(const std::shared_ptr<Client> &client,
+                                      const std::vector<ObjectID> &object_ids,
+                                      uint64_t retry_with_request_id);
+
+Status SendCreateBatchReply(const std::shared_ptr<Client> &client,
+                            const std::vector<ObjectID> &object_ids,
+                            const std::vector<PlasmaObject> &objects,
+                            const std::vector<MEMFD_TYPE> &store_fds,
+                            const std::vector<int64_t> &mmap_sizes,
+                            PlasmaError error);
+
+Status ReadCreateBatchReply(uint8_t *data,
+                            size_t size,
+                            uint64_t *retry_with_request_id,
+                            std::vector<ObjectID> *object_ids,
+                            std::vector<PlasmaObject> *objects,
+                            std::vector<MEMFD_TYPE> *store_fds,
+                            std::vector<int64_t> *mmap_sizes);
+
+Status SendSealBatchRequest(const std::shared_ptr<StoreConn> &store_conn,
+                            const std::vector<ObjectID> &object_ids);
+
+Status ReadSealBatchRequest(uint8_t *data,
+                            size_t size,
+                            std::vector<ObjectID> *object_ids);
+
+Status SendSealBatchReply(const std::shared_ptr<Client> &client,
+                          const std::vector<ObjectID> &object_ids,
+                          PlasmaError error);
+
+Status ReadSealBatchReply(uint8_t *data,
+                          size_t size,
+                          std::vector<ObjectID> *object_ids);
+
 /* Plasma Get message functions. */
 
 Status SendGetRequest(const std::shared_ptr<StoreConn> &store_conn,
@@ -227,6 +284,15 @@ Status SendConnectReply(const std::shared_ptr<Client> &client, int64_t memory_ca
 
 Status ReadConnectReply(uint8_t *data, size_t size, int64_t *memory_capacity);
 
+/* Plasma ConnectRing message functions. */
+
+Status SendConnectRingRequest(const std::shared_ptr<StoreConn> &store_conn);
+
+Status SendConnectRingReply(const std::shared_ptr<Client> &client,
+                            uint64_t ring_capacity);
+
+Status ReadConnectRingReply(uint8_t *data, size_t size, uint64_t *ring_capacity);
+
 /* Plasma Evict message functions (no reply so far). */
 
 Status SendEvictRequest(const std::shared_ptr<StoreConn> &store_conn, int64_t num_bytes);
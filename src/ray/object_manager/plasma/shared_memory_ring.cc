@@ -0,0 +1,356 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/shared_memory_ring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "ray/util/logging.h"
+
+namespace plasma {
+
+namespace {
+/// The number of times to poll the ring before going to sleep. Polling can't
+/// make progress with a single CPU, since the peer can't run meanwhile.
+int SpinIterations() {
+  static const int spin_iterations =
+      std::thread::hardware_concurrency() > 1 ? 4096 : 0;
+  return spin_iterations;
+}
+/// How long to sleep before checking whether the peer is still alive.
+constexpr int64_t kWaitTimeoutMs = 100;
+
+/// Sleep until the value at the address isn't the expected value anymore, the
+/// sleeper is woken up, or the timeout expires.
+void FutexWait(std::atomic<uint32_t> *address, uint32_t expected) {
+#ifdef __linux__
+  // Not FUTEX_PRIVATE_FLAG: the waker is in another process.
+  struct timespec timeout = {0, kWaitTimeoutMs * 1000 * 1000};
+  syscall(SYS_futex,
+          reinterpret_cast<uint32_t *>(address),
+          FUTEX_WAIT,
+          expected,
+          &timeout,
+          nullptr,
+          0);
+#else
+  if (address->load() == expected) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+#endif
+}
+
+void FutexWake(std::atomic<uint32_t> *address) {
+#ifdef __linux__
+  syscall(SYS_futex,
+          reinterpret_cast<uint32_t *>(address),
+          FUTEX_WAKE,
+          1,
+          nullptr,
+          nullptr,
+          0);
+#endif
+}
+
+size_t RoundUpToPowerOfTwo(size_t size) {
+  size_t result = 1;
+  while (result < size) {
+    result <<= 1;
+  }
+  return result;
+}
+}  // namespace
+
+/// The positions are the total number of bytes written and read, so that the
+/// ring is full when they differ by the capacity. Each end of the ring sets its
+/// waiting flag before it goes to sleep, and the other end wakes it up if the
+/// flag is set after it moves its position.
+struct SharedMemoryRing::Header {
+  alignas(64) std::atomic<uint64_t> write_position;
+  std::atomic<uint32_t> data_sequence;
+  std::atomic<uint32_t> consumer_waiting;
+  alignas(64) std::atomic<uint64_t> read_position;
+  std::atomic<uint32_t> space_sequence;
+  std::atomic<uint32_t> producer_waiting;
+};
+
+size_t SharedMemoryRing::RegionSize(size_t capacity) {
+  return sizeof(Header) + capacity;
+}
+
+void SharedMemoryRing::Initialize(uint8_t *region, size_t capacity) {
+  RAY_CHECK(capacity > 0 && (capacity & (capacity - 1)) == 0)
+      << "The capacity of a ring must be a power of two, got " << capacity;
+  new (region) Header{};
+}
+
+SharedMemoryRing::SharedMemoryRing(uint8_t *region, size_t capacity, int consumer_eventfd)
+    : header_(reinterpret_cast<Header *>(region)),
+      data_(region + sizeof(Header)),
+      capacity_(capacity),
+      consumer_eventfd_(consumer_eventfd) {}
+
+size_t SharedMemoryRing::ReadableBytes() const {
+  return header_->write_position.load(std::memory_order_acquire) -
+         header_->read_position.load(std::memory_order_relaxed);
+}
+
+size_t SharedMemoryRing::WriteSome(const uint8_t *data, size_t size) {
+  uint64_t write_position = header_->write_position.load(std::memory_order_relaxed);
+  uint64_t read_position = header_->read_position.load(std::memory_order_acquire);
+  size = std::min(size, capacity_ - (write_position - read_position));
+  if (size == 0) {
+    return 0;
+  }
+  size_t offset = write_position & (capacity_ - 1);
+  size_t first = std::min(size, capacity_ - offset);
+  memcpy(data_ + offset, data, first);
+  memcpy(data_, data + first, size - first);
+  header_->write_position.store(write_position + size, std::memory_order_release);
+  return size;
+}
+
+size_t SharedMemoryRing::ReadSome(uint8_t *data, size_t size) {
+  uint64_t read_position = header_->read_position.load(std::memory_order_relaxed);
+  uint64_t write_position = header_->write_position.load(std::memory_order_acquire);
+  size = std::min(size, static_cast<size_t>(write_position - read_position));
+  if (size == 0) {
+    return 0;
+  }
+  size_t offset = read_position & (capacity_ - 1);
+  size_t first = std::min(size, capacity_ - offset);
+  memcpy(data, data_ + offset, first);
+  memcpy(data + first, data_, size - first);
+  header_->read_position.store(read_position + size, std::memory_order_release);
+  return size;
+}
+
+void SharedMemoryRing::NotifyConsumer() {
+  header_->data_sequence.fetch_add(1, std::memory_order_seq_cst);
+  if (header_->consumer_waiting.exchange(0, std::memory_order_seq_cst) == 0) {
+    return;
+  }
+  if (consumer_eventfd_ == -1) {
+    FutexWake(&header_->data_sequence);
+    return;
+  }
+#ifdef __linux__
+  uint64_t one = 1;
+  // The eventfd only fails to be written to if its counter overflows, in which
+  // case the consumer is awake anyway.
+  ssize_t written = write(consumer_eventfd_, &one, sizeof(one));
+  RAY_UNUSED(written);
+#endif
+}
+
+void SharedMemoryRing::NotifyProducer() {
+  header_->space_sequence.fetch_add(1, std::memory_order_seq_cst);
+  if (header_->producer_waiting.exchange(0, std::memory_order_seq_cst) != 0) {
+    FutexWake(&header_->space_sequence);
+  }
+}
+
+ray::Status SharedMemoryRing::Write(
+    const std::vector<std::pair<const uint8_t *, size_t>> &buffers,
+    const std::function<bool()> &is_peer_alive) {
+  int spins = 0;
+  for (const auto &[data, size] : buffers) {
+    size_t written = 0;
+    while (written < size) {
+      size_t bytes = WriteSome(data + written, size - written);
+      written += bytes;
+      if (bytes > 0) {
+        spins = 0;
+        continue;
+      }
+      if (spins == 0) {
+        // The ring is full. Let the consumer drain what we wrote so far.
+        NotifyConsumer();
+      }
+      if (++spins < SpinIterations()) {
+        continue;
+      }
+      uint32_t sequence = header_->space_sequence.load(std::memory_order_seq_cst);
+      header_->producer_waiting.store(1, std::memory_order_seq_cst);
+      if (header_->read_position.load(std::memory_order_seq_cst) + capacity_ >
+          header_->write_position.load(std::memory_order_relaxed)) {
+        // Some space was freed in between.
+        continue;
+      }
+      FutexWait(&header_->space_sequence, sequence);
+      if (header_->space_sequence.load(std::memory_order_seq_cst) == sequence &&
+          !is_peer_alive()) {
+        return ray::Status::IOError("The reader of the shared memory ring is gone.");
+      }
+    }
+  }
+  NotifyConsumer();
+  return ray::Status::OK();
+}
+
+size_t SharedMemoryRing::TryRead(uint8_t *data, size_t size) {
+  size_t bytes = ReadSome(data, size);
+  if (bytes > 0) {
+    NotifyProducer();
+  }
+  return bytes;
+}
+
+ray::Status SharedMemoryRing::Read(uint8_t *data,
+                                   size_t size,
+                                   const std::function<bool()> &is_peer_alive) {
+  size_t read = 0;
+  int spins = 0;
+  while (read < size) {
+    size_t bytes = TryRead(data + read, size - read);
+    read += bytes;
+    if (bytes > 0) {
+      spins = 0;
+      continue;
+    }
+    if (++spins < SpinIterations()) {
+      continue;
+    }
+    uint32_t sequence = header_->data_sequence.load(std::memory_order_seq_cst);
+    header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+    if (ReadableBytes() > 0) {
+      continue;
+    }
+    FutexWait(&header_->data_sequence, sequence);
+    if (header_->data_sequence.load(std::memory_order_seq_cst) == sequence &&
+        !is_peer_alive()) {
+      return ray::Status::IOError("The writer of the shared memory ring is gone.");
+    }
+  }
+  return ray::Status::OK();
+}
+
+bool SharedMemoryRing::PrepareToWait() {
+  header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+  // The producer may have written before it saw the flag.
+  return header_->write_position.load(std::memory_order_seq_cst) ==
+         header_->read_position.load(std::memory_order_relaxed);
+}
+
+std::unique_ptr<SharedMemoryTransport> SharedMemoryTransport::Create(
+    size_t ring_capacity) {
+  ring_capacity = RoundUpToPowerOfTwo(ring_capacity);
+#ifdef __linux__
+  size_t ring_size = SharedMemoryRing::RegionSize(ring_capacity);
+  int shm_fd = -1;
+#ifdef SYS_memfd_create
+  shm_fd = syscall(SYS_memfd_create, "plasma_ring", 0);
+#endif
+  if (shm_fd == -1) {
+    // Same as the plasma allocator, for kernels without memfd_create.
+    char file_name[] = "/dev/shm/plasmaRingXXXXXX";
+    shm_fd = mkstemp(file_name);
+    if (shm_fd == -1) {
+      RAY_LOG(WARNING) << "Failed to create the shared memory of a plasma ring: "
+                       << strerror(errno);
+      return nullptr;
+    }
+    unlink(file_name);
+  }
+  if (ftruncate(shm_fd, 2 * ring_size) != 0) {
+    RAY_LOG(WARNING) << "Failed to size the shared memory of a plasma ring: "
+                     << strerror(errno);
+    close(shm_fd);
+    return nullptr;
+  }
+  int event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (event_fd == -1) {
+    RAY_LOG(WARNING) << "Failed to create the eventfd of a plasma ring: "
+                     << strerror(errno);
+    close(shm_fd);
+    return nullptr;
+  }
+  void *region =
+      mmap(nullptr, 2 * ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+  if (region == MAP_FAILED) {
+    RAY_LOG(WARNING) << "Failed to map the shared memory of a plasma ring: "
+                     << strerror(errno);
+    close(shm_fd);
+    close(event_fd);
+    return nullptr;
+  }
+  SharedMemoryRing::Initialize(static_cast<uint8_t *>(region), ring_capacity);
+  SharedMemoryRing::Initialize(static_cast<uint8_t *>(region) + ring_size,
+                               ring_capacity);
+  return std::unique_ptr<SharedMemoryTransport>(new SharedMemoryTransport(
+      shm_fd, event_fd, static_cast<uint8_t *>(region), ring_capacity));
+#else
+  return nullptr;
+#endif
+}
+
+std::unique_ptr<SharedMemoryTransport> SharedMemoryTransport::Attach(
+    int shm_fd, int eventfd, size_t ring_capacity) {
+#ifdef __linux__
+  size_t ring_size = SharedMemoryRing::RegionSize(ring_capacity);
+  void *region =
+      mmap(nullptr, 2 * ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+  if (region == MAP_FAILED) {
+    RAY_LOG(WARNING) << "Failed to map the shared memory of a plasma ring: "
+                     << strerror(errno);
+    close(shm_fd);
+    close(eventfd);
+    return nullptr;
+  }
+  return std::unique_ptr<SharedMemoryTransport>(new SharedMemoryTransport(
+      shm_fd, eventfd, static_cast<uint8_t *>(region), ring_capacity));
+#else
+  return nullptr;
+#endif
+}
+
+SharedMemoryTransport::SharedMemoryTransport(int shm_fd,
+                                             int eventfd,
+                                             uint8_t *region,
+                                             size_t ring_capacity)
+    : shm_fd_(shm_fd),
+      eventfd_(eventfd),
+      region_(region),
+      ring_capacity_(ring_capacity) {
+  size_t ring_size = SharedMemoryRing::RegionSize(ring_capacity);
+  // Only the store waits for requests in its event loop, and only the client
+  // waits for replies.
+  requests_ = std::make_unique<SharedMemoryRing>(region, ring_capacity, eventfd);
+  replies_ = std::make_unique<SharedMemoryRing>(
+      region + ring_size, ring_capacity, /*consumer_eventfd=*/-1);
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+#ifdef __linux__
+  munmap(region_, 2 * SharedMemoryRing::RegionSize(ring_capacity_));
+  close(shm_fd_);
+  close(eventfd_);
+#endif
+}
+
+}  // namespace plasma
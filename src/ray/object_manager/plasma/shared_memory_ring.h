@@ -0,0 +1,164 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ray/common/status.h"
+#include "ray/util/macros.h"
+
+namespace plasma {
+
+/// A byte stream from one process to another through a ring buffer in shared
+/// memory, with a single producer and a single consumer. Reads and writes don't
+/// take locks or make system calls, except to wake up the other end when it is
+/// blocked waiting for data or space.
+///
+/// A blocked producer is woken up with a futex. A blocked consumer is woken up
+/// with a futex too, or by writing to an eventfd if it waits in an event loop.
+///
+/// The same ring must not be written or read by several threads at once.
+class SharedMemoryRing {
+ public:
+  /// The size of the memory region for a ring of the given capacity.
+  static size_t RegionSize(size_t capacity);
+
+  /// Initialize a ring in a memory region. This must be done once, before any
+  /// end of the ring uses it.
+  ///
+  /// \param region The memory region, of at least RegionSize(capacity) bytes.
+  /// \param capacity The capacity in bytes. Must be a power of two.
+  static void Initialize(uint8_t *region, size_t capacity);
+
+  /// Attach to a ring.
+  ///
+  /// \param region The memory region of the ring.
+  /// \param capacity The capacity in bytes the ring was initialized with.
+  /// \param consumer_eventfd The eventfd to wake up the consumer with, or -1 to
+  /// wake it up with a futex.
+  SharedMemoryRing(uint8_t *region, size_t capacity, int consumer_eventfd);
+
+  /// Write the buffers, waiting while the ring is full.
+  ///
+  /// \param buffers The buffers to write, in order.
+  /// \param is_peer_alive Called when waiting for a while. The write fails if
+  /// it returns false.
+  /// \return Status.
+  ray::Status Write(const std::vector<std::pair<const uint8_t *, size_t>> &buffers,
+                    const std::function<bool()> &is_peer_alive);
+
+  /// Read exactly the given number of bytes, waiting while the ring is empty.
+  ///
+  /// \param data The buffer to read into.
+  /// \param size The number of bytes to read.
+  /// \param is_peer_alive Called when waiting for a while. The read fails if it
+  /// returns false.
+  /// \return Status.
+  ray::Status Read(uint8_t *data,
+                   size_t size,
+                   const std::function<bool()> &is_peer_alive);
+
+  /// Read the bytes available, up to the given number, without waiting.
+  ///
+  /// \return The number of bytes read.
+  size_t TryRead(uint8_t *data, size_t size);
+
+  /// Tell the producer that the consumer is about to wait for the eventfd.
+  ///
+  /// \return Whether the consumer should wait. False if there are bytes to read.
+  bool PrepareToWait();
+
+  /// The number of bytes available to read.
+  size_t ReadableBytes() const;
+
+  size_t Capacity() const { return capacity_; }
+
+ private:
+  struct Header;
+
+  size_t WriteSome(const uint8_t *data, size_t size);
+
+  size_t ReadSome(uint8_t *data, size_t size);
+
+  void NotifyConsumer();
+
+  void NotifyProducer();
+
+  Header *header_;
+  uint8_t *data_;
+  const size_t capacity_;
+  const int consumer_eventfd_;
+
+  RAY_DISALLOW_COPY_AND_ASSIGN(SharedMemoryRing);
+};
+
+/// The rings through which a plasma client and the store exchange messages
+/// instead of their socket: one for the requests of the client, and one for the
+/// replies of the store. The store waits for requests with an eventfd, so that
+/// it can wait for the requests of all clients in its event loop.
+class SharedMemoryTransport {
+ public:
+  /// Create a transport, in the store. Its file descriptors are then sent to
+  /// the client.
+  ///
+  /// \param ring_capacity The capacity of each ring. Rounded up to a power of
+  /// two.
+  /// \return The transport, or nullptr if it isn't supported on this platform.
+  static std::unique_ptr<SharedMemoryTransport> Create(size_t ring_capacity);
+
+  /// Attach to a transport created by the store, in the client.
+  ///
+  /// \param shm_fd The file descriptor of the shared memory. Closed by the
+  /// transport.
+  /// \param eventfd The eventfd that wakes up the store. Closed by the transport.
+  /// \param ring_capacity The capacity of each ring, as created.
+  /// \return The transport, or nullptr if the shared memory can't be mapped.
+  static std::unique_ptr<SharedMemoryTransport> Attach(int shm_fd,
+                                                       int eventfd,
+                                                       size_t ring_capacity);
+
+  ~SharedMemoryTransport();
+
+  /// The ring of requests, from the client to the store.
+  SharedMemoryRing &Requests() { return *requests_; }
+
+  /// The ring of replies, from the store to the client.
+  SharedMemoryRing &Replies() { return *replies_; }
+
+  int ShmFd() const { return shm_fd_; }
+
+  int EventFd() const { return eventfd_; }
+
+  size_t RingCapacity() const { return ring_capacity_; }
+
+ private:
+  SharedMemoryTransport(int shm_fd, int eventfd, uint8_t *region, size_t ring_capacity);
+
+  const int shm_fd_;
+  const int eventfd_;
+  uint8_t *const region_;
+  const size_t ring_capacity_;
+  std::unique_ptr<SharedMemoryRing> requests_;
+  std::unique_ptr<SharedMemoryRing> replies_;
+
+  RAY_DISALLOW_COPY_AND_ASSIGN(SharedMemoryTransport);
+};
+
+}  // namespace plasma
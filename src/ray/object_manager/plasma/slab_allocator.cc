@@ -0,0 +1,163 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/slab_allocator.h"
+
+#include <algorithm>
+
+#include "ray/util/logging.h"
+
+namespace plasma {
+
+namespace {
+// The size of the smallest blocks.
+const size_t kMinBlockSize = 4 * 1024;
+
+// Slabs have at least this size and hold at least this many blocks, so that slabs
+// of large blocks aren't mostly empty and small blocks don't need many slabs.
+const size_t kMinSlabSize = 4 * 1024 * 1024;
+const size_t kMinBlocksPerSlab = 8;
+
+// The number of size classes between two powers of two.
+const size_t kSizeClassesPerDoubling = 4;
+
+size_t RoundUp(size_t bytes, size_t alignment) {
+  return (bytes + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+SlabAllocator::SlabAllocator(size_t max_block_size,
+                             size_t alignment,
+                             std::function<void *(size_t)> allocate_slab,
+                             std::function<void(void *)> free_slab)
+    : max_block_size_(RoundUp(max_block_size, alignment)),
+      allocate_slab_(std::move(allocate_slab)),
+      free_slab_(std::move(free_slab)) {
+  RAY_CHECK(alignment > 0 && (alignment & (alignment - 1)) == 0) << alignment;
+  RAY_CHECK(max_block_size_ > 0);
+  size_t block_size = RoundUp(std::min(kMinBlockSize, max_block_size_), alignment);
+  for (size_t power_of_two = block_size; block_size < max_block_size_;
+       power_of_two *= 2) {
+    for (size_t i = 0; i < kSizeClassesPerDoubling; i++) {
+      block_size = std::min(
+          RoundUp(power_of_two + power_of_two * i / kSizeClassesPerDoubling, alignment),
+          max_block_size_);
+      if (size_classes_.empty() || size_classes_.back().block_size < block_size) {
+        size_classes_.push_back(SizeClass{block_size, 0, {}});
+      }
+    }
+  }
+  if (size_classes_.empty()) {
+    size_classes_.push_back(SizeClass{block_size, 0, {}});
+  }
+  for (auto &size_class : size_classes_) {
+    size_class.blocks_per_slab = static_cast<uint32_t>(
+        std::max(kMinBlocksPerSlab, RoundUp(kMinSlabSize, size_class.block_size) /
+                                        size_class.block_size));
+  }
+}
+
+SlabAllocator::~SlabAllocator() {
+  for (auto &entry : slabs_) {
+    free_slab_(entry.second->address);
+  }
+}
+
+size_t SlabAllocator::SizeClassIndex(size_t bytes) const {
+  auto it = std::lower_bound(
+      size_classes_.begin(),
+      size_classes_.end(),
+      bytes,
+      [](const SizeClass &size_class, size_t bytes) {
+        return size_class.block_size < bytes;
+      });
+  RAY_CHECK(it != size_classes_.end())
+      << bytes << " bytes is larger than the max block size " << max_block_size_;
+  return it - size_classes_.begin();
+}
+
+size_t SlabAllocator::BlockSize(size_t bytes) const {
+  return size_classes_[SizeClassIndex(bytes)].block_size;
+}
+
+void *SlabAllocator::Allocate(size_t bytes) {
+  auto index = SizeClassIndex(bytes);
+  auto &size_class = size_classes_[index];
+  if (size_class.slabs_with_free_blocks.empty()) {
+    size_t slab_size = size_class.block_size * size_class.blocks_per_slab;
+    auto address = static_cast<uint8_t *>(allocate_slab_(slab_size));
+    if (address == nullptr) {
+      return nullptr;
+    }
+    auto slab = std::make_unique<Slab>();
+    slab->address = address;
+    slab->size_class = index;
+    slab->free_blocks.reserve(size_class.blocks_per_slab);
+    for (uint32_t i = size_class.blocks_per_slab; i > 0; i--) {
+      slab->free_blocks.push_back(i - 1);
+    }
+    size_class.slabs_with_free_blocks.insert(slab.get());
+    slabs_.emplace(reinterpret_cast<uintptr_t>(address), std::move(slab));
+    stats_.num_slabs++;
+    stats_.slab_bytes += slab_size;
+  }
+
+  auto slab = *size_class.slabs_with_free_blocks.begin();
+  auto block = slab->free_blocks.back();
+  slab->free_blocks.pop_back();
+  if (slab->free_blocks.empty()) {
+    size_class.slabs_with_free_blocks.erase(slab);
+  }
+  stats_.block_bytes += size_class.block_size;
+  stats_.requested_bytes += bytes;
+  return slab->address + static_cast<size_t>(block) * size_class.block_size;
+}
+
+bool SlabAllocator::Free(void *address, size_t bytes) {
+  auto key = reinterpret_cast<uintptr_t>(address);
+  auto it = slabs_.upper_bound(key);
+  if (it == slabs_.begin()) {
+    return false;
+  }
+  it--;
+  auto slab = it->second.get();
+  auto &size_class = size_classes_[slab->size_class];
+  auto offset = key - it->first;
+  if (offset >= size_class.block_size * size_class.blocks_per_slab) {
+    return false;
+  }
+  RAY_CHECK(offset % size_class.block_size == 0)
+      << "Address " << address << " is not the start of a block.";
+  if (slab->free_blocks.empty()) {
+    size_class.slabs_with_free_blocks.insert(slab);
+  }
+  slab->free_blocks.push_back(static_cast<uint32_t>(offset / size_class.block_size));
+  stats_.block_bytes -= size_class.block_size;
+  stats_.requested_bytes -= bytes;
+  if (slab->free_blocks.size() == size_class.blocks_per_slab) {
+    FreeSlab(slab);
+  }
+  return true;
+}
+
+void SlabAllocator::FreeSlab(Slab *slab) {
+  auto &size_class = size_classes_[slab->size_class];
+  size_class.slabs_with_free_blocks.erase(slab);
+  stats_.num_slabs--;
+  stats_.slab_bytes -= size_class.block_size * size_class.blocks_per_slab;
+  free_slab_(slab->address);
+  slabs_.erase(reinterpret_cast<uintptr_t>(slab->address));
+}
+
+}  // namespace plasma
@@ -0,0 +1,127 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace plasma {
+
+/// The memory held by a SlabAllocator.
+struct SlabAllocatorStats {
+  int64_t num_slabs = 0;
+  /// The bytes of all slabs.
+  int64_t slab_bytes = 0;
+  /// The bytes of the blocks handed out. The rest of the slabs is free.
+  int64_t block_bytes = 0;
+  /// The bytes requested for the blocks handed out. The rest of the blocks is
+  /// lost to rounding up to the size classes.
+  int64_t requested_bytes = 0;
+};
+
+/// Allocates small objects from slabs: large regions split into blocks of a
+/// single size class, with a free list per slab.
+///
+/// Sizes are rounded up to one of 4 size classes per power of two, so a block
+/// wastes at most 20% of its size. Freed blocks are reused by objects of the same
+/// class instead of being coalesced, so small objects of various sizes created
+/// and deleted at a high rate don't fragment the memory the slabs come from. A
+/// slab is returned as soon as all its blocks are free, so the memory can be
+/// used for large objects again.
+///
+/// This class is not thread safe.
+class SlabAllocator {
+ public:
+  /// Create a slab allocator.
+  ///
+  /// \param max_block_size The max number of bytes to allocate from slabs.
+  /// \param alignment The alignment of the blocks. Must be a power of two, and the
+  /// slabs must be aligned to it.
+  /// \param allocate_slab Allocates a slab of the given size, or returns nullptr.
+  /// \param free_slab Frees a slab.
+  SlabAllocator(size_t max_block_size,
+                size_t alignment,
+                std::function<void *(size_t)> allocate_slab,
+                std::function<void(void *)> free_slab);
+
+  ~SlabAllocator();
+
+  /// Allocate a block of at least the given number of bytes.
+  ///
+  /// \param bytes Number of bytes, at most the max block size.
+  /// \return The block, or nullptr if a slab couldn't be allocated.
+  void *Allocate(size_t bytes);
+
+  /// Free a block, if it was allocated from a slab.
+  ///
+  /// \param address The address of the block.
+  /// \param bytes The number of bytes the block was allocated for.
+  /// \return Whether the address was allocated from a slab.
+  bool Free(void *address, size_t bytes);
+
+  size_t MaxBlockSize() const { return max_block_size_; }
+
+  /// Return the size of the blocks allocated for the given number of bytes.
+  size_t BlockSize(size_t bytes) const;
+
+  SlabAllocatorStats GetStats() const { return stats_; }
+
+ private:
+  struct Slab {
+    uint8_t *address;
+    size_t size_class;
+    /// The indices of the free blocks, used as a stack.
+    std::vector<uint32_t> free_blocks;
+  };
+
+  struct SlabAddressLess {
+    bool operator()(const Slab *a, const Slab *b) const {
+      return a->address < b->address;
+    }
+  };
+
+  struct SizeClass {
+    size_t block_size;
+    uint32_t blocks_per_slab;
+    /// The slabs with free blocks. Blocks are allocated from the lowest one, so that
+    /// the others are more likely to become free.
+    std::set<Slab *, SlabAddressLess> slabs_with_free_blocks;
+  };
+
+  size_t SizeClassIndex(size_t bytes) const;
+
+  void FreeSlab(Slab *slab);
+
+  const size_t max_block_size_;
+
+  const std::function<void *(size_t)> allocate_slab_;
+
+  const std::function<void(void *)> free_slab_;
+
+  /// The size classes, by increasing block size.
+  std::vector<SizeClass> size_classes_;
+
+  /// All slabs by address.
+  std::map<uintptr_t, std::unique_ptr<Slab>> slabs_;
+
+  SlabAllocatorStats stats_;
+};
+
+}  // namespace plasma
@@ -220,6 +220,17 @@ void ObjectStatsCollector::RecordMetrics() const {
       bytes_by_loc_seal_.Get({/* fallback_allocated */ true, /* sealed */ false}),
       {{ray::stats::LocationKey, ray::stats::kObjectLocMmapDisk},
        {ray::stats::ObjectStateKey, ray::stats::kObjectUnsealed}});
+
+  auto slab_stats =
+      allocator_ != nullptr ? allocator_->GetSlabAllocatorStats() : absl::nullopt;
+  if (slab_stats.has_value()) {
+    ray::stats::STATS_object_store_slab_memory.Record(slab_stats->requested_bytes,
+                                                      "USED");
+    ray::stats::STATS_object_store_slab_memory.Record(
+        slab_stats->block_bytes - slab_stats->requested_bytes, "ROUNDING");
+    ray::stats::STATS_object_store_slab_memory.Record(
+        slab_stats->slab_bytes - slab_stats->block_bytes, "FREE");
+  }
 }
 
 void ObjectStatsCollector::GetDebugDump(std::stringstream &buffer) const {
@@ -241,6 +252,18 @@ void ObjectStatsCollector::GetDebugDump(std::stringstream &buffer) const {
   buffer << "- bytes received: " << num_bytes_received_ << "\n";
   buffer << "- objects errored: " << num_objects_errored_ << "\n";
   buffer << "- bytes errored: " << num_bytes_errored_ << "\n";
+
+  auto slab_stats =
+      allocator_ != nullptr ? allocator_->GetSlabAllocatorStats() : absl::nullopt;
+  if (slab_stats.has_value()) {
+    buffer << "\n";
+    buffer << "- slabs: " << slab_stats->num_slabs << "\n";
+    buffer << "- bytes in slabs: " << slab_stats->slab_bytes << "\n";
+    buffer << "- bytes free in slabs: "
+           << slab_stats->slab_bytes - slab_stats->block_bytes << "\n";
+    buffer << "- bytes lost to slab size classes: "
+           << slab_stats->block_bytes - slab_stats->requested_bytes << "\n";
+  }
 }
 
 int64_t ObjectStatsCollector::GetNumBytesInUse() const { return num_bytes_in_use_; }
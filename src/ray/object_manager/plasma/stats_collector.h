@@ -19,6 +19,7 @@
 
 #include <utility>  // std::pair
 
+#include "ray/object_manager/plasma/allocator.h"
 #include "ray/object_manager/plasma/common.h"
 #include "ray/util/counter_map.h"  // CounterMap
 
@@ -31,6 +32,11 @@ namespace plasma {
 // ObjectLifeCycleManager into this class.
 class ObjectStatsCollector {
  public:
+  /// \param allocator The allocator of the objects, to report how fragmented its
+  /// memory is. Can be null.
+  explicit ObjectStatsCollector(const IAllocator *allocator = nullptr)
+      : allocator_(allocator) {}
+
   virtual ~ObjectStatsCollector() = default;
 
   // Called after a new object is created.
@@ -72,6 +78,7 @@ class ObjectStatsCollector {
 
   int64_t GetNumBytesCreatedCurrent() const;
 
+  const IAllocator *allocator_;
   CounterMap<std::pair</* fallback_allocated*/ bool, /*sealed*/ bool>> bytes_by_loc_seal_;
   int64_t num_objects_spillable_ = 0;
   int64_t num_bytes_spillable_ = 0;
@@ -52,6 +52,7 @@
 #include "ray/object_manager/plasma/malloc.h"
 #include "ray/object_manager/plasma/plasma_allocator.h"
 #include "ray/object_manager/plasma/protocol.h"
+#include "ray/object_manager/plasma/shared_memory_ring.h"
 #include "ray/stats/metric_defs.h"
 #include "ray/util/util.h"
 
@@ -175,6 +176,35 @@ PlasmaError PlasmaStore::HandleCreateObjectRequest(const std::shared_ptr<Client>
   return error;
 }
 
+PlasmaError PlasmaStore::HandleCreateBatchRequest(
+    const std::shared_ptr<Client> &client,
+    const std::vector<ray::ObjectInfo> &object_infos,
+    fb::ObjectSource source,
+    bool fallback_allocator,
+    std::vector<PlasmaObject> *objects) {
+  objects->clear();
+  objects->reserve(object_infos.size());
+  for (const auto &object_info : object_infos) {
+    PlasmaObject object = {};
+    auto error = CreateObject(object_info, source, client, fallback_allocator, &object);
+    if (error != PlasmaError::OK) {
+      if (error == PlasmaError::OutOfMemory) {
+        RAY_LOG(DEBUG) << "Not enough memory to create the object "
+                       << object_info.object_id << " in a batch of "
+                       << object_infos.size() << " objects";
+      }
+      // Free the objects created so far, so that the batch is retried as a whole.
+      for (size_t i = 0; i < objects->size(); i++) {
+        RAY_CHECK(AbortObject(object_infos[i].object_id, client) == 1);
+      }
+      objects->clear();
+      return error;
+    }
+    objects->push_back(object);
+  }
+  return PlasmaError::OK;
+}
+
 PlasmaError PlasmaStore::CreateObject(const ray::ObjectInfo &object_info,
                                       fb::ObjectSource source,
                                       const std::shared_ptr<Client> &client,
@@ -406,6 +436,46 @@ Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
     const auto &object_id = ObjectID::FromBinary(request->object_id()->str());
     ReplyToCreateClient(client, object_id, request->request_id());
   } break;
+  case fb::MessageType::PlasmaCreateBatchRequest: {
+    std::vector<ray::ObjectInfo> object_infos;
+    fb::ObjectSource source;
+    RAY_RETURN_NOT_OK(
+        ReadCreateBatchRequest(input, input_size, &object_infos, &source));
+    std::vector<ObjectID> object_ids;
+    size_t total_size = 0;
+    for (const auto &object_info : object_infos) {
+      object_ids.push_back(object_info.object_id);
+      total_size += object_info.GetObjectSize();
+    }
+    if (object_ids.empty()) {
+      RAY_RETURN_NOT_OK(SendCreateBatchReply(client, {}, {}, {}, {}, PlasmaError::OK));
+      break;
+    }
+
+    // absl failed analyze mutex safety for lambda
+    auto handle_create =
+        [this, client, object_infos = std::move(object_infos), source](
+            bool fallback_allocator,
+            std::vector<PlasmaObject> *results) ABSL_NO_THREAD_SAFETY_ANALYSIS {
+          mutex_.AssertHeld();
+          return HandleCreateBatchRequest(
+              client, object_infos, source, fallback_allocator, results);
+        };
+    auto req_id = create_request_queue_.AddBatchRequest(
+        object_ids, client, handle_create, total_size);
+    RAY_LOG(DEBUG) << "Received create request for " << object_ids.size()
+                   << " objects assigned request ID " << req_id << ", " << total_size
+                   << " bytes";
+    ProcessCreateRequests();
+    ReplyToCreateBatchClient(client, object_ids, req_id);
+  } break;
+  case fb::MessageType::PlasmaCreateBatchRetryRequest: {
+    std::vector<ObjectID> object_ids;
+    uint64_t request_id;
+    RAY_RETURN_NOT_OK(
+        ReadCreateBatchRetryRequest(input, input_size, &object_ids, &request_id));
+    ReplyToCreateBatchClient(client, object_ids, request_id);
+  } break;
   case fb::MessageType::PlasmaAbortRequest: {
     RAY_RETURN_NOT_OK(ReadAbortRequest(input, input_size, &object_id));
     RAY_CHECK(AbortObject(object_id, client) == 1) << "To abort an object, the only "
@@ -463,6 +533,12 @@ Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
     SealObjects({object_id});
     RAY_RETURN_NOT_OK(SendSealReply(client, object_id, PlasmaError::OK));
   } break;
+  case fb::MessageType::PlasmaSealBatchRequest: {
+    std::vector<ObjectID> object_ids;
+    RAY_RETURN_NOT_OK(ReadSealBatchRequest(input, input_size, &object_ids));
+    SealObjects(object_ids);
+    RAY_RETURN_NOT_OK(SendSealBatchReply(client, object_ids, PlasmaError::OK));
+  } break;
   case fb::MessageType::PlasmaEvictRequest: {
     // This code path should only be used for testing.
     int64_t num_bytes;
@@ -473,6 +549,16 @@ Status PlasmaStore::ProcessMessage(const std::shared_ptr<Client> &client,
   case fb::MessageType::PlasmaConnectRequest: {
     RAY_RETURN_NOT_OK(SendConnectReply(client, allocator_.GetFootprintLimit()));
   } break;
+  case fb::MessageType::PlasmaConnectRingRequest: {
+    auto transport = SharedMemoryTransport::Create(
+        RayConfig::instance().plasma_shared_memory_transport_ring_size());
+    // The reply goes through the socket, and the transport is used afterwards.
+    RAY_RETURN_NOT_OK(
+        SendConnectRingReply(client, transport ? transport->RingCapacity() : 0));
+    if (transport != nullptr) {
+      RAY_RETURN_NOT_OK(client->UseSharedMemoryTransport(std::move(transport)));
+    }
+  } break;
   case fb::MessageType::PlasmaDisconnectClient:
     RAY_LOG(DEBUG) << "Disconnecting client on fd " << client;
     DisconnectClient(client);
@@ -547,6 +633,37 @@ void PlasmaStore::ReplyToCreateClient(const std::shared_ptr<Client> &client,
   }
 }
 
+void PlasmaStore::ReplyToCreateBatchClient(const std::shared_ptr<Client> &client,
+                                           const std::vector<ObjectID> &object_ids,
+                                           uint64_t req_id) {
+  std::vector<PlasmaObject> results;
+  PlasmaError error;
+  bool finished = create_request_queue_.GetBatchRequestResult(req_id, &results, &error);
+  if (!finished) {
+    static_cast<void>(SendUnfinishedCreateBatchReply(client, object_ids, req_id));
+    return;
+  }
+  RAY_LOG(DEBUG) << "Finishing create request ID " << req_id << " for "
+                 << object_ids.size() << " objects";
+  // Send each file descriptor once, even if several objects are allocated in it.
+  absl::flat_hash_set<MEMFD_TYPE> fds_to_send;
+  std::vector<MEMFD_TYPE> store_fds;
+  std::vector<int64_t> mmap_sizes;
+  for (const auto &result : results) {
+    if (result.device_num == 0 && fds_to_send.insert(result.store_fd).second) {
+      store_fds.push_back(result.store_fd);
+      mmap_sizes.push_back(result.mmap_size);
+    }
+  }
+  auto status =
+      SendCreateBatchReply(client, object_ids, results, store_fds, mmap_sizes, error);
+  if (status.ok() && error == PlasmaError::OK) {
+    for (MEMFD_TYPE store_fd : store_fds) {
+      static_cast<void>(client->SendFd(store_fd));
+    }
+  }
+}
+
 int64_t PlasmaStore::GetConsumedBytes() { return total_consumed_bytes_; }
 
 bool PlasmaStore::IsObjectSpillable(const ObjectID &object_id) {
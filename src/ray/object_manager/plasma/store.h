@@ -220,6 +220,19 @@ class PlasmaStore {
                            const ObjectID &object_id,
                            uint64_t req_id) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  /// Create a batch of objects for a client. Either all of the objects are
+  /// created or, if one of them fails, the ones already created are aborted.
+  PlasmaError HandleCreateBatchRequest(const std::shared_ptr<Client> &client,
+                                       const std::vector<ray::ObjectInfo> &object_infos,
+                                       plasma::flatbuf::ObjectSource source,
+                                       bool fallback_allocator,
+                                       std::vector<PlasmaObject> *objects)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  void ReplyToCreateBatchClient(const std::shared_ptr<Client> &client,
+                                const std::vector<ObjectID> &object_ids,
+                                uint64_t req_id) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   void AddToClientObjectIds(const ObjectID &object_id,
                             std::optional<MEMFD_TYPE> fallback_allocated_fd,
                             const std::shared_ptr<ClientInterface> &client)
@@ -89,7 +89,11 @@ void PlasmaStoreRunner::Start(ray::SpillObjectsCallback spill_objects_callback,
   {
     absl::MutexLock lock(&store_runner_mutex_);
     allocator_ = std::make_unique<PlasmaAllocator>(
-        plasma_directory_, fallback_directory_, hugepages_enabled_, system_memory_);
+        plasma_directory_,
+        fallback_directory_,
+        hugepages_enabled_,
+        system_memory_,
+        RayConfig::instance().plasma_slab_allocator_max_object_size());
 #ifndef _WIN32
     std::vector<std::string> local_spilling_paths;
     if (RayConfig::instance().is_external_storage_type_fs()) {
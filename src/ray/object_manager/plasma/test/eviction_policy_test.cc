@@ -14,8 +14,16 @@
 
 #include "ray/object_manager/plasma/eviction_policy.h"
 
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/random/random.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "ray/object_manager/plasma/object_lifecycle_manager.h"
 #include "ray/object_manager/plasma/object_store.h"
 
 using namespace ray;
@@ -183,6 +191,366 @@ TEST(EvictionPolicyTest, Test) {
     EXPECT_TRUE(policy.IsObjectExists(key1));
   }
 }
+
+TEST(EvictionPolicyTest, TestGdsf) {
+  MockAllocator allocator;
+  MockObjectStore store;
+  EXPECT_CALL(allocator, GetFootprintLimit()).WillRepeatedly(Return(100));
+  EXPECT_CALL(allocator, Allocated()).WillRepeatedly(Return(100));
+  absl::flat_hash_map<ObjectID, std::unique_ptr<LocalObject>> objects;
+  EXPECT_CALL(store, GetObject(_)).WillRepeatedly(Invoke([&](const ObjectID &id) {
+    return objects.at(id).get();
+  }));
+  auto create_object = [&](GdsfEvictionPolicy &policy, int64_t size) {
+    ObjectID id = ObjectID::FromRandom();
+    auto object = std::make_unique<LocalObject>(Allocation());
+    object->object_info.data_size = size;
+    object->object_info.metadata_size = 0;
+    objects.emplace(id, std::move(object));
+    policy.ObjectCreated(id);
+    return id;
+  };
+  auto use_object = [](GdsfEvictionPolicy &policy, const ObjectID &id, int times) {
+    for (int i = 0; i < times; i++) {
+      policy.BeginObjectAccess(id);
+      EXPECT_FALSE(policy.IsObjectEvictable(id));
+      policy.EndObjectAccess(id);
+      EXPECT_TRUE(policy.IsObjectEvictable(id));
+    }
+  };
+
+  {
+    GdsfEvictionPolicy policy(store, allocator);
+    create_object(policy, 10);
+    create_object(policy, 20);
+    create_object(policy, 30);
+    create_object(policy, 40);
+    std::vector<ObjectID> objects_to_evict;
+
+    // Objects that were never used are evicted in the order they were created.
+    // Require 10, need to evict at least 20%, so the first two objects should be evicted.
+    EXPECT_EQ(-20, policy.RequireSpace(10, objects_to_evict));
+    EXPECT_EQ(2, objects_to_evict.size());
+  }
+
+  {
+    GdsfEvictionPolicy policy(store, allocator);
+    ObjectID key1 = create_object(policy, 10);
+    ObjectID key2 = create_object(policy, 20);
+    ObjectID key3 = create_object(policy, 30);
+    ObjectID key4 = create_object(policy, 40);
+    use_object(policy, key4, 3);
+    use_object(policy, key1, 1);
+
+    // The objects that were never used go first.
+    std::vector<ObjectID> objects_to_evict;
+    EXPECT_EQ(50, policy.ChooseObjectsToEvict(50, objects_to_evict));
+    EXPECT_EQ(objects_to_evict, (std::vector<ObjectID>{key2, key3}));
+    policy.RemoveObject(key2);
+    policy.RemoveObject(key3);
+
+    // The large object goes before the small one, even though it was used more often.
+    objects_to_evict.clear();
+    EXPECT_EQ(40, policy.ChooseObjectsToEvict(1, objects_to_evict));
+    EXPECT_EQ(objects_to_evict, (std::vector<ObjectID>{key4}));
+    policy.RemoveObject(key4);
+
+    // New objects age out the objects that aren't used anymore.
+    ObjectID key5 = create_object(policy, 10);
+    use_object(policy, key5, 2);
+    objects_to_evict.clear();
+    EXPECT_EQ(10, policy.ChooseObjectsToEvict(1, objects_to_evict));
+    EXPECT_EQ(objects_to_evict, (std::vector<ObjectID>{key1}));
+    policy.RemoveObject(key1);
+    EXPECT_TRUE(policy.IsObjectEvictable(key5));
+  }
+}
+
+TEST(EvictionPolicyTest, TestCreateEvictionPolicy) {
+  MockAllocator allocator;
+  MockObjectStore store;
+  EXPECT_CALL(allocator, GetFootprintLimit()).WillRepeatedly(Return(100));
+  EXPECT_NE(dynamic_cast<EvictionPolicy *>(
+                CreateEvictionPolicy(kLruEvictionPolicy, store, allocator).get()),
+            nullptr);
+  EXPECT_NE(dynamic_cast<GdsfEvictionPolicy *>(
+                CreateEvictionPolicy(kGdsfEvictionPolicy, store, allocator).get()),
+            nullptr);
+  EXPECT_NE(dynamic_cast<EvictionPolicy *>(
+                CreateEvictionPolicy("unknown", store, allocator).get()),
+            nullptr);
+}
+
+// An allocator that only counts the bytes allocated, up to a footprint limit.
+class DummyAllocator : public IAllocator {
+ public:
+  explicit DummyAllocator(int64_t footprint_limit) : footprint_limit_(footprint_limit) {}
+
+  absl::optional<Allocation> Allocate(size_t bytes) override {
+    if (allocated_ + static_cast<int64_t>(bytes) > footprint_limit_) {
+      return absl::nullopt;
+    }
+    allocated_ += bytes;
+    auto allocation = Allocation();
+    allocation.size = bytes;
+    return std::move(allocation);
+  }
+
+  absl::optional<Allocation> FallbackAllocate(size_t bytes) override {
+    return absl::nullopt;
+  }
+
+  void Free(Allocation allocation) override { allocated_ -= allocation.size; }
+
+  int64_t GetFootprintLimit() const override { return footprint_limit_; }
+
+  int64_t Allocated() const override { return allocated_; }
+
+  int64_t FallbackAllocated() const override { return 0; }
+
+ private:
+  const int64_t footprint_limit_;
+  int64_t allocated_ = 0;
+};
+
+// Adds up the time spent in an eviction policy.
+class TimedEvictionPolicy : public IEvictionPolicy {
+ public:
+  TimedEvictionPolicy(std::unique_ptr<IEvictionPolicy> policy,
+                      std::chrono::nanoseconds &duration)
+      : policy_(std::move(policy)), duration_(duration) {}
+
+  void ObjectCreated(const ObjectID &object_id) override {
+    Timer timer(duration_);
+    policy_->ObjectCreated(object_id);
+  }
+
+  int64_t RequireSpace(int64_t size, std::vector<ObjectID> &objects_to_evict) override {
+    Timer timer(duration_);
+    return policy_->RequireSpace(size, objects_to_evict);
+  }
+
+  void BeginObjectAccess(const ObjectID &object_id) override {
+    Timer timer(duration_);
+    policy_->BeginObjectAccess(object_id);
+  }
+
+  void EndObjectAccess(const ObjectID &object_id) override {
+    Timer timer(duration_);
+    policy_->EndObjectAccess(object_id);
+  }
+
+  int64_t ChooseObjectsToEvict(int64_t num_bytes_required,
+                               std::vector<ObjectID> &objects_to_evict) override {
+    Timer timer(duration_);
+    return policy_->ChooseObjectsToEvict(num_bytes_required, objects_to_evict);
+  }
+
+  void RemoveObject(const ObjectID &object_id) override {
+    Timer timer(duration_);
+    policy_->RemoveObject(object_id);
+  }
+
+  std::string DebugString() const override { return policy_->DebugString(); }
+
+ private:
+  struct Timer {
+    explicit Timer(std::chrono::nanoseconds &duration)
+        : duration(duration), start(std::chrono::steady_clock::now()) {}
+    ~Timer() { duration += std::chrono::steady_clock::now() - start; }
+    std::chrono::nanoseconds &duration;
+    const std::chrono::steady_clock::time_point start;
+  };
+
+  std::unique_ptr<IEvictionPolicy> policy_;
+  std::chrono::nanoseconds &duration_;
+};
+
+struct TraceEvent {
+  enum Type { kCreate, kGet, kRelease, kDelete };
+  Type type;
+  int64_t object_index;
+  /// The size of the object, for kCreate.
+  int64_t size;
+};
+
+// Loads a trace with one event per line: "create <object> <bytes>", "get <object>",
+// "release <object>" or "delete <object>".
+std::vector<TraceEvent> LoadTrace(const std::string &path, int64_t &num_objects) {
+  absl::flat_hash_map<std::string, int64_t> object_indices;
+  std::vector<TraceEvent> trace;
+  std::ifstream file(path);
+  RAY_CHECK(file.is_open()) << "Failed to open " << path;
+  std::string type;
+  std::string object;
+  while (file >> type >> object) {
+    auto index = object_indices.emplace(object, object_indices.size()).first->second;
+    if (type == "create") {
+      int64_t size;
+      RAY_CHECK(file >> size) << "Missing the size of " << object;
+      trace.push_back({TraceEvent::kCreate, index, size});
+    } else if (type == "get") {
+      trace.push_back({TraceEvent::kGet, index, 0});
+    } else if (type == "release") {
+      trace.push_back({TraceEvent::kRelease, index, 0});
+    } else {
+      RAY_CHECK(type == "delete") << "Unknown event " << type;
+      trace.push_back({TraceEvent::kDelete, index, 0});
+    }
+  }
+  num_objects = object_indices.size();
+  return trace;
+}
+
+// Generates the trace of a job that keeps reading a few hot objects, e.g. model
+// weights, while large one-shot objects, e.g. shuffle blocks, and small task returns
+// stream through the store. Half of the one-shot objects go out of scope right after
+// they are read, the rest stay until they are evicted.
+std::vector<TraceEvent> GenerateTrace(int64_t &num_objects) {
+  const int64_t kKB = 1024;
+  const int64_t kMB = 1024 * kKB;
+  std::mt19937 gen(42);
+  std::vector<TraceEvent> trace;
+  num_objects = 0;
+  auto use_object = [&](int64_t index) {
+    trace.push_back({TraceEvent::kGet, index, 0});
+    trace.push_back({TraceEvent::kRelease, index, 0});
+  };
+  auto create_object = [&](int64_t size) {
+    trace.push_back({TraceEvent::kCreate, num_objects, size});
+    return num_objects++;
+  };
+
+  std::vector<int64_t> hot_objects;
+  for (int i = 0; i < 8; i++) {
+    hot_objects.push_back(create_object(32 * kMB));
+  }
+  for (int i = 0; i < 50 * 1000; i++) {
+    if (absl::Bernoulli(gen, 0.02)) {
+      use_object(hot_objects[absl::Uniform<size_t>(gen, 0, hot_objects.size())]);
+    }
+    auto size = absl::Bernoulli(gen, 0.9) ? absl::Uniform(gen, 100 * kKB, kMB)
+                                          : absl::Uniform(gen, kMB, 64 * kMB);
+    auto index = create_object(size);
+    use_object(index);
+    if (absl::Bernoulli(gen, 0.5)) {
+      trace.push_back({TraceEvent::kDelete, index, 0});
+    }
+  }
+  return trace;
+}
+
+// Replays a trace of object creations, gets, releases and deletions through the
+// object lifecycle manager with each eviction policy, and reports the bytes evicted,
+// the objects that had to be fetched again because they were evicted, and the time
+// spent in the policy. Gets of evicted objects create them again, like a fetch from
+// another node would. Set PLASMA_EVICTION_TRACE to the path of a trace in the format
+// of LoadTrace to replay it instead of a synthetic one. We disable it by default.
+TEST(EvictionPolicyTest, DISABLED_TraceReplayPerf) {
+  const int64_t kFootprintLimit = 1024L * 1024 * 1024;
+  int64_t num_objects = 0;
+  auto trace_path = std::getenv("PLASMA_EVICTION_TRACE");
+  auto trace = trace_path != nullptr ? LoadTrace(trace_path, num_objects)
+                                     : GenerateTrace(num_objects);
+  std::vector<ObjectID> ids;
+  absl::flat_hash_map<ObjectID, int64_t> object_indices;
+  for (int64_t i = 0; i < num_objects; i++) {
+    ids.push_back(ObjectID::FromRandom());
+    object_indices.emplace(ids.back(), i);
+  }
+
+  int64_t lru_num_fetches = 0;
+  for (std::string policy_name : {kLruEvictionPolicy, kGdsfEvictionPolicy}) {
+    DummyAllocator allocator(kFootprintLimit);
+    std::chrono::nanoseconds policy_time(0);
+    auto object_store = std::make_unique<ObjectStore>(allocator);
+    auto eviction_policy = std::make_unique<TimedEvictionPolicy>(
+        CreateEvictionPolicy(policy_name, *object_store, allocator), policy_time);
+    std::vector<int64_t> sizes(num_objects, -1);
+    std::vector<int64_t> ref_counts(num_objects, 0);
+    std::vector<bool> deleted(num_objects, false);
+    int64_t num_evictions = 0;
+    int64_t bytes_evicted = 0;
+    int64_t num_fetches = 0;
+    int64_t bytes_fetched = 0;
+    int64_t num_failed_creations = 0;
+    ObjectLifecycleManager manager(
+        std::move(object_store),
+        std::move(eviction_policy),
+        [&](const ObjectID &object_id) {
+          auto index = object_indices.at(object_id);
+          if (!deleted[index]) {
+            num_evictions++;
+            bytes_evicted += sizes[index];
+          }
+        },
+        std::make_unique<ObjectStatsCollector>());
+    auto create_object = [&](int64_t index) {
+      ray::ObjectInfo info;
+      info.object_id = ids[index];
+      info.data_size = sizes[index];
+      info.metadata_size = 0;
+      if (manager.CreateObject(info, flatbuf::ObjectSource::CreatedByWorker, false)
+              .first == nullptr) {
+        num_failed_creations++;
+        return false;
+      }
+      manager.AddReference(ids[index]);
+      manager.SealObject(ids[index]);
+      manager.RemoveReference(ids[index]);
+      return true;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &event : trace) {
+      auto index = event.object_index;
+      switch (event.type) {
+      case TraceEvent::kCreate:
+        sizes[index] = event.size;
+        create_object(index);
+        break;
+      case TraceEvent::kGet:
+        if (sizes[index] < 0 || deleted[index]) {
+          break;
+        }
+        if (manager.GetObject(ids[index]) == nullptr) {
+          num_fetches++;
+          bytes_fetched += sizes[index];
+          if (!create_object(index)) {
+            break;
+          }
+        }
+        manager.AddReference(ids[index]);
+        ref_counts[index]++;
+        break;
+      case TraceEvent::kRelease:
+        if (ref_counts[index] > 0) {
+          manager.RemoveReference(ids[index]);
+          ref_counts[index]--;
+        }
+        break;
+      case TraceEvent::kDelete:
+        deleted[index] = true;
+        manager.DeleteObject(ids[index]);
+        break;
+      }
+    }
+    double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    if (policy_name == kLruEvictionPolicy) {
+      lru_num_fetches = num_fetches;
+    }
+    RAY_LOG(INFO) << policy_name << ": " << num_evictions << " objects (" << bytes_evicted
+                  << " bytes) evicted, " << num_fetches << " objects (" << bytes_fetched
+                  << " bytes) fetched again, " << lru_num_fetches - num_fetches
+                  << " fetches avoided compared to LRU, " << num_failed_creations
+                  << " failed creations, "
+                  << static_cast<double>(policy_time.count()) / trace.size()
+                  << " ns in the policy per event, " << trace.size() / duration_s
+                  << " events/s.";
+  }
+}
 }  // namespace plasma
 
 int main(int argc, char **argv) {
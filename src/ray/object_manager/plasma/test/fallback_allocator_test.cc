@@ -37,7 +37,8 @@ TEST(FallbackPlasmaAllocatorTest, FallbackPassThroughTest) {
   PlasmaAllocator allocator(plasma_directory,
                             fallback_directory,
                             /* hugepage_enabled */ false,
-                            kLimit);
+                            kLimit,
+                            /* slab_max_object_size */ 0);
 
   EXPECT_EQ(kLimit, allocator.GetFootprintLimit());
 
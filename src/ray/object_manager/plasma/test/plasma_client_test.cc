@@ -0,0 +1,264 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/client.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "ray/common/ray_config.h"
+#include "ray/object_manager/plasma/store_runner.h"
+#include "ray/util/logging.h"
+#include "ray/util/util.h"
+
+namespace plasma {
+namespace {
+const int64_t kMB = 1024 * 1024;
+
+std::string CreateTestDir() {
+  auto directory = std::filesystem::temp_directory_path() / GenerateUUIDV4();
+  std::filesystem::create_directories(directory);
+  return directory.string();
+}
+}  // namespace
+
+// Runs a plasma store for all tests, since the store's allocator can only be
+// initialized once per process.
+class PlasmaClientTest : public ::testing::Test {
+ public:
+  static void SetUpTestSuite() {
+    socket_name_ = CreateTestDir() + "/plasma.sock";
+    runner_ = std::make_unique<PlasmaStoreRunner>(socket_name_,
+                                                  /*system_memory=*/512 * kMB,
+                                                  /*hugepages_enabled=*/false,
+                                                  CreateTestDir(),
+                                                  CreateTestDir());
+    store_thread_ = std::thread(
+        &PlasmaStoreRunner::Start,
+        runner_.get(),
+        /*spill_objects_callback=*/[]() { return false; },
+        /*object_store_full_callback=*/nullptr,
+        /*add_object_callback=*/[](const ray::ObjectInfo &) {},
+        /*delete_object_callback=*/[](const ObjectID &) {});
+  }
+
+  static void TearDownTestSuite() {
+    runner_->Stop();
+    store_thread_.join();
+    runner_.reset();
+  }
+
+  void SetUp() override {
+    client_ = std::make_unique<PlasmaClient>();
+    RAY_CHECK_OK(client_->Connect(socket_name_, "", 0, /*num_retries=*/50));
+  }
+
+  void TearDown() override { RAY_CHECK_OK(client_->Disconnect()); }
+
+  Status CreateBatch(const std::vector<ObjectCreateSpec> &objects,
+                     std::vector<std::shared_ptr<Buffer>> *data) {
+    return client_->CreateBatchAndSpillIfNeeded(
+        objects, owner_address_, data, flatbuf::ObjectSource::CreatedByWorker);
+  }
+
+  Status Create(const ObjectID &object_id,
+                int64_t data_size,
+                std::shared_ptr<Buffer> *data) {
+    return client_->CreateAndSpillIfNeeded(object_id,
+                                           owner_address_,
+                                           /*is_mutable=*/false,
+                                           data_size,
+                                           /*metadata=*/nullptr,
+                                           /*metadata_size=*/0,
+                                           data,
+                                           flatbuf::ObjectSource::CreatedByWorker);
+  }
+
+  std::vector<ObjectBuffer> Get(const std::vector<ObjectID> &object_ids) {
+    std::vector<ObjectBuffer> buffers;
+    RAY_CHECK_OK(
+        client_->Get(object_ids, /*timeout_ms=*/0, &buffers, /*is_from_worker=*/true));
+    return buffers;
+  }
+
+  static std::string socket_name_;
+  static std::unique_ptr<PlasmaStoreRunner> runner_;
+  static std::thread store_thread_;
+  std::unique_ptr<PlasmaClient> client_;
+  ray::rpc::Address owner_address_;
+};
+
+std::string PlasmaClientTest::socket_name_;
+std::unique_ptr<PlasmaStoreRunner> PlasmaClientTest::runner_;
+std::thread PlasmaClientTest::store_thread_;
+
+TEST_F(PlasmaClientTest, TestCreateAndSealBatch) {
+  const uint8_t metadata[] = {1, 2, 3};
+  std::vector<ObjectCreateSpec> objects;
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < 10; i++) {
+    object_ids.push_back(ObjectID::FromRandom());
+    objects.push_back(
+        {object_ids.back(), /*data_size=*/1000 * (i + 1), metadata, sizeof(metadata)});
+  }
+  std::vector<std::shared_ptr<Buffer>> data;
+  ASSERT_TRUE(CreateBatch(objects, &data).ok());
+  ASSERT_EQ(data.size(), objects.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(data[i]->Size(), objects[i].data_size);
+    memset(data[i]->Data(), static_cast<int>(i), data[i]->Size());
+    ASSERT_TRUE(client_->IsInUse(object_ids[i]));
+  }
+  // The objects can't be read until they are sealed.
+  for (const auto &buffer : Get(object_ids)) {
+    ASSERT_EQ(buffer.data, nullptr);
+  }
+
+  ASSERT_TRUE(client_->SealBatch(object_ids).ok());
+  ASSERT_TRUE(client_->SealBatch(object_ids).IsObjectAlreadySealed());
+  for (const auto &object_id : object_ids) {
+    ASSERT_TRUE(client_->Release(object_id).ok());
+  }
+  auto buffers = Get(object_ids);
+  for (size_t i = 0; i < buffers.size(); i++) {
+    ASSERT_NE(buffers[i].data, nullptr);
+    ASSERT_EQ(buffers[i].data->Size(), objects[i].data_size);
+    ASSERT_EQ(buffers[i].data->Data()[objects[i].data_size - 1], i);
+    ASSERT_EQ(buffers[i].metadata->Size(), sizeof(metadata));
+    ASSERT_EQ(memcmp(buffers[i].metadata->Data(), metadata, sizeof(metadata)), 0);
+  }
+  buffers.clear();
+  ASSERT_TRUE(client_->Delete(object_ids).ok());
+}
+
+TEST_F(PlasmaClientTest, TestCreateBatchIsAtomic) {
+  auto existing_id = ObjectID::FromRandom();
+  std::shared_ptr<Buffer> existing_data;
+  ASSERT_TRUE(Create(existing_id, 100, &existing_data).ok());
+  ASSERT_TRUE(client_->Seal(existing_id).ok());
+  ASSERT_TRUE(client_->Release(existing_id).ok());
+
+  // The batch fails because one of its objects exists, and the objects created
+  // before it are aborted.
+  auto new_id = ObjectID::FromRandom();
+  std::vector<ObjectCreateSpec> objects = {{new_id, 100, nullptr, 0},
+                                           {existing_id, 100, nullptr, 0}};
+  std::vector<std::shared_ptr<Buffer>> data;
+  ASSERT_TRUE(CreateBatch(objects, &data).IsObjectExists());
+  ASSERT_FALSE(client_->IsInUse(new_id));
+  bool has_object = true;
+  ASSERT_TRUE(client_->Contains(new_id, &has_object).ok());
+  ASSERT_FALSE(has_object);
+
+  objects.pop_back();
+  ASSERT_TRUE(CreateBatch(objects, &data).ok());
+  ASSERT_TRUE(client_->SealBatch({new_id}).ok());
+  ASSERT_TRUE(client_->Release(new_id).ok());
+  ASSERT_TRUE(client_->Delete(std::vector<ObjectID>{new_id, existing_id}).ok());
+}
+
+// Measures the throughput of small object puts from a single client, creating and
+// sealing each object with its own requests, and in batches. We disable it by
+// default.
+TEST_F(PlasmaClientTest, DISABLED_SmallObjectPutPerf) {
+  const int kNumObjects = 20 * 1000;
+  const int64_t kObjectSize = 16 * 1024;
+  for (int batch_size : {1, 10, 100}) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumObjects; i += batch_size) {
+      std::vector<ObjectCreateSpec> objects;
+      std::vector<ObjectID> object_ids;
+      for (int j = 0; j < batch_size; j++) {
+        object_ids.push_back(ObjectID::FromRandom());
+        objects.push_back({object_ids.back(), kObjectSize, nullptr, 0});
+      }
+      std::vector<std::shared_ptr<Buffer>> data;
+      if (batch_size == 1) {
+        data.resize(1);
+        RAY_CHECK_OK(Create(object_ids[0], kObjectSize, &data[0]));
+      } else {
+        RAY_CHECK_OK(CreateBatch(objects, &data));
+      }
+      for (auto &buffer : data) {
+        memset(buffer->Data(), 1, buffer->Size());
+      }
+      if (batch_size == 1) {
+        RAY_CHECK_OK(client_->Seal(object_ids[0]));
+      } else {
+        RAY_CHECK_OK(client_->SealBatch(object_ids));
+      }
+      for (const auto &object_id : object_ids) {
+        RAY_CHECK_OK(client_->Release(object_id));
+      }
+      RAY_CHECK_OK(client_->Delete(object_ids));
+    }
+    double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    RAY_LOG(INFO) << "Batch size " << batch_size << ": " << kNumObjects / duration_s
+                  << " objects/s";
+  }
+}
+
+// Measures the latency of getting and releasing a local object, with messages
+// exchanged through the socket, and through the shared memory transport. We
+// disable it by default.
+TEST_F(PlasmaClientTest, DISABLED_GetLatencyPerf) {
+  const int kNumGets = 100 * 1000;
+  auto object_id = ObjectID::FromRandom();
+  std::shared_ptr<Buffer> data;
+  RAY_CHECK_OK(Create(object_id, 1024, &data));
+  RAY_CHECK_OK(client_->Seal(object_id));
+  RAY_CHECK_OK(client_->Release(object_id));
+
+  for (bool shared_memory_transport : {false, true}) {
+    RayConfig::instance().initialize(
+        shared_memory_transport ? R"({"plasma_shared_memory_transport": true})"
+                                : R"({"plasma_shared_memory_transport": false})");
+    PlasmaClient client;
+    RAY_CHECK_OK(client.Connect(socket_name_, "", 0, /*num_retries=*/50));
+    std::vector<double> latencies_us;
+    latencies_us.reserve(kNumGets);
+    for (int i = 0; i < kNumGets; i++) {
+      auto start = std::chrono::steady_clock::now();
+      std::vector<ObjectBuffer> buffers;
+      RAY_CHECK_OK(
+          client.Get({object_id}, /*timeout_ms=*/0, &buffers, /*is_from_worker=*/true));
+      buffers.clear();
+      RAY_CHECK_OK(client.Release(object_id));
+      latencies_us.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count() /
+                             1000.0);
+    }
+    RAY_CHECK_OK(client.Disconnect());
+    std::sort(latencies_us.begin(), latencies_us.end());
+    RAY_LOG(INFO) << (shared_memory_transport ? "Shared memory transport" : "Socket")
+                  << ": p50 " << latencies_us[kNumGets / 2] << " us, p99 "
+                  << latencies_us[kNumGets * 99 / 100] << " us";
+  }
+  RayConfig::instance().initialize(R"({"plasma_shared_memory_transport": false})");
+  RAY_CHECK_OK(client_->Delete(std::vector<ObjectID>{object_id}));
+}
+
+}  // namespace plasma
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
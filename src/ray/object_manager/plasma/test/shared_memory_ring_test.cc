@@ -0,0 +1,240 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/shared_memory_ring.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "ray/util/logging.h"
+
+namespace plasma {
+
+namespace {
+std::vector<uint8_t> MakeMessage(size_t size, uint8_t seed) {
+  std::vector<uint8_t> message(size);
+  for (size_t i = 0; i < size; i++) {
+    message[i] = static_cast<uint8_t>(seed + i * 7);
+  }
+  return message;
+}
+
+bool AlwaysAlive() { return true; }
+
+/// Log the p50 and p99 of round trip latencies, in microseconds.
+void LogLatencies(const std::string &name, std::vector<int64_t> latencies_ns) {
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+  auto percentile = [&latencies_ns](double p) {
+    return latencies_ns[static_cast<size_t>(p * (latencies_ns.size() - 1))] / 1000.0;
+  };
+  RAY_LOG(INFO) << name << ": p50 " << percentile(0.5) << " us, p99 "
+                << percentile(0.99) << " us";
+}
+}  // namespace
+
+TEST(SharedMemoryRingTest, TestRoundsUpCapacity) {
+  auto transport = SharedMemoryTransport::Create(1000);
+  ASSERT_NE(transport, nullptr);
+  ASSERT_EQ(transport->RingCapacity(), 1024u);
+  ASSERT_EQ(transport->Requests().Capacity(), 1024u);
+  ASSERT_EQ(transport->Replies().Capacity(), 1024u);
+}
+
+TEST(SharedMemoryRingTest, TestWraparound) {
+  auto transport = SharedMemoryTransport::Create(64);
+  auto &ring = transport->Replies();
+  // Each message starts at a different offset, so that most of them wrap around
+  // the end of the ring.
+  for (int i = 0; i < 100; i++) {
+    auto message = MakeMessage(40, i);
+    ASSERT_TRUE(ring.Write({{message.data(), message.size()}}, AlwaysAlive).ok());
+    ASSERT_EQ(ring.ReadableBytes(), message.size());
+    std::vector<uint8_t> received(message.size());
+    ASSERT_TRUE(ring.Read(received.data(), received.size(), AlwaysAlive).ok());
+    ASSERT_EQ(received, message);
+    ASSERT_EQ(ring.ReadableBytes(), 0u);
+  }
+}
+
+TEST(SharedMemoryRingTest, TestTryRead) {
+  auto transport = SharedMemoryTransport::Create(64);
+  auto &ring = transport->Replies();
+  uint8_t buffer[64];
+  ASSERT_EQ(ring.TryRead(buffer, sizeof(buffer)), 0u);
+
+  auto header = MakeMessage(8, 1);
+  auto body = MakeMessage(20, 2);
+  ASSERT_TRUE(ring.Write({{header.data(), header.size()}, {body.data(), body.size()}},
+                         AlwaysAlive)
+                  .ok());
+  ASSERT_EQ(ring.TryRead(buffer, 8), 8u);
+  ASSERT_EQ(std::vector<uint8_t>(buffer, buffer + 8), header);
+  ASSERT_EQ(ring.TryRead(buffer, sizeof(buffer)), 20u);
+  ASSERT_EQ(std::vector<uint8_t>(buffer, buffer + 20), body);
+}
+
+TEST(SharedMemoryRingTest, TestMessagesLargerThanRing) {
+  auto transport = SharedMemoryTransport::Create(256);
+  const int kNumMessages = 200;
+  // The producer blocks whenever the ring is full, until the consumer reads.
+  std::thread producer([&transport]() {
+    auto &ring = transport->Replies();
+    for (int i = 0; i < kNumMessages; i++) {
+      auto message = MakeMessage(1 + (i * 997) % 10000, i);
+      uint64_t size = message.size();
+      ASSERT_TRUE(ring.Write({{reinterpret_cast<const uint8_t *>(&size), sizeof(size)},
+                              {message.data(), message.size()}},
+                             AlwaysAlive)
+                      .ok());
+    }
+  });
+  auto &ring = transport->Replies();
+  for (int i = 0; i < kNumMessages; i++) {
+    uint64_t size;
+    ASSERT_TRUE(
+        ring.Read(reinterpret_cast<uint8_t *>(&size), sizeof(size), AlwaysAlive).ok());
+    std::vector<uint8_t> received(size);
+    ASSERT_TRUE(ring.Read(received.data(), received.size(), AlwaysAlive).ok());
+    ASSERT_EQ(received, MakeMessage(1 + (i * 997) % 10000, i));
+  }
+  producer.join();
+}
+
+TEST(SharedMemoryRingTest, TestEventfdWakesUpConsumer) {
+  auto transport = SharedMemoryTransport::Create(64);
+  auto &ring = transport->Requests();
+  struct pollfd poll_fd = {transport->EventFd(), POLLIN, 0};
+
+  // The producer doesn't signal the eventfd while the consumer isn't waiting.
+  auto message = MakeMessage(10, 0);
+  ASSERT_TRUE(ring.Write({{message.data(), message.size()}}, AlwaysAlive).ok());
+  ASSERT_EQ(poll(&poll_fd, 1, 0), 0);
+  // The consumer must not wait while there is something to read.
+  ASSERT_FALSE(ring.PrepareToWait());
+  uint8_t buffer[64];
+  ASSERT_EQ(ring.TryRead(buffer, sizeof(buffer)), message.size());
+
+  ASSERT_TRUE(ring.PrepareToWait());
+  ASSERT_TRUE(ring.Write({{message.data(), message.size()}}, AlwaysAlive).ok());
+  ASSERT_EQ(poll(&poll_fd, 1, 0), 1);
+  uint64_t events;
+  ASSERT_EQ(read(transport->EventFd(), &events, sizeof(events)), sizeof(events));
+}
+
+TEST(SharedMemoryRingTest, TestAttach) {
+  auto transport = SharedMemoryTransport::Create(64);
+  auto attached = SharedMemoryTransport::Attach(
+      dup(transport->ShmFd()), dup(transport->EventFd()), transport->RingCapacity());
+  ASSERT_NE(attached, nullptr);
+  auto message = MakeMessage(50, 3);
+  ASSERT_TRUE(
+      attached->Requests().Write({{message.data(), message.size()}}, AlwaysAlive).ok());
+  std::vector<uint8_t> received(message.size());
+  ASSERT_TRUE(
+      transport->Requests().Read(received.data(), received.size(), AlwaysAlive).ok());
+  ASSERT_EQ(received, message);
+}
+
+TEST(SharedMemoryRingTest, TestPeerGone) {
+  auto transport = SharedMemoryTransport::Create(64);
+  uint8_t buffer[8];
+  auto is_peer_alive = []() { return false; };
+  ASSERT_TRUE(
+      transport->Replies().Read(buffer, sizeof(buffer), is_peer_alive).IsIOError());
+
+  auto message = MakeMessage(100, 0);
+  ASSERT_TRUE(transport->Replies()
+                  .Write({{message.data(), message.size()}}, is_peer_alive)
+                  .IsIOError());
+}
+
+// Round trips of small messages between two threads, through rings and through
+// a unix socket, to compare the latency of the transports. A plasma request or
+// reply is a 24 bytes header followed by a small flatbuffer.
+TEST(SharedMemoryRingTest, DISABLED_RoundTripLatencyPerf) {
+  const int kNumRoundTrips = 100000;
+  const size_t kMessageSize = 64;
+
+  auto requests = SharedMemoryTransport::Create(1 << 16);
+  auto replies = SharedMemoryTransport::Create(1 << 16);
+  std::thread ring_server([&]() {
+    std::vector<uint8_t> message(kMessageSize);
+    for (int i = 0; i < kNumRoundTrips; i++) {
+      ASSERT_TRUE(
+          requests->Replies().Read(message.data(), message.size(), AlwaysAlive).ok());
+      ASSERT_TRUE(
+          replies->Replies().Write({{message.data(), message.size()}}, AlwaysAlive).ok());
+    }
+  });
+  std::vector<int64_t> latencies_ns;
+  latencies_ns.reserve(kNumRoundTrips);
+  auto message = MakeMessage(kMessageSize, 0);
+  for (int i = 0; i < kNumRoundTrips; i++) {
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(
+        requests->Replies().Write({{message.data(), message.size()}}, AlwaysAlive).ok());
+    ASSERT_TRUE(
+        replies->Replies().Read(message.data(), message.size(), AlwaysAlive).ok());
+    latencies_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count());
+  }
+  ring_server.join();
+  LogLatencies("ring", latencies_ns);
+
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  auto read_fully = [](int fd, uint8_t *data, size_t size) {
+    size_t read_bytes = 0;
+    while (read_bytes < size) {
+      ssize_t n = read(fd, data + read_bytes, size - read_bytes);
+      if (n <= 0) {
+        return false;
+      }
+      read_bytes += n;
+    }
+    return true;
+  };
+  std::thread socket_server([&]() {
+    std::vector<uint8_t> buffer(kMessageSize);
+    for (int i = 0; i < kNumRoundTrips; i++) {
+      ASSERT_TRUE(read_fully(fds[1], buffer.data(), buffer.size()));
+      ASSERT_EQ(write(fds[1], buffer.data(), buffer.size()),
+                static_cast<ssize_t>(buffer.size()));
+    }
+  });
+  latencies_ns.clear();
+  for (int i = 0; i < kNumRoundTrips; i++) {
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(write(fds[0], message.data(), message.size()),
+              static_cast<ssize_t>(message.size()));
+    ASSERT_TRUE(read_fully(fds[0], message.data(), message.size()));
+    latencies_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count());
+  }
+  socket_server.join();
+  close(fds[0]);
+  close(fds[1]);
+  LogLatencies("socket", latencies_ns);
+}
+
+}  // namespace plasma
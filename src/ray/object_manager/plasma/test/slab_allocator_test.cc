@@ -0,0 +1,271 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/plasma/slab_allocator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/random/random.h"
+#include "gtest/gtest.h"
+#include "ray/object_manager/plasma/plasma_allocator.h"
+#include "ray/util/logging.h"
+#include "ray/util/util.h"
+
+namespace plasma {
+namespace {
+const int64_t kKB = 1024;
+const int64_t kMB = 1024 * 1024;
+const size_t kAlignment = 64;
+}  // namespace
+
+class SlabAllocatorTest : public ::testing::Test {
+ public:
+  SlabAllocatorTest()
+      : allocator_(
+            kMB,
+            kAlignment,
+            [this](size_t bytes) -> void * {
+              if (fail_slab_allocations_) {
+                return nullptr;
+              }
+              void *slab = std::aligned_alloc(kAlignment, bytes);
+              slabs_.insert(slab);
+              return slab;
+            },
+            [this](void *slab) {
+              RAY_CHECK(slabs_.erase(slab));
+              std::free(slab);
+            }) {}
+
+  bool fail_slab_allocations_ = false;
+  absl::flat_hash_set<void *> slabs_;
+  SlabAllocator allocator_;
+};
+
+TEST_F(SlabAllocatorTest, TestBlockSizes) {
+  ASSERT_EQ(allocator_.MaxBlockSize(), kMB);
+  ASSERT_EQ(allocator_.BlockSize(1), 4 * kKB);
+  ASSERT_EQ(allocator_.BlockSize(4 * kKB), 4 * kKB);
+  ASSERT_EQ(allocator_.BlockSize(4 * kKB + 1), 5 * kKB);
+  ASSERT_EQ(allocator_.BlockSize(100 * kKB), 112 * kKB);
+  ASSERT_EQ(allocator_.BlockSize(kMB), kMB);
+  for (size_t bytes = 4 * kKB; bytes <= kMB; bytes += 999) {
+    auto block_size = allocator_.BlockSize(bytes);
+    ASSERT_GE(block_size, bytes);
+    ASSERT_LE(block_size, bytes * 5 / 4 + kAlignment);
+    ASSERT_EQ(block_size % kAlignment, 0);
+  }
+}
+
+TEST_F(SlabAllocatorTest, TestAllocateAndFree) {
+  std::vector<void *> blocks;
+  for (int i = 0; i < 10; i++) {
+    auto block = allocator_.Allocate(100 * kKB);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(block) % kAlignment, 0);
+    blocks.push_back(block);
+  }
+  // Blocks of the same size class share a slab.
+  ASSERT_EQ(slabs_.size(), 1);
+  auto stats = allocator_.GetStats();
+  ASSERT_EQ(stats.num_slabs, 1);
+  ASSERT_EQ(stats.block_bytes, 10 * 112 * kKB);
+  ASSERT_EQ(stats.requested_bytes, 10 * 100 * kKB);
+  ASSERT_GE(stats.slab_bytes, 4 * kMB);
+  for (size_t i = 1; i < blocks.size(); i++) {
+    ASSERT_EQ(static_cast<uint8_t *>(blocks[i]) - static_cast<uint8_t *>(blocks[i - 1]),
+              112 * kKB);
+  }
+
+  // Blocks of another size class get their own slab.
+  auto block = allocator_.Allocate(kMB);
+  ASSERT_NE(block, nullptr);
+  ASSERT_EQ(slabs_.size(), 2);
+  ASSERT_TRUE(allocator_.Free(block, kMB));
+  ASSERT_EQ(slabs_.size(), 1);
+
+  // Freed blocks are reused.
+  ASSERT_TRUE(allocator_.Free(blocks[3], 100 * kKB));
+  ASSERT_EQ(allocator_.Allocate(110 * kKB), blocks[3]);
+
+  // The slab is freed with its last block.
+  for (size_t i = 0; i < blocks.size(); i++) {
+    ASSERT_EQ(slabs_.size(), 1);
+    ASSERT_TRUE(allocator_.Free(blocks[i], i == 3 ? 110 * kKB : 100 * kKB));
+  }
+  ASSERT_TRUE(slabs_.empty());
+  stats = allocator_.GetStats();
+  ASSERT_EQ(stats.num_slabs, 0);
+  ASSERT_EQ(stats.slab_bytes, 0);
+  ASSERT_EQ(stats.block_bytes, 0);
+  ASSERT_EQ(stats.requested_bytes, 0);
+}
+
+TEST_F(SlabAllocatorTest, TestFreeNotFromSlab) {
+  auto block = allocator_.Allocate(10 * kKB);
+  ASSERT_NE(block, nullptr);
+  int64_t other;
+  ASSERT_FALSE(allocator_.Free(&other, sizeof(other)));
+  ASSERT_FALSE(allocator_.Free(nullptr, 0));
+  ASSERT_TRUE(allocator_.Free(block, 10 * kKB));
+}
+
+TEST_F(SlabAllocatorTest, TestSlabAllocationFailure) {
+  auto block = allocator_.Allocate(10 * kKB);
+  ASSERT_NE(block, nullptr);
+  fail_slab_allocations_ = true;
+  // The slab with free blocks is still used.
+  ASSERT_NE(allocator_.Allocate(10 * kKB), nullptr);
+  ASSERT_EQ(allocator_.Allocate(20 * kKB), nullptr);
+  ASSERT_EQ(allocator_.GetStats().num_slabs, 1);
+}
+
+TEST(PlasmaAllocatorSlabTest, TestAllocatedIncludesSlabs) {
+  auto plasma_directory = std::filesystem::temp_directory_path() / GenerateUUIDV4();
+  std::filesystem::create_directories(plasma_directory);
+  PlasmaAllocator plasma_allocator(plasma_directory.string(),
+                                   plasma_directory.string(),
+                                   /*hugepage_enabled=*/false,
+                                   /*footprint_limit=*/64 * kMB,
+                                   /*slab_max_object_size=*/kMB);
+  auto small = plasma_allocator.Allocate(10 * kKB);
+  ASSERT_TRUE(small.has_value());
+  // The whole slab is reserved, not only the block of the object.
+  auto stats = plasma_allocator.GetSlabAllocatorStats().value();
+  ASSERT_EQ(stats.num_slabs, 1);
+  ASSERT_GT(stats.slab_bytes, 10 * kKB);
+  ASSERT_EQ(plasma_allocator.Allocated(), stats.slab_bytes);
+
+  auto large = plasma_allocator.Allocate(4 * kMB);
+  ASSERT_TRUE(large.has_value());
+  ASSERT_EQ(plasma_allocator.Allocated(), stats.slab_bytes + 4 * kMB);
+
+  plasma_allocator.Free(std::move(small.value()));
+  plasma_allocator.Free(std::move(large.value()));
+  ASSERT_EQ(plasma_allocator.Allocated(), 0);
+  std::filesystem::remove_all(plasma_directory);
+}
+
+// Creates and deletes objects of random sizes in plasma memory, keeping it at most
+// 80% or 90% full, and reports the throughput and the allocations that fail, which
+// the store would have to allocate from the filesystem. Compares dlmalloc alone with
+// small objects allocated from slabs. We disable it by default.
+TEST(SlabAllocatorPerfTest, DISABLED_AllocationChurnPerf) {
+  const int64_t kFootprintLimit = 2L * 1024 * kMB;
+  const int kNumAllocations = 200 * 1000;
+  auto create_directory = [](std::filesystem::path parent) {
+    auto directory = parent / GenerateUUIDV4();
+    std::filesystem::create_directories(directory);
+    return directory.string();
+  };
+  // Like the store, use shared memory if available.
+  std::filesystem::path plasma_directory = "/dev/shm";
+  if (!std::filesystem::exists(plasma_directory)) {
+    plasma_directory = std::filesystem::temp_directory_path();
+  }
+  auto fallback_directory = std::filesystem::temp_directory_path();
+  PlasmaAllocator plasma_allocator(create_directory(plasma_directory),
+                                   create_directory(fallback_directory),
+                                   /*hugepage_enabled=*/false,
+                                   kFootprintLimit,
+                                   /*slab_max_object_size=*/0);
+  absl::flat_hash_map<void *, Allocation> dlmalloc_allocations;
+  auto dlmalloc_allocate = [&](size_t bytes) -> void * {
+    auto allocation = plasma_allocator.Allocate(bytes);
+    if (!allocation.has_value()) {
+      return nullptr;
+    }
+    auto address = allocation->address;
+    dlmalloc_allocations.emplace(address, std::move(allocation.value()));
+    return address;
+  };
+  auto dlmalloc_free = [&](void *address) {
+    auto it = dlmalloc_allocations.find(address);
+    RAY_CHECK(it != dlmalloc_allocations.end());
+    plasma_allocator.Free(std::move(it->second));
+    dlmalloc_allocations.erase(it);
+  };
+
+  for (int max_percent_used : {80, 90}) {
+    for (bool use_slabs : {false, true}) {
+      // The same as PlasmaAllocator with slab_max_object_size = 1MB.
+      SlabAllocator slab_allocator(kMB, kAlignment, dlmalloc_allocate, dlmalloc_free);
+      auto allocate = [&](size_t bytes) -> void * {
+        void *address = nullptr;
+        if (use_slabs && bytes <= slab_allocator.MaxBlockSize()) {
+          address = slab_allocator.Allocate(bytes);
+        }
+        return address != nullptr ? address : dlmalloc_allocate(bytes);
+      };
+      auto free = [&](void *address, size_t bytes) {
+        if (!use_slabs || !slab_allocator.Free(address, bytes)) {
+          dlmalloc_free(address);
+        }
+      };
+
+      std::mt19937 gen(42);
+      std::vector<std::pair<void *, size_t>> objects;
+      int64_t allocated = 0;
+      int64_t num_failed = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kNumAllocations; i++) {
+        // Mostly task returns just above the inline threshold, and a few large objects.
+        size_t bytes = absl::Bernoulli(gen, 0.9) ? absl::Uniform(gen, 100 * kKB, kMB)
+                                                 : absl::Uniform(gen, 4 * kMB, 32 * kMB);
+        while (allocated + static_cast<int64_t>(bytes) >
+               kFootprintLimit * max_percent_used / 100) {
+          auto index = absl::Uniform<size_t>(gen, 0, objects.size());
+          std::swap(objects[index], objects.back());
+          free(objects.back().first, objects.back().second);
+          allocated -= objects.back().second;
+          objects.pop_back();
+        }
+        auto address = allocate(bytes);
+        if (address == nullptr) {
+          num_failed++;
+          continue;
+        }
+        objects.emplace_back(address, bytes);
+        allocated += bytes;
+      }
+      double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+      auto stats = slab_allocator.GetStats();
+      RAY_LOG(INFO) << (use_slabs ? "Slabs + dlmalloc" : "dlmalloc") << ", at most "
+                    << max_percent_used << "% used: " << kNumAllocations / duration_s
+                    << " allocations/s, " << num_failed << " failed allocations, "
+                    << stats.slab_bytes - stats.block_bytes
+                    << " bytes free in slabs and "
+                    << stats.block_bytes - stats.requested_bytes
+                    << " bytes lost to rounding at the end.";
+      for (const auto &[address, bytes] : objects) {
+        free(address, bytes);
+      }
+    }
+  }
+  ASSERT_EQ(plasma_allocator.Allocated(), 0);
+}
+
+}  // namespace plasma
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
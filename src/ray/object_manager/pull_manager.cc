@@ -629,6 +629,18 @@ void PullManager::UnpinObject(const ObjectID &object_id) {
 
 int PullManager::NumObjectPullRequests() const { return object_pull_requests_.size(); }
 
+bool PullManager::GetObjectLocations(const ObjectID &object_id,
+                                     std::vector<NodeID> *node_ids,
+                                     int64_t *object_size) const {
+  auto it = object_pull_requests_.find(object_id);
+  if (it == object_pull_requests_.end() || !it->second.object_size_set) {
+    return false;
+  }
+  *node_ids = it->second.client_locations;
+  *object_size = it->second.object_size;
+  return true;
+}
+
 bool PullManager::IsObjectActive(const ObjectID &object_id) const {
   absl::MutexLock lock(&active_objects_mu_);
   return active_object_pull_requests_.count(object_id) == 1;
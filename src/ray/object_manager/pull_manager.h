@@ -148,6 +148,16 @@ class PullManager {
   /// The number of ongoing object pulls.
   int NumObjectPullRequests() const;
 
+  /// Get the last known locations and the size of an object that is being pulled.
+  ///
+  /// \param object_id The object ID.
+  /// \param[out] node_ids The nodes known to hold a copy of the object.
+  /// \param[out] object_size The size of the object.
+  /// \return Whether the object is being pulled and its size is known.
+  bool GetObjectLocations(const ObjectID &object_id,
+                          std::vector<NodeID> *node_ids,
+                          int64_t *object_size) const;
+
   /// Returns whether the object is actively being pulled.
   ///
   /// This method (and this method only) is thread-safe.
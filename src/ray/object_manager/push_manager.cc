@@ -14,25 +14,49 @@
 
 #include "ray/object_manager/push_manager.h"
 
+#include <cmath>
+
 #include "ray/common/common_protocol.h"
 #include "ray/stats/metric_defs.h"
 #include "ray/util/util.h"
 
 namespace ray {
 
+namespace {
+
+/// The window of a destination before any chunk to it completes.
+constexpr double kInitialWindow = 4;
+
+/// The window of a destination is decreased when the round trip time of a chunk
+/// exceeds its minimum round trip time by this factor.
+constexpr double kRttInflationFactor = 2;
+
+/// Weight of a new sample in the smoothed round trip time.
+constexpr double kRttSmoothingFactor = 0.125;
+
+/// Weight of a new sample in the smoothed throughput.
+constexpr double kThroughputSmoothingFactor = 0.25;
+
+/// The state of a destination is forgotten after it's been idle this long.
+constexpr double kDestinationIdleTimeoutSeconds = 60;
+
+}  // namespace
+
 void PushManager::StartPush(const NodeID &dest_id,
                             const ObjectID &obj_id,
                             int64_t num_chunks,
                             std::function<void(int64_t)> send_chunk_fn) {
   auto push_id = std::make_pair(dest_id, obj_id);
   RAY_CHECK(num_chunks > 0);
+  if (adaptive_scheduling_) {
+    ForgetIdleDestinations();
+  }
 
   auto it = push_info_.find(push_id);
   if (it == push_info_.end()) {
     chunks_remaining_ += num_chunks;
     auto push_state = std::make_unique<PushState>(num_chunks, send_chunk_fn);
-    push_requests_with_chunks_to_send_.push_back(
-        std::make_pair(push_id, push_state.get()));
+    AddPushWithChunksToSend(push_id, push_state.get());
     push_info_[push_id] = std::move(push_state);
   } else {
     RAY_LOG(DEBUG) << "Duplicate push request " << push_id.first << ", " << push_id.second
@@ -40,18 +64,41 @@ void PushManager::StartPush(const NodeID &dest_id,
     if (it->second->NoChunksToSend()) {
       // if all the chunks have been sent, the push request needs to be re-added to
       // `push_requests_with_chunks_to_send_`.
-      push_requests_with_chunks_to_send_.push_back(
-          std::make_pair(push_id, it->second.get()));
+      AddPushWithChunksToSend(push_id, it->second.get());
     }
     chunks_remaining_ += it->second->ResendAllChunks(send_chunk_fn);
   }
   ScheduleRemainingPushes();
 }
 
-void PushManager::OnChunkComplete(const NodeID &dest_id, const ObjectID &obj_id) {
+void PushManager::AddPushWithChunksToSend(const PushID &push_id,
+                                          PushState *push_state) {
+  if (!adaptive_scheduling_) {
+    push_requests_with_chunks_to_send_.push_back(std::make_pair(push_id, push_state));
+    return;
+  }
+  auto it = destinations_.find(push_id.first);
+  if (it == destinations_.end()) {
+    double max_window = static_cast<double>(max_chunks_in_flight_);
+    it = destinations_
+             .emplace(push_id.first,
+                      DestinationState(std::min(kInitialWindow, max_window), max_window))
+             .first;
+  }
+  it->second.pushes_with_chunks_to_send.push_back(std::make_pair(push_id, push_state));
+}
+
+void PushManager::OnChunkComplete(const NodeID &dest_id,
+                                  const ObjectID &obj_id,
+                                  const Status &status) {
   auto push_id = std::make_pair(dest_id, obj_id);
   chunks_in_flight_ -= 1;
   chunks_remaining_ -= 1;
+  if (adaptive_scheduling_) {
+    auto it = destinations_.find(dest_id);
+    RAY_CHECK(it != destinations_.end()) << dest_id;
+    UpdateDestination(it->second, status);
+  }
   push_info_[push_id]->OnChunkComplete();
   if (push_info_[push_id]->AllChunksComplete()) {
     push_info_.erase(push_id);
@@ -61,7 +108,70 @@ void PushManager::OnChunkComplete(const NodeID &dest_id, const ObjectID &obj_id)
   ScheduleRemainingPushes();
 }
 
+void PushManager::UpdateDestination(DestinationState &destination,
+                                    const Status &status) {
+  double now = get_time_seconds_();
+  RAY_CHECK(!destination.sent_chunks.empty());
+  auto [send_time, num_chunks_delivered_at_send] = destination.sent_chunks.front();
+  destination.sent_chunks.pop_front();
+  double rtt = now - send_time;
+  destination.num_chunks_inflight--;
+  destination.last_active_time_s = now;
+
+  bool congested = !status.ok();
+  if (status.ok()) {
+    if (std::isinf(destination.min_rtt_s)) {
+      destination.smoothed_rtt_s = rtt;
+    } else {
+      destination.smoothed_rtt_s +=
+          kRttSmoothingFactor * (rtt - destination.smoothed_rtt_s);
+    }
+    destination.min_rtt_s = std::min(destination.min_rtt_s, rtt);
+    congested = rtt > kRttInflationFactor * destination.min_rtt_s;
+
+    destination.num_chunks_delivered++;
+    if (rtt > 0) {
+      double rate =
+          (destination.num_chunks_delivered - num_chunks_delivered_at_send) / rtt;
+      destination.throughput +=
+          kThroughputSmoothingFactor * (rate - destination.throughput);
+    }
+  }
+
+  if (congested) {
+    // Multiplicative decrease, at most once per round trip since the chunks sent
+    // before the decrease see the same congestion.
+    if (now - destination.last_decrease_time_s >= destination.smoothed_rtt_s) {
+      destination.window = std::max(1.0, destination.window / 2);
+      destination.slow_start_threshold = destination.window;
+      destination.last_decrease_time_s = now;
+    }
+  } else if (destination.window < destination.slow_start_threshold) {
+    destination.window += 1;
+  } else {
+    destination.window += 1 / destination.window;
+  }
+  destination.window =
+      std::min(destination.window, static_cast<double>(max_chunks_in_flight_));
+}
+
+void PushManager::ForgetIdleDestinations() {
+  double now = get_time_seconds_();
+  for (auto it = destinations_.begin(); it != destinations_.end();) {
+    if (it->second.Idle() &&
+        now - it->second.last_active_time_s > kDestinationIdleTimeoutSeconds) {
+      destinations_.erase(it++);
+    } else {
+      it++;
+    }
+  }
+}
+
 void PushManager::ScheduleRemainingPushes() {
+  if (adaptive_scheduling_) {
+    ScheduleRemainingPushesAdaptive();
+    return;
+  }
   bool keep_looping = true;
   // Loop over all active pushes for approximate round-robin prioritization.
   // TODO(ekl) this isn't the best implementation of round robin, we should
@@ -92,10 +202,105 @@ void PushManager::ScheduleRemainingPushes() {
   }
 }
 
+void PushManager::ScheduleRemainingPushesAdaptive() {
+  while (chunks_in_flight_ < max_chunks_in_flight_) {
+    // Pick the destination whose next chunk finishes first in virtual time, among
+    // the ones with room in their window. All destinations have the same weight,
+    // so this shares the global budget equally across the destinations that can
+    // use it, whatever their number of pushes.
+    NodeID dest_id;
+    DestinationState *destination = nullptr;
+    for (auto &entry : destinations_) {
+      if (entry.second.CanSend() &&
+          (destination == nullptr || entry.second.virtual_finish_time <
+                                         destination->virtual_finish_time)) {
+        dest_id = entry.first;
+        destination = &entry.second;
+      }
+    }
+    if (destination == nullptr) {
+      return;
+    }
+
+    double now = get_time_seconds_();
+    double start_time = std::max(destination->virtual_finish_time, virtual_time_);
+    destination->virtual_finish_time = start_time + 1;
+    virtual_time_ = start_time;
+    destination->num_chunks_inflight++;
+    destination->sent_chunks.emplace_back(now, destination->num_chunks_delivered);
+    destination->last_active_time_s = now;
+
+    // Round-robin across the pushes to the destination.
+    auto &pushes = destination->pushes_with_chunks_to_send;
+    auto push = pushes.front();
+    pushes.pop_front();
+    auto &info = push.second;
+    RAY_CHECK(info->SendOneChunk());
+    chunks_in_flight_ += 1;
+    if (!info->NoChunksToSend()) {
+      pushes.push_back(push);
+    }
+    RAY_LOG(DEBUG) << "Sending chunk " << info->next_chunk_id << " of "
+                   << info->num_chunks << " for push " << push.first.first << ", "
+                   << push.first.second << ", chunks in flight to destination "
+                   << destination->num_chunks_inflight << " / "
+                   << static_cast<int64_t>(destination->window)
+                   << ", chunks in flight " << NumChunksInFlight() << " / "
+                   << max_chunks_in_flight_
+                   << " max, remaining chunks: " << NumChunksRemaining();
+  }
+}
+
+int64_t PushManager::NumPushRequestsWithChunksToSend() const {
+  int64_t num_pushes = push_requests_with_chunks_to_send_.size();
+  for (const auto &entry : destinations_) {
+    num_pushes += entry.second.pushes_with_chunks_to_send.size();
+  }
+  return num_pushes;
+}
+
+double PushManager::DestinationWindow(const NodeID &dest_id) const {
+  auto it = destinations_.find(dest_id);
+  return it == destinations_.end() ? 0 : it->second.window;
+}
+
+double PushManager::DestinationThroughput(const NodeID &dest_id) const {
+  auto it = destinations_.find(dest_id);
+  return it == destinations_.end() ? 0 : it->second.throughput;
+}
+
 void PushManager::RecordMetrics() const {
   ray::stats::STATS_push_manager_in_flight_pushes.Record(NumPushesInFlight());
   ray::stats::STATS_push_manager_chunks.Record(NumChunksInFlight(), "InFlight");
   ray::stats::STATS_push_manager_chunks.Record(NumChunksRemaining(), "Remaining");
+  if (!adaptive_scheduling_) {
+    return;
+  }
+  // The destinations are summarized rather than recorded per node: OpenCensus keeps
+  // every tagged series it has seen, so per-node series would grow with cluster churn.
+  double min_window = 0, max_window = 0, sum_window = 0;
+  double min_throughput = 0, max_throughput = 0, sum_throughput = 0;
+  bool first = true;
+  for (const auto &entry : destinations_) {
+    const auto &destination = entry.second;
+    min_window = first ? destination.window : std::min(min_window, destination.window);
+    max_window = std::max(max_window, destination.window);
+    sum_window += destination.window;
+    min_throughput =
+        first ? destination.throughput : std::min(min_throughput, destination.throughput);
+    max_throughput = std::max(max_throughput, destination.throughput);
+    sum_throughput += destination.throughput;
+    first = false;
+  }
+  const double num_destinations = std::max<size_t>(destinations_.size(), 1);
+  ray::stats::STATS_push_manager_destination_window.Record(min_window, "Min");
+  ray::stats::STATS_push_manager_destination_window.Record(
+      sum_window / num_destinations, "Mean");
+  ray::stats::STATS_push_manager_destination_window.Record(max_window, "Max");
+  ray::stats::STATS_push_manager_destination_throughput.Record(min_throughput, "Min");
+  ray::stats::STATS_push_manager_destination_throughput.Record(
+      sum_throughput / num_destinations, "Mean");
+  ray::stats::STATS_push_manager_destination_throughput.Record(max_throughput, "Max");
 }
 
 std::string PushManager::DebugString() const {
@@ -105,6 +310,9 @@ std::string PushManager::DebugString() const {
   result << "\n- num chunks in flight: " << NumChunksInFlight();
   result << "\n- num chunks remaining: " << NumChunksRemaining();
   result << "\n- max chunks allowed: " << max_chunks_in_flight_;
+  if (adaptive_scheduling_) {
+    result << "\n- num destinations: " << destinations_.size();
+  }
   return result.str();
 }
 
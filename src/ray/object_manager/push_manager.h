@@ -15,11 +15,14 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
+#include <limits>
 #include <list>
 #include <memory>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/time/clock.h"
 #include "ray/common/id.h"
 #include "ray/common/ray_config.h"
 #include "ray/common/status.h"
@@ -27,14 +30,31 @@
 namespace ray {
 
 /// Manages rate limiting and deduplication of outbound object pushes.
+///
+/// By default, chunks are sent round-robin across all pushes, subject to a single
+/// global limit of chunks in flight. With adaptive scheduling, each destination
+/// additionally gets its own window of chunks in flight, which grows additively
+/// while the round trip time of its chunks stays close to the minimum observed and
+/// is halved when it inflates (the link or the receiver is saturated) or when a
+/// chunk fails. Destinations are served in weighted fair queuing order, so that a
+/// broadcast to many nodes can't starve a push to a single node, and a slow
+/// destination can't hold the global budget that fast ones could use.
 class PushManager {
  public:
   /// Create a push manager.
   ///
   /// \param max_chunks_in_flight Max number of chunks allowed to be in flight
   ///                             from this PushManager (this raylet).
-  PushManager(int64_t max_chunks_in_flight)
-      : max_chunks_in_flight_(max_chunks_in_flight) {
+  /// \param adaptive_scheduling Whether to use per-destination adaptive windows
+  ///                            and fair queuing across destinations.
+  /// \param get_time_seconds The clock used to measure chunk round trip times.
+  PushManager(int64_t max_chunks_in_flight,
+              bool adaptive_scheduling = false,
+              std::function<double()> get_time_seconds =
+                  []() { return absl::GetCurrentTimeNanos() / 1e9; })
+      : max_chunks_in_flight_(max_chunks_in_flight),
+        adaptive_scheduling_(adaptive_scheduling),
+        get_time_seconds_(std::move(get_time_seconds)) {
     RAY_CHECK(max_chunks_in_flight_ > 0) << max_chunks_in_flight_;
   };
 
@@ -55,7 +75,12 @@ class PushManager {
 
   /// Called every time a chunk completes to trigger additional sends.
   /// TODO(ekl) maybe we should cancel the entire push on error.
-  void OnChunkComplete(const NodeID &dest_id, const ObjectID &obj_id);
+  ///
+  /// \param status The status of the chunk send. With adaptive scheduling, a
+  ///               failure shrinks the window of the destination.
+  void OnChunkComplete(const NodeID &dest_id,
+                       const ObjectID &obj_id,
+                       const Status &status = Status::OK());
 
   /// Return the number of chunks currently in flight. For testing only.
   int64_t NumChunksInFlight() const { return chunks_in_flight_; };
@@ -67,9 +92,20 @@ class PushManager {
   int64_t NumPushesInFlight() const { return push_info_.size(); };
 
   /// Return the number of push requests with remaining chunks. For testing only.
-  int64_t NumPushRequestsWithChunksToSend() const {
-    return push_requests_with_chunks_to_send_.size();
-  };
+  int64_t NumPushRequestsWithChunksToSend() const;
+
+  /// Return whether the object is being pushed to the node.
+  bool IsPushInProgress(const NodeID &dest_id, const ObjectID &obj_id) const {
+    return push_info_.contains(std::make_pair(dest_id, obj_id));
+  }
+
+  /// Return the current window of chunks in flight to a destination, or 0 if the
+  /// destination isn't tracked. For testing only.
+  double DestinationWindow(const NodeID &dest_id) const;
+
+  /// Return the estimated number of chunks per second acknowledged by a
+  /// destination, or 0 if unknown. For testing only.
+  double DestinationThroughput(const NodeID &dest_id) const;
 
   /// Record the internal metrics.
   void RecordMetrics() const;
@@ -132,15 +168,84 @@ class PushManager {
     }
   };
 
+  /// Pair of (destination, object_id).
+  typedef std::pair<NodeID, ObjectID> PushID;
+
+  /// Tracks the link to a destination node, with adaptive scheduling.
+  struct DestinationState {
+    /// The pushes to this destination with chunks waiting to be sent, served
+    /// round-robin.
+    std::list<std::pair<PushID, PushState *>> pushes_with_chunks_to_send;
+    /// The number of chunks allowed in flight to this destination. Only its
+    /// integral part is used, the fraction accumulates additive increases.
+    double window;
+    /// The window below which the window grows by one chunk per completed chunk
+    /// (slow start) rather than by one chunk per window (congestion avoidance).
+    double slow_start_threshold;
+    /// The number of chunks in flight to this destination.
+    int64_t num_chunks_inflight = 0;
+    /// The send time of each chunk in flight and the number of chunks delivered
+    /// when it was sent, in send order. Chunks to the same destination are assumed
+    /// to complete roughly in order.
+    std::deque<std::pair<double, int64_t>> sent_chunks;
+    /// The number of chunks completed by this destination.
+    int64_t num_chunks_delivered = 0;
+    /// The smallest round trip time observed, i.e. without queueing delay.
+    double min_rtt_s = std::numeric_limits<double>::infinity();
+    /// Smoothed round trip time.
+    double smoothed_rtt_s = 0;
+    /// The last time the window was decreased, so that it's decreased at most
+    /// once per round trip.
+    double last_decrease_time_s = 0;
+    /// Smoothed number of chunks per second delivered to the destination. Each
+    /// completed chunk samples the chunks delivered during its round trip.
+    double throughput = 0;
+    /// The virtual time at which the last chunk sent to this destination finishes,
+    /// used for weighted fair queuing across destinations.
+    double virtual_finish_time = 0;
+    /// The last time a chunk was sent to or completed by this destination.
+    double last_active_time_s = 0;
+
+    explicit DestinationState(double initial_window, double max_window)
+        : window(initial_window), slow_start_threshold(max_window) {}
+
+    /// Whether a chunk can be sent to this destination now.
+    bool CanSend() const {
+      return !pushes_with_chunks_to_send.empty() &&
+             num_chunks_inflight < static_cast<int64_t>(window);
+    }
+
+    /// Whether this destination has no pushes in progress.
+    bool Idle() const {
+      return pushes_with_chunks_to_send.empty() && num_chunks_inflight == 0;
+    }
+  };
+
   /// Called on completion events to trigger additional pushes.
   void ScheduleRemainingPushes();
 
-  /// Pair of (destination, object_id).
-  typedef std::pair<NodeID, ObjectID> PushID;
+  /// Send chunks in fair queuing order across destinations, within their windows.
+  void ScheduleRemainingPushesAdaptive();
+
+  /// Queue a push that has chunks to send.
+  void AddPushWithChunksToSend(const PushID &push_id, PushState *push_state);
+
+  /// Update the window and the estimates of a destination when a chunk completes.
+  void UpdateDestination(DestinationState &destination, const Status &status);
+
+  /// Forget the estimates of destinations that have been idle for a while, e.g.
+  /// because they have left the cluster.
+  void ForgetIdleDestinations();
 
   /// Max number of chunks in flight allowed.
   const int64_t max_chunks_in_flight_;
 
+  /// Whether to use per-destination windows and fair queuing.
+  const bool adaptive_scheduling_;
+
+  /// Returns the current time in seconds.
+  const std::function<double()> get_time_seconds_;
+
   /// Running count of chunks in flight, used to limit progress of in_flight_pushes_.
   int64_t chunks_in_flight_ = 0;
 
@@ -153,8 +258,19 @@ class PushManager {
   /// pointers in `push_requests_with_chunks_to_send_` may become dangling.
   absl::flat_hash_map<PushID, std::unique_ptr<PushState>> push_info_;
 
-  /// The list of push requests with chunks waiting to be sent.
+  /// The list of push requests with chunks waiting to be sent. Only used
+  /// without adaptive scheduling.
   std::list<std::pair<PushID, PushState *>> push_requests_with_chunks_to_send_;
+
+  /// The state of each destination, with adaptive scheduling. The state of a
+  /// destination is kept for a while after its pushes complete, so that its
+  /// estimates are reused by the next pushes.
+  absl::flat_hash_map<NodeID, DestinationState> destinations_;
+
+  /// The virtual time of the last chunk sent, with adaptive scheduling. A
+  /// destination that becomes active starts from it rather than from its own,
+  /// older, virtual time, so that it can't claim the share it didn't use.
+  double virtual_time_ = 0;
 };
 
 }  // namespace ray
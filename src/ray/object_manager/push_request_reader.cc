@@ -0,0 +1,159 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/push_request_reader.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <algorithm>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+namespace {
+
+using google::protobuf::internal::WireFormatLite;
+
+/// Zero copy input stream over gRPC slices. Unlike grpc::ProtoBufferReader, it
+/// doesn't own the slices, so the buffers it returns stay valid after it's gone.
+class SliceInputStream : public google::protobuf::io::ZeroCopyInputStream {
+ public:
+  explicit SliceInputStream(const std::vector<grpc::Slice> &slices) : slices_(slices) {}
+
+  bool Next(const void **data, int *size) override {
+    if (backup_count_ > 0) {
+      const auto &slice = slices_[index_ - 1];
+      *data = slice.begin() + slice.size() - backup_count_;
+      *size = static_cast<int>(backup_count_);
+      byte_count_ += backup_count_;
+      backup_count_ = 0;
+      return true;
+    }
+    while (index_ < slices_.size()) {
+      const auto &slice = slices_[index_++];
+      if (slice.size() == 0) {
+        continue;
+      }
+      *data = slice.begin();
+      *size = static_cast<int>(slice.size());
+      byte_count_ += slice.size();
+      return true;
+    }
+    return false;
+  }
+
+  void BackUp(int count) override {
+    RAY_CHECK(index_ > 0 && backup_count_ == 0 &&
+              static_cast<size_t>(count) <= slices_[index_ - 1].size());
+    backup_count_ = count;
+    byte_count_ -= count;
+  }
+
+  bool Skip(int count) override {
+    const void *data;
+    int size;
+    while (count > 0) {
+      if (!Next(&data, &size)) {
+        return false;
+      }
+      if (size > count) {
+        BackUp(size - count);
+        return true;
+      }
+      count -= size;
+    }
+    return true;
+  }
+
+  int64_t ByteCount() const override { return byte_count_; }
+
+ private:
+  const std::vector<grpc::Slice> &slices_;
+  /// Index of the next slice to return.
+  size_t index_ = 0;
+  /// Number of bytes at the end of the previous slice to return again.
+  size_t backup_count_ = 0;
+  int64_t byte_count_ = 0;
+};
+
+}  // namespace
+
+/* static */ std::unique_ptr<PushRequestReader> PushRequestReader::Parse(
+    const grpc::ByteBuffer &buffer) {
+  std::unique_ptr<PushRequestReader> reader(new PushRequestReader());
+  if (!buffer.Dump(&reader->slices_).ok()) {
+    return nullptr;
+  }
+
+  // All fields but `data` are re-encoded into this string and parsed by protobuf.
+  std::string header;
+  {
+    SliceInputStream slice_stream(reader->slices_);
+    google::protobuf::io::CodedInputStream input(&slice_stream);
+    google::protobuf::io::StringOutputStream header_stream(&header);
+    google::protobuf::io::CodedOutputStream header_output(&header_stream);
+
+    while (true) {
+      uint32_t tag = input.ReadTag();
+      if (tag == 0) {
+        // End of the message. A tag of 0 is invalid, which is only fine at the end.
+        if (!input.ConsumedEntireMessage()) {
+          return nullptr;
+        }
+        break;
+      }
+      if (WireFormatLite::GetTagFieldNumber(tag) != rpc::PushRequest::kDataFieldNumber ||
+          WireFormatLite::GetTagWireType(tag) !=
+              WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+        if (!WireFormatLite::SkipField(&input, tag, &header_output)) {
+          return nullptr;
+        }
+        continue;
+      }
+
+      // The chunk payload: record views into the slices instead of copying it.
+      // If the field is repeated on the wire, protobuf keeps the last value.
+      uint32_t length;
+      if (!input.ReadVarint32(&length)) {
+        return nullptr;
+      }
+      reader->data_.clear();
+      reader->data_size_ = length;
+      while (length > 0) {
+        const void *data;
+        int size;
+        if (!input.GetDirectBufferPointer(&data, &size)) {
+          return nullptr;
+        }
+        uint32_t piece_size = std::min(length, static_cast<uint32_t>(size));
+        reader->data_.emplace_back(static_cast<const char *>(data), piece_size);
+        if (!input.Skip(piece_size)) {
+          return nullptr;
+        }
+        length -= piece_size;
+      }
+    }
+  }
+
+  if (!reader->header_.ParseFromString(header)) {
+    return nullptr;
+  }
+  return reader;
+}
+
+}  // namespace ray
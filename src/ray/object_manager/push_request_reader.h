@@ -0,0 +1,62 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "src/ray/protobuf/object_manager.pb.h"
+
+namespace ray {
+
+/// Reader of a serialized `PushRequest` received as a raw gRPC byte buffer.
+///
+/// Parsing a `PushRequest` with protobuf copies the chunk payload out of the
+/// received gRPC slices into the `data` string, which the object manager then
+/// copies again into the plasma buffer. This reader parses every field but
+/// `data` as usual, and exposes `data` as views into the received slices, so
+/// that the payload is copied only once, straight into plasma.
+///
+/// The views are valid as long as this reader is alive.
+class PushRequestReader {
+ public:
+  /// Parse a serialized `PushRequest`. Return nullptr if the request is malformed.
+  ///
+  /// \param buffer the byte buffer received from gRPC.
+  static std::unique_ptr<PushRequestReader> Parse(const grpc::ByteBuffer &buffer);
+
+  /// The request, with every field set except `data`.
+  const rpc::PushRequest &Header() const { return header_; }
+
+  /// The chunk payload, as views into the received buffer, in order.
+  const std::vector<absl::string_view> &Data() const { return data_; }
+
+  /// Size of the chunk payload in bytes.
+  uint64_t DataSize() const { return data_size_; }
+
+ private:
+  PushRequestReader() = default;
+
+  /// The slices of the received buffer. Views in data_ point into them.
+  std::vector<grpc::Slice> slices_;
+  rpc::PushRequest header_;
+  std::vector<absl::string_view> data_;
+  uint64_t data_size_ = 0;
+};
+
+}  // namespace ray
@@ -0,0 +1,78 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/receiving_object_reader.h"
+
+namespace ray {
+
+ReceivingObjectReader::ReceivingObjectReader(ObjectBufferPool &buffer_pool,
+                                             const ObjectID &object_id,
+                                             uint64_t data_size,
+                                             uint64_t metadata_size,
+                                             rpc::Address owner_address)
+    : buffer_pool_(buffer_pool),
+      object_id_(object_id),
+      data_size_(data_size),
+      metadata_size_(metadata_size),
+      owner_address_(std::move(owner_address)) {}
+
+bool ReceivingObjectReader::ReadFromDataSection(uint64_t offset,
+                                                uint64_t size,
+                                                char *output) const {
+  if (offset + size > GetDataSize()) {
+    return false;
+  }
+  return Read(offset, size, output);
+}
+
+bool ReceivingObjectReader::ReadFromMetadataSection(uint64_t offset,
+                                                    uint64_t size,
+                                                    char *output) const {
+  if (offset + size > GetMetadataSize()) {
+    return false;
+  }
+  return Read(GetDataSize() + offset, size, output);
+}
+
+bool ReceivingObjectReader::Read(uint64_t offset, uint64_t size, char *output) const {
+  std::shared_ptr<MemoryObjectReader> sealed_object;
+  {
+    absl::MutexLock lock(&mu_);
+    sealed_object = sealed_object_;
+  }
+  if (sealed_object == nullptr) {
+    if (buffer_pool_.ReadReceivedData(object_id_, offset, size, output)) {
+      return true;
+    }
+    // The object isn't being received anymore: it has either been fully received
+    // and sealed, or aborted.
+    auto reader_status = buffer_pool_.CreateObjectReader(object_id_, owner_address_);
+    if (!reader_status.second.ok()) {
+      return false;
+    }
+    sealed_object = std::move(reader_status.first);
+    if (sealed_object->GetDataSize() != GetDataSize() ||
+        sealed_object->GetMetadataSize() != GetMetadataSize()) {
+      return false;
+    }
+    absl::MutexLock lock(&mu_);
+    sealed_object_ = sealed_object;
+  }
+  if (offset < GetDataSize()) {
+    return sealed_object->ReadFromDataSection(offset, size, output);
+  }
+  return sealed_object->ReadFromMetadataSection(offset - GetDataSize(), size, output);
+}
+
+}  // namespace ray
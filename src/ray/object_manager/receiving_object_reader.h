@@ -0,0 +1,66 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "absl/synchronization/mutex.h"
+#include "ray/object_manager/object_buffer_pool.h"
+#include "ray/object_manager/object_reader.h"
+
+namespace ray {
+
+/// Reader over an object that is being received from another node, so that the
+/// chunks received so far can be forwarded to other nodes. Once the object has
+/// been fully received, it reads from the sealed object in plasma. Please read
+/// ray/object_manager/object_reader.h for interface guarantees. This class is
+/// thread safe.
+///
+/// Reads fail for the ranges that haven't been received yet. The caller is
+/// expected to check that a chunk has been received before reading it, see
+/// ObjectBufferPool::IsChunkReceived.
+class ReceivingObjectReader : public IObjectReader {
+ public:
+  ReceivingObjectReader(ObjectBufferPool &buffer_pool,
+                        const ObjectID &object_id,
+                        uint64_t data_size,
+                        uint64_t metadata_size,
+                        rpc::Address owner_address);
+
+  uint64_t GetDataSize() const override { return data_size_; }
+
+  uint64_t GetMetadataSize() const override { return metadata_size_; }
+
+  const rpc::Address &GetOwnerAddress() const override { return owner_address_; }
+
+  bool ReadFromDataSection(uint64_t offset, uint64_t size, char *output) const override;
+  bool ReadFromMetadataSection(uint64_t offset,
+                               uint64_t size,
+                               char *output) const override;
+
+ private:
+  /// Read a range of the object data followed by its metadata.
+  bool Read(uint64_t offset, uint64_t size, char *output) const;
+
+  ObjectBufferPool &buffer_pool_;
+  const ObjectID object_id_;
+  const uint64_t data_size_;
+  const uint64_t metadata_size_;
+  const rpc::Address owner_address_;
+
+  mutable absl::Mutex mu_;
+  /// The reader of the sealed object, once the object has been fully received.
+  mutable std::shared_ptr<MemoryObjectReader> sealed_object_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace ray
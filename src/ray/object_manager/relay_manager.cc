@@ -0,0 +1,170 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/relay_manager.h"
+
+#include <sstream>
+#include <utility>
+
+#include "ray/object_manager/receiving_object_reader.h"
+#include "ray/util/logging.h"
+
+namespace ray {
+
+RelayManager::RelayManager(int64_t max_fanout,
+                           uint64_t chunk_size,
+                           int64_t push_timeout_ms,
+                           ObjectBufferPool &buffer_pool,
+                           PushManager &push_manager,
+                           std::function<bool(const ObjectID &)> is_object_local,
+                           SendPullRequestCallback send_pull_request,
+                           SendChunkCallback send_chunk,
+                           std::function<int64_t()> get_time_ms)
+    : chunk_size_(chunk_size),
+      push_timeout_ms_(push_timeout_ms),
+      buffer_pool_(buffer_pool),
+      push_manager_(push_manager),
+      is_object_local_(std::move(is_object_local)),
+      send_pull_request_(std::move(send_pull_request)),
+      send_chunk_(std::move(send_chunk)),
+      get_time_ms_(std::move(get_time_ms)),
+      broadcast_manager_(max_fanout,
+                         [this](const NodeID &node_id, const ObjectID &object_id) {
+                           return push_manager_.IsPushInProgress(node_id, object_id);
+                         }) {}
+
+bool RelayManager::ForwardPull(const ObjectID &object_id, const NodeID &node_id) {
+  auto forward_to = broadcast_manager_.ForwardPullTo(object_id, node_id);
+  if (forward_to.IsNil()) {
+    return false;
+  }
+  send_pull_request_(object_id, forward_to, /*requester_id=*/node_id);
+  return true;
+}
+
+bool RelayManager::RelayReceivingObject(const ObjectID &object_id,
+                                        const NodeID &node_id) {
+  uint64_t data_size;
+  uint64_t metadata_size;
+  rpc::Address owner_address;
+  if (!buffer_pool_.GetReceivingObject(
+          object_id, &data_size, &metadata_size, &owner_address)) {
+    return false;
+  }
+  if (ForwardPull(object_id, node_id)) {
+    return true;
+  }
+
+  RAY_LOG(DEBUG) << "Relaying object chunks of " << object_id << " to node " << node_id
+                 << ", total data size: " << data_size;
+  num_objects_relayed_++;
+  // The data size of the buffer pool includes the metadata.
+  auto chunk_reader = std::make_shared<ChunkObjectReader>(
+      std::make_shared<ReceivingObjectReader>(buffer_pool_,
+                                              object_id,
+                                              data_size - metadata_size,
+                                              metadata_size,
+                                              std::move(owner_address)),
+      chunk_size_);
+  auto push_id = UniqueID::FromRandom();
+  push_manager_.StartPush(
+      node_id, object_id, chunk_reader->GetNumChunks(), [=](int64_t chunk_index) {
+        SendRelayedChunk(push_id, object_id, node_id, chunk_index, chunk_reader);
+      });
+  return true;
+}
+
+void RelayManager::SendRelayedChunk(const UniqueID &push_id,
+                                    const ObjectID &object_id,
+                                    const NodeID &node_id,
+                                    uint64_t chunk_index,
+                                    std::shared_ptr<ChunkObjectReader> chunk_reader) {
+  if (!is_object_local_(object_id) &&
+      !buffer_pool_.IsChunkReceived(object_id, chunk_index)) {
+    // The chunk is still in flight to this node. It's sent once received, see
+    // HandleObjectChunkReceived.
+    waiting_chunks_[object_id].push_back({push_id,
+                                          node_id,
+                                          chunk_index,
+                                          std::move(chunk_reader),
+                                          get_time_ms_() + push_timeout_ms_});
+    return;
+  }
+  send_chunk_(push_id, object_id, node_id, chunk_index, std::move(chunk_reader));
+}
+
+void RelayManager::HandleObjectChunkReceived(const ObjectID &object_id) {
+  auto it = waiting_chunks_.find(object_id);
+  if (it == waiting_chunks_.end()) {
+    return;
+  }
+  // Sending a chunk may wait again, so take the chunks out of the map first.
+  auto waiting_chunks = std::move(it->second);
+  waiting_chunks_.erase(it);
+  for (auto &chunk : waiting_chunks) {
+    SendRelayedChunk(chunk.push_id,
+                     object_id,
+                     chunk.node_id,
+                     chunk.chunk_index,
+                     std::move(chunk.chunk_reader));
+  }
+}
+
+void RelayManager::Tick() {
+  ExpireWaitingChunks();
+  broadcast_manager_.RemoveCompletedPushes();
+}
+
+void RelayManager::ExpireWaitingChunks() {
+  if (push_timeout_ms_ < 0) {
+    return;
+  }
+  int64_t now_ms = get_time_ms_();
+  std::vector<std::pair<NodeID, ObjectID>> expired_chunks;
+  for (auto it = waiting_chunks_.begin(); it != waiting_chunks_.end();) {
+    auto &waiting_chunks = it->second;
+    for (auto chunk = waiting_chunks.begin(); chunk != waiting_chunks.end();) {
+      if (chunk->deadline_ms <= now_ms) {
+        expired_chunks.emplace_back(chunk->node_id, it->first);
+        chunk = waiting_chunks.erase(chunk);
+      } else {
+        chunk++;
+      }
+    }
+    if (waiting_chunks.empty()) {
+      waiting_chunks_.erase(it++);
+    } else {
+      it++;
+    }
+  }
+  // The relayed objects weren't received in time, e.g. because the pull of this node
+  // was cancelled. The nodes they're relayed to will pull them again.
+  for (const auto &[node_id, object_id] : expired_chunks) {
+    RAY_LOG(DEBUG) << "Timed out waiting to receive object " << object_id
+                   << " to relay it to node " << node_id;
+    push_manager_.OnChunkComplete(
+        node_id, object_id, Status::TimedOut("Object to relay wasn't received"));
+  }
+}
+
+std::string RelayManager::DebugString() const {
+  std::stringstream result;
+  result << broadcast_manager_.DebugString();
+  result << "\n- num objects relayed while received: " << num_objects_relayed_;
+  result << "\n- num objects with chunks waiting to be relayed: "
+         << waiting_chunks_.size();
+  return result.str();
+}
+
+}  // namespace ray
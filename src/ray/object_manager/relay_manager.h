@@ -0,0 +1,149 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "ray/common/id.h"
+#include "ray/object_manager/broadcast_manager.h"
+#include "ray/object_manager/chunk_object_reader.h"
+#include "ray/object_manager/object_buffer_pool.h"
+#include "ray/object_manager/push_manager.h"
+#include "ray/util/util.h"
+
+namespace ray {
+
+/// Serves the pulls of an object that is broadcast to many nodes, see
+/// BroadcastManager. It forwards pulls to the nodes this node is already pushing the
+/// object to, and relays the object to other nodes while this node is still
+/// receiving it, sending each chunk once it has been received.
+///
+/// The object manager owns one if broadcast is enabled. The network is reached
+/// through the callbacks, so that it can be driven without rpc clients.
+class RelayManager {
+ public:
+  /// Send the pull of an object of the requester node to another node.
+  using SendPullRequestCallback = std::function<void(
+      const ObjectID &object_id, const NodeID &node_id, const NodeID &requester_id)>;
+
+  /// Send a chunk of an object to a node, and call PushManager::OnChunkComplete
+  /// once it has been sent.
+  using SendChunkCallback =
+      std::function<void(const UniqueID &push_id,
+                         const ObjectID &object_id,
+                         const NodeID &node_id,
+                         uint64_t chunk_index,
+                         std::shared_ptr<ChunkObjectReader> chunk_reader)>;
+
+  /// Create a relay manager.
+  ///
+  /// \param max_fanout The max number of nodes to push an object to at a time.
+  /// \param chunk_size The size of the chunks objects are sent in.
+  /// \param push_timeout_ms How long to wait for a chunk to be received to relay it.
+  /// A negative value waits forever.
+  /// \param buffer_pool The buffer pool the objects are received in.
+  /// \param push_manager The push manager the relayed chunks are sent through.
+  /// \param is_object_local Returns whether an object is sealed in the local store.
+  /// \param send_pull_request Sends a forwarded pull.
+  /// \param send_chunk Sends a relayed chunk.
+  /// \param get_time_ms The clock of the chunk deadlines.
+  RelayManager(int64_t max_fanout,
+               uint64_t chunk_size,
+               int64_t push_timeout_ms,
+               ObjectBufferPool &buffer_pool,
+               PushManager &push_manager,
+               std::function<bool(const ObjectID &)> is_object_local,
+               SendPullRequestCallback send_pull_request,
+               SendChunkCallback send_chunk,
+               std::function<int64_t()> get_time_ms = current_time_ms);
+
+  /// Forward a pull of an object to another node that is receiving the object from
+  /// this node, if this node is already pushing the object to enough nodes.
+  ///
+  /// \param object_id The object's id.
+  /// \param node_id The id of the node that pulls the object.
+  /// \return Whether the pull was forwarded.
+  bool ForwardPull(const ObjectID &object_id, const NodeID &node_id);
+
+  /// Relay an object that is being received to a remote node, chunk by chunk as
+  /// they are received, unless the pull is forwarded.
+  ///
+  /// \param object_id The object's id.
+  /// \param node_id The remote node's id.
+  /// \return Whether the object is being received. If not, nothing is sent.
+  bool RelayReceivingObject(const ObjectID &object_id, const NodeID &node_id);
+
+  /// Handle a chunk of an object received from a remote node, or the object being
+  /// sealed, to send the relayed chunks that were waiting for it.
+  void HandleObjectChunkReceived(const ObjectID &object_id);
+
+  /// Fail the chunks that have waited for too long to be received, and forget the
+  /// pushes that have completed. Called periodically.
+  void Tick();
+
+  /// Return the number of objects with chunks waiting to be received to be relayed.
+  size_t NumObjectsWaiting() const { return waiting_chunks_.size(); }
+
+  /// Return the number of objects relayed while they were being received.
+  int64_t NumObjectsRelayed() const { return num_objects_relayed_; }
+
+  std::string DebugString() const;
+
+ private:
+  /// A chunk of an object being relayed, waiting for the chunk to be received.
+  struct WaitingChunk {
+    UniqueID push_id;
+    NodeID node_id;
+    uint64_t chunk_index;
+    std::shared_ptr<ChunkObjectReader> chunk_reader;
+    /// Time after which the chunk is failed, in milliseconds.
+    int64_t deadline_ms;
+  };
+
+  /// Send a chunk of an object that is being relayed if it has been received, or
+  /// wait for it otherwise.
+  void SendRelayedChunk(const UniqueID &push_id,
+                        const ObjectID &object_id,
+                        const NodeID &node_id,
+                        uint64_t chunk_index,
+                        std::shared_ptr<ChunkObjectReader> chunk_reader);
+
+  /// Fail the chunks that have waited for too long to be received.
+  void ExpireWaitingChunks();
+
+  const uint64_t chunk_size_;
+  const int64_t push_timeout_ms_;
+  ObjectBufferPool &buffer_pool_;
+  PushManager &push_manager_;
+  const std::function<bool(const ObjectID &)> is_object_local_;
+  const SendPullRequestCallback send_pull_request_;
+  const SendChunkCallback send_chunk_;
+  const std::function<int64_t()> get_time_ms_;
+
+  /// Decides which pulls to forward to other nodes.
+  BroadcastManager broadcast_manager_;
+
+  /// The chunks of the objects being relayed that haven't been received yet.
+  absl::flat_hash_map<ObjectID, std::vector<WaitingChunk>> waiting_chunks_;
+
+  /// The number of objects relayed while they were being received.
+  int64_t num_objects_relayed_ = 0;
+};
+
+}  // namespace ray
@@ -0,0 +1,179 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/spilled_object_file_cache.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include <sstream>
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+/// An open, read-only spilled file.
+class SpilledObjectFileCache::FileHandle {
+ public:
+  static std::shared_ptr<FileHandle> Open(const std::string &file_path) {
+#ifdef _WIN32
+    auto handle = std::shared_ptr<FileHandle>(new FileHandle());
+    handle->is_.open(file_path, std::ios::binary);
+    if (!handle->is_) {
+      return nullptr;
+    }
+    return handle;
+#else
+    int fd = open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+    return std::shared_ptr<FileHandle>(new FileHandle(fd));
+#endif
+  }
+
+  ~FileHandle() {
+#ifndef _WIN32
+    close(fd_);
+#endif
+  }
+
+  bool Read(uint64_t offset, uint64_t size, char *output) {
+#ifdef _WIN32
+    // There is no positional read on an ifstream, so serialize the seek + read.
+    absl::MutexLock lock(&mu_);
+    is_.clear();
+    return is_.seekg(offset) && is_.read(output, size);
+#else
+    while (size > 0) {
+      ssize_t n = pread(fd_, output, size, offset);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        // Error, or end of file before the requested bytes were read.
+        return false;
+      }
+      output += n;
+      offset += n;
+      size -= n;
+    }
+    return true;
+#endif
+  }
+
+ private:
+#ifdef _WIN32
+  FileHandle() = default;
+
+  absl::Mutex mu_;
+  std::ifstream is_ ABSL_GUARDED_BY(mu_);
+#else
+  explicit FileHandle(int fd) : fd_(fd) {}
+
+  const int fd_;
+#endif
+};
+
+SpilledObjectFileCache::SpilledObjectFileCache(size_t max_open_files)
+    : max_open_files_(max_open_files) {
+  RAY_CHECK(max_open_files_ > 0) << "max_open_files shouldn't be 0";
+}
+
+bool SpilledObjectFileCache::Read(const std::string &file_path,
+                                  uint64_t offset,
+                                  uint64_t size,
+                                  char *output) {
+  auto handle = GetOrOpen(file_path);
+  if (handle == nullptr) {
+    return false;
+  }
+  // Read without holding the cache lock so that reads of different chunks can
+  // proceed in parallel on the rpc threads.
+  if (!handle->Read(offset, size, output)) {
+    return false;
+  }
+  num_bytes_read_.fetch_add(size, std::memory_order_relaxed);
+  return true;
+}
+
+std::shared_ptr<SpilledObjectFileCache::FileHandle> SpilledObjectFileCache::GetOrOpen(
+    const std::string &file_path) {
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = open_files_.find(file_path);
+    if (it != open_files_.end()) {
+      num_hits_.fetch_add(1, std::memory_order_relaxed);
+      lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_it);
+      return it->second.handle;
+    }
+  }
+
+  num_misses_.fetch_add(1, std::memory_order_relaxed);
+  // Open the file outside of the lock; it might block on slow storage.
+  auto handle = FileHandle::Open(file_path);
+  if (handle == nullptr) {
+    RAY_LOG(DEBUG) << "Failed to open spilled file " << file_path;
+    return nullptr;
+  }
+
+  absl::MutexLock lock(&mu_);
+  auto it = open_files_.find(file_path);
+  if (it != open_files_.end()) {
+    // Another thread opened the same file concurrently; keep its handle.
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_it);
+    return it->second.handle;
+  }
+  while (open_files_.size() >= max_open_files_) {
+    open_files_.erase(lru_list_.back());
+    lru_list_.pop_back();
+  }
+  lru_list_.push_front(file_path);
+  open_files_.emplace(file_path, Entry{handle, lru_list_.begin()});
+  return handle;
+}
+
+void SpilledObjectFileCache::Evict(const std::string &file_path) {
+  absl::MutexLock lock(&mu_);
+  auto it = open_files_.find(file_path);
+  if (it == open_files_.end()) {
+    return;
+  }
+  lru_list_.erase(it->second.lru_it);
+  open_files_.erase(it);
+}
+
+size_t SpilledObjectFileCache::NumOpenFiles() const {
+  absl::MutexLock lock(&mu_);
+  return open_files_.size();
+}
+
+std::string SpilledObjectFileCache::DebugString() const {
+  std::stringstream result;
+  result << "SpilledObjectFileCache:";
+  result << "\n- num open files: " << NumOpenFiles();
+  result << "\n- max open files: " << max_open_files_;
+  result << "\n- num hits: " << NumHits();
+  result << "\n- num misses: " << NumMisses();
+  result << "\n- num bytes read: " << NumBytesRead();
+  return result.str();
+}
+
+}  // namespace ray
@@ -0,0 +1,103 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace ray {
+
+/// A bounded LRU cache of open file handles for spilled object files.
+///
+/// Spilled objects are fused into large files, and pushing a spilled object
+/// reads it chunk by chunk. Without this cache every chunk read opens, seeks
+/// and closes the spill file. The cache keeps the most recently used files open
+/// and serves reads with a positional read (pread) straight into the caller's
+/// buffer, so concurrent readers of the same file don't share a file offset.
+///
+/// A file handle that is evicted while a read is in progress is kept alive
+/// until that read finishes. Note that a cached handle keeps a deleted spill
+/// file readable (and its disk space allocated) until it's evicted or Evict()
+/// is called for that path.
+///
+/// This class is thread safe.
+class SpilledObjectFileCache {
+ public:
+  /// Create a file cache.
+  ///
+  /// \param max_open_files the maximum number of file handles to keep open.
+  explicit SpilledObjectFileCache(size_t max_open_files);
+
+  /// Read `size` bytes at `offset` of `file_path` into `output`.
+  /// Return false if the file can't be opened or has fewer bytes than requested.
+  ///
+  /// \param file_path path of the spilled file.
+  /// \param offset offset in the file to read from.
+  /// \param size number of bytes to read.
+  /// \param output pointer to the memory location to copy to.
+  /// \return bool.
+  bool Read(const std::string &file_path, uint64_t offset, uint64_t size, char *output);
+
+  /// Close the cached handle of a file, if any. Reads that are in progress
+  /// finish on the old handle.
+  void Evict(const std::string &file_path);
+
+  /// Number of reads served by an already open file handle.
+  uint64_t NumHits() const { return num_hits_.load(std::memory_order_relaxed); }
+
+  /// Number of reads that had to open the file.
+  uint64_t NumMisses() const { return num_misses_.load(std::memory_order_relaxed); }
+
+  /// Total number of bytes successfully read through the cache.
+  uint64_t NumBytesRead() const {
+    return num_bytes_read_.load(std::memory_order_relaxed);
+  }
+
+  /// Number of currently cached file handles.
+  size_t NumOpenFiles() const;
+
+  std::string DebugString() const;
+
+ private:
+  class FileHandle;
+
+  struct Entry {
+    std::shared_ptr<FileHandle> handle;
+    /// Position of the file path in lru_list_.
+    std::list<std::string>::iterator lru_it;
+  };
+
+  /// Return the handle of the file, opening it (and evicting the least recently
+  /// used handle) if needed. Return nullptr if the file can't be opened.
+  std::shared_ptr<FileHandle> GetOrOpen(const std::string &file_path);
+
+  const size_t max_open_files_;
+
+  mutable absl::Mutex mu_;
+  /// File paths ordered from the most recently used to the least recently used.
+  std::list<std::string> lru_list_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<std::string, Entry> open_files_ ABSL_GUARDED_BY(mu_);
+
+  std::atomic<uint64_t> num_hits_{0};
+  std::atomic<uint64_t> num_misses_{0};
+  std::atomic<uint64_t> num_bytes_read_{0};
+};
+
+}  // namespace ray
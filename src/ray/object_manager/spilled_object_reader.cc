@@ -25,7 +25,8 @@ const size_t UINT64_size = sizeof(uint64_t);
 }
 
 /* static */ absl::optional<SpilledObjectReader>
-SpilledObjectReader::CreateSpilledObjectReader(const std::string &object_url) {
+SpilledObjectReader::CreateSpilledObjectReader(
+    const std::string &object_url, std::shared_ptr<SpilledObjectFileCache> file_cache) {
   std::string file_path;
   uint64_t object_offset = 0;
   uint64_t object_size = 0;
@@ -61,7 +62,8 @@ SpilledObjectReader::CreateSpilledObjectReader(const std::string &object_url) {
                           data_size,
                           metadata_offset,
                           metadata_size,
-                          std::move(owner_address)));
+                          std::move(owner_address),
+                          std::move(file_cache)));
 }
 
 uint64_t SpilledObjectReader::GetDataSize() const { return data_size_; }
@@ -72,20 +74,23 @@ const rpc::Address &SpilledObjectReader::GetOwnerAddress() const {
   return owner_address_;
 }
 
-SpilledObjectReader::SpilledObjectReader(std::string file_path,
-                                         uint64_t object_size,
-                                         uint64_t data_offset,
-                                         uint64_t data_size,
-                                         uint64_t metadata_offset,
-                                         uint64_t metadata_size,
-                                         rpc::Address owner_address)
+SpilledObjectReader::SpilledObjectReader(
+    std::string file_path,
+    uint64_t object_size,
+    uint64_t data_offset,
+    uint64_t data_size,
+    uint64_t metadata_offset,
+    uint64_t metadata_size,
+    rpc::Address owner_address,
+    std::shared_ptr<SpilledObjectFileCache> file_cache)
     : file_path_(std::move(file_path)),
       object_size_(object_size),
       data_offset_(data_offset),
       data_size_(data_size),
       metadata_offset_(metadata_offset),
       metadata_size_(metadata_size),
-      owner_address_(std::move(owner_address)) {}
+      owner_address_(std::move(owner_address)),
+      file_cache_(std::move(file_cache)) {}
 
 /* static */ bool SpilledObjectReader::ParseObjectURL(const std::string &object_url,
                                                       std::string &file_path,
@@ -169,14 +174,22 @@ uint64_t SpilledObjectReader::ToUINT64(const std::string &s) {
 bool SpilledObjectReader::ReadFromDataSection(uint64_t offset,
                                               uint64_t size,
                                               char *output) const {
-  std::ifstream is(file_path_, std::ios::binary);
-  return is.seekg(data_offset_ + offset) && is.read(output, size);
+  return ReadFromFile(data_offset_ + offset, size, output);
 }
 
 bool SpilledObjectReader::ReadFromMetadataSection(uint64_t offset,
                                                   uint64_t size,
                                                   char *output) const {
+  return ReadFromFile(metadata_offset_ + offset, size, output);
+}
+
+bool SpilledObjectReader::ReadFromFile(uint64_t offset,
+                                       uint64_t size,
+                                       char *output) const {
+  if (file_cache_ != nullptr) {
+    return file_cache_->Read(file_path_, offset, size, output);
+  }
   std::ifstream is(file_path_, std::ios::binary);
-  return is.seekg(metadata_offset_ + offset) && is.read(output, size);
+  return is.seekg(offset) && is.read(output, size);
 }
 }  // namespace ray
@@ -16,10 +16,12 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <memory>
 #include <string>
 
 #include "absl/types/optional.h"
 #include "ray/object_manager/object_reader.h"
+#include "ray/object_manager/spilled_object_file_cache.h"
 #include "src/ray/protobuf/common.pb.h"
 
 namespace ray {
@@ -31,8 +33,11 @@ class SpilledObjectReader : public IObjectReader {
   /// malformed url; corrupted/deleted file.
   ///
   /// \param object_url the object url in the form of {path}?offset={offset}&size={size}
+  /// \param file_cache if set, the object is read through this shared cache of open
+  /// file handles instead of opening the file on every read.
   static absl::optional<SpilledObjectReader> CreateSpilledObjectReader(
-      const std::string &object_url);
+      const std::string &object_url,
+      std::shared_ptr<SpilledObjectFileCache> file_cache = nullptr);
 
   uint64_t GetDataSize() const override;
 
@@ -52,7 +57,11 @@ class SpilledObjectReader : public IObjectReader {
                       uint64_t data_size,
                       uint64_t metadata_offset,
                       uint64_t metadata_size,
-                      rpc::Address owner_address);
+                      rpc::Address owner_address,
+                      std::shared_ptr<SpilledObjectFileCache> file_cache = nullptr);
+
+  /// Read from the spilled file, either through the file cache or by opening it.
+  bool ReadFromFile(uint64_t offset, uint64_t size, char *output) const;
 
   /// Parse the object url in the form of {path}?offset={offset}&size={size}.
   /// Return false if parsing failed.
@@ -117,6 +126,7 @@ class SpilledObjectReader : public IObjectReader {
   const uint64_t metadata_offset_;
   const uint64_t metadata_size_;
   const rpc::Address owner_address_;
+  const std::shared_ptr<SpilledObjectFileCache> file_cache_;
 };
 
 }  // namespace ray
@@ -0,0 +1,520 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/object_manager/broadcast_manager.h"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "gtest/gtest.h"
+#include "ray/common/buffer.h"
+#include "ray/object_manager/chunk_object_reader.h"
+#include "ray/object_manager/object_buffer_pool.h"
+#include "ray/object_manager/plasma/client.h"
+#include "ray/object_manager/push_manager.h"
+#include "ray/object_manager/relay_manager.h"
+#include "ray/util/logging.h"
+#include "ray/util/util.h"
+
+namespace ray {
+
+class BroadcastManagerTest : public ::testing::Test {
+ public:
+  BroadcastManagerTest()
+      : object_id_(ObjectID::FromRandom()),
+        broadcast_manager_(2, [this](const NodeID &node_id, const ObjectID &object_id) {
+          return pushes_.contains(node_id);
+        }) {}
+
+  /// Simulates the object manager: pushes the object if it's not forwarded.
+  NodeID Pull(const NodeID &node_id) {
+    auto forward_to = broadcast_manager_.ForwardPullTo(object_id_, node_id);
+    if (forward_to.IsNil()) {
+      pushes_.insert(node_id);
+    }
+    return forward_to;
+  }
+
+  ObjectID object_id_;
+  absl::flat_hash_set<NodeID> pushes_;
+  BroadcastManager broadcast_manager_;
+};
+
+TEST_F(BroadcastManagerTest, TestForwardPulls) {
+  std::vector<NodeID> node_ids;
+  for (int i = 0; i < 6; i++) {
+    node_ids.push_back(NodeID::FromRandom());
+  }
+  ASSERT_TRUE(Pull(node_ids[0]).IsNil());
+  ASSERT_TRUE(Pull(node_ids[1]).IsNil());
+  ASSERT_EQ(broadcast_manager_.NumObjects(), 1);
+  // Further pulls are forwarded round-robin to the nodes being pushed to.
+  ASSERT_EQ(Pull(node_ids[2]), node_ids[0]);
+  ASSERT_EQ(Pull(node_ids[3]), node_ids[1]);
+  ASSERT_EQ(Pull(node_ids[4]), node_ids[0]);
+  // A retried pull from a node being pushed to isn't forwarded.
+  ASSERT_TRUE(Pull(node_ids[1]).IsNil());
+
+  // Once a push completes, the next pull is served.
+  pushes_.erase(node_ids[0]);
+  ASSERT_TRUE(Pull(node_ids[5]).IsNil());
+  ASSERT_EQ(Pull(node_ids[2]), node_ids[5]);
+}
+
+TEST_F(BroadcastManagerTest, TestRemoveCompletedPushes) {
+  auto node_id = NodeID::FromRandom();
+  ASSERT_TRUE(Pull(node_id).IsNil());
+  broadcast_manager_.RemoveCompletedPushes();
+  ASSERT_EQ(broadcast_manager_.NumObjects(), 1);
+  pushes_.clear();
+  broadcast_manager_.RemoveCompletedPushes();
+  ASSERT_EQ(broadcast_manager_.NumObjects(), 0);
+}
+
+/// A plasma client that keeps the objects in memory.
+class FakePlasmaClient : public plasma::PlasmaClientInterface {
+ public:
+  FakePlasmaClient() = default;
+
+  /// Create the objects that fit in the given buffer in it rather than in their own
+  /// buffer.
+  explicit FakePlasmaClient(std::shared_ptr<Buffer> shared_buffer)
+      : shared_buffer_(std::move(shared_buffer)) {}
+
+  Status Release(const ObjectID &object_id) override { return Status::OK(); }
+
+  Status Disconnect() override { return Status::OK(); }
+
+  Status Get(const std::vector<ObjectID> &object_ids,
+             int64_t timeout_ms,
+             std::vector<plasma::ObjectBuffer> *object_buffers,
+             bool is_from_worker) override {
+    object_buffers->clear();
+    for (const auto &object_id : object_ids) {
+      plasma::ObjectBuffer object_buffer{};
+      auto it = objects_.find(object_id);
+      if (it != objects_.end() && it->second.sealed) {
+        auto &object = it->second;
+        object_buffer.data =
+            SharedMemoryBuffer::Slice(object.buffer, 0, object.data_size);
+        object_buffer.metadata = SharedMemoryBuffer::Slice(
+            object.buffer, object.data_size, object.metadata_size);
+      }
+      object_buffers->push_back(std::move(object_buffer));
+    }
+    return Status::OK();
+  }
+
+  Status GetExperimentalMutableObject(
+      const ObjectID &object_id,
+      std::unique_ptr<plasma::MutableObject> *mutable_object) override {
+    return Status::NotImplemented("");
+  }
+
+  Status Seal(const ObjectID &object_id) override {
+    objects_.at(object_id).sealed = true;
+    return Status::OK();
+  }
+
+  Status Abort(const ObjectID &object_id) override {
+    objects_.erase(object_id);
+    return Status::OK();
+  }
+
+  Status CreateAndSpillIfNeeded(const ObjectID &object_id,
+                                const rpc::Address &owner_address,
+                                bool is_mutable,
+                                int64_t data_size,
+                                const uint8_t *metadata,
+                                int64_t metadata_size,
+                                std::shared_ptr<Buffer> *data,
+                                plasma::flatbuf::ObjectSource source,
+                                int device_num) override {
+    auto &object = objects_[object_id];
+    if (shared_buffer_ != nullptr &&
+        shared_buffer_->Size() >= static_cast<size_t>(data_size + metadata_size)) {
+      object.buffer = shared_buffer_;
+    } else {
+      object.buffer = std::make_shared<LocalMemoryBuffer>(data_size + metadata_size);
+    }
+    object.data_size = data_size;
+    object.metadata_size = metadata_size;
+    *data = SharedMemoryBuffer::Slice(object.buffer, 0, data_size);
+    return Status::OK();
+  }
+
+  Status Delete(const std::vector<ObjectID> &object_ids) override {
+    return Status::OK();
+  }
+
+  bool IsSealed(const ObjectID &object_id) const {
+    auto it = objects_.find(object_id);
+    return it != objects_.end() && it->second.sealed;
+  }
+
+ private:
+  struct Object {
+    std::shared_ptr<Buffer> buffer;
+    int64_t data_size = 0;
+    int64_t metadata_size = 0;
+    bool sealed = false;
+  };
+
+  std::shared_ptr<Buffer> shared_buffer_;
+  absl::flat_hash_map<ObjectID, Object> objects_;
+};
+
+/// An in-process cluster of nodes that broadcast an object with the relay code of
+/// the object manager: each node has an ObjectBufferPool over an in-memory plasma
+/// client, a PushManager and a RelayManager, receivers pull the object from the node
+/// that created it, and a node relays the chunks it has received while it receives
+/// the rest. Only the transport is stubbed: every node has an uplink of fixed
+/// bandwidth that sends one chunk at a time, taking turns between the nodes it sends
+/// to like concurrent connections would, and a fixed latency to every other node.
+class FakeBroadcastCluster {
+ public:
+  struct Options {
+    int num_receivers = 64;
+    uint64_t object_size = 8 * 1024 * 1024;
+    uint64_t chunk_size = 64 * 1024;
+    uint64_t max_bytes_in_flight = 16 * 1024 * 1024;
+    /// 0 disables the broadcast, every node pulls from the node that created it.
+    int64_t max_fanout = 0;
+    double uplink_bytes_per_s = 1.25e9;
+    double latency_s = 0.00001;
+    /// Receive the object in one buffer shared by all receivers, so that objects too
+    /// large to have a copy per node fit in memory. Every receiver writes the same
+    /// bytes at the same offsets, so the buffer still ends up holding the object, but
+    /// only the first receiver's copy is checked.
+    bool share_receiver_buffers = false;
+  };
+
+  explicit FakeBroadcastCluster(const Options &options)
+      : options_(options), object_id_(ObjectID::FromRandom()) {
+    std::shared_ptr<Buffer> receiver_buffer;
+    if (options_.share_receiver_buffers) {
+      receiver_buffer = std::make_shared<LocalMemoryBuffer>(options_.object_size);
+    }
+    for (int i = 0; i <= options_.num_receivers; i++) {
+      auto node = std::make_unique<Node>();
+      node->node_id = NodeID::FromRandom();
+      node->plasma_client = i == 0 ? std::make_shared<FakePlasmaClient>()
+                                   : std::make_shared<FakePlasmaClient>(receiver_buffer);
+      node->buffer_pool =
+          std::make_unique<ObjectBufferPool>(node->plasma_client, options_.chunk_size);
+      node->push_manager = std::make_unique<PushManager>(
+          std::max<int64_t>(1, options_.max_bytes_in_flight / options_.chunk_size),
+          /*adaptive_scheduling=*/false,
+          [this]() { return now_; });
+      if (options_.max_fanout > 0) {
+        node->relay_manager = std::make_unique<RelayManager>(
+            options_.max_fanout,
+            options_.chunk_size,
+            /*push_timeout_ms=*/-1,
+            *node->buffer_pool,
+            *node->push_manager,
+            [node = node.get()](const ObjectID &object_id) {
+              return node->plasma_client->IsSealed(object_id);
+            },
+            [this](const ObjectID &object_id,
+                   const NodeID &node_id,
+                   const NodeID &requester_id) {
+              int forward_index = node_index_.at(node_id);
+              int requester = node_index_.at(requester_id);
+              Schedule(options_.latency_s, [this, forward_index, requester]() {
+                HandlePull(forward_index, requester);
+              });
+            },
+            [this, i](const UniqueID &push_id,
+                      const ObjectID &object_id,
+                      const NodeID &node_id,
+                      uint64_t chunk_index,
+                      std::shared_ptr<ChunkObjectReader> chunk_reader) {
+              SendChunk(i, node_index_.at(node_id), chunk_index, *chunk_reader);
+            },
+            [this]() { return static_cast<int64_t>(now_ * 1000); });
+      }
+      node_index_[node->node_id] = i;
+      nodes_.push_back(std::move(node));
+    }
+    // Node 0 created the object.
+    std::shared_ptr<Buffer> data;
+    RAY_CHECK_OK(nodes_[0]->plasma_client->CreateAndSpillIfNeeded(
+        object_id_,
+        owner_address_,
+        /*is_mutable=*/false,
+        options_.object_size,
+        nullptr,
+        0,
+        &data,
+        plasma::flatbuf::ObjectSource::CreatedByWorker,
+        0));
+    for (uint64_t i = 0; i < options_.object_size; i++) {
+      data->Data()[i] = static_cast<uint8_t>(i * 7);
+    }
+    RAY_CHECK_OK(nodes_[0]->plasma_client->Seal(object_id_));
+    nodes_[0]->completion_time = 0;
+  }
+
+  /// Pull the object on all receivers at once and return the time until they all
+  /// have it.
+  double Broadcast() {
+    for (int i = 1; i <= options_.num_receivers; i++) {
+      Schedule(options_.latency_s, [this, i]() { HandlePull(0, i); });
+    }
+    while (!events_.empty()) {
+      auto event = events_.top();
+      events_.pop();
+      now_ = event.time;
+      event.handler();
+    }
+    auto expected = ReadObject(0);
+    double time_to_all_nodes = 0;
+    for (int i = 1; i <= options_.num_receivers; i++) {
+      RAY_CHECK(nodes_[i]->completion_time >= 0) << i;
+      RAY_CHECK((options_.share_receiver_buffers && i > 1) || ReadObject(i) == expected)
+          << i;
+      time_to_all_nodes = std::max(time_to_all_nodes, nodes_[i]->completion_time);
+    }
+    return time_to_all_nodes;
+  }
+
+  /// Return the number of times a node relayed the object while receiving it.
+  int64_t NumObjectsRelayed() const {
+    int64_t num_relayed = 0;
+    for (const auto &node : nodes_) {
+      if (node->relay_manager != nullptr) {
+        num_relayed += node->relay_manager->NumObjectsRelayed();
+      }
+    }
+    return num_relayed;
+  }
+
+ private:
+  struct Node {
+    NodeID node_id;
+    std::shared_ptr<FakePlasmaClient> plasma_client;
+    std::unique_ptr<ObjectBufferPool> buffer_pool;
+    std::unique_ptr<PushManager> push_manager;
+    std::unique_ptr<RelayManager> relay_manager;
+    /// The time the object was sealed on the node, -1 if it hasn't been.
+    double completion_time = -1;
+    /// The chunks to send to each node, sent round-robin across nodes.
+    std::map<int, std::deque<std::pair<uint64_t, std::string>>> uplink_queues;
+    int last_destination = -1;
+    bool uplink_busy = false;
+    /// Pulls received before the object started being received.
+    std::vector<int> unfulfilled_pulls;
+  };
+
+  struct Event {
+    double time;
+    uint64_t sequence;
+    std::function<void()> handler;
+    bool operator>(const Event &other) const {
+      return std::tie(time, sequence) > std::tie(other.time, other.sequence);
+    }
+  };
+
+  void Schedule(double delay, std::function<void()> handler) {
+    events_.push(Event{now_ + delay, next_sequence_++, std::move(handler)});
+  }
+
+  std::string ReadObject(int node_index) {
+    auto reader = nodes_[node_index]->buffer_pool->CreateObjectReader(object_id_,
+                                                                     owner_address_);
+    RAY_CHECK_OK(reader.second);
+    std::string data(reader.first->GetDataSize(), '\0');
+    RAY_CHECK(reader.first->ReadFromDataSection(0, data.size(), data.data()));
+    return data;
+  }
+
+  /// The dispatch of ObjectManager::Push.
+  void HandlePull(int node_index, int requester) {
+    auto &node = *nodes_[node_index];
+    const auto &requester_id = nodes_[requester]->node_id;
+    if (node.plasma_client->IsSealed(object_id_)) {
+      if (node.relay_manager != nullptr &&
+          node.relay_manager->ForwardPull(object_id_, requester_id)) {
+        return;
+      }
+      // ObjectManager::PushLocalObject.
+      auto reader_status =
+          node.buffer_pool->CreateObjectReader(object_id_, owner_address_);
+      RAY_CHECK_OK(reader_status.second);
+      auto chunk_reader = std::make_shared<ChunkObjectReader>(
+          std::move(reader_status.first), options_.chunk_size);
+      node.push_manager->StartPush(
+          requester_id,
+          object_id_,
+          chunk_reader->GetNumChunks(),
+          [this, node_index, requester, chunk_reader](int64_t chunk_index) {
+            SendChunk(node_index, requester, chunk_index, *chunk_reader);
+          });
+      return;
+    }
+    if (node.relay_manager != nullptr &&
+        node.relay_manager->RelayReceivingObject(object_id_, requester_id)) {
+      return;
+    }
+    node.unfulfilled_pulls.push_back(requester);
+  }
+
+  /// The stub transport: reads the chunk like ObjectManager::SendObjectChunk and
+  /// queues it on the uplink of the node.
+  void SendChunk(int node_index,
+                 int destination,
+                 uint64_t chunk_index,
+                 const ChunkObjectReader &chunk_reader) {
+    auto chunk = chunk_reader.GetChunk(chunk_index);
+    RAY_CHECK(chunk.has_value()) << "Relayed a chunk that wasn't received";
+    auto &node = *nodes_[node_index];
+    node.uplink_queues[destination].emplace_back(chunk_index, std::move(*chunk));
+    if (!node.uplink_busy) {
+      SendNextChunk(node_index);
+    }
+  }
+
+  void SendNextChunk(int node_index) {
+    auto &node = *nodes_[node_index];
+    node.uplink_busy = !node.uplink_queues.empty();
+    if (!node.uplink_busy) {
+      return;
+    }
+    auto it = node.uplink_queues.upper_bound(node.last_destination);
+    if (it == node.uplink_queues.end()) {
+      it = node.uplink_queues.begin();
+    }
+    int destination = it->first;
+    auto chunk = std::make_shared<std::pair<uint64_t, std::string>>(
+        std::move(it->second.front()));
+    it->second.pop_front();
+    if (it->second.empty()) {
+      node.uplink_queues.erase(it);
+    }
+    node.last_destination = destination;
+    double send_time = chunk->second.size() / options_.uplink_bytes_per_s;
+    Schedule(send_time, [this, node_index, destination, chunk]() {
+      Schedule(options_.latency_s, [this, destination, chunk]() {
+        ReceiveChunk(destination, chunk->first, chunk->second);
+      });
+      Schedule(2 * options_.latency_s, [this, node_index, destination]() {
+        nodes_[node_index]->push_manager->OnChunkComplete(nodes_[destination]->node_id,
+                                                         object_id_);
+      });
+      SendNextChunk(node_index);
+    });
+  }
+
+  /// ObjectManager::ReceiveObjectChunk, HandleObjectAdded and
+  /// HandleObjectChunkReceived.
+  void ReceiveChunk(int node_index, uint64_t chunk_index, const std::string &data) {
+    auto &node = *nodes_[node_index];
+    if (node.plasma_client->IsSealed(object_id_)) {
+      return;
+    }
+    auto status = node.buffer_pool->CreateChunk(
+        object_id_, owner_address_, options_.object_size, 0, chunk_index);
+    if (!status.ok()) {
+      // The chunk was already received from another node.
+      return;
+    }
+    node.buffer_pool->WriteChunk(
+        object_id_, options_.object_size, 0, chunk_index, data);
+    if (node.plasma_client->IsSealed(object_id_)) {
+      node.completion_time = now_;
+    }
+    auto unfulfilled_pulls = std::move(node.unfulfilled_pulls);
+    node.unfulfilled_pulls.clear();
+    for (int requester : unfulfilled_pulls) {
+      HandlePull(node_index, requester);
+    }
+    if (node.relay_manager != nullptr) {
+      node.relay_manager->HandleObjectChunkReceived(object_id_);
+    }
+  }
+
+  const Options options_;
+  const ObjectID object_id_;
+  const rpc::Address owner_address_;
+  std::vector<std::unique_ptr<Node>> nodes_;
+  absl::flat_hash_map<NodeID, int> node_index_;
+  double now_ = 0;
+  uint64_t next_sequence_ = 0;
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+};
+
+TEST(BroadcastSimulationTest, TestTimeToAllNodes) {
+  FakeBroadcastCluster::Options options;
+  double time_to_one_node = options.object_size / options.uplink_bytes_per_s;
+
+  double star_time = FakeBroadcastCluster(options).Broadcast();
+  RAY_LOG(INFO) << "Pushing " << options.object_size << " bytes to "
+                << options.num_receivers << " nodes from one node: " << star_time
+                << "s";
+  // The uplink of the node that created the object is the bottleneck.
+  ASSERT_GT(star_time, options.num_receivers * time_to_one_node);
+
+  for (int64_t max_fanout : {1, 2, 4}) {
+    options.max_fanout = max_fanout;
+    FakeBroadcastCluster cluster(options);
+    double tree_time = cluster.Broadcast();
+    RAY_LOG(INFO) << "Broadcasting " << options.object_size << " bytes to "
+                  << options.num_receivers << " nodes with a fanout of " << max_fanout
+                  << ": " << tree_time << "s";
+    // Each node sends the object to at most max_fanout nodes while it receives it,
+    // but the pushes of a node don't all get chunks in flight at once.
+    ASSERT_LT(tree_time, 2 * max_fanout * time_to_one_node);
+    ASSERT_LT(tree_time, star_time / 10);
+    // The nodes relayed the object while receiving it.
+    ASSERT_GT(cluster.NumObjectsRelayed(), 0);
+  }
+}
+
+// Broadcasts 1 GiB to 64 nodes in the default 5 MiB chunks, to compare the time to
+// all nodes with and without relaying. It takes minutes, so it's disabled by default.
+TEST(BroadcastSimulationTest, DISABLED_TimeToAllNodesPerf) {
+  FakeBroadcastCluster::Options options;
+  options.object_size = 1024 * 1024 * 1024;
+  options.chunk_size = 5 * 1024 * 1024;
+  options.latency_s = 0.0001;
+  options.share_receiver_buffers = true;
+
+  for (int64_t max_fanout : {0, 1, 2, 4}) {
+    options.max_fanout = max_fanout;
+    FakeBroadcastCluster cluster(options);
+    int64_t start_time = current_time_ms();
+    double time_to_all_nodes = cluster.Broadcast();
+    RAY_LOG(INFO) << "Sending " << options.object_size << " bytes to "
+                  << options.num_receivers << " nodes with a fanout of " << max_fanout
+                  << ": " << time_to_all_nodes << "s to all nodes, "
+                  << cluster.NumObjectsRelayed() << " objects relayed, simulated in "
+                  << current_time_ms() - start_time << "ms";
+  }
+}
+
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -525,6 +525,51 @@ TEST_F(CreateRequestQueueTest, TestFallbackAllocationFailled) {
   AssertNoLeaks();
 }
 
+TEST_F(CreateRequestQueueTest, TestBatchRequest) {
+  std::vector<ObjectID> object_ids;
+  for (int i = 0; i < 3; i++) {
+    object_ids.push_back(ObjectID::FromRandom());
+  }
+  int num_calls = 0;
+  auto batch_request = [&](bool fallback, std::vector<PlasmaObject> *results) {
+    num_calls++;
+    if (num_calls == 1) {
+      return PlasmaError::OutOfMemory;
+    }
+    results->resize(object_ids.size());
+    for (size_t i = 0; i < results->size(); i++) {
+      (*results)[i].data_size = i;
+    }
+    return PlasmaError::OK;
+  };
+  auto request = [&](bool fallback, PlasmaObject *result) {
+    result->data_size = 1234;
+    return PlasmaError::OK;
+  };
+
+  // The batch is retried as a single request and blocks the requests behind it.
+  auto client = std::make_shared<MockClient>();
+  auto req_id1 = queue_.AddBatchRequest(object_ids, client, batch_request, 3 * 1234);
+  auto req_id2 = queue_.AddRequest(ObjectID::Nil(), client, request, 1234);
+  ASSERT_TRUE(queue_.ProcessRequests().IsObjectStoreFull());
+  ASSERT_EQ(num_calls, 1);
+  std::vector<PlasmaObject> results;
+  PlasmaError status;
+  ASSERT_FALSE(queue_.GetBatchRequestResult(req_id1, &results, &status));
+  ASSERT_REQUEST_UNFINISHED(queue_, req_id2);
+
+  ASSERT_TRUE(queue_.ProcessRequests().ok());
+  ASSERT_EQ(num_calls, 2);
+  ASSERT_TRUE(queue_.GetBatchRequestResult(req_id1, &results, &status));
+  ASSERT_EQ(status, PlasmaError::OK);
+  ASSERT_EQ(results.size(), object_ids.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    ASSERT_EQ(results[i].data_size, i);
+  }
+  ASSERT_REQUEST_FINISHED(queue_, req_id2, PlasmaError::OK);
+  AssertNoLeaks();
+}
+
 }  // namespace plasma
 
 int main(int argc, char **argv) {
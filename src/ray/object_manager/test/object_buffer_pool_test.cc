@@ -65,10 +65,13 @@ class MockPlasmaClient : public plasma::PlasmaClientInterface {
                                      plasma::flatbuf::ObjectSource source,
                                      int device_num) {
     *data = std::make_shared<LocalMemoryBuffer>(data_size);
+    last_created_buffer_ = *data;
     return ray::Status::OK();
   }
 
   MOCK_METHOD1(Delete, ray::Status(const std::vector<ObjectID> &object_ids));
+
+  std::shared_ptr<Buffer> last_created_buffer_;
 };
 
 class ObjectBufferPoolTest : public ::testing::Test {
@@ -123,6 +126,81 @@ TEST_F(ObjectBufferPoolTest, TestMultiChunk) {
   }
 }
 
+TEST_F(ObjectBufferPoolTest, TestWriteChunkFromPieces) {
+  auto obj_id = ObjectID::FromRandom();
+  rpc::Address owner_address;
+
+  ASSERT_TRUE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, 2 * chunk_size_, 0, 1)
+          .ok());
+  std::string first(chunk_size_ / 4, 'a');
+  std::string second(chunk_size_ - first.size(), 'b');
+  std::vector<absl::string_view> pieces = {first, "", second};
+  object_buffer_pool_.WriteChunk(obj_id, 2 * chunk_size_, 0, 1, pieces);
+
+  auto buffer = mock_plasma_client_->last_created_buffer_;
+  std::string written(reinterpret_cast<const char *>(buffer->Data()) + chunk_size_,
+                      chunk_size_);
+  ASSERT_EQ(first + second, written);
+
+  ASSERT_TRUE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, 2 * chunk_size_, 0, 0)
+          .ok());
+  EXPECT_CALL(*mock_plasma_client_, Seal(obj_id));
+  EXPECT_CALL(*mock_plasma_client_, Release(obj_id));
+  object_buffer_pool_.WriteChunk(obj_id, 2 * chunk_size_, 0, 0, mock_data_);
+  AssertNoLeaks();
+}
+
+TEST_F(ObjectBufferPoolTest, TestReadReceivedData) {
+  auto obj_id = ObjectID::FromRandom();
+  rpc::Address owner_address;
+  owner_address.set_port(1234);
+  uint64_t data_size;
+  uint64_t metadata_size;
+  rpc::Address receiving_owner_address;
+  char output[2000];
+
+  ASSERT_FALSE(object_buffer_pool_.GetReceivingObject(
+      obj_id, &data_size, &metadata_size, &receiving_owner_address));
+  ASSERT_TRUE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, 2 * chunk_size_, 10, 1)
+          .ok());
+  ASSERT_TRUE(object_buffer_pool_.GetReceivingObject(
+      obj_id, &data_size, &metadata_size, &receiving_owner_address));
+  ASSERT_EQ(data_size, 2 * chunk_size_);
+  ASSERT_EQ(metadata_size, 10);
+  ASSERT_EQ(receiving_owner_address.port(), 1234);
+
+  // Chunks can't be read before they are written.
+  ASSERT_FALSE(object_buffer_pool_.IsChunkReceived(obj_id, 1));
+  ASSERT_FALSE(object_buffer_pool_.ReadReceivedData(obj_id, chunk_size_, 10, output));
+  std::string chunk(chunk_size_, 'b');
+  object_buffer_pool_.WriteChunk(obj_id, 2 * chunk_size_, 10, 1, chunk);
+  ASSERT_TRUE(object_buffer_pool_.IsChunkReceived(obj_id, 1));
+  ASSERT_FALSE(object_buffer_pool_.IsChunkReceived(obj_id, 0));
+  ASSERT_TRUE(object_buffer_pool_.ReadReceivedData(
+      obj_id, chunk_size_ + 10, chunk_size_ - 10, output));
+  ASSERT_EQ(std::string(output, chunk_size_ - 10), chunk.substr(10));
+  // The range spans a chunk that hasn't been written.
+  ASSERT_FALSE(
+      object_buffer_pool_.ReadReceivedData(obj_id, chunk_size_ - 10, 20, output));
+  // The range is out of the object.
+  ASSERT_FALSE(
+      object_buffer_pool_.ReadReceivedData(obj_id, 2 * chunk_size_ - 10, 20, output));
+
+  // Once all chunks are written, the object is sealed and not being received.
+  ASSERT_TRUE(
+      object_buffer_pool_.CreateChunk(obj_id, owner_address, 2 * chunk_size_, 10, 0)
+          .ok());
+  EXPECT_CALL(*mock_plasma_client_, Seal(obj_id));
+  EXPECT_CALL(*mock_plasma_client_, Release(obj_id));
+  object_buffer_pool_.WriteChunk(obj_id, 2 * chunk_size_, 10, 0, mock_data_);
+  ASSERT_FALSE(object_buffer_pool_.IsChunkReceived(obj_id, 1));
+  ASSERT_FALSE(object_buffer_pool_.ReadReceivedData(obj_id, chunk_size_, 10, output));
+  AssertNoLeaks();
+}
+
 TEST_F(ObjectBufferPoolTest, TestAbort) {
   auto obj_id = ObjectID::FromRandom();
   rpc::Address owner_address;
@@ -289,6 +289,152 @@ TEST(TestPushManager, TestPushMultipleObject) {
   ASSERT_EQ(result[obj_id_3].size(), 2);
 }
 
+TEST(TestPushManager, TestAdaptiveSingleTransfer) {
+  std::vector<int> results;
+  results.resize(10);
+  auto node_id = NodeID::FromRandom();
+  auto obj_id = ObjectID::FromRandom();
+  PushManager pm(5, /*adaptive_scheduling=*/true, []() { return 0.0; });
+  pm.StartPush(node_id, obj_id, 10, [&](int64_t chunk_id) { results[chunk_id] = 1; });
+  // The destination starts with a window of 4 chunks.
+  ASSERT_EQ(pm.NumChunksInFlight(), 4);
+  ASSERT_EQ(pm.NumChunksRemaining(), 10);
+  ASSERT_EQ(pm.NumPushesInFlight(), 1);
+  ASSERT_EQ(pm.NumPushRequestsWithChunksToSend(), 1);
+  pm.OnChunkComplete(node_id, obj_id);
+  // Slow start: the window is now above the global limit.
+  ASSERT_EQ(pm.DestinationWindow(node_id), 5);
+  ASSERT_EQ(pm.NumChunksInFlight(), 5);
+  for (int i = 0; i < 9; i++) {
+    pm.OnChunkComplete(node_id, obj_id);
+  }
+  ASSERT_EQ(pm.NumChunksInFlight(), 0);
+  ASSERT_EQ(pm.NumChunksRemaining(), 0);
+  ASSERT_EQ(pm.NumPushesInFlight(), 0);
+  ASSERT_EQ(pm.NumPushRequestsWithChunksToSend(), 0);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(results[i], 1);
+  }
+}
+
+TEST(TestPushManager, TestAdaptiveWindow) {
+  double now = 0;
+  auto node_id = NodeID::FromRandom();
+  auto obj_id = ObjectID::FromRandom();
+  int num_active = 0;
+  PushManager pm(100, /*adaptive_scheduling=*/true, [&]() { return now; });
+  pm.StartPush(node_id, obj_id, 1000, [&](int64_t chunk_id) { num_active++; });
+  ASSERT_EQ(num_active, 4);
+
+  auto complete_all = [&]() {
+    int num_to_complete = num_active;
+    num_active = 0;
+    for (int i = 0; i < num_to_complete; i++) {
+      pm.OnChunkComplete(node_id, obj_id);
+    }
+  };
+
+  // Slow start: the window doubles every round trip while the RTT stays flat.
+  now += 1;
+  complete_all();
+  ASSERT_EQ(pm.DestinationWindow(node_id), 8);
+  ASSERT_EQ(num_active, 8);
+  now += 1;
+  complete_all();
+  ASSERT_EQ(pm.DestinationWindow(node_id), 16);
+  ASSERT_EQ(num_active, 16);
+  // At most 16 chunks were delivered per second.
+  ASSERT_GT(pm.DestinationThroughput(node_id), 0);
+  ASSERT_LE(pm.DestinationThroughput(node_id), 16);
+
+  // The RTT inflates: the window is halved once for the round trip.
+  now += 3;
+  complete_all();
+  ASSERT_EQ(pm.DestinationWindow(node_id), 8);
+  ASSERT_EQ(num_active, 8);
+
+  // Congestion avoidance: the window grows by about one chunk per round trip.
+  now += 1;
+  complete_all();
+  ASSERT_GT(pm.DestinationWindow(node_id), 8.9);
+  ASSERT_LT(pm.DestinationWindow(node_id), 9);
+  ASSERT_EQ(num_active, 8);
+  now += 1;
+  complete_all();
+  ASSERT_GT(pm.DestinationWindow(node_id), 9.8);
+  ASSERT_LT(pm.DestinationWindow(node_id), 10);
+  ASSERT_EQ(num_active, 9);
+
+  // A failed chunk halves the window too. The chunks that complete late in the
+  // same round trip don't decrease it further.
+  now += 10;
+  num_active--;
+  pm.OnChunkComplete(node_id, obj_id, Status::IOError("failed"));
+  ASSERT_GT(pm.DestinationWindow(node_id), 4.9);
+  ASSERT_LT(pm.DestinationWindow(node_id), 5);
+  complete_all();
+  ASSERT_EQ(pm.NumChunksInFlight(), 4);
+}
+
+TEST(TestPushManager, TestAdaptiveFairAcrossDestinations) {
+  // One destination with many objects to push, like a broadcast source, and one
+  // destination with a single object.
+  auto node1 = NodeID::FromRandom();
+  auto node2 = NodeID::FromRandom();
+  std::vector<ObjectID> objects;
+  for (int i = 0; i < 10; i++) {
+    objects.push_back(ObjectID::FromRandom());
+  }
+  std::vector<std::pair<NodeID, ObjectID>> in_flight;
+  PushManager pm(4, /*adaptive_scheduling=*/true, []() { return 0.0; });
+  for (const auto &obj_id : objects) {
+    pm.StartPush(node1, obj_id, 10, [&, obj_id](int64_t chunk_id) {
+      in_flight.emplace_back(node1, obj_id);
+    });
+  }
+  ASSERT_EQ(pm.NumChunksInFlight(), 4);
+  pm.StartPush(node2, objects[0], 10, [&](int64_t chunk_id) {
+    in_flight.emplace_back(node2, objects[0]);
+  });
+
+  // Without fair queuing, node2 would get one chunk in 11 as its push is one of
+  // 11. With it, it gets every other chunk.
+  int node2_chunks = 0;
+  for (int i = 0; i < 20; i++) {
+    auto chunk = in_flight.front();
+    in_flight.erase(in_flight.begin());
+    pm.OnChunkComplete(chunk.first, chunk.second);
+    if (in_flight.back().first == node2) {
+      node2_chunks++;
+    }
+  }
+  ASSERT_EQ(node2_chunks, 10);
+  while (!in_flight.empty()) {
+    auto chunk = in_flight.front();
+    in_flight.erase(in_flight.begin());
+    pm.OnChunkComplete(chunk.first, chunk.second);
+  }
+  ASSERT_EQ(pm.NumChunksInFlight(), 0);
+  ASSERT_EQ(pm.NumChunksRemaining(), 0);
+  ASSERT_EQ(pm.NumPushesInFlight(), 0);
+}
+
+TEST(TestPushManager, TestAdaptiveForgetIdleDestinations) {
+  double now = 0;
+  auto node1 = NodeID::FromRandom();
+  auto node2 = NodeID::FromRandom();
+  auto obj_id = ObjectID::FromRandom();
+  PushManager pm(5, /*adaptive_scheduling=*/true, [&]() { return now; });
+  pm.StartPush(node1, obj_id, 1, [](int64_t chunk_id) {});
+  pm.OnChunkComplete(node1, obj_id);
+  // The estimates are kept for the next pushes to the destination.
+  ASSERT_EQ(pm.DestinationWindow(node1), 5);
+  now += 1000;
+  pm.StartPush(node2, obj_id, 1, [](int64_t chunk_id) {});
+  ASSERT_EQ(pm.DestinationWindow(node1), 0);
+  ASSERT_EQ(pm.DestinationWindow(node2), 4);
+}
+
 }  // namespace ray
 
 int main(int argc, char **argv) {
@@ -20,6 +20,7 @@
 #include "ray/common/test_util.h"
 #include "ray/object_manager/chunk_object_reader.h"
 #include "ray/object_manager/memory_object_reader.h"
+#include "ray/object_manager/spilled_object_file_cache.h"
 #include "ray/object_manager/spilled_object_reader.h"
 #include "ray/util/filesystem.h"
 
@@ -411,6 +412,76 @@ TYPED_TEST(ObjectReaderTest, GetChunk) {
   }
 }
 
+TEST(SpilledObjectFileCacheTest, ReadAndEvict) {
+  std::string contents = "0123456789";
+  std::vector<std::string> paths;
+  for (int i = 0; i < 3; i++) {
+    paths.push_back(ray::JoinPaths(
+        ray::GetUserTempDir(), "spilled_file_cache_test" + ObjectID::FromRandom().Hex()));
+    std::ofstream f(paths.back(), std::ios::binary);
+    RAY_CHECK(f.write(contents.c_str(), contents.size()));
+  }
+
+  SpilledObjectFileCache cache(/*max_open_files=*/2);
+  std::string result(4, '\0');
+  ASSERT_TRUE(cache.Read(paths[0], 2, 4, &result[0]));
+  ASSERT_EQ("2345", result);
+  ASSERT_EQ(0, cache.NumHits());
+  ASSERT_EQ(1, cache.NumMisses());
+
+  ASSERT_TRUE(cache.Read(paths[0], 6, 4, &result[0]));
+  ASSERT_EQ("6789", result);
+  ASSERT_EQ(1, cache.NumHits());
+  ASSERT_EQ(8, cache.NumBytesRead());
+
+  // Reading past the end of the file fails.
+  ASSERT_FALSE(cache.Read(paths[0], 8, 4, &result[0]));
+  // Missing files are not cached.
+  ASSERT_FALSE(cache.Read(paths[0] + "_missing", 0, 4, &result[0]));
+  ASSERT_EQ(1, cache.NumOpenFiles());
+
+  // paths[1] is now the least recently used file, so it's evicted for paths[2].
+  ASSERT_TRUE(cache.Read(paths[1], 0, 4, &result[0]));
+  ASSERT_TRUE(cache.Read(paths[0], 0, 4, &result[0]));
+  ASSERT_TRUE(cache.Read(paths[2], 0, 4, &result[0]));
+  ASSERT_EQ(2, cache.NumOpenFiles());
+  auto num_misses = cache.NumMisses();
+  ASSERT_TRUE(cache.Read(paths[0], 0, 4, &result[0]));
+  ASSERT_EQ(num_misses, cache.NumMisses());
+  ASSERT_TRUE(cache.Read(paths[1], 0, 4, &result[0]));
+  ASSERT_EQ(num_misses + 1, cache.NumMisses());
+
+  cache.Evict(paths[1]);
+  ASSERT_EQ(1, cache.NumOpenFiles());
+}
+
+TEST(SpilledObjectFileCacheTest, GetChunkThroughCache) {
+  std::string data = "alotofdata";
+  std::string metadata = "metadata";
+  rpc::Address owner_address;
+  owner_address.set_raylet_id("nonsense");
+  auto file_cache = std::make_shared<SpilledObjectFileCache>(/*max_open_files=*/1);
+  auto object_url = CreateSpilledObjectReaderOnTmp(
+      10 /* object_offset */, data, metadata, owner_address);
+  auto optional_object =
+      SpilledObjectReader::CreateSpilledObjectReader(object_url, file_cache);
+  ASSERT_TRUE(optional_object.has_value());
+
+  auto reader = ChunkObjectReader(
+      std::make_shared<SpilledObjectReader>(std::move(optional_object.value())),
+      3 /* chunk_size */);
+  std::string actual_output_by_chunks;
+  for (uint64_t i = 0; i < reader.GetNumChunks(); i++) {
+    auto chunk = reader.GetChunk(i);
+    ASSERT_TRUE(chunk.has_value());
+    actual_output_by_chunks.append(chunk.value());
+  }
+  ASSERT_EQ(data + metadata, actual_output_by_chunks);
+  // The file is only opened once for all the chunks.
+  ASSERT_EQ(1, file_cache->NumMisses());
+  ASSERT_EQ(data.size() + metadata.size(), file_cache->NumBytesRead());
+}
+
 TEST(StringAllocationTest, TestNoCopyWhenStringMoved) {
   // Since protobuf always allocate string on heap,
   // move assign a string field doesn't copy the data.
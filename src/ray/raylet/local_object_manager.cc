@@ -540,6 +540,9 @@ void LocalObjectManager::ProcessSpilledObjectsDeleteQueue(uint32_t max_batch_siz
         RAY_LOG(DEBUG) << "The URL " << object_url
                        << " is deleted because the references are out of scope.";
         object_urls_to_delete.emplace_back(object_url);
+        if (on_spilled_file_deleted_) {
+          on_spilled_file_deleted_(base_url_it->second);
+        }
       }
       spilled_objects_url_.erase(spilled_objects_url_it);
 
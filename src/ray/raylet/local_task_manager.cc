@@ -144,6 +144,7 @@ void LocalTaskManager::DispatchScheduledTasksToWorkers() {
     /// pressure to limit the number of worker processes started in scenarios
     /// with nested tasks.
     bool is_infeasible = false;
+    SpillbackPlan spillback_plan;
     for (auto work_it = dispatch_queue.begin(); work_it != dispatch_queue.end();) {
       auto &work = *work_it;
       const auto &task = work->task;
@@ -179,7 +180,8 @@ void LocalTaskManager::DispatchScheduledTasksToWorkers() {
 
           // While we're over capacity and cannot run the task,
           // try to spill to a node that can run it.
-          bool did_spill = TrySpillback(work, is_infeasible);
+          bool did_spill = TrySpillback(
+              work, dispatch_queue.end() - work_it, spillback_plan, is_infeasible);
           if (did_spill) {
             work_it = dispatch_queue.erase(work_it);
             continue;
@@ -251,7 +253,8 @@ void LocalTaskManager::DispatchScheduledTasksToWorkers() {
         ReleaseTaskArgs(task_id);
         // The local node currently does not have the resources to run the task, so we
         // should try spilling to another node.
-        bool did_spill = TrySpillback(work, is_infeasible);
+        bool did_spill = TrySpillback(
+            work, dispatch_queue.end() - work_it, spillback_plan, is_infeasible);
         if (!did_spill) {
           // There must not be any other available nodes in the cluster, so the task
           // should stay on this node. We can skip the rest of the shape because the
@@ -268,6 +271,8 @@ void LocalTaskManager::DispatchScheduledTasksToWorkers() {
         // passed.
         sched_cls_info.next_update_time = std::numeric_limits<int64_t>::max();
         sched_cls_info.running_tasks.insert(spec.TaskId());
+        // The spillback plan was made with the resources the task just took.
+        spillback_plan.nodes.clear();
         // The local node has the available resources to run the task, so we should run
         // it.
         std::string allocated_instances_serialized_json = "{}";
@@ -394,16 +399,32 @@ void LocalTaskManager::SpillWaitingTasks() {
 }
 
 bool LocalTaskManager::TrySpillback(const std::shared_ptr<internal::Work> &work,
+                                    size_t num_works,
+                                    SpillbackPlan &plan,
                                     bool &is_infeasible) {
-  auto scheduling_node_id = cluster_resource_scheduler_->GetBestSchedulableNode(
-      work->task.GetTaskSpecification(),
-      // We should prefer to stay local if possible
-      // to avoid unnecessary spillback
-      // since this node is already selected by the cluster scheduler.
-      /*preferred_node_id*/ self_node_id_.Binary(),
-      /*exclude_local_node*/ false,
-      /*requires_object_store_memory*/ false,
-      &is_infeasible);
+  // All works of the class share the resource shape, so pick the nodes for the rest of
+  // the queue in one pass over the cluster view rather than once per work.
+  if (plan.nodes.empty()) {
+    const auto &spec = work->task.GetTaskSpecification();
+    auto nodes = cluster_resource_scheduler_->GetBestSchedulableNodes(
+        spec,
+        // We should prefer to stay local if possible
+        // to avoid unnecessary spillback
+        // since this node is already selected by the cluster scheduler.
+        /*preferred_node_id*/ self_node_id_.Binary(),
+        /*exclude_local_node*/ false,
+        /*requires_object_store_memory*/ false,
+        cluster_resource_scheduler_->CanScheduleInBatch(spec) ? num_works : 1,
+        &is_infeasible);
+    plan.nodes.assign(nodes.begin(), nodes.end());
+  }
+
+  auto scheduling_node_id = scheduling::NodeID::Nil();
+  if (!plan.nodes.empty()) {
+    scheduling_node_id = plan.nodes.front();
+    plan.nodes.pop_front();
+    is_infeasible = false;
+  }
 
   if (is_infeasible || scheduling_node_id.IsNil() ||
       scheduling_node_id.Binary() == self_node_id_.Binary()) {
@@ -600,6 +621,73 @@ void LocalTaskManager::Spillback(const NodeID &spillback_to,
   send_reply_callback();
 }
 
+std::vector<TaskSpecification> LocalTaskManager::StealTasks(const NodeID &node_id,
+                                                            NodeResourceSet available,
+                                                            size_t max_tasks) {
+  std::vector<TaskSpecification> stolen_tasks;
+  if (node_id == self_node_id_ || get_node_info_(node_id) == nullptr) {
+    return stolen_tasks;
+  }
+  for (auto shapes_it = tasks_to_dispatch_.begin();
+       shapes_it != tasks_to_dispatch_.end() && stolen_tasks.size() < max_tasks;) {
+    auto &dispatch_queue = shapes_it->second;
+    // Keep the head of the queue, which this node dispatches first.
+    const size_t num_to_keep = (dispatch_queue.size() + 1) / 2;
+    for (size_t i = dispatch_queue.size();
+         i > num_to_keep && stolen_tasks.size() < max_tasks;
+         i--) {
+      auto work = dispatch_queue[i - 1];
+      const auto &spec = work->task.GetTaskSpecification();
+      if (!(available >= spec.GetRequiredResources())) {
+        // The works of a scheduling class all have the same resource shape.
+        break;
+      }
+      if (!IsStealable(*work)) {
+        continue;
+      }
+      RAY_LOG(DEBUG) << "Handing over task " << spec.TaskId() << " to idle node "
+                     << node_id;
+      available -= spec.GetRequiredResources();
+      Spillback(node_id, work);
+      if (!spec.GetDependencies().empty()) {
+        task_dependency_manager_.RemoveTaskDependencies(spec.TaskId());
+      }
+      stolen_tasks.push_back(spec);
+      dispatch_queue.erase(dispatch_queue.begin() + (i - 1));
+      num_task_stolen_++;
+    }
+    if (dispatch_queue.empty()) {
+      tasks_to_dispatch_.erase(shapes_it++);
+    } else {
+      shapes_it++;
+    }
+  }
+  return stolen_tasks;
+}
+
+bool LocalTaskManager::IsStealable(const internal::Work &work) const {
+  if (work.GetState() != internal::WorkStatus::WAITING || work.PrioritizeLocalNode()) {
+    return false;
+  }
+  const auto &spec = work.task.GetTaskSpecification();
+  switch (spec.GetSchedulingStrategy().scheduling_strategy_case()) {
+  case rpc::SchedulingStrategy::SCHEDULING_STRATEGY_NOT_SET:
+  case rpc::SchedulingStrategy::kDefaultSchedulingStrategy:
+  case rpc::SchedulingStrategy::kSpreadSchedulingStrategy:
+    break;
+  default:
+    return false;
+  }
+  // Size the arguments from the object manager's metadata. Reading them through
+  // `get_task_arguments_` would pin them on every steal request.
+  int64_t task_arg_bytes = 0;
+  if (!cluster_resource_scheduler_->GetArgumentBytes(spec, &task_arg_bytes)) {
+    return false;
+  }
+  return static_cast<uint64_t>(task_arg_bytes) <=
+         RayConfig::instance().work_stealing_max_args_bytes();
+}
+
 void LocalTaskManager::TasksUnblocked(const std::vector<TaskID> &ready_ids) {
   if (ready_ids.empty()) {
     return;
@@ -1109,6 +1197,7 @@ void LocalTaskManager::DebugStr(std::stringstream &buffer) const {
   buffer << "Number of spilled waiting tasks: " << num_waiting_task_spilled_ << "\n";
   buffer << "Number of spilled unschedulable tasks: " << num_unschedulable_task_spilled_
          << "\n";
+  buffer << "Number of stolen tasks: " << num_task_stolen_ << "\n";
   buffer << "Resource usage {\n";
 
   // Calculates how much resources are occupied by tasks or actors.
@@ -123,6 +123,22 @@ class LocalTaskManager : public ILocalTaskManager {
                       rpc::RequestWorkerLeaseReply::SCHEDULING_CANCELLED_INTENDED,
                   const std::string &scheduling_failure_message = "") override;
 
+  /// Hand over queued tasks to an idle node by spilling them back to it.
+  ///
+  /// Only tasks waiting for local resources are handed over, never more than half of
+  /// a scheduling class's queue, starting from its end. Tasks whose owner asked for
+  /// this node in particular (spillback, locality, placement group or node affinity)
+  /// are kept, as are tasks whose arguments would be expensive to pull again.
+  ///
+  /// \param node_id: The idle node.
+  /// \param available: The resources available on the idle node. The tasks handed
+  /// over must fit in them all together.
+  /// \param max_tasks: The maximum number of tasks to hand over.
+  /// \return The tasks handed over.
+  std::vector<TaskSpecification> StealTasks(const NodeID &node_id,
+                                            NodeResourceSet available,
+                                            size_t max_tasks);
+
   /// Return if any tasks are pending resource acquisition.
   ///
   /// \param[out] example: An example task that is deadlocking.
@@ -212,13 +228,30 @@ class LocalTaskManager : public ILocalTaskManager {
   /// different node.
   void DispatchScheduledTasksToWorkers();
 
+  /// The nodes picked in one batch for the works of a scheduling class that cannot run
+  /// locally, consumed in queue order by TrySpillback during one dispatch pass. It is
+  /// cleared whenever a work is dispatched locally, since that changes the resources of
+  /// the local node.
+  struct SpillbackPlan {
+    /// The nodes for the next works to spill, front first.
+    std::deque<scheduling::NodeID> nodes;
+  };
+
   /// Helper method when the current node does not have the available resources to run a
   /// task.
   ///
+  /// \param work The work to spill.
+  /// \param num_works The number of works of the scheduling class that are left to
+  /// dispatch, starting from `work`. When the plan is empty, nodes are picked for all
+  /// of them at once if the scheduler supports it.
+  /// \param plan The spillback plan of the scheduling class for this pass.
   /// \returns true if the task was spilled. The task may not be spilled if the
   /// spillback policy specifies the local node (which may happen if no other nodes have
   /// the requested resources available).
-  bool TrySpillback(const std::shared_ptr<internal::Work> &work, bool &is_infeasible);
+  bool TrySpillback(const std::shared_ptr<internal::Work> &work,
+                    size_t num_works,
+                    SpillbackPlan &plan,
+                    bool &is_infeasible);
 
   // Try to spill waiting tasks to a remote node, starting from the end of the
   // queue.
@@ -254,6 +287,10 @@ class LocalTaskManager : public ILocalTaskManager {
 
   void Spillback(const NodeID &spillback_to, const std::shared_ptr<internal::Work> &work);
 
+  /// Return whether a work queued for dispatch can be handed over to another node by
+  /// StealTasks.
+  bool IsStealable(const internal::Work &work) const;
+
   /// Sum up the backlog size across all workers for a given scheduling class.
   int64_t TotalBacklogSize(SchedulingClass scheduling_class);
 
@@ -382,11 +419,13 @@ class LocalTaskManager : public ILocalTaskManager {
   size_t num_task_spilled_ = 0;
   size_t num_waiting_task_spilled_ = 0;
   size_t num_unschedulable_task_spilled_ = 0;
+  size_t num_task_stolen_ = 0;
 
   friend class SchedulerResourceReporter;
   friend class ClusterTaskManagerTest;
   friend class SchedulerStats;
   FRIEND_TEST(ClusterTaskManagerTest, FeasibleToNonFeasible);
+  FRIEND_TEST(ClusterTaskManagerTest, StealTasksTest);
 };
 }  // namespace raylet
 }  // namespace ray
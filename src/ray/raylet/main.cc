@@ -350,6 +350,12 @@ int main(int argc, char *argv[]) {
         }
         object_manager_config.object_chunk_size =
             RayConfig::instance().object_manager_default_chunk_size();
+        object_manager_config.max_cached_spilled_files =
+            RayConfig::instance().object_manager_max_cached_spilled_files();
+        object_manager_config.push_adaptive_scheduling =
+            RayConfig::instance().object_manager_push_adaptive_scheduling();
+        object_manager_config.broadcast_max_fanout =
+            RayConfig::instance().object_manager_broadcast_max_fanout();
 
         RAY_LOG(DEBUG) << "Starting object manager with configuration: \n"
                        << "rpc_service_threads_number = "
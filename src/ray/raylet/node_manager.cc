@@ -81,6 +81,18 @@ std::vector<ray::rpc::ObjectReference> FlatbufferToObjectReference(
   return refs;
 }
 
+/// Return the ray syncer aggregation group of a node given its labels, or an empty
+/// string if it isn't in any.
+template <typename Labels>
+std::string GetSyncerAggregationGroup(const Labels &labels) {
+  const auto &label = RayConfig::instance().ray_syncer_aggregation_label();
+  if (label.empty()) {
+    return "";
+  }
+  auto iter = labels.find(label);
+  return iter == labels.end() ? "" : iter->second;
+}
+
 }  // namespace
 
 namespace ray {
@@ -142,6 +154,7 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
           /*get_time=*/[]() { return absl::GetCurrentTimeNanos() / 1e6; }),
       client_call_manager_(io_service),
       worker_rpc_pool_(client_call_manager_),
+      raylet_client_pool_(client_call_manager_),
       core_worker_subscriber_(std::make_unique<pubsub::Subscriber>(
           self_node_id_,
           /*channels=*/
@@ -261,7 +274,11 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
             return object_manager_.IsPlasmaObjectSpillable(object_id);
           },
           /*core_worker_subscriber_=*/core_worker_subscriber_.get(),
-          object_directory_.get()),
+          object_directory_.get(),
+          /*on_spilled_file_deleted*/
+          [this](const std::string &file_path) {
+            object_manager_.EvictSpilledObjectFile(file_path);
+          }),
       high_plasma_storage_usage_(RayConfig::instance().high_plasma_storage_usage()),
       local_gc_run_time_ns_(absl::GetCurrentTimeNanos()),
       local_gc_throttler_(RayConfig::instance().local_gc_min_interval_s() * 1e9),
@@ -271,6 +288,7 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
       next_resource_seq_no_(0),
       ray_syncer_(io_service_, self_node_id_.Binary()),
       ray_syncer_service_(ray_syncer_),
+      ray_syncer_group_(self_node_id_, GetSyncerAggregationGroup(config.labels)),
       worker_killing_policy_(
           CreateWorkerKillingPolicy(RayConfig::instance().worker_killing_policy())),
       memory_monitor_(std::make_unique<MemoryMonitor>(
@@ -307,7 +325,13 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
       /*get_pull_manager_at_capacity*/
       [this]() { return object_manager_.PullManagerHasPullsQueued(); },
       /*labels*/
-      config.labels);
+      config.labels,
+      /*get_object_locations*/
+      [this](const ObjectID &object_id,
+             std::vector<NodeID> *node_ids,
+             int64_t *object_size) {
+        return object_manager_.GetObjectLocations(object_id, node_ids, object_size);
+      });
 
   auto get_node_info_func = [this](const NodeID &node_id) {
     return gcs_client_->Nodes().Get(node_id);
@@ -356,6 +380,11 @@ NodeManager::NodeManager(instrumented_io_context &io_service,
       [this]() { cluster_task_manager_->ScheduleAndDispatchTasks(); },
       RayConfig::instance().worker_cap_initial_backoff_delay_ms(),
       "NodeManager.ScheduleAndDispatchTasks");
+  if (RayConfig::instance().work_stealing_period_ms() > 0) {
+    periodical_runner_.RunFnPeriodically([this]() { StealTasks(); },
+                                         RayConfig::instance().work_stealing_period_ms(),
+                                         "NodeManager.StealTasks");
+  }
 
   RAY_CHECK_OK(store_client_.Connect(config.store_socket_name.c_str()));
   // Run the node manger rpc server.
@@ -422,8 +451,7 @@ ray::Status NodeManager::RegisterGcs() {
         /* receiver */ this,
         /* pull_from_reporter_interval_ms */ 0);
 
-    auto gcs_channel = gcs_client_->GetGcsRpcClient().GetChannel();
-    ray_syncer_.Connect(kGCSNodeID.Binary(), gcs_channel);
+    ConnectRaySyncerUpstream();
     periodical_runner_.RunFnPeriodically(
         [this] {
           auto triggered_by_global_gc = TryLocalGC();
@@ -922,6 +950,11 @@ void NodeManager::NodeAdded(const GcsNodeInfo &node_info) {
   cluster_resource_scheduler_->GetClusterResourceManager().SetNodeLabels(
       scheduling::NodeID(node_id.Binary()), labels);
 
+  ray_syncer_group_.AddNode(node_id, GetSyncerAggregationGroup(node_info.labels()));
+  if (!ray_syncer_upstream_.IsNil()) {
+    ConnectRaySyncerUpstream();
+  }
+
   // TODO: Always use the message from ray syncer.
   ResourceRequest resources;
   for (auto &resource_entry : node_info.resources_total()) {
@@ -981,6 +1014,12 @@ void NodeManager::NodeRemoved(const NodeID &node_id) {
   if (node_entry != remote_node_manager_addresses_.end()) {
     remote_node_manager_addresses_.erase(node_entry);
   }
+  raylet_client_pool_.Disconnect(node_id);
+
+  ray_syncer_group_.RemoveNode(node_id);
+  if (!ray_syncer_upstream_.IsNil()) {
+    ConnectRaySyncerUpstream();
+  }
 
   // Notify the object directory that the node has been removed so that it
   // can remove it from any cached locations.
@@ -993,6 +1032,33 @@ void NodeManager::NodeRemoved(const NodeID &node_id) {
   HandleUnexpectedWorkerFailure(data);
 }
 
+void NodeManager::ConnectRaySyncerUpstream() {
+  auto upstream = ray_syncer_group_.GetUpstream();
+  if (upstream.IsNil()) {
+    upstream = kGCSNodeID;
+  }
+  if (upstream == ray_syncer_upstream_) {
+    return;
+  }
+  if (!ray_syncer_upstream_.IsNil()) {
+    ray_syncer_.Disconnect(ray_syncer_upstream_.Binary());
+  }
+  RAY_LOG(INFO) << "Connecting ray syncer to "
+                << (upstream == kGCSNodeID ? "GCS" : upstream.Hex())
+                << ". Aggregation group size: " << ray_syncer_group_.Size();
+  ray_syncer_upstream_ = upstream;
+  if (upstream == kGCSNodeID) {
+    ray_syncer_.Connect(kGCSNodeID.Binary(),
+                        gcs_client_->GetGcsRpcClient().GetChannel());
+    return;
+  }
+  const auto node_entry = remote_node_manager_addresses_.find(upstream);
+  RAY_CHECK(node_entry != remote_node_manager_addresses_.end());
+  ray_syncer_.Connect(
+      upstream.Binary(),
+      rpc::BuildChannel(node_entry->second.first, node_entry->second.second));
+}
+
 void NodeManager::HandleUnexpectedWorkerFailure(const rpc::WorkerDeltaData &data) {
   const WorkerID worker_id = WorkerID::FromBinary(data.worker_id());
   const NodeID node_id = NodeID::FromBinary(data.raylet_id());
@@ -1112,6 +1178,139 @@ void NodeManager::HandleNotifyGCSRestart(rpc::NotifyGCSRestartRequest request,
   send_reply_callback(Status::OK(), nullptr, nullptr);
 }
 
+void NodeManager::HandleStealTasks(rpc::StealTasksRequest request,
+                                   rpc::StealTasksReply *reply,
+                                   rpc::SendReplyCallback send_reply_callback) {
+  const auto node_id = NodeID::FromBinary(request.node_id());
+  NodeResourceSet available(absl::flat_hash_map<std::string, double>(
+      request.resources_available().begin(), request.resources_available().end()));
+  auto stolen_tasks =
+      local_task_manager_->StealTasks(node_id, std::move(available), request.max_tasks());
+  RAY_LOG(DEBUG) << "Handed over " << stolen_tasks.size() << " queued tasks to idle node "
+                 << node_id;
+  for (const auto &task_spec : stolen_tasks) {
+    auto *stolen_task = reply->add_stolen_tasks();
+    stolen_task->set_task_id(task_spec.TaskId().Binary());
+    for (const auto &[name, value] : task_spec.GetRequiredResources().GetResourceMap()) {
+      (*stolen_task->mutable_required_resources())[name] = value;
+    }
+  }
+  send_reply_callback(Status::OK(), nullptr, nullptr);
+}
+
+void NodeManager::StealTasks() {
+  // Give up on the stolen tasks whose owners never asked for a lease, e.g. because they
+  // died, so that their resources are free again.
+  const int64_t now_ms = current_time_ms();
+  std::vector<TaskID> expired_task_ids;
+  for (const auto &[task_id, reservation] : work_stealing_reservations_) {
+    if (reservation.expiration_ms <= now_ms) {
+      expired_task_ids.push_back(task_id);
+    }
+  }
+  for (const auto &task_id : expired_task_ids) {
+    RAY_LOG(DEBUG) << "The lease request of stolen task " << task_id
+                   << " didn't arrive in time.";
+    ReleaseWorkStealingReservation(task_id);
+  }
+  if (!expired_task_ids.empty()) {
+    cluster_task_manager_->ScheduleAndDispatchTasks();
+  }
+
+  if (work_stealing_in_flight_ || !local_task_manager_->GetTaskToDispatch().empty()) {
+    return;
+  }
+  auto &local_resource_manager = cluster_resource_scheduler_->GetLocalResourceManager();
+  if (local_resource_manager.IsLocalNodeDraining() ||
+      local_resource_manager.GetLocalAvailableCpus() <= 0) {
+    return;
+  }
+
+  // Steal from a random node that has no CPU left: it may have tasks queued.
+  std::vector<NodeID> victims;
+  for (const auto &[node_id, node] :
+       cluster_resource_scheduler_->GetClusterResourceManager().GetResourceView()) {
+    const auto &resources = node.GetLocalView();
+    if (node_id.Binary() != self_node_id_.Binary() && !resources.is_draining &&
+        resources.total.Get(scheduling::ResourceID::CPU()) > 0 &&
+        resources.available.Get(scheduling::ResourceID::CPU()) <= 0) {
+      victims.push_back(NodeID::FromBinary(node_id.Binary()));
+    }
+  }
+  if (victims.empty()) {
+    return;
+  }
+  const auto victim =
+      victims[absl::Uniform<size_t>(work_stealing_gen_, 0, victims.size())];
+  const auto node_entry = remote_node_manager_addresses_.find(victim);
+  if (node_entry == remote_node_manager_addresses_.end()) {
+    return;
+  }
+
+  rpc::StealTasksRequest request;
+  request.set_node_id(self_node_id_.Binary());
+  const auto &local_view =
+      cluster_resource_scheduler_->GetClusterResourceManager().GetNodeResources(
+          scheduling::NodeID(self_node_id_.Binary()));
+  for (const auto &[name, value] : local_view.available.GetResourceMap()) {
+    (*request.mutable_resources_available())[name] = value;
+  }
+  request.set_max_tasks(RayConfig::instance().work_stealing_max_tasks());
+  rpc::Address victim_address;
+  victim_address.set_raylet_id(victim.Binary());
+  victim_address.set_ip_address(node_entry->second.first);
+  victim_address.set_port(node_entry->second.second);
+  work_stealing_in_flight_ = true;
+  auto raylet_client = raylet_client_pool_.GetOrConnectByAddress(victim_address);
+  raylet_client->StealTasks(
+      request, [this, victim](const Status &status, const rpc::StealTasksReply &reply) {
+        work_stealing_in_flight_ = false;
+        const auto leases_requested = std::move(leases_requested_while_stealing_);
+        leases_requested_while_stealing_.clear();
+        if (!status.ok()) {
+          RAY_LOG(DEBUG) << "Failed to steal tasks from node " << victim << ": "
+                         << status.ToString();
+          return;
+        }
+        RAY_LOG(DEBUG) << "Stole " << reply.stolen_tasks_size() << " tasks from node "
+                       << victim;
+        // Hold the resources of the stolen tasks until their owners ask for leases
+        // here, so that other tasks don't take them in the meantime.
+        auto &local_resource_manager =
+            cluster_resource_scheduler_->GetLocalResourceManager();
+        const int64_t expiration_ms =
+            current_time_ms() +
+            RayConfig::instance().work_stealing_reservation_timeout_ms();
+        for (const auto &stolen_task : reply.stolen_tasks()) {
+          const auto task_id = TaskID::FromBinary(stolen_task.task_id());
+          auto allocation = std::make_shared<TaskResourceInstances>();
+          // The lease request of the task already arrived, so it's queued or
+          // granted here.
+          if (leases_requested.contains(task_id) ||
+              work_stealing_reservations_.contains(task_id) ||
+              !local_resource_manager.AllocateLocalTaskResources(
+                  absl::flat_hash_map<std::string, double>(
+                      stolen_task.required_resources().begin(),
+                      stolen_task.required_resources().end()),
+                  allocation)) {
+            continue;
+          }
+          work_stealing_reservations_.emplace(
+              task_id, WorkStealingReservation{allocation, expiration_ms});
+        }
+      });
+}
+
+void NodeManager::ReleaseWorkStealingReservation(const TaskID &task_id) {
+  auto it = work_stealing_reservations_.find(task_id);
+  if (it == work_stealing_reservations_.end()) {
+    return;
+  }
+  cluster_resource_scheduler_->GetLocalResourceManager().ReleaseWorkerResources(
+      it->second.allocation);
+  work_stealing_reservations_.erase(it);
+}
+
 bool NodeManager::UpdateResourceUsage(
     const NodeID &node_id,
     const syncer::ResourceViewSyncMessage &resource_view_sync_message) {
@@ -1699,6 +1898,12 @@ void NodeManager::HandleRequestWorkerLease(rpc::RequestWorkerLeaseRequest reques
   rpc::Task task_message;
   task_message.mutable_task_spec()->CopyFrom(request.resource_spec());
   RayTask task(task_message);
+  // The task may have been stolen by this node, in which case its resources were held
+  // for it until now.
+  ReleaseWorkStealingReservation(task.GetTaskSpecification().TaskId());
+  if (work_stealing_in_flight_) {
+    leases_requested_while_stealing_.insert(task.GetTaskSpecification().TaskId());
+  }
 
   const auto caller_worker =
       WorkerID::FromBinary(task.GetTaskSpecification().CallerAddress().worker_id());
@@ -15,9 +15,11 @@
 #pragma once
 
 // clang-format off
+#include "absl/random/random.h"
 #include "ray/rpc/grpc_client.h"
 #include "ray/rpc/node_manager/node_manager_server.h"
 #include "ray/rpc/node_manager/node_manager_client.h"
+#include "ray/rpc/node_manager/node_manager_client_pool.h"
 #include "ray/common/id.h"
 #include "ray/common/memory_monitor.h"
 #include "ray/common/task/task.h"
@@ -39,6 +41,7 @@
 #include "ray/raylet/scheduling/cluster_task_manager_interface.h"
 #include "ray/raylet/dependency_manager.h"
 #include "ray/raylet/local_task_manager.h"
+#include "ray/raylet/syncer_aggregation_group.h"
 #include "ray/raylet/wait_manager.h"
 #include "ray/raylet/worker_pool.h"
 #include "ray/rpc/worker/core_worker_client_pool.h"
@@ -266,6 +269,10 @@ class NodeManager : public rpc::NodeManagerServiceHandler,
   /// \return Void.
   void NodeRemoved(const NodeID &node_id);
 
+  /// Connect ray syncer to the upstream of this node in its aggregation group, or to
+  /// the GCS if it has none, and disconnect it from the previous upstream.
+  void ConnectRaySyncerUpstream();
+
   /// Handler for the addition or updation of a resource in the GCS
   /// \param node_id ID of the node that created or updated resources.
   /// \param createUpdatedResources Created or updated resources.
@@ -601,6 +608,19 @@ class NodeManager : public rpc::NodeManagerServiceHandler,
                               rpc::NotifyGCSRestartReply *reply,
                               rpc::SendReplyCallback send_reply_callback) override;
 
+  /// Handle a `StealTasks` request.
+  void HandleStealTasks(rpc::StealTasksRequest request,
+                        rpc::StealTasksReply *reply,
+                        rpc::SendReplyCallback send_reply_callback) override;
+
+  /// If this node is idle, ask a random saturated node to hand over some of its queued
+  /// tasks.
+  void StealTasks();
+
+  /// Release the resources held for a stolen task, if any, once its lease request
+  /// arrives or it is too late for it to arrive.
+  void ReleaseWorkStealingReservation(const TaskID &task_id);
+
   /// Trigger local GC on each worker of this raylet.
   void DoLocalGC(bool triggered_by_global_gc = false);
 
@@ -708,6 +728,8 @@ class NodeManager : public rpc::NodeManagerServiceHandler,
   rpc::ClientCallManager client_call_manager_;
   /// Pool of RPC client connections to core workers.
   rpc::CoreWorkerClientPool worker_rpc_pool_;
+  /// Pool of RPC client connections to other raylets.
+  rpc::NodeManagerClientPool raylet_client_pool_;
   /// The raylet client to initiate the pubsub to core workers (owners).
   /// It is used to subscribe objects to evict.
   std::unique_ptr<pubsub::SubscriberInterface> core_worker_subscriber_;
@@ -861,6 +883,34 @@ class NodeManager : public rpc::NodeManagerServiceHandler,
   /// RaySyncerService for gRPC
   syncer::RaySyncerService ray_syncer_service_;
 
+  /// Whether a `StealTasks` request is in flight.
+  bool work_stealing_in_flight_ = false;
+
+  /// Picks the node to steal tasks from.
+  absl::BitGen work_stealing_gen_;
+
+  /// The resources held for a task stolen from another node, so that they are still
+  /// free when the owner of the task asks this node for a lease.
+  struct WorkStealingReservation {
+    std::shared_ptr<TaskResourceInstances> allocation;
+    int64_t expiration_ms;
+  };
+
+  /// The reservations of the stolen tasks whose lease requests haven't arrived yet.
+  absl::flat_hash_map<TaskID, WorkStealingReservation> work_stealing_reservations_;
+
+  /// The tasks whose lease requests arrived while a `StealTasks` request was in
+  /// flight. The victim may spill a task back before its reply arrives, so its
+  /// resources must not be reserved when the reply lists it.
+  absl::flat_hash_set<TaskID> leases_requested_while_stealing_;
+
+  /// The nodes this node aggregates ray syncer traffic with.
+  SyncerAggregationGroup ray_syncer_group_;
+
+  /// The node ray syncer is connected to, kGCSNodeID for the GCS, or nil if it isn't
+  /// connected yet.
+  NodeID ray_syncer_upstream_ = NodeID::Nil();
+
   /// The Policy for selecting the worker to kill when the node runs out of memory.
   std::shared_ptr<WorkerKillingPolicy> worker_killing_policy_;
 
@@ -23,7 +23,8 @@
 namespace ray {
 
 ClusterResourceManager::ClusterResourceManager(instrumented_io_context &io_service)
-    : timer_(io_service) {
+    : node_score_index_(RayConfig::instance().scheduler_spread_threshold()),
+      timer_(io_service) {
   timer_.RunFnPeriodically(
       [this]() {
         auto syncer_delay = absl::Milliseconds(
@@ -67,6 +68,7 @@ void ClusterResourceManager::AddOrUpdateNode(scheduling::NodeID node_id,
     // This node exists, so update its resources.
     it->second = Node(node_resources);
   }
+  node_score_index_.AddOrUpdateNode(node_id, node_resources);
 }
 
 bool ClusterResourceManager::UpdateNode(
@@ -105,6 +107,7 @@ bool ClusterResourceManager::UpdateNode(
 
 bool ClusterResourceManager::RemoveNode(scheduling::NodeID node_id) {
   received_node_resources_.erase(node_id);
+  node_score_index_.RemoveNode(node_id);
   return nodes_.erase(node_id) != 0;
 }
 
@@ -151,6 +154,7 @@ void ClusterResourceManager::UpdateResourceCapacity(scheduling::NodeID node_id,
   }
   local_view->total.Set(resource_id, total);
   local_view->available.Set(resource_id, available);
+  node_score_index_.AddOrUpdateNode(node_id, *local_view);
 }
 
 bool ClusterResourceManager::DeleteResources(
@@ -165,6 +169,7 @@ bool ClusterResourceManager::DeleteResources(
     local_view->total.Set(resource_id, 0);
     local_view->available.Set(resource_id, 0);
   }
+  node_score_index_.AddOrUpdateNode(node_id, *local_view);
   return true;
 }
 
@@ -190,6 +195,7 @@ bool ClusterResourceManager::SubtractNodeAvailableResources(
 
   resources->available -= resource_request.GetResourceSet();
   resources->available.RemoveNegative();
+  node_score_index_.AddOrUpdateNode(node_id, *resources);
 
   // TODO(swang): We should also subtract object store memory if the task has
   // arguments. Right now we do not modify object_pulls_queued in case of
@@ -236,6 +242,7 @@ bool ClusterResourceManager::AddNodeAvailableResources(scheduling::NodeID node_i
       node_resources->available.Set(resource_id, new_available);
     }
   }
+  node_score_index_.AddOrUpdateNode(node_id, *node_resources);
   return true;
 }
 
@@ -254,6 +261,8 @@ bool ClusterResourceManager::UpdateNodeNormalTaskResources(
         local_normal_task_resources = normal_task_resources;
         node_resources->latest_resources_normal_task_timestamp =
             resource_data.resources_normal_task_timestamp();
+        // The normal task resources count towards the utilization of the node.
+        node_score_index_.AddOrUpdateNode(node_id, *node_resources);
         return true;
       }
     }
@@ -276,6 +285,10 @@ BundleLocationIndex &ClusterResourceManager::GetBundleLocationIndex() {
   return bundle_location_index_;
 }
 
+const NodeScoreIndex &ClusterResourceManager::GetNodeScoreIndex() const {
+  return node_score_index_;
+}
+
 void ClusterResourceManager::SetNodeLabels(
     const scheduling::NodeID &node_id,
     const absl::flat_hash_map<std::string, std::string> &labels) {
@@ -285,6 +298,7 @@ void ClusterResourceManager::SetNodeLabels(
     it = nodes_.emplace(node_id, node_resources).first;
   }
   it->second.GetMutableLocalView()->labels = labels;
+  node_score_index_.AddOrUpdateNode(node_id, it->second.GetLocalView());
 }
 
 }  // namespace ray
@@ -26,6 +26,7 @@
 #include "ray/common/scheduling/cluster_resource_data.h"
 #include "ray/common/scheduling/fixed_point.h"
 #include "ray/raylet/scheduling/local_resource_manager.h"
+#include "ray/raylet/scheduling/node_score_index.h"
 #include "ray/util/logging.h"
 #include "src/ray/protobuf/gcs.pb.h"
 
@@ -129,6 +130,10 @@ class ClusterResourceManager {
 
   BundleLocationIndex &GetBundleLocationIndex();
 
+  /// Get the index of the nodes by their hybrid scheduling score, computed with the
+  /// configured spread threshold.
+  const NodeScoreIndex &GetNodeScoreIndex() const;
+
   void SetNodeLabels(const scheduling::NodeID &node_id,
                      const absl::flat_hash_map<std::string, std::string> &labels);
 
@@ -167,6 +172,10 @@ class ClusterResourceManager {
 
   BundleLocationIndex bundle_location_index_;
 
+  /// The nodes ordered by their hybrid scheduling score. It must be updated whenever
+  /// the local view of a node in `nodes_` changes.
+  NodeScoreIndex node_score_index_;
+
   /// Timer to revert local changes to the resources periodically.
   ray::PeriodicalRunner timer_;
 
@@ -194,6 +203,8 @@ class ClusterResourceManager {
   FRIEND_TEST(ClusterTaskManagerTestWithGPUsAtHead, RleaseAndReturnWorkerCpuResources);
   FRIEND_TEST(ClusterResourceSchedulerTest, TestForceSpillback);
   FRIEND_TEST(ClusterResourceSchedulerTest, AffinityWithBundleScheduleTest);
+  FRIEND_TEST(ClusterResourceSchedulerTest, GetBestSchedulableNodesTest);
+  FRIEND_TEST(ClusterResourceSchedulerTest, DISABLED_GetBestSchedulableNodesPerf);
 
   friend class raylet::SchedulingPolicyTest;
   friend class raylet_scheduling_policy::HybridSchedulingPolicyTest;
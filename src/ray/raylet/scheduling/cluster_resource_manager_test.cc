@@ -152,4 +152,67 @@ TEST_F(ClusterResourceManagerTest, UpdateNodeNormalTaskResources) {
   ASSERT_TRUE(node_resources.normal_task_resources.Get(ResourceID::CPU()) == 0.8);
 }
 
+TEST_F(ClusterResourceManagerTest, NodeScoreIndex) {
+  auto ordered_node_ids = [this]() {
+    std::vector<scheduling::NodeID> node_ids;
+    for (const auto &[score, node_id] : manager->GetNodeScoreIndex().GetOrderedNodes()) {
+      node_ids.push_back(node_id);
+    }
+    return node_ids;
+  };
+  // Nodes without utilization are ordered by ID.
+  ASSERT_EQ(ordered_node_ids(), (std::vector<scheduling::NodeID>{node0, node1, node2}));
+
+  // node0 is fully utilized.
+  ASSERT_TRUE(manager->SubtractNodeAvailableResources(
+      node0, ResourceMapToResourceRequest({{"CPU", 1}}, false)));
+  ASSERT_EQ(ordered_node_ids(), (std::vector<scheduling::NodeID>{node1, node2, node0}));
+
+  ASSERT_TRUE(
+      manager->AddNodeAvailableResources(node0, ResourceSet({{"CPU", FixedPoint(1)}})));
+  manager->UpdateResourceCapacity(node3, ResourceID::CPU(), 4);
+  ASSERT_TRUE(manager->SubtractNodeAvailableResources(
+      node3, ResourceMapToResourceRequest({{"CPU", 1}}, false)));
+  ASSERT_EQ(ordered_node_ids(),
+            (std::vector<scheduling::NodeID>{node0, node1, node2, node3}));
+
+  // node2 is fully utilized, and node3 is still below the spread threshold.
+  ASSERT_TRUE(manager->SubtractNodeAvailableResources(
+      node2, ResourceMapToResourceRequest({{"CPU", 1}}, false)));
+  ASSERT_TRUE(manager->RemoveNode(node1));
+  ASSERT_EQ(ordered_node_ids(), (std::vector<scheduling::NodeID>{node0, node3, node2}));
+  ASSERT_EQ(manager->GetNodeScoreIndex().Size(), 3u);
+}
+
+TEST_F(ClusterResourceManagerTest, NodeUtilizationCache) {
+  const auto &index = manager->GetNodeScoreIndex();
+  auto check_cache = [this, &index]() {
+    ASSERT_EQ(index.GetNodeIds().size(), index.Size());
+    ASSERT_EQ(index.GetUtilizations().size(), index.Size());
+    for (size_t i = 0; i < index.Size(); i++) {
+      const auto &node_id = index.GetNodeIds()[i];
+      const auto &resources = manager->GetNodeResources(node_id);
+      ASSERT_EQ(index.GetUtilizations()[i],
+                resources.CalculateCriticalResourceUtilization());
+      ASSERT_EQ(index.GetUtilization(node_id), index.GetUtilizations()[i]);
+    }
+  };
+  check_cache();
+
+  manager->UpdateResourceCapacity(node3, ResourceID::CPU(), 4);
+  ASSERT_TRUE(manager->SubtractNodeAvailableResources(
+      node3, ResourceMapToResourceRequest({{"CPU", 1}}, false)));
+  ASSERT_EQ(index.GetUtilization(node3), 0.25);
+  check_cache();
+
+  // Removing a node keeps the cache contiguous.
+  ASSERT_TRUE(manager->RemoveNode(node0));
+  ASSERT_EQ(index.Size(), 3u);
+  check_cache();
+  ASSERT_TRUE(manager->SubtractNodeAvailableResources(
+      node3, ResourceMapToResourceRequest({{"CPU", 1}}, false)));
+  ASSERT_EQ(index.GetUtilization(node3), 0.5);
+  check_cache();
+}
+
 }  // namespace ray
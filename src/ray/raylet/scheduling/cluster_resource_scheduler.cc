@@ -45,8 +45,12 @@ ClusterResourceScheduler::ClusterResourceScheduler(
     std::function<bool(scheduling::NodeID)> is_node_available_fn,
     std::function<int64_t(void)> get_used_object_store_memory,
     std::function<bool(void)> get_pull_manager_at_capacity,
-    const absl::flat_hash_map<std::string, std::string> &local_node_labels)
-    : local_node_id_(local_node_id), is_node_available_fn_(is_node_available_fn) {
+    const absl::flat_hash_map<std::string, std::string> &local_node_labels,
+    std::function<bool(const ObjectID &, std::vector<NodeID> *, int64_t *)>
+        get_object_locations)
+    : local_node_id_(local_node_id),
+      is_node_available_fn_(is_node_available_fn),
+      get_object_locations_(std::move(get_object_locations)) {
   NodeResources node_resources = ResourceMapToNodeResources(
       local_node_resources, local_node_resources, local_node_labels);
   Init(io_service,
@@ -145,7 +149,8 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
     bool force_spillback,
     const std::string &preferred_node_id,
     int64_t *total_violations,
-    bool *is_infeasible) {
+    bool *is_infeasible,
+    std::shared_ptr<SchedulingContext> argument_locality) {
   // The zero cpu actor is a special case that must be handled the same way by all
   // scheduling policies, except for HARD node affnity scheduling policy.
   if (actor_creation && resource_request.IsEmpty() &&
@@ -197,7 +202,8 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
                                      SchedulingOptions::Hybrid(
                                          /*avoid_local_node*/ force_spillback,
                                          /*require_node_available*/ force_spillback,
-                                         preferred_node_id));
+                                         preferred_node_id,
+                                         std::move(argument_locality)));
   }
 
   *is_infeasible = best_node_id.IsNil();
@@ -279,12 +285,23 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
     bool exclude_local_node,
     bool requires_object_store_memory,
     bool *is_infeasible) {
+  ResourceRequest resource_request = ResourceMapToResourceRequest(
+      task_spec.GetRequiredPlacementResources().GetResourceMap(),
+      requires_object_store_memory);
+  return GetBestSchedulableNode(
+      resource_request, task_spec, preferred_node_id, exclude_local_node, is_infeasible);
+}
+
+scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
+    const ResourceRequest &resource_request,
+    const TaskSpecification &task_spec,
+    const std::string &preferred_node_id,
+    bool exclude_local_node,
+    bool *is_infeasible) {
   // If the local node is available, we should directly return it instead of
   // going through the full hybrid policy since we don't want spillback.
   if (preferred_node_id == local_node_id_.Binary() && !exclude_local_node &&
-      IsSchedulableOnNode(local_node_id_,
-                          task_spec.GetRequiredPlacementResources().GetResourceMap(),
-                          requires_object_store_memory)) {
+      IsSchedulable(resource_request, local_node_id_)) {
     *is_infeasible = false;
     return local_node_id_;
   }
@@ -292,20 +309,17 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
   // This argument is used to set violation, which is an unsupported feature now.
   int64_t _unused;
   scheduling::NodeID best_node =
-      GetBestSchedulableNode(task_spec.GetRequiredPlacementResources().GetResourceMap(),
+      GetBestSchedulableNode(resource_request,
                              task_spec.GetMessage().scheduling_strategy(),
-                             requires_object_store_memory,
                              task_spec.IsActorCreationTask(),
                              exclude_local_node,
                              preferred_node_id,
                              &_unused,
-                             is_infeasible);
+                             is_infeasible,
+                             GetArgumentLocality(task_spec));
 
   // There is no other available nodes.
-  if (!best_node.IsNil() &&
-      !IsSchedulableOnNode(best_node,
-                           task_spec.GetRequiredPlacementResources().GetResourceMap(),
-                           requires_object_store_memory)) {
+  if (!best_node.IsNil() && !IsSchedulable(resource_request, best_node)) {
     // Prefer waiting on the local node since the local node is chosen for a reason (e.g.
     // spread).
     if (preferred_node_id == local_node_id_.Binary()) {
@@ -322,6 +336,136 @@ scheduling::NodeID ClusterResourceScheduler::GetBestSchedulableNode(
   return best_node;
 }
 
+bool ClusterResourceScheduler::GetArgumentBytes(const TaskSpecification &task_spec,
+                                                int64_t *total_bytes) const {
+  *total_bytes = 0;
+  const auto &deps = task_spec.GetDependencyIds();
+  if (deps.empty()) {
+    return true;
+  }
+  if (get_object_locations_ == nullptr) {
+    return false;
+  }
+  std::vector<NodeID> node_ids;
+  for (const auto &object_id : deps) {
+    int64_t object_size = 0;
+    if (!get_object_locations_(object_id, &node_ids, &object_size)) {
+      return false;
+    }
+    *total_bytes += object_size;
+  }
+  return true;
+}
+
+std::shared_ptr<SchedulingContext> ClusterResourceScheduler::GetArgumentLocality(
+    const TaskSpecification &task_spec) const {
+  if (!IsArgumentLocalityAware()) {
+    return nullptr;
+  }
+  absl::flat_hash_map<scheduling::NodeID, int64_t> arg_bytes_by_node;
+  int64_t total_arg_bytes = 0;
+  std::vector<NodeID> node_ids;
+  for (const auto &object_id : task_spec.GetDependencyIds()) {
+    int64_t object_size = 0;
+    if (!get_object_locations_(object_id, &node_ids, &object_size)) {
+      continue;
+    }
+    total_arg_bytes += object_size;
+    for (const auto &node_id : node_ids) {
+      arg_bytes_by_node[scheduling::NodeID(node_id.Binary())] += object_size;
+    }
+  }
+  if (total_arg_bytes == 0) {
+    return nullptr;
+  }
+  return std::make_shared<ArgumentLocalitySchedulingContext>(std::move(arg_bytes_by_node),
+                                                             total_arg_bytes);
+}
+
+bool ClusterResourceScheduler::CanScheduleInBatch(const TaskSpecification &task_spec) {
+  // The tasks that GetBestSchedulableNode places with the hybrid policy, without
+  // looking at the locations of their arguments.
+  const auto &scheduling_strategy = task_spec.GetMessage().scheduling_strategy();
+  return RayConfig::instance().scheduler_batch_same_shape_tasks() &&
+         !task_spec.IsActorCreationTask() &&
+         !scheduling_strategy.has_spread_scheduling_strategy() &&
+         !scheduling_strategy.has_node_affinity_scheduling_strategy() &&
+         !(IsAffinityWithBundleSchedule(scheduling_strategy) &&
+           !is_local_node_with_raylet_) &&
+         !scheduling_strategy.has_node_label_scheduling_strategy() &&
+         !(IsArgumentLocalityAware() && !task_spec.GetDependencyIds().empty());
+}
+
+std::vector<scheduling::NodeID> ClusterResourceScheduler::GetBestSchedulableNodes(
+    const TaskSpecification &task_spec,
+    const std::string &preferred_node_id,
+    bool exclude_local_node,
+    bool requires_object_store_memory,
+    size_t num_tasks,
+    bool *is_infeasible) {
+  std::vector<scheduling::NodeID> best_nodes;
+  *is_infeasible = false;
+  if (num_tasks == 0) {
+    return best_nodes;
+  }
+
+  // Convert the shape once for the whole burst rather than once per task.
+  ResourceRequest resource_request = ResourceMapToResourceRequest(
+      task_spec.GetRequiredPlacementResources().GetResourceMap(),
+      requires_object_store_memory);
+  const bool prefer_local_node = preferred_node_id == local_node_id_.Binary();
+  if (num_tasks == 1 ||
+      (prefer_local_node && !exclude_local_node &&
+       IsSchedulable(resource_request, local_node_id_))) {
+    // Tasks placed on the local node only queue there, so if it can run the first
+    // task, GetBestSchedulableNode picks it for all of them.
+    auto best_node = GetBestSchedulableNode(resource_request,
+                                            task_spec,
+                                            preferred_node_id,
+                                            exclude_local_node,
+                                            is_infeasible);
+    if (!best_node.IsNil()) {
+      best_nodes.resize(num_tasks, best_node);
+    }
+    return best_nodes;
+  }
+  RAY_CHECK(CanScheduleInBatch(task_spec));
+
+  // GetBestSchedulableNode keeps a task that no node can run right now on the
+  // preferred local node, or in the queue if the GCS schedules it. In these cases,
+  // the policy only needs to look for available nodes.
+  const bool require_node_available =
+      exclude_local_node || prefer_local_node || !is_local_node_with_raylet_;
+  best_nodes = scheduling_policy_->ScheduleBatch(
+      resource_request,
+      SchedulingOptions::Hybrid(/*avoid_local_node*/ exclude_local_node,
+                                require_node_available,
+                                preferred_node_id),
+      num_tasks);
+  if (best_nodes.empty()) {
+    // The cluster view is the one the policy saw for the first task, so decide as
+    // usual for it, and the other tasks get the same node.
+    auto best_node = GetBestSchedulableNode(resource_request,
+                                            task_spec,
+                                            preferred_node_id,
+                                            exclude_local_node,
+                                            is_infeasible);
+    if (!best_node.IsNil()) {
+      best_nodes.resize(num_tasks, best_node);
+    }
+  } else if (best_nodes.size() < num_tasks) {
+    // The nodes ran out of resources for the rest of the burst.
+    if (exclude_local_node) {
+      *is_infeasible = true;
+    } else if (prefer_local_node) {
+      best_nodes.resize(num_tasks, local_node_id_);
+    }
+  }
+  RAY_LOG(DEBUG) << "Placed " << best_nodes.size() << " of " << num_tasks
+                 << " tasks of the burst, is infeasible: " << *is_infeasible;
+  return best_nodes;
+}
+
 SchedulingResult ClusterResourceScheduler::Schedule(
     const std::vector<const ResourceRequest *> &resource_request_list,
     SchedulingOptions options) {
@@ -22,6 +22,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "ray/common/ray_config.h"
 #include "ray/common/scheduling/cluster_resource_data.h"
 #include "ray/common/scheduling/fixed_point.h"
 #include "ray/common/scheduling/resource_set.h"
@@ -63,7 +64,9 @@ class ClusterResourceScheduler {
       std::function<bool(scheduling::NodeID)> is_node_available_fn,
       std::function<int64_t(void)> get_used_object_store_memory = nullptr,
       std::function<bool(void)> get_pull_manager_at_capacity = nullptr,
-      const absl::flat_hash_map<std::string, std::string> &local_node_labels = {});
+      const absl::flat_hash_map<std::string, std::string> &local_node_labels = {},
+      std::function<bool(const ObjectID &, std::vector<NodeID> *, int64_t *)>
+          get_object_locations = nullptr);
 
   /// Schedule the specified resources to the cluster nodes.
   ///
@@ -99,6 +102,39 @@ class ClusterResourceScheduler {
                                             bool requires_object_store_memory,
                                             bool *is_infeasible);
 
+  ///  Find nodes for a burst of tasks that share the resource shape and scheduling
+  ///  strategy of `task_spec`, e.g. the queued tasks of one scheduling class, with one
+  ///  pass over the nodes. Each task gets the node that GetBestSchedulableNode would
+  ///  pick for it if every previous task placed on a remote node had been spilled
+  ///  there, which takes its resources from the node. Tasks placed on the local node
+  ///  don't take its resources, since they only queue there until they are
+  ///  dispatched. The cluster view isn't modified.
+  ///
+  ///  \param task_spec: A task of the burst. Unless `num_tasks` is 1, it must be
+  ///  CanScheduleInBatch.
+  ///  \param preferred_node_id: See GetBestSchedulableNode.
+  ///  \param exclude_local_node: See GetBestSchedulableNode.
+  ///  \param requires_object_store_memory: See GetBestSchedulableNode.
+  ///  \param num_tasks: The number of tasks in the burst.
+  ///  \param is_infeasible[out]: It is set true if the tasks that could not be placed
+  ///  are not schedulable because they are infeasible.
+  ///
+  ///  \return The node chosen for each task, in order. It has fewer than `num_tasks`
+  ///  entries if no node can schedule the rest of the burst right now.
+  std::vector<scheduling::NodeID> GetBestSchedulableNodes(
+      const TaskSpecification &task_spec,
+      const std::string &preferred_node_id,
+      bool exclude_local_node,
+      bool requires_object_store_memory,
+      size_t num_tasks,
+      bool *is_infeasible);
+
+  /// Return whether GetBestSchedulableNodes can place several tasks like `task_spec` at
+  /// once. It can for the tasks placed by the hybrid policy, unless the locations of
+  /// their arguments are part of the decision or scheduler_batch_same_shape_tasks is
+  /// off.
+  bool CanScheduleInBatch(const TaskSpecification &task_spec);
+
   /// Subtract the resources required by a given resource request (resource_request) from
   /// a given remote node.
   ///
@@ -129,6 +165,21 @@ class ClusterResourceScheduler {
 
   bool IsLocalNodeWithRaylet() { return is_local_node_with_raylet_; }
 
+  /// Return whether the hybrid policy takes the locality of the task's arguments into
+  /// account, in which case tasks with arguments can't share a scheduling decision.
+  bool IsArgumentLocalityAware() const {
+    return get_object_locations_ != nullptr &&
+           RayConfig::instance().scheduler_locality_weight() > 0;
+  }
+
+  /// Sum the sizes of the task's arguments as known to the object manager, without
+  /// reading the objects themselves.
+  ///
+  /// \param task_spec The task whose arguments are sized.
+  /// \param[out] total_bytes The total size of the arguments.
+  /// \return False if the size of any argument isn't known.
+  bool GetArgumentBytes(const TaskSpecification &task_spec, int64_t *total_bytes) const;
+
  private:
   void Init(instrumented_io_context &io_service,
             const NodeResources &local_node_resources,
@@ -170,6 +221,8 @@ class ClusterResourceScheduler {
   ///                     a node that can schedule resource_request is found).
   ///  \param is_infeasible[out]: It is set true if the task is not schedulable because it
   ///  is infeasible.
+  ///  \param argument_locality: The locations of the task's arguments, used by the
+  ///  hybrid policy only.
   ///
   ///  \return -1, if no node can schedule the current request; otherwise,
   ///          return the ID of a node that can schedule the resource request.
@@ -180,7 +233,9 @@ class ClusterResourceScheduler {
       bool force_spillback,
       const std::string &preferred_node_id,
       int64_t *violations,
-      bool *is_infeasible);
+      bool *is_infeasible,
+      std::shared_ptr<raylet_scheduling_policy::SchedulingContext> argument_locality =
+          nullptr);
 
   /// Similar to
   ///    int64_t GetBestSchedulableNode(...)
@@ -198,18 +253,34 @@ class ClusterResourceScheduler {
       int64_t *violations,
       bool *is_infeasible);
 
+  /// Same as the public GetBestSchedulableNode, with the task's placement resources
+  /// already converted to `resource_request`.
+  scheduling::NodeID GetBestSchedulableNode(const ResourceRequest &resource_request,
+                                            const TaskSpecification &task_spec,
+                                            const std::string &preferred_node_id,
+                                            bool exclude_local_node,
+                                            bool *is_infeasible);
+
+  /// Look up where the arguments of the task are. Return nullptr if the hybrid policy
+  /// doesn't take the locality of the arguments into account or no location is known.
+  std::shared_ptr<raylet_scheduling_policy::SchedulingContext> GetArgumentLocality(
+      const TaskSpecification &task_spec) const;
+
   /// Judging whether it affinity with placement group bundle
   bool IsAffinityWithBundleSchedule(const rpc::SchedulingStrategy &scheduling_strategy);
   /// Identifier of local node.
   scheduling::NodeID local_node_id_;
   /// Callback to check if node is available.
   std::function<bool(scheduling::NodeID)> is_node_available_fn_;
+  /// Callback to look up the nodes known to hold an object and its size.
+  std::function<bool(const ObjectID &, std::vector<NodeID> *, int64_t *)>
+      get_object_locations_;
   /// Resources of local node.
   std::unique_ptr<LocalResourceManager> local_resource_manager_;
   /// Resources of the entire cluster.
   std::unique_ptr<ClusterResourceManager> cluster_resource_manager_;
   /// The scheduling policy to use.
-  std::unique_ptr<raylet_scheduling_policy::ISchedulingPolicy> scheduling_policy_;
+  std::unique_ptr<raylet_scheduling_policy::CompositeSchedulingPolicy> scheduling_policy_;
   /// The bundle scheduling policy to use.
   std::unique_ptr<raylet_scheduling_policy::IBundleSchedulingPolicy>
       bundle_scheduling_policy_;
@@ -15,6 +15,8 @@
 // clang-format off
 #include "ray/raylet/scheduling/cluster_resource_scheduler.h"
 
+#include <algorithm>
+#include <chrono>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -1549,6 +1551,129 @@ TEST_F(ClusterResourceSchedulerTest, TestForceSpillback) {
             node_ids[51]);
 }
 
+TEST_F(ClusterResourceSchedulerTest, GetBestSchedulableNodesTest) {
+  absl::flat_hash_map<std::string, double> local_resources({{"CPU", 2}});
+  instrumented_io_context io_context;
+  ClusterResourceScheduler resource_scheduler(
+      io_context, scheduling::NodeID("local"), local_resources, is_node_available_fn_);
+  auto remote1 = scheduling::NodeID(NodeID::FromRandom().Binary());
+  auto remote2 = scheduling::NodeID(NodeID::FromRandom().Binary());
+  resource_scheduler.GetClusterResourceManager().AddOrUpdateNode(
+      remote1, {{"CPU", 3.}}, {{"CPU", 3.}});
+  resource_scheduler.GetClusterResourceManager().AddOrUpdateNode(
+      remote2, {{"CPU", 2.}}, {{"CPU", 2.}});
+
+  rpc::TaskSpec message;
+  (*message.mutable_required_resources())["CPU"] = 1;
+  message.mutable_scheduling_strategy()->mutable_default_scheduling_strategy();
+  TaskSpecification task_spec(message);
+  ASSERT_TRUE(resource_scheduler.CanScheduleInBatch(task_spec));
+
+  // Tasks placed on the local node only queue there, so they all stay local while the
+  // local node has a CPU available.
+  bool is_infeasible;
+  auto best_nodes =
+      resource_scheduler.GetBestSchedulableNodes(task_spec,
+                                                 /*preferred_node_id=*/"local",
+                                                 /*exclude_local_node=*/false,
+                                                 /*requires_object_store_memory=*/false,
+                                                 /*num_tasks=*/8,
+                                                 &is_infeasible);
+  ASSERT_FALSE(is_infeasible);
+  ASSERT_EQ(best_nodes,
+            std::vector<scheduling::NodeID>(8, scheduling::NodeID("local")));
+
+  // Once the local CPUs are taken, each task spilled to a remote node takes a CPU
+  // there. The burst fills the remote nodes, then waits locally once no node has a CPU
+  // left.
+  auto &cluster_resource_manager = resource_scheduler.GetClusterResourceManager();
+  ASSERT_TRUE(cluster_resource_manager.SubtractNodeAvailableResources(
+      scheduling::NodeID("local"), ResourceMapToResourceRequest({{"CPU", 2}}, false)));
+  best_nodes =
+      resource_scheduler.GetBestSchedulableNodes(task_spec,
+                                                 /*preferred_node_id=*/"local",
+                                                 /*exclude_local_node=*/false,
+                                                 /*requires_object_store_memory=*/false,
+                                                 /*num_tasks=*/7,
+                                                 &is_infeasible);
+  ASSERT_FALSE(is_infeasible);
+  ASSERT_EQ(best_nodes.size(), 7);
+  ASSERT_EQ(std::count(best_nodes.begin(), best_nodes.begin() + 5, remote1), 3);
+  ASSERT_EQ(std::count(best_nodes.begin(), best_nodes.begin() + 5, remote2), 2);
+  ASSERT_EQ(best_nodes[5], scheduling::NodeID("local"));
+  ASSERT_EQ(best_nodes[6], scheduling::NodeID("local"));
+
+  // The cluster view is not modified.
+  ASSERT_TRUE(cluster_resource_manager.GetNodeResources(remote1).available.Get(
+                  scheduling::ResourceID::CPU()) == 3);
+  ASSERT_TRUE(cluster_resource_manager.GetNodeResources(remote2).available.Get(
+                  scheduling::ResourceID::CPU()) == 2);
+  ASSERT_FALSE(cluster_resource_manager.GetNodeResourceModifiedTs(remote1).has_value());
+
+  // A burst that fits nowhere gets no node.
+  rpc::TaskSpec gpu_message;
+  (*gpu_message.mutable_required_resources())["GPU"] = 1;
+  gpu_message.mutable_scheduling_strategy()->mutable_default_scheduling_strategy();
+  best_nodes = resource_scheduler.GetBestSchedulableNodes(TaskSpecification(gpu_message),
+                                                          /*preferred_node_id=*/"local",
+                                                          false,
+                                                          false,
+                                                          /*num_tasks=*/10,
+                                                          &is_infeasible);
+  ASSERT_TRUE(best_nodes.empty());
+  ASSERT_TRUE(is_infeasible);
+
+  // Spread tasks are placed one at a time.
+  rpc::TaskSpec spread_message;
+  (*spread_message.mutable_required_resources())["CPU"] = 1;
+  spread_message.mutable_scheduling_strategy()->mutable_spread_scheduling_strategy();
+  ASSERT_FALSE(resource_scheduler.CanScheduleInBatch(TaskSpecification(spread_message)));
+}
+
+TEST_F(ClusterResourceSchedulerTest, DISABLED_GetBestSchedulableNodesPerf) {
+  const size_t kNumTasks = 50 * 1000;
+  const int kNumNodes = 100;
+  // The local node has no CPUs, so every task is spilled to a remote node.
+  absl::flat_hash_map<std::string, double> local_resources;
+  rpc::TaskSpec message;
+  (*message.mutable_required_resources())["CPU"] = 1;
+  message.mutable_scheduling_strategy()->mutable_default_scheduling_strategy();
+  TaskSpecification task_spec(message);
+  for (bool batch : {false, true}) {
+    instrumented_io_context io_context;
+    ClusterResourceScheduler resource_scheduler(
+        io_context, scheduling::NodeID("local"), local_resources, is_node_available_fn_);
+    for (int i = 0; i < kNumNodes; i++) {
+      resource_scheduler.GetClusterResourceManager().AddOrUpdateNode(
+          scheduling::NodeID(NodeID::FromRandom().Binary()),
+          {{"CPU", 1000.}},
+          {{"CPU", 1000.}});
+    }
+    // Allocate the resources of each spilled task, like the cluster task manager does.
+    auto spill = [&](scheduling::NodeID node_id) {
+      resource_scheduler.AllocateRemoteTaskResources(node_id, {{"CPU", 1.}});
+    };
+    bool is_infeasible;
+    auto start = std::chrono::steady_clock::now();
+    if (batch) {
+      for (auto node_id : resource_scheduler.GetBestSchedulableNodes(
+               task_spec, "local", false, false, kNumTasks, &is_infeasible)) {
+        spill(node_id);
+      }
+    } else {
+      for (size_t i = 0; i < kNumTasks; i++) {
+        spill(resource_scheduler.GetBestSchedulableNode(
+            task_spec, "local", false, false, &is_infeasible));
+      }
+    }
+    double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    RAY_LOG(INFO) << kNumTasks << " tasks on " << kNumNodes << " nodes, "
+                  << (batch ? "batched" : "one by one") << ": " << duration_s << "s";
+  }
+}
+
 TEST_F(ClusterResourceSchedulerTest, CustomResourceInstanceTest) {
   SetUnitInstanceResourceIds({ResourceID("FPGA")});
   instrumented_io_context io_context;
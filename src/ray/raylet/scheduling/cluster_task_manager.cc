@@ -141,56 +141,75 @@ void ClusterTaskManager::ScheduleAndDispatchTasks() {
       // blocking where a task which cannot be scheduled because
       // there are not enough available resources blocks other
       // tasks from being scheduled.
-      const std::shared_ptr<internal::Work> &work = *work_it;
-      RayTask task = work->task;
-      RAY_LOG(DEBUG) << "Scheduling pending task "
-                     << task.GetTaskSpecification().TaskId();
-      auto scheduling_node_id = cluster_resource_scheduler_->GetBestSchedulableNode(
-          task.GetTaskSpecification(),
-          /*preferred_node_id*/ work->PrioritizeLocalNode() ? self_node_id_.Binary()
-                                                            : task.GetPreferredNodeID(),
+      //
+      // Tasks of a scheduling class share their resource shape and scheduling
+      // strategy, so the run of tasks that also share the preferred node is placed
+      // with a single call to the scheduler, if the scheduler supports it for them.
+      const std::string preferred_node_id = GetPreferredNodeId(**work_it);
+      auto can_share_placement = [this](const internal::Work &work) {
+        return !work.grant_or_reject && cluster_resource_scheduler_->CanScheduleInBatch(
+                                            work.task.GetTaskSpecification());
+      };
+      size_t num_tasks = 1;
+      if (can_share_placement(**work_it)) {
+        for (auto it = std::next(work_it);
+             it != work_queue.end() && can_share_placement(**it) &&
+             GetPreferredNodeId(**it) == preferred_node_id;
+             it++) {
+          num_tasks++;
+        }
+      }
+      RAY_LOG(DEBUG) << "Scheduling " << num_tasks << " pending tasks starting from "
+                     << (*work_it)->task.GetTaskSpecification().TaskId();
+      auto scheduling_node_ids = cluster_resource_scheduler_->GetBestSchedulableNodes(
+          (*work_it)->task.GetTaskSpecification(),
+          preferred_node_id,
           /*exclude_local_node*/ false,
           /*requires_object_store_memory*/ false,
+          num_tasks,
           &is_infeasible);
+      for (const auto &scheduling_node_id : scheduling_node_ids) {
+        ScheduleOnNode(NodeID::FromBinary(scheduling_node_id.Binary()), *work_it);
+        work_it = work_queue.erase(work_it);
+      }
+      if (scheduling_node_ids.size() == num_tasks) {
+        continue;
+      }
 
       // There is no node that has available resources to run the request.
       // Move on to the next shape.
-      if (scheduling_node_id.IsNil()) {
-        RAY_LOG(DEBUG) << "No node found to schedule a task "
-                       << task.GetTaskSpecification().TaskId() << " is infeasible?"
-                       << is_infeasible;
-
-        if (task.GetTaskSpecification().IsNodeAffinitySchedulingStrategy() &&
-            !task.GetTaskSpecification().GetNodeAffinitySchedulingStrategySoft()) {
-          // This can only happen if the target node doesn't exist or is infeasible.
-          // The task will never be schedulable in either case so we should fail it.
-          if (cluster_resource_scheduler_->IsLocalNodeWithRaylet()) {
-            ReplyCancelled(
-                *work,
-                rpc::RequestWorkerLeaseReply::SCHEDULING_CANCELLED_UNSCHEDULABLE,
-                "The node specified via NodeAffinitySchedulingStrategy doesn't exist "
-                "any more or is infeasible, and soft=False was specified.");
-            // We don't want to trigger the normal infeasible task logic (i.e. waiting),
-            // but rather we want to fail the task immediately.
-            work_it = work_queue.erase(work_it);
-          } else {
-            // If scheduling is done by gcs, we can not `ReplyCancelled` now because it
-            // would synchronously call `ClusterTaskManager::CancelTask`, where
-            // `task_to_schedule_`'s iterator will be invalidated. So record this work and
-            // it will be handled below (out of the loop).
-            works_to_cancel.push_back(*work_it);
-            work_it++;
-          }
-          is_infeasible = false;
-          continue;
+      const std::shared_ptr<internal::Work> &work = *work_it;
+      RayTask task = work->task;
+      RAY_LOG(DEBUG) << "No node found to schedule a task "
+                     << task.GetTaskSpecification().TaskId() << " is infeasible?"
+                     << is_infeasible;
+
+      if (task.GetTaskSpecification().IsNodeAffinitySchedulingStrategy() &&
+          !task.GetTaskSpecification().GetNodeAffinitySchedulingStrategySoft()) {
+        // This can only happen if the target node doesn't exist or is infeasible.
+        // The task will never be schedulable in either case so we should fail it.
+        if (cluster_resource_scheduler_->IsLocalNodeWithRaylet()) {
+          ReplyCancelled(
+              *work,
+              rpc::RequestWorkerLeaseReply::SCHEDULING_CANCELLED_UNSCHEDULABLE,
+              "The node specified via NodeAffinitySchedulingStrategy doesn't exist "
+              "any more or is infeasible, and soft=False was specified.");
+          // We don't want to trigger the normal infeasible task logic (i.e. waiting),
+          // but rather we want to fail the task immediately.
+          work_it = work_queue.erase(work_it);
+        } else {
+          // If scheduling is done by gcs, we can not `ReplyCancelled` now because it
+          // would synchronously call `ClusterTaskManager::CancelTask`, where
+          // `task_to_schedule_`'s iterator will be invalidated. So record this work and
+          // it will be handled below (out of the loop).
+          works_to_cancel.push_back(*work_it);
+          work_it++;
         }
-
-        break;
+        is_infeasible = false;
+        continue;
       }
 
-      NodeID node_id = NodeID::FromBinary(scheduling_node_id.Binary());
-      ScheduleOnNode(node_id, work);
-      work_it = work_queue.erase(work_it);
+      break;
     }
 
     if (is_infeasible) {
@@ -242,8 +261,7 @@ void ClusterTaskManager::TryScheduleInfeasibleTask() {
     bool is_infeasible;
     cluster_resource_scheduler_->GetBestSchedulableNode(
         task.GetTaskSpecification(),
-        /*preferred_node_id*/ work->PrioritizeLocalNode() ? self_node_id_.Binary()
-                                                          : task.GetPreferredNodeID(),
+        GetPreferredNodeId(*work),
         /*exclude_local_node*/ false,
         /*requires_object_store_memory*/ false,
         &is_infeasible);
@@ -386,6 +404,11 @@ std::string ClusterTaskManager::DebugStr() const {
   return internal_stats_.ComputeAndReportDebugStr();
 }
 
+std::string ClusterTaskManager::GetPreferredNodeId(const internal::Work &work) const {
+  return work.PrioritizeLocalNode() ? self_node_id_.Binary()
+                                    : work.task.GetPreferredNodeID();
+}
+
 void ClusterTaskManager::ScheduleOnNode(const NodeID &spillback_to,
                                         const std::shared_ptr<internal::Work> &work) {
   if (spillback_to == self_node_id_ && local_task_manager_) {
@@ -139,6 +139,10 @@ class ClusterTaskManager : public ClusterTaskManagerInterface {
  private:
   void TryScheduleInfeasibleTask();
 
+  // The node the work should be placed on if it has resources: the local node if the
+  // work prioritizes it, otherwise the task's preferred node.
+  std::string GetPreferredNodeId(const internal::Work &work) const;
+
   // Schedule the task onto a node (which could be either remote or local).
   void ScheduleOnNode(const NodeID &node_to_schedule,
                       const std::shared_ptr<internal::Work> &work);
@@ -181,6 +185,8 @@ class ClusterTaskManager : public ClusterTaskManagerInterface {
   friend class SchedulerStats;
   friend class ClusterTaskManagerTest;
   FRIEND_TEST(ClusterTaskManagerTest, FeasibleToNonFeasible);
+  FRIEND_TEST(ClusterTaskManagerTestWithoutCPUsAtHead,
+              DISABLED_ScheduleAndDispatchBurstPerf);
 };
 }  // namespace raylet
 }  // namespace ray
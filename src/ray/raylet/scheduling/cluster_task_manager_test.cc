@@ -19,6 +19,8 @@
 #include <memory>
 #include <string>
 
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ray/common/id.h"
@@ -1791,6 +1793,92 @@ TEST_F(ClusterTaskManagerTest, FeasibleToNonFeasible) {
             task1.GetTaskSpecification().TaskId());
 }
 
+TEST_F(ClusterTaskManagerTest, StealTasksTest) {
+  std::shared_ptr<MockWorker> worker =
+      std::make_shared<MockWorker>(WorkerID::FromRandom(), 1234);
+  pool_.PushWorker(std::static_pointer_cast<WorkerInterface>(worker));
+  int num_callbacks = 0;
+  auto callback = [&](Status, std::function<void()>, std::function<void()>) {
+    num_callbacks++;
+  };
+
+  // The first task takes all the local CPUs.
+  RayTask running_task = CreateTask({{ray::kCPU_ResourceLabel, 8}});
+  rpc::RequestWorkerLeaseReply running_reply;
+  task_manager_.QueueAndScheduleTask(
+      running_task, false, false, &running_reply, callback);
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(leased_workers_.size(), 1);
+  ASSERT_EQ(num_callbacks, 1);
+
+  // The next ones wait for local resources.
+  std::vector<RayTask> tasks;
+  std::vector<rpc::RequestWorkerLeaseReply> replies(6);
+  for (size_t i = 0; i < replies.size(); i++) {
+    tasks.push_back(CreateTask({{ray::kCPU_ResourceLabel, 1}}));
+    task_manager_.QueueAndScheduleTask(tasks[i], false, false, &replies[i], callback);
+  }
+  // Tasks with node affinity to this node are never handed over.
+  rpc::SchedulingStrategy scheduling_strategy;
+  scheduling_strategy.mutable_node_affinity_scheduling_strategy()->set_node_id(
+      id_.Binary());
+  scheduling_strategy.mutable_node_affinity_scheduling_strategy()->set_soft(false);
+  std::vector<rpc::RequestWorkerLeaseReply> affinity_replies(2);
+  for (auto &reply : affinity_replies) {
+    RayTask task =
+        CreateTask({{ray::kCPU_ResourceLabel, 1}}, 0, {}, nullptr, scheduling_strategy);
+    task_manager_.QueueAndScheduleTask(task, false, false, &reply, callback);
+  }
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(num_callbacks, 1);
+  ASSERT_EQ(NumTasksToDispatchWithStatus(internal::WorkStatus::WAITING), 8);
+
+  // Nothing is handed over to this node or to an unknown node.
+  auto remote_node_id = NodeID::FromRandom();
+  NodeResourceSet eight_cpus({{"CPU", 8}});
+  ASSERT_EQ(local_task_manager_->StealTasks(id_, eight_cpus, 100).size(), 0);
+  ASSERT_EQ(local_task_manager_->StealTasks(remote_node_id, eight_cpus, 100).size(), 0);
+  AddNode(remote_node_id, 8);
+
+  // The tasks handed over fit in the idle node all together, and are taken from the
+  // end of the queue.
+  auto stolen_tasks =
+      local_task_manager_->StealTasks(remote_node_id, NodeResourceSet({{"CPU", 2}}), 100);
+  ASSERT_EQ(stolen_tasks.size(), 2);
+  ASSERT_EQ(stolen_tasks[0].TaskId(), tasks[5].GetTaskSpecification().TaskId());
+  ASSERT_EQ(stolen_tasks[1].TaskId(), tasks[4].GetTaskSpecification().TaskId());
+  ASSERT_EQ(num_callbacks, 3);
+  for (size_t i = 0; i < replies.size(); i++) {
+    ASSERT_EQ(replies[i].retry_at_raylet_address().raylet_id(),
+              i >= 4 ? remote_node_id.Binary() : "");
+  }
+
+  // No more than `max_tasks` are handed over.
+  ASSERT_EQ(local_task_manager_->StealTasks(remote_node_id, eight_cpus, 1).size(), 1);
+  ASSERT_EQ(replies[3].retry_at_raylet_address().raylet_id(), remote_node_id.Binary());
+
+  // The head of the queue stays with this node.
+  ASSERT_EQ(local_task_manager_->StealTasks(remote_node_id, eight_cpus, 100).size(), 1);
+  ASSERT_EQ(local_task_manager_->StealTasks(remote_node_id, eight_cpus, 100).size(), 1);
+  ASSERT_EQ(local_task_manager_->StealTasks(remote_node_id, eight_cpus, 100).size(), 0);
+  ASSERT_EQ(num_callbacks, 6);
+  ASSERT_EQ(replies[0].retry_at_raylet_address().raylet_id(), "");
+  for (const auto &reply : affinity_replies) {
+    ASSERT_EQ(reply.retry_at_raylet_address().raylet_id(), "");
+  }
+  ASSERT_EQ(NumTasksToDispatchWithStatus(internal::WorkStatus::WAITING), 3);
+  ASSERT_EQ(local_task_manager_->num_task_stolen_, 5);
+
+  // A task whose argument size isn't known to the object manager stays with this node.
+  rpc::RequestWorkerLeaseReply arg_reply;
+  RayTask arg_task = CreateTask({{ray::kCPU_ResourceLabel, 1}}, /*num_args=*/1);
+  task_manager_.QueueAndScheduleTask(arg_task, false, false, &arg_reply, callback);
+  pool_.TriggerCallbacks();
+  ASSERT_EQ(NumTasksToDispatchWithStatus(internal::WorkStatus::WAITING), 4);
+  ASSERT_EQ(local_task_manager_->StealTasks(remote_node_id, eight_cpus, 100).size(), 0);
+  ASSERT_EQ(arg_reply.retry_at_raylet_address().raylet_id(), "");
+}
+
 TEST_F(ClusterTaskManagerTestWithGPUsAtHead, RleaseAndReturnWorkerCpuResources) {
   // Add PG CPU and GPU resources.
   scheduler_->GetLocalResourceManager().AddLocalResourceInstances(
@@ -2724,6 +2812,51 @@ TEST_F(ClusterTaskManagerTestWithoutCPUsAtHead, OneCpuInfeasibleTask) {
   }
 }
 
+// Compares the main-thread time ScheduleAndDispatchTasks spends spilling a burst of
+// queued tasks of one scheduling class to 100 remote nodes, with and without placing
+// the burst with one scheduler call. It's only used to measure the speedup, so it's
+// disabled by default.
+TEST_F(ClusterTaskManagerTestWithoutCPUsAtHead, DISABLED_ScheduleAndDispatchBurstPerf) {
+  const int num_nodes = 100;
+  const int num_tasks = 10000;
+  const int num_rounds = 10;
+  std::vector<NodeID> node_ids;
+  for (int i = 0; i < num_nodes; i++) {
+    node_ids.push_back(NodeID::FromRandom());
+  }
+  std::vector<std::unique_ptr<rpc::RequestWorkerLeaseReply>> replies;
+
+  for (bool batch : {false, true}) {
+    RayConfig::instance().initialize(
+        absl::StrCat(R"({"scheduler_top_k_absolute": 1, )",
+                     R"("scheduler_batch_same_shape_tasks": )",
+                     batch ? "true" : "false",
+                     "}"));
+    int64_t total_us = 0;
+    for (int round = 0; round < num_rounds; round++) {
+      // Every node has room for all of the tasks, so they are all spilled.
+      for (const auto &node_id : node_ids) {
+        AddNode(node_id, num_tasks);
+      }
+      for (int i = 0; i < num_tasks; i++) {
+        auto task = CreateTask({{ray::kCPU_ResourceLabel, 1}});
+        replies.push_back(std::make_unique<rpc::RequestWorkerLeaseReply>());
+        task_manager_.tasks_to_schedule_[task.GetTaskSpecification().GetSchedulingClass()]
+            .push_back(std::make_shared<internal::Work>(
+                task, false, false, replies.back().get(), []() {}));
+      }
+      auto start = absl::Now();
+      task_manager_.ScheduleAndDispatchTasks();
+      total_us += absl::ToInt64Microseconds(absl::Now() - start);
+      ASSERT_TRUE(task_manager_.tasks_to_schedule_.empty());
+      replies.clear();
+    }
+    RAY_LOG(INFO) << "ScheduleAndDispatchTasks for " << num_tasks << " tasks on "
+                  << num_nodes << " nodes " << (batch ? "with" : "without")
+                  << " batching: " << total_us / num_rounds << "us";
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,73 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/scheduling/node_score_index.h"
+
+#include "ray/util/logging.h"
+
+namespace ray {
+
+float ComputeHybridNodeScore(const NodeResources &node_resources,
+                             float spread_threshold) {
+  return ComputeHybridNodeScore(node_resources.CalculateCriticalResourceUtilization(),
+                                spread_threshold);
+}
+
+void NodeScoreIndex::AddOrUpdateNode(scheduling::NodeID node_id,
+                                     const NodeResources &node_resources) {
+  float utilization = node_resources.CalculateCriticalResourceUtilization();
+  float score = ComputeHybridNodeScore(utilization, spread_threshold_);
+  auto it = slots_.find(node_id);
+  if (it == slots_.end()) {
+    slots_.emplace(node_id, node_ids_.size());
+    node_ids_.push_back(node_id);
+    utilizations_.push_back(utilization);
+  } else {
+    float &cached_utilization = utilizations_[it->second];
+    float old_score = ComputeHybridNodeScore(cached_utilization, spread_threshold_);
+    cached_utilization = utilization;
+    if (old_score == score) {
+      return;
+    }
+    ordered_nodes_.erase({old_score, node_id});
+  }
+  ordered_nodes_.emplace(score, node_id);
+}
+
+void NodeScoreIndex::RemoveNode(scheduling::NodeID node_id) {
+  auto it = slots_.find(node_id);
+  if (it == slots_.end()) {
+    return;
+  }
+  const size_t slot = it->second;
+  ordered_nodes_.erase(
+      {ComputeHybridNodeScore(utilizations_[slot], spread_threshold_), node_id});
+  slots_.erase(it);
+  // Move the last node into the freed slot to keep the arrays contiguous.
+  if (slot != node_ids_.size() - 1) {
+    node_ids_[slot] = node_ids_.back();
+    utilizations_[slot] = utilizations_.back();
+    slots_[node_ids_[slot]] = slot;
+  }
+  node_ids_.pop_back();
+  utilizations_.pop_back();
+}
+
+float NodeScoreIndex::GetUtilization(scheduling::NodeID node_id) const {
+  auto it = slots_.find(node_id);
+  RAY_CHECK(it != slots_.end()) << "Node " << node_id.ToInt() << " is not indexed";
+  return utilizations_[it->second];
+}
+
+}  // namespace ray
@@ -0,0 +1,95 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "absl/container/btree_set.h"
+#include "absl/container/flat_hash_map.h"
+#include "ray/common/scheduling/cluster_resource_data.h"
+
+namespace ray {
+
+/// Compute the score the hybrid scheduling policy gives to a node: its critical
+/// resource utilization, truncated to 0 below the spread threshold. The lower the
+/// score, the more preferable the node.
+float ComputeHybridNodeScore(const NodeResources &node_resources, float spread_threshold);
+
+/// Same as above, from the critical resource utilization of the node.
+inline float ComputeHybridNodeScore(float critical_resource_utilization,
+                                    float spread_threshold) {
+  return critical_resource_utilization < spread_threshold ? 0
+                                                          : critical_resource_utilization;
+}
+
+/// \class NodeScoreIndex
+///
+/// The nodes of the cluster ordered by their hybrid score for a fixed spread
+/// threshold. This lets the hybrid scheduling policy visit the nodes from the most to
+/// the least preferable and stop as soon as it has found its top k candidates,
+/// instead of scoring and sorting all the nodes for every scheduling decision.
+///
+/// It also caches the critical resource utilization of each node in a contiguous
+/// array, so that the policy can score the nodes for any spread threshold without
+/// going through their resources.
+///
+/// The ClusterResourceManager updates the index whenever the local view of a node
+/// changes. This class is not thread safe.
+class NodeScoreIndex {
+ public:
+  /// The nodes ordered by increasing score, and then by ID to break ties.
+  using OrderedNodes = absl::btree_set<std::pair<float, scheduling::NodeID>>;
+
+  explicit NodeScoreIndex(float spread_threshold) : spread_threshold_(spread_threshold) {}
+
+  /// Add a node to the index or update its score.
+  ///
+  /// \param node_id ID of the node.
+  /// \param node_resources The local view of the resources of the node.
+  void AddOrUpdateNode(scheduling::NodeID node_id, const NodeResources &node_resources);
+
+  /// Remove a node from the index, if it is in it.
+  void RemoveNode(scheduling::NodeID node_id);
+
+  /// The spread threshold the scores are computed with.
+  float SpreadThreshold() const { return spread_threshold_; }
+
+  /// Get the nodes in the index, from the most to the least preferable.
+  const OrderedNodes &GetOrderedNodes() const { return ordered_nodes_; }
+
+  /// Get the cached critical resource utilization of a node in the index.
+  float GetUtilization(scheduling::NodeID node_id) const;
+
+  /// Get the nodes in the index, in no particular order.
+  const std::vector<scheduling::NodeID> &GetNodeIds() const { return node_ids_; }
+
+  /// Get the critical resource utilization of the nodes, in the order of GetNodeIds().
+  const std::vector<float> &GetUtilizations() const { return utilizations_; }
+
+  /// The number of nodes in the index.
+  size_t Size() const { return slots_.size(); }
+
+ private:
+  const float spread_threshold_;
+  /// The nodes ordered by score.
+  OrderedNodes ordered_nodes_;
+  /// The position of each node in `node_ids_` and `utilizations_`.
+  absl::flat_hash_map<scheduling::NodeID, size_t> slots_;
+  std::vector<scheduling::NodeID> node_ids_;
+  std::vector<float> utilizations_;
+};
+
+}  // namespace ray
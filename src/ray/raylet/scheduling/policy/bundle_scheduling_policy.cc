@@ -87,6 +87,92 @@ bool AllocationWillExceedMaxCpuFraction(
   return cpus_used_by_pg_after > max_reservable_cpus;
 }
 
+/// Give the resources of a bundle back to the available resources of a node.
+void ReturnAvailableResources(ray::NodeResources &node_resources,
+                              const ray::ResourceRequest &bundle_resource_request) {
+  for (const auto &resource_id : bundle_resource_request.ResourceIds()) {
+    node_resources.available.Set(resource_id,
+                                 node_resources.available.Get(resource_id) +
+                                     bundle_resource_request.Get(resource_id));
+  }
+}
+
+/// Maximum bipartite matching between the bundles of a STRICT_SPREAD placement group and
+/// the nodes they fit. Identical bundles share the same shape, i.e. the same nodes.
+class BundleNodeMatching {
+ public:
+  /// \param shape_nodes The nodes each shape fits, in order of preference.
+  /// \param bundle_shapes The shape of each bundle.
+  /// \param num_nodes The number of nodes.
+  /// \param steps_left The remaining budget of nodes to visit.
+  BundleNodeMatching(const std::vector<std::vector<size_t>> &shape_nodes,
+                     const std::vector<size_t> &bundle_shapes,
+                     size_t num_nodes,
+                     int64_t &steps_left)
+      : shape_nodes_(shape_nodes),
+        bundle_shapes_(bundle_shapes),
+        steps_left_(steps_left),
+        shape_free_nodes_(shape_nodes.size(), 0),
+        node_bundles_(num_nodes, -1),
+        node_visits_(num_nodes, 0) {}
+
+  /// Give a node to the bundle, moving the bundles already matched to other nodes if
+  /// needed.
+  ///
+  /// \return Whether the bundle got a node.
+  bool Match(size_t bundle) {
+    visit_++;
+    return Augment(bundle);
+  }
+
+  /// Return the bundle of each node, or -1.
+  const std::vector<int64_t> &GetNodeBundles() const { return node_bundles_; }
+
+ private:
+  bool Augment(size_t bundle) {
+    const auto shape = bundle_shapes_[bundle];
+    const auto &nodes = shape_nodes_[shape];
+    // Take the first free node, as the greedy placement would. Matched nodes never
+    // become free again, so each shape only scans its nodes once.
+    auto &free_node = shape_free_nodes_[shape];
+    while (free_node < nodes.size() && node_bundles_[nodes[free_node]] >= 0) {
+      if (--steps_left_ < 0) {
+        return false;
+      }
+      free_node++;
+    }
+    if (free_node < nodes.size()) {
+      node_bundles_[nodes[free_node]] = bundle;
+      return true;
+    }
+    // Otherwise look for an augmenting path through the nodes of the bundle.
+    for (auto node : nodes) {
+      if (node_visits_[node] == visit_) {
+        continue;
+      }
+      if (--steps_left_ < 0) {
+        return false;
+      }
+      node_visits_[node] = visit_;
+      if (Augment(static_cast<size_t>(node_bundles_[node]))) {
+        node_bundles_[node] = bundle;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const std::vector<std::vector<size_t>> &shape_nodes_;
+  const std::vector<size_t> &bundle_shapes_;
+  int64_t &steps_left_;
+  /// The index of the first node of each shape that may be free.
+  std::vector<size_t> shape_free_nodes_;
+  std::vector<int64_t> node_bundles_;
+  /// The last augmentation that visited each node.
+  std::vector<uint64_t> node_visits_;
+  uint64_t visit_ = 0;
+};
+
 }  // namespace
 
 namespace ray {
@@ -221,7 +307,8 @@ std::pair<scheduling::NodeID, const Node *> BundleSchedulingPolicy::GetBestNode(
       continue;
     }
 
-    double node_score = node_scorer_->Score(required_resources, node_resources);
+    double node_score =
+        node_scorer_->Score(node_id, required_resources, node_resources);
     if (best_node_id.IsNil() || best_node_score < node_score) {
       best_node_id = node_id;
       best_node_score = node_score;
@@ -234,6 +321,190 @@ std::pair<scheduling::NodeID, const Node *> BundleSchedulingPolicy::GetBestNode(
   return {scheduling::NodeID::Nil(), nullptr};
 }
 
+std::vector<scheduling::NodeID> BundleSchedulingPolicy::SolvePlacement(
+    const std::vector<const ResourceRequest *> &sorted_resource_request_list,
+    const absl::flat_hash_map<scheduling::NodeID, const Node *> &candidate_nodes,
+    const SchedulingOptions &options,
+    const absl::flat_hash_map<scheduling::NodeID, double>
+        &available_cpus_before_bundle_scheduling,
+    bool strict_spread) const {
+  int64_t steps_left = RayConfig::instance().placement_group_solver_max_steps();
+  const size_t num_bundles = sorted_resource_request_list.size();
+  if (steps_left <= 0 || candidate_nodes.empty() ||
+      (strict_spread && num_bundles > candidate_nodes.size())) {
+    return {};
+  }
+
+  // Search on a copy of the resources of the candidate nodes, ordered by their score for
+  // the scarcest bundle and then by id, so that the search is deterministic and
+  // matches bundles to the nodes the greedy placement prefers first.
+  std::vector<std::pair<double, scheduling::NodeID>> scored_nodes;
+  scored_nodes.reserve(candidate_nodes.size());
+  for (const auto &[node_id, node] : candidate_nodes) {
+    scored_nodes.emplace_back(
+        -node_scorer_->Score(
+            node_id, *sorted_resource_request_list.front(), node->GetLocalView()),
+        node_id);
+  }
+  std::sort(scored_nodes.begin(), scored_nodes.end());
+  std::vector<scheduling::NodeID> node_ids;
+  std::vector<NodeResources> node_resources;
+  std::vector<double> available_cpus_before;
+  node_ids.reserve(scored_nodes.size());
+  node_resources.reserve(scored_nodes.size());
+  available_cpus_before.reserve(scored_nodes.size());
+  for (const auto &[score, node_id] : scored_nodes) {
+    node_ids.push_back(node_id);
+    node_resources.push_back(candidate_nodes.at(node_id)->GetLocalView());
+    available_cpus_before.push_back(available_cpus_before_bundle_scheduling.at(node_id));
+  }
+  const size_t num_nodes = node_ids.size();
+
+  // Return the score of the node for the bundle, or -1 if the bundle doesn't fit.
+  auto fit_score = [&](size_t node, const ResourceRequest &resource_request) {
+    double score =
+        node_scorer_->Score(node_ids[node], resource_request, node_resources[node]);
+    if (score < 0 ||
+        AllocationWillExceedMaxCpuFraction(node_resources[node],
+                                           resource_request,
+                                           options.max_cpu_fraction_per_node,
+                                           available_cpus_before[node])) {
+      return -1.;
+    }
+    return score;
+  };
+  auto same_resources = [&](size_t node, size_t other_node) {
+    return available_cpus_before[node] == available_cpus_before[other_node] &&
+           node_resources[node].available == node_resources[other_node].available &&
+           node_resources[node].total == node_resources[other_node].total;
+  };
+
+  std::vector<size_t> bundle_to_node(num_bundles);
+  if (strict_spread) {
+    // Each bundle takes a whole node, so the placement is a maximum matching between
+    // the bundles and the nodes they fit.
+    std::vector<std::vector<size_t>> shape_nodes;
+    std::vector<size_t> bundle_shapes(num_bundles);
+    for (size_t bundle = 0; bundle < num_bundles; bundle++) {
+      const auto &resource_request = *sorted_resource_request_list[bundle];
+      if (bundle > 0 && resource_request == *sorted_resource_request_list[bundle - 1]) {
+        bundle_shapes[bundle] = bundle_shapes[bundle - 1];
+        continue;
+      }
+      bundle_shapes[bundle] = shape_nodes.size();
+      shape_nodes.emplace_back();
+      for (size_t node = 0; node < num_nodes; node++) {
+        if (--steps_left < 0) {
+          return {};
+        }
+        if (fit_score(node, resource_request) >= 0) {
+          shape_nodes.back().push_back(node);
+        }
+      }
+    }
+    BundleNodeMatching matching(shape_nodes, bundle_shapes, num_nodes, steps_left);
+    for (size_t bundle = 0; bundle < num_bundles; bundle++) {
+      if (!matching.Match(bundle)) {
+        return {};
+      }
+    }
+    const auto &node_bundles = matching.GetNodeBundles();
+    for (size_t node = 0; node < num_nodes; node++) {
+      if (node_bundles[node] >= 0) {
+        bundle_to_node[node_bundles[node]] = node;
+      }
+    }
+  } else {
+    // Place the bundles with the largest share of the biggest node first, each on the
+    // node it leaves the least resources on, and backtrack to the next node of the
+    // previous bundle when a bundle fits no node. A node is skipped when it has the
+    // same resources as the node that just failed, because it would fail the same way.
+    absl::flat_hash_map<scheduling::ResourceID, double> max_totals;
+    std::vector<double> bundle_shares(num_bundles, 0);
+    for (size_t bundle = 0; bundle < num_bundles; bundle++) {
+      const auto &resource_request = *sorted_resource_request_list[bundle];
+      for (const auto &resource_id : resource_request.ResourceIds()) {
+        auto it = max_totals.find(resource_id);
+        if (it == max_totals.end()) {
+          double max_total = 0;
+          for (const auto &resources : node_resources) {
+            max_total = std::max(max_total, resources.total.Get(resource_id).Double());
+          }
+          it = max_totals.emplace(resource_id, max_total).first;
+        }
+        if (it->second > 0) {
+          bundle_shares[bundle] =
+              std::max(bundle_shares[bundle],
+                       resource_request.Get(resource_id).Double() / it->second);
+        }
+      }
+    }
+    std::vector<size_t> bundle_order(num_bundles);
+    std::iota(bundle_order.begin(), bundle_order.end(), 0);
+    std::stable_sort(bundle_order.begin(), bundle_order.end(), [&](size_t a, size_t b) {
+      return bundle_shares[a] > bundle_shares[b];
+    });
+
+    // The nodes each placed bundle fits, from the tightest, and the next one to try.
+    std::vector<std::vector<std::pair<double, size_t>>> candidates(num_bundles);
+    std::vector<size_t> next_candidate(num_bundles, 0);
+    size_t depth = 0;
+    bool backtracked = false;
+    while (depth < num_bundles) {
+      const auto bundle = bundle_order[depth];
+      const auto &resource_request = *sorted_resource_request_list[bundle];
+      auto &bundle_candidates = candidates[depth];
+      int64_t failed_node = -1;
+      if (backtracked) {
+        failed_node = bundle_to_node[bundle];
+        ReturnAvailableResources(node_resources[failed_node], resource_request);
+      } else {
+        bundle_candidates.clear();
+        for (size_t node = 0; node < num_nodes; node++) {
+          if (--steps_left < 0) {
+            return {};
+          }
+          double score = fit_score(node, resource_request);
+          if (score >= 0) {
+            bundle_candidates.emplace_back(score, node);
+          }
+        }
+        std::sort(bundle_candidates.begin(), bundle_candidates.end());
+        next_candidate[depth] = 0;
+      }
+
+      auto &candidate = next_candidate[depth];
+      while (candidate < bundle_candidates.size() && failed_node >= 0 &&
+             same_resources(bundle_candidates[candidate].second,
+                            static_cast<size_t>(failed_node))) {
+        if (--steps_left < 0) {
+          return {};
+        }
+        candidate++;
+      }
+      if (candidate < bundle_candidates.size()) {
+        const auto node = bundle_candidates[candidate++].second;
+        node_resources[node].available -= resource_request.GetResourceSet();
+        bundle_to_node[bundle] = node;
+        depth++;
+        backtracked = false;
+      } else if (depth == 0) {
+        return {};
+      } else {
+        depth--;
+        backtracked = true;
+      }
+    }
+  }
+
+  std::vector<scheduling::NodeID> result_nodes;
+  result_nodes.reserve(num_bundles);
+  for (auto node : bundle_to_node) {
+    result_nodes.push_back(node_ids[node]);
+  }
+  return result_nodes;
+}
+
 ////////////////////  BundlePackSchedulingPolicy  ///////////////////////////////
 SchedulingResult BundlePackSchedulingPolicy::Schedule(
     const std::vector<const ResourceRequest *> &resource_request_list,
@@ -315,8 +586,17 @@ SchedulingResult BundlePackSchedulingPolicy::Schedule(
   }
 
   if (!required_resources_list_copy.empty()) {
-    // Can't meet the scheduling requirements temporarily.
-    return SchedulingResult::Failed();
+    // The greedy placement can fail although the bundles fit, so search for a placement
+    // before giving up.
+    result_nodes = SolvePlacement(sorted_resource_request_list,
+                                  SelectCandidateNodes(options.scheduling_context.get()),
+                                  options,
+                                  available_cpus_before_bundle_scheduling,
+                                  /*strict_spread=*/false);
+    if (result_nodes.empty()) {
+      // Can't meet the scheduling requirements temporarily.
+      return SchedulingResult::Failed();
+    }
   }
   return SortSchedulingResult(SchedulingResult::Success(std::move(result_nodes)),
                               sorted_index);
@@ -525,6 +805,15 @@ SchedulingResult BundleStrictSpreadSchedulingPolicy::Schedule(
   }
 
   if (result_nodes.size() != sorted_resource_request_list.size()) {
+    // The greedy placement can fail although each bundle could get its own node, so
+    // search for a placement before giving up.
+    result_nodes = SolvePlacement(sorted_resource_request_list,
+                                  SelectCandidateNodes(options.scheduling_context.get()),
+                                  options,
+                                  available_cpus_before_bundle_scheduling,
+                                  /*strict_spread=*/true);
+  }
+  if (result_nodes.empty()) {
     // Can't meet the scheduling requirements temporarily.
     return SchedulingResult::Failed();
   }
@@ -70,6 +70,24 @@ class BundleSchedulingPolicy : public IBundleSchedulingPolicy {
   const absl::flat_hash_map<scheduling::NodeID, double>
   GetAvailableCpusBeforeBundleScheduling() const;
 
+  /// Search an assignment of all the bundles to the candidate nodes, for when the greedy
+  /// placement fails although one may exist. With `strict_spread`, the bundles are
+  /// matched to distinct nodes with augmenting paths, otherwise they are placed in order
+  /// with backtracking. The search gives up after `placement_group_solver_max_steps`
+  /// attempts to fit a bundle on a node.
+  ///
+  /// \param sorted_resource_request_list The bundles to place, scarcest first.
+  /// \param candidate_nodes The nodes can be used for scheduling.
+  /// \param strict_spread Whether each node can host at most one bundle.
+  /// \return The node of each bundle, or an empty vector if none was found.
+  std::vector<scheduling::NodeID> SolvePlacement(
+      const std::vector<const ResourceRequest *> &sorted_resource_request_list,
+      const absl::flat_hash_map<scheduling::NodeID, const Node *> &candidate_nodes,
+      const SchedulingOptions &options,
+      const absl::flat_hash_map<scheduling::NodeID, double>
+          &available_cpus_before_bundle_scheduling,
+      bool strict_spread) const;
+
  protected:
   /// The cluster resource manager.
   ClusterResourceManager &cluster_resource_manager_;
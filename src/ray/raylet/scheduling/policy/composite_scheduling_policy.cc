@@ -46,6 +46,15 @@ scheduling::NodeID CompositeSchedulingPolicy::Schedule(
   UNREACHABLE;
 }
 
+std::vector<scheduling::NodeID> CompositeSchedulingPolicy::ScheduleBatch(
+    const ResourceRequest &resource_request,
+    const SchedulingOptions &options,
+    size_t num_tasks) {
+  RAY_CHECK(options.scheduling_type == SchedulingType::HYBRID)
+      << "Only the hybrid policy can schedule tasks in a batch";
+  return hybrid_policy_.ScheduleBatch(resource_request, options, num_tasks);
+}
+
 SchedulingResult CompositeBundleSchedulingPolicy::Schedule(
     const std::vector<const ResourceRequest *> &resource_request_list,
     SchedulingOptions options) {
@@ -35,8 +35,10 @@ class CompositeSchedulingPolicy : public ISchedulingPolicy {
   CompositeSchedulingPolicy(scheduling::NodeID local_node_id,
                             ClusterResourceManager &cluster_resource_manager,
                             std::function<bool(scheduling::NodeID)> is_node_available)
-      : hybrid_policy_(
-            local_node_id, cluster_resource_manager.GetResourceView(), is_node_available),
+      : hybrid_policy_(local_node_id,
+                       cluster_resource_manager.GetResourceView(),
+                       is_node_available,
+                       &cluster_resource_manager.GetNodeScoreIndex()),
         random_policy_(
             local_node_id, cluster_resource_manager.GetResourceView(), is_node_available),
         spread_policy_(
@@ -54,6 +56,12 @@ class CompositeSchedulingPolicy : public ISchedulingPolicy {
   scheduling::NodeID Schedule(const ResourceRequest &resource_request,
                               SchedulingOptions options) override;
 
+  /// Pick the nodes of tasks that make the same request. Only the hybrid policy
+  /// supports it, see HybridSchedulingPolicy::ScheduleBatch.
+  std::vector<scheduling::NodeID> ScheduleBatch(const ResourceRequest &resource_request,
+                                                const SchedulingOptions &options,
+                                                size_t num_tasks);
+
  private:
   HybridSchedulingPolicy hybrid_policy_;
   RandomSchedulingPolicy random_policy_;
@@ -14,8 +14,12 @@
 
 #include "ray/raylet/scheduling/policy/hybrid_scheduling_policy.h"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
+#include <tuple>
 
+#include "absl/container/btree_set.h"
 #include "ray/util/container_util.h"
 #include "ray/util/util.h"
 
@@ -44,22 +48,24 @@ bool HybridSchedulingPolicy::IsNodeFeasible(
   return node_resources.IsFeasible(resource_request);
 }
 
-namespace {
-float ComputeNodeScoreImpl(const NodeResources &node_resources, float spread_threshold) {
-  float critical_resource_utilization =
-      node_resources.CalculateCriticalResourceUtilization();
-  if (critical_resource_utilization < spread_threshold) {
-    critical_resource_utilization = 0;
+float HybridSchedulingPolicy::ComputeNodeScore(
+    const scheduling::NodeID &node_id,
+    float spread_threshold,
+    const ArgumentLocalityScorer *locality_scorer) const {
+  float node_score;
+  if (node_score_index_ != nullptr) {
+    node_score = ComputeHybridNodeScore(node_score_index_->GetUtilization(node_id),
+                                        spread_threshold);
+  } else {
+    const auto local_it = nodes_.find(node_id);
+    RAY_CHECK(local_it != nodes_.end());
+    node_score =
+        ComputeHybridNodeScore(local_it->second.GetLocalView(), spread_threshold);
   }
-  return critical_resource_utilization;
-}
-}  // namespace
-
-float HybridSchedulingPolicy::ComputeNodeScore(const scheduling::NodeID &node_id,
-                                               float spread_threshold) const {
-  const auto local_it = nodes_.find(node_id);
-  RAY_CHECK(local_it != nodes_.end());
-  return ComputeNodeScoreImpl(local_it->second.GetLocalView(), spread_threshold);
+  if (locality_scorer != nullptr) {
+    node_score = locality_scorer->ScoreUtilization(node_id, node_score);
+  }
+  return node_score;
 }
 
 scheduling::NodeID HybridSchedulingPolicy::GetBestNode(
@@ -69,20 +75,17 @@ scheduling::NodeID HybridSchedulingPolicy::GetBestNode(
     float preferred_node_score) const {
   RAY_CHECK(!node_scores.empty());
   RAY_CHECK(num_candidate_nodes >= 1);
-  // Pick the top num_candidate_nodes nodes with the lowest score.
-  // First, sort nodes by id so that we always break ties between nodes in the same
-  // order.
-  std::sort(
-      node_scores.begin(),
-      node_scores.end(),
-      [](const std::pair<scheduling::NodeID, float> &a,
-         const std::pair<scheduling::NodeID, float> &b) { return a.first < b.first; });
-  // Then sort nodes by scores and preserve the order of equivalent elements.
-  std::stable_sort(
+  // Pick the top num_candidate_nodes nodes with the lowest score. Ties are broken by
+  // node id so that we always pick between nodes of the same score in the same order.
+  num_candidate_nodes = std::min(num_candidate_nodes, node_scores.size());
+  std::partial_sort(
       node_scores.begin(),
+      node_scores.begin() + num_candidate_nodes,
       node_scores.end(),
       [](const std::pair<scheduling::NodeID, float> &a,
-         const std::pair<scheduling::NodeID, float> &b) { return a.second < b.second; });
+         const std::pair<scheduling::NodeID, float> &b) {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+      });
 
   // If prioritize local node, always pick local node is it has the minimal
   // score across all candidates.
@@ -91,8 +94,7 @@ scheduling::NodeID HybridSchedulingPolicy::GetBestNode(
       return preferred_node_id.value();
     }
   }
-  size_t node_index = absl::Uniform<size_t>(
-      bitgenref_, 0u, std::min(num_candidate_nodes, node_scores.size()));
+  size_t node_index = absl::Uniform<size_t>(bitgenref_, 0u, num_candidate_nodes);
   return node_scores[node_index].first;
 }
 
@@ -104,7 +106,8 @@ scheduling::NodeID HybridSchedulingPolicy::ScheduleImpl(
     NodeFilter node_filter,
     const std::string &preferred_node,
     int32_t schedule_top_k_absolute,
-    float scheduler_top_k_fraction) {
+    float scheduler_top_k_fraction,
+    const ArgumentLocalityScorer *locality_scorer) {
   // Nodes that are feasible and currently have available resources.
   std::vector<std::pair<scheduling::NodeID, float>> available_nodes;
   // Nodes that are feasible but currently do not have available resources.
@@ -120,45 +123,92 @@ scheduling::NodeID HybridSchedulingPolicy::ScheduleImpl(
       preferred_node_id = new_id;
     }
   }
-  for (const auto &pair : nodes_) {
-    const auto &node_id = pair.first;
-    const auto &node_resources = pair.second.GetLocalView();
+  auto add_node = [&](const scheduling::NodeID &node_id,
+                      const NodeResources &node_resources,
+                      float node_score) {
     if (force_spillback && node_id == preferred_node_id) {
-      continue;
+      return;
     }
-    if (IsNodeFeasible(node_id, node_filter, node_resources, resource_request)) {
-      bool ignore_pull_manager_at_capacity = false;
-      if (node_id == preferred_node_id) {
-        // It's okay if the local node's pull manager is at
-        // capacity because we will eventually spill the task
-        // back from the waiting queue if its args cannot be
-        // pulled.
-        ignore_pull_manager_at_capacity = true;
-        preferred_node_is_feasible = true;
-      }
-      bool is_available =
-          node_resources.IsAvailable(resource_request, ignore_pull_manager_at_capacity);
-      if (node_id == preferred_node_id && is_available) {
-        preferred_node_is_available = true;
-      }
-      float node_score = ComputeNodeScoreImpl(node_resources, spread_threshold);
-      RAY_LOG(DEBUG) << "Node " << node_id.ToInt() << " is "
-                     << (is_available ? "available" : "not available") << " for request "
-                     << resource_request.DebugString()
-                     << " with critical resource utilization " << node_score
-                     << " based on local view " << node_resources.DebugString();
-      if (is_available) {
-        available_nodes.push_back({node_id, node_score});
-      } else {
-        feasible_and_unavailable_nodes.push_back({node_id, node_score});
-      }
+    if (!IsNodeFeasible(node_id, node_filter, node_resources, resource_request)) {
+      return;
     }
-  }
+    bool ignore_pull_manager_at_capacity = false;
+    if (node_id == preferred_node_id) {
+      // It's okay if the local node's pull manager is at
+      // capacity because we will eventually spill the task
+      // back from the waiting queue if its args cannot be
+      // pulled.
+      ignore_pull_manager_at_capacity = true;
+      preferred_node_is_feasible = true;
+    }
+    bool is_available =
+        node_resources.IsAvailable(resource_request, ignore_pull_manager_at_capacity);
+    if (node_id == preferred_node_id && is_available) {
+      preferred_node_is_available = true;
+    }
+    RAY_LOG(DEBUG) << "Node " << node_id.ToInt() << " is "
+                   << (is_available ? "available" : "not available") << " for request "
+                   << resource_request.DebugString()
+                   << " with critical resource utilization " << node_score
+                   << " based on local view " << node_resources.DebugString();
+    if (is_available) {
+      available_nodes.push_back({node_id, node_score});
+    } else {
+      feasible_and_unavailable_nodes.push_back({node_id, node_score});
+    }
+  };
 
   size_t num_candidate_nodes =
       std::max<int32_t>(schedule_top_k_absolute,
                         static_cast<int32_t>(nodes_.size() * scheduler_top_k_fraction));
 
+  // The index orders the nodes by utilization only, so it can't be used when the
+  // locality of the arguments is part of the score.
+  if (node_score_index_ != nullptr && locality_scorer == nullptr &&
+      node_score_index_->SpreadThreshold() == spread_threshold) {
+    RAY_DCHECK(node_score_index_->Size() == nodes_.size());
+    // Visit the nodes from the lowest score. Once we have found num_candidate_nodes
+    // available nodes, the remaining nodes can't be among the top ones.
+    bool visited_preferred_node = false;
+    for (const auto &[node_score, node_id] : node_score_index_->GetOrderedNodes()) {
+      if (available_nodes.size() >= num_candidate_nodes) {
+        break;
+      }
+      visited_preferred_node = visited_preferred_node || node_id == preferred_node_id;
+      add_node(node_id, map_find_or_die(nodes_, node_id).GetLocalView(), node_score);
+    }
+    // We still need to know whether the preferred node is available. It ranks after
+    // all the visited nodes, so adding it doesn't change the top nodes.
+    auto preferred_it = nodes_.find(preferred_node_id);
+    if (!visited_preferred_node && preferred_it != nodes_.end()) {
+      add_node(preferred_node_id,
+               preferred_it->second.GetLocalView(),
+               ComputeNodeScore(preferred_node_id, spread_threshold, locality_scorer));
+    }
+  } else if (node_score_index_ != nullptr) {
+    RAY_DCHECK(node_score_index_->Size() == nodes_.size());
+    // Score the nodes from their cached utilization.
+    const auto &node_ids = node_score_index_->GetNodeIds();
+    const auto &utilizations = node_score_index_->GetUtilizations();
+    for (size_t i = 0; i < node_ids.size(); i++) {
+      float node_score = ComputeHybridNodeScore(utilizations[i], spread_threshold);
+      if (locality_scorer != nullptr) {
+        node_score = locality_scorer->ScoreUtilization(node_ids[i], node_score);
+      }
+      add_node(
+          node_ids[i], map_find_or_die(nodes_, node_ids[i]).GetLocalView(), node_score);
+    }
+  } else {
+    for (const auto &pair : nodes_) {
+      const auto &node_resources = pair.second.GetLocalView();
+      float node_score = ComputeHybridNodeScore(node_resources, spread_threshold);
+      if (locality_scorer != nullptr) {
+        node_score = locality_scorer->ScoreUtilization(pair.first, node_score);
+      }
+      add_node(pair.first, node_resources, node_score);
+    }
+  }
+
   if (!available_nodes.empty()) {
     bool prioritize_preferred_node = !force_spillback && preferred_node_is_available;
     // First prioritize available nodes.
@@ -167,7 +217,8 @@ scheduling::NodeID HybridSchedulingPolicy::ScheduleImpl(
                        prioritize_preferred_node
                            ? std::optional<scheduling::NodeID>(preferred_node_id)
                            : std::optional<scheduling::NodeID>(),
-                       ComputeNodeScore(preferred_node_id, spread_threshold));
+                       ComputeNodeScore(
+                           preferred_node_id, spread_threshold, locality_scorer));
   } else if (!feasible_and_unavailable_nodes.empty() && !require_node_available) {
     bool prioritize_preferred_node = !force_spillback && preferred_node_is_feasible;
     // If there are no available nodes, and the caller is okay with an
@@ -177,16 +228,177 @@ scheduling::NodeID HybridSchedulingPolicy::ScheduleImpl(
                        prioritize_preferred_node
                            ? std::optional<scheduling::NodeID>(preferred_node_id)
                            : std::optional<scheduling::NodeID>(),
-                       ComputeNodeScore(preferred_node_id, spread_threshold));
+                       ComputeNodeScore(
+                           preferred_node_id, spread_threshold, locality_scorer));
   } else {
     return scheduling::NodeID::Nil();
   }
 }
 
+std::vector<scheduling::NodeID> HybridSchedulingPolicy::ScheduleBatch(
+    const ResourceRequest &resource_request,
+    const SchedulingOptions &options,
+    size_t num_tasks) {
+  RAY_CHECK(options.scheduling_type == SchedulingType::HYBRID)
+      << "HybridPolicy policy requires type = HYBRID";
+  RAY_CHECK(options.scheduling_context == nullptr)
+      << "Tasks with a scheduling context can't share a scheduling decision";
+  const float spread_threshold = options.spread_threshold;
+  const bool force_spillback = options.avoid_local_node;
+  scheduling::NodeID preferred_node_id = local_node_id_;
+  if (!options.preferred_node_id.empty()) {
+    auto new_id = scheduling::NodeID(options.preferred_node_id);
+    if (nodes_.contains(new_id)) {
+      preferred_node_id = new_id;
+    }
+  }
+  size_t num_candidate_nodes =
+      std::max<int32_t>(options.schedule_top_k_absolute,
+                        static_cast<int32_t>(nodes_.size() *
+                                             options.scheduler_top_k_fraction));
+
+  // The local views of the nodes that tasks were placed on, with the requests of
+  // these tasks taken from their available resources. The other nodes are read from
+  // the cluster view, and scored from the node score index if there is one.
+  absl::flat_hash_map<scheduling::NodeID, NodeResources> placed_views;
+  auto get_view = [&](scheduling::NodeID node_id) -> const NodeResources & {
+    auto it = placed_views.find(node_id);
+    return it != placed_views.end() ? it->second
+                                    : map_find_or_die(nodes_, node_id).GetLocalView();
+  };
+  auto get_score = [&](scheduling::NodeID node_id) {
+    auto it = placed_views.find(node_id);
+    return it != placed_views.end()
+               ? ComputeHybridNodeScore(it->second, spread_threshold)
+               : ComputeNodeScore(node_id, spread_threshold, nullptr);
+  };
+  auto is_available = [&](scheduling::NodeID node_id) {
+    return get_view(node_id).IsAvailable(
+        resource_request,
+        /*ignore_pull_manager_at_capacity*/ node_id == preferred_node_id);
+  };
+  // Schedule only falls back to the nodes with GPUs when no node without GPUs is
+  // available, if the request doesn't need GPUs. So the nodes are ranked by this tier
+  // first, and a task only picks among the available nodes of the best tier.
+  const bool avoid_gpu_nodes =
+      options.avoid_gpu_nodes && !resource_request.Has(ResourceID::GPU());
+  auto get_tier = [&](scheduling::NodeID node_id) {
+    return avoid_gpu_nodes &&
+           map_find_or_die(nodes_, node_id).GetLocalView().total.Has(ResourceID::GPU());
+  };
+
+  // Take the request of a task placed on a node from the available resources of the
+  // node, as SubtractNodeAvailableResources does for a spilled task.
+  auto take_resources = [&](scheduling::NodeID node_id) {
+    auto it = placed_views.find(node_id);
+    if (it == placed_views.end()) {
+      it = placed_views.emplace(node_id, map_find_or_die(nodes_, node_id).GetLocalView())
+               .first;
+    }
+    it->second.available -= resource_request.GetResourceSet();
+    it->second.available.RemoveNegative();
+  };
+
+  // Score all the feasible nodes once.
+  using RankedNode = std::tuple<bool, float, scheduling::NodeID>;
+  absl::btree_set<RankedNode> available_nodes;
+  std::vector<scheduling::NodeID> feasible_nodes;
+  for (const auto &[node_id, node] : nodes_) {
+    if (force_spillback && node_id == preferred_node_id) {
+      continue;
+    }
+    if (!IsNodeFeasible(
+            node_id, NodeFilter::kAny, node.GetLocalView(), resource_request)) {
+      continue;
+    }
+    feasible_nodes.push_back(node_id);
+    if (is_available(node_id)) {
+      available_nodes.emplace(get_tier(node_id), get_score(node_id), node_id);
+    }
+  }
+
+  std::vector<scheduling::NodeID> best_nodes;
+  best_nodes.reserve(num_tasks);
+  while (best_nodes.size() < num_tasks && !available_nodes.empty()) {
+    RankedNode best = *available_nodes.begin();
+    // As in GetBestNode, the preferred node wins if no node has a lower score.
+    RankedNode preferred = {
+        get_tier(preferred_node_id), get_score(preferred_node_id), preferred_node_id};
+    if (!force_spillback && std::get<0>(preferred) == std::get<0>(best) &&
+        std::get<1>(preferred) <= std::get<1>(best) &&
+        available_nodes.contains(preferred)) {
+      best = preferred;
+    } else {
+      size_t num_top_nodes = 0;
+      for (auto it = available_nodes.begin();
+           it != available_nodes.end() && num_top_nodes < num_candidate_nodes &&
+           std::get<0>(*it) == std::get<0>(best);
+           it++) {
+        num_top_nodes++;
+      }
+      auto it = available_nodes.begin();
+      std::advance(it, absl::Uniform<size_t>(bitgenref_, 0u, num_top_nodes));
+      best = *it;
+    }
+    const scheduling::NodeID node_id = std::get<2>(best);
+    best_nodes.push_back(node_id);
+    if (node_id == local_node_id_) {
+      continue;
+    }
+    available_nodes.erase(best);
+    take_resources(node_id);
+    if (is_available(node_id)) {
+      available_nodes.emplace(std::get<0>(best), get_score(node_id), node_id);
+    }
+  }
+
+  if (best_nodes.size() < num_tasks && !options.require_node_available) {
+    // No node is available for the rest of the tasks, so they pick among the top
+    // feasible nodes, as GetBestNode would.
+    absl::btree_set<std::pair<float, scheduling::NodeID>> ranked_nodes;
+    bool preferred_node_is_feasible = false;
+    for (const auto &node_id : feasible_nodes) {
+      ranked_nodes.emplace(get_score(node_id), node_id);
+      preferred_node_is_feasible |= node_id == preferred_node_id;
+    }
+    const bool prioritize_preferred_node = !force_spillback && preferred_node_is_feasible;
+    while (best_nodes.size() < num_tasks && !ranked_nodes.empty()) {
+      std::pair<float, scheduling::NodeID> best = *ranked_nodes.begin();
+      const float preferred_node_score = get_score(preferred_node_id);
+      if (prioritize_preferred_node && preferred_node_score <= best.first) {
+        best = {preferred_node_score, preferred_node_id};
+      } else {
+        const size_t num_top_nodes = std::min(num_candidate_nodes, ranked_nodes.size());
+        auto it = ranked_nodes.begin();
+        std::advance(it, absl::Uniform<size_t>(bitgenref_, 0u, num_top_nodes));
+        best = *it;
+      }
+      best_nodes.push_back(best.second);
+      if (best.second == local_node_id_) {
+        continue;
+      }
+      ranked_nodes.erase(best);
+      take_resources(best.second);
+      ranked_nodes.emplace(get_score(best.second), best.second);
+    }
+  }
+  return best_nodes;
+}
+
 scheduling::NodeID HybridSchedulingPolicy::Schedule(
     const ResourceRequest &resource_request, SchedulingOptions options) {
   RAY_CHECK(options.scheduling_type == SchedulingType::HYBRID)
       << "HybridPolicy policy requires type = HYBRID";
+  std::optional<ArgumentLocalityScorer> locality_scorer;
+  const auto *locality = dynamic_cast<const ArgumentLocalitySchedulingContext *>(
+      options.scheduling_context.get());
+  const float locality_weight = RayConfig::instance().scheduler_locality_weight();
+  if (locality != nullptr && locality_weight > 0) {
+    locality_scorer.emplace(
+        *locality, std::min(locality_weight, 1.0f), options.spread_threshold);
+  }
+  const ArgumentLocalityScorer *locality_scorer_ptr =
+      locality_scorer.has_value() ? &locality_scorer.value() : nullptr;
   if (!options.avoid_gpu_nodes || resource_request.Has(ResourceID::GPU())) {
     return ScheduleImpl(resource_request,
                         options.spread_threshold,
@@ -195,7 +407,8 @@ scheduling::NodeID HybridSchedulingPolicy::Schedule(
                         NodeFilter::kAny,
                         options.preferred_node_id,
                         options.schedule_top_k_absolute,
-                        options.scheduler_top_k_fraction);
+                        options.scheduler_top_k_fraction,
+                        locality_scorer_ptr);
   }
 
   // Try schedule on non-GPU nodes.
@@ -206,7 +419,8 @@ scheduling::NodeID HybridSchedulingPolicy::Schedule(
                                    NodeFilter::kNonGpu,
                                    options.preferred_node_id,
                                    options.schedule_top_k_absolute,
-                                   options.scheduler_top_k_fraction);
+                                   options.scheduler_top_k_fraction,
+                                   locality_scorer_ptr);
   if (!best_node_id.IsNil()) {
     return best_node_id;
   }
@@ -220,7 +434,8 @@ scheduling::NodeID HybridSchedulingPolicy::Schedule(
                       NodeFilter::kAny,
                       options.preferred_node_id,
                       options.schedule_top_k_absolute,
-                      options.scheduler_top_k_fraction);
+                      options.scheduler_top_k_fraction,
+                      locality_scorer_ptr);
 }
 
 }  // namespace raylet_scheduling_policy
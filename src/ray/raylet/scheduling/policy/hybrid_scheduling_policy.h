@@ -21,7 +21,9 @@
 
 #include "absl/random/bit_gen_ref.h"
 #include "absl/random/random.h"
+#include "ray/raylet/scheduling/node_score_index.h"
 #include "ray/raylet/scheduling/policy/scheduling_policy.h"
+#include "ray/raylet/scheduling/policy/scorer.h"
 
 namespace ray {
 namespace raylet_scheduling_policy {
@@ -46,21 +48,50 @@ namespace raylet_scheduling_policy {
 ///   * Always prefer available nodes over feasible nodes.
 ///   * Break ties in available/feasible by critical resource utilization.
 ///   * Critical resource utilization below a threshold should be truncated to 0.
+///   * If the options carry the locations of the task's arguments, blend the
+///     utilization with the fraction of argument bytes already on the node (see
+///     ArgumentLocalityScorer).
+///
+/// If a NodeScoreIndex of the nodes is given and it was built with the spread
+/// threshold of the request, the policy visits the nodes in the order of the index
+/// and stops once it has found the top k available nodes, instead of scoring and
+/// sorting all the nodes. Otherwise it still scores all the nodes, but reads their
+/// utilization from the index rather than computing it from their resources.
 ///
 class HybridSchedulingPolicy : public ISchedulingPolicy {
  public:
   HybridSchedulingPolicy(scheduling::NodeID local_node_id,
                          const absl::flat_hash_map<scheduling::NodeID, Node> &nodes,
-                         std::function<bool(scheduling::NodeID)> is_node_alive)
+                         std::function<bool(scheduling::NodeID)> is_node_alive,
+                         const NodeScoreIndex *node_score_index = nullptr)
       : local_node_id_(local_node_id),
         nodes_(nodes),
         is_node_alive_(is_node_alive),
+        node_score_index_(node_score_index),
         bitgen_(),
         bitgenref_(bitgen_) {}
 
   scheduling::NodeID Schedule(const ResourceRequest &resource_request,
                               SchedulingOptions options) override;
 
+  /// Pick the nodes of tasks that make the same request, in one pass over the nodes.
+  /// Each task gets a node as Schedule would pick it, if the request of every previous
+  /// task had been taken from the available resources of its node. Tasks placed on
+  /// the local node don't take its resources, since they only queue there until they
+  /// are dispatched.
+  ///
+  /// \param resource_request: The resource request of each task.
+  /// \param options: The scheduling options of each task. They must not carry a
+  /// scheduling context.
+  /// \param num_tasks: The number of tasks.
+  ///
+  /// \return The node of each task, in order. It has fewer than num_tasks entries if
+  /// the options require an available node and the nodes ran out of resources, and
+  /// none if no node is feasible.
+  std::vector<scheduling::NodeID> ScheduleBatch(const ResourceRequest &resource_request,
+                                                const SchedulingOptions &options,
+                                                size_t num_tasks);
+
  private:
   enum class NodeFilter {
     /// Default scheduling.
@@ -82,8 +113,12 @@ class HybridSchedulingPolicy : public ISchedulingPolicy {
   /// helper function compute a score between 0-1 indicates
   /// the preference of the node (the lower score,
   /// the more preferable.
-  float ComputeNodeScore(const scheduling::NodeID &node_id, float spread_threshold) const;
+  float ComputeNodeScore(const scheduling::NodeID &node_id,
+                         float spread_threshold,
+                         const ArgumentLocalityScorer *locality_scorer) const;
 
+  /// Pick a node among the top num_candidate_nodes nodes with the lowest score,
+  /// breaking ties by node ID. Only these nodes are sorted.
   scheduling::NodeID GetBestNode(
       std::vector<std::pair<scheduling::NodeID, float>> &node_scores,
       size_t num_candidate_nodes,
@@ -111,6 +146,8 @@ class HybridSchedulingPolicy : public ISchedulingPolicy {
   /// one node from the top k in the cluster to improve load balancing. The
   /// scheduler guarantees k is at least equal to this fraction * the number of
   /// nodes in the cluster.
+  /// \param locality_scorer: If not null, blends the score of each node with the
+  /// locality of the task's arguments.
   ///
   /// \return -1 if the task is unfeasible, otherwise the node id (key in `nodes`) to
   /// schedule on.
@@ -121,7 +158,8 @@ class HybridSchedulingPolicy : public ISchedulingPolicy {
                                   NodeFilter node_filter,
                                   const std::string &preferred_node,
                                   int32_t schedule_top_k_absolute,
-                                  float scheduler_top_k_fraction);
+                                  float scheduler_top_k_fraction,
+                                  const ArgumentLocalityScorer *locality_scorer);
 
   /// Identifier of local node.
   const scheduling::NodeID local_node_id_;
@@ -130,6 +168,9 @@ class HybridSchedulingPolicy : public ISchedulingPolicy {
   const absl::flat_hash_map<scheduling::NodeID, Node> &nodes_;
   /// Function Checks if node is alive.
   std::function<bool(scheduling::NodeID)> is_node_alive_;
+  /// The nodes ordered by score with their cached utilization, or nullptr to compute
+  /// the score of all the nodes from their resources for each request.
+  const NodeScoreIndex *node_score_index_;
   /// Random number generator to choose a random node out of the top K.
   mutable absl::BitGen bitgen_;
   /// Using BitGenRef to simplify testing.
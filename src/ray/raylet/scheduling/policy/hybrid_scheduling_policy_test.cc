@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+
 #include "absl/random/mock_distributions.h"
 #include "absl/random/mocking_bit_gen.h"
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ray/raylet/scheduling/policy/composite_scheduling_policy.h"
@@ -68,6 +71,16 @@ class HybridSchedulingPolicyTest : public ::testing::Test {
                              schedule_top_k_absolute,
                              scheduler_top_k_fraction);
   }
+
+  std::unique_ptr<ClusterResourceManager> MockClusterResourceManager(
+      const absl::flat_hash_map<scheduling::NodeID, Node> &nodes) {
+    static instrumented_io_context io_context;
+    auto cluster_resource_manager = std::make_unique<ClusterResourceManager>(io_context);
+    for (const auto &[node_id, node] : nodes) {
+      cluster_resource_manager->AddOrUpdateNode(node_id, node.GetLocalView());
+    }
+    return cluster_resource_manager;
+  }
 };
 
 TEST_F(HybridSchedulingPolicyTest, GetBestNode) {
@@ -147,6 +160,313 @@ TEST_F(HybridSchedulingPolicyTest, GetBestNodePrioritizePreferredNode) {
   }
 }
 
+TEST_F(HybridSchedulingPolicyTest, IndexedScheduleMatchesFullScan) {
+  // Nodes with utilizations below and above the spread threshold, some of them with
+  // GPUs, and some of them dead.
+  for (int i = 0; i < 100; i++) {
+    nodes.emplace(scheduling::NodeID(i),
+                  CreateNodeResources(i % 9, 8, 0, 0, i % 5 == 0 ? 1 : 0, 1));
+  }
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+  auto is_node_alive = [](scheduling::NodeID node_id) {
+    return node_id.ToInt() % 7 != 3;
+  };
+  HybridSchedulingPolicy indexed_policy(local_node,
+                                        cluster_resource_manager->GetResourceView(),
+                                        is_node_alive,
+                                        &cluster_resource_manager->GetNodeScoreIndex());
+  HybridSchedulingPolicy full_scan_policy(
+      local_node, cluster_resource_manager->GetResourceView(), is_node_alive);
+
+  // Schedule until the cluster is full. With a single candidate node, both policies
+  // must pick the same node for every request.
+  for (int i = 0; i < 500; i++) {
+    auto request = ResourceMapToResourceRequest(
+        {{"CPU", 1 + i % 3}, {"GPU", i % 10 == 0 ? 1 : 0}}, false);
+    auto options = HybridOptions(0.5,
+                                 /*avoid_local_node=*/i % 2 == 0,
+                                 /*require_node_available=*/i % 3 == 0,
+                                 /*avoid_gpu_nodes=*/i % 4 == 0,
+                                 /*schedule_top_k_absolute=*/1,
+                                 /*scheduler_top_k_fraction=*/0);
+    auto node_id = indexed_policy.Schedule(request, options);
+    ASSERT_EQ(node_id, full_scan_policy.Schedule(request, options));
+    if (!node_id.IsNil()) {
+      cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+    }
+  }
+}
+
+TEST_F(HybridSchedulingPolicyTest, ScheduleBatchMatchesSchedule) {
+  // Nodes with utilizations below and above the spread threshold, some of them with
+  // GPUs, and some of them dead. The local node has no available CPU.
+  for (int i = 0; i < 50; i++) {
+    nodes.emplace(scheduling::NodeID(i),
+                  CreateNodeResources(i % 9, 8, 0, 0, i % 5 == 0 ? 1 : 0, 1));
+  }
+  auto is_node_alive = [](scheduling::NodeID node_id) {
+    return node_id.ToInt() % 7 != 3;
+  };
+  for (int i = 0; i < 16; i++) {
+    auto request = ResourceMapToResourceRequest(
+        {{"CPU", 1 + i % 3}, {"GPU", i % 8 == 0 ? 1 : 0}}, false);
+    auto options = HybridOptions(0.5,
+                                 /*avoid_local_node=*/i % 2 == 0,
+                                 /*require_node_available=*/i % 4 < 2,
+                                 /*avoid_gpu_nodes=*/i % 8 < 4,
+                                 /*schedule_top_k_absolute=*/1,
+                                 /*scheduler_top_k_fraction=*/0);
+    auto batch_cluster_resource_manager = MockClusterResourceManager(nodes);
+    HybridSchedulingPolicy batch_policy(
+        local_node,
+        batch_cluster_resource_manager->GetResourceView(),
+        is_node_alive,
+        &batch_cluster_resource_manager->GetNodeScoreIndex());
+    auto best_nodes = batch_policy.ScheduleBatch(request, options, 200);
+
+    // Schedule the tasks one at a time, taking the resources of those placed on a
+    // remote node. With a single candidate node, both must pick the same nodes.
+    auto cluster_resource_manager = MockClusterResourceManager(nodes);
+    HybridSchedulingPolicy policy(local_node,
+                                  cluster_resource_manager->GetResourceView(),
+                                  is_node_alive,
+                                  &cluster_resource_manager->GetNodeScoreIndex());
+    std::vector<scheduling::NodeID> expected_nodes;
+    while (expected_nodes.size() < 200) {
+      auto node_id = policy.Schedule(request, options);
+      if (node_id.IsNil()) {
+        break;
+      }
+      expected_nodes.push_back(node_id);
+      if (node_id != local_node) {
+        cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+      }
+    }
+    ASSERT_EQ(best_nodes, expected_nodes) << "request " << i;
+    // The cluster view is not modified.
+    for (const auto &[node_id, node] : nodes) {
+      ASSERT_EQ(batch_cluster_resource_manager->GetNodeResources(node_id),
+                node.GetLocalView());
+    }
+  }
+}
+
+TEST_F(HybridSchedulingPolicyTest, ArgumentLocality) {
+  RayConfig::instance().initialize(R"({"scheduler_locality_weight": 0.5})");
+  nodes.emplace(local_node, CreateNodeResources(8, 8, 0, 0, 0, 0));
+  nodes.emplace(n1, CreateNodeResources(8, 8, 0, 0, 0, 0));
+  nodes.emplace(n2, CreateNodeResources(8, 8, 0, 0, 0, 0));
+  nodes.emplace(n3, CreateNodeResources(0, 8, 0, 0, 0, 0));
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+  HybridSchedulingPolicy policy(
+      local_node, cluster_resource_manager->GetResourceView(), [](auto) {
+        return true;
+      });
+  auto request = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+
+  // All the remote nodes are idle, so ties are broken by node id.
+  auto options = HybridOptions(0.5,
+                               /*avoid_local_node=*/true,
+                               /*require_node_available=*/false);
+  ASSERT_EQ(policy.Schedule(request, options), n1);
+
+  // The node that holds most of the argument bytes wins among idle nodes.
+  options.scheduling_context = std::make_shared<ArgumentLocalitySchedulingContext>(
+      absl::flat_hash_map<scheduling::NodeID, int64_t>{{n1, 10}, {n2, 90}}, 100);
+  ASSERT_EQ(policy.Schedule(request, options), n2);
+
+  // Available nodes are still preferred over nodes holding the arguments.
+  options.scheduling_context = std::make_shared<ArgumentLocalitySchedulingContext>(
+      absl::flat_hash_map<scheduling::NodeID, int64_t>{{n1, 10}, {n3, 90}}, 100);
+  ASSERT_EQ(policy.Schedule(request, options), n1);
+
+  // Locality is ignored when its weight is 0.
+  RayConfig::instance().initialize(R"({"scheduler_locality_weight": 0})");
+  options.scheduling_context = std::make_shared<ArgumentLocalitySchedulingContext>(
+      absl::flat_hash_map<scheduling::NodeID, int64_t>{{n2, 100}}, 100);
+  ASSERT_EQ(policy.Schedule(request, options), n1);
+}
+
+// Measures the throughput of hybrid scheduling decisions with and without the node
+// score index, for clusters of different sizes. We disable it by default.
+TEST_F(HybridSchedulingPolicyTest, DISABLED_ScheduleThroughputPerf) {
+  const int kNumDecisions = 10 * 1000;
+  auto request = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  auto options = HybridOptions(0.5,
+                               /*avoid_local_node=*/false,
+                               /*require_node_available=*/false,
+                               /*avoid_gpu_nodes=*/false,
+                               RayConfig::instance().scheduler_top_k_absolute(),
+                               RayConfig::instance().scheduler_top_k_fraction());
+  for (int num_nodes : {100, 1000, 10000}) {
+    nodes.clear();
+    for (int i = 0; i < num_nodes; i++) {
+      nodes.emplace(scheduling::NodeID(i), CreateNodeResources(i % 17, 16, 0, 0, 0, 0));
+    }
+    for (bool use_index : {false, true}) {
+      auto cluster_resource_manager = MockClusterResourceManager(nodes);
+      HybridSchedulingPolicy policy(
+          local_node,
+          cluster_resource_manager->GetResourceView(),
+          [](auto) { return true; },
+          use_index ? &cluster_resource_manager->GetNodeScoreIndex() : nullptr);
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kNumDecisions; i++) {
+        auto node_id = policy.Schedule(request, options);
+        // Allocate the resources and release them, so that the score of the node
+        // changes twice per decision.
+        cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+        cluster_resource_manager->AddNodeAvailableResources(node_id,
+                                                            request.GetResourceSet());
+      }
+      double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+      RAY_LOG(INFO) << num_nodes << " nodes, " << (use_index ? "indexed" : "full scan")
+                    << ": " << kNumDecisions / duration_s << " decisions/s";
+    }
+  }
+}
+
+// Measures the throughput of indexed hybrid scheduling decisions for tasks whose
+// arguments live on a few nodes, with the locality weight at 0 and above 0. A weight
+// above 0 makes every such decision score all the nodes instead of using the node
+// score index, which is why it defaults to 0. We disable it by default.
+TEST_F(HybridSchedulingPolicyTest, DISABLED_ArgumentLocalityPerf) {
+  const int kNumDecisions = 1000;
+  auto request = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  auto options = HybridOptions(0.5,
+                               /*avoid_local_node=*/false,
+                               /*require_node_available=*/false,
+                               /*avoid_gpu_nodes=*/false,
+                               RayConfig::instance().scheduler_top_k_absolute(),
+                               RayConfig::instance().scheduler_top_k_fraction());
+  for (int num_nodes : {100, 1000, 10000}) {
+    nodes.clear();
+    for (int i = 0; i < num_nodes; i++) {
+      nodes.emplace(scheduling::NodeID(i), CreateNodeResources(i % 17, 16, 0, 0, 0, 0));
+    }
+    options.scheduling_context = std::make_shared<ArgumentLocalitySchedulingContext>(
+        absl::flat_hash_map<scheduling::NodeID, int64_t>{
+            {scheduling::NodeID(1), 30}, {scheduling::NodeID(num_nodes / 2), 70}},
+        100);
+    for (const char *weight : {"0", "0.5"}) {
+      RayConfig::instance().initialize(
+          absl::StrCat(R"({"scheduler_locality_weight": )", weight, "}"));
+      auto cluster_resource_manager = MockClusterResourceManager(nodes);
+      HybridSchedulingPolicy policy(
+          local_node,
+          cluster_resource_manager->GetResourceView(),
+          [](auto) { return true; },
+          &cluster_resource_manager->GetNodeScoreIndex());
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kNumDecisions; i++) {
+        auto node_id = policy.Schedule(request, options);
+        cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+        cluster_resource_manager->AddNodeAvailableResources(node_id,
+                                                            request.GetResourceSet());
+      }
+      double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+      RAY_LOG(INFO) << num_nodes << " nodes, locality weight " << weight << ": "
+                    << kNumDecisions / duration_s << " decisions/s";
+    }
+  }
+  RayConfig::instance().initialize(R"({"scheduler_locality_weight": 0})");
+}
+
+// Measures the throughput of hybrid scheduling decisions that score all the nodes,
+// because the request's spread threshold isn't the one of the node score index, with
+// and without the utilization cached by the index. We disable it by default.
+TEST_F(HybridSchedulingPolicyTest, DISABLED_CachedUtilizationPerf) {
+  const int kNumDecisions = 1000;
+  auto request = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  auto options = HybridOptions(0.5,
+                               /*avoid_local_node=*/false,
+                               /*require_node_available=*/false,
+                               /*avoid_gpu_nodes=*/false,
+                               RayConfig::instance().scheduler_top_k_absolute(),
+                               RayConfig::instance().scheduler_top_k_fraction());
+  options.spread_threshold = 0.3;
+  for (int num_nodes : {100, 1000, 10000}) {
+    nodes.clear();
+    for (int i = 0; i < num_nodes; i++) {
+      auto resources = CreateNodeResources(i % 17, 16, 64, 64, 0, 0);
+      resources.total.Set(ResourceID::ObjectStoreMemory(), 32);
+      resources.available.Set(ResourceID::ObjectStoreMemory(), 30);
+      nodes.emplace(scheduling::NodeID(i), resources);
+    }
+    for (bool use_cache : {false, true}) {
+      auto cluster_resource_manager = MockClusterResourceManager(nodes);
+      HybridSchedulingPolicy policy(
+          local_node,
+          cluster_resource_manager->GetResourceView(),
+          [](auto) { return true; },
+          use_cache ? &cluster_resource_manager->GetNodeScoreIndex() : nullptr);
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < kNumDecisions; i++) {
+        auto node_id = policy.Schedule(request, options);
+        cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+        cluster_resource_manager->AddNodeAvailableResources(node_id,
+                                                            request.GetResourceSet());
+      }
+      double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+      RAY_LOG(INFO) << num_nodes << " nodes, "
+                    << (use_cache ? "cached utilization" : "computed utilization")
+                    << ": " << kNumDecisions / duration_s << " decisions/s";
+    }
+  }
+}
+
+// Measures the time to place a burst of tasks with one ScheduleBatch call, and with a
+// Schedule call per task that takes the resources of the task from its node like a
+// spillback does. We disable it by default.
+TEST_F(HybridSchedulingPolicyTest, DISABLED_ScheduleBatchPerf) {
+  const int kNumTasks = 50 * 1000;
+  auto request = ResourceMapToResourceRequest({{"CPU", 1}}, false);
+  auto options = HybridOptions(0.5,
+                               /*avoid_local_node=*/false,
+                               /*require_node_available=*/true,
+                               /*avoid_gpu_nodes=*/false,
+                               RayConfig::instance().scheduler_top_k_absolute(),
+                               RayConfig::instance().scheduler_top_k_fraction());
+  for (int num_nodes : {100, 1000, 10000}) {
+    nodes.clear();
+    // The local node has no CPUs, so every task is placed on a remote node.
+    nodes.emplace(local_node, CreateNodeResources(0, 0, 0, 0, 0, 0));
+    for (int i = 1; i <= num_nodes; i++) {
+      nodes.emplace(scheduling::NodeID(i),
+                    CreateNodeResources(2 * kNumTasks / num_nodes, 1000, 0, 0, 0, 0));
+    }
+    for (bool batch : {false, true}) {
+      auto cluster_resource_manager = MockClusterResourceManager(nodes);
+      HybridSchedulingPolicy policy(local_node,
+                                    cluster_resource_manager->GetResourceView(),
+                                    [](auto) { return true; },
+                                    &cluster_resource_manager->GetNodeScoreIndex());
+      auto start = std::chrono::steady_clock::now();
+      if (batch) {
+        for (auto node_id : policy.ScheduleBatch(request, options, kNumTasks)) {
+          cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+        }
+      } else {
+        for (int i = 0; i < kNumTasks; i++) {
+          auto node_id = policy.Schedule(request, options);
+          cluster_resource_manager->SubtractNodeAvailableResources(node_id, request);
+        }
+      }
+      double duration_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+      RAY_LOG(INFO) << kNumTasks << " tasks on " << num_nodes << " nodes, "
+                    << (batch ? "batched" : "one by one") << ": " << duration_s << "s";
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
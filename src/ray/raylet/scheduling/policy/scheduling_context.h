@@ -19,6 +19,7 @@
 #include "ray/common/bundle_spec.h"
 #include "ray/common/id.h"
 #include "ray/common/placement_group.h"
+#include "ray/common/scheduling/scheduling_ids.h"
 
 namespace ray {
 namespace raylet_scheduling_policy {
@@ -60,5 +61,29 @@ struct NodeLabelSchedulingContext : public SchedulingContext {
   rpc::SchedulingStrategy scheduling_strategy_;
 };
 
+struct ArgumentLocalitySchedulingContext : public SchedulingContext {
+ public:
+  ArgumentLocalitySchedulingContext(
+      absl::flat_hash_map<scheduling::NodeID, int64_t> arg_bytes_by_node,
+      int64_t total_arg_bytes)
+      : arg_bytes_by_node_(std::move(arg_bytes_by_node)),
+        total_arg_bytes_(total_arg_bytes) {}
+
+  /// Return the fraction of the task's argument bytes already located on the node.
+  double LocalFraction(scheduling::NodeID node_id) const {
+    auto it = arg_bytes_by_node_.find(node_id);
+    if (it == arg_bytes_by_node_.end() || total_arg_bytes_ <= 0) {
+      return 0;
+    }
+    return static_cast<double>(it->second) / total_arg_bytes_;
+  }
+
+ private:
+  /// The bytes of the task's arguments located on each node.
+  absl::flat_hash_map<scheduling::NodeID, int64_t> arg_bytes_by_node_;
+  /// The bytes of the task's arguments whose locations are known.
+  int64_t total_arg_bytes_;
+};
+
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -59,17 +59,21 @@ struct SchedulingOptions {
                              RayConfig::instance().scheduler_avoid_gpu_nodes());
   }
 
-  // construct option for hybrid scheduling policy.
-  static SchedulingOptions Hybrid(bool avoid_local_node,
-                                  bool require_node_available,
-                                  const std::string &preferred_node_id = std::string()) {
+  // construct option for hybrid scheduling policy. The scheduling context can be an
+  // ArgumentLocalitySchedulingContext to take the locality of the task's arguments
+  // into account.
+  static SchedulingOptions Hybrid(
+      bool avoid_local_node,
+      bool require_node_available,
+      const std::string &preferred_node_id = std::string(),
+      std::shared_ptr<SchedulingContext> scheduling_context = nullptr) {
     return SchedulingOptions(SchedulingType::HYBRID,
                              RayConfig::instance().scheduler_spread_threshold(),
                              avoid_local_node,
                              require_node_available,
                              RayConfig::instance().scheduler_avoid_gpu_nodes(),
                              /*max_cpu_fraction_per_node*/ 1.0,
-                             /*scheduling_context*/ nullptr,
+                             std::move(scheduling_context),
                              preferred_node_id);
   }
 
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <random>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "ray/raylet/scheduling/policy/composite_scheduling_policy.h"
@@ -70,7 +74,9 @@ class SchedulingPolicyTest : public ::testing::Test {
       const absl::flat_hash_map<scheduling::NodeID, Node> &nodes) {
     static instrumented_io_context io_context;
     auto cluster_resource_manager = std::make_unique<ClusterResourceManager>(io_context);
-    cluster_resource_manager->nodes_ = nodes;
+    for (const auto &[node_id, node] : nodes) {
+      cluster_resource_manager->AddOrUpdateNode(node_id, node.GetLocalView());
+    }
     return cluster_resource_manager;
   }
 };
@@ -679,6 +685,146 @@ TEST_F(SchedulingPolicyTest, BundleSchedulingMaxFractionWorkingWhenNormalResourc
   ASSERT_TRUE(to_schedule.status.IsSuccess());
 }
 
+TEST_F(SchedulingPolicyTest, BundleStrictSpreadSolverTest) {
+  /*
+   * Test that strict spread scheduling finds a placement when the greedy placement
+   * gives the only node a bundle fits to another bundle.
+   */
+  nodes.emplace(remote_node, CreateNodeResources(1, 1, 2, 2, 0, 0));
+  nodes.emplace(remote_node_2, CreateNodeResources(2, 2, 4, 4, 0, 0));
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+
+  // The memory bundle is placed first, on the node the CPU bundle needs.
+  ResourceRequest cpu_req = ResourceMapToResourceRequest({{"CPU", 2}}, false);
+  ResourceRequest memory_req =
+      ResourceMapToResourceRequest({{"CPU", 1}, {"memory", 1}}, false);
+  std::vector<const ResourceRequest *> req_list{&cpu_req, &memory_req};
+
+  RayConfig::instance().initialize(R"({"placement_group_solver_max_steps": 0})");
+  auto result = BundleStrictSpreadSchedulingPolicy(*cluster_resource_manager,
+                                                   [](auto) { return true; })
+                    .Schedule(req_list, SchedulingOptions::BundleStrictSpread());
+  ASSERT_TRUE(result.status.IsFailed());
+
+  RayConfig::instance().initialize("");
+  result = BundleStrictSpreadSchedulingPolicy(*cluster_resource_manager,
+                                              [](auto) { return true; })
+               .Schedule(req_list, SchedulingOptions::BundleStrictSpread());
+  ASSERT_TRUE(result.status.IsSuccess());
+  ASSERT_EQ(result.selected_nodes,
+            (std::vector<scheduling::NodeID>{remote_node_2, remote_node}));
+}
+
+TEST_F(SchedulingPolicyTest, BundlePackSolverTest) {
+  /*
+   * Test that pack scheduling finds a placement when the greedy placement fragments
+   * the nodes.
+   */
+  nodes.emplace(remote_node, CreateNodeResources(4, 4, 0, 0, 0, 0));
+  nodes.emplace(remote_node_2, CreateNodeResources(3, 3, 0, 0, 0, 0));
+  nodes.emplace(remote_node_3, CreateNodeResources(3, 3, 0, 0, 0, 0));
+  auto cluster_resource_manager = MockClusterResourceManager(nodes);
+
+  // The greedy placement puts a 3 CPU bundle on the 4 CPU node, so the two 2 CPU
+  // bundles no longer fit.
+  ResourceRequest small_req = ResourceMapToResourceRequest({{"CPU", 2}}, false);
+  ResourceRequest big_req = ResourceMapToResourceRequest({{"CPU", 3}}, false);
+  std::vector<const ResourceRequest *> req_list{
+      &small_req, &big_req, &small_req, &big_req};
+
+  RayConfig::instance().initialize(R"({"placement_group_solver_max_steps": 0})");
+  auto result =
+      BundlePackSchedulingPolicy(*cluster_resource_manager, [](auto) { return true; })
+          .Schedule(req_list, SchedulingOptions::BundlePack());
+  ASSERT_TRUE(result.status.IsFailed());
+
+  RayConfig::instance().initialize("");
+  result =
+      BundlePackSchedulingPolicy(*cluster_resource_manager, [](auto) { return true; })
+          .Schedule(req_list, SchedulingOptions::BundlePack());
+  ASSERT_TRUE(result.status.IsSuccess());
+  ASSERT_EQ(result.selected_nodes[0], remote_node);
+  ASSERT_EQ(result.selected_nodes[2], remote_node);
+  ASSERT_NE(result.selected_nodes[1], result.selected_nodes[3]);
+  // The resources deducted during the search are given back.
+  for (const auto &[node_id, node] : cluster_resource_manager->GetResourceView()) {
+    ASSERT_EQ(node.GetLocalView().available, node.GetLocalView().total);
+  }
+}
+
+// Measures the placement success rate and the solve time of groups on synthetic
+// clusters where a placement exists, with and without the search that runs when the
+// greedy placement fails. We disable it by default.
+TEST_F(SchedulingPolicyTest, DISABLED_BundlePlacementSolverPerf) {
+  const int kNumTrials = 50;
+  for (auto strategy :
+       {rpc::PlacementStrategy::STRICT_SPREAD, rpc::PlacementStrategy::PACK}) {
+    for (size_t num_bundles : {16, 64, 512}) {
+      for (int64_t max_steps : {0, 100000}) {
+        RayConfig::instance().initialize("{\"placement_group_solver_max_steps\": " +
+                                         std::to_string(max_steps) + "}");
+        int num_successes = 0;
+        double duration_s = 0;
+        for (int trial = 0; trial < kNumTrials; trial++) {
+          std::mt19937 gen(trial);
+          std::vector<ResourceRequest> reqs;
+          nodes.clear();
+          if (strategy == rpc::PlacementStrategy::STRICT_SPREAD) {
+            // A quarter of the bundles only fit the big nodes, and the other bundles are
+            // placed first, preferably on the big nodes.
+            for (size_t i = 0; i < num_bundles; i++) {
+              scheduling::NodeID node_id(i);
+              if (gen() % 4 == 0) {
+                reqs.push_back(ResourceMapToResourceRequest({{"CPU", 16}}, false));
+                nodes.emplace(node_id, CreateNodeResources(32, 32, 64, 64, 0, 0));
+              } else {
+                reqs.push_back(
+                    ResourceMapToResourceRequest({{"CPU", 1}, {"memory", 8}}, false));
+                nodes.emplace(node_id, CreateNodeResources(2, 2, 16, 16, 0, 0));
+              }
+            }
+          } else {
+            // Split the CPUs and memory of each node into two bundles.
+            for (int i = 0; reqs.size() < num_bundles; i++) {
+              double cpus = 4 + gen() % 13;
+              double memory = 4 + gen() % 29;
+              double cpus_a = 1 + gen() % static_cast<int>(cpus - 1);
+              double memory_a = 1 + gen() % static_cast<int>(memory - 1);
+              reqs.push_back(ResourceMapToResourceRequest(
+                  {{"CPU", cpus_a}, {"memory", memory_a}}, false));
+              reqs.push_back(ResourceMapToResourceRequest(
+                  {{"CPU", cpus - cpus_a}, {"memory", memory - memory_a}}, false));
+              nodes.emplace(scheduling::NodeID(i),
+                            CreateNodeResources(cpus, cpus, memory, memory, 0, 0));
+            }
+          }
+          std::shuffle(reqs.begin(), reqs.end(), gen);
+          std::vector<const ResourceRequest *> req_list;
+          for (const auto &req : reqs) {
+            req_list.push_back(&req);
+          }
+          auto cluster_resource_manager = MockClusterResourceManager(nodes);
+          CompositeBundleSchedulingPolicy policy(*cluster_resource_manager,
+                                                 [](auto) { return true; });
+          auto options = strategy == rpc::PlacementStrategy::STRICT_SPREAD
+                             ? SchedulingOptions::BundleStrictSpread()
+                             : SchedulingOptions::BundlePack();
+          auto start = std::chrono::steady_clock::now();
+          num_successes += policy.Schedule(req_list, options).status.IsSuccess();
+          duration_s += std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        }
+        RAY_LOG(INFO) << rpc::PlacementStrategy_Name(strategy) << ", " << num_bundles
+                      << " bundles, max steps " << max_steps << ": " << num_successes
+                      << "/" << kNumTrials << " placed, "
+                      << duration_s * 1000 / kNumTrials << " ms per group";
+      }
+    }
+  }
+  RayConfig::instance().initialize("");
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -16,10 +16,13 @@
 
 #include <numeric>
 
+#include "ray/raylet/scheduling/node_score_index.h"
+
 namespace ray {
 namespace raylet_scheduling_policy {
 
-double LeastResourceScorer::Score(const ResourceRequest &required_resources,
+double LeastResourceScorer::Score(scheduling::NodeID node_id,
+                                  const ResourceRequest &required_resources,
                                   const NodeResources &node_resources) {
   // In GCS-based actor scheduling, the `NodeResources` are only acquired or released by
   // actor scheduling, instead of being updated by resource reports from raylets. So we
@@ -62,5 +65,18 @@ double LeastResourceScorer::Calculate(const FixedPoint &requested,
   return (available - requested).Double() / available.Double();
 }
 
+double ArgumentLocalityScorer::Score(scheduling::NodeID node_id,
+                                     const ResourceRequest &required_resources,
+                                     const NodeResources &node_resources) {
+  return ScoreUtilization(node_id,
+                          ComputeHybridNodeScore(node_resources, spread_threshold_));
+}
+
+float ArgumentLocalityScorer::ScoreUtilization(scheduling::NodeID node_id,
+                                               float utilization_score) const {
+  return (1 - locality_weight_) * utilization_score +
+         locality_weight_ * static_cast<float>(1 - locality_.LocalFraction(node_id));
+}
+
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -16,23 +16,26 @@
 #include <optional>
 
 #include "ray/common/scheduling/cluster_resource_data.h"
+#include "ray/raylet/scheduling/policy/scheduling_context.h"
 
 namespace ray {
 namespace raylet_scheduling_policy {
 
 /// NodeScorer is a scorer to make a grade to the node, which is used for scheduling
-/// decision.
+/// decision. Whether higher or lower scores are preferable depends on the scorer.
 class NodeScorer {
  public:
   virtual ~NodeScorer() = default;
 
   /// \brief Score according to node resources.
   ///
+  /// \param node_id The node.
   /// \param required_resources The required resources.
   /// \param node_resources The node resources which contains available and total
   /// resources.
   /// \return Score of the node.
-  virtual double Score(const ResourceRequest &required_resources,
+  virtual double Score(scheduling::NodeID node_id,
+                       const ResourceRequest &required_resources,
                        const NodeResources &node_resources) = 0;
 };
 
@@ -40,7 +43,8 @@ class NodeScorer {
 /// requested resources based on requested resources.
 class LeastResourceScorer : public NodeScorer {
  public:
-  double Score(const ResourceRequest &required_resources,
+  double Score(scheduling::NodeID node_id,
+               const ResourceRequest &required_resources,
                const NodeResources &node_resources) override;
 
  private:
@@ -52,5 +56,42 @@ class LeastResourceScorer : public NodeScorer {
   double Calculate(const FixedPoint &requested, const FixedPoint &available);
 };
 
+/// ArgumentLocalityScorer blends the critical resource utilization score that the
+/// hybrid policy gives a node with the fraction of the task's argument bytes already
+/// located on the node, so that between similarly loaded nodes the one that has to
+/// pull the fewest bytes is preferred. Lower scores are preferable.
+class ArgumentLocalityScorer : public NodeScorer {
+ public:
+  /// \param locality The locations of the task's arguments.
+  /// \param locality_weight The weight of the locality in the score, between 0 and 1.
+  /// \param spread_threshold The spread threshold of the hybrid score.
+  ArgumentLocalityScorer(const ArgumentLocalitySchedulingContext &locality,
+                         float locality_weight,
+                         float spread_threshold)
+      : locality_(locality),
+        locality_weight_(locality_weight),
+        spread_threshold_(spread_threshold) {}
+
+  /// \brief Score according to the node utilization and argument locality.
+  ///
+  /// \return Score of the node between 0 and 1.
+  double Score(scheduling::NodeID node_id,
+               const ResourceRequest &required_resources,
+               const NodeResources &node_resources) override;
+
+  /// \brief Score from a hybrid score already computed for the node, e.g. from the
+  /// cached utilization of the node.
+  ///
+  /// \param node_id The node.
+  /// \param utilization_score The hybrid score of the node, between 0 and 1.
+  /// \return Score of the node between 0 and 1.
+  float ScoreUtilization(scheduling::NodeID node_id, float utilization_score) const;
+
+ private:
+  const ArgumentLocalitySchedulingContext &locality_;
+  const float locality_weight_;
+  const float spread_threshold_;
+};
+
 }  // namespace raylet_scheduling_policy
 }  // namespace ray
@@ -0,0 +1,48 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/syncer_aggregation_group.h"
+
+namespace ray {
+namespace raylet {
+
+SyncerAggregationGroup::SyncerAggregationGroup(const NodeID &self_node_id,
+                                               std::string group)
+    : self_node_id_(self_node_id), group_(std::move(group)) {
+  if (!group_.empty()) {
+    members_.insert(self_node_id_.Binary());
+  }
+}
+
+void SyncerAggregationGroup::AddNode(const NodeID &node_id, const std::string &group) {
+  if (!group_.empty() && group == group_) {
+    members_.insert(node_id.Binary());
+  }
+}
+
+void SyncerAggregationGroup::RemoveNode(const NodeID &node_id) {
+  if (node_id != self_node_id_) {
+    members_.erase(node_id.Binary());
+  }
+}
+
+NodeID SyncerAggregationGroup::GetUpstream() const {
+  if (members_.empty() || *members_.begin() == self_node_id_.Binary()) {
+    return NodeID::Nil();
+  }
+  return NodeID::FromBinary(*members_.begin());
+}
+
+}  // namespace raylet
+}  // namespace ray
@@ -0,0 +1,67 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "ray/common/id.h"
+
+namespace ray {
+namespace raylet {
+
+/// The group of nodes whose RaySyncer traffic is aggregated by one of them.
+///
+/// Nodes with the same value of the `ray_syncer_aggregation_label` label form a group.
+/// The aggregator of a group is its alive node with the smallest id: it syncs with the
+/// GCS and the other nodes of the group sync with it, so the GCS relays each update to
+/// one stream per group instead of one per node. Since a node only ever syncs with a
+/// node of a smaller id, the sync graph stays a tree while nodes disagree about the
+/// membership of the group.
+///
+/// It is not thread safe and is expected to run ONLY in the NodeManager.io_service_
+/// thread.
+class SyncerAggregationGroup {
+ public:
+  /// \param self_node_id The id of the local node.
+  /// \param group The label value of the local node. Empty means the local node isn't
+  /// in any group and syncs with the GCS directly.
+  SyncerAggregationGroup(const NodeID &self_node_id, std::string group);
+
+  /// Handle a node joining the cluster.
+  ///
+  /// \param node_id The id of the node.
+  /// \param group The label value of the node.
+  void AddNode(const NodeID &node_id, const std::string &group);
+
+  /// Handle a node leaving the cluster.
+  void RemoveNode(const NodeID &node_id);
+
+  /// Return the node the local node syncs with, or nil if it syncs with the GCS
+  /// directly, either because it is the aggregator of its group or it isn't in any.
+  NodeID GetUpstream() const;
+
+  /// Return the number of alive nodes in the group, including the local node.
+  size_t Size() const { return members_.size(); }
+
+ private:
+  const NodeID self_node_id_;
+  const std::string group_;
+  /// The alive nodes of the group in id order.
+  std::set<std::string> members_;
+};
+
+}  // namespace raylet
+}  // namespace ray
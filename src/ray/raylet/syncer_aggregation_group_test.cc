@@ -0,0 +1,79 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/raylet/syncer_aggregation_group.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+namespace raylet {
+
+class SyncerAggregationGroupTest : public ::testing::Test {
+ protected:
+  /// Return `num_nodes` random node ids in ascending order.
+  std::vector<NodeID> SortedNodeIds(size_t num_nodes) {
+    std::vector<NodeID> node_ids;
+    for (size_t i = 0; i < num_nodes; i++) {
+      node_ids.push_back(NodeID::FromRandom());
+    }
+    std::sort(node_ids.begin(), node_ids.end(), [](const NodeID &a, const NodeID &b) {
+      return a.Binary() < b.Binary();
+    });
+    return node_ids;
+  }
+};
+
+TEST_F(SyncerAggregationGroupTest, TestNoGroup) {
+  auto node_ids = SortedNodeIds(2);
+  SyncerAggregationGroup group(node_ids[1], "");
+  group.AddNode(node_ids[0], "");
+  ASSERT_EQ(group.Size(), 0);
+  ASSERT_TRUE(group.GetUpstream().IsNil());
+}
+
+TEST_F(SyncerAggregationGroupTest, TestUpstream) {
+  auto node_ids = SortedNodeIds(4);
+  SyncerAggregationGroup group(node_ids[2], "zone-a");
+  // Alone in its group, the node syncs with the GCS.
+  ASSERT_TRUE(group.GetUpstream().IsNil());
+
+  // Nodes of other groups are ignored.
+  group.AddNode(node_ids[0], "zone-b");
+  ASSERT_TRUE(group.GetUpstream().IsNil());
+
+  // A node with a larger id doesn't take over the group.
+  group.AddNode(node_ids[3], "zone-a");
+  ASSERT_EQ(group.Size(), 2);
+  ASSERT_TRUE(group.GetUpstream().IsNil());
+
+  // The node with the smallest id aggregates the group.
+  group.AddNode(node_ids[1], "zone-a");
+  ASSERT_EQ(group.GetUpstream(), node_ids[1]);
+
+  // When the aggregator dies, the next one takes over.
+  group.RemoveNode(node_ids[1]);
+  ASSERT_TRUE(group.GetUpstream().IsNil());
+  group.RemoveNode(node_ids[0]);
+  ASSERT_EQ(group.Size(), 2);
+}
+
+}  // namespace raylet
+}  // namespace ray
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -353,7 +353,11 @@ class LocalObjectManagerTestWithMinSpillingSize {
               return unevictable_objects_.count(object_id) == 0;
             },
             /*core_worker_subscriber=*/subscriber_.get(),
-            object_directory_.get()),
+            object_directory_.get(),
+            /*on_spilled_file_deleted=*/
+            [&](const std::string &file_path) {
+              deleted_spilled_files.push_back(file_path);
+            }),
         unpins(std::make_shared<absl::flat_hash_map<ObjectID, int>>()) {
     RayConfig::instance().initialize(R"({"object_spilling_config": "dummy"})");
   }
@@ -410,6 +414,7 @@ class LocalObjectManagerTestWithMinSpillingSize {
   LocalObjectManager manager;
 
   std::unordered_set<ObjectID> freed;
+  std::vector<std::string> deleted_spilled_files;
   // This hashmap is incremented when objects are unpinned by destroying their
   // unique_ptr.
   std::shared_ptr<absl::flat_hash_map<ObjectID, int>> unpins;
@@ -1050,6 +1055,7 @@ TEST_F(LocalObjectManagerTest, TestDeleteURLRefCount) {
   int deleted_urls_size = worker_pool.io_worker_client->ReplyDeleteSpilledObjects();
   // Nothing is deleted yet because the ref count is > 0.
   ASSERT_EQ(deleted_urls_size, 0);
+  ASSERT_TRUE(deleted_spilled_files.empty());
 
   // Only 1 spilled object left
   ASSERT_EQ(GetCurrentSpilledCount(), 1);
@@ -1063,6 +1069,7 @@ TEST_F(LocalObjectManagerTest, TestDeleteURLRefCount) {
   deleted_urls_size = worker_pool.io_worker_client->ReplyDeleteSpilledObjects();
   // Now the object is deleted.
   ASSERT_EQ(deleted_urls_size, 1);
+  ASSERT_EQ(deleted_spilled_files, std::vector<std::string>{"unified_url"});
 
   ASSERT_EQ(GetCurrentSpilledCount(), 0);
   ASSERT_EQ(GetCurrentSpilledBytes(), 0);
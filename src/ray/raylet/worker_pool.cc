@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <cmath>
 #include <fstream>
 
 #include "absl/strings/str_split.h"
@@ -113,6 +114,9 @@ WorkerPool::WorkerPool(instrumented_io_context &io_service,
   stats::NumCachedWorkersSkippedJobMismatch.Record(0);
   stats::NumCachedWorkersSkippedDynamicOptionsMismatch.Record(0);
   stats::NumCachedWorkersSkippedRuntimeEnvironmentMismatch.Record(0);
+  stats::NumWorkersPrestartedForDemand.Record(0);
+  stats::NumPrestartedWorkersUsed.Record(0);
+  stats::PrestartedWorkersStartupTimeSavedMs.Record(0);
   // We used to ignore SIGCHLD here. The code is moved to raylet main.cc to support the
   // subreaper feature.
   for (const auto &entry : worker_commands) {
@@ -164,6 +168,13 @@ void WorkerPool::Start() {
         "RayletWorkerPool.deadline_timer.kill_idle_workers");
   }
 
+  if (RayConfig::instance().worker_demand_prestart_interval_ms() > 0) {
+    periodical_runner_.RunFnPeriodically(
+        [this] { PrestartWorkersForDemand(); },
+        RayConfig::instance().worker_demand_prestart_interval_ms(),
+        "RayletWorkerPool.deadline_timer.prestart_workers_for_demand");
+  }
+
   if (RayConfig::instance().enable_worker_prestart()) {
     PrestartDefaultCpuWorkers(Language::PYTHON, num_prestart_python_workers);
   }
@@ -203,7 +214,9 @@ void WorkerPool::PopWorkerCallbackInternal(const PopWorkerCallback &callback,
                                            PopWorkerStatus status) {
   RAY_CHECK(callback);
   auto used = callback(worker, status, /*runtime_env_setup_error_message*/ "");
-  if (worker && !used) {
+  if (worker && used) {
+    RecordPrestartedWorkerUsed(worker);
+  } else if (worker && !used) {
     // The invalid worker not used, restore it to worker pool.
     PushWorker(worker);
   }
@@ -225,6 +238,7 @@ void WorkerPool::AddWorkerProcess(
                                                    worker_type,
                                                    proc,
                                                    start,
+                                                   get_time_(),
                                                    runtime_env_info,
                                                    dynamic_options});
 }
@@ -232,6 +246,9 @@ void WorkerPool::AddWorkerProcess(
 void WorkerPool::RemoveWorkerProcess(State &state,
                                      const StartupToken &proc_startup_token) {
   state.worker_processes.erase(proc_startup_token);
+  // A process prestarted for the demand may fail to start, and then no worker of it
+  // disconnects.
+  demand_prestarted_processes_.erase(proc_startup_token);
 }
 
 std::pair<std::vector<std::string>, ProcessEnvironment>
@@ -776,6 +793,11 @@ void WorkerPool::OnWorkerStarted(const std::shared_ptr<WorkerInterface> &worker)
   auto it = state.worker_processes.find(worker_startup_token);
   if (it != state.worker_processes.end()) {
     it->second.is_pending_registration = false;
+    if (worker_type == rpc::WorkerType::WORKER) {
+      // Keep a moving average of the startup times to size the warm workers.
+      worker_startup_time_ms_ +=
+          0.1 * (get_time_() - it->second.start_time_ms - worker_startup_time_ms_);
+    }
     // We may have slots to start more workers now.
     TryStartIOWorkers(worker->GetLanguage());
   }
@@ -986,6 +1008,9 @@ void WorkerPool::InvokePopWorkerCallbackForProcess(
     // invoking the callback immediately.
     RAY_CHECK(status != PopWorkerStatus::RuntimeEnvCreationFailed);
     *worker_used = callback(worker, status, /*runtime_env_setup_error_message*/ "");
+    if (worker && *worker_used) {
+      RecordPrestartedWorkerUsed(worker);
+    }
     starting_workers_to_tasks.erase(it);
   }
 }
@@ -1302,6 +1327,7 @@ void WorkerPool::PopWorker(const TaskSpecification &task_spec,
 
 void WorkerPool::PrestartWorkers(const TaskSpecification &task_spec,
                                  int64_t backlog_size) {
+  RecordWorkerDemand(task_spec);
   int64_t num_available_cpus = get_num_cpus_available_();
   // Code path of task that needs a dedicated worker.
   RAY_LOG(DEBUG) << "PrestartWorkers, num_available_cpus " << num_available_cpus
@@ -1353,9 +1379,159 @@ void WorkerPool::PrestartDefaultCpuWorkers(ray::Language language, int64_t num_n
   }
 }
 
+void WorkerPool::RecordWorkerDemand(const TaskSpecification &task_spec) {
+  if (RayConfig::instance().worker_demand_prestart_interval_ms() == 0 ||
+      (task_spec.IsActorCreationTask() && !task_spec.DynamicWorkerOptions().empty())) {
+    // Workers with dynamic options are dedicated to their actors.
+    return;
+  }
+  const double now = get_time_();
+  // Each request adds 1/tau to a rate decaying with the mean lifetime tau, so that the
+  // rate converges to the actual request rate.
+  const double tau_ms = RayConfig::instance().worker_demand_half_life_ms() / std::log(2);
+  auto &demand = worker_demands_[{task_spec.GetLanguage(),
+                                  task_spec.JobId(),
+                                  task_spec.GetRuntimeEnvHash()}];
+  demand.request_rate =
+      demand.request_rate * std::exp(-(now - demand.last_update_ms) / tau_ms) +
+      1000 / tau_ms;
+  demand.last_update_ms = now;
+  demand.task_spec = task_spec;
+}
+
+void WorkerPool::RecordPrestartedWorkerUsed(
+    const std::shared_ptr<WorkerInterface> &worker) {
+  if (demand_prestarted_processes_.erase(worker->GetStartupToken()) > 0) {
+    // The task didn't wait for this worker to start.
+    stats::NumPrestartedWorkersUsed.Record(1);
+    stats::PrestartedWorkersStartupTimeSavedMs.Record(worker_startup_time_ms_);
+  }
+}
+
+void WorkerPool::PrestartWorkersForDemand() {
+  const double now = get_time_();
+  const double tau_ms = RayConfig::instance().worker_demand_half_life_ms() / std::log(2);
+  // The number of workers each kind of worker should keep warm, busiest kinds first.
+  std::vector<std::pair<int64_t, WorkerDemandKey>> targets;
+  for (auto it = worker_demands_.begin(); it != worker_demands_.end();) {
+    auto &demand = it->second;
+    demand.request_rate *= std::exp(-(now - demand.last_update_ms) / tau_ms);
+    demand.last_update_ms = now;
+    // The number of requests expected while a worker starts.
+    int64_t target = std::lround(demand.request_rate * worker_startup_time_ms_ / 1000);
+    if (target == 0 || finished_jobs_.contains(std::get<1>(it->first))) {
+      worker_demands_.erase(it++);
+      continue;
+    }
+    targets.emplace_back(target, it->first);
+    it++;
+  }
+  if (targets.empty()) {
+    return;
+  }
+  std::sort(targets.begin(), targets.end(), [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  });
+
+  // Like `PrestartWorkers`, don't start more workers than the CPUs can run, and bound
+  // the speculative workers.
+  int64_t num_idle_or_starting = idle_of_all_languages_.size();
+  for (const auto &entry : states_by_lang_) {
+    for (const auto &process : entry.second.worker_processes) {
+      num_idle_or_starting += process.second.is_pending_registration ? 1 : 0;
+    }
+  }
+  int64_t num_allowed =
+      std::min<int64_t>(get_num_cpus_available_() - num_idle_or_starting,
+                        RayConfig::instance().worker_demand_max_warm_workers() -
+                            static_cast<int64_t>(demand_prestarted_processes_.size()));
+
+  absl::flat_hash_map<WorkerDemandKey, int64_t> num_starting;
+  for (const auto &[startup_token, key] : demand_prestarted_processes_) {
+    const auto &state = GetStateForLanguage(std::get<0>(key));
+    auto it = state.worker_processes.find(startup_token);
+    if (it != state.worker_processes.end() && it->second.is_pending_registration) {
+      num_starting[key]++;
+    }
+  }
+  for (const auto &[target, key] : targets) {
+    if (num_allowed <= 0) {
+      break;
+    }
+    const auto &[language, job_id, runtime_env_hash] = key;
+    auto &demand = worker_demands_.at(key);
+    int64_t num_warm = num_starting[key] + demand.num_creating_runtime_envs;
+    for (const auto &[idle_worker, last_time_used_ms] : idle_of_all_languages_) {
+      // The same conditions as `PopWorker` uses to reuse idle workers.
+      if (idle_worker->GetLanguage() == language && !idle_worker->IsDead() &&
+          (idle_worker->GetAssignedJobId().IsNil() ||
+           idle_worker->GetAssignedJobId() == job_id) &&
+          idle_worker->GetRuntimeEnvHash() == runtime_env_hash &&
+          LookupWorkerDynamicOptions(idle_worker->GetStartupToken()).empty() &&
+          !pending_exit_idle_workers_.contains(idle_worker->WorkerId())) {
+        num_warm++;
+      }
+    }
+    for (; num_warm < target && num_allowed > 0; num_warm++, num_allowed--) {
+      if (!StartWorkerProcessForDemand(key, demand)) {
+        break;
+      }
+    }
+  }
+}
+
+bool WorkerPool::StartWorkerProcessForDemand(const WorkerDemandKey &key,
+                                             WorkerDemand &demand) {
+  auto start_worker_process_fn = [this, key, task_spec = demand.task_spec](
+                                     const std::string &serialized_runtime_env_context) {
+    PopWorkerStatus status = PopWorkerStatus::OK;
+    auto [proc, startup_token] = StartWorkerProcess(task_spec.GetLanguage(),
+                                                    rpc::WorkerType::WORKER,
+                                                    task_spec.JobId(),
+                                                    &status,
+                                                    /*dynamic_options=*/{},
+                                                    task_spec.GetRuntimeEnvHash(),
+                                                    serialized_runtime_env_context,
+                                                    task_spec.RuntimeEnvInfo());
+    if (status != PopWorkerStatus::OK) {
+      DeleteRuntimeEnvIfPossible(task_spec.SerializedRuntimeEnv());
+      return false;
+    }
+    demand_prestarted_processes_.emplace(startup_token, key);
+    stats::NumWorkersPrestartedForDemand.Record(1);
+    return true;
+  };
+
+  if (!demand.task_spec.HasRuntimeEnv()) {
+    return start_worker_process_fn("");
+  }
+  demand.num_creating_runtime_envs++;
+  GetOrCreateRuntimeEnv(
+      demand.task_spec.SerializedRuntimeEnv(),
+      demand.task_spec.RuntimeEnvConfig(),
+      demand.task_spec.JobId(),
+      [this, key, start_worker_process_fn](
+          bool successful,
+          const std::string &serialized_runtime_env_context,
+          const std::string &setup_error_message) {
+        auto it = worker_demands_.find(key);
+        if (it != worker_demands_.end()) {
+          it->second.num_creating_runtime_envs--;
+        }
+        if (successful) {
+          start_worker_process_fn(serialized_runtime_env_context);
+        } else {
+          RAY_LOG(DEBUG) << "Couldn't create a runtime env to prestart a worker: "
+                         << setup_error_message;
+        }
+      });
+  return true;
+}
+
 void WorkerPool::DisconnectWorker(const std::shared_ptr<WorkerInterface> &worker,
                                   rpc::WorkerExitType disconnect_type) {
   MarkPortAsFree(worker->AssignedPort());
+  demand_prestarted_processes_.erase(worker->GetStartupToken());
   auto &state = GetStateForLanguage(worker->GetLanguage());
   auto it = state.worker_processes.find(worker->GetStartupToken());
   if (it != state.worker_processes.end()) {
@@ -20,6 +20,7 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/functional/hash.hpp>
 #include <queue>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -392,6 +393,12 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
   /// reasonable size.
   void TryKillingIdleWorkers();
 
+  /// Start workers for the kinds of workers with recent lease requests, so that the
+  /// next tasks of these kinds find a warm worker instead of waiting for one to start.
+  /// Each kind keeps as many warm workers as the lease requests expected while a
+  /// worker starts, i.e. its decayed request rate times the worker startup time.
+  void PrestartWorkersForDemand();
+
  protected:
   void update_worker_startup_token_counter();
 
@@ -476,12 +483,32 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
     Process proc;
     /// The worker process start time.
     std::chrono::high_resolution_clock::time_point start_time;
+    /// The worker process start time from `get_time_`, in ms.
+    double start_time_ms;
     /// The runtime env Info.
     rpc::RuntimeEnvInfo runtime_env_info;
     /// The dynamic_options.
     std::vector<std::string> dynamic_options;
   };
 
+  /// The kind of worker a task needs: the language, the job and the runtime env hash.
+  /// The runtime env hash also covers the resource shape when
+  /// `worker_resource_limits_enabled` is set.
+  using WorkerDemandKey = std::tuple<Language, JobID, int>;
+
+  /// The recent lease requests for one kind of worker.
+  struct WorkerDemand {
+    /// The latest task of this kind, used to start workers for it.
+    TaskSpecification task_spec;
+    /// The lease requests per second, decayed exponentially with the half-life
+    /// `worker_demand_half_life_ms`.
+    double request_rate = 0;
+    /// The time `request_rate` was last updated, in ms.
+    double last_update_ms = 0;
+    /// The number of runtime envs being created for workers of this kind.
+    int64_t num_creating_runtime_envs = 0;
+  };
+
   struct TaskWaitingForWorkerInfo {
     /// The id of task.
     TaskID task_id;
@@ -582,6 +609,25 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
   /// \param language The language of the PopWorker requests.
   void TryPendingPopWorkerRequests(const Language &language);
 
+  /// Count a lease request towards the demand for the kind of worker of the task.
+  ///
+  /// \param task_spec The task of the lease request.
+  void RecordWorkerDemand(const TaskSpecification &task_spec);
+
+  /// Count the worker as a used prestarted worker if it was prestarted for the demand
+  /// and this is the first task it serves.
+  ///
+  /// \param worker The worker a task accepted.
+  void RecordPrestartedWorkerUsed(const std::shared_ptr<WorkerInterface> &worker);
+
+  /// Start a worker process for the demand of the given kind. Workers with a runtime
+  /// env are started once the runtime env is created.
+  ///
+  /// \param key The kind of worker to start.
+  /// \param demand The demand for this kind of worker.
+  /// \return False if the worker process couldn't be started.
+  bool StartWorkerProcessForDemand(const WorkerDemandKey &key, WorkerDemand &demand);
+
   /// Get either restore or spill worker state from state based on worker_type.
   ///
   /// \param worker_type IO Worker Type.
@@ -753,6 +799,15 @@ class WorkerPool : public WorkerPoolInterface, public IOWorkerPoolInterface {
 
   /// A callback to get the current time.
   const std::function<double()> get_time_;
+
+  /// The recent lease requests by kind of worker.
+  absl::flat_hash_map<WorkerDemandKey, WorkerDemand> worker_demands_;
+  /// The worker processes started for the demand that no task has used yet, by
+  /// startup token.
+  absl::flat_hash_map<StartupToken, WorkerDemandKey> demand_prestarted_processes_;
+  /// The estimated time for a worker process to start, in ms. It's a moving average
+  /// of the startup times of the task workers.
+  double worker_startup_time_ms_ = 1000;
   /// Runtime env manager client.
   std::shared_ptr<RuntimeEnvAgentClient> runtime_env_agent_client_;
   /// Stats
@@ -431,6 +431,10 @@ class WorkerPoolTest : public ::testing::Test {
 
   void AssertNoLeaks() { ASSERT_EQ(worker_pool_->pending_exit_idle_workers_.size(), 0); }
 
+  size_t NumUnusedDemandPrestartedProcesses() {
+    return worker_pool_->demand_prestarted_processes_.size();
+  }
+
   std::shared_ptr<WorkerInterface> CreateSpillWorker(Process proc) {
     return worker_pool_->CreateWorker(
         proc, Language::PYTHON, JobID::Nil(), rpc::WorkerType::SPILL_WORKER);
@@ -1928,6 +1932,155 @@ TEST_F(WorkerPoolDriverRegisteredTest, WorkerReuseForPrestartedWorker) {
   ASSERT_EQ(worker_pool_->GetIdleWorkerSize(), 0);
 }
 
+TEST_F(WorkerPoolDriverRegisteredTest, PrestartWorkersForBurstyDemand) {
+  RayConfig::instance().worker_demand_prestart_interval_ms() = 100;
+  RayConfig::instance().worker_demand_half_life_ms() = 2000;
+  RayConfig::instance().worker_demand_max_warm_workers() = 2;
+  const auto runtime_env_info = ExampleRuntimeEnvInfo({"XXX"});
+  const int num_bursts = 10;
+  const int burst_size = 4;
+  int num_warm_pops = 0;
+  int num_cold_pops = 0;
+  // Replay bursts of lease requests for tasks with a runtime env, which the backlog
+  // based prestarting doesn't handle. Each worker takes about a second to start.
+  for (int burst = 0; burst < num_bursts; burst++) {
+    const double burst_start_ms = burst * 2000;
+    int num_burst_warm_pops = 0;
+    for (int i = 0; i < burst_size; i++) {
+      worker_pool_->SetCurrentTimeMs(burst_start_ms + 10 * i);
+      const auto task_spec = ExampleTaskSpec(ActorID::Nil(),
+                                             Language::PYTHON,
+                                             JOB_ID,
+                                             ActorID::Nil(),
+                                             {},
+                                             TaskID::FromRandom(JobID::Nil()),
+                                             runtime_env_info);
+      worker_pool_->PrestartWorkers(task_spec, burst_size - i - 1);
+      bool popped = false;
+      worker_pool_->PopWorker(
+          task_spec,
+          [&popped](const std::shared_ptr<WorkerInterface> worker,
+                    PopWorkerStatus status,
+                    const std::string &runtime_env_setup_error_message) -> bool {
+            popped = true;
+            return true;
+          });
+      // The task didn't wait for a worker to start.
+      num_burst_warm_pops += popped ? 1 : 0;
+    }
+    if (burst == 0) {
+      // There's no demand to predict from yet.
+      ASSERT_EQ(num_burst_warm_pops, 0);
+    } else {
+      ASSERT_GE(num_burst_warm_pops, 1);
+    }
+    num_warm_pops += num_burst_warm_pops;
+    num_cold_pops += burst_size - num_burst_warm_pops;
+
+    // The workers started for the tasks register, then the workers prestarted for the
+    // demand register before the next burst.
+    worker_pool_->SetCurrentTimeMs(burst_start_ms + 1000);
+    worker_pool_->PushWorkers();
+    ASSERT_EQ(worker_pool_->NumPendingPopWorkerRequests(), 0);
+    worker_pool_->PrestartWorkersForDemand();
+    worker_pool_->SetCurrentTimeMs(burst_start_ms + 1900);
+    worker_pool_->PushWorkers();
+    ASSERT_LE(worker_pool_->GetIdleWorkerSize(), 2);
+  }
+  ASSERT_EQ(num_warm_pops + num_cold_pops, num_bursts * burst_size);
+  // Every task either used a prestarted worker or started its own.
+  ASSERT_EQ(worker_pool_->GetProcessSize(),
+            num_cold_pops + num_warm_pops + worker_pool_->GetIdleWorkerSize());
+
+  // Once the demand decays, no more workers are prestarted.
+  const int num_processes = worker_pool_->GetProcessSize();
+  worker_pool_->SetCurrentTimeMs(num_bursts * 2000 + 60000);
+  worker_pool_->PrestartWorkersForDemand();
+  ASSERT_EQ(worker_pool_->GetProcessSize(), num_processes);
+}
+
+TEST_F(WorkerPoolDriverRegisteredTest, PrestartedWorkerUsedOnceAccepted) {
+  RayConfig::instance().worker_demand_prestart_interval_ms() = 100;
+  RayConfig::instance().worker_demand_half_life_ms() = 2000;
+  RayConfig::instance().worker_demand_max_warm_workers() = 2;
+  const auto runtime_env_info = ExampleRuntimeEnvInfo({"XXX"});
+  const auto task_spec = ExampleTaskSpec(ActorID::Nil(),
+                                         Language::PYTHON,
+                                         JOB_ID,
+                                         ActorID::Nil(),
+                                         {},
+                                         TaskID::FromRandom(JobID::Nil()),
+                                         runtime_env_info);
+  // Enough recent requests to keep one worker warm.
+  worker_pool_->SetCurrentTimeMs(0);
+  for (int i = 0; i < 3; i++) {
+    worker_pool_->PrestartWorkers(task_spec, /*backlog_size=*/0);
+  }
+  worker_pool_->PrestartWorkersForDemand();
+  ASSERT_EQ(NumUnusedDemandPrestartedProcesses(), 1);
+  worker_pool_->PushWorkers();
+  ASSERT_EQ(worker_pool_->GetIdleWorkerSize(), 1);
+
+  auto pop_worker = [&](bool accept) {
+    worker_pool_->PopWorker(
+        task_spec,
+        [accept](const std::shared_ptr<WorkerInterface> worker,
+                 PopWorkerStatus status,
+                 const std::string &runtime_env_setup_error_message) -> bool {
+          return accept;
+        });
+  };
+  // A task that turns the prestarted worker down doesn't use it.
+  pop_worker(/*accept=*/false);
+  ASSERT_EQ(NumUnusedDemandPrestartedProcesses(), 1);
+  ASSERT_EQ(worker_pool_->GetIdleWorkerSize(), 1);
+  // The first task that accepts it does.
+  pop_worker(/*accept=*/true);
+  ASSERT_EQ(NumUnusedDemandPrestartedProcesses(), 0);
+  ASSERT_EQ(worker_pool_->GetIdleWorkerSize(), 0);
+}
+
+TEST_F(WorkerPoolDriverRegisteredTest, PrestartedProcessThatNeverRegistersFreesItsSlot) {
+  RayConfig::instance().worker_demand_prestart_interval_ms() = 100;
+  RayConfig::instance().worker_demand_half_life_ms() = 2000;
+  RayConfig::instance().worker_demand_max_warm_workers() = 1;
+  const auto runtime_env_info = ExampleRuntimeEnvInfo({"XXX"});
+  const auto task_spec = ExampleTaskSpec(ActorID::Nil(),
+                                         Language::PYTHON,
+                                         JOB_ID,
+                                         ActorID::Nil(),
+                                         {},
+                                         TaskID::FromRandom(JobID::Nil()),
+                                         runtime_env_info);
+  worker_pool_->SetCurrentTimeMs(0);
+  for (int i = 0; i < 3; i++) {
+    worker_pool_->PrestartWorkers(task_spec, /*backlog_size=*/0);
+  }
+  worker_pool_->PrestartWorkersForDemand();
+  ASSERT_EQ(NumUnusedDemandPrestartedProcesses(), 1);
+
+  // The process never registers. The registration timeout runs on the thread of the
+  // worker pool, so the prestarted processes are counted there.
+  auto num_unused_on_pool_thread = [this] {
+    std::promise<size_t> promise;
+    io_service_.post(
+        [this, &promise] { promise.set_value(NumUnusedDemandPrestartedProcesses()); },
+        "WorkerPoolTest.NumUnusedDemandPrestartedProcesses");
+    return promise.get_future().get();
+  };
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(2 * WORKER_REGISTER_TIMEOUT_SECONDS);
+  while (num_unused_on_pool_thread() > 0 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  ASSERT_EQ(num_unused_on_pool_thread(), 0);
+
+  // Its slot of the warm workers is free for another prestarted worker.
+  worker_pool_->PrestartWorkersForDemand();
+  ASSERT_EQ(NumUnusedDemandPrestartedProcesses(), 1);
+  worker_pool_->ClearProcesses();
+}
+
 TEST_F(WorkerPoolDriverRegisteredTest, WorkerReuseForSameJobId) {
   const auto task_spec = ExampleTaskSpec();
 
@@ -514,6 +514,12 @@ void raylet::RayletClient::DrainRaylet(
   grpc_client_->DrainRaylet(request, callback);
 }
 
+void raylet::RayletClient::StealTasks(
+    const rpc::StealTasksRequest &request,
+    const rpc::ClientCallback<rpc::StealTasksReply> &callback) {
+  grpc_client_->StealTasks(request, callback);
+}
+
 void raylet::RayletClient::GlobalGC(
     const rpc::ClientCallback<rpc::GlobalGCReply> &callback) {
   rpc::GlobalGCRequest request;
@@ -197,6 +197,10 @@ class RayletClientInterface : public PinObjectsInterface,
       int64_t deadline_timestamp_ms,
       const rpc::ClientCallback<rpc::DrainRayletReply> &callback) = 0;
 
+  /// Ask the raylet to hand over some of its queued tasks to an idle raylet.
+  virtual void StealTasks(const rpc::StealTasksRequest &request,
+                          const rpc::ClientCallback<rpc::StealTasksReply> &callback) = 0;
+
   virtual std::shared_ptr<grpc::Channel> GetChannel() const = 0;
 };
 
@@ -460,6 +464,9 @@ class RayletClient : public RayletClientInterface {
                    int64_t deadline_timestamp_ms,
                    const rpc::ClientCallback<rpc::DrainRayletReply> &callback) override;
 
+  void StealTasks(const rpc::StealTasksRequest &request,
+                  const rpc::ClientCallback<rpc::StealTasksReply> &callback) override;
+
   void GetSystemConfig(
       const rpc::ClientCallback<rpc::GetSystemConfigReply> &callback) override;
 
@@ -126,6 +126,12 @@ class NodeManagerWorkerClient
                          grpc_client_,
                          /*method_timeout_ms*/ -1, )
 
+  /// Ask the node to hand over some of its queued tasks.
+  VOID_RPC_CLIENT_METHOD(NodeManagerService,
+                         StealTasks,
+                         grpc_client_,
+                         /*method_timeout_ms*/ -1, )
+
   /// Cancel a pending worker lease request.
   VOID_RPC_CLIENT_METHOD(NodeManagerService,
                          CancelWorkerLease,
@@ -49,7 +49,8 @@ namespace rpc {
   RAY_NODE_MANAGER_RPC_SERVICE_HANDLER(DrainRaylet)            \
   RAY_NODE_MANAGER_RPC_SERVICE_HANDLER(GetTasksInfo)           \
   RAY_NODE_MANAGER_RPC_SERVICE_HANDLER(GetObjectsInfo)         \
-  RAY_NODE_MANAGER_RPC_SERVICE_HANDLER(GetTaskFailureCause)
+  RAY_NODE_MANAGER_RPC_SERVICE_HANDLER(GetTaskFailureCause)    \
+  RAY_NODE_MANAGER_RPC_SERVICE_HANDLER(StealTasks)
 
 /// Interface of the `NodeManagerService`, see `src/ray/protobuf/node_manager.proto`.
 class NodeManagerServiceHandler {
@@ -151,6 +152,10 @@ class NodeManagerServiceHandler {
   virtual void HandleGetTaskFailureCause(GetTaskFailureCauseRequest request,
                                          GetTaskFailureCauseReply *reply,
                                          SendReplyCallback send_reply_callback) = 0;
+
+  virtual void HandleStealTasks(StealTasksRequest request,
+                                StealTasksReply *reply,
+                                SendReplyCallback send_reply_callback) = 0;
 };
 
 /// The `GrpcService` for `NodeManagerService`.
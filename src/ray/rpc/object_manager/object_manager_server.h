@@ -26,8 +26,35 @@ namespace rpc {
 #define RAY_OBJECT_MANAGER_RPC_SERVICE_HANDLER(METHOD) \
   RPC_SERVICE_HANDLER_CUSTOM_AUTH(ObjectManagerService, METHOD, -1, AuthType::NO_AUTH)
 
+/// `ObjectManagerService` with `Push` requests received as raw serialized messages,
+/// so that the chunk data can be written to the object store without being copied
+/// into a protobuf string first.
+struct ObjectManagerRawPushService {
+  using AsyncService =
+      ObjectManagerService::WithRawMethod_Push<ObjectManagerService::AsyncService>;
+};
+
+#define RAY_OBJECT_MANAGER_RAW_PUSH_HANDLER                        \
+  std::unique_ptr<ServerCallFactory> Push_call_factory(            \
+      new ServerCallFactoryImpl<ObjectManagerRawPushService,       \
+                                ObjectManagerServiceHandler,       \
+                                grpc::ByteBuffer,                  \
+                                grpc::ByteBuffer,                  \
+                                AuthType::NO_AUTH>(                \
+          service_,                                                \
+          &ObjectManagerRawPushService::AsyncService::RequestPush, \
+          service_handler_,                                        \
+          &ObjectManagerServiceHandler::HandlePush,                \
+          cq,                                                      \
+          main_service_,                                           \
+          "ObjectManagerService.grpc_server.Push",                 \
+          ClusterID::Nil(),                                        \
+          -1,                                                      \
+          true));                                                  \
+  server_call_factories->emplace_back(std::move(Push_call_factory));
+
 #define RAY_OBJECT_MANAGER_RPC_HANDLERS        \
-  RAY_OBJECT_MANAGER_RPC_SERVICE_HANDLER(Push) \
+  RAY_OBJECT_MANAGER_RAW_PUSH_HANDLER          \
   RAY_OBJECT_MANAGER_RPC_SERVICE_HANDLER(Pull) \
   RAY_OBJECT_MANAGER_RPC_SERVICE_HANDLER(FreeObjects)
 
@@ -39,11 +66,11 @@ class ObjectManagerServiceHandler {
   /// The implementation can handle this request asynchronously. When handling is done,
   /// the `send_reply_callback` should be called.
   ///
-  /// \param[in] request The request message.
-  /// \param[out] reply The reply message.
+  /// \param[in] request The serialized `PushRequest` message.
+  /// \param[out] reply The serialized `PushReply` message.
   /// \param[in] send_reply_callback The callback to be called when the request is done.
-  virtual void HandlePush(PushRequest request,
-                          PushReply *reply,
+  virtual void HandlePush(grpc::ByteBuffer request,
+                          grpc::ByteBuffer *reply,
                           SendReplyCallback send_reply_callback) = 0;
   /// Handle a `Pull` request
   virtual void HandlePull(PullRequest request,
@@ -78,7 +105,7 @@ class ObjectManagerGrpcService : public GrpcService {
 
  private:
   /// The grpc async service object.
-  ObjectManagerService::AsyncService service_;
+  ObjectManagerRawPushService::AsyncService service_;
   /// The service handler that actually handle the requests.
   ObjectManagerServiceHandler &service_handler_;
 };
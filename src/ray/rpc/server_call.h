@@ -15,6 +15,7 @@
 #pragma once
 
 #include <google/protobuf/arena.h>
+#include <google/protobuf/message.h>
 #include <grpcpp/grpcpp.h>
 
 #include <boost/asio.hpp>
@@ -190,7 +191,12 @@ class ServerCallImpl : public ServerCall {
         cluster_id_(cluster_id),
         start_time_(0),
         record_metrics_(record_metrics) {
-    reply_ = google::protobuf::Arena::CreateMessage<Reply>(&arena_);
+    if constexpr (std::is_base_of_v<google::protobuf::Message, Reply>) {
+      reply_ = google::protobuf::Arena::CreateMessage<Reply>(&arena_);
+    } else {
+      // Raw methods reply with a serialized message (`grpc::ByteBuffer`).
+      reply_ = google::protobuf::Arena::Create<Reply>(&arena_);
+    }
     // TODO call_name_ sometimes get corrunpted due to memory issues.
     RAY_CHECK(!call_name_.empty()) << "Call name is empty";
     if (record_metrics_) {
@@ -117,6 +117,17 @@ DEFINE_stats(object_store_dist,
                16384_MB}),
              ray::stats::HISTOGRAM);
 
+/// Memory of the slabs small objects are allocated from, when enabled.
+DEFINE_stats(object_store_slab_memory,
+             "Object store memory held by slabs of small objects",
+             /// State:
+             ///    - USED: bytes of the objects allocated from slabs.
+             ///    - ROUNDING: bytes lost to rounding objects up to a size class.
+             ///    - FREE: bytes of the free blocks of slabs.
+             ("State"),
+             (),
+             ray::stats::GAUGE);
+
 /// Placement group metrics from the GCS.
 DEFINE_stats(placement_groups,
              "Number of placement groups broken down by state.",
@@ -178,6 +189,13 @@ DEFINE_stats(object_manager_received_chunks,
              (),
              ray::stats::GAUGE);
 
+DEFINE_stats(object_manager_spilled_file_cache,
+             "Spilled file cache used to push spilled objects, broken per type {Hits, "
+             "Misses, BytesRead, OpenFiles}.",
+             ("Type"),
+             (),
+             ray::stats::GAUGE);
+
 /// Pull Manager
 DEFINE_stats(
     pull_manager_usage_bytes,
@@ -228,6 +246,20 @@ DEFINE_stats(push_manager_chunks,
              ("Type"),
              (),
              ray::stats::GAUGE);
+DEFINE_stats(push_manager_destination_window,
+             "Number of object chunks allowed in flight to a destination node, when "
+             "adaptive push scheduling is enabled, per type {Min, Mean, Max} over the "
+             "destinations.",
+             ("Type"),
+             (),
+             ray::stats::GAUGE);
+DEFINE_stats(push_manager_destination_throughput,
+             "Estimated number of object chunks per second acknowledged by a destination "
+             "node, when adaptive push scheduling is enabled, per type {Min, Mean, Max} "
+             "over the destinations.",
+             ("Type"),
+             (),
+             ray::stats::GAUGE);
 
 /// Scheduler
 DEFINE_stats(
@@ -293,6 +325,16 @@ DEFINE_stats(gcs_storage_operation_count,
              ("Operation"),
              (),
              ray::stats::COUNT);
+DEFINE_stats(gcs_storage_write_batch_size,
+             "Number of writes sent to Redis as one command by the Gcs storage",
+             (),
+             ({1, 10, 100, 1000}, ),
+             ray::stats::HISTOGRAM);
+DEFINE_stats(gcs_storage_write_batch_flush_latency_ms,
+             "Time from the first write of a batch being buffered to Redis replying",
+             (),
+             ({0.1, 1, 10, 100, 1000, 10000}, ),
+             ray::stats::HISTOGRAM);
 
 /// Placement Group
 // The end to end placement group creation latency.
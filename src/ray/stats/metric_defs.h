@@ -66,6 +66,7 @@ DECLARE_stats(grpc_server_req_finished);
 /// Object Manager.
 DECLARE_stats(object_manager_bytes);
 DECLARE_stats(object_manager_received_chunks);
+DECLARE_stats(object_manager_spilled_file_cache);
 
 /// Pull Manager
 DECLARE_stats(pull_manager_usage_bytes);
@@ -81,6 +82,8 @@ DECLARE_stats(pull_manager_object_request_time_ms);
 /// Push Manager
 DECLARE_stats(push_manager_in_flight_pushes);
 DECLARE_stats(push_manager_chunks);
+DECLARE_stats(push_manager_destination_window);
+DECLARE_stats(push_manager_destination_throughput);
 
 /// Scheduler
 DECLARE_stats(scheduler_failed_worker_startup_total);
@@ -101,6 +104,8 @@ DECLARE_stats(spill_manager_throughput_mb);
 /// GCS Storage
 DECLARE_stats(gcs_storage_operation_latency_ms);
 DECLARE_stats(gcs_storage_operation_count);
+DECLARE_stats(gcs_storage_write_batch_size);
+DECLARE_stats(gcs_storage_write_batch_flush_latency_ms);
 DECLARE_stats(gcs_task_manager_task_events_dropped);
 DECLARE_stats(gcs_task_manager_task_events_stored);
 DECLARE_stats(gcs_task_manager_task_events_reported);
@@ -108,6 +113,7 @@ DECLARE_stats(gcs_task_manager_task_events_reported);
 /// Object Store
 DECLARE_stats(object_store_memory);
 DECLARE_stats(object_store_dist);
+DECLARE_stats(object_store_slab_memory);
 
 /// Placement Group
 DECLARE_stats(gcs_placement_group_creation_latency_ms);
@@ -228,6 +234,24 @@ static Sum NumWorkersStartedFromCache(
     "The total number of workers started from a cached worker process.",
     "workers");
 
+static Sum NumWorkersPrestartedForDemand(
+    "internal_num_processes_prestarted_for_demand",
+    "The total number of worker processes prestarted for the recent lease requests.",
+    "processes");
+
+static Sum NumPrestartedWorkersUsed(
+    "internal_num_prestarted_workers_used",
+    "The total number of workers prestarted for the recent lease requests that were "
+    "used by a task. The hit rate is this over "
+    "internal_num_processes_prestarted_for_demand.",
+    "workers");
+
+static Sum PrestartedWorkersStartupTimeSavedMs(
+    "internal_prestarted_workers_startup_time_saved_ms",
+    "The total estimated worker startup time that tasks didn't wait for because a "
+    "prestarted worker was ready.",
+    "ms");
+
 static Gauge NumSpilledTasks("internal_num_spilled_tasks",
                              "The cumulative number of lease requeusts that this raylet "
                              "has spilled to other raylets.",
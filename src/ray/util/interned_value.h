@@ -0,0 +1,210 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "ray/util/logging.h"
+
+namespace ray {
+
+/// \class InternTable
+///
+/// A process-wide table of distinct values of type T, each identified by a small
+/// integer ID and reference counted. A value is stored once no matter how many
+/// holders it has, and is erased when its last holder releases it. The IDs of
+/// erased values are reused.
+///
+/// Values are accessed through InternedValue handles rather than through this
+/// class directly. This class is thread-safe.
+template <typename T>
+class InternTable {
+ public:
+  /// The ID of no value. Valid IDs start at 1.
+  static constexpr uint32_t kNilId = 0;
+
+  static InternTable &Instance() {
+    static auto *instance = new InternTable();
+    return *instance;
+  }
+
+  /// Add a holder of the value, inserting the value if it isn't in the table.
+  ///
+  /// \return The ID of the value.
+  uint32_t Intern(const T &value) ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    auto it = ids_.find(value);
+    if (it != ids_.end()) {
+      entries_[it->second - 1].ref_count++;
+      return it->second;
+    }
+    uint32_t id;
+    if (free_ids_.empty()) {
+      entries_.push_back({value, 1});
+      id = entries_.size();
+      RAY_CHECK(id != kNilId) << "Too many distinct interned values.";
+    } else {
+      id = free_ids_.back();
+      free_ids_.pop_back();
+      entries_[id - 1] = {value, 1};
+    }
+    ids_.emplace(value, id);
+    return id;
+  }
+
+  /// Add a holder of the value with the given ID.
+  void Ref(uint32_t id) ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    entries_[id - 1].ref_count++;
+  }
+
+  /// Remove a holder of the value with the given ID, erasing the value if it was
+  /// the last one.
+  void Unref(uint32_t id) ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    auto &entry = entries_[id - 1];
+    RAY_CHECK(entry.ref_count > 0);
+    if (--entry.ref_count == 0) {
+      ids_.erase(entry.value);
+      entry.value = T();
+      free_ids_.push_back(id);
+    }
+  }
+
+  /// Get the value with the given ID. The reference is valid as long as the
+  /// caller holds the value.
+  const T &Get(uint32_t id) const ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    // Elements of a deque don't move when the deque grows.
+    return entries_[id - 1].value;
+  }
+
+  /// The number of distinct values in the table.
+  size_t Size() const ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    return ids_.size();
+  }
+
+ private:
+  InternTable() = default;
+
+  struct Entry {
+    T value;
+    /// The number of holders of the value. 0 if the ID is free.
+    uint64_t ref_count;
+  };
+
+  mutable absl::Mutex mutex_;
+  /// The values, indexed by ID - 1.
+  std::deque<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  /// The IDs of the values in the table.
+  absl::flat_hash_map<T, uint32_t> ids_ ABSL_GUARDED_BY(mutex_);
+  /// The IDs of the erased values, to reuse.
+  std::vector<uint32_t> free_ids_ ABSL_GUARDED_BY(mutex_);
+};
+
+/// \class InternedValue
+///
+/// A handle to a value of type T interned in the InternTable of T. It behaves like
+/// an absl::optional<T> that is 4 bytes large, for values such as addresses or
+/// strings that many objects hold copies of, or that are too large to store in
+/// each object.
+///
+/// Copying a handle and setting or resetting its value take the lock of the table,
+/// so this isn't meant for values that change often.
+template <typename T>
+class InternedValue {
+ public:
+  InternedValue() = default;
+
+  InternedValue(const T &value) : id_(Table().Intern(value)) {}
+
+  InternedValue(const InternedValue &other) : id_(other.id_) {
+    if (id_ != InternTable<T>::kNilId) {
+      Table().Ref(id_);
+    }
+  }
+
+  InternedValue(InternedValue &&other) noexcept : id_(other.id_) {
+    other.id_ = InternTable<T>::kNilId;
+  }
+
+  InternedValue &operator=(const InternedValue &other) {
+    if (this != &other) {
+      if (other.id_ != InternTable<T>::kNilId) {
+        Table().Ref(other.id_);
+      }
+      reset();
+      id_ = other.id_;
+    }
+    return *this;
+  }
+
+  InternedValue &operator=(InternedValue &&other) noexcept {
+    if (this != &other) {
+      reset();
+      id_ = other.id_;
+      other.id_ = InternTable<T>::kNilId;
+    }
+    return *this;
+  }
+
+  InternedValue &operator=(const T &value) {
+    auto id = Table().Intern(value);
+    reset();
+    id_ = id;
+    return *this;
+  }
+
+  ~InternedValue() { reset(); }
+
+  bool has_value() const { return id_ != InternTable<T>::kNilId; }
+
+  explicit operator bool() const { return has_value(); }
+
+  const T &value() const {
+    RAY_CHECK(has_value());
+    return Table().Get(id_);
+  }
+
+  const T &operator*() const { return value(); }
+
+  const T *operator->() const { return &value(); }
+
+  T value_or(const T &default_value) const {
+    return has_value() ? Table().Get(id_) : default_value;
+  }
+
+  void reset() {
+    if (id_ != InternTable<T>::kNilId) {
+      Table().Unref(id_);
+      id_ = InternTable<T>::kNilId;
+    }
+  }
+
+  /// The number of distinct values of type T interned in the process.
+  static size_t NumInterned() { return Table().Size(); }
+
+ private:
+  static InternTable<T> &Table() { return InternTable<T>::Instance(); }
+
+  uint32_t id_ = InternTable<T>::kNilId;
+};
+
+}  // namespace ray
@@ -0,0 +1,87 @@
+// Copyright 2023 The Ray Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//  http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ray/util/interned_value.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace ray {
+
+TEST(InternedValueTest, TestBasic) {
+  InternedValue<std::string> empty;
+  EXPECT_FALSE(empty.has_value());
+  EXPECT_EQ(empty.value_or("default"), "default");
+  EXPECT_EQ(sizeof(empty), 4);
+
+  InternedValue<std::string> a("value");
+  EXPECT_TRUE(a.has_value());
+  EXPECT_EQ(*a, "value");
+  EXPECT_EQ(a->size(), 5);
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 1);
+
+  // Equal values are stored once.
+  InternedValue<std::string> b("value");
+  InternedValue<std::string> c = a;
+  EXPECT_EQ(*b, "value");
+  EXPECT_EQ(*c, "value");
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 1);
+
+  b = "other";
+  EXPECT_EQ(*b, "other");
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 2);
+
+  // A value is erased with its last holder.
+  a.reset();
+  EXPECT_FALSE(a.has_value());
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 2);
+  InternedValue<std::string> d = std::move(c);
+  EXPECT_FALSE(c.has_value());
+  d.reset();
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 1);
+  b.reset();
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 0);
+
+  // Erased values can be interned again.
+  InternedValue<std::string> e("value");
+  EXPECT_EQ(*e, "value");
+  EXPECT_EQ(InternedValue<std::string>::NumInterned(), 1);
+}
+
+TEST(InternedValueTest, TestConcurrentHolders) {
+  const int kNumThreads = 8;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; i++) {
+    threads.emplace_back([i]() {
+      std::vector<InternedValue<int>> values;
+      for (int j = 0; j < 1000; j++) {
+        values.emplace_back(j % 10);
+        values.emplace_back(i);
+      }
+      for (int j = 0; j < 1000; j++) {
+        ASSERT_EQ(*values[2 * j], j % 10);
+        ASSERT_EQ(*values[2 * j + 1], i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(InternedValue<int>::NumInterned(), 0);
+}
+
+}  // namespace ray